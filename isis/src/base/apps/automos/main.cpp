@@ -88,6 +88,9 @@ void IsisMain() {
   // Get the MatchDEM Flag
   m.SetMatchDEM(ui.GetBoolean("MATCHDEM"));
 
+  // Composite the mosaic in parallel tiles after all inputs are placed
+  m.SetTiledFlag(ui.GetBoolean("THREADED"));
+
   bool mosaicCreated = false;
   for (int i = 0; i < list.size(); i++) {
     if (!m.StartProcess(list[i].toString())) {
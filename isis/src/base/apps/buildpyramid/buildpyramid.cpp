@@ -0,0 +1,261 @@
+#include "buildpyramid.h"
+
+#include <algorithm>
+#include <vector>
+
+#include <QList>
+#include <QStringList>
+
+#include "CubeOverview.h"
+#include "FileName.h"
+#include "IException.h"
+#include "LineManager.h"
+#include "Progress.h"
+#include "PvlGroup.h"
+#include "PvlKeyword.h"
+#include "PvlObject.h"
+#include "SpecialPixel.h"
+
+using namespace std;
+
+namespace Isis {
+
+  /**
+   * The running sums for the overview line currently being built at one level,
+   * and the tile that the finished lines go into.
+   */
+  struct OverviewLevel {
+    int level;            //!< The reduction factor of the level
+    int samples;          //!< The number of samples in the level
+    int lines;            //!< The number of lines in the level
+    int tileLines;        //!< The number of lines in each tile but the last
+    CubeOverview *tile;   //!< The tile being filled
+    int line;             //!< The overview line being accumulated
+    vector<double> sums;  //!< The sum of the valid cube pixels in each sample of each band
+    vector<double> counts; //!< The number of valid cube pixels in each sample of each band
+  };
+
+  static QStringList tileNames(const OverviewLevel &overviewLevel);
+  static void addRow(Cube *cube, QList<OverviewLevel> &levels, int levelIndex, int row,
+                     int rowCount, const vector<double> &sums, const vector<double> &counts);
+  static void nextTile(OverviewLevel &overviewLevel, int bands);
+
+
+  /**
+   * Builds the overviews of the cube named by FROM.
+   *
+   * @param ui The user interface to get the parameters from
+   * @param log The log to put the results in
+   */
+  void buildpyramid(UserInterface &ui, Pvl *log) {
+    Cube cube(FileName(ui.GetFileName("FROM")), "rw");
+    buildpyramid(&cube, ui, log);
+  }
+
+
+  /**
+   * Builds reduced resolution overviews of a cube at levels 2, 4, 8 and so on
+   * in a single pass through the cube, and stores them in the cube. Each level
+   * is the average of the valid pixels of the cube under it, which is
+   * accumulated from the sums of the level below it.
+   *
+   * The cube is read a line of all bands at a time, and each level is written
+   * a tile at a time as its lines are finished, so only one tile of each level
+   * is held in memory.
+   *
+   * @param cube The cube to build the overviews of, opened read/write
+   * @param ui The user interface to get the parameters from
+   * @param log The log to put the results in
+   */
+  void buildpyramid(Cube *cube, UserInterface &ui, Pvl *log) {
+    int minimumSize = ui.GetInteger("MINSIZE");
+    int samples = cube->sampleCount();
+    int lines = cube->lineCount();
+    int bands = cube->bandCount();
+
+    QList<OverviewLevel> levels;
+    int level = 1;
+    int levelSamples = samples;
+    int levelLines = lines;
+    while (max(levelSamples, levelLines) > minimumSize) {
+      level *= 2;
+      levelSamples = (samples + level - 1) / level;
+      levelLines = (lines + level - 1) / level;
+
+      OverviewLevel overviewLevel;
+      overviewLevel.level = level;
+      overviewLevel.samples = levelSamples;
+      overviewLevel.lines = levelLines;
+      overviewLevel.tileLines = min(levelLines,
+                                    CubeOverview::maximumTileLines(levelSamples, bands));
+      overviewLevel.tile = NULL;
+      overviewLevel.line = 1;
+      overviewLevel.sums.assign((size_t)levelSamples * bands, 0.0);
+      overviewLevel.counts.assign((size_t)levelSamples * bands, 0.0);
+      levels.append(overviewLevel);
+    }
+
+    // Remove the tiles of a previous run that this one will not replace. The
+    // others are overwritten in place.
+    QStringList newTiles;
+    foreach (const OverviewLevel &overviewLevel, levels) {
+      newTiles += tileNames(overviewLevel);
+    }
+    QStringList oldTiles;
+    for (int i = 0; i < cube->label()->objects(); i++) {
+      const PvlObject &obj = cube->label()->object(i);
+      if (obj.isNamed("Overview") && obj.hasKeyword("Name") &&
+          !newTiles.contains(obj["Name"][0])) {
+        oldTiles.append(obj["Name"][0]);
+      }
+    }
+    foreach (QString oldTile, oldTiles) {
+      cube->deleteBlob("Overview", oldTile);
+    }
+
+    try {
+      for (int i = 0; i < levels.size(); i++) {
+        nextTile(levels[i], bands);
+      }
+
+      Progress progress;
+      progress.SetText("Building overviews");
+      progress.SetMaximumSteps(lines * bands);
+      progress.CheckStatus();
+
+      LineManager cubeLine(*cube);
+      vector<double> sums((size_t)samples * bands);
+      vector<double> counts((size_t)samples * bands);
+      for (int line = 1; line <= lines; line++) {
+        for (int band = 1; band <= bands; band++) {
+          cubeLine.SetLine(line, band);
+          cube->read(cubeLine);
+          size_t start = (size_t)(band - 1) * samples;
+          for (int i = 0; i < samples; i++) {
+            bool valid = IsValidPixel(cubeLine[i]);
+            sums[start + i] = valid ? cubeLine[i] : 0.0;
+            counts[start + i] = valid ? 1.0 : 0.0;
+          }
+          progress.CheckStatus();
+        }
+
+        if (!levels.isEmpty()) {
+          addRow(cube, levels, 0, line, lines, sums, counts);
+        }
+      }
+
+      PvlKeyword levelsKeyword("Levels");
+      foreach (const OverviewLevel &overviewLevel, levels) {
+        levelsKeyword += toString(overviewLevel.level);
+      }
+
+      PvlGroup results("Results");
+      results += levelsKeyword;
+      log->addGroup(results);
+    }
+    catch (IException &) {
+      foreach (const OverviewLevel &overviewLevel, levels) {
+        delete overviewLevel.tile;
+      }
+      throw;
+    }
+  }
+
+
+  /**
+   * @param overviewLevel An overview level
+   * @return The names of the tiles the level is stored in
+   */
+  static QStringList tileNames(const OverviewLevel &overviewLevel) {
+    QStringList names;
+    for (int line = 1; line <= overviewLevel.lines; line += overviewLevel.tileLines) {
+      names.append(CubeOverview::overviewName(overviewLevel.level, line));
+    }
+    return names;
+  }
+
+
+  /**
+   * Adds a row of sums from the level below to an overview level. When the
+   * overview line is complete its pixels are put in the tile and its sums are
+   * passed on to the next level. When the tile is complete it is written to
+   * the cube.
+   *
+   * @param cube The cube to write the tiles to
+   * @param levels All of the overview levels being built
+   * @param levelIndex The level to add the row to
+   * @param row The line of the row in the level below, starting at 1
+   * @param rowCount The number of lines in the level below
+   * @param sums The sum of the valid cube pixels under each sample of each band
+   *             of the row
+   * @param counts The number of valid cube pixels under each sample of each
+   *               band of the row
+   */
+  static void addRow(Cube *cube, QList<OverviewLevel> &levels, int levelIndex, int row,
+                     int rowCount, const vector<double> &sums, const vector<double> &counts) {
+    OverviewLevel &overviewLevel = levels[levelIndex];
+    int bands = overviewLevel.tile->bandCount();
+    int rowSamples = (int)(sums.size() / bands);
+    for (int band = 0; band < bands; band++) {
+      size_t rowStart = (size_t)band * rowSamples;
+      size_t levelStart = (size_t)band * overviewLevel.samples;
+      for (int i = 0; i < rowSamples; i++) {
+        overviewLevel.sums[levelStart + i / 2] += sums[rowStart + i];
+        overviewLevel.counts[levelStart + i / 2] += counts[rowStart + i];
+      }
+    }
+
+    if (row % 2 != 0 && row != rowCount) {
+      return;
+    }
+
+    CubeOverview *tile = overviewLevel.tile;
+    for (int band = 0; band < bands; band++) {
+      size_t levelStart = (size_t)band * overviewLevel.samples;
+      for (int i = 0; i < overviewLevel.samples; i++) {
+        double value = Null;
+        if (overviewLevel.counts[levelStart + i] > 0.0) {
+          value = overviewLevel.sums[levelStart + i] / overviewLevel.counts[levelStart + i];
+        }
+        tile->setPixel(i + 1, overviewLevel.line, band + 1, value);
+      }
+    }
+
+    if (levelIndex + 1 < levels.size()) {
+      addRow(cube, levels, levelIndex + 1, overviewLevel.line, overviewLevel.lines,
+             overviewLevel.sums, overviewLevel.counts);
+    }
+
+    overviewLevel.sums.assign(overviewLevel.sums.size(), 0.0);
+    overviewLevel.counts.assign(overviewLevel.counts.size(), 0.0);
+
+    if (overviewLevel.line == tile->firstLine() + tile->tileLineCount() - 1) {
+      cube->write(*tile);
+      nextTile(overviewLevel, bands);
+    }
+    overviewLevel.line++;
+  }
+
+
+  /**
+   * Replaces the tile of a level with an empty one that starts after it, or
+   * with none after the last tile.
+   *
+   * @param overviewLevel The level to start the next tile of
+   * @param bands The number of bands in the level
+   */
+  static void nextTile(OverviewLevel &overviewLevel, int bands) {
+    int firstLine = 1;
+    if (overviewLevel.tile) {
+      firstLine = overviewLevel.tile->firstLine() + overviewLevel.tile->tileLineCount();
+      delete overviewLevel.tile;
+      overviewLevel.tile = NULL;
+    }
+
+    if (firstLine <= overviewLevel.lines) {
+      int tileLines = min(overviewLevel.tileLines, overviewLevel.lines - firstLine + 1);
+      overviewLevel.tile = new CubeOverview(overviewLevel.level, overviewLevel.samples,
+                                            overviewLevel.lines, bands, firstLine, tileLines);
+    }
+  }
+}
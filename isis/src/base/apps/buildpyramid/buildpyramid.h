@@ -0,0 +1,13 @@
+#ifndef buildpyramid_h
+#define buildpyramid_h
+
+#include "Cube.h"
+#include "Pvl.h"
+#include "UserInterface.h"
+
+namespace Isis {
+  extern void buildpyramid(Cube *cube, UserInterface &ui, Pvl *log);
+  extern void buildpyramid(UserInterface &ui, Pvl *log);
+}
+
+#endif
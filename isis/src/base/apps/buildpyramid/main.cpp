@@ -0,0 +1,19 @@
+#include "Isis.h"
+
+#include "buildpyramid.h"
+
+#include "Application.h"
+#include "Pvl.h"
+
+using namespace std;
+using namespace Isis;
+
+void IsisMain() {
+  UserInterface &ui = Application::GetUserInterface();
+  Pvl appLog;
+  buildpyramid(ui, &appLog);
+
+  for (auto grpIt = appLog.beginGroup(); grpIt!= appLog.endGroup(); grpIt++) {
+    Application::Log(*grpIt);
+  }
+}
@@ -1,5 +1,7 @@
 #include "cam2map.h"
 
+#include <vector>
+
 #include "Camera.h"
 #include "CubeAttribute.h"
 #include "IException.h"
@@ -518,6 +520,39 @@ namespace Isis {
   // Transform method mapping output line/samps to lat/lons to input line/samps
   bool cam2mapReverse::Xform(double &inSample, double &inLine,
                              const double outSample, const double outLine) {
+    double lat, lon;
+    if (!groundToImage(inSample, inLine, lat, lon, outSample, outLine)) return false;
+    return checkImage(inSample, inLine, lat, lon);
+  }
+
+  // Transform many output pixels, letting the camera trace the input pixels together
+  void cam2mapReverse::Xforms(const int count, double *inSamples, double *inLines,
+                              const double *outSamples, const double *outLines, bool *good) {
+    std::vector<double> lats(count), lons(count);
+    std::vector<double> samples, lines;
+    for (int i = 0; i < count; i++) {
+      good[i] = groundToImage(inSamples[i], inLines[i], lats[i], lons[i],
+                              outSamples[i], outLines[i]);
+      if (good[i]) {
+        samples.push_back(inSamples[i]);
+        lines.push_back(inLines[i]);
+      }
+    }
+
+    // Shape models that trace rays in batches, such as DSKs, trace the look
+    // directions of all of the input pixels here
+    p_incam->PrepareImages(samples, lines);
+
+    for (int i = 0; i < count; i++) {
+      if (good[i]) {
+        good[i] = checkImage(inSamples[i], inLines[i], lats[i], lons[i]);
+      }
+    }
+  }
+
+  // Map an output line/samp to the lat/lon and input line/samp it came from
+  bool cam2mapReverse::groundToImage(double &inSample, double &inLine, double &lat, double &lon,
+                                     const double outSample, const double outLine) {
     // See if the output image coordinate converts to lat/lon
     if (!p_outmap->SetWorld(outSample, outLine)) return false;
 
@@ -530,8 +565,8 @@ namespace Isis {
     }
 
     // Get the universal lat/lon and see if it can be converted to input line/samp
-    double lat = p_outmap->UniversalLatitude();
-    double lon = p_outmap->UniversalLongitude();
+    lat = p_outmap->UniversalLatitude();
+    lon = p_outmap->UniversalLongitude();
 
     if (!p_incam->SetUniversalGround(lat, lon)) return false;
 
@@ -544,7 +579,12 @@ namespace Isis {
     // Everything is good
     inSample = p_incam->Sample();
     inLine = p_incam->Line();
+    return true;
+  }
 
+  // Go back to the ground from the input line/samp to check for occlusion
+  bool cam2mapReverse::checkImage(const double inSample, const double inLine,
+                                  const double lat, const double lon) {
     // Good to ground one last time to check for occlusion
     p_incam->SetImage(inSample, inLine);
 
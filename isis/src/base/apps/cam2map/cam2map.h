@@ -47,8 +47,16 @@ namespace Isis {
       // Implementations for parent's pure virtual members
       bool Xform(double &inSample, double &inLine,
                  const double outSample, const double outLine);
+      void Xforms(const int count, double *inSamples, double *inLines,
+                  const double *outSamples, const double *outLines, bool *good);
       int OutputSamples() const;
       int OutputLines() const;
+
+    private:
+      bool groundToImage(double &inSample, double &inLine, double &lat, double &lon,
+                         const double outSample, const double outLine);
+      bool checkImage(const double inSample, const double inLine,
+                      const double lat, const double lon);
   };
 
   /**
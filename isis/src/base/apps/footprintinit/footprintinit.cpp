@@ -1,6 +1,7 @@
 #include "footprintinit.h"
 
 #include "Application.h"
+#include "FileList.h"
 #include "IException.h"
 #include "ImagePolygon.h"
 #include "PolygonTools.h"
@@ -8,6 +9,7 @@
 #include "Progress.h"
 #include "PvlGroup.h"
 #include "SerialNumber.h"
+#include "Spice.h"
 #include "Target.h"
 #include "TProjection.h"
 
@@ -16,7 +18,16 @@ using namespace std;
 
 namespace Isis {
 
+  //! Kernels a batch keeps loaded, a tenth of the 5000 files NAIF can have loaded at once
+  static const int s_batchResidentKernels = 500;
+
   void footprintinit(UserInterface &ui, Pvl *log) {
+    if (ui.WasEntered("FROMLIST")) {
+      FileList cubes(FileName(ui.GetFileName("FROMLIST")));
+      footprintinit(cubes, ui, log);
+      return;
+    }
+
     Cube cube;
     cube.open(ui.GetFileName("FROM"), "rw");
 
@@ -24,6 +35,54 @@ namespace Isis {
     cube.close();
   }
 
+
+  /**
+   * Creates footprints for every cube in a list in this process, so the
+   * application and library start up only once for the whole batch. Each cube
+   * is opened, footprinted and closed before the next one is opened.
+   *
+   * The cameras of the batch share their setup. NAIF kernels stay loaded from
+   * one cube to the next, so cubes from the same mission do not load them
+   * again, and DEM shape models stay open in the CubeManager.
+   *
+   * @param cubes The cubes to create footprints for
+   * @param ui The user interface to parse the parameters from
+   * @param log The log to add results to
+   */
+  void footprintinit(FileList &cubes, UserInterface &ui, Pvl *log) {
+    if (cubes.size() == 0) {
+      QString msg = "The input list [" + ui.GetFileName("FROMLIST") + "] is empty";
+      throw IException(IException::User, msg, _FILEINFO_);
+    }
+
+    Progress prog;
+    prog.SetText("Creating footprints");
+    prog.SetMaximumSteps(cubes.size());
+    prog.CheckStatus();
+
+    int maximumResidentKernels = Spice::maximumResidentKernels();
+    Spice::setMaximumResidentKernels(qMax(maximumResidentKernels, s_batchResidentKernels));
+
+    try {
+      for (int i = 0; i < cubes.size(); i++) {
+        Cube cube;
+        cube.open(cubes[i].expanded(), "rw");
+
+        footprintinit(&cube, ui, log);
+        cube.close();
+
+        prog.CheckStatus();
+      }
+    }
+    catch (IException &) {
+      Spice::setMaximumResidentKernels(maximumResidentKernels);
+      throw;
+    }
+
+    // Unloads the kernels that stayed loaded for the batch
+    Spice::setMaximumResidentKernels(maximumResidentKernels);
+  }
+
   void footprintinit(Cube *cube, UserInterface &ui, Pvl *log) {
     bool testXY = ui.GetBoolean("TESTXY");
 
@@ -55,6 +114,7 @@ namespace Isis {
     if (ui.GetString("LIMBTEST") == "ELLIPSOID") {
       poly.EllipsoidLimb(true);
     }
+    poly.Threaded(ui.GetBoolean("THREADED"));
 
     int sinc = 1;
     int linc = 1;
@@ -81,7 +141,7 @@ namespace Isis {
       poly.Create(*cube, sinc, linc, 1, 1, 0, 0, 1, precision);
     }
     catch (IException &e) {
-      QString msg = "Cannot generate polygon for [" + ui.GetFileName("FROM") + "]";
+      QString msg = "Cannot generate polygon for [" + cube->fileName() + "]";
       throw IException(e, IException::User, msg, _FILEINFO_);
     }
 
@@ -89,7 +149,7 @@ namespace Isis {
       Pvl map(ui.GetFileName("MAP"));
       PvlGroup &mapGroup = map.findGroup("MAPPING");
 
-      Pvl cubeLab(ui.GetFileName("FROM"));
+      Pvl cubeLab(cube->fileName());
       // This call adds TargetName, EquatorialRadius and PolarRadius to mapGroup
       mapGroup = Target::radiiGroup(cubeLab, mapGroup);
       // add/replace the rest of the keywords
@@ -128,7 +188,7 @@ namespace Isis {
             delete xyPoly;
             e.print(); // This should be a NAIF error
             QString msg = "Cannot calculate XY for [";
-            msg += ui.GetFileName("FROM") + "]";
+            msg += cube->fileName() + "]";
             throw IException(e, IException::User, msg, _FILEINFO_);
           }
         }
@@ -1,4 +1,5 @@
 #include "Cube.h"
+#include "FileList.h"
 #include "Pvl.h"
 #include "UserInterface.h"
 
@@ -6,4 +7,6 @@ namespace Isis {
   extern void footprintinit(UserInterface &ui, Pvl *log=nullptr);
 
   extern void footprintinit(Cube *cube, UserInterface &ui, Pvl *log=nullptr);
+
+  extern void footprintinit(FileList &cubes, UserInterface &ui, Pvl *log=nullptr);
 }
@@ -5,6 +5,8 @@
 #include <QString>
 #include <QStringList>
 #include <sstream>
+#include "Cube.h"
+#include "IException.h"
 #include "Process.h"
 #include "Pvl.h"
 #include "SessionLog.h"
@@ -14,6 +16,7 @@ using namespace Isis;
 
 //helper button functins in the code
 void helperButtonLog();
+bool readCubeGroup(const QString &file, const QString &name, PvlGroup &group);
 
 map <QString, void *> GuiHelpers() {
   map <QString, void *> helper;
@@ -33,9 +36,17 @@ void IsisMain() {
   UserInterface &ui = Application::GetUserInterface();
   QString labelFile = ui.GetFileName("FROM");
 
+  // A group of a cube's IsisCube object, such as Instrument, is found without
+  // reading the tables and kernels in the rest of the label
+  PvlGroup cubeGroup;
+  bool inCube = !ui.WasEntered("OBJNAME") && ui.WasEntered("GRPNAME") &&
+                readCubeGroup(labelFile, ui.GetString("GRPNAME"), cubeGroup);
+
   // Open the file ... it must be a label-type file
   Pvl lab;
-  lab.read(labelFile);
+  if (!inCube) {
+    lab.read(labelFile);
+  }
   bool recursive = ui.GetBoolean("RECURSIVE");
 
   // Set up the requested object
@@ -63,7 +74,8 @@ void IsisMain() {
   // Set up the requested group
   else if(ui.WasEntered("GRPNAME")) {
     QString grp = ui.GetString("GRPNAME");
-    key = lab.findGroup(grp, Pvl::Traverse)[ui.GetString("KEYWORD")];
+    const PvlGroup &group = inCube ? cubeGroup : lab.findGroup(grp, Pvl::Traverse);
+    key = group[ui.GetString("KEYWORD")];
   }
 
   // Find the keyword in the label, outside of any object or group
@@ -135,3 +147,20 @@ void helperButtonLog() {
   Application::GuiLog(p);
 }
 //...........end of helper function LogMap ........
+
+//Reads a group of the IsisCube object when the file is a cube, without
+//reading the rest of the label. Returns false for other files and groups.
+bool readCubeGroup(const QString &file, const QString &name, PvlGroup &group) {
+  try {
+    Cube cube;
+    cube.setLazyLabels(true);
+    cube.open(file, "r");
+    if (cube.hasGroup(name)) {
+      group = cube.group(name);
+      return true;
+    }
+  }
+  catch (IException &) {
+  }
+  return false;
+}
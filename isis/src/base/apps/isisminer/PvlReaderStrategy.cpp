@@ -161,7 +161,9 @@ namespace Isis {
     QString rowBase(keys.get("PvlBaseName","Pvl"));
     QString rowId = rowBase + QString::number(nth);
   
-    Pvl pvl(pvlfile);
+    // Objects that are not included are never imported, so they are not read
+    Pvl pvl;
+    pvl.read(pvlfile, m_pvlparms.includes());
     PvlFlatMap pvlImports(pvl, m_pvlparms);
     SharedResource pvlsrc(new Resource(rowId, pvlImports));
   
@@ -1,40 +1,56 @@
 #ifndef map2map_h
 #define map2map_h
 
+#include "Pvl.h"
+#include "TProjection.h"
 #include "Transform.h"
+#include "UserInterface.h"
 
-/**
- * @author ????-??-?? Unknown
- *
- * @internal
- *   @history 2012-12-06 Debbie A. Cook - Changed to use TProjection instead of Projection.
- *                          References #775.
- */
-class map2map : public Isis::Transform {
-  private:
-    Isis::TProjection *p_inmap;
-    Isis::TProjection *p_outmap;
-    int p_inputSamples;
-    int p_inputLines;
-    bool p_trim;
-    int p_outputSamples;
-    int p_outputLines;
-    int p_inputWorldSize;
-
-  public:
-    // constructor
-    map2map(const int inputSamples, const int inputLines, Isis::TProjection *inmap,
-            const int outputSamples, const int outputLines, Isis::TProjection *outmap,
-            bool trim);
-
-    // destructor
-    ~map2map() {};
-
-    // Implementations for parent's pure virtual members
-    bool Xform(double &inSample, double &inLine,
-               const double outSample, const double outLine);
-    int OutputSamples() const;
-    int OutputLines() const;
-};
+namespace Isis {
+  extern void map2map(UserInterface &ui, Pvl *log=nullptr);
+
+  /**
+   * @author ????-??-?? Unknown
+   *
+   * @internal
+   *   @history 2012-12-06 Debbie A. Cook - Changed to use TProjection instead of Projection.
+   *                          References #775.
+   */
+  class map2mapReverse : public Transform {
+    private:
+      TProjection *p_inmap;
+      TProjection *p_outmap;
+      int p_inputSamples;
+      int p_inputLines;
+      bool p_trim;
+      int p_outputSamples;
+      int p_outputLines;
+      int p_inputWorldSize;
+      bool p_separable;
+      double p_referenceSample;
+      double p_referenceLine;
+
+      void inputSampleWrap(double &inSample);
+
+    public:
+      // constructor
+      map2mapReverse(const int inputSamples, const int inputLines, TProjection *inmap,
+                     const int outputSamples, const int outputLines, TProjection *outmap,
+                     bool trim);
+
+      // destructor
+      ~map2mapReverse() {};
+
+      // Implementations for parent's pure virtual members
+      bool Xform(double &inSample, double &inLine,
+                 const double outSample, const double outLine);
+      int OutputSamples() const;
+      int OutputLines() const;
+
+      bool IsSeparable() const;
+      bool XformSample(double &inSample, const double outSample);
+      bool XformLine(double &inLine, const double outLine);
+  };
+}
 
 #endif
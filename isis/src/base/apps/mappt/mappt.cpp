@@ -1,4 +1,5 @@
 #include <QString>
+#include <QVector>
 #include <cmath>
 
 #include "Brick.h"
@@ -18,8 +19,24 @@ using namespace std;
 
 namespace Isis {
 
+/**
+ * The location of one requested point, as found by the projection of the cube
+ */
+struct MapPoint {
+  double sample;             //!< The sample of the point in the cube
+  double line;               //!< The line of the point in the cube
+  double x;                  //!< The projection x coordinate
+  double y;                  //!< The projection y coordinate
+  double universalLatitude;  //!< The planetocentric latitude
+  double universalLongitude; //!< The positive east, 0 to 360 longitude
+  bool good;                 //!< If the latitude and longitude were found
+};
+
 QList< QPair<double, double> > getMapPoints(const UserInterface &ui, bool usePointList);
-PvlGroup getProjPointInfo(Cube *icube, QPair<double, double> point, UserInterface &ui, Pvl *log);
+MapPoint setProjPoint(Cube *icube, QPair<double, double> point, UserInterface &ui);
+QList<MapPoint> invertProjPoints(Cube *icube, const QList< QPair<double, double> > &points,
+                                 UserInterface &ui);
+PvlGroup getProjPointInfo(Cube *icube, const MapPoint &point, UserInterface &ui);
   
 void mappt(UserInterface &ui, Pvl *log) {
   Cube *cube = new Cube();
@@ -39,9 +56,18 @@ void mappt(Cube *icube, UserInterface &ui, Pvl *log, CubeAttributeInput* inAtt)
   QList<QPair<double, double>> points = getMapPoints(ui, ui.WasEntered("COORDLIST"));
    
   if(log) {
-    for(int i = 0; i < points.size(); i++) {
-      log->addGroup(getProjPointInfo(icube, points[i], ui, log));
-    } 
+    // Image and projection coordinates are inverted all at once
+    if (ui.GetString("TYPE") == "GROUND") {
+      for(int i = 0; i < points.size(); i++) {
+        log->addGroup(getProjPointInfo(icube, setProjPoint(icube, points[i], ui), ui));
+      }
+    }
+    else {
+      QList<MapPoint> mapPoints = invertProjPoints(icube, points, ui);
+      for(int i = 0; i < mapPoints.size(); i++) {
+        log->addGroup(getProjPointInfo(icube, mapPoints[i], ui));
+      }
+    }
   }
 
   // Write an output label file if necessary
@@ -110,25 +136,86 @@ void mappt(Cube *icube, UserInterface &ui, Pvl *log, CubeAttributeInput* inAtt)
 }
 
 
-PvlGroup getProjPointInfo(Cube *icube, QPair<double, double> point, UserInterface &ui, Pvl *log) { 
-  // Get the coordinate
-  bool outsideAllowed = ui.GetBoolean("ALLOWOUTSIDE");
+/**
+ * Checks that a requested sample and line are on the image, unless points
+ * outside of it are allowed.
+ */
+static void checkImagePoint(Cube *icube, QPair<double, double> point, UserInterface &ui) {
   int cubeLineLimit = icube->lineCount() + .5;
   int cubeSampleLimit = icube->sampleCount() + .5;
+  double samp = point.first;
+  double line = point.second;
 
+  if (!ui.GetBoolean("ALLOWOUTSIDE")) {
+    if (samp < .5 || line < .5 || samp > cubeSampleLimit || line > cubeLineLimit) {
+      QString error = "Requested line,sample is not on the image";
+      throw IException(IException::Unknown, error, _FILEINFO_);
+    }
+  }
+}
+
+
+/**
+ * Finds the location of many image or projection points with one call to the
+ * batch inverse of the projection, rather than setting the projection to each
+ * point in turn.
+ */
+QList<MapPoint> invertProjPoints(Cube *icube, const QList< QPair<double, double> > &points,
+                                 UserInterface &ui) {
   TProjection *proj = (TProjection *) icube->projection();
-  // Get the sample/line position if we have an image point
-  if(ui.GetString("TYPE") == "IMAGE") {
-    double samp = point.first;
-    double line = point.second;
+  bool image = (ui.GetString("TYPE") == "IMAGE");
+
+  int count = points.size();
+  QVector<double> xs(count), ys(count), lats(count), lons(count);
+  QVector<bool> good(count);
+  for (int i = 0; i < count; i++) {
+    if (image) {
+      checkImagePoint(icube, points[i], ui);
+      xs[i] = proj->ToProjectionX(points[i].first);
+      ys[i] = proj->ToProjectionY(points[i].second);
+    }
+    else {
+      xs[i] = points[i].first;
+      ys[i] = points[i].second;
+    }
+  }
 
-    if (!outsideAllowed) {
-      if (samp < .5 || line < .5 || samp > cubeSampleLimit || line > cubeLineLimit) {
-        QString error = "Requested line,sample is not on the image";
-        throw IException(IException::Unknown, error, _FILEINFO_);
-      }
+  proj->SetCoordinates(count, xs.constData(), ys.constData(), lats.data(), lons.data(),
+                       good.data());
+
+  QList<MapPoint> mapPoints;
+  for (int i = 0; i < count; i++) {
+    MapPoint mapPoint;
+    mapPoint.sample = proj->ToWorldX(xs[i]);
+    mapPoint.line = proj->ToWorldY(ys[i]);
+    mapPoint.x = xs[i];
+    mapPoint.y = ys[i];
+    mapPoint.good = good[i];
+    mapPoint.universalLatitude = Null;
+    mapPoint.universalLongitude = Null;
+    if (good[i]) {
+      // The same conversions as UniversalLatitude and UniversalLongitude
+      mapPoint.universalLatitude =
+          proj->IsPlanetographic() ? proj->ToPlanetocentric(lats[i]) : lats[i];
+      mapPoint.universalLongitude =
+          TProjection::To360Domain(proj->IsPositiveWest() ? -lons[i] : lons[i]);
     }
-    proj->SetWorld(samp, line);
+    mapPoints.append(mapPoint);
+  }
+
+  return mapPoints;
+}
+
+
+/**
+ * Sets the projection of the cube to one point and returns its location.
+ */
+MapPoint setProjPoint(Cube *icube, QPair<double, double> point, UserInterface &ui) {
+  TProjection *proj = (TProjection *) icube->projection();
+  // Get the sample/line position if we have an image point
+  if(ui.GetString("TYPE") == "IMAGE") {
+    checkImagePoint(icube, point, ui);
+    proj->SetWorld(point.first, point.second);
   }
 
   // Get the lat/lon position if we have a ground point
@@ -220,9 +307,30 @@ PvlGroup getProjPointInfo(Cube *icube, QPair<double, double> point, UserInterfac
     proj->SetCoordinate(x, y);
   }
 
+  MapPoint mapPoint;
+  mapPoint.sample = proj->WorldX();
+  mapPoint.line = proj->WorldY();
+  mapPoint.x = proj->XCoord();
+  mapPoint.y = proj->YCoord();
+  mapPoint.good = proj->IsGood();
+  mapPoint.universalLatitude = mapPoint.good ? proj->UniversalLatitude() : Null;
+  mapPoint.universalLongitude = mapPoint.good ? proj->UniversalLongitude() : Null;
+  return mapPoint;
+}
+
+
+/**
+ * Creates the results group for the location of one point.
+ */
+PvlGroup getProjPointInfo(Cube *icube, const MapPoint &point, UserInterface &ui) {
+  bool outsideAllowed = ui.GetBoolean("ALLOWOUTSIDE");
+  int cubeLineLimit = icube->lineCount() + .5;
+  int cubeSampleLimit = icube->sampleCount() + .5;
+  TProjection *proj = (TProjection *) icube->projection();
+
   PvlGroup results("Results");
-  if (proj->WorldX() < .5 || proj->WorldY() < .5 || proj->WorldX() > cubeSampleLimit ||
-      proj->WorldY() > cubeLineLimit) {
+  if (point.sample < .5 || point.line < .5 || point.sample > cubeSampleLimit ||
+      point.line > cubeLineLimit) {
     if (!outsideAllowed) {
       QString error = "Resulting line,sample is not on the image";
       throw IException(IException::Unknown, error, _FILEINFO_);
@@ -234,8 +342,8 @@ PvlGroup getProjPointInfo(Cube *icube, QPair<double, double> point, UserInterfac
 
   // Create Brick on samp, line to get the dn value of the pixel
   Brick b(1, 1, 1, icube->pixelType());
-  int intSamp = (int)(proj->WorldX() + 0.5);
-  int intLine = (int)(proj->WorldY() + 0.5);
+  int intSamp = (int)(point.sample + 0.5);
+  int intLine = (int)(point.line + 0.5);
   
   b.SetBasePosition(intSamp, intLine, 1);
   icube->read(b);
@@ -250,40 +358,40 @@ PvlGroup getProjPointInfo(Cube *icube, QPair<double, double> point, UserInterfac
   }
 
   // Log the position
-  if(proj->IsGood()) {
+  if(point.good) {
     results += PvlKeyword("Filename",
                           FileName(icube->fileName()).expanded());
-    results += PvlKeyword("Sample", toString(proj->WorldX()));
-    results += PvlKeyword("Line", toString(proj->WorldY()));
+    results += PvlKeyword("Sample", toString(point.sample));
+    results += PvlKeyword("Line", toString(point.line));
     results += PvlKeyword("Band", toString(icube->physicalBand(1)));
     results += PvlKeyword("FilterName", filterName);
     results += PvlKeyword("PixelValue", PixelToString(b[0]));
-    results += PvlKeyword("X", toString(proj->XCoord()));
-    results += PvlKeyword("Y", toString(proj->YCoord()));
+    results += PvlKeyword("X", toString(point.x));
+    results += PvlKeyword("Y", toString(point.y));
 
     // Put together all the keywords for different coordinate systems.
     PvlKeyword centLat =
-      PvlKeyword("PlanetocentricLatitude", toString(proj->UniversalLatitude()));
+      PvlKeyword("PlanetocentricLatitude", toString(point.universalLatitude));
 
     PvlKeyword graphLat =
       PvlKeyword("PlanetographicLatitude",
-                 toString(proj->ToPlanetographic(proj->UniversalLatitude())));
+                 toString(proj->ToPlanetographic(point.universalLatitude)));
 
     PvlKeyword pE360 =
-      PvlKeyword("PositiveEast360Longitude", toString(proj->UniversalLongitude()));
+      PvlKeyword("PositiveEast360Longitude", toString(point.universalLongitude));
 
     PvlKeyword pW360 =
       PvlKeyword("PositiveWest360Longitude",
-                 toString(proj->ToPositiveWest(proj->UniversalLongitude(), 360)));
+                 toString(proj->ToPositiveWest(point.universalLongitude, 360)));
 
     PvlKeyword pE180 =
       PvlKeyword("PositiveEast180Longitude",
-                 toString(proj->To180Domain(proj->UniversalLongitude())));
+                 toString(proj->To180Domain(point.universalLongitude)));
 
     PvlKeyword pW180 =
       PvlKeyword("PositiveWest180Longitude",
                  toString(proj->To180Domain(proj->ToPositiveEast(
-                            proj->UniversalLongitude(), 360))));
+                            point.universalLongitude, 360))));
 
 
     // Input map coordinate system location
@@ -1,8 +1,7 @@
 #include "Isis.h"
 #include "ProcessByBoxcar.h"
 #include "SpecialPixel.h"
-#include <algorithm>
-#include <vector>
+#include <cfloat>
 
 using namespace std;
 using namespace Isis;
@@ -14,12 +13,10 @@ bool filterLrs;
 bool filterLis;
 double low;
 double high;
-bool propagate;
-unsigned int  minimum;
 
-void FilterAll(Buffer &in, double &v);
-void FilterValid(Buffer &in, double &v);
-void FilterInvalid(Buffer &in, double &v);
+bool FilterAll(double centerPixel);
+bool FilterValid(double centerPixel);
+bool FilterInvalid(double centerPixel);
 
 void IsisMain() {
   //Set up ProcessByBoxcar
@@ -42,6 +39,7 @@ void IsisMain() {
   filterLrs  = ui.GetBoolean("LRS");
   filterHis  = ui.GetBoolean("HIS");
   filterLis  = ui.GetBoolean("LIS");
+  int minimum;
   if(ui.GetString("MINOPT") == "PERCENTAGE") {
     int size = lines * samples;
     double perc = ui.GetDouble("MINIMUM") / 100;
@@ -61,205 +59,67 @@ void IsisMain() {
 
   //Determine what to do if there are too few
   //non-Special pixels
-  propagate = (ui.GetString("REPLACEMENT") == "CENTER");
+  bool propagate = (ui.GetString("REPLACEMENT") == "CENTER");
+
+  //The median of the non-Special pixels between low and high
+  //is written to every filtered pixel
+  p.SetRankStatistic(ProcessByBoxcar::Median);
+  p.SetRankValidRange(low, high);
+  p.SetRankMinimumCount(minimum, propagate);
 
   //Check for filter style, and process accordingly
   if(ui.GetString("FILTER") == "ALL") {
-    p.StartProcess(FilterAll);
+    p.StartRankProcess(FilterAll);
     p.EndProcess();
   }
   else if(ui.GetString("FILTER") == "INSIDE") {
-    p.StartProcess(FilterValid);
+    p.StartRankProcess(FilterValid);
     p.EndProcess();
   }
   else if(ui.GetString("FILTER") == "OUTSIDE") {
-    p.StartProcess(FilterInvalid);
+    p.StartRankProcess(FilterInvalid);
     p.EndProcess();
   }
 }
 
-//Function which loops through every pixel in the boxcar,
-//and outputs the median value to the center pixel, if
-//the center pixel is valid.
-void FilterValid(Buffer &in, double &v) {
-  double centerPixel = in[(in.size()-1)/2];
-
-  //Check if the center pixel is a Special Pixel type to be
-  //filtered. If not, ignore the pixel and move on
+//Function to determine if the median should be written to
+//the center pixel regardless of its validity. Special Pixel
+//types the user did not select are left alone.
+bool FilterAll(double centerPixel) {
   if(IsSpecial(centerPixel)) {
     if((IsNullPixel(centerPixel)) && (!filterNull)) {
-      v = centerPixel;
-      return;
+      return false;
     }
     else if((IsLisPixel(centerPixel)) && (!filterLis)) {
-      v = centerPixel;
-      return;
+      return false;
     }
     else if((IsLrsPixel(centerPixel)) && (!filterLrs)) {
-      v = centerPixel;
-      return;
+      return false;
     }
     else if((IsHisPixel(centerPixel)) && (!filterHis)) {
-      v = centerPixel;
-      return;
+      return false;
     }
     else if((IsHrsPixel(centerPixel)) && (!filterHrs)) {
-      v = centerPixel;
-      return;
-    }
-  }
-  else if(centerPixel < low || centerPixel > high) {
-    v = centerPixel;
-    return;
-  }
-
-  //Build a vector containing the non-Special pixel values
-  //from the input buffer. If there are not enough to meet
-  //the minimum requirements, write a user-selected value
-  //to the center. If there are, sort the vector and write
-  //the median value to the center.
-  std::vector<double> boxdata(0);
-  for(int i = 0; i < in.size(); i++) {
-    if(!IsSpecial(in[i]) && in[i] >= low && in[i] <= high) {
-      boxdata.push_back(in[i]);
-    }
-    else {
-      continue;
+      return false;
     }
   }
-  if(boxdata.size() < minimum) {
-    if(propagate) {
-      v = centerPixel;
-      return;
-    }
-    else {
-      v = Isis::Null;
-      return;
-    }
-  }
-  sort(boxdata.begin(), boxdata.end());
-  v = boxdata[(boxdata.size()-1)/2];
+  return true;
 }
 
-//Function to loop through the boxcar and find and write
-//the median value to the center pixel, but only if the
-//center pixel is invalid
-void FilterInvalid(Buffer &in, double &v) {
-  double centerPixel = in[(in.size()-1)/2];
-
-  //Check for Special Pixels and handle according to user
-  //input.
-  if(IsSpecial(centerPixel)) {
-    if((IsNullPixel(centerPixel)) && (!filterNull)) {
-      v = centerPixel;
-      return;
-    }
-    else if((IsLisPixel(centerPixel)) && (!filterLis)) {
-      v = centerPixel;
-      return;
-    }
-    else if((IsLrsPixel(centerPixel)) && (!filterLrs)) {
-      v = centerPixel;
-      return;
-    }
-    else if((IsHisPixel(centerPixel)) && (!filterHis)) {
-      v = centerPixel;
-      return;
-    }
-    else if((IsHrsPixel(centerPixel)) && (!filterHrs)) {
-      v = centerPixel;
-      return;
-    }
-  }
-  else if(centerPixel >= low && centerPixel <= high) {
-    v = centerPixel;
-    return;
-  }
-
-  //Build a vector of non-Special pixel values from the
-  //input boxcar, then sort and find the median value.
-  //If there aren't enough to meet the minimum requirements,
-  //write a user-selected value to the center pixel.
-  std::vector<double> boxdata(0);
-
-  for(int i = 0; i < in.size(); i++) {
-    if(!IsSpecial(in[i]) && in[i] >= low && in[i] <= high) {
-      boxdata.push_back(in[i]);
-    }
-    else {
-      continue;
-    }
+//Function to determine if the median should be written to
+//the center pixel, only if the center pixel is valid
+bool FilterValid(double centerPixel) {
+  if(!IsSpecial(centerPixel) && (centerPixel < low || centerPixel > high)) {
+    return false;
   }
-  if(boxdata.size() < minimum) {
-    if(propagate) {
-      v = centerPixel;
-      return;
-    }
-    else {
-      v = Isis::Null;
-      return;
-    }
-  }
-  sort(boxdata.begin(), boxdata.end());
-  v = boxdata[(boxdata.size()-1)/2];
+  return FilterAll(centerPixel);
 }
 
-//Function to find the median value of the boxcar and
-//write it to the center, regardless of the validity
-//of the center pixel value
-void FilterAll(Buffer &in, double &v) {
-  double centerPixel = in[(in.size()-1)/2];
-
-  //Check for Special Pixels and handle according to user
-  //input.
-  if(IsSpecial(centerPixel)) {
-    if((IsNullPixel(centerPixel)) && (!filterNull)) {
-      v = centerPixel;
-      return;
-    }
-    else if((IsLisPixel(centerPixel)) && (!filterLis)) {
-      v = centerPixel;
-      return;
-    }
-    else if((IsLrsPixel(centerPixel)) && (!filterLrs)) {
-      v = centerPixel;
-      return;
-    }
-    else if((IsHisPixel(centerPixel)) && (!filterHis)) {
-      v = centerPixel;
-      return;
-    }
-    else if((IsHrsPixel(centerPixel)) && (!filterHrs)) {
-      v = centerPixel;
-      return;
-    }
-  }
-
-  //Build a vector of non-Special pixel values from the
-  //input boxcar, then sort and find the median value.
-  //If there aren't enough to meet the minimum requirements,
-  //write a user-selected value to the center pixel.
-  std::vector<double> boxdata(0);
-
-  for(int i = 0; i < in.size(); i++) {
-    if(!IsSpecial(in[i]) && in[i] >= low && in[i] <= high) {
-      boxdata.push_back(in[i]);
-    }
-    else {
-      continue;
-    }
-  }
-  if(boxdata.size() < minimum) {
-    if(propagate) {
-      v = centerPixel;
-      return;
-    }
-    else {
-      v = Isis::Null;
-      return;
-    }
+//Function to determine if the median should be written to
+//the center pixel, only if the center pixel is invalid
+bool FilterInvalid(double centerPixel) {
+  if(!IsSpecial(centerPixel) && centerPixel >= low && centerPixel <= high) {
+    return false;
   }
-  sort(boxdata.begin(), boxdata.end());
-  v = boxdata[(boxdata.size()-1)/2];
+  return FilterAll(centerPixel);
 }
-
@@ -12,6 +12,7 @@
 #include "TProjection.h"
 
 #include <cmath>
+#include <vector>
 
 using namespace std;
 using namespace Isis;
@@ -275,6 +276,19 @@ void IsisMain() {
    * @param out The output cube buffer.
    */
   auto phocube = [&](Buffer &in, Buffer &out)->void {
+    // Let the shape model trace the pixels of the brick together
+    if (!noCamera) {
+      std::vector<double> samples;
+      std::vector<double> lines;
+      for (int index = 0; index < 64 * 64; index++) {
+        if (specialPixels || !IsSpecial(in[index])) {
+          samples.push_back(out.Sample(index));
+          lines.push_back(out.Line(index));
+        }
+      }
+      cam->PrepareImages(samples, lines);
+    }
+
     for (int i = 0; i < 64; i++) {
       for (int j = 0; j < 64; j++) {
 
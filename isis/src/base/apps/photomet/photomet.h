@@ -0,0 +1,11 @@
+#ifndef photomet_h
+#define photomet_h
+
+#include "Pvl.h"
+#include "UserInterface.h"
+
+namespace Isis {
+  extern void photomet(UserInterface &ui, Pvl *log=nullptr);
+}
+
+#endif
@@ -3,7 +3,9 @@
 #include <sstream>
 
 #include <QDomElement>
+#include <QElapsedTimer>
 #include <QFile>
+#include <QLocalSocket>
 #include <QNetworkRequest>
 #include <QNetworkAccessManager>
 #include <QNetworkReply>
@@ -126,9 +128,17 @@ namespace Isis {
 
 
   /**
-   * This POSTS to the spice server
+   * This POSTS to the spice server, or sends the request to a local
+   * spiceserver if the url is local:<socket name>.
    */
   void SpiceClient::sendRequest() {
+    // Requests to a local spiceserver go through its socket instead of HTTP
+    if (p_request->url().scheme() == "local") {
+      sendLocalRequest(p_request->url().path());
+      quit();
+      return;
+    }
+
     p_networkMgr = new QNetworkAccessManager();
 
     connect(p_networkMgr, SIGNAL(finished(QNetworkReply *)),
@@ -160,194 +170,264 @@ namespace Isis {
   void SpiceClient::replyFinished(QNetworkReply *reply) {
     p_rawResponse = new QString(QString(reply->readAll()));
 
-    // Decode the response
-    p_response = new QString();
+    if (!readResponse()) {
+      if (reply->error() != QNetworkReply::NoError) {
+        *p_error = "An error occurred when talking to the server";
 
-    try {
-      *p_response = QString(
-          QByteArray::fromHex(QByteArray(p_rawResponse->toLatin1())).constData());
+        switch (reply->error()) {
+          case QNetworkReply::NoError:
+            break;
 
-      // Make sure we can get the log out of it before continuing
-      applicationLog();
-    }
-    catch(IException &) {
-      p_error = new QString();
+          case QNetworkReply::ConnectionRefusedError:
+            *p_error += ". The server refused the connection";
+            break;
 
-      // Well, the XML is bad, maybe it's PVL
-      try {
-        Pvl pvlTest;
-        stringstream s;
-        s << *p_rawResponse;
-        s >> pvlTest;
+          case QNetworkReply::RemoteHostClosedError:
+            *p_error += ". The server closed the connection";
+            break;
 
-        PvlGroup &err = pvlTest.findGroup("Error", Pvl::Traverse);
+          case QNetworkReply::HostNotFoundError:
+            *p_error += ". The server was not found";
+            break;
 
-        *p_error = "The Spice Server was unable to initialize the cube.";
+          case QNetworkReply::TimeoutError:
+            *p_error += ". The connection timed out";
+            break;
 
-        if (err.findKeyword("Message")[0] != "") {
-          *p_error += "  The error reported was: ";
-          *p_error += err.findKeyword("Message")[0];
-        }
-      }
-      catch(IException &) {
-        if (reply->error() != QNetworkReply::NoError) {
-          *p_error = "An error occurred when talking to the server";
+          case QNetworkReply::OperationCanceledError:
+            *p_error += ". We aborted the network operation";
+            break;
 
-          switch (reply->error()) {
-            case QNetworkReply::NoError:
-              break;
+          case QNetworkReply::SslHandshakeFailedError:
+            *p_error += ". Could not establish an encrypted connection";
+            break;
 
-            case QNetworkReply::ConnectionRefusedError:
-              *p_error += ". The server refused the connection";
-              break;
+          case QNetworkReply::TemporaryNetworkFailureError:
+            *p_error += ". There was a temporary network failure";
+            break;
 
-            case QNetworkReply::RemoteHostClosedError:
-              *p_error += ". The server closed the connection";
-              break;
+          case QNetworkReply::NetworkSessionFailedError:
+            *p_error += ". The connection was broken";
+            break;
 
-            case QNetworkReply::HostNotFoundError:
-              *p_error += ". The server was not found";
-              break;
+          case QNetworkReply::BackgroundRequestNotAllowedError:
+            *p_error += ". The background request is not allowed";
+            break;
 
-            case QNetworkReply::TimeoutError:
-              *p_error += ". The connection timed out";
-              break;
+          case QNetworkReply::TooManyRedirectsError:
+            *p_error += ". The maximum limit of redirects was reached";
+            break;
 
-            case QNetworkReply::OperationCanceledError:
-              *p_error += ". We aborted the network operation";
-              break;
+          case QNetworkReply::InsecureRedirectError:
+            *p_error += ". A redirect from https to http occurred";
+            break;
 
-            case QNetworkReply::SslHandshakeFailedError:
-              *p_error += ". Could not establish an encrypted connection";
-              break;
+          case QNetworkReply::ProxyConnectionRefusedError:
+            *p_error += ". The proxy server refused the connection";
+            break;
 
-            case QNetworkReply::TemporaryNetworkFailureError:
-              *p_error += ". There was a temporary network failure";
-              break;
+          case QNetworkReply::ProxyConnectionClosedError:
+            *p_error += ". The proxy server closed the connection";
+            break;
 
-            case QNetworkReply::NetworkSessionFailedError:
-              *p_error += ". The connection was broken";
-              break;
+          case QNetworkReply::ProxyNotFoundError:
+            *p_error += ". The proxy server could not be found";
+            break;
 
-            case QNetworkReply::BackgroundRequestNotAllowedError:
-              *p_error += ". The background request is not allowed";
-              break;
+          case QNetworkReply::ProxyTimeoutError:
+            *p_error += ". The connection to the proxy server timed out";
+            break;
 
-            case QNetworkReply::TooManyRedirectsError:
-              *p_error += ". The maximum limit of redirects was reached";
-              break;
+          case QNetworkReply::ProxyAuthenticationRequiredError:
+            *p_error += ". The proxy server requires authentication";
+            break;
 
-            case QNetworkReply::InsecureRedirectError:
-              *p_error += ". A redirect from https to http occurred";
-              break;
+          case QNetworkReply::ContentAccessDenied:
+            *p_error += ". Access to the remove content was denied (401)";
+            break;
 
-            case QNetworkReply::ProxyConnectionRefusedError:
-              *p_error += ". The proxy server refused the connection";
-              break;
+          case QNetworkReply::ContentOperationNotPermittedError:
+            *p_error += ". The operation requested on the server is not "
+                        "permitted";
+            break;
 
-            case QNetworkReply::ProxyConnectionClosedError:
-              *p_error += ". The proxy server closed the connection";
-              break;
+          case QNetworkReply::ContentNotFoundError:
+            *p_error += ". The spice server script was not found (404)";
+            break;
 
-            case QNetworkReply::ProxyNotFoundError:
-              *p_error += ". The proxy server could not be found";
-              break;
+          case QNetworkReply::AuthenticationRequiredError:
+            *p_error += ". The server requires authentication";
+            break;
 
-            case QNetworkReply::ProxyTimeoutError:
-              *p_error += ". The connection to the proxy server timed out";
-              break;
+          case QNetworkReply::ContentReSendError:
+            *p_error += ". The server requests for you to try again";
+            break;
 
-            case QNetworkReply::ProxyAuthenticationRequiredError:
-              *p_error += ". The proxy server requires authentication";
-              break;
+          case QNetworkReply::ContentConflictError:
+            *p_error += ". There is a conflict with the current state of the resource";
+            break;
 
-            case QNetworkReply::ContentAccessDenied:
-              *p_error += ". Access to the remove content was denied (401)";
-              break;
+          case QNetworkReply::ContentGoneError:
+            *p_error += ". The requested resource is no longer available";
+            break;
+
+          case QNetworkReply::InternalServerError:
+            *p_error += ". The server encountered an unexpected error";
+            break;
+
+          case QNetworkReply::OperationNotImplementedError:
+            *p_error += ". The server does not support the functionality required to "
+                        "the request";
+            break;
+
+          case QNetworkReply::ServiceUnavailableError:
+            *p_error += ". The server is unable to handle the request at this time.";
+            break;
+
+          case QNetworkReply::ProtocolUnknownError:
+            *p_error += ". The attempted network protocol is unknown";
+            break;
+
+          case QNetworkReply::ProtocolInvalidOperationError:
+            *p_error += ". The network protocol did not support this "
+                        "operation";
+            break;
+
+          case QNetworkReply::UnknownNetworkError:
+            *p_error += ". An unknown network-related error occurred";
+            break;
+
+          case QNetworkReply::UnknownProxyError:
+            *p_error += ". An unknown proxy-related error occurred";
+            break;
+
+          case QNetworkReply::UnknownContentError:
+            *p_error += ". An unknown content-related error occurred";
+            break;
+
+          case QNetworkReply::ProtocolFailure:
+            *p_error += ". A breakdown in the protocol was detected";
+            break;
+
+          case QNetworkReply::UnknownServerError:
+            *p_error += ". An unknown error related to the server occurred.";
+            break;
+        }
 
-            case QNetworkReply::ContentOperationNotPermittedError:
-              *p_error += ". The operation requested on the server is not "
-                          "permitted";
-              break;
+      }
+      else {
+        // Well, we really don't know what this is.
+        *p_error = "The server sent an unrecognized response";
+
+        if (*p_rawResponse != "") {
+          *p_error += " [";
+          *p_error += *p_rawResponse;
+          *p_error += "]";
+        }
+      }
+    }
 
-            case QNetworkReply::ContentNotFoundError:
-              *p_error += ". The spice server script was not found (404)";
-              break;
+    quit();
+  }
 
-            case QNetworkReply::AuthenticationRequiredError:
-              *p_error += ". The server requires authentication";
-              break;
 
-            case QNetworkReply::ContentReSendError:
-              *p_error += ". The server requests for you to try again";
-              break;
+  /**
+   * This sends the request to a spiceserver running on this machine that
+   * listens on a local socket, and waits for the response.
+   *
+   * @param socketName The name of the server's socket
+   */
+  void SpiceClient::sendLocalRequest(QString socketName) {
+    QLocalSocket socket;
+    socket.connectToServer(socketName);
 
-            case QNetworkReply::ContentConflictError:
-              *p_error += ". There is a conflict with the current state of the resource";
-              break;
+    // The server answers one request at a time, so this request may have to
+    //   wait for others before it is answered
+    const int responseTimeout = 600000;
 
-            case QNetworkReply::ContentGoneError:
-              *p_error += ". The requested resource is no longer available";
-              break;
+    QByteArray data;
+    bool timedOut = false;
+    if (socket.waitForConnected(30000)) {
+      socket.write(p_xml->toLatin1() + "\n");
+
+      // The server closes the connection after it sends the response
+      QElapsedTimer elapsed;
+      elapsed.start();
+      while (socket.state() == QLocalSocket::ConnectedState) {
+        int remaining = responseTimeout - (int)elapsed.elapsed();
+        if (remaining <= 0 || !socket.waitForReadyRead(remaining)) {
+          timedOut = (socket.error() == QLocalSocket::SocketTimeoutError) || remaining <= 0;
+          break;
+        }
+        data += socket.readAll();
+      }
+      data += socket.readAll();
+    }
 
-            case QNetworkReply::InternalServerError:
-              *p_error += ". The server encountered an unexpected error";
-              break;
-
-            case QNetworkReply::OperationNotImplementedError:
-              *p_error += ". The server does not support the functionality required to "
-                          "the request";
-              break;
+    p_rawResponse = new QString(QString(data));
 
-            case QNetworkReply::ServiceUnavailableError:
-              *p_error += ". The server is unable to handle the request at this time.";
-              break;
+    if (!readResponse() || timedOut) {
+      if (!p_error) {
+        p_error = new QString();
+      }
 
-            case QNetworkReply::ProtocolUnknownError:
-              *p_error += ". The attempted network protocol is unknown";
-              break;
+      if (timedOut) {
+        *p_error = "The local spice server [" + socketName + "] did not respond within [" +
+                   QString::number(responseTimeout / 1000) + "] seconds";
+      }
+      else {
+        *p_error = "Unable to get a response from the local spice server [" + socketName + "]";
+        if (socket.error() != QLocalSocket::UnknownSocketError) {
+          *p_error += ". " + socket.errorString();
+        }
+      }
+    }
+  }
 
-            case QNetworkReply::ProtocolInvalidOperationError:
-              *p_error += ". The network protocol did not support this "
-                          "operation";
-              break;
 
-            case QNetworkReply::UnknownNetworkError:
-              *p_error += ". An unknown network-related error occurred";
-              break;
+  /**
+   * This decodes the raw server response. If the server sent an error instead
+   * of SPICE data, the error is stored so it can be reported.
+   *
+   * @return bool False if the response is neither SPICE data nor an error, in
+   *              which case the error has yet to be filled in
+   */
+  bool SpiceClient::readResponse() {
+    // Decode the response
+    p_response = new QString();
 
-            case QNetworkReply::UnknownProxyError:
-              *p_error += ". An unknown proxy-related error occurred";
-              break;
+    try {
+      *p_response = QString(
+          QByteArray::fromHex(QByteArray(p_rawResponse->toLatin1())).constData());
 
-            case QNetworkReply::UnknownContentError:
-              *p_error += ". An unknown content-related error occurred";
-              break;
+      // Make sure we can get the log out of it before continuing
+      applicationLog();
+    }
+    catch(IException &) {
+      p_error = new QString();
+
+      // Well, the XML is bad, maybe it's PVL
+      try {
+        Pvl pvlTest;
+        stringstream s;
+        s << *p_rawResponse;
+        s >> pvlTest;
 
-            case QNetworkReply::ProtocolFailure:
-              *p_error += ". A breakdown in the protocol was detected";
-              break;
+        PvlGroup &err = pvlTest.findGroup("Error", Pvl::Traverse);
 
-            case QNetworkReply::UnknownServerError:
-              *p_error += ". An unknown error related to the server occurred.";
-              break;
-          }
+        *p_error = "The Spice Server was unable to initialize the cube.";
 
+        if (err.findKeyword("Message")[0] != "") {
+          *p_error += "  The error reported was: ";
+          *p_error += err.findKeyword("Message")[0];
         }
-        else {
-          // Well, we really don't know what this is.
-          *p_error = "The server sent an unrecognized response";
-
-          if (*p_rawResponse != "") {
-            *p_error += " [";
-            *p_error += *p_rawResponse;
-            *p_error += "]";
-          }
-        }
+      }
+      catch(IException &) {
+        return false;
       }
     }
 
-    quit();
+    return true;
   }
 
 
@@ -56,6 +56,8 @@ namespace Isis {
 
     private:
       static QString yesNo(bool boolVal);
+      void sendLocalRequest(QString socketName);
+      bool readResponse();
       Table *readTable(QString xmlName, QString tableName);
       QDomElement rootXMLElement();
       QDomElement findTag(QDomElement currentElement, QString name);
@@ -4,9 +4,19 @@
 #include <QDomDocument>
 #include <QDomElement>
 #include <QDomNode>
+#include <QEventLoop>
 #include <QFile>
+#include <QFutureWatcher>
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSharedPointer>
 #include <QString>
 #include <QStringList>
+#include <QThreadPool>
+#include <QTimer>
+#include <QtConcurrentRun>
 
 #include "Camera.h"
 #include "CameraFactory.h"
@@ -19,6 +29,7 @@
 #include "Process.h"
 #include "Pvl.h"
 #include "PvlToPvlTranslationManager.h"
+#include "Spice.h"
 #include "Table.h"
 #include "TextFile.h"
 #include "spiceserver.h"
@@ -27,18 +38,39 @@ using namespace std;
 
 
 namespace Isis {
-  bool g_ckSmithed = false;
-  bool g_ckRecon = false;
-  bool g_ckPredicted = false;
-  bool g_ckNadir = false;
-  bool g_spkSmithed = false;
-  bool g_spkRecon = false;
-  bool g_spkPredicted = false;
-  double g_startPad = 0.0;
-  double g_endPad = 0.0;
-  QString g_shapeKernelStr;
-
-  bool tryKernels(Cube &cube, UserInterface &ui, Pvl *log, Pvl &labels, Process &p,
+  /**
+   * The spiceinit parameters sent with a request.
+   */
+  struct SpiceParameters {
+    SpiceParameters() {
+      ckSmithed = false;
+      ckRecon = false;
+      ckPredicted = false;
+      ckNadir = false;
+      spkSmithed = false;
+      spkRecon = false;
+      spkPredicted = false;
+      startPad = 0.0;
+      endPad = 0.0;
+    }
+
+    bool ckSmithed;
+    bool ckRecon;
+    bool ckPredicted;
+    bool ckNadir;
+    bool spkSmithed;
+    bool spkRecon;
+    bool spkPredicted;
+    double startPad;
+    double endPad;
+    QString shapeKernelStr;
+  };
+
+  //! NAIF is not thread safe, so requests take turns finding kernels and creating cameras
+  QMutex g_naifMutex;
+
+  bool tryKernels(Cube &cube, Pvl *log, Pvl &labels, const SpiceParameters &parameters,
+                  QString outputFile,
                   Kernel lk, Kernel pck,
                   Kernel targetSpk, Kernel ck,
                   Kernel fk, Kernel ik,
@@ -46,56 +78,94 @@ namespace Isis {
                   Kernel iak, Kernel dem,
                   Kernel exk);
 
-  //! Combines all the temp files into one final output file
-  void packageKernels(QString toFile);
+  //! Combines all the temp files into the encoded response
+  QByteArray packageKernels(QString toFile);
 
   //! Read the spiceinit parameters
-  void parseParameters(QDomElement parametersElement);
+  void parseParameters(QDomElement parametersElement, SpiceParameters &parameters);
 
   //! Convert a table into an xml tag
   QString tableToXml(QString tableName, QString file);
 
+  //! Create the response to one encoded request
+  QByteArray processRequest(QString hexCode, QString requestName, bool checkVersion,
+                            QString tempFile, QString outputFile, Pvl *log);
+
+  //! Answer requests sent to a local socket until the server is idle
+  void serveRequests(UserInterface &ui);
+
   void spiceserver(UserInterface &ui, Pvl *log) {
+    if (ui.WasEntered("SOCKET")) {
+      serveRequests(ui);
+      return;
+    }
+
+    if (!ui.WasEntered("FROM") || !ui.WasEntered("TO")) {
+      QString msg = "Either the FROM and TO files or a SOCKET must be given";
+      throw IException(IException::User, msg, _FILEINFO_);
+    }
+
+    Process p;
+
+    // Get the single line of encoded XML from the input file that the client, spiceinit, sent us.
+    TextFile inFile( ui.GetFileName("FROM") );
+    QString hexCode;
+
+    // GetLine returns false if it was the last line... so we can't check for problems really
+    inFile.GetLine(hexCode);
+
+    /*
+     * For Debugging, you may want to run spiceserver locally (without spiceinit).
+     *
+     * Uncomment the following code and run the spiceinit with web=true. An error will be thrown
+     * with the file name of the stored input hex file. You can rsync that file to your work area
+     * and run spice server locally.
+     */
+    /*
+     * const char *inmode = "overwrite";
+     * const char *ext  = "dat";
+     * TextFile newInput;
+     * newInput.Open(QString("/tmp/spice_web_service/input"), inmode, ext);
+     * newInput.Rewind();//start at begining
+     * newInput.PutLine(hexCode);
+     * newInput.Close();
+     * QString msg = "In: " + ui.GetFileName("FROM") + "   " + ui.GetFileName("TO");
+     * throw IException(IException::Programmer, msg, _FILEINFO_);
+     */
+
+    QByteArray response = processRequest(hexCode, ui.GetFileName("FROM"),
+                                         ui.GetBoolean("CHECKVERSION"),
+                                         ui.GetFileName("TEMPFILE"), ui.GetFileName("TO"), log);
+
+    QFile finalOutput( ui.GetFileName("TO") );
+    finalOutput.open(QIODevice::WriteOnly);
+    finalOutput.write(response);
+    finalOutput.close();
+
+    p.EndProcess();
+  }
+
+
+  /**
+   * Finds the kernels for one request and creates the response to send back
+   * to spiceinit.
+   *
+   * @param hexCode The hex encoded request
+   * @param requestName The name of the request for error messages
+   * @param checkVersion Whether to reject requests from old versions of Isis
+   * @param tempFile The template for the temporary cube created from the labels
+   * @param outputFile The base name of the temporary files the response is
+   *                   assembled from
+   * @param log The Pvl that attempted kernel sets will be logged to
+   *
+   * @return QByteArray The hex encoded response
+   */
+  QByteArray processRequest(QString hexCode, QString requestName, bool checkVersion,
+                            QString tempFile, QString outputFile, Pvl *log) {
+    QByteArray response;
 
     try {
-      Process p;
-
-      g_ckSmithed = false;
-      g_ckRecon = false;
-      g_ckPredicted = false;
-      g_ckNadir = false;
-      g_spkSmithed = false;
-      g_spkRecon = false;
-      g_spkPredicted = false;
-      g_shapeKernelStr = "";
-      g_startPad = 0.0;
-      g_endPad = 0.0;
-
-      // Get the single line of encoded XML from the input file that the client, spiceinit, sent us.
-      TextFile inFile( ui.GetFileName("FROM") );
-      QString hexCode;
-      
-      // GetLine returns false if it was the last line... so we can't check for problems really
-      inFile.GetLine(hexCode);
-
-      /*
-       * For Debugging, you may want to run spiceserver locally (without spiceinit).
-       *
-       * Uncomment the following code and run the spiceinit with web=true. An error will be thrown
-       * with the file name of the stored input hex file. You can rsync that file to your work area
-       * and run spice server locally.
-       */
-      /*
-       * const char *inmode = "overwrite";
-       * const char *ext  = "dat";
-       * TextFile newInput;
-       * newInput.Open(QString("/tmp/spice_web_service/input"), inmode, ext);
-       * newInput.Rewind();//start at begining
-       * newInput.PutLine(hexCode);
-       * newInput.Close();
-       * QString msg = "In: " + ui.GetFileName("FROM") + "   " + ui.GetFileName("TO");
-       * throw IException(IException::Programmer, msg, _FILEINFO_);
-       */
+      SpiceParameters parameters;
 
       Pvl label;
       label.clear();
@@ -124,7 +194,7 @@ namespace Isis {
             }
             else if (element.tagName() == "parameters") {
               // Read the spiceinit parameters
-              parseParameters(element);
+              parseParameters(element, parameters);
             }
             else if (element.tagName() == "label") {
               // Get the cube label
@@ -149,7 +219,7 @@ namespace Isis {
       }
 
 
-      if (ui.GetBoolean("CHECKVERSION") ) {
+      if (checkVersion) {
         QStringList remoteVersion = otherVersion.split(QRegExp("\\s+"))[0].split(QRegExp("\\."));
         if ( remoteVersion[0].toInt() <= 3 && remoteVersion[1].toInt() < 5) {
 
@@ -178,13 +248,17 @@ namespace Isis {
       unsigned int allowed = 0;
       unsigned int allowedCK = 0;
       unsigned int allowedSPK = 0;
-      if (g_ckPredicted)  allowedCK |= Kernel::typeEnum("PREDICTED");
-      if (g_ckRecon)      allowedCK |= Kernel::typeEnum("RECONSTRUCTED");
-      if (g_ckSmithed)    allowedCK |= Kernel::typeEnum("SMITHED");
-      if (g_ckNadir)      allowedCK |= Kernel::typeEnum("NADIR");
-      if (g_spkPredicted) allowedSPK |= Kernel::typeEnum("PREDICTED");
-      if (g_spkRecon)     allowedSPK |= Kernel::typeEnum("RECONSTRUCTED");
-      if (g_spkSmithed)   allowedSPK |= Kernel::typeEnum("SMITHED");
+      if (parameters.ckPredicted)  allowedCK |= Kernel::typeEnum("PREDICTED");
+      if (parameters.ckRecon)      allowedCK |= Kernel::typeEnum("RECONSTRUCTED");
+      if (parameters.ckSmithed)    allowedCK |= Kernel::typeEnum("SMITHED");
+      if (parameters.ckNadir)      allowedCK |= Kernel::typeEnum("NADIR");
+      if (parameters.spkPredicted) allowedSPK |= Kernel::typeEnum("PREDICTED");
+      if (parameters.spkRecon)     allowedSPK |= Kernel::typeEnum("RECONSTRUCTED");
+      if (parameters.spkSmithed)   allowedSPK |= Kernel::typeEnum("SMITHED");
+
+      // Kernel searches read leap seconds through NAIF, so everything from here on
+      //   waits for the other requests
+      QMutexLocker naifLocker(&g_naifMutex);
 
       KernelDb baseKernels(allowed);
       KernelDb ckKernels(allowedCK);
@@ -206,7 +280,7 @@ namespace Isis {
       ck        = ckKernels.spacecraftPointing(label);
       spk       = spkKernels.spacecraftPosition(label);
 
-      if (g_ckNadir) {
+      if (parameters.ckNadir) {
         // Only add nadir if no spacecraft pointing found
         QStringList nadirCk;
         nadirCk.push_back("Nadir");
@@ -223,12 +297,12 @@ namespace Isis {
       }
 
       // Get shape kernel
-      if (g_shapeKernelStr == "system") {
+      if (parameters.shapeKernelStr == "system") {
         dem = baseKernels.dem(label);
       }
-      else if (g_shapeKernelStr != "ellipsoid") {
+      else if (parameters.shapeKernelStr != "ellipsoid") {
         stringstream demPvlKeyStream;
-        demPvlKeyStream << "ShapeModel = " + g_shapeKernelStr;
+        demPvlKeyStream << "ShapeModel = " + parameters.shapeKernelStr;
         PvlKeyword key;
         demPvlKeyStream >> key;
 
@@ -242,7 +316,7 @@ namespace Isis {
       if (ck.size() == 0 || ck.at(0).size() == 0) {
         throw IException(IException::Unknown,
                          "No Camera Kernel found for the image [" +
-                          ui.GetFileName("FROM") + "]",
+                          requestName + "]",
                          _FILEINFO_);
       }
 
@@ -289,11 +363,11 @@ namespace Isis {
          *
          * This program has read and write access on the spice server in /tmp/spice_web_service.
          */
-        inputLabels = FileName::createTempFile( ui.GetFileName("TEMPFILE") );
+        inputLabels = FileName::createTempFile(tempFile);
         label.write( inputLabels.expanded() );
         Cube cube;
         cube.open(inputLabels.expanded(), "rw");
-        kernelSuccess = tryKernels(cube, ui, log, label, p, lk, pck, targetSpk,
+        kernelSuccess = tryKernels(cube, log, label, parameters, outputFile, lk, pck, targetSpk,
                                    realCkKernel, fk, ik, sclk, spk,
                                    iak, dem, exk);
       }
@@ -302,14 +376,13 @@ namespace Isis {
         throw IException(IException::Unknown, "Unable to initialize camera model", _FILEINFO_);
       }
       else {
-        packageKernels( ui.GetFileName("TO") );
+        response = packageKernels(outputFile);
       }
       remove( inputLabels.expanded().toLatin1() ); //clean up
-      p.EndProcess();
     }
     catch (...) {
       // We failed at something, delete the temp files...
-      QString outFile = ui.GetFileName("TO");
+      QString outFile = outputFile;
       QFile pointingFile(outFile + ".pointing");
       if ( pointingFile.exists() ) pointingFile.remove();
 
@@ -324,9 +397,12 @@ namespace Isis {
 
       throw;
     }
+
+    return response;
   }
 
-  bool tryKernels(Cube &cube, UserInterface &ui, Pvl *log, Pvl &lab, Process &p,
+  bool tryKernels(Cube &cube, Pvl *log, Pvl &lab, const SpiceParameters &parameters,
+                  QString outputFile,
                   Kernel lk, Kernel pck,
                   Kernel targetSpk, Kernel ck,
                   Kernel fk, Kernel ik, Kernel sclk,
@@ -426,11 +502,11 @@ namespace Isis {
       currentKernels.deleteKeyword("EndPadding");
 
     // Add any time padding the user specified to the spice group
-    if (g_startPad > DBL_EPSILON)
-      currentKernels.addKeyword( PvlKeyword("StartPadding", toString(g_startPad), "seconds") );
+    if (parameters.startPad > DBL_EPSILON)
+      currentKernels.addKeyword( PvlKeyword("StartPadding", toString(parameters.startPad), "seconds") );
 
-    if (g_endPad > DBL_EPSILON)
-      currentKernels.addKeyword( PvlKeyword("EndPadding", toString(g_endPad), "seconds") );
+    if (parameters.endPad > DBL_EPSILON)
+      currentKernels.addKeyword( PvlKeyword("EndPadding", toString(parameters.endPad), "seconds") );
 
 
     currentKernels.addKeyword(
@@ -440,15 +516,15 @@ namespace Isis {
     cube.putGroup(currentKernels);
 
     // Create the camera so we can get blobs if necessary
+    Camera *cam = NULL;
     try {
-      Camera *cam = NULL;
       try {
         cam = CameraFactory::Create(cube);
 
         // If success then pretend we had the shape model keyword in there...
         Pvl applicationLog;
         applicationLog += currentKernels;
-        applicationLog.write(ui.GetFileName("TO") + ".print");
+        applicationLog.write(outputFile + ".print");
       }
       catch (IException &e) {
         Pvl errPvl = e.toPvl();
@@ -468,7 +544,7 @@ namespace Isis {
       for (int i = 0; i < ckKeyword.size(); i++)
         ckTable.Label()["Kernels"].addValue(ckKeyword[i]);
 
-      ckTable.Write(ui.GetFileName("TO") + ".pointing");
+      ckTable.Write(outputFile + ".pointing");
 
       Table spkTable = cam->instrumentPosition()->Cache("InstrumentPosition");
       spkTable.Label() += PvlKeyword("Description", "Created by spiceinit");
@@ -476,7 +552,7 @@ namespace Isis {
       for (int i = 0; i < spkKeyword.size(); i++)
         spkTable.Label()["Kernels"].addValue(spkKeyword[i]);
 
-      spkTable.Write(ui.GetFileName("TO") + ".position");
+      spkTable.Write(outputFile + ".position");
 
       Table bodyTable = cam->bodyRotation()->Cache("BodyRotation");
       bodyTable.Label() += PvlKeyword("Description", "Created by spiceinit");
@@ -488,7 +564,7 @@ namespace Isis {
         bodyTable.Label()["Kernels"].addValue(pckKeyword[i]);
 
       bodyTable.Label() += PvlKeyword( "SolarLongitude", toString( cam->solarLongitude().degrees() ) );
-      bodyTable.Write(ui.GetFileName("TO") + ".bodyrot");
+      bodyTable.Write(outputFile + ".bodyrot");
 
       Table sunTable = cam->sunPosition()->Cache("SunPosition");
       sunTable.Label() += PvlKeyword("Description", "Created by spiceinit");
@@ -496,7 +572,7 @@ namespace Isis {
       for (int i = 0; i < targetSpkKeyword.size(); i++)
         sunTable.Label()["Kernels"].addValue(targetSpkKeyword[i]);
 
-      sunTable.Write(ui.GetFileName("TO") + ".sun");
+      sunTable.Write(outputFile + ".sun");
 
       //  Save original kernels in keyword before changing to Table
       PvlKeyword origCk = currentKernels["InstrumentPointing"];
@@ -518,9 +594,13 @@ namespace Isis {
       Pvl kernelsLabels;
       kernelsLabels += currentKernels;
       kernelsLabels += cam->getStoredNaifKeywords();
-      kernelsLabels.write(ui.GetFileName("TO") + ".lab");
+      kernelsLabels.write(outputFile + ".lab");
+
+      delete cam;
     }
     catch (IException &) {
+      // The kernels of a failed attempt must not answer for the next one
+      delete cam;
       lab = origLabels;
       return false;
     }
@@ -550,7 +630,7 @@ namespace Isis {
   }
 
 
-  void parseParameters(QDomElement parametersElement) {
+  void parseParameters(QDomElement parametersElement, SpiceParameters &parameters) {
     for ( QDomNode node = parametersElement.firstChild();
           !node .isNull();
           node = node.nextSibling() ) {
@@ -559,58 +639,58 @@ namespace Isis {
       if (element.tagName() == "cksmithed") {
         QDomNode node = element.attributes().namedItem("value");
         QDomAttr attribute = *( (QDomAttr *)&node );
-        g_ckSmithed = (attribute.value().toLower() == "yes");
+        parameters.ckSmithed = (attribute.value().toLower() == "yes");
       }
       else if (element.tagName() == "ckrecon") {
         QDomNode node = element.attributes().namedItem("value");
         QDomAttr attribute = *( (QDomAttr *)&node );
-        g_ckRecon = (attribute.value().toLower() == "yes");
+        parameters.ckRecon = (attribute.value().toLower() == "yes");
       }
       else if (element.tagName() == "ckpredicted") {
         QDomNode node = element.attributes().namedItem("value");
         QDomAttr attribute = *( (QDomAttr *)&node );
-        g_ckPredicted = (attribute.value().toLower() == "yes");
+        parameters.ckPredicted = (attribute.value().toLower() == "yes");
       }
       else if (element.tagName() == "cknadir") {
         QDomNode node = element.attributes().namedItem("value");
         QDomAttr attribute = *( (QDomAttr *)&node );
-        g_ckNadir = (attribute.value().toLower() == "yes");
+        parameters.ckNadir = (attribute.value().toLower() == "yes");
       }
       else if (element.tagName() == "spksmithed") {
         QDomNode node = element.attributes().namedItem("value");
         QDomAttr attribute = *( (QDomAttr *)&node );
-        g_spkSmithed = (attribute.value().toLower() == "yes");
+        parameters.spkSmithed = (attribute.value().toLower() == "yes");
       }
       else if (element.tagName() == "spkrecon") {
         QDomNode node = element.attributes().namedItem("value");
         QDomAttr attribute = *( (QDomAttr *)&node );
-        g_spkRecon = (attribute.value().toLower() == "yes");
+        parameters.spkRecon = (attribute.value().toLower() == "yes");
       }
       else if (element.tagName() == "spkpredicted") {
         QDomNode node = element.attributes().namedItem("value");
         QDomAttr attribute = *( (QDomAttr *)&node );
-        g_spkPredicted = (attribute.value().toLower() == "yes");
+        parameters.spkPredicted = (attribute.value().toLower() == "yes");
       }
       else if (element.tagName() == "shape") {
         QDomNode node = element.attributes().namedItem("value");
         QDomAttr attribute = *( (QDomAttr *)&node );
-        g_shapeKernelStr = attribute.value();
+        parameters.shapeKernelStr = attribute.value();
       }
       else if (element.tagName() == "startpad") {
         QDomNode node = element.attributes().namedItem("time");
         QDomAttr attribute = *( (QDomAttr *)&node );
-        g_startPad = attribute.value().toDouble();
+        parameters.startPad = attribute.value().toDouble();
       }
       else if (element.tagName() == "endpad") {
         QDomNode node = element.attributes().namedItem("time");
         QDomAttr attribute = *( (QDomAttr *)&node );
-        g_endPad = attribute.value().toDouble();
+        parameters.endPad = attribute.value().toDouble();
       }
     }
   }
 
 
-  void packageKernels(QString toFile) {
+  QByteArray packageKernels(QString toFile) {
     QString xml;
     xml += "<spice_data>\n";
 
@@ -644,11 +724,128 @@ namespace Isis {
 
     xml += "  </tables>\n";
     xml += "</spice_data>\n";
-    QString encodedXml( QByteArray( xml.toLatin1() ).toHex().constData() );
+    return xml.toLatin1().toHex();
+  }
 
-    QFile finalOutput(toFile);
-    finalOutput.open(QIODevice::WriteOnly);
-    finalOutput.write( encodedXml.toLatin1() );
-    finalOutput.close();
+
+  /**
+   * Creates the response to a request sent to the local socket. Errors are
+   * returned as Pvl, which is what spiceinit expects from a server that was
+   * unable to initialize the cube.
+   *
+   * @param hexCode The hex encoded request
+   * @param checkVersion Whether to reject requests from old versions of Isis
+   * @param tempFile The template for the temporary files used by the request
+   *
+   * @return QByteArray The response to send back to spiceinit
+   */
+  QByteArray answerRequest(QString hexCode, bool checkVersion, QString tempFile) {
+    try {
+      // Every request needs its own temporary files
+      FileName outputFile = FileName::createTempFile(tempFile);
+      QByteArray response;
+      try {
+        response = processRequest(hexCode, "request", checkVersion, tempFile,
+                                  outputFile.expanded(), NULL);
+      }
+      catch (IException &) {
+        QFile::remove( outputFile.expanded() );
+        throw;
+      }
+      QFile::remove( outputFile.expanded() );
+      return response;
+    }
+    catch (IException &e) {
+      stringstream errorStream;
+      errorStream << e.toPvl();
+      return QByteArray( errorStream.str().c_str() );
+    }
+  }
+
+
+  /**
+   * Answers requests from spiceinit URL=local:<socket> until the server has
+   * been idle for IDLETIMEOUT seconds. Each connection sends one line with the
+   * same encoded request that the FROM file holds, and gets the encoded
+   * response back before the connection is closed.
+   *
+   * Connections are answered concurrently, but NAIF is not thread safe, so the
+   * requests take turns with the kernels. The kernels stay loaded between
+   * requests, up to MAXKERNELS of them, so images from the same mission do not
+   * load the same kernels again. Kernels a request does not list are unloaded
+   * before it is answered.
+   *
+   * @param ui The user interface with the SOCKET parameters
+   */
+  void serveRequests(UserInterface &ui) {
+    QString socketName = ui.GetFileName("SOCKET");
+    bool checkVersion = ui.GetBoolean("CHECKVERSION");
+    QString tempFile = ui.GetFileName("TEMPFILE");
+    int idleTimeout = ui.GetInteger("IDLETIMEOUT");
+
+    // Clean up after a server that did not shut down
+    QLocalServer::removeServer(socketName);
+
+    QLocalServer server;
+    server.setSocketOptions(QLocalServer::UserAccessOption);
+    if ( !server.listen(socketName) ) {
+      QString msg = "Unable to listen for spiceinit requests on [" + socketName + "]. " +
+                    server.errorString();
+      throw IException(IException::User, msg, _FILEINFO_);
+    }
+
+    Spice::setMaximumResidentKernels( ui.GetInteger("MAXKERNELS") );
+
+    QThreadPool pool;
+    QEventLoop loop;
+    QTimer idleTimer;
+    idleTimer.setSingleShot(true);
+    idleTimer.setInterval(idleTimeout * 1000);
+    QObject::connect(&idleTimer, &QTimer::timeout, &loop, &QEventLoop::quit);
+
+    int activeRequests = 0;
+    QObject::connect(&server, &QLocalServer::newConnection, [&]() {
+      while ( server.hasPendingConnections() ) {
+        QLocalSocket *socket = server.nextPendingConnection();
+        activeRequests++;
+        idleTimer.stop();
+
+        QObject::connect(socket, &QLocalSocket::disconnected,
+                         socket, &QLocalSocket::deleteLater);
+        QObject::connect(socket, &QObject::destroyed, &idleTimer, [&]() {
+          activeRequests--;
+          if (activeRequests == 0 && idleTimeout > 0) {
+            idleTimer.start();
+          }
+        });
+
+        QObject::connect(socket, &QLocalSocket::readyRead, socket, [&, socket]() {
+          // The request is a single line, which only gets answered once
+          if ( !socket->canReadLine() ||
+               socket->findChild< QFutureWatcher<QByteArray> * >() ) {
+            return;
+          }
+          QString hexCode = QString::fromLatin1( socket->readLine() ).trimmed();
+
+          QFutureWatcher<QByteArray> *watcher = new QFutureWatcher<QByteArray>(socket);
+          QObject::connect(watcher, &QFutureWatcherBase::finished, socket, [socket, watcher]() {
+            socket->write( watcher->result() );
+            socket->disconnectFromServer();
+          });
+          watcher->setFuture( QtConcurrent::run(&pool, answerRequest,
+                                                hexCode, checkVersion, tempFile) );
+        });
+      }
+    });
+
+    if (idleTimeout > 0) {
+      idleTimer.start();
+    }
+    loop.exec();
+
+    server.close();
+    pool.waitForDone();
+    Spice::unloadResidentKernels();
+    Spice::setMaximumResidentKernels(0);
   }
 };
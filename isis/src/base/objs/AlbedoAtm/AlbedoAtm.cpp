@@ -22,6 +22,11 @@ namespace Isis {
    */
   AlbedoAtm::AlbedoAtm(Pvl &pvl, PhotoModel &pmodel, AtmosModel &amodel) :
     NormModel(pvl, pmodel, amodel) {
+    p_normOldPhase = -9999;
+    p_normOldIncidence = -9999;
+    p_normOldEmission = -9999;
+    p_normOldDemincidence = -9999;
+    p_normOldDememission = -9999;
     PvlGroup &algo = pvl.findObject("NormalizationModel")
                      .findGroup("Algorithm", Pvl::Traverse);
     // Set default value
@@ -86,9 +91,6 @@ namespace Isis {
   void AlbedoAtm::NormModelAlgorithm(double phase, double incidence, double emission,
                                      double demincidence, double dememission, double dn,
                                      double &albedo, double &mult, double &base) {
-    static double psurf;
-    static double ahInterp;
-    static double munot;
     double pstd;
     double trans;
     double trans0;
@@ -103,27 +105,23 @@ namespace Isis {
     double fourthterm;
     double fifthterm;
 
-    static double old_phase = -9999;
-    static double old_incidence = -9999;
-    static double old_emission = -9999;
-    static double old_demincidence = -9999;
-    static double old_dememission = -9999;
+    if (p_normOldPhase != phase || p_normOldIncidence != incidence ||
+        p_normOldEmission != emission || p_normOldDemincidence != demincidence ||
+        p_normOldDememission != dememission) {
 
-    if (old_phase != phase || old_incidence != incidence || old_emission != emission ||
-        old_demincidence != demincidence || old_dememission != dememission) {
+      p_normPsurf = GetPhotoModel()->CalcSurfAlbedo(phase, demincidence,
+                                                    dememission);
 
-      psurf = GetPhotoModel()->CalcSurfAlbedo(phase, demincidence,
-                                              dememission);
+      p_normAhInterp = (GetAtmosModel()->AtmosAhSpline()).Evaluate(incidence,
+                           NumericalApproximation::Extrapolate);
 
-      ahInterp = (GetAtmosModel()->AtmosAhSpline()).Evaluate(incidence, NumericalApproximation::Extrapolate);
+      p_normMunot = cos(incidence * (PI / 180.0));
 
-      munot = cos(incidence * (PI / 180.0));
-
-      old_phase = phase;
-      old_incidence = incidence;
-      old_emission = emission;
-      old_demincidence = demincidence;
-      old_dememission = dememission;
+      p_normOldPhase = phase;
+      p_normOldIncidence = incidence;
+      p_normOldEmission = emission;
+      p_normOldDemincidence = demincidence;
+      p_normOldDememission = dememission;
     }
 
     GetAtmosModel()->CalcAtmEffect(phase, incidence, emission, &pstd, &trans, &trans0, &p_normSbar,
@@ -131,8 +129,8 @@ namespace Isis {
 
     // With model at actual geometry, calculate rho from dn
     dpo = dn - pstd;
-    dpm = (psurf - ahInterp * munot) * trans0;
-    q = ahInterp * munot * trans + GetAtmosModel()->AtmosAb() * p_normSbar * dpo + dpm;
+    dpm = (p_normPsurf - p_normAhInterp * p_normMunot) * trans0;
+    q = p_normAhInterp * p_normMunot * trans + GetAtmosModel()->AtmosAb() * p_normSbar * dpo + dpm;
 
     if(dpo <= 0.0 && GetAtmosModel()->AtmosNulneg()) {
       rho = 0.0;
@@ -6,6 +6,7 @@
 #include "NumericalApproximation.h"
 #include "NumericalAtmosApprox.h"
 #include "PhotoModel.h"
+#include "PhotometricTable.h"
 #include "Minnaert.h"
 #include "LunarLambert.h"
 #include "Plugin.h"
@@ -477,6 +478,18 @@ namespace Isis {
     //  throw IException::Message(IException::Programmer,msg,_FILEINFO_);
     //}
 
+    // Use the table of effects when there is one
+    double values[5];
+    if (!p_atmosTable.isNull() && !p_standardConditions &&
+        p_atmosTable->interpolate(pha, inc, ema, values)) {
+      *pstd = values[0];
+      *trans = values[1];
+      *trans0 = values[2];
+      *sbar = values[3];
+      *transs = values[4];
+      return;
+    }
+
     // Apply atmospheric function
     AtmosModelAlgorithm(pha, inc, ema);
     *pstd = p_pstd;
@@ -486,6 +499,49 @@ namespace Isis {
     *transs = p_transs;
   }
 
+  /**
+   * Tabulate the atmospheric effects so CalcAtmEffect interpolates them
+   * instead of evaluating the atmospheric function. The table is made from
+   * the current parameters and is not used under standard conditions. If
+   * no table small enough to keep meets the tolerance, the atmospheric function
+   * is still evaluated for every pixel and Table() returns a null pointer.
+   *
+   * @param tolerance The largest difference allowed between each of the
+   *                  effects and the table
+   */
+  void AtmosModel::GenerateTable(double tolerance) {
+    p_atmosTable.clear();
+    QSharedPointer<const PhotometricTable> table(
+        new PhotometricTable(TableFunction, this, 5, tolerance));
+    if (!table->isEmpty()) {
+      p_atmosTable = table;
+    }
+  }
+
+  /**
+   * Use a table generated by another copy of this atmospheric model with the
+   * same parameters.
+   *
+   * @param table The table, or a null pointer to stop using a table
+   */
+  void AtmosModel::SetTable(QSharedPointer<const PhotometricTable> table) {
+    p_atmosTable = table;
+  }
+
+  /**
+   * Evaluates the atmospheric function for PhotometricTable.
+   */
+  void AtmosModel::TableFunction(double phase, double incidence, double emission,
+                                 double *values, void *model) {
+    AtmosModel *atmosModel = (AtmosModel *) model;
+    atmosModel->AtmosModelAlgorithm(phase, incidence, emission);
+    values[0] = atmosModel->p_pstd;
+    values[1] = atmosModel->p_trans;
+    values[2] = atmosModel->p_trans0;
+    values[3] = atmosModel->p_sbar;
+    values[4] = atmosModel->p_transs;
+  }
+
   /**
    * Used to calculate atmosphere at standard conditions
    */
@@ -25,12 +25,14 @@
 
 #include <string>
 #include <vector>
+#include <QSharedPointer>
 #include "PhotoModel.h"
 #include "NumericalApproximation.h"
 #include "NumericalAtmosApprox.h"
 
 using namespace std;
 namespace Isis {
+  class PhotometricTable;
   class Pvl;
 
   /**
@@ -86,6 +88,13 @@ namespace Isis {
       // Calculate atmospheric scattering effect
       void CalcAtmEffect(double pha, double inc, double ema, double *pstd,
                          double *trans, double *trans0, double *sbar, double *transs);
+      // Tabulate the atmospheric scattering effect
+      void GenerateTable(double tolerance);
+      void SetTable(QSharedPointer<const PhotometricTable> table);
+      //! Return the table of atmospheric effects, or a null pointer if there is none
+      QSharedPointer<const PhotometricTable> Table() const {
+        return p_atmosTable;
+      }
       // Used to calculate atmosphere at standard conditions
       virtual void SetStandardConditions(bool standard);
       // Obtain hemispheric and bihemispheric albedo by integrating the photometric function
@@ -313,6 +322,12 @@ namespace Isis {
 
       double p_atmosTauold;
       double p_atmosWhaold;
+
+      static void TableFunction(double phase, double incidence, double emission,
+                                double *values, void *model);
+
+      //! The atmospheric effects on a grid of angles, used outside of standard conditions
+      QSharedPointer<const PhotometricTable> p_atmosTable;
       friend class NumericalAtmosApprox;
   };
 };
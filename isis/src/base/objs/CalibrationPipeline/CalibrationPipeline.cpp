@@ -0,0 +1,247 @@
+/**
+ * @file
+ *
+ *   Unless noted otherwise, the portions of Isis written by the USGS are public
+ *   domain. See individual third-party library and package descriptions for
+ *   intellectual property information,user agreements, and related information.
+ *
+ *   Although Isis has been used by the USGS, no warranty, expressed or implied,
+ *   is made by the USGS as to the accuracy and functioning of such software
+ *   and related material nor shall the fact of distribution constitute any such
+ *   warranty, and no responsibility is assumed by the USGS in connection
+ *   therewith.
+ *
+ *   For additional information, launch
+ *   $ISISROOT/doc//documents/Disclaimers/Disclaimers.html in a browser or see
+ *   the Privacy &amp; Disclaimers page on the Isis website,
+ *   http://isis.astrogeology.usgs.gov, and the USGS privacy and disclaimers on
+ *   http://www.usgs.gov/privacy.html.
+ */
+#include "CalibrationPipeline.h"
+
+#include "Buffer.h"
+#include "IException.h"
+#include "IString.h"
+#include "SpecialPixel.h"
+
+using namespace std;
+
+namespace Isis {
+
+  //! Constructs an empty pipeline that copies its input
+  CalibrationPipeline::CalibrationPipeline() {
+    m_statistics = 0;
+  }
+
+
+  //! Destroys the pipeline
+  CalibrationPipeline::~CalibrationPipeline() {
+  }
+
+
+  /**
+   * Appends a stage that changes each valid pixel by a coefficient
+   *
+   * @param operation How the stage changes a pixel
+   * @param name The name of the stage used in error messages. For a
+   *             LineStatistic stage, this is the name of the statistic.
+   * @param source Where the coefficient of each pixel comes from
+   * @param coefficients One constant, one coefficient per sample or one
+   *                     coefficient per line. Unused for LineStatistic stages.
+   *
+   * @throws IException::Programmer "The constant stage needs exactly one coefficient"
+   * @throws IException::Programmer "No line statistic with this name has been added"
+   */
+  void CalibrationPipeline::addStage(Operation operation, const QString &name, Source source,
+                                     const std::vector<double> &coefficients) {
+    Stage stage;
+    stage.name = name;
+    stage.isStatistic = false;
+    stage.operation = operation;
+    stage.source = source;
+    stage.coefficients = coefficients;
+    stage.statisticIndex = -1;
+
+    if (source == Constant && coefficients.size() != 1) {
+      QString msg = "The constant stage [" + name + "] needs exactly one coefficient";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    if (source == LineStatistic) {
+      stage.statisticIndex = statisticIndex(name);
+      if (stage.statisticIndex < 0) {
+        QString msg = "No line statistic named [" + name + "] has been added to the pipeline";
+        throw IException(IException::Programmer, msg, _FILEINFO_);
+      }
+    }
+
+    m_stages.push_back(stage);
+  }
+
+
+  /**
+   * Appends a stage that computes a statistic from the valid pixels of the
+   * line as they are at this point of the pipeline. Later LineStatistic stages
+   * use the statistic by name. If a line has no valid pixels, the rest of the
+   * pipeline is skipped for that line.
+   *
+   * @param name The name of the statistic
+   * @param statistic The function computing the statistic
+   *
+   * @throws IException::Programmer "A line statistic with this name has already been added"
+   */
+  void CalibrationPipeline::addLineStatistic(const QString &name, StatisticFunction statistic) {
+    if (statisticIndex(name) >= 0) {
+      QString msg = "A line statistic named [" + name + "] has already been added to the pipeline";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    Stage stage;
+    stage.name = name;
+    stage.isStatistic = true;
+    stage.operation = Multiply;
+    stage.source = LineStatistic;
+    stage.statisticIndex = m_statistics++;
+    stage.statistic = statistic;
+    m_stages.push_back(stage);
+  }
+
+
+  /**
+   * Returns the number of stages, including line statistics
+   *
+   * @return @b int The number of stages
+   */
+  int CalibrationPipeline::size() const {
+    return (int) m_stages.size();
+  }
+
+
+  /**
+   * Checks that every stage has a coefficient for each sample or line of a
+   * cube. Call this before processing so a bad coefficient file is reported
+   * before any line is calibrated.
+   *
+   * @param samples The number of samples in the cube
+   * @param lines The number of lines in the cube
+   *
+   * @throws IException::User "The calibration stage does not have enough coefficients"
+   */
+  void CalibrationPipeline::validate(int samples, int lines) const {
+    for (unsigned int i = 0; i < m_stages.size(); i++) {
+      const Stage &stage = m_stages[i];
+      int needed = 0;
+      if (stage.source == SampleCoefficients) {
+        needed = samples;
+      }
+      else if (stage.source == LineCoefficients) {
+        needed = lines;
+      }
+
+      if ((int) stage.coefficients.size() < needed) {
+        QString msg = "The calibration stage [" + stage.name + "] has ["
+                      + toString((int) stage.coefficients.size()) + "] coefficients but ["
+                      + toString(needed) + "] are needed";
+        throw IException(IException::User, msg, _FILEINFO_);
+      }
+    }
+  }
+
+
+  /**
+   * Calibrates one line. The stages between line statistics are applied to
+   * each valid pixel in a single pass over the line. This does not change the
+   * pipeline, so it can be called from several threads at once.
+   *
+   * @param in The raw input line
+   * @param out The calibrated output line
+   */
+  void CalibrationPipeline::operator()(Buffer &in, Buffer &out) const {
+    int line = in.Line() - 1;
+    int samples = in.size();
+    for (int i = 0; i < samples; i++) {
+      out[i] = in[i];
+    }
+
+    vector<double> statistics(m_statistics, Null);
+    vector<double> lineValues(m_stages.size(), 0.0);
+    vector<double> pixels;
+
+    unsigned int first = 0;
+    while (first < m_stages.size()) {
+      unsigned int last = first;
+      while (last < m_stages.size() && !m_stages[last].isStatistic) {
+        // Coefficients that are the same for the whole line are looked up once
+        const Stage &stage = m_stages[last];
+        if (stage.source == Constant) {
+          lineValues[last] = stage.coefficients[0];
+        }
+        else if (stage.source == LineCoefficients) {
+          lineValues[last] = stage.coefficients[line];
+        }
+        else if (stage.source == LineStatistic) {
+          lineValues[last] = statistics[stage.statisticIndex];
+        }
+        last++;
+      }
+
+      if (last > first) {
+        for (int i = 0; i < samples; i++) {
+          if (IsSpecial(out[i])) {
+            continue;
+          }
+
+          double dn = out[i];
+          for (unsigned int s = first; s < last; s++) {
+            const Stage &stage = m_stages[s];
+            double coefficient = (stage.source == SampleCoefficients) ?
+                                 stage.coefficients[i] : lineValues[s];
+            if (stage.operation == Subtract) {
+              dn = dn - coefficient;
+            }
+            else if (stage.operation == Multiply) {
+              dn = dn * coefficient;
+            }
+            else {
+              dn = dn / coefficient;
+            }
+          }
+          out[i] = dn;
+        }
+      }
+
+      if (last < m_stages.size()) {
+        pixels.clear();
+        for (int i = 0; i < samples; i++) {
+          if (!IsSpecial(out[i])) {
+            pixels.push_back(out[i]);
+          }
+        }
+
+        // No valid pixels means there is nothing left to calibrate
+        if (pixels.empty()) {
+          return;
+        }
+        statistics[m_stages[last].statisticIndex] = m_stages[last].statistic(pixels);
+      }
+      first = last + 1;
+    }
+  }
+
+
+  /**
+   * Returns the index of a line statistic
+   *
+   * @param name The name of the statistic
+   *
+   * @return @b int The index of the statistic, or -1 if there is none
+   */
+  int CalibrationPipeline::statisticIndex(const QString &name) const {
+    for (unsigned int i = 0; i < m_stages.size(); i++) {
+      if (m_stages[i].isStatistic && m_stages[i].name == name) {
+        return m_stages[i].statisticIndex;
+      }
+    }
+    return -1;
+  }
+}
@@ -0,0 +1,116 @@
+#ifndef CalibrationPipeline_h
+#define CalibrationPipeline_h
+/**
+ * @file
+ *
+ *   Unless noted otherwise, the portions of Isis written by the USGS are public
+ *   domain. See individual third-party library and package descriptions for
+ *   intellectual property information,user agreements, and related information.
+ *
+ *   Although Isis has been used by the USGS, no warranty, expressed or implied,
+ *   is made by the USGS as to the accuracy and functioning of such software
+ *   and related material nor shall the fact of distribution constitute any such
+ *   warranty, and no responsibility is assumed by the USGS in connection
+ *   therewith.
+ *
+ *   For additional information, launch
+ *   $ISISROOT/doc//documents/Disclaimers/Disclaimers.html in a browser or see
+ *   the Privacy &amp; Disclaimers page on the Isis website,
+ *   http://isis.astrogeology.usgs.gov, and the USGS privacy and disclaimers on
+ *   http://www.usgs.gov/privacy.html.
+ */
+
+#include <functional>
+#include <vector>
+
+#include <QString>
+
+namespace Isis {
+  class Buffer;
+
+  /**
+   * @brief A fused, thread-safe radiometric calibration equation
+   *
+   * A CalibrationPipeline describes a calibration equation as an ordered list
+   * of stages applied to each valid pixel of a line. Each stage subtracts,
+   * multiplies or divides the pixel by a constant, by a coefficient per sample
+   * (dark, flat field, reverse clock), by a coefficient per line (zero buffer
+   * drift, line gain drift), or by a statistic computed earlier from the
+   * pixels of the same line (non-linearity gain). Special pixels are copied to
+   * the output unchanged.
+   *
+   * Consecutive stages are fused into one pass over the line, so the whole
+   * equation costs one pass per line statistic plus one. The pipeline is built
+   * before processing and is not changed while processing, so it can be used as
+   * the functor of ProcessByBrick::ProcessCube or ProcessByLine::ProcessCube
+   * with threading enabled.
+   *
+   * @code
+   *   CalibrationPipeline pipeline;
+   *   pipeline.addStage(CalibrationPipeline::Subtract, "Dark",
+   *                     CalibrationPipeline::SampleCoefficients, dark);
+   *   pipeline.addStage(CalibrationPipeline::Divide, "Flat",
+   *                     CalibrationPipeline::SampleCoefficients, flat);
+   *   pipeline.validate(cube->sampleCount(), cube->lineCount());
+   *   p.ProcessCube(pipeline);
+   * @endcode
+   *
+   * @ingroup Utility
+   */
+  class CalibrationPipeline {
+    public:
+      //! How a stage changes a pixel
+      enum Operation {
+        Subtract,  //!< Subtract the coefficient from the pixel
+        Multiply,  //!< Multiply the pixel by the coefficient
+        Divide     //!< Divide the pixel by the coefficient
+      };
+
+      //! Where the coefficient of a stage comes from
+      enum Source {
+        Constant,            //!< A single coefficient for every pixel
+        SampleCoefficients,  //!< A coefficient for each sample
+        LineCoefficients,    //!< A coefficient for each line
+        LineStatistic        //!< A statistic of the line added by addLineStatistic
+      };
+
+      /**
+       * A function that computes a line statistic from the valid pixels of a
+       * line. The function may reorder the pixels.
+       */
+      typedef std::function<double(std::vector<double> &pixels)> StatisticFunction;
+
+      CalibrationPipeline();
+      ~CalibrationPipeline();
+
+      void addStage(Operation operation, const QString &name, Source source,
+                    const std::vector<double> &coefficients = std::vector<double>());
+      void addLineStatistic(const QString &name, StatisticFunction statistic);
+
+      int size() const;
+      void validate(int samples, int lines) const;
+
+      void operator()(Buffer &in, Buffer &out) const;
+
+    private:
+      /**
+       * One step of the calibration equation
+       */
+      struct Stage {
+        QString name;                      //!< The name of the stage
+        bool isStatistic;                  //!< Computes a statistic instead of changing pixels
+        Operation operation;               //!< How the stage changes a pixel
+        Source source;                     //!< Where the coefficient comes from
+        std::vector<double> coefficients;  //!< The constant, sample or line coefficients
+        int statisticIndex;                //!< The statistic used by a LineStatistic stage
+        StatisticFunction statistic;       //!< The statistic computed by a statistic stage
+      };
+
+      int statisticIndex(const QString &name) const;
+
+      std::vector<Stage> m_stages;  //!< The stages in the order they are applied
+      int m_statistics;             //!< The number of line statistics
+  };
+}
+
+#endif
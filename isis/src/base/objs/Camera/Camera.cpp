@@ -49,6 +49,7 @@
 #include "iTime.h"
 #include "Latitude.h"
 #include "Longitude.h"
+#include "NaifMath.h"
 #include "NaifStatus.h"
 #include "Projection.h"
 #include "ProjectionFactory.h"
@@ -296,6 +297,61 @@ namespace Isis {
   }
 
 
+  /**
+   * @brief Traces the look directions of a set of image coordinates together
+   *        ahead of the SetImage calls for them.
+   *
+   * Shape models that can intersect many rays at once, such as the Embree
+   * shape model, trace the look directions of all of the image coordinates
+   * here and then answer the following SetImage calls for the same image
+   * coordinates from the batch. SetImage returns the same results whether or
+   * not the image coordinates were prepared. Nothing is done for other shape
+   * models or for map projected images.
+   *
+   * The look directions are found by running the camera model, so each image
+   * coordinate goes through it twice: here and in its SetImage call. The
+   * camera keeps the state of the current pixel in its detector, focal plane
+   * and distortion maps, so SetImage has to run it again. SPICE positions and
+   * rotations are cached by time, which leaves only the map arithmetic to
+   * repeat. That costs much less than tracing a ray through a DSK.
+   *
+   * The camera does not have a computed point afterwards.
+   *
+   * @param samples The sample of each image coordinate, in the order they
+   *                will be set
+   * @param lines The line of each image coordinate
+   */
+  void Camera::PrepareImages(const std::vector<double> &samples,
+                             const std::vector<double> &lines) {
+    ShapeModel *shape = target()->shape();
+    if ((p_projection != NULL && !p_ignoreProjection) || !shape->canPrepareIntersections()) {
+      return;
+    }
+
+    std::vector< std::vector<double> > observerPositions;
+    std::vector< std::vector<double> > lookDirections;
+    observerPositions.reserve(samples.size());
+    lookDirections.reserve(samples.size());
+
+    collectLookDirections(&observerPositions, &lookDirections);
+    try {
+      for (size_t i = 0; i < samples.size() && i < lines.size(); i++) {
+        SetImage(samples[i], lines[i]);
+      }
+    }
+    catch (...) {
+      collectLookDirections(NULL, NULL);
+      throw;
+    }
+    collectLookDirections(NULL, NULL);
+
+    shape->clearSurfacePoint();
+    p_pointComputed = false;
+
+    shape->prepareIntersections(observerPositions, lookDirections);
+  }
+
+
 /**
  * @brief Sets the sample/line values of the image to get the lat/lon values for a Map Projected 
  * image. 
@@ -1591,7 +1647,8 @@ namespace Isis {
         lon = surfacePoint.GetLongitude();
         radius = LocalRadius(lat, lon);
 
-        latrec_c(radius.kilometers(), lon.radians(), lat.radians(), cornerNeighborPoints[i]);
+        NaifMath::latrec(radius.kilometers(), lon.radians(), lat.radians(),
+                         cornerNeighborPoints[i]);
       }
 
       // if the first 2 surrounding points match or the last 2 surrounding points match,
@@ -1668,7 +1725,7 @@ namespace Isis {
 
     // Check to make sure normal is valid
     SpiceDouble mag;
-    unorm_c(normal,normal,&mag);
+    NaifMath::unorm(normal, normal, mag);
     if (mag == 0.) {
       success = false;
       return;
@@ -1685,28 +1742,28 @@ namespace Isis {
     pB[1] = surfacePoint.GetY().kilometers();
     pB[2] = surfacePoint.GetZ().kilometers();
 
-    vsub_c((SpiceDouble *) &sB[0], pB, surfSpaceVect);
-    unorm_c(surfSpaceVect, unitizedSurfSpaceVect, &dist);
+    NaifMath::vsub(&sB[0], pB, surfSpaceVect);
+    NaifMath::unorm(surfSpaceVect, unitizedSurfSpaceVect, dist);
 
     // get a normalized surface sun vector
     SpiceDouble surfaceSunVect[3];
-    vsub_c(m_uB, pB, surfaceSunVect);
+    NaifMath::vsub(m_uB, pB, surfaceSunVect);
     SpiceDouble unitizedSurfSunVect[3];
-    unorm_c(surfaceSunVect, unitizedSurfSunVect, &dist);
+    NaifMath::unorm(surfaceSunVect, unitizedSurfSunVect, dist);
 
     // use normalized surface spacecraft and surface sun vectors to calculate
     // the phase angle (in radians)
-    phase = Angle(vsep_c(unitizedSurfSpaceVect, unitizedSurfSunVect),
+    phase = Angle(NaifMath::vsep(unitizedSurfSpaceVect, unitizedSurfSunVect),
         Angle::Radians);
 
     // use normalized surface spacecraft and local normal vectors to calculate
     // the emission angle (in radians)
-    emission = Angle(vsep_c(unitizedSurfSpaceVect, normal),
+    emission = Angle(NaifMath::vsep(unitizedSurfSpaceVect, normal),
         Angle::Radians);
 
     // use normalized surface sun and normal vectors to calculate the incidence
     // angle (in radians)
-    incidence = Angle(vsep_c(unitizedSurfSunVect, normal),
+    incidence = Angle(NaifMath::vsep(unitizedSurfSunVect, normal),
         Angle::Radians);
 
 
@@ -2212,22 +2269,18 @@ namespace Isis {
    * @return @b double Off Nadir Angle
    */
   double Camera::OffNadirAngle() {
-    NaifStatus::CheckErrors();
-
     // Get the xyz coordinates for the spacecraft and point we are interested in
     double coord[3], spCoord[3];
     Coordinate(coord);
     instrumentPosition(spCoord);
 
     // Get the angle between the 2 points and convert to degrees
-    double a = vsep_c(coord, spCoord) * 180.0 / PI;
+    double a = NaifMath::vsep(coord, spCoord) * 180.0 / PI;
     double b = 180.0 - EmissionAngle();
 
     // The three angles in a triangle must add up to 180 degrees
     double c = 180.0 - (a + b);
 
-    NaifStatus::CheckErrors();
-
     return c;
   }
 
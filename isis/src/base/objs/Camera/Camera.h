@@ -258,6 +258,7 @@ namespace Isis {
       // Methods
       virtual bool SetImage(const double sample, const double line);
       virtual bool SetImage(const double sample, const double line, const double deltaT);
+      void PrepareImages(const std::vector<double> &samples, const std::vector<double> &lines);
 
       virtual bool SetUniversalGround(const double latitude, const double longitude);
       virtual bool SetUniversalGround(const double latitude, const double longitude,
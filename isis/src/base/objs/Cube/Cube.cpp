@@ -23,20 +23,30 @@
 #include "IsisDebug.h"
 #include "Cube.h"
 
+#include <fstream>
 #include <sstream>
 #include <unistd.h>
+#include <vector>
 
 #include <QDebug>
 #include <QDir>
 #include <QFile>
 #include <QFileInfo>
+#include <QMap>
 #include <QMutex>
+#include <QStringList>
+#include <QUrl>
 
 #include "Application.h"
+#include "Blob.h"
+#include "Buffer.h"
 #include "Camera.h"
 #include "CameraFactory.h"
 #include "CubeAttribute.h"
 #include "CubeBsqHandler.h"
+#include "CubeCompressedTileHandler.h"
+#include "CubeHttpDataSource.h"
+#include "CubeOverview.h"
 #include "CubeTileHandler.h"
 #include "Endian.h"
 #include "FileName.h"
@@ -150,6 +160,9 @@ namespace Isis {
     delete m_mutex;
     m_mutex = NULL;
 
+    delete m_labelMutex;
+    m_labelMutex = NULL;
+
     delete m_camera;
     m_camera = NULL;
 
@@ -159,6 +172,9 @@ namespace Isis {
 
     delete m_formatTemplateFile;
     m_formatTemplateFile = NULL;
+
+    delete m_overviews;
+    m_overviews = NULL;
   }
 
 
@@ -554,6 +570,10 @@ namespace Isis {
       m_ioHandler = new CubeBsqHandler(dataFile(), m_virtualBandList, realDataFileLabel(),
                                        dataAlreadyOnDisk);
     }
+    else if (m_format == CompressedTile) {
+      m_ioHandler = new CubeCompressedTileHandler(dataFile(), m_virtualBandList,
+                                                  realDataFileLabel(), dataAlreadyOnDisk);
+    }
     else {
       m_ioHandler = new CubeTileHandler(dataFile(), m_virtualBandList, realDataFileLabel(),
                                         dataAlreadyOnDisk);
@@ -607,7 +627,9 @@ namespace Isis {
    * This method will open an isis cube for reading or reading/writing.
    *
    * @param[in] cubeFileName Name of the cube file to open. Environment
-   *     variables in the filename will be automatically expanded.
+   *     variables in the filename will be automatically expanded. This may
+   *     also be an http or https URL of a cube on a web server or object
+   *     store, which can only be opened read-only.
    * @param[in] access (Default value of "r") Defines how the cube will be
    *     accessed. Either read-only "r" or read-write "rw".
    */
@@ -619,6 +641,11 @@ namespace Isis {
       throw IException(IException::Programmer, msg, _FILEINFO_);
     }
 
+    if (CubeHttpDataSource::isRemote(cubeFileName)) {
+      openRemote(cubeFileName, access);
+      return;
+    }
+
     initLabelFromFile(cubeFileName, (access == "rw"));
 
     // Figure out the name of the data file
@@ -736,6 +763,10 @@ namespace Isis {
       m_ioHandler = new CubeBsqHandler(dataFile(), m_virtualBandList,
           realDataFileLabel(), true);
     }
+    else if (m_format == CompressedTile) {
+      m_ioHandler = new CubeCompressedTileHandler(dataFile(), m_virtualBandList,
+          realDataFileLabel(), true);
+    }
     else {
       m_ioHandler = new CubeTileHandler(dataFile(), m_virtualBandList,
           realDataFileLabel(), true);
@@ -803,6 +834,9 @@ namespace Isis {
 
     QMutexLocker locker(m_mutex);
     QMutexLocker locker2(m_ioHandler->dataFileMutex());
+    if (isRemote()) {
+      fetchRemoteBlob(blob);
+    }
     blob.Read(cubeFile.toString(), *label());
   }
 
@@ -824,6 +858,117 @@ namespace Isis {
   }
 
 
+  /**
+   * This method will read a buffer of data from a reduced resolution overview
+   * of the cube. The positions in the buffer are overview samples and lines,
+   * so sample S of a level N overview covers cube samples (S - 1) * N + 1
+   * through S * N. Level 1 is the cube itself. Only the overview rows under
+   * the buffer are read.
+   *
+   * @param bufferToFill Buffer to be loaded
+   * @param level The reduction factor of the overview, one of overviewLevels()
+   */
+  void Cube::read(Buffer &bufferToFill, int level) const {
+    if (level == 1) {
+      read(bufferToFill);
+      return;
+    }
+
+    if (!isOpen()) {
+      string msg = "Try opening a file before you read it";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    QList<CubeOverview *> tiles;
+    {
+      QMutexLocker locker(m_mutex);
+      readOverviews();
+      tiles = m_overviews->value(level);
+    }
+
+    if (tiles.isEmpty()) {
+      QString msg = "Cube [" + fileName() + "] does not have a current overview of level [" +
+                    toString(level) + "]. Run buildpyramid to create or update overviews";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    FileName cubeFile = *m_labelFileName;
+    if (m_tempCube)
+      cubeFile = *m_tempCube;
+
+    int overviewSamples = tiles.first()->sampleCount();
+    int overviewLines = tiles.first()->lineCount();
+    int samples = bufferToFill.SampleDimension();
+    ifstream stream;
+    QString streamFile;
+    vector<char> stored;
+
+    for (int i = 0; i < bufferToFill.size(); i += samples) {
+      double *row = bufferToFill.DoubleBuffer() + i;
+      for (int j = 0; j < samples; j++) {
+        row[j] = Null;
+      }
+
+      int line = bufferToFill.Line(i);
+      int band = bufferToFill.Band(i);
+      int startSample = qMax(bufferToFill.Sample(i), 1);
+      int endSample = qMin(bufferToFill.Sample(i) + samples - 1, overviewSamples);
+      if (band < 1 || band > bandCount() || line < 1 || line > overviewLines ||
+          startSample > endSample) {
+        continue;
+      }
+
+      CubeOverview *tile = tiles.first();
+      foreach (CubeOverview *candidate, tiles) {
+        if (candidate->firstLine() <= line) {
+          tile = candidate;
+        }
+      }
+
+      BigInt offset = tile->byteOffset(startSample, line, physicalBand(band));
+      int count = endSample - startSample + 1;
+      int bytes = count * sizeof(float);
+      double *pixels = row + (startSample - bufferToFill.Sample(i));
+
+      if (isRemote()) {
+        QByteArray data;
+        {
+          QMutexLocker locker(m_ioHandler->dataFileMutex());
+          data = m_ioHandler->dataSource()->read(offset, bytes);
+        }
+        if (data.size() != bytes) {
+          QString msg = "Unable to read the Overview [" + tile->Name() +
+                        "] of the remote cube [" + fileName() + "]";
+          throw IException(IException::Io, msg, _FILEINFO_);
+        }
+        tile->toPixels(data.constData(), count, pixels);
+        continue;
+      }
+
+      QString tileFile = tile->dataFile().isEmpty() ? cubeFile.expanded() : tile->dataFile();
+      if (tileFile != streamFile) {
+        stream.close();
+        stream.clear();
+        stream.open(tileFile.toLatin1().data(), ios::in | ios::binary);
+        if (!stream) {
+          QString msg = Message::FileOpen(tileFile);
+          throw IException(IException::Io, msg, _FILEINFO_);
+        }
+        streamFile = tileFile;
+      }
+
+      stored.resize(bytes);
+      stream.seekg((streampos)offset, ios::beg);
+      stream.read(&stored[0], bytes);
+      if (!stream.good()) {
+        QString msg = "Error reading data from Overview [" + tile->Name() + "]";
+        throw IException(IException::Io, msg, _FILEINFO_);
+      }
+      tile->toPixels(&stored[0], count, pixels);
+    }
+  }
+
+
   /**
    * This method will write a blob of data (e.g. History, Table, etc)
    * to the cube as specified by the contents of the Blob object.
@@ -841,6 +986,19 @@ namespace Isis {
       throw IException(IException::Programmer, msg, _FILEINFO_);
     }
 
+    // Stamp overview tiles with the DNs they were built from
+    if (blob.Type() == "Overview") {
+      QMutexLocker locker(m_mutex);
+      PvlObject &core = m_label->findObject("IsisCube").findObject("Core");
+      if (!core.hasKeyword("DataStamp")) {
+        core += PvlKeyword("DataStamp", "1");
+      }
+      blob.Label().addKeyword(PvlKeyword("SourceStamp", core["DataStamp"][0]),
+                              PvlContainer::Replace);
+      m_dataStampChanged = false;
+      clearOverviews();
+    }
+
     // Write an attached blob
     if (m_attached) {
       QMutexLocker locker(m_mutex);
@@ -919,6 +1077,17 @@ namespace Isis {
     }
 
     QMutexLocker locker(m_mutex);
+
+    // Overviews built from the old DNs no longer match the DataStamp
+    if (!m_dataStampChanged) {
+      PvlObject &core = m_label->findObject("IsisCube").findObject("Core");
+      if (core.hasKeyword("DataStamp")) {
+        core["DataStamp"] = toString(toBigInt(core["DataStamp"][0]) + 1);
+        clearOverviews();
+      }
+      m_dataStampChanged = true;
+    }
+
     m_ioHandler->write(bufferToWrite);
   }
 
@@ -1046,7 +1215,7 @@ namespace Isis {
    * either band, sequential or tiled.
    * If not invoked, a tiled file will be created.
    *
-   * @param format An enumeration of either Bsq or Tile.
+   * @param format An enumeration of Bsq, Tile or CompressedTile.
    */
   void Cube::setFormat(Format format) {
     openCheck();
@@ -1079,6 +1248,22 @@ namespace Isis {
   }
 
 
+  /**
+   * Used prior to the open method, this makes opening a cube read-only only
+   * read the IsisCube and Label objects of its labels. The other objects, such
+   * as Tables, History and NaifKeywords, are read the first time label() or
+   * a Blob is used. Programs that only need the dimensions or the groups in
+   * the IsisCube object, through group() and hasGroup(), never read them,
+   * which makes inspecting many cubes much faster.
+   *
+   * @param[in] lazy True to read labels lazily
+   */
+  void Cube::setLazyLabels(bool lazy) {
+    openCheck();
+    m_lazyLabels = lazy;
+  }
+
+
   /**
    * Used prior to the Create method, this will specify the output pixel type.
    * If not invoked, the pixel type will be Real.
@@ -1241,7 +1426,7 @@ namespace Isis {
   }
 
 
-  void Cube::attachSpiceFromIsd(nlohmann::json isd) {
+  void Cube::attachSpiceFromIsd(const nlohmann::json &isd) {
     PvlKeyword lkKeyword("LeapSecond");
     PvlKeyword pckKeyword("TargetAttitudeShape");
     PvlKeyword targetSpkKeyword("TargetPosition");
@@ -1353,6 +1538,22 @@ namespace Isis {
   }
 
 
+  /**
+   * @returns The reduction factors of the overviews stored in the cube, in
+   *   increasing order. These are empty until buildpyramid is run on the cube,
+   *   and overviews built before the DNs were last written to are left out.
+   */
+  QList<int> Cube::overviewLevels() const {
+    if (!isOpen()) {
+      return QList<int>();
+    }
+
+    QMutexLocker locker(m_mutex);
+    readOverviews();
+    return m_overviews->keys();
+  }
+
+
   /**
    * @returns the cube's storage format. If no cube is opened yet, then this is
    *   the storage format that will be used if create(...) is called.
@@ -1484,6 +1685,14 @@ namespace Isis {
    * @return Pvl Pointer to the Label object associated with the cube.
    */
   Pvl *Cube::label() const {
+    // Threads that share a cube may ask for the label at the same time
+    if (m_lazyLabels) {
+      QMutexLocker locker(m_labelMutex);
+      if (m_partialLabel) {
+        readRestOfLabel();
+      }
+    }
+
     return m_label;
   }
 
@@ -1500,7 +1709,7 @@ namespace Isis {
 
     if (actual && m_label) {
       ostringstream s;
-      s << *m_label << endl;
+      s << *label() << endl;
       labelSize = s.tellp();
     }
     else if (actual) {
@@ -1728,6 +1937,24 @@ namespace Isis {
   }
 
 
+  /**
+   * Returns the IO cache counters of the opened cube: chunk cache hits and
+   *   misses, the bytes read from disk, the bytes cached and the detected
+   *   access pattern.
+   *
+   * @return A CacheStatistics group
+   */
+  PvlGroup Cube::cacheStatistics() const {
+    if (!m_ioHandler) {
+      QString msg = "Cannot get cache statistics until the cube is open";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    QMutexLocker locker(m_mutex);
+    return m_ioHandler->cacheStatistics();
+  }
+
+
   /**
    * This method will delete a blob label object from the cube as specified by the
    * Blob type and name. If blob does not exist it will do nothing and return
@@ -1743,6 +1970,10 @@ namespace Isis {
       if (obj.name().compare(BlobType) == 0) {
         if (obj.findKeyword("Name")[0] == BlobName) {
           m_label->deleteObject(i);
+          if (BlobType == "Overview") {
+            QMutexLocker locker(m_mutex);
+            clearOverviews();
+          }
           return true;
         }
       }
@@ -1774,7 +2005,8 @@ namespace Isis {
    * @return (PvlGroup) Label which will contain the requested group.
    */
   PvlGroup &Cube::group(const QString &group) const {
-    PvlObject &isiscube = label()->findObject("IsisCube");
+    // The IsisCube object is always read, even with lazy labels
+    PvlObject &isiscube = m_label->findObject("IsisCube");
     return isiscube.findGroup(group);
   }
 
@@ -1787,7 +2019,7 @@ namespace Isis {
    * @return (bool) True if the cube has the specified group, false if not.
    */
   bool Cube::hasGroup(const QString &group) const {
-    const PvlObject &isiscube = label()->findObject("IsisCube");
+    const PvlObject &isiscube = m_label->findObject("IsisCube");
     if (isiscube.hasGroup(group)) return true;
     return false;
   }
@@ -1915,6 +2147,9 @@ namespace Isis {
     delete m_virtualBandList;
     m_virtualBandList = NULL;
 
+    clearOverviews();
+    m_dataStampChanged = false;
+
     initialize();
   }
 
@@ -1928,6 +2163,7 @@ namespace Isis {
     m_dataFile = NULL;
     m_ioHandler = NULL;
     m_mutex = NULL;
+    m_labelMutex = NULL;
 
     m_camera = NULL;
     m_projection = NULL;
@@ -1937,10 +2173,15 @@ namespace Isis {
     m_tempCube = NULL;
     m_formatTemplateFile = NULL;
     m_label = NULL;
+    m_lazyLabels = false;
 
     m_virtualBandList = NULL;
 
     m_mutex = new QMutex();
+    m_labelMutex = new QMutex();
+    m_overviews = new QMap<int, QList<CubeOverview *> >;
+    m_overviewsRead = false;
+    m_dataStampChanged = false;
     m_formatTemplateFile =
          new FileName("$ISISROOT/appdata/templates/labels/CubeFormatTemplate.pft");
 
@@ -2044,6 +2285,7 @@ namespace Isis {
     m_attached = true;
     m_storesDnData = true;
     m_labelBytes = 65536;
+    m_partialLabel = false;
 
     m_samples = 0;
     m_lines = 0;
@@ -2080,6 +2322,9 @@ namespace Isis {
       if ((QString) core["Format"] == "BandSequential") {
         m_format = Bsq;
       }
+      else if ((QString) core["Format"] == "CompressedTile") {
+        m_format = CompressedTile;
+      }
       else {
         m_format = Tile;
       }
@@ -2106,9 +2351,16 @@ namespace Isis {
   void Cube::initLabelFromFile(FileName labelFileName, bool readWrite) {
     ASSERT(!m_labelFileName);
 
+    // Lazy labels start with only what opening the cube needs
+    QStringList labelObjects;
+    if (m_lazyLabels && !readWrite) {
+      labelObjects << "IsisCube" << "Label";
+    }
+
     try {
       if (labelFileName.fileExists()) {
-        m_label = new Pvl(labelFileName.expanded());
+        m_label = new Pvl;
+        m_label->read(labelFileName.expanded(), labelObjects);
         if (!m_label->objects()) {
           throw IException();
         }
@@ -2126,7 +2378,8 @@ namespace Isis {
         FileName tmp(labelFileName);
         tmp = tmp.addExtension("cub");
         if (tmp.fileExists()) {
-          m_label = new Pvl(tmp.expanded());
+          m_label = new Pvl;
+          m_label->read(tmp.expanded(), labelObjects);
           if (!m_label->objects()) {
             throw IException();
           }
@@ -2146,7 +2399,8 @@ namespace Isis {
         FileName tmp(labelFileName);
         tmp = tmp.setExtension("lbl");
         if (tmp.fileExists()) {
-          m_label = new Pvl(tmp.expanded());
+          m_label = new Pvl;
+          m_label->read(tmp.expanded(), labelObjects);
           if (!m_label->objects()) {
             throw IException();
           }
@@ -2166,7 +2420,8 @@ namespace Isis {
         FileName tmp(labelFileName);
         tmp = tmp.addExtension("ecub");
         if (tmp.fileExists()) {
-          m_label = new Pvl(tmp.expanded());
+          m_label = new Pvl;
+          m_label->read(tmp.expanded(), labelObjects);
           if (!m_label->objects()) {
             throw IException();
           }
@@ -2203,7 +2458,278 @@ namespace Isis {
     }
     else {
       m_labelFile = new QFile(m_labelFileName->expanded());
+      m_partialLabel = !labelObjects.isEmpty();
+    }
+  }
+
+
+  /**
+   * Reads the objects of the labels that were skipped when the cube was
+   *   opened with lazy labels, and adds them after the IsisCube and Label
+   *   objects.
+   */
+  void Cube::readRestOfLabel() const {
+    Pvl fullLabel(m_labelFileName->expanded());
+    for (int i = 0; i < fullLabel.objects(); i++) {
+      const PvlObject &obj = fullLabel.object(i);
+      if (!obj.isNamed("IsisCube") && !obj.isNamed("Label")) {
+        m_label->addObject(obj);
+      }
+    }
+
+    m_partialLabel = false;
+  }
+
+
+  /**
+   * Open a cube on a web server for reading. Only the labels are transferred
+   *   here; DN data and blobs are read with HTTP range requests as they are
+   *   used. The labels are kept in a local temporary file, and blobs are
+   *   written into it at their positions in the remote cube before they are
+   *   read, so the rest of the cube works as it does for local files.
+   *
+   * The cube must have attached labels and be in the Tile or BandSequential
+   *   format.
+   *
+   * @param url The http or https URL of the cube
+   * @param access The access to open the cube with, which must be "r"
+   */
+  void Cube::openRemote(const QString &url, QString access) {
+    if (access != "r") {
+      QString msg = "The remote cube [" + url + "] can only be opened read-only";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    CubeHttpDataSource *dataSource = NULL;
+    try {
+      dataSource = new CubeHttpDataSource(QUrl(url));
+
+      // Read more of the cube until the labels are complete
+      QByteArray labelArea;
+      BigInt labelBytes = m_labelBytes;
+      while (!m_label) {
+        labelArea = dataSource->read(0, qMin(labelBytes, dataSource->size()));
+        int labelEnd = labelArea.indexOf('\0');
+        istringstream labelStream(labelEnd == -1 ? labelArea.toStdString() :
+                                                   labelArea.left(labelEnd).toStdString());
+        try {
+          Pvl *label = new Pvl;
+          try {
+            labelStream >> *label;
+          }
+          catch (IException &) {
+            delete label;
+            throw;
+          }
+          m_label = label;
+        }
+        catch (IException &e) {
+          if (labelBytes >= dataSource->size()) {
+            QString msg = "Unable to read the labels of the remote cube [" + url + "]";
+            throw IException(e, IException::Io, msg, _FILEINFO_);
+          }
+          labelBytes *= 4;
+        }
+      }
+
+      PvlObject &core = m_label->findObject("IsisCube").findObject("Core");
+      if (core.hasKeyword("^Core") || core.hasKeyword("^DnFile")) {
+        QString msg = "The remote cube [" + url + "] must have attached labels";
+        throw IException(IException::Io, msg, _FILEINFO_);
+      }
+
+      m_labelFileName = new FileName(url);
+      m_dataFileName = new FileName(url);
+      m_attached = true;
+      m_storesDnData = true;
+
+      initCoreFromLabel(*m_label);
+      m_labelBytes = m_label->findObject("Label")["Bytes"];
+
+      if (m_format == CompressedTile) {
+        QString msg = "The remote cube [" + url + "] is in the CompressedTile format, which "
+                      "can only be read from local files";
+        throw IException(IException::Io, msg, _FILEINFO_);
+      }
+
+      m_tempCube = new FileName(
+          FileName::createTempFile("$temporary/Remote_" + QUrl(url).fileName()));
+      m_labelFile = new QFile(m_tempCube->expanded());
+      if (!m_labelFile->open(QIODevice::WriteOnly) ||
+          m_labelFile->write(labelArea) != labelArea.size()) {
+        QString msg = "Unable to write the labels of the remote cube [" + url + "] to [" +
+                      m_tempCube->expanded() + "]";
+        throw IException(IException::Io, msg, _FILEINFO_);
+      }
+      m_labelFile->close();
+
+      if (!m_labelFile->open(QIODevice::ReadOnly)) {
+        QString msg = "Failed to open [" + m_labelFile->fileName() + "] with "
+            "read only access";
+        throw IException(IException::Io, msg, _FILEINFO_);
+      }
+
+      // The IO handler owns the data source once it has it
+      CubeDataSource *handlerSource = dataSource;
+      dataSource = NULL;
+      if (m_format == Bsq) {
+        m_ioHandler = new CubeBsqHandler(handlerSource, m_virtualBandList,
+            realDataFileLabel(), true);
+      }
+      else {
+        m_ioHandler = new CubeTileHandler(handlerSource, m_virtualBandList,
+            realDataFileLabel(), true);
+      }
+    }
+    catch (IException &) {
+      delete dataSource;
+      cleanUp(false);
+      throw;
+    }
+
+    applyVirtualBandsToLabel();
+  }
+
+
+  /**
+   * @returns True if the opened cube is on a web server instead of in a file
+   */
+  bool Cube::isRemote() const {
+    return m_labelFileName && CubeHttpDataSource::isRemote(m_labelFileName->original());
+  }
+
+
+  /**
+   * Copy a blob of a remote cube into the local copy of its labels, at the
+   *   same position it has in the remote cube, so it can be read from there.
+   *   Blobs that aren't in the labels are left for Blob::Read to report.
+   *
+   * @param blob The blob that is about to be read
+   */
+  void Cube::fetchRemoteBlob(const Blob &blob) const {
+    for (int i = 0; i < m_label->objects(); i++) {
+      const PvlObject &obj = m_label->object(i);
+      if (obj.isNamed(blob.Type()) && obj.hasKeyword("Name") &&
+          obj["Name"][0].toUpper() == blob.Name().toUpper()) {
+        BigInt startByte = toBigInt(obj["StartByte"][0]) - 1;
+        BigInt bytes = toBigInt(obj["Bytes"][0]);
+
+        QByteArray data = m_ioHandler->dataSource()->read(startByte, bytes);
+        QFile localCopy(m_tempCube->expanded());
+        if (data.size() != bytes || !localCopy.open(QIODevice::ReadWrite) ||
+            !localCopy.seek(startByte) || localCopy.write(data) != bytes) {
+          QString msg = "Unable to read the " + blob.Type() + " [" + blob.Name() +
+                        "] of the remote cube [" + fileName() + "]";
+          throw IException(IException::Io, msg, _FILEINFO_);
+        }
+        return;
+      }
+    }
+  }
+
+
+  /**
+   * Orders overview tiles by their first line.
+   *
+   * @param first A tile
+   * @param second Another tile of the same overview
+   * @return True if first comes before second
+   */
+  static bool lessByFirstLine(const CubeOverview *first, const CubeOverview *second) {
+    return first->firstLine() < second->firstLine();
+  }
+
+
+  /**
+   * Finds the overview tiles in the labels, if that has not been done yet.
+   *   Levels are kept only when their tiles were built from the current DNs
+   *   and cover the whole overview, so a stale or partly written overview is
+   *   never read. Only the tile labels are read here. The caller must hold
+   *   m_mutex.
+   */
+  void Cube::readOverviews() const {
+    if (m_overviewsRead) {
+      return;
+    }
+    m_overviewsRead = true;
+
+    QString stamp = dataStamp();
+    if (stamp.isEmpty()) {
+      return;
+    }
+
+    FileName cubeFile = *m_labelFileName;
+    if (m_tempCube)
+      cubeFile = *m_tempCube;
+
+    QMap<int, QList<CubeOverview *> > levels;
+    Pvl *cubeLabel = label();
+    for (int i = 0; i < cubeLabel->objects(); i++) {
+      const PvlObject &obj = cubeLabel->object(i);
+      if (!obj.isNamed("Overview") || !obj.hasKeyword("SourceStamp") ||
+          obj["SourceStamp"][0] != stamp) {
+        continue;
+      }
+
+      try {
+        CubeOverview *tile = new CubeOverview(obj, cubeFile.expanded());
+        levels[tile->level()].append(tile);
+      }
+      catch (IException &) {
+        // A tile that can't be described leaves its level incomplete
+      }
+    }
+
+    foreach (int level, levels.keys()) {
+      QList<CubeOverview *> tiles = levels[level];
+      qSort(tiles.begin(), tiles.end(), lessByFirstLine);
+
+      const CubeOverview *first = tiles.first();
+      bool complete = (first->bandCount() == m_bands);
+      int nextLine = 1;
+      foreach (const CubeOverview *tile, tiles) {
+        complete = complete && tile->firstLine() == nextLine &&
+                   tile->sampleCount() == first->sampleCount() &&
+                   tile->lineCount() == first->lineCount() &&
+                   tile->bandCount() == first->bandCount();
+        nextLine += tile->tileLineCount();
+      }
+      complete = complete && nextLine == first->lineCount() + 1;
+
+      if (complete) {
+        m_overviews->insert(level, tiles);
+      }
+      else {
+        qDeleteAll(tiles);
+      }
+    }
+  }
+
+
+  /**
+   * Forgets the overview tiles found in the labels, so they are found again
+   *   when next needed. The caller must hold m_mutex.
+   */
+  void Cube::clearOverviews() const {
+    foreach (const QList<CubeOverview *> &tiles, *m_overviews) {
+      qDeleteAll(tiles);
+    }
+    m_overviews->clear();
+    m_overviewsRead = false;
+  }
+
+
+  /**
+   * @returns The DataStamp of the cube, which changes whenever DNs are written
+   *   to a cube that has overviews, or an empty string if the cube never had
+   *   overviews
+   */
+  QString Cube::dataStamp() const {
+    const PvlObject &core = m_label->findObject("IsisCube").findObject("Core");
+    if (!core.hasKeyword("DataStamp")) {
+      return "";
     }
+    return core["DataStamp"][0];
   }
 
 
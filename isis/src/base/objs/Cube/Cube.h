@@ -36,6 +36,7 @@
 class QFile;
 class QMutex;
 class QString;
+template <typename A, typename B> class QMap;
 
 namespace Isis {
   class Blob;
@@ -44,6 +45,7 @@ namespace Isis {
   class CubeAttributeOutput;
   class CubeCachingAlgorithm;
   class CubeIoHandler;
+  class CubeOverview;
   class FileName;
   class Projection;
   class Pvl;
@@ -234,7 +236,14 @@ namespace Isis {
          * The symbol '*' denotes tile boundaries.
          * The symbols '-' and '|' denote cube boundaries.
          */
-        Tile
+        Tile,
+        /**
+         * Cubes are stored in the same tiles as the Tile format, but each tile
+         *   is compressed and tiles of only NULLs are not stored. The tiles
+         *   are found through an index at the start of the cube data, see
+         *   CubeCompressedTileHandler.
+         */
+        CompressedTile
       };
 
       void fromIsd(const FileName &fileName, Pvl &label, nlohmann::json &isd, QString access);
@@ -248,7 +257,7 @@ namespace Isis {
       bool isReadWrite() const;
       bool labelsAttached() const;
 
-      void attachSpiceFromIsd(nlohmann::json Isd);
+      void attachSpiceFromIsd(const nlohmann::json &isd);
 
       void close(bool remove = false);
       Cube *copy(FileName newFile, const CubeAttributeOutput &newFileAttributes);
@@ -259,6 +268,7 @@ namespace Isis {
 
       void read(Blob &blob) const;
       void read(Buffer &rbuf) const;
+      void read(Buffer &rbuf, int level) const;
       void write(Blob &blob);
       void write(Buffer &wbuf);
 
@@ -270,6 +280,7 @@ namespace Isis {
       void setFormat(Format format);
       void setLabelsAttached(bool attached);
       void setLabelSize(int labelBytes);
+      void setLazyLabels(bool lazy);
       void setPixelType(PixelType pixelType);
       void setVirtualBands(const QList<QString> &vbands);
       void setVirtualBands(const std::vector<QString> &vbands);
@@ -284,6 +295,7 @@ namespace Isis {
       FileName externalCubeFileName() const;
       virtual QString fileName() const;
       Format format() const;
+      QList<int> overviewLevels() const;
       virtual Histogram *histogram(const int &band = 1,
                                    QString msg = "Gathering histogram");
       virtual Histogram *histogram(const int &band, const double &validMin,
@@ -306,6 +318,7 @@ namespace Isis {
 
       void addCachingAlgorithm(CubeCachingAlgorithm *);
       void clearIoCache();
+      PvlGroup cacheStatistics() const;
       bool deleteBlob(QString BlobType, QString BlobName);
       void deleteGroup(const QString &group);
       PvlGroup &group(const QString &group) const;
@@ -326,7 +339,14 @@ namespace Isis {
       void initialize();
       void initCoreFromLabel(const Pvl &label);
       void initLabelFromFile(FileName labelFileName, bool readWrite);
+      void readRestOfLabel() const;
       void openCheck();
+      void openRemote(const QString &url, QString access);
+      bool isRemote() const;
+      void fetchRemoteBlob(const Blob &blob) const;
+      void readOverviews() const;
+      void clearOverviews() const;
+      QString dataStamp() const;
       Pvl realDataFileLabel() const;
       void reformatOldIsisLabel(const QString &oldCube);
       void writeLabels();
@@ -413,6 +433,15 @@ namespace Isis {
       //! The label if IsOpen(), otherwise NULL
       Pvl *m_label;
 
+      //! True if only the objects needed to open the cube are read at first
+      bool m_lazyLabels;
+
+      //! True if m_label is missing the objects that lazy labels skip
+      mutable bool m_partialLabel;
+
+      //! Serializes reading the rest of a lazy label
+      QMutex *m_labelMutex;
+
       //! The maximum allowed size of the label; the allocated space.
       int m_labelBytes;
 
@@ -439,6 +468,22 @@ namespace Isis {
 
       //! If allocated, converts from physical on-disk band # to virtual band #
       QList<int> *m_virtualBandList;
+
+      /**
+       * The tiles of the overviews that are complete and were built from the
+       *   current DNs, by level and in line order. These are found in the
+       *   labels when first needed.
+       */
+      mutable QMap<int, QList<CubeOverview *> > *m_overviews;
+
+      //! True if m_overviews has been filled from the labels
+      mutable bool m_overviewsRead;
+
+      /**
+       * True if the DataStamp of the cube has been changed for DNs written
+       *   since the cube was opened or its overviews were last written.
+       */
+      bool m_dataStampChanged;
   };
 }
 
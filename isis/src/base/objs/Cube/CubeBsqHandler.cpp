@@ -25,8 +25,10 @@
 
 #include <iostream>
 
-#include <QFile>
+#include <QPair>
 
+#include "CubeDataSource.h"
+#include "CubeFileDataSource.h"
 #include "IException.h"
 #include "Pvl.h"
 #include "PvlKeyword.h"
@@ -49,7 +51,25 @@ namespace Isis {
    */
   CubeBsqHandler::CubeBsqHandler(QFile * dataFile,
       const QList<int> *virtualBandList, const Pvl &labels, bool alreadyOnDisk)
-    : CubeIoHandler(dataFile, virtualBandList, labels, alreadyOnDisk) {
+    : CubeBsqHandler(dataFile ? new CubeFileDataSource(dataFile) : NULL,
+                     virtualBandList, labels, alreadyOnDisk) {
+  }
+
+
+  /**
+   * Construct a BSQ IO handler that does its IO through a data source.
+   *
+   * @param dataSource Where the cube DN data is. The handler takes ownership
+   *          of it.
+   * @param virtualBandList The mapping from virtual band to physical band, see
+   *          CubeIoHandler's description.
+   * @param labels The Pvl labels for the cube
+   * @param alreadyOnDisk True if the cube is allocated on the disk, false
+   *          otherwise
+   */
+  CubeBsqHandler::CubeBsqHandler(CubeDataSource * dataSource,
+      const QList<int> *virtualBandList, const Pvl &labels, bool alreadyOnDisk)
+    : CubeIoHandler(dataSource, virtualBandList, labels, alreadyOnDisk) {
     int numSamplesInChunk = sampleCount();
     int numLinesInChunk = 1;
     QList<int> primeFactors;
@@ -89,26 +109,36 @@ namespace Isis {
 
 
   void CubeBsqHandler::readRaw(RawCubeChunk &chunkToFill) {
-    BigInt startByte = getChunkStartByte(chunkToFill);
+    QList<RawCubeChunk *> chunksToFill;
+    chunksToFill.append(&chunkToFill);
+    readRawChunks(chunksToFill);
+  }
 
-    bool success = false;
 
-    QFile * dataFile = getDataFile();
-    if(dataFile->seek(startByte)) {
-      QByteArray binaryData = dataFile->read(chunkToFill.getByteCount());
+  /**
+   * Read several chunks from the data source with a single request to it, so
+   *   sources like web servers can combine and overlap the reads.
+   *
+   * @param chunksToFill The chunks to read; their positions are already set
+   */
+  void CubeBsqHandler::readRawChunks(QList<RawCubeChunk *> &chunksToFill) {
+    QList< QPair<BigInt, BigInt> > ranges;
+    foreach (RawCubeChunk *chunk, chunksToFill) {
+      ranges.append(qMakePair(getChunkStartByte(*chunk), (BigInt)chunk->getByteCount()));
+    }
+
+    QList<QByteArray> binaryData = dataSource()->read(ranges);
 
-      if(binaryData.size() == chunkToFill.getByteCount()) {
-        chunkToFill.setRawData(binaryData);
-        success = true;
+    for (int i = 0; i < chunksToFill.size(); i++) {
+      if(binaryData[i].size() != chunksToFill[i]->getByteCount()) {
+        IString msg = "Reading from the file [" + dataSource()->name() + "] "
+            "failed with reading [" +
+            QString::number(chunksToFill[i]->getByteCount()) +
+            "] bytes at position [" + QString::number(ranges[i].first) + "]";
+        throw IException(IException::Io, msg, _FILEINFO_);
       }
-    }
 
-    if(!success) {
-      IString msg = "Reading from the file [" + dataFile->fileName() + "] "
-          "failed with reading [" +
-          QString::number(chunkToFill.getByteCount()) +
-          "] bytes at position [" + QString::number(startByte) + "]";
-      throw IException(IException::Io, msg, _FILEINFO_);
+      chunksToFill[i]->setRawData(binaryData[i]);
     }
   }
 
@@ -118,17 +148,14 @@ namespace Isis {
 
     bool success = false;
 
-    QFile * dataFile = getDataFile();
-    if(dataFile->seek(startByte)) {
-      BigInt dataWritten = dataFile->write(chunkToWrite.getRawData());
+    BigInt dataWritten = dataSource()->write(startByte, chunkToWrite.getRawData());
 
-      if(dataWritten == chunkToWrite.getByteCount()) {
-        success = true;
-      }
+    if(dataWritten == chunkToWrite.getByteCount()) {
+      success = true;
     }
 
     if(!success) {
-      IString msg = "Writing to the file [" + dataFile->fileName() + "] "
+      IString msg = "Writing to the file [" + dataSource()->name() + "] "
           "failed with writing [" +
           QString::number(chunkToWrite.getByteCount()) +
           "] bytes at position [" + QString::number(startByte) + "]";
@@ -58,12 +58,15 @@ namespace Isis {
     public:
       CubeBsqHandler(QFile * dataFile, const QList<int> *virtualBandList,
           const Pvl &label, bool alreadyOnDisk);
+      CubeBsqHandler(CubeDataSource * dataSource, const QList<int> *virtualBandList,
+          const Pvl &label, bool alreadyOnDisk);
       ~CubeBsqHandler();
 
       void updateLabels(Pvl &labels);
 
     protected:
       virtual void readRaw(RawCubeChunk &chunkToFill);
+      virtual void readRawChunks(QList<RawCubeChunk *> &chunksToFill);
       virtual void writeRaw(const RawCubeChunk &chunkToWrite);
 
     private:
@@ -0,0 +1,196 @@
+/**
+ * @file
+ *   Unless noted otherwise, the portions of Isis written by the USGS are
+ *   public domain. See individual third-party library and package descriptions
+ *   for intellectual property information, user agreements, and related
+ *   information.
+ *
+ *   Although Isis has been used by the USGS, no warranty, expressed or
+ *   implied, is made by the USGS as to the accuracy and functioning of such
+ *   software and related material nor shall the fact of distribution
+ *   constitute any such warranty, and no responsibility is assumed by the
+ *   USGS in connection therewith.
+ *
+ *   For additional information, launch
+ *   $ISISROOT/doc//documents/Disclaimers/Disclaimers.html
+ *   in a browser or see the Privacy &amp; Disclaimers page on the Isis website,
+ *   http://isis.astrogeology.usgs.gov, and the USGS privacy and disclaimers on
+ *   http://www.usgs.gov/privacy.html.
+ */
+
+#include "CubeCacheBudget.h"
+
+#include <algorithm>
+
+#include <unistd.h>
+
+#include <QString>
+
+#include "Preference.h"
+#include "PvlGroup.h"
+#include "PvlKeyword.h"
+
+using std::max;
+using std::min;
+
+namespace Isis {
+  /**
+   * Returns the process-wide budget, reading its size from the preferences
+   *   the first time.
+   *
+   * @return The chunk cache budget
+   */
+  CubeCacheBudget &CubeCacheBudget::budget() {
+    static CubeCacheBudget processBudget;
+    return processBudget;
+  }
+
+
+  /**
+   * Creates the budget from the CubeCacheMemory preference.
+   */
+  CubeCacheBudget::CubeCacheBudget() {
+    m_allocatedBytes.store(0);
+    m_wantedBytes.store(0);
+    m_handlerCount.store(0);
+
+    // Default to a quarter of the physical memory, or a gigabyte if the
+    //   system will not tell us
+    BigInt maximumBytes = 1024LL * 1024 * 1024;
+    long pages = sysconf(_SC_PHYS_PAGES);
+    long pageSize = sysconf(_SC_PAGE_SIZE);
+    if (pages > 0 && pageSize > 0) {
+      maximumBytes = (BigInt)pages * pageSize / 4;
+    }
+
+    PvlGroup &performance = Preference::Preferences().findGroup("Performance");
+    if (performance.hasKeyword("CubeCacheMemory")) {
+      QString memoryPreference = performance["CubeCacheMemory"][0];
+
+      if (memoryPreference.toLower() != "optimized") {
+        bool ok = false;
+        double megabytes = memoryPreference.toDouble(&ok);
+
+        if (ok && megabytes > 0.0) {
+          maximumBytes = (BigInt)(megabytes * 1024 * 1024);
+        }
+      }
+    }
+
+    m_maximumBytes.store(maximumBytes);
+  }
+
+
+  //! Destroys the budget
+  CubeCacheBudget::~CubeCacheBudget() {
+  }
+
+
+  /**
+   * @return The most chunk memory all open cubes together should use
+   */
+  BigInt CubeCacheBudget::maximumBytes() const {
+    return m_maximumBytes.load();
+  }
+
+
+  /**
+   * Changes the size of the budget. Handlers over their new allowance evict
+   *   chunks on their next IO.
+   *
+   * @param bytes The most chunk memory all open cubes together should use
+   */
+  void CubeCacheBudget::setMaximumBytes(BigInt bytes) {
+    m_maximumBytes.store(bytes);
+  }
+
+
+  /**
+   * @return The chunk memory currently allocated by all open cubes
+   */
+  BigInt CubeCacheBudget::allocatedBytes() const {
+    return m_allocatedBytes.load();
+  }
+
+
+  /**
+   * Adds the handler of a newly opened cube to the handlers sharing the
+   *   budget.
+   */
+  void CubeCacheBudget::addHandler() {
+    m_handlerCount.ref();
+  }
+
+
+  /**
+   * Removes the handler of a closed cube from the handlers sharing the budget.
+   *   The handler must have freed its chunks first.
+   */
+  void CubeCacheBudget::removeHandler() {
+    m_handlerCount.deref();
+  }
+
+
+  /**
+   * Records chunk memory allocated by a handler.
+   *
+   * @param bytes The size of the chunks
+   */
+  void CubeCacheBudget::allocated(BigInt bytes) {
+    m_allocatedBytes.fetchAndAddOrdered(bytes);
+  }
+
+
+  /**
+   * Records chunk memory freed by a handler.
+   *
+   * @param bytes The size of the chunks
+   */
+  void CubeCacheBudget::freed(BigInt bytes) {
+    m_allocatedBytes.fetchAndAddOrdered(-bytes);
+  }
+
+
+  /**
+   * The chunk memory a handler may keep after its IO: its own chunks and
+   *   whatever the other handlers have left of the budget. A handler under an
+   *   equal share of the budget that has to give up chunks asks for what it
+   *   gave up. A handler over its share gives back what was asked for, down
+   *   to its share.
+   *
+   * @param handlerBytes The chunk memory the handler has allocated
+   * @return The bytes of chunks the handler may keep
+   */
+  BigInt CubeCacheBudget::allowance(BigInt handlerBytes) {
+    BigInt maximum = m_maximumBytes.load();
+    BigInt remainder = handlerBytes + maximum - m_allocatedBytes.load();
+    BigInt share = maximum / max(m_handlerCount.load(), 1);
+
+    if (handlerBytes <= share) {
+      if (remainder < handlerBytes) {
+        // Keep the largest request, a handler asks again on each IO
+        BigInt wanted = min(handlerBytes, share) - max(remainder, (BigInt)0);
+        BigInt asked = m_wantedBytes.load();
+        while (asked < wanted && !m_wantedBytes.testAndSetOrdered(asked, wanted)) {
+          asked = m_wantedBytes.load();
+        }
+      }
+      return remainder;
+    }
+
+    BigInt asked = m_wantedBytes.load();
+    while (asked > 0) {
+      BigInt given = min(asked, min(remainder, handlerBytes) - share);
+      if (given <= 0) {
+        break;
+      }
+
+      if (m_wantedBytes.testAndSetOrdered(asked, asked - given)) {
+        return min(remainder, handlerBytes) - given;
+      }
+      asked = m_wantedBytes.load();
+    }
+
+    return remainder;
+  }
+}
@@ -0,0 +1,99 @@
+/**
+ * @file
+ * $Revision: 1.1.1.1 $
+ * $Date: 2006/10/31 23:18:06 $
+ *
+ *   Unless noted otherwise, the portions of Isis written by the USGS are
+ *   public domain. See individual third-party library and package descriptions
+ *   for intellectual property information, user agreements, and related
+ *   information.
+ *
+ *   Although Isis has been used by the USGS, no warranty, expressed or
+ *   implied, is made by the USGS as to the accuracy and functioning of such
+ *   software and related material nor shall the fact of distribution
+ *   constitute any such warranty, and no responsibility is assumed by the
+ *   USGS in connection therewith.
+ *
+ *   For additional information, launch
+ *   $ISISROOT/doc//documents/Disclaimers/Disclaimers.html
+ *   in a browser or see the Privacy &amp; Disclaimers page on the Isis website,
+ *   http://isis.astrogeology.usgs.gov, and the USGS privacy and disclaimers on
+ *   http://www.usgs.gov/privacy.html.
+ */
+
+#ifndef CubeCacheBudget_h
+#define CubeCacheBudget_h
+
+#include <QAtomicInteger>
+
+#include "Constants.h"
+
+namespace Isis {
+  /**
+   * @ingroup Low Level Cube IO
+   * @brief The memory budget shared by the chunk caches of all open cubes
+   *
+   * Every CubeIoHandler reports the cube chunks it allocates and frees to
+   *   this process-wide budget. The size of the budget is the CubeCacheMemory
+   *   keyword in the Performance group of the Isis preferences, in megabytes,
+   *   or a quarter of the physical memory when it is Optimized.
+   *
+   * A handler may keep its own chunks and whatever the other handlers have
+   *   left of the budget, so together they never keep more than the budget.
+   *   A handler under an equal share of the budget that has to give up chunks
+   *   asks for the memory, and the handlers over their share give it back on
+   *   their next IO. Handlers evict their own chunks, so the caching
+   *   algorithms of one cube never touch the chunks of another.
+   *
+   * The budget is kept in atomic counters, so reporting chunks and asking
+   *   for an allowance never wait on the IO of other cubes.
+   */
+  class CubeCacheBudget {
+    public:
+      static CubeCacheBudget &budget();
+
+      BigInt maximumBytes() const;
+      void setMaximumBytes(BigInt bytes);
+      BigInt allocatedBytes() const;
+
+      void addHandler();
+      void removeHandler();
+      void allocated(BigInt bytes);
+      void freed(BigInt bytes);
+      BigInt allowance(BigInt handlerBytes);
+
+    private:
+      CubeCacheBudget();
+      ~CubeCacheBudget();
+
+      /**
+       * Disallow copying of this object.
+       *
+       * @param other The object to copy.
+       */
+      CubeCacheBudget(const CubeCacheBudget &other);
+
+      /**
+       * Disallow assignments of this object
+       *
+       * @param other The object to copy.
+       * @return A reference to *this.
+       */
+      CubeCacheBudget &operator=(const CubeCacheBudget &other);
+
+    private:
+      //! The most chunk memory all of the handlers together should use
+      QAtomicInteger<qint64> m_maximumBytes;
+
+      //! The chunk memory allocated by all of the handlers
+      QAtomicInteger<qint64> m_allocatedBytes;
+
+      //! The chunk memory handlers under their share had to give up
+      QAtomicInteger<qint64> m_wantedBytes;
+
+      //! The number of handlers sharing the budget
+      QAtomicInt m_handlerCount;
+  };
+}
+
+#endif
@@ -0,0 +1,340 @@
+/**
+ * @file
+ * $Revision: 1.1 $
+ * $Date: 2007/09/14 16:44:07 $
+ *
+ *   Unless noted otherwise, the portions of Isis written by the USGS are
+ *   public domain. See individual third-party library and package descriptions
+ *   for intellectual property information, user agreements, and related
+ *   information.
+ *
+ *   Although Isis has been used by the USGS, no warranty, expressed or
+ *   implied, is made by the USGS as to the accuracy and functioning of such
+ *   software and related material nor shall the fact of distribution
+ *   constitute any such warranty, and no responsibility is assumed by the
+ *   USGS in connection therewith.
+ *
+ *   For additional information, launch
+ *   $ISISROOT/doc//documents/Disclaimers/Disclaimers.html
+ *   in a browser or see the Privacy &amp; Disclaimers page on the Isis website,
+ *   http://isis.astrogeology.usgs.gov, and the USGS privacy and disclaimers on
+ *   http://www.usgs.gov/privacy.html.
+ */
+
+#include "CubeCompressedTileHandler.h"
+
+#include <algorithm>
+
+#include <QFile>
+#include <QtConcurrentMap>
+#include <QtEndian>
+
+#include "CubeFileDataSource.h"
+#include "IException.h"
+#include "IString.h"
+#include "Pvl.h"
+#include "PvlKeyword.h"
+#include "PvlObject.h"
+#include "RawCubeChunk.h"
+
+using namespace std;
+
+namespace Isis {
+  /**
+   * Construct a compressed tile handler. New cubes get an empty tile index and
+   *   the file is sized to hold only the index, existing cubes have their tile
+   *   index read from the file.
+   *
+   * @param dataFile The file with cube DN data in it
+   * @param virtualBandList The mapping from virtual band to physical band, see
+   *          CubeIoHandler's description.
+   * @param labels The Pvl labels for the cube
+   * @param alreadyOnDisk True if the cube is allocated on the disk, false
+   *          otherwise
+   */
+  CubeCompressedTileHandler::CubeCompressedTileHandler(QFile * dataFile,
+      const QList<int> *virtualBandList, const Pvl &labels, bool alreadyOnDisk)
+      : CubeTileHandler(dataFile ? new CubeFileDataSource(dataFile) : NULL,
+                        virtualBandList, labels, alreadyOnDisk, false) {
+    int chunkCount = getChunkCountInSampleDimension() *
+                     getChunkCountInLineDimension() *
+                     getChunkCountInBandDimension();
+    m_offsets.fill(0, chunkCount);
+    m_sizes.fill(0, chunkCount);
+
+    QFile * file = getDataFile();
+    if (alreadyOnDisk) {
+      readIndex();
+
+      if (file->size() < getDataStartByte() + getDataSize()) {
+        QString msg = "File size [" + toString((BigInt)file->size()) +
+                      " bytes] not big enough to hold the compressed tiles [" +
+                      toString(getDataStartByte() + getDataSize()) +
+                      " bytes] where the offset to the cube data is [" +
+                      toString(getDataStartByte()) + " bytes]";
+        throw IException(IException::Io, msg, _FILEINFO_);
+      }
+    }
+    else {
+      // Only the index is allocated, the tiles are appended as they are written
+      QByteArray emptyIndex(getIndexByteCount(), '\0');
+      if (!file->resize(getDataStartByte() + getIndexByteCount()) ||
+          !file->seek(getDataStartByte()) ||
+          file->write(emptyIndex) != emptyIndex.size()) {
+        QString msg = "Writing the tile index to the file [" + file->fileName() +
+                      "] failed";
+        throw IException(IException::Io, msg, _FILEINFO_);
+      }
+    }
+  }
+
+
+  /**
+   * Writes all data from memory to disk. This has to happen here, the
+   *   CubeTileHandler destructor would write the tiles uncompressed.
+   */
+  CubeCompressedTileHandler::~CubeCompressedTileHandler() {
+    clearCache();
+  }
+
+
+  /**
+   * @return The number of bytes the tile index and the compressed tiles
+   *   currently use in the file, including space left by moved tiles.
+   */
+  BigInt CubeCompressedTileHandler::getDataSize() const {
+    BigInt dataSize = getIndexByteCount();
+    for (int i = 0; i < m_offsets.size(); i++) {
+      dataSize = max(dataSize, m_offsets[i] + m_sizes[i]);
+    }
+
+    return dataSize;
+  }
+
+
+  /**
+   * Update the cube labels so that this cube indicates it is compressed and
+   *   what tile size it used.
+   *
+   * @param labels The "Core" object in this Pvl will be updated
+   */
+  void CubeCompressedTileHandler::updateLabels(Pvl &labels) {
+    CubeTileHandler::updateLabels(labels);
+
+    PvlObject &core = labels.findObject("IsisCube").findObject("Core");
+    core.addKeyword(PvlKeyword("Format", "CompressedTile"),
+                    PvlContainer::Replace);
+  }
+
+
+  void CubeCompressedTileHandler::readRaw(RawCubeChunk &chunkToFill) {
+    QList<RawCubeChunk *> chunksToFill;
+    chunksToFill.append(&chunkToFill);
+    readRawChunks(chunksToFill);
+  }
+
+
+  /**
+   * Reads the compressed tiles one after another and then decompresses them
+   *   in parallel.
+   *
+   * @param chunksToFill The containers that need to be filled with cube data.
+   */
+  void CubeCompressedTileHandler::readRawChunks(QList<RawCubeChunk *> &chunksToFill) {
+    QList<CompressedChunk> compressedChunks;
+    foreach (RawCubeChunk *chunk, chunksToFill) {
+      CompressedChunk compressedChunk;
+      compressedChunk.chunk = chunk;
+      compressedChunk.compressed = readCompressed(*chunk);
+      compressedChunk.failed = false;
+      compressedChunks.append(compressedChunk);
+    }
+
+    DecompressFunctor functor(&nullChunkData());
+    if (compressedChunks.size() == 1) {
+      functor(compressedChunks[0]);
+    }
+    else {
+      QtConcurrent::blockingMap(compressedChunks, functor);
+    }
+
+    foreach (const CompressedChunk &compressedChunk, compressedChunks) {
+      if (compressedChunk.failed) {
+        throw compressedChunk.error;
+      }
+    }
+  }
+
+
+  /**
+   * Compresses a tile and writes it to disk. Tiles of NULLs are only recorded
+   *   in the index.
+   *
+   * @param chunkToWrite The container that needs to be put on disk.
+   */
+  void CubeCompressedTileHandler::writeRaw(const RawCubeChunk &chunkToWrite) {
+    int chunkIndex = getChunkIndex(chunkToWrite);
+
+    if (chunkToWrite.getRawData() == nullChunkData()) {
+      if (m_sizes[chunkIndex] != 0) {
+        m_offsets[chunkIndex] = 0;
+        m_sizes[chunkIndex] = 0;
+        writeIndexEntry(chunkIndex);
+      }
+      return;
+    }
+
+    QByteArray compressed = qCompress(chunkToWrite.getRawData(), 1);
+
+    QFile * dataFile = getDataFile();
+    BigInt offset = m_offsets[chunkIndex];
+    if (m_sizes[chunkIndex] == 0 || compressed.size() > m_sizes[chunkIndex]) {
+      // Put the tile after everything else in the file, which may include blobs
+      offset = max((BigInt)dataFile->size() - getDataStartByte(), getIndexByteCount());
+    }
+
+    bool success = false;
+    if (dataFile->seek(getDataStartByte() + offset)) {
+      BigInt dataWritten = dataFile->write(compressed);
+
+      if (dataWritten == compressed.size()) {
+        success = true;
+      }
+    }
+
+    if (!success) {
+      IString msg = "Writing to the file [" + dataFile->fileName() + "] "
+          "failed with writing [" + QString::number(compressed.size()) +
+          "] bytes at position [" + QString::number(getDataStartByte() + offset) + "]";
+      throw IException(IException::Io, msg, _FILEINFO_);
+    }
+
+    m_offsets[chunkIndex] = offset;
+    m_sizes[chunkIndex] = compressed.size();
+    writeIndexEntry(chunkIndex);
+  }
+
+
+  /**
+   * @return The size of the tile index at the start of the DN data
+   */
+  BigInt CubeCompressedTileHandler::getIndexByteCount() const {
+    return (BigInt)m_offsets.size() * 2 * sizeof(qint64);
+  }
+
+
+  /**
+   * Read the compressed bytes of a tile from disk.
+   *
+   * @param chunk The chunk to read the tile of
+   * @return The compressed tile, empty if the tile is all NULLs
+   */
+  QByteArray CubeCompressedTileHandler::readCompressed(const RawCubeChunk &chunk) {
+    int chunkIndex = getChunkIndex(chunk);
+    if (m_sizes[chunkIndex] == 0) {
+      return QByteArray();
+    }
+
+    BigInt startByte = getDataStartByte() + m_offsets[chunkIndex];
+    QFile * dataFile = getDataFile();
+    if (dataFile->seek(startByte)) {
+      QByteArray compressed = dataFile->read(m_sizes[chunkIndex]);
+
+      if (compressed.size() == m_sizes[chunkIndex]) {
+        return compressed;
+      }
+    }
+
+    IString msg = "Reading from the file [" + dataFile->fileName() + "] "
+        "failed with reading [" + QString::number(m_sizes[chunkIndex]) +
+        "] bytes at position [" + QString::number(startByte) + "]";
+    throw IException(IException::Io, msg, _FILEINFO_);
+  }
+
+
+  /**
+   * Read the tile index from the start of the DN data.
+   */
+  void CubeCompressedTileHandler::readIndex() {
+    QFile * dataFile = getDataFile();
+    QByteArray index;
+    if (dataFile->seek(getDataStartByte())) {
+      index = dataFile->read(getIndexByteCount());
+    }
+
+    if (index.size() != getIndexByteCount()) {
+      QString msg = "Reading the tile index from the file [" +
+                    dataFile->fileName() + "] failed";
+      throw IException(IException::Io, msg, _FILEINFO_);
+    }
+
+    const uchar *entries = (const uchar *)index.constData();
+    for (int i = 0; i < m_offsets.size(); i++) {
+      m_offsets[i] = qFromLittleEndian<qint64>(entries + 16 * i);
+      m_sizes[i] = qFromLittleEndian<qint64>(entries + 16 * i + 8);
+    }
+  }
+
+
+  /**
+   * Write the index entry of a tile to disk.
+   *
+   * @param chunkIndex The index of the tile's chunk
+   */
+  void CubeCompressedTileHandler::writeIndexEntry(int chunkIndex) {
+    uchar entry[16];
+    qToLittleEndian<qint64>(m_offsets[chunkIndex], entry);
+    qToLittleEndian<qint64>(m_sizes[chunkIndex], entry + 8);
+
+    QFile * dataFile = getDataFile();
+    if (!dataFile->seek(getDataStartByte() + 16 * (BigInt)chunkIndex) ||
+        dataFile->write((const char *)entry, 16) != 16) {
+      QString msg = "Writing the tile index to the file [" + dataFile->fileName() +
+                    "] failed";
+      throw IException(IException::Io, msg, _FILEINFO_);
+    }
+  }
+
+
+  /**
+   * Constructs a DecompressFunctor.
+   *
+   * @param nullChunkData The raw bytes of a tile of NULLs. This is not owned.
+   */
+  CubeCompressedTileHandler::DecompressFunctor::DecompressFunctor(
+      const QByteArray *nullChunkData) {
+    m_nullChunkData = nullChunkData;
+  }
+
+
+  /**
+   * Decompress one tile into its chunk, recording any error in the tile.
+   *
+   * @param compressedChunk The tile to decompress
+   */
+  void CubeCompressedTileHandler::DecompressFunctor::operator()(
+      CompressedChunk &compressedChunk) const {
+    try {
+      RawCubeChunk *chunk = compressedChunk.chunk;
+      if (compressedChunk.compressed.isEmpty()) {
+        chunk->setRawData(*m_nullChunkData);
+        return;
+      }
+
+      QByteArray rawData = qUncompress(compressedChunk.compressed);
+      if (rawData.size() != chunk->getByteCount()) {
+        QString msg = "The compressed tile at sample [" +
+                      toString(chunk->getStartSample()) + "], line [" +
+                      toString(chunk->getStartLine()) + "], band [" +
+                      toString(chunk->getStartBand()) + "] is corrupt";
+        throw IException(IException::Io, msg, _FILEINFO_);
+      }
+
+      chunk->setRawData(rawData);
+    }
+    catch (IException &e) {
+      compressedChunk.failed = true;
+      compressedChunk.error = e;
+    }
+  }
+}
@@ -0,0 +1,126 @@
+/**
+ * @file
+ * $Revision: 1.1 $
+ * $Date: 2008/09/03 16:21:02 $
+ *
+ *   Unless noted otherwise, the portions of Isis written by the USGS are
+ *   public domain. See individual third-party library and package descriptions
+ *   for intellectual property information, user agreements, and related
+ *   information.
+ *
+ *   Although Isis has been used by the USGS, no warranty, expressed or
+ *   implied, is made by the USGS as to the accuracy and functioning of such
+ *   software and related material nor shall the fact of distribution
+ *   constitute any such warranty, and no responsibility is assumed by the
+ *   USGS in connection therewith.
+ *
+ *   For additional information, launch
+ *   $ISISROOT/doc//documents/Disclaimers/Disclaimers.html
+ *   in a browser or see the Privacy &amp; Disclaimers page on the Isis website,
+ *   http://isis.astrogeology.usgs.gov, and the USGS privacy and disclaimers on
+ *   http://www.usgs.gov/privacy.html.
+ */
+
+#ifndef CubeTileHandler_h
+#ifndef CubeCompressedTileHandler_h
+#define CubeCompressedTileHandler_h
+
+#include "CubeTileHandler.h"
+
+#include <QByteArray>
+#include <QList>
+#include <QVector>
+
+#include "IException.h"
+
+namespace Isis {
+
+  /**
+   * @brief IO Handler for Isis Cubes using the compressed tile format.
+   *
+   * This stores cubes in the same tiles as the Tile format, but each tile is
+   *   compressed with zlib on its way to disk. Tiles that contain only NULLs
+   *   are not stored at all, which makes mostly-NULL map projected cubes and
+   *   8-bit cubes much smaller.
+   *
+   * The DN data starts with an index of every tile in the cube. Each entry is
+   *   the 8-byte offset of the compressed tile from the start of the DN data
+   *   followed by its 8-byte size, both least significant byte first. An entry
+   *   with a size of zero is a tile of NULLs. The compressed tiles follow the
+   *   index in the order they were written. A tile that grows when it is
+   *   rewritten is moved to the end of the file, leaving its old space unused.
+   *
+   * The tiles needed by a read are decompressed in parallel on the global
+   *   thread pool.
+   *
+   * @ingroup LowLevelCubeIO
+   */
+  class CubeCompressedTileHandler : public CubeTileHandler {
+    public:
+      CubeCompressedTileHandler(QFile * dataFile, const QList<int> *virtualBandList,
+          const Pvl &label, bool alreadyOnDisk);
+      ~CubeCompressedTileHandler();
+
+      BigInt getDataSize() const;
+      void updateLabels(Pvl &label);
+
+    protected:
+      virtual void readRaw(RawCubeChunk &chunkToFill);
+      virtual void readRawChunks(QList<RawCubeChunk *> &chunksToFill);
+      virtual void writeRaw(const RawCubeChunk &chunkToWrite);
+
+    private:
+      /**
+       * Disallow copying of this object.
+       *
+       * @param other The object to copy.
+       */
+      CubeCompressedTileHandler(const CubeCompressedTileHandler &other);
+
+      /**
+       * Disallow assignments of this object
+       *
+       * @param other The CubeCompressedTileHandler on the right-hand side of
+       *              the assignment that we are copying into *this.
+       * @return A reference to *this.
+       */
+      CubeCompressedTileHandler &operator=(const CubeCompressedTileHandler &other);
+
+      /**
+       * A tile read from disk that still needs to be decompressed.
+       */
+      struct CompressedChunk {
+        RawCubeChunk *chunk;   //!< The chunk to fill, not owned
+        QByteArray compressed; //!< The compressed tile, empty for a NULL tile
+        bool failed;           //!< True if decompressing the tile failed
+        IException error;      //!< The reason decompressing the tile failed
+      };
+
+      /**
+       * Functor for QtConcurrent that decompresses one tile into its chunk.
+       */
+      class DecompressFunctor {
+        public:
+          DecompressFunctor(const QByteArray *nullChunkData);
+
+          void operator()(CompressedChunk &compressedChunk) const;
+
+        private:
+          const QByteArray *m_nullChunkData; //!< The raw bytes of a NULL tile
+      };
+
+      BigInt getIndexByteCount() const;
+      QByteArray readCompressed(const RawCubeChunk &chunk);
+      void readIndex();
+      void writeIndexEntry(int chunkIndex);
+
+    private:
+      //! The offset of each tile from the start of the DN data
+      QVector<BigInt> m_offsets;
+
+      //! The compressed size of each tile, zero for NULL tiles
+      QVector<BigInt> m_sizes;
+  };
+}
+
+#endif
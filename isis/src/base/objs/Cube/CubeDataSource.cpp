@@ -0,0 +1,66 @@
+/**
+ * @file
+ * $Revision: 1.1.1.1 $
+ * $Date: 2006/10/31 23:18:06 $
+ *
+ *   Unless noted otherwise, the portions of Isis written by the USGS are
+ *   public domain. See individual third-party library and package descriptions
+ *   for intellectual property information, user agreements, and related
+ *   information.
+ *
+ *   Although Isis has been used by the USGS, no warranty, expressed or
+ *   implied, is made by the USGS as to the accuracy and functioning of such
+ *   software and related material nor shall the fact of distribution
+ *   constitute any such warranty, and no responsibility is assumed by the
+ *   USGS in connection therewith.
+ *
+ *   For additional information, launch
+ *   $ISISROOT/doc//documents/Disclaimers/Disclaimers.html
+ *   in a browser or see the Privacy &amp; Disclaimers page on the Isis website,
+ *   http://isis.astrogeology.usgs.gov, and the USGS privacy and disclaimers on
+ *   http://www.usgs.gov/privacy.html.
+ */
+
+#include "CubeDataSource.h"
+
+namespace Isis {
+  /**
+   * Construct a data source.
+   */
+  CubeDataSource::CubeDataSource() {
+  }
+
+
+  /**
+   * Destroy a data source.
+   */
+  CubeDataSource::~CubeDataSource() {
+  }
+
+
+  /**
+   * Read several ranges of bytes from the source. Each range is a pair of
+   *   the position of its first byte and its byte count. This reads the
+   *   ranges one at a time; sources where each request is expensive should
+   *   combine them.
+   *
+   * @param ranges The ranges to read
+   * @returns The bytes read for each range, in the order of the ranges
+   */
+  QList<QByteArray> CubeDataSource::read(const QList< QPair<BigInt, BigInt> > &ranges) {
+    QList<QByteArray> results;
+    for (int i = 0; i < ranges.size(); i++) {
+      results.append(read(ranges[i].first, ranges[i].second));
+    }
+
+    return results;
+  }
+
+
+  /**
+   * Make sure everything written has reached the storage. This does nothing
+   *   by default.
+   */
+  void CubeDataSource::flush() {
+  }
+}
@@ -0,0 +1,114 @@
+/**
+ * @file
+ * $Revision: 1.1.1.1 $
+ * $Date: 2006/10/31 23:18:06 $
+ *
+ *   Unless noted otherwise, the portions of Isis written by the USGS are
+ *   public domain. See individual third-party library and package descriptions
+ *   for intellectual property information, user agreements, and related
+ *   information.
+ *
+ *   Although Isis has been used by the USGS, no warranty, expressed or
+ *   implied, is made by the USGS as to the accuracy and functioning of such
+ *   software and related material nor shall the fact of distribution
+ *   constitute any such warranty, and no responsibility is assumed by the
+ *   USGS in connection therewith.
+ *
+ *   For additional information, launch
+ *   $ISISROOT/doc//documents/Disclaimers/Disclaimers.html
+ *   in a browser or see the Privacy &amp; Disclaimers page on the Isis website,
+ *   http://isis.astrogeology.usgs.gov, and the USGS privacy and disclaimers on
+ *   http://www.usgs.gov/privacy.html.
+ */
+#ifndef CubeDataSource_h
+#define CubeDataSource_h
+
+#include <QByteArray>
+#include <QList>
+#include <QPair>
+#include <QString>
+
+#include "Constants.h"
+
+namespace Isis {
+  /**
+   * @ingroup Low Level Cube IO
+   * @brief The bytes of a cube's DN data, wherever they are stored
+   *
+   * CubeIoHandler reads and writes cube DN data through a data source, so the
+   *   same handlers can work on a local file or on a cube stored somewhere
+   *   else, like an object store. Byte positions are from the start of the
+   *   file holding the DN data, starting at zero.
+   *
+   * The handlers ask for all of the chunks an IO needs at once, so sources
+   *   with a high cost per request can combine and overlap them.
+   *
+   * @see CubeFileDataSource
+   * @see CubeHttpDataSource
+   */
+  class CubeDataSource {
+    public:
+      CubeDataSource();
+      virtual ~CubeDataSource();
+
+      /**
+       * @returns A name for the source to use in messages, like a file name
+       */
+      virtual QString name() const = 0;
+
+      /**
+       * @returns The size of the source in bytes
+       */
+      virtual BigInt size() const = 0;
+
+      /**
+       * Change the size of the source, adding zeros or discarding bytes at
+       *   the end.
+       *
+       * @param newSize The new size of the source in bytes
+       * @returns True if the size was changed
+       */
+      virtual bool resize(BigInt newSize) = 0;
+
+      /**
+       * Read a range of bytes from the source.
+       *
+       * @param startByte The position of the first byte
+       * @param byteCount The number of bytes to read
+       * @returns The bytes read, which are fewer than asked for if the read
+       *   failed or went past the end of the source
+       */
+      virtual QByteArray read(BigInt startByte, BigInt byteCount) = 0;
+
+      virtual QList<QByteArray> read(const QList< QPair<BigInt, BigInt> > &ranges);
+
+      /**
+       * Write bytes to the source.
+       *
+       * @param startByte The position to write the first byte to
+       * @param data The bytes to write
+       * @returns The number of bytes written, or -1 if the write failed
+       */
+      virtual BigInt write(BigInt startByte, const QByteArray &data) = 0;
+
+      virtual void flush();
+
+    private:
+      /**
+       * Disallow copying data sources.
+       *
+       * @param other The data source to copy
+       */
+      CubeDataSource(const CubeDataSource &other);
+
+      /**
+       * Disallow assigning data sources.
+       *
+       * @param other The data source to copy
+       * @returns Nothing, this is not implemented
+       */
+      CubeDataSource &operator=(const CubeDataSource &other);
+  };
+}
+
+#endif
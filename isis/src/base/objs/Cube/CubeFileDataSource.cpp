@@ -0,0 +1,120 @@
+/**
+ * @file
+ * $Revision: 1.1.1.1 $
+ * $Date: 2006/10/31 23:18:06 $
+ *
+ *   Unless noted otherwise, the portions of Isis written by the USGS are
+ *   public domain. See individual third-party library and package descriptions
+ *   for intellectual property information, user agreements, and related
+ *   information.
+ *
+ *   Although Isis has been used by the USGS, no warranty, expressed or
+ *   implied, is made by the USGS as to the accuracy and functioning of such
+ *   software and related material nor shall the fact of distribution
+ *   constitute any such warranty, and no responsibility is assumed by the
+ *   USGS in connection therewith.
+ *
+ *   For additional information, launch
+ *   $ISISROOT/doc//documents/Disclaimers/Disclaimers.html
+ *   in a browser or see the Privacy &amp; Disclaimers page on the Isis website,
+ *   http://isis.astrogeology.usgs.gov, and the USGS privacy and disclaimers on
+ *   http://www.usgs.gov/privacy.html.
+ */
+
+#include "CubeFileDataSource.h"
+
+#include <QFile>
+
+namespace Isis {
+  /**
+   * Construct a data source for a local file.
+   *
+   * @param dataFile The opened file with the DN data in it
+   */
+  CubeFileDataSource::CubeFileDataSource(QFile *dataFile) {
+    m_dataFile = dataFile;
+  }
+
+
+  /**
+   * Destroy the data source. The file is left open.
+   */
+  CubeFileDataSource::~CubeFileDataSource() {
+    m_dataFile = NULL;
+  }
+
+
+  /**
+   * @returns The file with the DN data in it
+   */
+  QFile *CubeFileDataSource::file() const {
+    return m_dataFile;
+  }
+
+
+  /**
+   * @returns The name of the file
+   */
+  QString CubeFileDataSource::name() const {
+    return m_dataFile->fileName();
+  }
+
+
+  /**
+   * @returns The size of the file in bytes
+   */
+  BigInt CubeFileDataSource::size() const {
+    return m_dataFile->size();
+  }
+
+
+  /**
+   * Change the size of the file.
+   *
+   * @param newSize The new size of the file in bytes
+   * @returns True if the size was changed
+   */
+  bool CubeFileDataSource::resize(BigInt newSize) {
+    return m_dataFile->resize(newSize);
+  }
+
+
+  /**
+   * Read a range of bytes from the file.
+   *
+   * @param startByte The position of the first byte
+   * @param byteCount The number of bytes to read
+   * @returns The bytes read
+   */
+  QByteArray CubeFileDataSource::read(BigInt startByte, BigInt byteCount) {
+    if (!m_dataFile->seek(startByte)) {
+      return QByteArray();
+    }
+
+    return m_dataFile->read(byteCount);
+  }
+
+
+  /**
+   * Write bytes to the file.
+   *
+   * @param startByte The position to write the first byte to
+   * @param data The bytes to write
+   * @returns The number of bytes written, or -1 if the write failed
+   */
+  BigInt CubeFileDataSource::write(BigInt startByte, const QByteArray &data) {
+    if (!m_dataFile->seek(startByte)) {
+      return -1;
+    }
+
+    return m_dataFile->write(data);
+  }
+
+
+  /**
+   * Flush the file's buffers to the disk.
+   */
+  void CubeFileDataSource::flush() {
+    m_dataFile->flush();
+  }
+}
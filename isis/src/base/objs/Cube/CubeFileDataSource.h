@@ -0,0 +1,57 @@
+/**
+ * @file
+ * $Revision: 1.1.1.1 $
+ * $Date: 2006/10/31 23:18:06 $
+ *
+ *   Unless noted otherwise, the portions of Isis written by the USGS are
+ *   public domain. See individual third-party library and package descriptions
+ *   for intellectual property information, user agreements, and related
+ *   information.
+ *
+ *   Although Isis has been used by the USGS, no warranty, expressed or
+ *   implied, is made by the USGS as to the accuracy and functioning of such
+ *   software and related material nor shall the fact of distribution
+ *   constitute any such warranty, and no responsibility is assumed by the
+ *   USGS in connection therewith.
+ *
+ *   For additional information, launch
+ *   $ISISROOT/doc//documents/Disclaimers/Disclaimers.html
+ *   in a browser or see the Privacy &amp; Disclaimers page on the Isis website,
+ *   http://isis.astrogeology.usgs.gov, and the USGS privacy and disclaimers on
+ *   http://www.usgs.gov/privacy.html.
+ */
+#ifndef CubeFileDataSource_h
+#define CubeFileDataSource_h
+
+#include "CubeDataSource.h"
+
+class QFile;
+
+namespace Isis {
+  /**
+   * @ingroup Low Level Cube IO
+   * @brief Cube DN data in a local file
+   *
+   * This reads and writes an opened QFile. The file is not owned by the data
+   *   source and must outlive it.
+   */
+  class CubeFileDataSource : public CubeDataSource {
+    public:
+      CubeFileDataSource(QFile *dataFile);
+      virtual ~CubeFileDataSource();
+
+      QFile *file() const;
+
+      virtual QString name() const;
+      virtual BigInt size() const;
+      virtual bool resize(BigInt newSize);
+      virtual QByteArray read(BigInt startByte, BigInt byteCount);
+      virtual BigInt write(BigInt startByte, const QByteArray &data);
+      virtual void flush();
+
+    private:
+      QFile *m_dataFile; //!< The file with the DN data in it
+  };
+}
+
+#endif
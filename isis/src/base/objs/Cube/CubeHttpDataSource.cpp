@@ -0,0 +1,297 @@
+/**
+ * @file
+ * $Revision: 1.1.1.1 $
+ * $Date: 2006/10/31 23:18:06 $
+ *
+ *   Unless noted otherwise, the portions of Isis written by the USGS are
+ *   public domain. See individual third-party library and package descriptions
+ *   for intellectual property information, user agreements, and related
+ *   information.
+ *
+ *   Although Isis has been used by the USGS, no warranty, expressed or
+ *   implied, is made by the USGS as to the accuracy and functioning of such
+ *   software and related material nor shall the fact of distribution
+ *   constitute any such warranty, and no responsibility is assumed by the
+ *   USGS in connection therewith.
+ *
+ *   For additional information, launch
+ *   $ISISROOT/doc//documents/Disclaimers/Disclaimers.html
+ *   in a browser or see the Privacy &amp; Disclaimers page on the Isis website,
+ *   http://isis.astrogeology.usgs.gov, and the USGS privacy and disclaimers on
+ *   http://www.usgs.gov/privacy.html.
+ */
+
+#include "CubeHttpDataSource.h"
+
+#include <QEventLoop>
+#include <QMultiMap>
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QNetworkRequest>
+
+#include "IException.h"
+#include "IString.h"
+
+namespace Isis {
+  /**
+   * One request for a contiguous range of bytes that covers one or more of
+   *   the ranges being read.
+   */
+  struct RangeRequest {
+    BigInt startByte;      //!< The first byte requested
+    BigInt endByte;        //!< One past the last byte requested
+    QList<int> ranges;     //!< The indices of the ranges this request covers
+    QNetworkReply *reply;  //!< The reply to the request
+  };
+
+
+  /**
+   * Run an event loop until every reply has finished.
+   *
+   * @param manager The network access manager the replies came from
+   * @param replies The replies to wait for
+   */
+  static void waitForReplies(QNetworkAccessManager &manager, const QList<QNetworkReply *> &replies) {
+    QEventLoop loop;
+    QObject::connect(&manager, SIGNAL(finished(QNetworkReply *)), &loop, SLOT(quit()));
+
+    bool finished = false;
+    while (!finished) {
+      finished = true;
+      foreach (QNetworkReply *reply, replies) {
+        finished = finished && reply->isFinished();
+      }
+
+      if (!finished) {
+        loop.exec();
+      }
+    }
+  }
+
+
+  /**
+   * Construct a data source for a cube at a URL. This asks the server for
+   *   the size of the cube.
+   *
+   * @param url The location of the cube
+   */
+  CubeHttpDataSource::CubeHttpDataSource(const QUrl &url) {
+    m_url = url;
+    m_size = 0;
+
+    QNetworkReply *reply = manager()->head(QNetworkRequest(m_url));
+    waitForReplies(*manager(), QList<QNetworkReply *>() << reply);
+
+    bool hasSize = false;
+    if (reply->error() == QNetworkReply::NoError) {
+      m_size = reply->header(QNetworkRequest::ContentLengthHeader).toLongLong(&hasSize);
+    }
+
+    if (!hasSize) {
+      QString msg = "Unable to get the size of the cube [" + m_url.toString() + "]";
+      if (reply->error() != QNetworkReply::NoError) {
+        msg += ". " + reply->errorString();
+      }
+      delete reply;
+      throw IException(IException::Io, msg, _FILEINFO_);
+    }
+
+    delete reply;
+  }
+
+
+  /**
+   * Destroy the data source.
+   */
+  CubeHttpDataSource::~CubeHttpDataSource() {
+  }
+
+
+  /**
+   * @returns The location of the cube
+   */
+  QUrl CubeHttpDataSource::url() const {
+    return m_url;
+  }
+
+
+  /**
+   * @returns The URL of the cube
+   */
+  QString CubeHttpDataSource::name() const {
+    return m_url.toString();
+  }
+
+
+  /**
+   * @returns The size of the cube in bytes
+   */
+  BigInt CubeHttpDataSource::size() const {
+    return m_size;
+  }
+
+
+  /**
+   * Remote cubes are read-only, so they can't be resized.
+   *
+   * @param newSize The new size in bytes
+   * @returns True if the size is unchanged
+   */
+  bool CubeHttpDataSource::resize(BigInt newSize) {
+    return newSize == m_size;
+  }
+
+
+  /**
+   * Read a range of bytes from the cube.
+   *
+   * @param startByte The position of the first byte
+   * @param byteCount The number of bytes to read
+   * @returns The bytes read
+   */
+  QByteArray CubeHttpDataSource::read(BigInt startByte, BigInt byteCount) {
+    QList< QPair<BigInt, BigInt> > ranges;
+    ranges.append(qMakePair(startByte, byteCount));
+    return read(ranges).first();
+  }
+
+
+  /**
+   * Read several ranges of bytes from the cube. Ranges that touch or overlap
+   *   are requested together, and all of the requests are made at once.
+   *
+   * @param ranges The position of the first byte and byte count of each range
+   * @returns The bytes read for each range, in the order of the ranges
+   */
+  QList<QByteArray> CubeHttpDataSource::read(const QList< QPair<BigInt, BigInt> > &ranges) {
+    QList<QByteArray> results;
+    for (int i = 0; i < ranges.size(); i++) {
+      results.append(QByteArray());
+    }
+
+    QMultiMap<BigInt, int> rangesByStart;
+    for (int i = 0; i < ranges.size(); i++) {
+      if (ranges[i].second > 0 && ranges[i].first < m_size) {
+        rangesByStart.insert(ranges[i].first, i);
+      }
+    }
+
+    QList<RangeRequest> requests;
+    QMapIterator<BigInt, int> it(rangesByStart);
+    while (it.hasNext()) {
+      it.next();
+      BigInt startByte = it.key();
+      BigInt endByte = qMin(startByte + ranges[it.value()].second, m_size);
+
+      if (!requests.isEmpty() && startByte <= requests.last().endByte &&
+          qMax(endByte, requests.last().endByte) - requests.last().startByte <=
+            MaximumRequestBytes) {
+        requests.last().endByte = qMax(endByte, requests.last().endByte);
+        requests.last().ranges.append(it.value());
+      }
+      else {
+        RangeRequest request;
+        request.startByte = startByte;
+        request.endByte = endByte;
+        request.ranges.append(it.value());
+        request.reply = NULL;
+        requests.append(request);
+      }
+    }
+
+    if (requests.isEmpty()) {
+      return results;
+    }
+
+    // The manager keeps up to six connections to the server busy and queues
+    //   the rest of the requests
+    QList<QNetworkReply *> replies;
+    for (int i = 0; i < requests.size(); i++) {
+      QNetworkRequest request(m_url);
+      request.setRawHeader("Range", "bytes=" + QByteArray::number(requests[i].startByte) + "-" +
+                                    QByteArray::number(requests[i].endByte - 1));
+      requests[i].reply = manager()->get(request);
+      replies.append(requests[i].reply);
+    }
+
+    waitForReplies(*manager(), replies);
+
+    try {
+      for (int i = 0; i < requests.size(); i++) {
+        const RangeRequest &request = requests[i];
+        QNetworkReply *reply = request.reply;
+        int status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+        QString bytesRead = "Reading bytes [" + toString(request.startByte) + "] through [" +
+                            toString(request.endByte - 1) + "] of the cube [" +
+                            m_url.toString() + "] failed";
+
+        if (reply->error() != QNetworkReply::NoError) {
+          QString msg = bytesRead + ". " + reply->errorString();
+          throw IException(IException::Io, msg, _FILEINFO_);
+        }
+
+        // A server that ignores the range answers with the whole file, which
+        //   is not worth transferring for a part of it
+        if (status != 206) {
+          QString msg = bytesRead + ". The server answered with HTTP status [" +
+                        toString(status) + "] instead of a partial response, so it does "
+                        "not support range requests";
+          throw IException(IException::Io, msg, _FILEINFO_);
+        }
+
+        QByteArray data = reply->readAll();
+        if (data.size() != request.endByte - request.startByte) {
+          QString msg = bytesRead + ". The server sent [" + toString(data.size()) +
+                        "] bytes";
+          throw IException(IException::Io, msg, _FILEINFO_);
+        }
+
+        foreach (int rangeIndex, request.ranges) {
+          results[rangeIndex] = data.mid(ranges[rangeIndex].first - request.startByte,
+                                         ranges[rangeIndex].second);
+        }
+      }
+    }
+    catch (IException &) {
+      qDeleteAll(replies);
+      throw;
+    }
+
+    qDeleteAll(replies);
+    return results;
+  }
+
+
+  /**
+   * Remote cubes are read-only.
+   *
+   * @param startByte The position to write the first byte to
+   * @param data The bytes to write
+   * @returns -1, the write always fails
+   */
+  BigInt CubeHttpDataSource::write(BigInt startByte, const QByteArray &data) {
+    return -1;
+  }
+
+
+  /**
+   * @returns The network access manager of the calling thread, which is
+   *   created on its first read and deleted when the thread finishes
+   */
+  QNetworkAccessManager *CubeHttpDataSource::manager() {
+    if (!m_managers.hasLocalData()) {
+      m_managers.setLocalData(new QNetworkAccessManager);
+    }
+    return m_managers.localData();
+  }
+
+
+  /**
+   * @param fileName A cube file name
+   * @returns True if the cube is on a web server instead of in a file
+   */
+  bool CubeHttpDataSource::isRemote(const QString &fileName) {
+    return fileName.startsWith("http://", Qt::CaseInsensitive) ||
+           fileName.startsWith("https://", Qt::CaseInsensitive);
+  }
+}
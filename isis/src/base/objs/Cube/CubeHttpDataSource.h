@@ -0,0 +1,81 @@
+/**
+ * @file
+ * $Revision: 1.1.1.1 $
+ * $Date: 2006/10/31 23:18:06 $
+ *
+ *   Unless noted otherwise, the portions of Isis written by the USGS are
+ *   public domain. See individual third-party library and package descriptions
+ *   for intellectual property information, user agreements, and related
+ *   information.
+ *
+ *   Although Isis has been used by the USGS, no warranty, expressed or
+ *   implied, is made by the USGS as to the accuracy and functioning of such
+ *   software and related material nor shall the fact of distribution
+ *   constitute any such warranty, and no responsibility is assumed by the
+ *   USGS in connection therewith.
+ *
+ *   For additional information, launch
+ *   $ISISROOT/doc//documents/Disclaimers/Disclaimers.html
+ *   in a browser or see the Privacy &amp; Disclaimers page on the Isis website,
+ *   http://isis.astrogeology.usgs.gov, and the USGS privacy and disclaimers on
+ *   http://www.usgs.gov/privacy.html.
+ */
+#ifndef CubeHttpDataSource_h
+#define CubeHttpDataSource_h
+
+#include "CubeDataSource.h"
+
+#include <QThreadStorage>
+#include <QUrl>
+
+class QNetworkAccessManager;
+
+namespace Isis {
+  /**
+   * @ingroup Low Level Cube IO
+   * @brief Read-only cube DN data on a web server or object store
+   *
+   * This reads cube data with HTTP range requests, so only the parts of the
+   *   cube that are used are transferred. Any server that supports range
+   *   requests works, including the HTTP interfaces of object stores.
+   *
+   * When several ranges are read at once, ranges that touch or overlap are
+   *   combined into one request of up to MaximumRequestBytes, and all of the
+   *   requests are in flight at the same time. Reading the tiles of a cube
+   *   line by line this way costs about one round trip per row of tiles
+   *   instead of one per tile.
+   *
+   * Each thread that reads keeps its own network access manager, so the
+   *   connections to the server are reused from one read to the next.
+   */
+  class CubeHttpDataSource : public CubeDataSource {
+    public:
+      CubeHttpDataSource(const QUrl &url);
+      virtual ~CubeHttpDataSource();
+
+      QUrl url() const;
+
+      virtual QString name() const;
+      virtual BigInt size() const;
+      virtual bool resize(BigInt newSize);
+      virtual QByteArray read(BigInt startByte, BigInt byteCount);
+      virtual QList<QByteArray> read(const QList< QPair<BigInt, BigInt> > &ranges);
+      virtual BigInt write(BigInt startByte, const QByteArray &data);
+
+      static bool isRemote(const QString &fileName);
+
+      //! The largest number of bytes combined into one request
+      static const BigInt MaximumRequestBytes = 16 * 1024 * 1024;
+
+    private:
+      QNetworkAccessManager *manager();
+
+      QUrl m_url;   //!< The location of the cube
+      BigInt m_size; //!< The size of the cube in bytes
+
+      //! The network access manager of each thread that has read the cube
+      QThreadStorage<QNetworkAccessManager *> m_managers;
+  };
+}
+
+#endif
@@ -30,6 +30,7 @@
 
 #include <QDebug>
 #include <QFile>
+#include <QHash>
 #include <QList>
 #include <QListIterator>
 #include <QMapIterator>
@@ -40,7 +41,9 @@
 
 #include "Area3D.h"
 #include "Brick.h"
+#include "CubeCacheBudget.h"
 #include "CubeCachingAlgorithm.h"
+#include "CubeFileDataSource.h"
 #include "Displacement.h"
 #include "Distance.h"
 #include "Endian.h"
@@ -77,7 +80,31 @@ namespace Isis {
    *          initialized into the file before this object is destructed.
    */
   CubeIoHandler::CubeIoHandler(QFile * dataFile,
+      const QList<int> *virtualBandList, const Pvl &label, bool alreadyOnDisk)
+    : CubeIoHandler(dataFile ? new CubeFileDataSource(dataFile) : NULL,
+                    virtualBandList, label, alreadyOnDisk) {
+  }
+
+
+  /**
+   * Creates a new CubeIoHandler that does its IO through a data source, like
+   *   a cube on a web server. The chunk sizes must be set by a child in its
+   *   constructor.
+   *
+   * @param dataSource Where the cube data is. This may not be NULL. The IO
+   *          handler takes ownership of it.
+   * @param virtualBandList A list where the indices are the vbands and the
+   *          values are the physical bands. The values are 1-based. This can
+   *          be specified as NULL, in which case the vbands are the physical
+   *          bands. The virtual band list is copied (the pointer provided isn't
+   *          remembered).
+   * @param label The label which contains the "Pixels" and "Core" groups.
+   * @param alreadyOnDisk True if the cube exists; false ensures all NULLs are
+   *          initialized into the data source before this object is destructed.
+   */
+  CubeIoHandler::CubeIoHandler(CubeDataSource * dataSource,
       const QList<int> *virtualBandList, const Pvl &label, bool alreadyOnDisk) {
+    m_dataSource = dataSource;
     m_byteSwapper = NULL;
     m_cachingAlgorithms = NULL;
     m_dataIsOnDiskMap = NULL;
@@ -88,9 +115,10 @@ namespace Isis {
     m_writeCache = NULL;
     m_ioThreadPool = NULL;
     m_writeThreadMutex = NULL;
+    m_chunkUseLinks = NULL;
 
     try {
-      if (!dataFile) {
+      if (!dataSource) {
         IString msg = "Cannot create a CubeIoHandler with a NULL data file";
         throw IException(IException::Programmer, msg, _FILEINFO_);
       }
@@ -116,9 +144,19 @@ namespace Isis {
 
       m_idealFlushSize = 32;
 
-      m_cachingAlgorithms->append(new RegionalCachingAlgorithm);
+      m_chunkUseLinks = new QHash<int, QPair<int, int> >;
+      m_leastRecentChunk = -1;
+      m_mostRecentChunk = -1;
+      m_requestCount = 0;
+      m_cacheHits = 0;
+      m_cacheMisses = 0;
+      m_bytesRead = 0;
+      m_accessPattern = UnknownAccess;
+      m_sequentialRequests = 0;
+      m_lastRequestBand = 0;
+      m_lastRequestLine = 0;
 
-      m_dataFile = dataFile;
+      m_cachingAlgorithms->append(new RegionalCachingAlgorithm);
 
       const PvlObject &core = label.findObject("IsisCube").findObject("Core");
       const PvlGroup &pixelGroup = core.findGroup("Pixels");
@@ -154,12 +192,16 @@ namespace Isis {
       }
 
       setVirtualBands(virtualBandList);
+
+      CubeCacheBudget::budget().addHandler();
     }
     catch(IException &e) {
+      delete m_dataSource;
       IString msg = "Constructing CubeIoHandler failed";
       throw IException(e, IException::Programmer, msg, _FILEINFO_);
     }
     catch(...) {
+      delete m_dataSource;
       IString msg = "Constructing CubeIoHandler failed";
       throw IException(IException::Programmer, msg, _FILEINFO_);
     }
@@ -179,6 +221,9 @@ namespace Isis {
     delete m_ioThreadPool;
     m_ioThreadPool = NULL;
 
+    delete m_dataSource;
+    m_dataSource = NULL;
+
     delete m_dataIsOnDiskMap;
     m_dataIsOnDiskMap = NULL;
 
@@ -198,8 +243,10 @@ namespace Isis {
         ASSERT(0);
         it.next();
 
-        if(it.value())
+        if(it.value()) {
           delete it.value();
+          CubeCacheBudget::budget().freed(getBytesPerChunk());
+        }
       }
       delete m_rawData;
       m_rawData = NULL;
@@ -232,6 +279,11 @@ namespace Isis {
 
     delete m_writeThreadMutex;
     m_writeThreadMutex = NULL;
+
+    delete m_chunkUseLinks;
+    m_chunkUseLinks = NULL;
+
+    CubeCacheBudget::budget().removeHandler();
   }
 
 
@@ -335,6 +387,8 @@ namespace Isis {
       writeIntoDouble(*cubeChunks[i], bufferToFill, chunkBands[i]);
     }
 
+    recordRequest(bufferToFill, cubeChunks);
+
     // Minimize the cache if it changed in size
     if (lastChunkCount != m_rawData->size()) {
       minimizeCache(cubeChunks, bufferToFill);
@@ -421,10 +475,14 @@ namespace Isis {
           }
 
           delete it.value();
+          CubeCacheBudget::budget().freed(getBytesPerChunk());
         }
       }
 
       m_rawData->clear();
+      m_chunkUseLinks->clear();
+      m_leastRecentChunk = -1;
+      m_mostRecentChunk = -1;
     }
 
     if(m_lastProcessByLineChunks) {
@@ -434,6 +492,44 @@ namespace Isis {
   }
 
 
+  /**
+   * Returns the cache counters of this cube: the chunk requests found in the
+   *   cache (Hits), the chunk requests that allocated a chunk (Misses), the
+   *   bytes read from disk into chunks, the bytes currently cached and the
+   *   detected access pattern.
+   *
+   * @return A CacheStatistics group
+   */
+  PvlGroup CubeIoHandler::cacheStatistics() const {
+    PvlGroup statistics("CacheStatistics");
+    statistics += PvlKeyword("Hits", toString(m_cacheHits));
+    statistics += PvlKeyword("Misses", toString(m_cacheMisses));
+    statistics += PvlKeyword("BytesRead", toString(m_bytesRead), "bytes");
+
+    BigInt cachedBytes = m_rawData->size() * getBytesPerChunk();
+    statistics += PvlKeyword("CachedBytes", toString(cachedBytes), "bytes");
+
+    QString pattern = "Unknown";
+    if (m_accessPattern == SequentialAccess) {
+      pattern = "Sequential";
+    }
+    else if (m_accessPattern == RandomAccess) {
+      pattern = "Random";
+    }
+    statistics += PvlKeyword("AccessPattern", pattern);
+
+    return statistics;
+  }
+
+
+  /**
+   * @return The detected pattern of the recent reads and writes
+   */
+  CubeIoHandler::AccessPattern CubeIoHandler::accessPattern() const {
+    return m_accessPattern;
+  }
+
+
   /**
    * @return the number of bytes that the cube DNs will take up. This includes
    *   padding caused by the cube chunks not aligning with the cube dimensions.
@@ -476,6 +572,17 @@ namespace Isis {
     return m_writeThreadMutex;
   }
 
+
+  /**
+   * Get the data source that this IO handler reads the cube data from and
+   *   writes it to. Lock the dataFileMutex() before using it.
+   *
+   * @return The cube's data source
+   */
+  CubeDataSource *CubeIoHandler::dataSource() {
+    return m_dataSource;
+  }
+
   /**
    * @return the number of physical bands in the cube.
    */
@@ -573,10 +680,11 @@ namespace Isis {
    * @return the QFile containing cube data. This is what should be read from and
    *   written to.
    *
-   * @return The data file for I/O
+   * @return The data file for I/O, NULL if the cube data is not in a local file
    */
   QFile * CubeIoHandler::getDataFile() {
-    return m_dataFile;
+    CubeFileDataSource *fileSource = dynamic_cast<CubeFileDataSource *>(m_dataSource);
+    return fileSource ? fileSource->file() : NULL;
   }
 
 
@@ -633,9 +741,12 @@ namespace Isis {
    * @param numSamples The chunk size in the sample dimension
    * @param numLines The chunk size in the line dimension
    * @param numBands The chunk size in the band dimension
+   * @param sizeData False if the child stores a varying amount of data per
+   *          chunk and sizes the file itself. The file is then neither grown
+   *          to hold every chunk nor checked to be big enough for them.
    */
   void CubeIoHandler::setChunkSizes(
-      int numSamples, int numLines, int numBands) {
+      int numSamples, int numLines, int numBands, bool sizeData) {
     bool success = false;
     IString msg;
 
@@ -663,12 +774,15 @@ namespace Isis {
       m_linesInChunk = numLines;
       m_bandsInChunk = numBands;
 
-      if(m_dataIsOnDiskMap) {
-        m_dataFile->resize(getDataStartByte() + getDataSize());
+      if(!sizeData) {
+        // The child sizes the file
+      }
+      else if(m_dataIsOnDiskMap) {
+        m_dataSource->resize(getDataStartByte() + getDataSize());
       }
-      else if(m_dataFile->size() < getDataStartByte() + getDataSize()) {
+      else if(m_dataSource->size() < getDataStartByte() + getDataSize()) {
         success = false;
-        msg = "File size [" + IString((BigInt)m_dataFile->size()) +
+        msg = "File size [" + IString(m_dataSource->size()) +
             " bytes] not big enough to hold data [" +
             IString(getDataStartByte() + getDataSize()) + " bytes] where the "
             "offset to the cube data is [" + IString(getDataStartByte()) +
@@ -681,6 +795,37 @@ namespace Isis {
   }
 
 
+  /**
+   * Chunks that have never been written contain exactly these raw bytes, so
+   *   handlers can compare chunks against them to avoid storing NULL chunks.
+   *
+   * @return The raw bytes of a chunk filled with NULLs
+   */
+  const QByteArray &CubeIoHandler::nullChunkData() const {
+    if (!m_nullChunkData) {
+      // This builds m_nullChunkData as a side effect
+      delete getNullChunk(0);
+    }
+
+    return *m_nullChunkData;
+  }
+
+
+  /**
+   * Populate a group of chunks with unswapped raw bytes from the disk. The
+   *   chunks are the ones needed by a single read or write, so handlers that
+   *   do extra work per chunk can do it for all of them at once. The default
+   *   calls readRaw() on each chunk in turn.
+   *
+   * @param chunksToFill The containers that need to be filled with cube data.
+   */
+  void CubeIoHandler::readRawChunks(QList<RawCubeChunk *> &chunksToFill) {
+    foreach (RawCubeChunk *chunk, chunksToFill) {
+      readRaw(*chunk);
+    }
+  }
+
+
   /**
    * This blocks (doesn't return) until the number of active runnables in the
    *   thread pool goes to 0. This uses the m_writeThreadMutex, because the
@@ -694,6 +839,64 @@ namespace Isis {
   }
 
 
+  /**
+   * Make sure all of the given chunks are in the cache. The chunks that are not
+   *   cached yet and are on disk are read with a single call to
+   *   readRawChunks().
+   *
+   * @param chunkIndices The indices of the chunks that are needed
+   */
+  void CubeIoHandler::cacheChunks(const QList<int> &chunkIndices) const {
+    QList<RawCubeChunk *> chunksToRead;
+    QList<int> indicesToRead;
+
+    foreach (int chunkIndex, chunkIndices) {
+      if (m_rawData->value(chunkIndex) || indicesToRead.contains(chunkIndex)) {
+        m_cacheHits++;
+      }
+      else if (m_dataIsOnDiskMap && !(*m_dataIsOnDiskMap)[chunkIndex]) {
+        // getChunk() makes the NULL chunks that have never been written
+        getChunk(chunkIndex, true);
+      }
+      else {
+        int startSample;
+        int startLine;
+        int startBand;
+        int endSample;
+        int endLine;
+        int endBand;
+        getChunkPlacement(chunkIndex, startSample, startLine, startBand,
+                          endSample, endLine, endBand);
+        chunksToRead.append(new RawCubeChunk(startSample, startLine, startBand,
+                                             endSample, endLine, endBand,
+                                             getBytesPerChunk()));
+        indicesToRead.append(chunkIndex);
+      }
+    }
+
+    if (chunksToRead.isEmpty()) {
+      return;
+    }
+
+    try {
+      (const_cast<CubeIoHandler *>(this))->readRawChunks(chunksToRead);
+    }
+    catch (IException &) {
+      qDeleteAll(chunksToRead);
+      throw;
+    }
+
+    for (int i = 0; i < chunksToRead.size(); i++) {
+      chunksToRead[i]->setDirty(false);
+      (*m_rawData)[indicesToRead[i]] = chunksToRead[i];
+      touchChunk(indicesToRead[i]);
+      m_cacheMisses++;
+      m_bytesRead += getBytesPerChunk();
+      CubeCacheBudget::budget().allocated(getBytesPerChunk());
+    }
+  }
+
+
   /**
    * This is used for sorting buffers into the most efficient write order.
    *
@@ -755,6 +958,7 @@ namespace Isis {
       int numBands) const {
     QList<RawCubeChunk *> results;
     QList<int> resultBands;
+    QList<int> chunkIndices;
 /************************************************************************CHANGED THIS!!!!!!!!******/
     int lastBand = startBand + numBands - 1;
 //     int lastBand = min(startBand + numBands - 1,
@@ -862,9 +1066,7 @@ namespace Isis {
               (chunkZPos * getChunkCountInSampleDimension() *
                           getChunkCountInLineDimension());
 
-          RawCubeChunk * newChunk = getChunk(chunkIndex, true);
-
-          results.append(newChunk);
+          chunkIndices.append(chunkIndex);
           resultBands.append(band);
 
           chunkRect.moveLeft(chunkRect.right() + 1);
@@ -874,6 +1076,11 @@ namespace Isis {
       }
     }
 
+    cacheChunks(chunkIndices);
+    foreach (int chunkIndex, chunkIndices) {
+      results.append(getChunk(chunkIndex, false));
+    }
+
     return QPair< QList<RawCubeChunk *>, QList<int> >(results, resultBands);
   }
 
@@ -1042,11 +1249,13 @@ namespace Isis {
       int chunkIndex = getChunkIndex(*chunkToFree);
 
       m_rawData->erase(m_rawData->find(chunkIndex));
+      forgetChunkUse(chunkIndex);
 
       if(chunkToFree->isDirty())
         (const_cast<CubeIoHandler *>(this))->writeRaw(*chunkToFree);
 
       delete chunkToFree;
+      CubeCacheBudget::budget().freed(getBytesPerChunk());
 
       if(m_lastProcessByLineChunks) {
         delete m_lastProcessByLineChunks;
@@ -1073,7 +1282,13 @@ namespace Isis {
       chunk = m_rawData->value(chunkIndex);
     }
 
+    if(allocateIfNecessary && chunk) {
+      m_cacheHits++;
+    }
+
     if(allocateIfNecessary && !chunk) {
+      m_cacheMisses++;
+
       if(m_dataIsOnDiskMap && !(*m_dataIsOnDiskMap)[chunkIndex]) {
         chunk = getNullChunk(chunkIndex);
         (*m_dataIsOnDiskMap)[chunkIndex] = true;
@@ -1093,9 +1308,12 @@ namespace Isis {
 
         (const_cast<CubeIoHandler *>(this))->readRaw(*chunk);
         chunk->setDirty(false);
+        m_bytesRead += getBytesPerChunk();
       }
 
       (*m_rawData)[chunkIndex] = chunk;
+      touchChunk(chunkIndex);
+      CubeCacheBudget::budget().allocated(getBytesPerChunk());
     }
 
     return chunk;
@@ -1247,6 +1465,160 @@ namespace Isis {
         clearCache(false);
       }
     }
+
+    enforceCacheBudget(justUsed, justRequested);
+  }
+
+
+  /**
+   * Free chunks until this handler is within its allowance of the process-wide
+   *   CubeCacheBudget. The chunks a sequential scan has passed will not be
+   *   used again and clean chunks cost no write, so they go first. Dirty
+   *   chunks the scan has not passed go last. Each group is freed from the
+   *   least recently used chunk on. The chunks of the current IO are never
+   *   freed.
+   *
+   * @param justUsed The cube chunks that were used in the IO operation that
+   *     is calling this method.
+   * @param justRequested The buffer that was used in the IO operation that
+   *     is calling this method.
+   */
+  void CubeIoHandler::enforceCacheBudget(const QList<RawCubeChunk *> &justUsed,
+                                         const Buffer &justRequested) const {
+    BigInt bytesPerChunk = getBytesPerChunk();
+    BigInt cachedBytes = m_rawData->size() * bytesPerChunk;
+    BigInt allowance = CubeCacheBudget::budget().allowance(cachedBytes);
+    if (cachedBytes <= allowance) {
+      return;
+    }
+
+    int requestBand = justRequested.Band();
+    if (m_virtualBands && requestBand >= 1 && requestBand <= m_virtualBands->size()) {
+      requestBand = m_virtualBands->at(requestBand - 1);
+    }
+
+    for (int pass = 0; pass < 2 && cachedBytes > allowance; pass++) {
+      int chunkIndex = m_leastRecentChunk;
+      while (chunkIndex != -1 && cachedBytes > allowance) {
+        int nextChunkIndex = m_chunkUseLinks->value(chunkIndex).second;
+        RawCubeChunk *chunk = m_rawData->value(chunkIndex);
+
+        if (chunk && !justUsed.contains(chunk)) {
+          bool passed = false;
+          if (m_accessPattern == SequentialAccess) {
+            int chunkEndBand = chunk->getStartBand() + chunk->bandCount() - 1;
+            int chunkEndLine = chunk->getStartLine() + chunk->lineCount() - 1;
+            passed = chunkEndBand < requestBand ||
+                     (chunk->getStartBand() <= requestBand &&
+                      chunkEndLine < justRequested.Line());
+          }
+
+          if (pass == 1 || passed || !chunk->isDirty()) {
+            freeChunk(chunk);
+            cachedBytes -= bytesPerChunk;
+          }
+        }
+
+        chunkIndex = nextChunkIndex;
+      }
+    }
+  }
+
+
+  /**
+   * Move a cached chunk to the most recently used end of the order of use.
+   *
+   * @param chunkIndex The index of the chunk that was used
+   */
+  void CubeIoHandler::touchChunk(int chunkIndex) const {
+    if (chunkIndex == m_mostRecentChunk) {
+      return;
+    }
+
+    forgetChunkUse(chunkIndex);
+
+    m_chunkUseLinks->insert(chunkIndex, qMakePair(m_mostRecentChunk, -1));
+    if (m_mostRecentChunk != -1) {
+      (*m_chunkUseLinks)[m_mostRecentChunk].second = chunkIndex;
+    }
+    else {
+      m_leastRecentChunk = chunkIndex;
+    }
+    m_mostRecentChunk = chunkIndex;
+  }
+
+
+  /**
+   * Take a chunk out of the order of use, if it is in it.
+   *
+   * @param chunkIndex The index of the chunk
+   */
+  void CubeIoHandler::forgetChunkUse(int chunkIndex) const {
+    QHash<int, QPair<int, int> >::iterator links = m_chunkUseLinks->find(chunkIndex);
+    if (links == m_chunkUseLinks->end()) {
+      return;
+    }
+
+    int previous = links.value().first;
+    int next = links.value().second;
+    m_chunkUseLinks->erase(links);
+
+    if (previous != -1) {
+      (*m_chunkUseLinks)[previous].second = next;
+    }
+    else {
+      m_leastRecentChunk = next;
+    }
+
+    if (next != -1) {
+      (*m_chunkUseLinks)[next].first = previous;
+    }
+    else {
+      m_mostRecentChunk = previous;
+    }
+  }
+
+
+  /**
+   * Update the access pattern, the last use of the chunks and the request
+   *   count with a read or write. A request that starts at or after the line
+   *   of the last request in the same band, or in a later band, continues a
+   *   sequential scan. Eight in a row make the pattern sequential and any
+   *   other request makes it random.
+   *
+   * @param request The buffer that was read or written
+   * @param chunksUsed The cube chunks of the request
+   */
+  void CubeIoHandler::recordRequest(const Buffer &request,
+                                    const QList<RawCubeChunk *> &chunksUsed) const {
+    m_requestCount++;
+
+    for (int i = 0; i < chunksUsed.size(); i++) {
+      touchChunk(getChunkIndex(*chunksUsed[i]));
+    }
+
+    int band = request.Band();
+    if (m_virtualBands && band >= 1 && band <= m_virtualBands->size()) {
+      band = m_virtualBands->at(band - 1);
+    }
+
+    if (m_requestCount > 1) {
+      if (band > m_lastRequestBand ||
+          (band == m_lastRequestBand && request.Line() >= m_lastRequestLine)) {
+        m_sequentialRequests++;
+
+        if (m_sequentialRequests >= 8) {
+          m_accessPattern = SequentialAccess;
+        }
+      }
+      else {
+        m_sequentialRequests = 0;
+        m_accessPattern = RandomAccess;
+      }
+    }
+
+    m_lastRequestBand = band;
+    m_lastRequestLine = request.Line();
   }
 
 
@@ -1295,6 +1667,7 @@ namespace Isis {
           for (int i = 0; i < cubeChunks.size(); i++) {
             cubeChunkBands.append( cubeChunks[i]->getStartBand() );
           }
+          m_cacheHits += cubeChunks.size();
         }
       }
     }
@@ -1362,6 +1735,7 @@ namespace Isis {
       writeIntoRaw(bufferToWrite, *cubeChunks[i], cubeChunkBands[i]);
     }
 
+    recordRequest(bufferToWrite, cubeChunks);
     minimizeCache(cubeChunks, bufferToWrite);
   }
 
@@ -1968,6 +2342,6 @@ namespace Isis {
     }
 
     m_buffersToWrite->clear();
-    m_ioHandler->m_dataFile->flush();
+    m_ioHandler->m_dataSource->flush();
   }
 }
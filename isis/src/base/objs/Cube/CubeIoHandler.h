@@ -31,9 +31,11 @@
 #include "Endian.h"
 #include "PixelType.h"
 
+class QByteArray;
 class QFile;
 class QMutex;
 class QTime;
+template <typename A, typename B> class QHash;
 template <typename A> class QList;
 template <typename A, typename B> class QMap;
 template <typename A, typename B> struct QPair;
@@ -41,8 +43,10 @@ template <typename A, typename B> struct QPair;
 namespace Isis {
   class Buffer;
   class CubeCachingAlgorithm;
+  class CubeDataSource;
   class EndianSwapper;
   class Pvl;
+  class PvlGroup;
   class RawCubeChunk;
 
   /**
@@ -59,6 +63,13 @@ namespace Isis {
    *   guarantees that unwritten cube data ends up read and written as NULLs.
    *   The default caching algorithm is a RegionalCachingAlgorithm.
    *
+   * Whatever the caching algorithms recommend, the chunks of all of the
+   *   handlers in the process are kept within the CubeCacheBudget. A handler
+   *   over its allowance evicts chunks a sequential scan has already passed
+   *   and clean chunks first, then dirty chunks that must be written, least
+   *   recently used first. Each handler counts its cache hits, misses
+   *   and bytes read; see cacheStatistics().
+   *
    * @author 2011-??-?? Jai Rideout and Steven Lambright
    *
    * @internal
@@ -124,8 +135,19 @@ namespace Isis {
    */
   class CubeIoHandler {
     public:
+      /**
+       * The pattern of the recent requests to a cube
+       */
+      enum AccessPattern {
+        UnknownAccess,    //!< Too few requests to tell
+        SequentialAccess, //!< Requests move forward through lines and bands
+        RandomAccess      //!< Requests jump around the cube
+      };
+
       CubeIoHandler(QFile * dataFile, const QList<int> *virtualBandList,
           const Pvl &label, bool alreadyOnDisk);
+      CubeIoHandler(CubeDataSource * dataSource, const QList<int> *virtualBandList,
+          const Pvl &label, bool alreadyOnDisk);
       virtual ~CubeIoHandler();
 
       void read(Buffer &bufferToFill) const;
@@ -133,7 +155,9 @@ namespace Isis {
 
       void addCachingAlgorithm(CubeCachingAlgorithm *algorithm);
       void clearCache(bool blockForWriteCache = true) const;
-      BigInt getDataSize() const;
+      virtual BigInt getDataSize() const;
+      PvlGroup cacheStatistics() const;
+      AccessPattern accessPattern() const;
       void setVirtualBands(const QList<int> *virtualBandList);
       /**
        * Function to update the labels with a Pvl object
@@ -143,6 +167,7 @@ namespace Isis {
       virtual void updateLabels(Pvl &labels) = 0;
 
       QMutex *dataFileMutex();
+      CubeDataSource *dataSource();
 
     protected:
       int bandCount() const;
@@ -160,7 +185,10 @@ namespace Isis {
       int sampleCount() const;
       int getSampleCountInChunk() const;
 
-      void setChunkSizes(int numSamples, int numLines, int numBands);
+      void setChunkSizes(int numSamples, int numLines, int numBands,
+                         bool sizeData = true);
+
+      const QByteArray &nullChunkData() const;
 
       /**
        * This needs to populate the chunkToFill with unswapped raw bytes from
@@ -172,6 +200,8 @@ namespace Isis {
        */
       virtual void readRaw(RawCubeChunk &chunkToFill) = 0;
 
+      virtual void readRawChunks(QList<RawCubeChunk *> &chunksToFill);
+
       /**
        * This needs to write the chunkToWrite directly to disk with no
        *   modifications to the data itself.
@@ -247,6 +277,8 @@ namespace Isis {
 
       void blockUntilThreadPoolEmpty() const;
 
+      void cacheChunks(const QList<int> &chunkIndices) const;
+
       static bool bufferLessThan(Buffer * const &lhs, Buffer * const &rhs);
 
       QPair< QList<RawCubeChunk *>, QList<int> > findCubeChunks(int startSample, int numSamples,
@@ -259,6 +291,8 @@ namespace Isis {
 
       void flushWriteCache(bool force = false) const;
 
+      void forgetChunkUse(int chunkIndex) const;
+
       void freeChunk(RawCubeChunk *chunkToFree) const;
 
       RawCubeChunk *getChunk(int chunkIndex, bool allocateIfNecessary) const;
@@ -274,8 +308,16 @@ namespace Isis {
       void minimizeCache(const QList<RawCubeChunk *> &justUsed,
                          const Buffer &justRequested) const;
 
+      void enforceCacheBudget(const QList<RawCubeChunk *> &justUsed,
+                              const Buffer &justRequested) const;
+
+      void recordRequest(const Buffer &request,
+                         const QList<RawCubeChunk *> &chunksUsed) const;
+
       void synchronousWrite(const Buffer &bufferToWrite);
 
+      void touchChunk(int chunkIndex) const;
+
       void writeIntoDouble(const RawCubeChunk &chunk, Buffer &output, int startIndex) const;
 
       void writeIntoRaw(const Buffer &buffer, RawCubeChunk &output, int index) const;
@@ -283,8 +325,8 @@ namespace Isis {
       void writeNullDataToDisk() const;
 
     private:
-      //! The file containing cube data.
-      QFile * m_dataFile;
+      //! Where the cube data is read from and written to. We own this.
+      CubeDataSource * m_dataSource;
 
       /**
        * The start byte of the cube data. This is 0-based (i.e. a value of 0
@@ -376,6 +418,42 @@ namespace Isis {
 
       //! How many times the write cache has overflown in a row
       mutable int m_consecutiveOverflowCount;
+
+      /**
+       * The cached chunks from the least to the most recently used, as the
+       *   previous and next chunk index of each chunk index. -1 ends the list.
+       */
+      mutable QHash<int, QPair<int, int> > * m_chunkUseLinks;
+
+      //! The index of the least recently used cached chunk, or -1
+      mutable int m_leastRecentChunk;
+
+      //! The index of the most recently used cached chunk, or -1
+      mutable int m_mostRecentChunk;
+
+      //! The number of reads and writes requested
+      mutable BigInt m_requestCount;
+
+      //! The number of chunk requests found in the cache
+      mutable BigInt m_cacheHits;
+
+      //! The number of chunk requests that had to allocate the chunk
+      mutable BigInt m_cacheMisses;
+
+      //! The number of bytes read from disk into chunks
+      mutable BigInt m_bytesRead;
+
+      //! The detected pattern of the recent requests
+      mutable AccessPattern m_accessPattern;
+
+      //! The number of requests in a row that moved forward through the cube
+      mutable int m_sequentialRequests;
+
+      //! The physical band of the last request
+      mutable int m_lastRequestBand;
+
+      //! The starting line of the last request
+      mutable int m_lastRequestLine;
   };
 }
 
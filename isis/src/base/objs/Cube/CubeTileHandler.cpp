@@ -23,8 +23,10 @@
 
 #include "CubeTileHandler.h"
 
-#include <QFile>
+#include <QPair>
 
+#include "CubeDataSource.h"
+#include "CubeFileDataSource.h"
 #include "IException.h"
 #include "Pvl.h"
 #include "PvlObject.h"
@@ -47,12 +49,51 @@ namespace Isis {
    */
   CubeTileHandler::CubeTileHandler(QFile * dataFile,
       const QList<int> *virtualBandList, const Pvl &labels, bool alreadyOnDisk)
-      : CubeIoHandler(dataFile, virtualBandList, labels, alreadyOnDisk) {
+      : CubeTileHandler(dataFile ? new CubeFileDataSource(dataFile) : NULL,
+                        virtualBandList, labels, alreadyOnDisk) {
+  }
+
+
+  /**
+   * Construct a tile handler that does its IO through a data source.
+   *
+   * @param dataSource Where the cube DN data is. The handler takes ownership
+   *          of it.
+   * @param virtualBandList The mapping from virtual band to physical band, see
+   *          CubeIoHandler's description.
+   * @param labels The Pvl labels for the cube
+   * @param alreadyOnDisk True if the cube is allocated on the disk, false
+   *          otherwise
+   */
+  CubeTileHandler::CubeTileHandler(CubeDataSource * dataSource,
+      const QList<int> *virtualBandList, const Pvl &labels, bool alreadyOnDisk)
+      : CubeTileHandler(dataSource, virtualBandList, labels, alreadyOnDisk, true) {
+  }
+
+
+  /**
+   * Construct a tile handler for a child that stores its tiles in a varying
+   *   amount of space, such as compressed tiles.
+   *
+   * @param dataSource Where the cube DN data is. The handler takes ownership
+   *          of it.
+   * @param virtualBandList The mapping from virtual band to physical band, see
+   *          CubeIoHandler's description.
+   * @param labels The Pvl labels for the cube
+   * @param alreadyOnDisk True if the cube is allocated on the disk, false
+   *          otherwise
+   * @param sizeData False if the child sizes the file itself instead of
+   *          allocating space for every uncompressed tile
+   */
+  CubeTileHandler::CubeTileHandler(CubeDataSource * dataSource,
+      const QList<int> *virtualBandList, const Pvl &labels, bool alreadyOnDisk,
+      bool sizeData)
+      : CubeIoHandler(dataSource, virtualBandList, labels, alreadyOnDisk) {
 
     const PvlObject &core = labels.findObject("IsisCube").findObject("Core");
 
     if(core.hasKeyword("Format")) {
-      setChunkSizes(core["TileSamples"], core["TileLines"], 1);
+      setChunkSizes(core["TileSamples"], core["TileLines"], 1, sizeData);
     }
     else {
       // up to 1MB chunks
@@ -61,7 +102,7 @@ namespace Isis {
       int lineChunkSize =
           findGoodSize(512 * 4 / SizeOf(pixelType()), lineCount());
 
-      setChunkSizes(sampleChunkSize, lineChunkSize, 1);
+      setChunkSizes(sampleChunkSize, lineChunkSize, 1, sizeData);
     }
   }
 
@@ -91,26 +132,36 @@ namespace Isis {
 
 
   void CubeTileHandler::readRaw(RawCubeChunk &chunkToFill) {
-    BigInt startByte = getTileStartByte(chunkToFill);
+    QList<RawCubeChunk *> chunksToFill;
+    chunksToFill.append(&chunkToFill);
+    readRawChunks(chunksToFill);
+  }
 
-    bool success = false;
 
-    QFile * dataFile = getDataFile();
-    if(dataFile->seek(startByte)) {
-      QByteArray binaryData = dataFile->read(chunkToFill.getByteCount());
+  /**
+   * Read several tiles from the data source with a single request to it, so
+   *   sources like web servers can combine and overlap the reads.
+   *
+   * @param chunksToFill The tiles to read; their positions are already set
+   */
+  void CubeTileHandler::readRawChunks(QList<RawCubeChunk *> &chunksToFill) {
+    QList< QPair<BigInt, BigInt> > ranges;
+    foreach (RawCubeChunk *chunk, chunksToFill) {
+      ranges.append(qMakePair(getTileStartByte(*chunk), (BigInt)chunk->getByteCount()));
+    }
 
-      if(binaryData.size() == chunkToFill.getByteCount()) {
-        chunkToFill.setRawData(binaryData);
-        success = true;
+    QList<QByteArray> binaryData = dataSource()->read(ranges);
+
+    for (int i = 0; i < chunksToFill.size(); i++) {
+      if(binaryData[i].size() != chunksToFill[i]->getByteCount()) {
+        IString msg = "Reading from the file [" + dataSource()->name() + "] "
+            "failed with reading [" +
+            QString::number(chunksToFill[i]->getByteCount()) +
+            "] bytes at position [" + QString::number(ranges[i].first) + "]";
+        throw IException(IException::Io, msg, _FILEINFO_);
       }
-    }
 
-    if(!success) {
-      IString msg = "Reading from the file [" + dataFile->fileName() + "] "
-          "failed with reading [" +
-          QString::number(chunkToFill.getByteCount()) +
-          "] bytes at position [" + QString::number(startByte) + "]";
-      throw IException(IException::Io, msg, _FILEINFO_);
+      chunksToFill[i]->setRawData(binaryData[i]);
     }
   }
 
@@ -119,17 +170,14 @@ namespace Isis {
     BigInt startByte = getTileStartByte(chunkToWrite);
     bool success = false;
 
-    QFile * dataFile = getDataFile();
-    if(dataFile->seek(startByte)) {
-      BigInt dataWritten = dataFile->write(chunkToWrite.getRawData());
+    BigInt dataWritten = dataSource()->write(startByte, chunkToWrite.getRawData());
 
-      if(dataWritten == chunkToWrite.getByteCount()) {
-        success = true;
-      }
+    if(dataWritten == chunkToWrite.getByteCount()) {
+      success = true;
     }
 
     if(!success) {
-      IString msg = "Writing to the file [" + dataFile->fileName() + "] "
+      IString msg = "Writing to the file [" + dataSource()->name() + "] "
           "failed with writing [" +
           QString::number(chunkToWrite.getByteCount()) +
           "] bytes at position [" + QString::number(startByte) + "]";
@@ -53,12 +53,18 @@ namespace Isis {
     public:
       CubeTileHandler(QFile * dataFile, const QList<int> *virtualBandList,
           const Pvl &label, bool alreadyOnDisk);
+      CubeTileHandler(CubeDataSource * dataSource, const QList<int> *virtualBandList,
+          const Pvl &label, bool alreadyOnDisk);
       ~CubeTileHandler();
 
       void updateLabels(Pvl &label);
 
     protected:
+      CubeTileHandler(CubeDataSource * dataSource, const QList<int> *virtualBandList,
+          const Pvl &label, bool alreadyOnDisk, bool sizeData);
+
       virtual void readRaw(RawCubeChunk &chunkToFill);
+      virtual void readRawChunks(QList<RawCubeChunk *> &chunksToFill);
       virtual void writeRaw(const RawCubeChunk &chunkToWrite);
 
     private:
@@ -290,6 +290,8 @@ namespace Isis {
 
       if (formatString == "BSQ" || formatString == "BANDSEQUENTIAL")
         result = Cube::Bsq;
+      else if (formatString == "COMPRESSEDTILE")
+        result = Cube::CompressedTile;
     }
 
     return result;
@@ -302,8 +304,7 @@ namespace Isis {
 
 
   void CubeAttributeOutput::setFileFormat(Cube::Format fmt) {
-    setAttribute((fmt == Cube::Tile)? "Tile" : "BandSequential",
-                 &CubeAttributeOutput::isFileFormat);
+    setAttribute(toString(fmt), &CubeAttributeOutput::isFileFormat);
   }
 
 
@@ -436,7 +437,7 @@ namespace Isis {
 
 
   bool CubeAttributeOutput::isFileFormat(QString attribute) const {
-    return QRegExp("(BANDSEQUENTIAL|BSQ|TILE)").exactMatch(attribute);
+    return QRegExp("(BANDSEQUENTIAL|BSQ|TILE|COMPRESSEDTILE)").exactMatch(attribute);
   }
 
 
@@ -463,6 +464,8 @@ namespace Isis {
 
     if (format == Cube::Bsq)
       result = "BandSequential";
+    else if (format == Cube::CompressedTile)
+      result = "CompressedTile";
 
     return result;
   }
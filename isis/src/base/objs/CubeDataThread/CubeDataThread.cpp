@@ -3,6 +3,7 @@
 
 #include <QApplication>
 #include <QEventLoop>
+#include <QList>
 #include <QMap>
 #include <QMutex>
 #include <QPair>
@@ -31,11 +32,13 @@ namespace Isis {
     p_managedData = NULL;
     p_threadSafeMutex = NULL;
     p_managedDataSources = NULL;
+    p_overviewData = NULL;
 
     p_managedCubes = new QMap< int, QPair< bool, Cube * > > ;
     p_managedData = new QList< QPair< QReadWriteLock *, Brick * > > ;
     p_threadSafeMutex = new QMutex();
     p_managedDataSources = new QList< int > ;
+    p_overviewData = new QList< Brick * > ;
 
     p_numChangeListeners = 0;
     p_currentLocksWaiting = 0;
@@ -99,6 +102,13 @@ namespace Isis {
       delete p_managedDataSources;
       p_managedDataSources = NULL;
     }
+
+    // Destroy the overview bricks nobody has released
+    if (p_overviewData) {
+      qDeleteAll(*p_overviewData);
+      delete p_overviewData;
+      p_overviewData = NULL;
+    }
   }
 
   /**
@@ -467,6 +477,92 @@ namespace Isis {
                 caller, false);
   }
 
+
+  /**
+   * This slot behaves like ReadCube, but fills the requested area from one of
+   * the cube's reduced-resolution overviews instead of the full resolution
+   * data. The brick given by ReadReady covers the requested full resolution
+   * area, with each overview pixel repeated over the level x level block of
+   * pixels it was averaged from. This is much less I/O than reading the area
+   * when it is going to be shown at a reduced scale anyway. Overview bricks
+   * are read-only; release them with DoneWithData like any other brick. If
+   * the overview is no longer current because the cube was written to, the
+   * area is read from the cube itself, as ReadCube does.
+   *
+   * @param cubeId Cube to read from
+   * @param level Overview level to read, as given by Cube::overviewLevels()
+   * @param startSample Starting Sample Position
+   * @param startLine Starting Line Position
+   * @param endSample Ending Sample Position
+   * @param endLine Ending Line Position
+   * @param band Band Number To Read From
+   * @param caller A pointer to the calling class, used to identify who requested
+   *               the data when they receive the ReadReady signal
+   */
+  void CubeDataThread::ReadCubeOverview(int cubeId, int level, int startSample,
+                                        int startLine, int endSample, int endLine,
+                                        int band, void *caller) {
+    if(!p_managedCubes->contains(cubeId)) {
+      IString msg = "cube ID [";
+      msg += IString(cubeId);
+      msg += "] is not a valid cube ID";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    int overviewStartSample = (startSample - 1) / level + 1;
+    int overviewStartLine = (startLine - 1) / level + 1;
+    int overviewEndSample = (endSample - 1) / level + 1;
+    int overviewEndLine = (endLine - 1) / level + 1;
+
+    p_threadSafeMutex->lock();
+    Cube *cube = p_managedCubes->value(cubeId).second;
+    p_threadSafeMutex->unlock();
+
+    // Overviews are dropped when the cube's DNs are written to
+    if (!cube->overviewLevels().contains(level)) {
+      GetCubeData(cubeId, startSample, startLine, endSample, endLine, band,
+                  caller, true);
+      return;
+    }
+
+    Brick *requestedBrick = new Brick(*cube, endSample - startSample + 1,
+                                      endLine - startLine + 1, 1);
+    requestedBrick->SetBasePosition(startSample, startLine, band);
+
+    Brick overviewBrick(overviewEndSample - overviewStartSample + 1,
+                        overviewEndLine - overviewStartLine + 1, 1,
+                        cube->pixelType());
+    overviewBrick.SetBasePosition(overviewStartSample, overviewStartLine, band);
+
+    // The cube serializes its own reads, so other bricks can be handed out
+    // while the overview rows are read
+    try {
+      cube->read(overviewBrick, level);
+    }
+    catch (IException &) {
+      delete requestedBrick;
+      throw;
+    }
+
+    p_threadSafeMutex->lock();
+    p_overviewData->append(requestedBrick);
+    p_threadSafeMutex->unlock();
+
+    int samples = requestedBrick->SampleDimension();
+    int overviewSamples = overviewBrick.SampleDimension();
+    for (int line = 0; line < requestedBrick->LineDimension(); line++) {
+      int overviewLine = (startLine + line - 1) / level + 1 - overviewStartLine;
+      for (int sample = 0; sample < samples; sample++) {
+        int overviewSample = (startSample + sample - 1) / level + 1 -
+                             overviewStartSample;
+        (*requestedBrick)[line * samples + sample] =
+            overviewBrick[overviewLine * overviewSamples + overviewSample];
+      }
+    }
+
+    emit ReadReady(caller, cubeId, requestedBrick);
+  }
+
   /**
    * This is a searching method used to identify overlapping data already in
    * memory.
@@ -580,6 +676,14 @@ namespace Isis {
    */
   void CubeDataThread::DoneWithData(int cubeId, const Isis::Brick *brickDone) {
     ASSERT(brickDone != NULL);
+
+    // Overview bricks are never shared, so only the pointer itself can match
+    int overviewIndex = p_overviewData->indexOf(const_cast<Brick *>(brickDone));
+    if (overviewIndex != -1) {
+      delete p_overviewData->takeAt(overviewIndex);
+      return;
+    }
+
     int instance = 0;
     bool exactMatch = false;
     bool writeLock = false;
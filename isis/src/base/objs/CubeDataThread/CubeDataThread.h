@@ -78,6 +78,9 @@ namespace Isis {
                     int endSample, int endLine, int band, void *caller);
       void ReadWriteCube(int cubeId, int startSample, int startLine,
                          int endSample, int endLine, int band, void *caller);
+      void ReadCubeOverview(int cubeId, int level, int startSample,
+                            int startLine, int endSample, int endLine,
+                            int band, void *caller);
 
       void DoneWithData(int, const Isis::Brick *);
 
@@ -195,6 +198,13 @@ namespace Isis {
       //! This is the associated cube ID with each brick
       QList< int > * p_managedDataSources;
 
+      /**
+       * Bricks filled from reduced-resolution overviews. These are never
+       * shared or locked, so they are kept apart from p_managedData where an
+       * exact match would be mistaken for full resolution data.
+       */
+      QList< Brick * > * p_overviewData;
+
       //! This is the number of shaded locks to put on a brick when changes made
       int p_numChangeListeners;
 
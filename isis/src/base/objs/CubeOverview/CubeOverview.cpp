@@ -0,0 +1,367 @@
+/**
+ * @file
+ *
+ *   Unless noted otherwise, the portions of Isis written by the USGS are public
+ *   domain. See individual third-party library and package descriptions for
+ *   intellectual property information,user agreements, and related information.
+ *
+ *   Although Isis has been used by the USGS, no warranty, expressed or implied,
+ *   is made by the USGS as to the accuracy and functioning of such software
+ *   and related material nor shall the fact of distribution constitute any such
+ *   warranty, and no responsibility is assumed by the USGS in connection
+ *   therewith.
+ *
+ *   For additional information, launch
+ *   $ISISROOT/doc//documents/Disclaimers/Disclaimers.html in a browser or see
+ *   the Privacy &amp; Disclaimers page on the Isis website,
+ *   http://isis.astrogeology.usgs.gov, and the USGS privacy and disclaimers on
+ *   http://www.usgs.gov/privacy.html.
+ */
+#include "CubeOverview.h"
+
+#include <cstring>
+#include <fstream>
+#include <istream>
+
+#include "Endian.h"
+#include "EndianSwapper.h"
+#include "FileName.h"
+#include "IException.h"
+#include "IString.h"
+#include "PvlKeyword.h"
+#include "PvlObject.h"
+#include "SpecialPixel.h"
+
+using namespace std;
+
+namespace Isis {
+
+  /**
+   * Constructs a tile filled with NULLs to be written to a cube.
+   *
+   * @param level The reduction factor of the overview
+   * @param samples The number of samples in the overview
+   * @param lines The number of lines in the whole overview
+   * @param bands The number of bands in the overview
+   * @param firstLine The first overview line in the tile
+   * @param tileLines The number of overview lines in the tile
+   */
+  CubeOverview::CubeOverview(int level, int samples, int lines, int bands, int firstLine,
+                             int tileLines) :
+      Blob(overviewName(level, firstLine), "Overview") {
+    m_level = level;
+    m_samples = samples;
+    m_lines = lines;
+    m_bands = bands;
+    m_firstLine = firstLine;
+    m_tileLines = tileLines;
+    m_swap = false;
+    m_pixels.assign((size_t)samples * tileLines * bands, NULL4);
+  }
+
+
+  /**
+   * Constructs a tile from its object in the labels of a cube, without reading
+   * its pixels.
+   *
+   * @param object The Overview object of the tile
+   * @param labelFile The file the labels were read from, which detached tiles
+   *                  are relative to
+   */
+  CubeOverview::CubeOverview(const PvlObject &object, const QString &labelFile) :
+      Blob(object["Name"][0], "Overview") {
+    p_blobPvl = object;
+    p_labelFile = labelFile;
+    try {
+      p_startByte = p_blobPvl["StartByte"];
+      p_nbytes = p_blobPvl["Bytes"];
+      if (p_blobPvl.hasKeyword("^Overview")) {
+        p_detached = FileName(labelFile).path() + "/" + (QString)p_blobPvl["^Overview"];
+      }
+    }
+    catch (IException &e) {
+      QString msg = "Invalid Overview label format";
+      throw IException(e, IException::Unknown, msg, _FILEINFO_);
+    }
+
+    readDimensions();
+  }
+
+
+  //! Destroys the tile.
+  CubeOverview::~CubeOverview() {
+  }
+
+
+  /**
+   * @param level The reduction factor of an overview
+   * @param firstLine The first overview line in a tile of the overview
+   * @return The name of the overview blob holding the tile
+   */
+  QString CubeOverview::overviewName(int level, int firstLine) {
+    return "Level" + toString(level) + "Line" + toString(firstLine);
+  }
+
+
+  /**
+   * Finds how many overview lines fit in one tile. A single line is always
+   * allowed, so only lines over the 2 GB blob limit are rejected.
+   *
+   * @param samples The number of samples in the overview
+   * @param bands The number of bands in the overview
+   * @return The largest number of lines to put in a tile
+   */
+  int CubeOverview::maximumTileLines(int samples, int bands) {
+    BigInt lineBytes = (BigInt)samples * bands * sizeof(float);
+    if (lineBytes > 2147483647) {
+      QString msg = "An overview line of [" + toString(samples) + "] samples and [" +
+                    toString(bands) + "] bands is too large to store in a cube";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    return (int)qMax((BigInt)1, s_maximumTileBytes / lineBytes);
+  }
+
+
+  /**
+   * @return The reduction factor of the overview
+   */
+  int CubeOverview::level() const {
+    return m_level;
+  }
+
+
+  /**
+   * @return The number of samples in the overview
+   */
+  int CubeOverview::sampleCount() const {
+    return m_samples;
+  }
+
+
+  /**
+   * @return The number of lines in the whole overview
+   */
+  int CubeOverview::lineCount() const {
+    return m_lines;
+  }
+
+
+  /**
+   * @return The number of bands in the overview
+   */
+  int CubeOverview::bandCount() const {
+    return m_bands;
+  }
+
+
+  /**
+   * @return The first overview line in the tile
+   */
+  int CubeOverview::firstLine() const {
+    return m_firstLine;
+  }
+
+
+  /**
+   * @return The number of overview lines in the tile
+   */
+  int CubeOverview::tileLineCount() const {
+    return m_tileLines;
+  }
+
+
+  /**
+   * @return The DataStamp of the cube when the tile was written, or an empty
+   *         string if it was never written to a cube
+   */
+  QString CubeOverview::sourceStamp() const {
+    if (!p_blobPvl.hasKeyword("SourceStamp")) {
+      return "";
+    }
+    return p_blobPvl["SourceStamp"][0];
+  }
+
+
+  /**
+   * @return The file holding the pixels of a detached tile, or an empty string
+   *         if the pixels are in the cube file
+   */
+  QString CubeOverview::dataFile() const {
+    return p_detached;
+  }
+
+
+  /**
+   * @param sample The overview sample, starting at 1
+   * @param line The overview line, starting at 1
+   * @param band The band, starting at 1
+   * @return The pixel, or NULL outside of the tile or if its pixels are not
+   *         loaded
+   */
+  double CubeOverview::pixel(int sample, int line, int band) const {
+    if (sample < 1 || sample > m_samples || line < m_firstLine ||
+        line >= m_firstLine + m_tileLines || band < 1 || band > m_bands ||
+        m_pixels.empty()) {
+      return Null;
+    }
+
+    return TestPixel(m_pixels[index(sample, line, band)]);
+  }
+
+
+  /**
+   * @param sample The overview sample, starting at 1
+   * @param line The overview line, starting at 1
+   * @param band The band, starting at 1
+   * @param value The new value of the pixel
+   */
+  void CubeOverview::setPixel(int sample, int line, int band, double value) {
+    if (sample < 1 || sample > m_samples || line < m_firstLine ||
+        line >= m_firstLine + m_tileLines || band < 1 || band > m_bands ||
+        m_pixels.empty()) {
+      QString msg = "Overview pixel [" + toString(sample) + ", " + toString(line) + ", " +
+                    toString(band) + "] is outside of the tile [" + p_blobName + "]";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    m_pixels[index(sample, line, band)] = TestPixel(value);
+  }
+
+
+  /**
+   * Finds where a stored pixel of the tile is, so a row of pixels can be read
+   * without reading the rest of the tile.
+   *
+   * @param sample The overview sample, starting at 1
+   * @param line The overview line in the tile, starting at 1
+   * @param band The band, starting at 1
+   * @return The position of the pixel from the start of the file holding the
+   *         tile, starting at 0
+   */
+  BigInt CubeOverview::byteOffset(int sample, int line, int band) const {
+    return p_startByte - 1 + (BigInt)index(sample, line, band) * sizeof(float);
+  }
+
+
+  /**
+   * Converts stored pixels of the tile to doubles.
+   *
+   * @param stored The pixels as they are stored in the file
+   * @param count The number of pixels
+   * @param pixels The converted pixels
+   */
+  void CubeOverview::toPixels(const char *stored, int count, double *pixels) const {
+    EndianSwapper swapper(IsLsb() ? "MSB" : "LSB");
+    for (int i = 0; i < count; i++) {
+      float value;
+      if (m_swap) {
+        value = swapper.Float((void *)(stored + i * sizeof(float)));
+      }
+      else {
+        memcpy(&value, stored + i * sizeof(float), sizeof(float));
+      }
+      pixels[i] = TestPixel(value);
+    }
+  }
+
+
+  //! Reads the tile size from its label.
+  void CubeOverview::ReadInit() {
+    readDimensions();
+  }
+
+
+  /**
+   * Reads all of the tile pixels.
+   *
+   * @param stream The stream to read the pixels from
+   */
+  void CubeOverview::ReadData(std::istream &stream) {
+    m_pixels.resize((size_t)m_samples * m_tileLines * m_bands);
+
+    stream.seekg((streampos)(p_startByte - 1), std::ios::beg);
+    stream.read((char *)&m_pixels[0], p_nbytes);
+    if (!stream.good()) {
+      QString msg = "Error reading data from Overview [" + p_blobName + "]";
+      throw IException(IException::Io, msg, _FILEINFO_);
+    }
+
+    if (m_swap) {
+      EndianSwapper swapper(IsLsb() ? "MSB" : "LSB");
+      for (size_t i = 0; i < m_pixels.size(); i++) {
+        m_pixels[i] = swapper.Float(&m_pixels[i]);
+      }
+      m_swap = false;
+    }
+  }
+
+
+  //! Puts the tile size in its label.
+  void CubeOverview::WriteInit() {
+    p_nbytes = (BigInt)m_pixels.size() * sizeof(float);
+
+    p_blobPvl.addKeyword(PvlKeyword("Level", toString(m_level)), PvlContainer::Replace);
+    p_blobPvl.addKeyword(PvlKeyword("Samples", toString(m_samples)), PvlContainer::Replace);
+    p_blobPvl.addKeyword(PvlKeyword("Lines", toString(m_lines)), PvlContainer::Replace);
+    p_blobPvl.addKeyword(PvlKeyword("Bands", toString(m_bands)), PvlContainer::Replace);
+    p_blobPvl.addKeyword(PvlKeyword("FirstLine", toString(m_firstLine)),
+                         PvlContainer::Replace);
+    p_blobPvl.addKeyword(PvlKeyword("TileLines", toString(m_tileLines)),
+                         PvlContainer::Replace);
+    p_blobPvl.addKeyword(PvlKeyword("ByteOrder", ByteOrderName(IsLsb() ? Lsb : Msb)),
+                         PvlContainer::Replace);
+  }
+
+
+  /**
+   * Writes the tile pixels.
+   *
+   * @param stream The stream to write the pixels to
+   */
+  void CubeOverview::WriteData(std::fstream &stream) {
+    stream.write((const char *)&m_pixels[0], p_nbytes);
+    if (!stream.good()) {
+      QString msg = "Error writing data to Overview [" + p_blobName + "]";
+      throw IException(IException::Io, msg, _FILEINFO_);
+    }
+  }
+
+
+  //! Reads the size of the tile from its label and checks it against its bytes.
+  void CubeOverview::readDimensions() {
+    try {
+      m_level = p_blobPvl["Level"];
+      m_samples = p_blobPvl["Samples"];
+      m_lines = p_blobPvl["Lines"];
+      m_bands = p_blobPvl["Bands"];
+      m_firstLine = p_blobPvl["FirstLine"];
+      m_tileLines = p_blobPvl["TileLines"];
+
+      ByteOrder byteOrder = ByteOrderEnumeration(p_blobPvl["ByteOrder"]);
+      m_swap = (IsLsb() && byteOrder == Msb) || (IsMsb() && byteOrder == Lsb);
+    }
+    catch (IException &e) {
+      QString msg = "Invalid Overview [" + p_blobName + "] label format";
+      throw IException(e, IException::Unknown, msg, _FILEINFO_);
+    }
+
+    if ((BigInt)p_nbytes != (BigInt)m_samples * m_tileLines * m_bands * sizeof(float)) {
+      QString msg = "Overview [" + p_blobName + "] has [" + toString(p_nbytes) +
+                    "] bytes, which does not match its dimensions";
+      throw IException(IException::Unknown, msg, _FILEINFO_);
+    }
+  }
+
+
+  /**
+   * @param sample The overview sample, starting at 1
+   * @param line The overview line in the tile, starting at 1
+   * @param band The band, starting at 1
+   * @return The position of the pixel in the tile
+   */
+  size_t CubeOverview::index(int sample, int line, int band) const {
+    return ((size_t)(band - 1) * m_tileLines + (line - m_firstLine)) * m_samples +
+           (sample - 1);
+  }
+}
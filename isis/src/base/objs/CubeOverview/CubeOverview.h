@@ -0,0 +1,105 @@
+#ifndef CubeOverview_h
+#define CubeOverview_h
+/**
+ * @file
+ *
+ *   Unless noted otherwise, the portions of Isis written by the USGS are public
+ *   domain. See individual third-party library and package descriptions for
+ *   intellectual property information,user agreements, and related information.
+ *
+ *   Although Isis has been used by the USGS, no warranty, expressed or implied,
+ *   is made by the USGS as to the accuracy and functioning of such software
+ *   and related material nor shall the fact of distribution constitute any such
+ *   warranty, and no responsibility is assumed by the USGS in connection
+ *   therewith.
+ *
+ *   For additional information, launch
+ *   $ISISROOT/doc//documents/Disclaimers/Disclaimers.html in a browser or see
+ *   the Privacy &amp; Disclaimers page on the Isis website,
+ *   http://isis.astrogeology.usgs.gov, and the USGS privacy and disclaimers on
+ *   http://www.usgs.gov/privacy.html.
+ */
+
+#include <iosfwd>
+#include <vector>
+
+#include <QString>
+
+#include "Blob.h"
+#include "Constants.h"
+
+namespace Isis {
+  class PvlObject;
+
+  /**
+   * One tile of a reduced resolution copy of a cube, stored in the cube as an
+   * Overview blob.
+   *
+   * Each pixel of an overview of level N is the average of the valid pixels in
+   * an N by N block of the cube, or NULL if the block has no valid pixels.
+   * Overview sample S covers cube samples (S - 1) * N + 1 through S * N, and
+   * likewise for lines. Bands are not reduced.
+   *
+   * A level is stored as a strip of tiles, each holding a range of whole
+   * overview lines for all of the bands, so no blob gets near the 2 GB blob
+   * limit and a level can be written one tile at a time. Tiles are read a row
+   * at a time with byteOffset() and toPixels() instead of being read whole.
+   * The pixels are stored as 4-byte reals, in BSQ order within the tile, in
+   * the byte order of the machine that wrote them.
+   *
+   * Overviews are built by the buildpyramid application and read with
+   * Cube::read(Buffer &, int). Each tile records the DataStamp of the cube it
+   * was built from, and the cube ignores tiles whose stamp no longer matches
+   * after its DNs are written to.
+   */
+  class CubeOverview : public Blob {
+    public:
+      CubeOverview(int level, int samples, int lines, int bands, int firstLine,
+                   int tileLines);
+      CubeOverview(const PvlObject &object, const QString &labelFile);
+      ~CubeOverview();
+
+      static QString overviewName(int level, int firstLine);
+      static int maximumTileLines(int samples, int bands);
+
+      int level() const;
+      int sampleCount() const;
+      int lineCount() const;
+      int bandCount() const;
+      int firstLine() const;
+      int tileLineCount() const;
+      QString sourceStamp() const;
+      QString dataFile() const;
+
+      double pixel(int sample, int line, int band) const;
+      void setPixel(int sample, int line, int band, double value);
+
+      BigInt byteOffset(int sample, int line, int band) const;
+      void toPixels(const char *stored, int count, double *pixels) const;
+
+    protected:
+      void ReadInit();
+      void ReadData(std::istream &stream);
+      void WriteInit();
+      void WriteData(std::fstream &stream);
+
+    private:
+      void readDimensions();
+      size_t index(int sample, int line, int band) const;
+
+      //! The largest tile, in bytes, that buildpyramid holds in memory per level
+      static const BigInt s_maximumTileBytes = 128 * 1024 * 1024;
+
+      int m_level;      //!< The reduction factor of the overview
+      int m_samples;    //!< The number of samples in the overview
+      int m_lines;      //!< The number of lines in the whole overview
+      int m_bands;      //!< The number of bands in the overview
+      int m_firstLine;  //!< The first overview line in the tile
+      int m_tileLines;  //!< The number of overview lines in the tile
+      bool m_swap;      //!< True if the stored pixels are in the other byte order
+
+      std::vector<float> m_pixels; //!< The tile pixels in BSQ order, when loaded
+  };
+}
+
+#endif
@@ -12,7 +12,7 @@
 #include "IString.h"
 #include "Latitude.h"
 #include "Longitude.h"
-#include "NaifStatus.h"
+#include "NaifMath.h"
 #include "ShapeModel.h"
 #include "SurfacePoint.h"
 
@@ -119,9 +119,7 @@ namespace Isis {
     double c = radii[2].kilometers();
 
     vector<double> normal(3,0.);
-    NaifStatus::CheckErrors();
-    surfnm_c(a, b, c, pB, (SpiceDouble *) &normal[0]);
-    NaifStatus::CheckErrors();
+    NaifMath::surfnm(a, b, c, pB, &normal[0]);
 
     setNormal(normal);
     setHasNormal(true);
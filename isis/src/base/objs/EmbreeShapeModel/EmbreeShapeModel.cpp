@@ -43,6 +43,23 @@ using namespace std;
 
 namespace Isis {
 
+  /**
+   * Returns the key of a ray in the table of prepared rays
+   *
+   * @param observerPos Position of observer in body-fixed kilometers
+   * @param lookDirection Unit look direction from the observer
+   *
+   * @return @b QByteArray The bytes of the observer position and look direction
+   */
+  static QByteArray preparedRayKey(const std::vector<double> &observerPos,
+                                   const std::vector<double> &lookDirection) {
+    QByteArray key((const char *) &observerPos[0], observerPos.size() * sizeof(double));
+    key.append((const char *) &lookDirection[0], lookDirection.size() * sizeof(double));
+    return key;
+  }
+
+
+
   /** 
    * Default constructor sets type to a TIN
    */
@@ -51,7 +68,8 @@ namespace Isis {
         m_targetShape(0),
         m_targetManager(0),
         m_tolerance(DBL_MAX),
-        m_shapeFile("") {
+        m_shapeFile(""),
+        m_nextPrepared(0) {
     // defaults for ShapeModel parent class include:
     //     name = empty string
     //     surfacePoint = null sp
@@ -81,7 +99,8 @@ namespace Isis {
         m_targetShape(0),
         m_targetManager(targetManager),
         m_tolerance(DBL_MAX),
-        m_shapeFile("") {
+        m_shapeFile(""),
+        m_nextPrepared(0) {
 
     // defaults for ShapeModel parent class include:
     //     name = empty string
@@ -128,7 +147,8 @@ namespace Isis {
         m_targetShape(0),
         m_targetManager(targetManager),
         m_tolerance(DBL_MAX),
-        m_shapeFile(shapefile) {
+        m_shapeFile(shapefile),
+        m_nextPrepared(0) {
 
     // defaults for ShapeModel parent class include:
     //     name = empty string
@@ -180,6 +200,18 @@ namespace Isis {
     // Remove any previous intersection
     clearSurfacePoint();
 
+    // Use the hit from prepareIntersections if this ray was traced there
+    int prepared = findPreparedIntersection(observerPos, lookDirection);
+    if (prepared >= 0) {
+      if (m_preparedHasHit[prepared]) {
+        updateIntersection(m_preparedHits[prepared]);
+      }
+      else {
+        setHasIntersection(false);
+      }
+      return hasIntersection();
+    }
+
     // Create a ray from the observer in the look direction
     RTCMultiHitRay ray(observerPos, lookDirection);
 
@@ -201,6 +233,108 @@ namespace Isis {
   }
 
 
+  /**
+   * Indicates that the Embree shape model traces batches of look directions
+   * with prepareIntersections.
+   *
+   * @return @b bool Always true
+   */
+  bool EmbreeShapeModel::canPrepareIntersections() const {
+    return true;
+  }
+
+
+  /**
+   * Traces a batch of look directions through the target shape, such as the
+   * look directions of a brick of pixels. The rays are traced together with
+   * EmbreeTargetShape::intersectRays and their first hits are kept. Following
+   * calls to intersectSurface with the same observer position and look
+   * direction use the kept hit instead of tracing the ray again, so they give
+   * the same intersection. Any previously prepared look directions are
+   * discarded.
+   *
+   * @param observerPositions The body-fixed position of the observer for each
+   *                          look direction, in kilometers
+   * @param lookDirections The body-fixed look directions
+   *
+   * @throws IException::Programmer
+   */
+  void EmbreeShapeModel::prepareIntersections(
+      const std::vector< std::vector<double> > &observerPositions,
+      const std::vector< std::vector<double> > &lookDirections) {
+    if (observerPositions.size() != lookDirections.size()) {
+      QString msg = "The number of observer positions [" + toString((int) observerPositions.size())
+                    + "] and look directions [" + toString((int) lookDirections.size())
+                    + "] must match";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    m_preparedPositions = observerPositions;
+    m_preparedLookDirections = lookDirections;
+    m_nextPrepared = 0;
+    m_preparedIndex.clear();
+    m_preparedIndex.reserve(lookDirections.size());
+    for (size_t i = 0; i < lookDirections.size(); i++) {
+      QByteArray key = preparedRayKey(observerPositions[i], lookDirections[i]);
+      if (!m_preparedIndex.contains(key)) {
+        m_preparedIndex.insert(key, (int) i);
+      }
+    }
+
+    std::vector<RTCMultiHitRay> rays;
+    rays.reserve(lookDirections.size());
+    for (size_t i = 0; i < lookDirections.size(); i++) {
+      rays.push_back(RTCMultiHitRay(observerPositions[i], lookDirections[i]));
+    }
+
+    m_targetShape->intersectRays(rays);
+
+    m_preparedHits.assign(rays.size(), RayHitInformation());
+    m_preparedHasHit.assign(rays.size(), false);
+    for (size_t i = 0; i < rays.size(); i++) {
+      if (rays[i].lastHit >= 0) {
+        m_preparedHits[i] = m_targetShape->getHitInformation(rays[i], 0);
+        m_preparedHasHit[i] = true;
+      }
+    }
+  }
+
+
+  /**
+   * Finds a look direction traced by prepareIntersections. The look directions
+   * are normally intersected in the order they were prepared, so the one after
+   * the last found is checked first. Other rays, such as the neighbors traced
+   * for local normals, are looked up by their observer position and look
+   * direction, so a ray that was not prepared costs one hash lookup.
+   *
+   * @param observerPos Position of observer in body-fixed kilometers
+   * @param lookDirection Unit look direction from the observer
+   *
+   * @return @b int The index of the prepared look direction, or -1 if it was
+   *                not prepared
+   */
+  int EmbreeShapeModel::findPreparedIntersection(const std::vector<double> &observerPos,
+                                                 const std::vector<double> &lookDirection) {
+    if (m_preparedIndex.isEmpty()) {
+      return -1;
+    }
+
+    if (m_nextPrepared < m_preparedLookDirections.size() &&
+        m_preparedLookDirections[m_nextPrepared] == lookDirection &&
+        m_preparedPositions[m_nextPrepared] == observerPos) {
+      return (int) m_nextPrepared++;
+    }
+
+    QHash<QByteArray, int>::const_iterator prepared =
+        m_preparedIndex.constFind(preparedRayKey(observerPos, lookDirection));
+    if (prepared == m_preparedIndex.constEnd()) {
+      return -1;
+    }
+    m_nextPrepared = prepared.value() + 1;
+    return prepared.value();
+  }
+
+
 /**
  * @brief Compute intersection of surface vector direction from observer with 
  *        occulusion
@@ -28,6 +28,8 @@
 
 #include <embree2/rtcore.h>
 
+#include <QByteArray>
+#include <QHash>
 #include <QMap>
 #include <QVector>
 
@@ -72,6 +74,10 @@ namespace Isis {
                                     const std::vector<double> &observerPos,
                                     const bool &backCheck = true);
 
+      virtual bool canPrepareIntersections() const;
+      virtual void prepareIntersections(const std::vector< std::vector<double> > &observerPositions,
+                                        const std::vector< std::vector<double> > &lookDirections);
+
       virtual void clearSurfacePoint();
 
       virtual bool isDEM() const;
@@ -99,6 +105,8 @@ namespace Isis {
       Q_DISABLE_COPY(EmbreeShapeModel)
 
       void updateIntersection(const RayHitInformation hitInfo);
+      int findPreparedIntersection(const std::vector<double> &observerPos,
+                                   const std::vector<double> &lookDirection);
       RTCMultiHitRay latlonToRay(const Latitude &lat, const Longitude &lon) const;
       RTCMultiHitRay pointToRay(const  SurfacePoint &point) const;
       QVector< RayHitInformation > sortHits(RTCMultiHitRay &ray,
@@ -115,6 +123,20 @@ namespace Isis {
       double               m_tolerance;     /**!< Tolerance for checking visibility. */
       QString              m_shapeFile;     /**!< The shapefile used to create the target
                                                   shape. */
+      std::vector< std::vector<double> > m_preparedPositions; /**!< The observer positions
+                                                                    traced by
+                                                                    prepareIntersections. */
+      std::vector< std::vector<double> > m_preparedLookDirections; /**!< The look directions
+                                                                         traced by
+                                                                         prepareIntersections. */
+      std::vector<RayHitInformation>     m_preparedHits;   //!< The first hit of each prepared ray
+      std::vector<bool>                  m_preparedHasHit; //!< If each prepared ray hit the target
+      QHash<QByteArray, int>             m_preparedIndex;  /**!< The index of each prepared
+                                                                ray, keyed by its observer
+                                                                position and look
+                                                                direction. */
+      size_t                             m_nextPrepared;   /**!< The prepared look direction
+                                                                expected next. */
   };
 };
 
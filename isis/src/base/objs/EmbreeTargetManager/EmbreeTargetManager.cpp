@@ -27,6 +27,8 @@
 
 #include "FileName.h"
 #include "IException.h"
+#include "Preference.h"
+#include "Pvl.h"
 
 #include "EmbreeTargetManager.h"
 
@@ -131,6 +133,10 @@ namespace Isis {
    * EmbreeTargetManager::setMaxCacheSize to change the maximum number of
    * EmbreeTargetShapes.
    *
+   * If the ShapeModel group of the user preferences has a MeshCache keyword,
+   * new EmbreeTargetShapes load their mesh from, and save it to, a mesh cache
+   * in that directory.
+   *
    * @param shapeFile The path to the file to create an EmbreeTargetShape from
    *
    * @return @b EmbreeTargetShape* A pointer to the loaded target shape. The
@@ -164,7 +170,14 @@ namespace Isis {
     }
 
     // If there's still space make a new one
-    EmbreeTargetShape *targetShape = new EmbreeTargetShape(fullPath);
+    Pvl conf;
+    if ( Preference::Preferences().hasGroup("ShapeModel") ) {
+      PvlGroup &shapePrefs = Preference::Preferences().findGroup("ShapeModel");
+      if ( shapePrefs.hasKeyword("MeshCache") ) {
+        conf += shapePrefs["MeshCache"];
+      }
+    }
+    EmbreeTargetShape *targetShape = new EmbreeTargetShape(fullPath, &conf);
     EmbreeTargetShapeContainer targetShapeContainer(fullPath, targetShape);
     ++(targetShapeContainer.m_referenceCount);
     m_targeCache.insert(fullPath, targetShapeContainer);
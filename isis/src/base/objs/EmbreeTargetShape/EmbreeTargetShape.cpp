@@ -24,11 +24,18 @@
 
 #include "EmbreeTargetShape.h"
 
+#include <cstring>
 #include <iostream>
 #include <iomanip>
 #include <numeric>
 #include <sstream>
 
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFile>
+#include <QSaveFile>
+#include <QtConcurrentMap>
+
 #include "NaifDskApi.h"
 
 #include "FileName.h"
@@ -246,7 +253,12 @@ namespace Isis {
         m_device(rtcNewDevice(NULL)),
         m_scene(rtcDeviceNewScene(m_device,
                                   RTC_SCENE_STATIC | RTC_SCENE_HIGH_QUALITY | RTC_SCENE_ROBUST,
-                                  RTC_INTERSECT1)) { }
+                                  RTC_INTERSECT1)),
+        m_meshCache(),
+        m_cachedVertices(NULL),
+        m_cachedTriangles(NULL),
+        m_cachedVertexCount(0),
+        m_cachedTriangleCount(0) { }
 
 
   /** 
@@ -262,7 +274,12 @@ namespace Isis {
         m_device(rtcNewDevice(NULL)),
         m_scene(rtcDeviceNewScene(m_device,
                                   RTC_SCENE_STATIC | RTC_SCENE_HIGH_QUALITY | RTC_SCENE_ROBUST,
-                                  RTC_INTERSECT1)) {
+                                  RTC_INTERSECT1)),
+        m_meshCache(),
+        m_cachedVertices(NULL),
+        m_cachedTriangles(NULL),
+        m_cachedVertexCount(0),
+        m_cachedTriangleCount(0) {
     initMesh(mesh);
   }
 
@@ -273,7 +290,8 @@ namespace Isis {
    * @param dem The file to construct the target shape from. The file type is determined
    *            based on the file extension.
    * @param conf Pvl containing configuration settings for the target shape.
-   *             Currently unused.
+   *             If it has a MeshCache keyword, the mesh is loaded from and
+   *             saved to a cache file in that directory.
    * 
    * @throws IException::Io
    */
@@ -284,11 +302,24 @@ namespace Isis {
         m_device(rtcNewDevice(NULL)),
         m_scene(rtcDeviceNewScene(m_device,
                                   RTC_SCENE_STATIC | RTC_SCENE_HIGH_QUALITY | RTC_SCENE_ROBUST,
-                                  RTC_INTERSECT1)) {
+                                  RTC_INTERSECT1)),
+        m_meshCache(),
+        m_cachedVertices(NULL),
+        m_cachedTriangles(NULL),
+        m_cachedVertexCount(0),
+        m_cachedTriangleCount(0) {
     FileName file(dem);
     pcl::PolygonMesh::Ptr mesh;
     m_name = file.baseName();
 
+    QString cacheFile;
+    if ( conf && conf->hasKeyword("MeshCache") && file.extension() != "cub" ) {
+      cacheFile = meshCacheFile(file, (QString) conf->findKeyword("MeshCache"));
+      if ( loadMeshCache(cacheFile) ) {
+        return;
+      }
+    }
+
     try {
       // DEMs (ISIS cubes) TODO implement this
       if (file.extension() == "cub") {
@@ -310,6 +341,10 @@ namespace Isis {
       throw IException(e, IException::Io, msg, _FILEINFO_);
     }
     initMesh(mesh);
+
+    if ( !cacheFile.isEmpty() ) {
+      saveMeshCache(cacheFile);
+    }
   }
 
 
@@ -543,6 +578,192 @@ namespace Isis {
   }
 
 
+  /**
+   * Layout of the start of a mesh cache file. The vertices follow the header
+   * as Vertex structs and the triangles follow the vertices as Triangle
+   * structs, in the byte order of the machine that wrote the cache. The header
+   * is a multiple of 16 bytes so the mapped vertices are aligned for Embree.
+   */
+  struct MeshCacheHeader {
+    char   magic[8];      //!< Always "ISISMESH"
+    qint32 version;       //!< The version of the layout, currently 1
+    qint32 vertexCount;   //!< The number of vertices
+    qint32 triangleCount; //!< The number of triangles
+    qint32 reserved[3];   //!< Unused, pads the header to 32 bytes
+  };
+
+
+  /**
+   * Returns the mesh cache file for a shape file. The cache is named by the
+   * SHA-1 checksum of the shape file contents, so a changed shape file is
+   * never matched with the cache of its old contents.
+   *
+   * @param file The shape file
+   * @param cacheDirectory The directory holding mesh cache files
+   *
+   * @return @b QString The path of the cache file, or an empty string if the
+   *                    shape file cannot be read or the directory cannot be
+   *                    created.
+   */
+  QString EmbreeTargetShape::meshCacheFile(const FileName &file, const QString &cacheDirectory) {
+    QFile shape(file.expanded());
+    if ( !shape.open(QIODevice::ReadOnly) ) {
+      return "";
+    }
+    QCryptographicHash checksum(QCryptographicHash::Sha1);
+    if ( !checksum.addData(&shape) ) {
+      return "";
+    }
+
+    QString directory = FileName(cacheDirectory).expanded();
+    if ( !QDir().mkpath(directory) ) {
+      return "";
+    }
+    return directory + "/" + QString(checksum.result().toHex()) + ".mesh";
+  }
+
+
+  /**
+   * Loads the mesh from a mesh cache file. The file is memory mapped and its
+   * vertex and triangle arrays are given to Embree as shared buffers, so the
+   * mesh is not copied. The scene is committed.
+   *
+   * @param cacheFile The mesh cache file
+   *
+   * @return @b bool If the cache file exists and is valid. If not, the target
+   *                 shape is unchanged.
+   */
+  bool EmbreeTargetShape::loadMeshCache(const QString &cacheFile) {
+    if ( cacheFile.isEmpty() || !QFile::exists(cacheFile) ) {
+      return false;
+    }
+
+    QScopedPointer<QFile> cache( new QFile(cacheFile) );
+    if ( !cache->open(QIODevice::ReadOnly) ) {
+      return false;
+    }
+
+    uchar *data = cache->map( 0, cache->size() );
+    if ( !data || cache->size() < (qint64) sizeof(MeshCacheHeader) ) {
+      return false;
+    }
+
+    const MeshCacheHeader *header = (const MeshCacheHeader *) data;
+    if ( memcmp(header->magic, "ISISMESH", 8) != 0 || header->version != 1 ||
+         header->vertexCount < 0 || header->triangleCount < 0 ) {
+      return false;
+    }
+    qint64 expectedSize = sizeof(MeshCacheHeader)
+                          + (qint64) header->vertexCount * sizeof(Vertex)
+                          + (qint64) header->triangleCount * sizeof(Triangle);
+    if ( cache->size() != expectedSize ) {
+      return false;
+    }
+
+    m_cachedVertexCount = header->vertexCount;
+    m_cachedTriangleCount = header->triangleCount;
+    m_cachedVertices = (const Vertex *) ( data + sizeof(MeshCacheHeader) );
+    m_cachedTriangles = (const Triangle *) ( m_cachedVertices + m_cachedVertexCount );
+    m_meshCache.reset( cache.take() );
+
+    // Create a static geometry (the body) in our scene from the mapped arrays
+    unsigned geomID = rtcNewTriangleMesh(m_scene,
+                                         RTC_GEOMETRY_STATIC,
+                                         m_cachedTriangleCount,
+                                         m_cachedVertexCount,
+                                         1);
+    rtcSetBuffer(m_scene, geomID, RTC_VERTEX_BUFFER, m_cachedVertices, 0, sizeof(Vertex));
+    rtcSetBuffer(m_scene, geomID, RTC_INDEX_BUFFER, m_cachedTriangles, 0, sizeof(Triangle));
+
+    rtcSetIntersectionFilterFunction(m_scene, geomID,
+                                     (RTCFilterFunc)&EmbreeTargetShape::multiHitFilter);
+    rtcSetOcclusionFilterFunction(m_scene, geomID,
+                                    (RTCFilterFunc)&EmbreeTargetShape::occlusionFilter);
+
+    rtcCommit(m_scene);
+    return true;
+  }
+
+
+  /**
+   * Saves the internalized polygon mesh to a mesh cache file. The file is
+   * written under a temporary name and renamed, so other processes never map
+   * a partially written cache. Failing to save the cache is not an error.
+   *
+   * @param cacheFile The mesh cache file
+   */
+  void EmbreeTargetShape::saveMeshCache(const QString &cacheFile) const {
+    if ( cacheFile.isEmpty() || !m_mesh.get() ) {
+      return;
+    }
+
+    MeshCacheHeader header;
+    memset( &header, 0, sizeof(MeshCacheHeader) );
+    memcpy( header.magic, "ISISMESH", 8 );
+    header.version = 1;
+    header.vertexCount = numberOfVertices();
+    header.triangleCount = numberOfPolygons();
+
+    std::vector<Vertex> vertices(header.vertexCount);
+    for (int v = 0; v < header.vertexCount; ++v) {
+      vertices[v].x = m_cloud.points[v].x;
+      vertices[v].y = m_cloud.points[v].y;
+      vertices[v].z = m_cloud.points[v].z;
+      vertices[v].a = 0.0;
+    }
+
+    std::vector<Triangle> triangles(header.triangleCount);
+    for (int t = 0; t < header.triangleCount; ++t) {
+      triangles[t].v0 = m_mesh->polygons[t].vertices[0];
+      triangles[t].v1 = m_mesh->polygons[t].vertices[1];
+      triangles[t].v2 = m_mesh->polygons[t].vertices[2];
+    }
+
+    QSaveFile cache(cacheFile);
+    if ( !cache.open(QIODevice::WriteOnly) ) {
+      return;
+    }
+    cache.write( (const char *) &header, sizeof(MeshCacheHeader) );
+    cache.write( (const char *) vertices.data(), vertices.size() * sizeof(Vertex) );
+    cache.write( (const char *) triangles.data(), triangles.size() * sizeof(Triangle) );
+    cache.commit();
+  }
+
+
+  /**
+   * Returns the body-fixed vertices of a triangle in the mesh.
+   *
+   * @param primID The index of the triangle
+   * @param[out] v0 The first vertex of the triangle
+   * @param[out] v1 The second vertex of the triangle
+   * @param[out] v2 The third vertex of the triangle
+   */
+  void EmbreeTargetShape::triangleVertices(int primID, float v0[3],
+                                           float v1[3], float v2[3]) const {
+    if ( m_meshCache ) {
+      const Triangle &triangle = m_cachedTriangles[primID];
+      const Vertex *vertices[3] = { &m_cachedVertices[triangle.v0],
+                                    &m_cachedVertices[triangle.v1],
+                                    &m_cachedVertices[triangle.v2] };
+      float *out[3] = { v0, v1, v2 };
+      for (int i = 0; i < 3; i++) {
+        out[i][0] = vertices[i]->x;
+        out[i][1] = vertices[i]->y;
+        out[i][2] = vertices[i]->z;
+      }
+    }
+    else {
+      const std::vector<uint32_t> &indices = m_mesh->polygons[primID].vertices;
+      float *out[3] = { v0, v1, v2 };
+      for (int i = 0; i < 3; i++) {
+        out[i][0] = m_cloud.points[indices[i]].x;
+        out[i][1] = m_cloud.points[indices[i]].y;
+        out[i][2] = m_cloud.points[indices[i]].z;
+      }
+    }
+  }
+
+
   /**
    * Desctructor. The PointCloudLibrary objects are automatically cleaned up,
    * but the Embree scene and device must be manually cleaned up.
@@ -560,6 +781,9 @@ namespace Isis {
    *                of the target.
    */
   int EmbreeTargetShape::numberOfPolygons() const {
+    if (m_meshCache) {
+      return m_cachedTriangleCount;
+    }
     if (isValid()) {
       return m_mesh->polygons.size();
     }
@@ -574,6 +798,9 @@ namespace Isis {
    *                of the target.
    */
   int EmbreeTargetShape::numberOfVertices() const {
+    if (m_meshCache) {
+      return m_cachedVertexCount;
+    }
     if (isValid()) {
       return m_mesh->cloud.height * m_mesh->cloud.width;
     }
@@ -678,6 +905,45 @@ namespace Isis {
   }
 
 
+  /**
+   * Intersect a batch of rays with the target shape, such as the look
+   * directions of a brick of pixels. The result for each ray is the same as
+   * calling intersectRay with it, but the rays are traced concurrently on the
+   * global thread pool.
+   *
+   * @param[in,out] rays The rays to intersect with the scene. After calling,
+   *                     the intersection information will be stored in each
+   *                     ray.
+   *
+   * @see intersectRay
+   */
+  void EmbreeTargetShape::intersectRays(std::vector<RTCMultiHitRay> &rays) {
+    if (isValid()) {
+      QtConcurrent::blockingMap(rays, TraceFunctor(m_scene));
+    }
+  }
+
+
+  /**
+   * Constructs a functor that traces rays through a scene
+   *
+   * @param scene The committed scene to trace
+   */
+  EmbreeTargetShape::TraceFunctor::TraceFunctor(RTCScene scene) {
+    m_scene = scene;
+  }
+
+
+  /**
+   * Intersect a ray with the scene, collecting its hits with multiHitFilter
+   *
+   * @param[in,out] ray The ray to intersect
+   */
+  void EmbreeTargetShape::TraceFunctor::operator()(RTCMultiHitRay &ray) const {
+    rtcIntersect(m_scene, *((RTCRay*)&ray));
+  }
+
+
   /**
    * Extract the intersection point and unit surface normal from an
    * RTCMultiHitRay that has been intersected with the target shape. This
@@ -704,9 +970,8 @@ namespace Isis {
     }
 
     // Get the vertices of the triangle hit
-    pcl::PointXYZ v0 = m_cloud.points[m_mesh->polygons[ray.hitPrimIDs[hitIndex]].vertices[0]];
-    pcl::PointXYZ v1 = m_cloud.points[m_mesh->polygons[ray.hitPrimIDs[hitIndex]].vertices[1]];
-    pcl::PointXYZ v2 = m_cloud.points[m_mesh->polygons[ray.hitPrimIDs[hitIndex]].vertices[2]];
+    float v0[3], v1[3], v2[3];
+    triangleVertices(ray.hitPrimIDs[hitIndex], v0, v1, v2);
 
     // The intersection location comes out in barycentric coordinates, (u, v, w).
     // Only u and v are returned because u + v + w = 1. If the coordinates of the
@@ -717,21 +982,21 @@ namespace Isis {
     float w = 1.0 - u - v;
 
     LinearAlgebra::Vector intersection(3);
-    intersection[0] = w*v0.x + v*v1.x + u*v2.x;
-    intersection[1] = w*v0.y + v*v1.y + u*v2.y;
-    intersection[2] = w*v0.z + v*v1.z + u*v2.z;
+    intersection[0] = w*v0[0] + v*v1[0] + u*v2[0];
+    intersection[1] = w*v0[1] + v*v1[1] + u*v2[1];
+    intersection[2] = w*v0[2] + v*v1[2] + u*v2[2];
 
     // Calculate the normal vector as (v1 - v0) x (v2 - v0) and normalize it
     // TODO This calculation assumes that the shape conforms to the NAIF dsk standard
     //      of the plate vertices being ordered counterclockwise about the normal.
     //      Check if this is true for other file types and/or make a more generic process
     LinearAlgebra::Vector surfaceNormal(3);
-    surfaceNormal[0] = (v1.y - v0.y) * (v2.z - v0.z)
-                       - (v1.z - v0.z) * (v2.y - v0.y);
-    surfaceNormal[1] = (v1.z - v0.z) * (v2.x - v0.x)
-                       - (v1.x - v0.x) * (v2.z - v0.z);
-    surfaceNormal[2] = (v1.x - v0.x) * (v2.y - v0.y)
-                       - (v1.y - v0.y) * (v2.x - v0.x);
+    surfaceNormal[0] = (v1[1] - v0[1]) * (v2[2] - v0[2])
+                       - (v1[2] - v0[2]) * (v2[1] - v0[1]);
+    surfaceNormal[1] = (v1[2] - v0[2]) * (v2[0] - v0[0])
+                       - (v1[0] - v0[0]) * (v2[2] - v0[2]);
+    surfaceNormal[2] = (v1[0] - v0[0]) * (v2[1] - v0[1])
+                       - (v1[1] - v0[1]) * (v2[0] - v0[0]);
 
     // The surface normal is not normalized so normalize it.
     surfaceNormal = LinearAlgebra::normalize(surfaceNormal);
@@ -750,12 +1015,13 @@ namespace Isis {
 
 
   /**
-   * Return if a valid mesh is internalized and ready for use.
+   * Return if a valid mesh is internalized or loaded from a mesh cache and
+   * ready for use.
    * 
    * @return @b bool If a mesh is internalized and the Embree scene is ready.
    */
   bool EmbreeTargetShape::isValid() const {
-    return m_mesh.get();
+    return m_mesh.get() || m_meshCache;
   }
 
 
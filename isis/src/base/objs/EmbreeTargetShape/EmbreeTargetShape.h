@@ -23,6 +23,9 @@
  *   http://www.usgs.gov/privacy.html.
  */
 
+#include <vector>
+
+#include <QScopedPointer>
 #include <QString>
 
 // Embree includes
@@ -44,6 +47,8 @@
 #include "FileName.h"
 #include "LinearAlgebra.h"
 
+class QFile;
+
 namespace Isis {
 
 
@@ -147,7 +152,13 @@ namespace Isis {
  * This class holds the Embree representation of a target body. All vectors
  * are expected to be in the body-fixed reference frame for the target and all
  * positions are expected to be in kilometers.
- * 
+ *
+ * If the configuration has a MeshCache directory, the vertices and triangles
+ * of shapes read from files are saved there in a cache file named by the
+ * checksum of the shape file. Later target shapes for the same file memory
+ * map the cache and share it with Embree instead of reading the file, so
+ * processes on the same machine share one read-only copy of the mesh.
+ *
  * @author 2017-05-11 Jeannie Backer & Jesse Mapel
  * @internal 
  *   @history 2017-05-11 Jeannie Backer & Jesse Mapel - Original Version
@@ -171,6 +182,8 @@ namespace Isis {
       void intersectRay(RTCMultiHitRay &ray);
       bool isOccluded(RTCOcclusionRay &ray);
 
+      void intersectRays(std::vector<RTCMultiHitRay> &rays);
+
       RayHitInformation getHitInformation(RTCMultiHitRay &ray, int hitIndex);
 
       static void multiHitFilter(void* userDataPtr, RTCMultiHitRay& ray);
@@ -183,7 +196,28 @@ namespace Isis {
       void addVertices(int geomID);
       void addIndices(int geomID);
 
+      static QString meshCacheFile(const FileName &file, const QString &cacheDirectory);
+      bool loadMeshCache(const QString &cacheFile);
+      void saveMeshCache(const QString &cacheFile) const;
+
     private:
+      void triangleVertices(int primID, float v0[3], float v1[3], float v2[3]) const;
+
+      /**
+       * Functor for QtConcurrent that traces the rays of a batch through the
+       * scene. Embree scenes can be traced by any number of threads once they
+       * are committed.
+       */
+      class TraceFunctor {
+        public:
+          TraceFunctor(RTCScene scene);
+
+          void operator()(RTCMultiHitRay &ray) const;
+
+        private:
+          RTCScene m_scene; //!< The committed scene to trace
+      };
+
       /**
        * Container for a vertex.
        * 
@@ -228,6 +262,15 @@ namespace Isis {
                                                      the target body and the aabb
                                                      tree used to accelerate ray
                                                      tracing. */
+      QScopedPointer<QFile>          m_meshCache;        /**!< The memory mapped mesh cache
+                                                              file, if the mesh was loaded
+                                                              from one. */
+      const Vertex                  *m_cachedVertices;   /**!< The vertices in the mapped
+                                                              mesh cache file. */
+      const Triangle                *m_cachedTriangles;  /**!< The triangles in the mapped
+                                                              mesh cache file. */
+      int                            m_cachedVertexCount;   //!< Vertices in the mesh cache
+      int                            m_cachedTriangleCount; //!< Triangles in the mesh cache
 
   };
 
@@ -77,6 +77,7 @@ namespace Isis {
       QRadioButton *p_detached;
       QRadioButton *p_tiled;
       QRadioButton *p_bsq;
+      QRadioButton *p_compressed;
       QRadioButton *p_lsb;
       QRadioButton *p_msb;
       bool p_propagationEnabled;
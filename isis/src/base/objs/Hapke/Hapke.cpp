@@ -102,7 +102,7 @@ namespace Isis {
    */
   double Hapke::PhotoModelAlgorithm(double phase, double incidence,
                                        double emission) {
-    static double pht_hapke;
+    double pht_hapke;
     double pharad;  //phase angle in radians
     double incrad;  // incidence angle in radians
     double emarad; // emission angle in radians
@@ -150,18 +150,6 @@ namespace Isis {
     double rr1;
     double rr2;
 
-    static double old_phase = -9999;
-    static double old_incidence = -9999;
-    static double old_emission= -9999;
-
-    if (old_phase == phase && old_incidence == incidence && old_emission == emission) {
-      return pht_hapke;
-    }
-
-    old_phase = phase;
-    old_incidence = incidence;
-    old_emission = emission;
-
     pharad = phase * PI / 180.0;
     incrad = incidence * PI / 180.0;
     emarad = emission * PI / 180.0;
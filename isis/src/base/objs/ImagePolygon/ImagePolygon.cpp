@@ -28,6 +28,8 @@
 #include <vector>
 
 #include <QDebug>
+#include <QThreadPool>
+#include <QtConcurrentMap>
 
 #include <geos/geom/Geometry.h>
 #include <geos/geom/Polygon.h>
@@ -72,11 +74,15 @@ namespace Isis {
     p_subpixelAccuracy = 50; //An accuracte and quick number
 
     p_ellipsoid = false;
+
+    p_threaded = false;
   }
 
 
   //! Destroys the Polygon object
   ImagePolygon::~ImagePolygon() {
+    deleteThreadGroundMaps();
+
     delete p_polygons;
     p_polygons = NULL;
 
@@ -220,6 +226,10 @@ namespace Isis {
 
     cam = initCube(cube, ss, sl, ns, nl, band);
 
+    if (p_threaded) {
+      createThreadGroundMaps(band);
+    }
+
     // Reduce the increment size to find a valid polygon
     bool polygonGenerated = false;
     while (!polygonGenerated) {
@@ -265,6 +275,8 @@ namespace Isis {
     // Create the polygon, fixing if needed
     Fix360Poly();
 
+    deleteThreadGroundMaps();
+
     if (p_brick != 0) delete p_brick;
 
     if (p_gMap->Camera())
@@ -758,11 +770,26 @@ namespace Isis {
     // this vector stores crossing points, where the image crosses the
     // meridian. It stores the first coordinate of the pair in its vector
     vector<geos::geom::Coordinate> *crossingPoints = new vector<geos::geom::Coordinate>;
-    for (unsigned int i = 0; i < points.size(); i++) {
-      geos::geom::Coordinate *temp = &(points.at(i));
-      SetImage(temp->x, temp->y);
-      lon = p_gMap->UniversalLongitude();
-      lat = p_gMap->UniversalLatitude();
+
+    // The ground conversion of each point is independent, so do it up front
+    // (possibly on multiple threads) and look for crossings afterwards
+    vector<geos::geom::Coordinate> lonLats(points.size());
+    if (p_threadGMaps.size() > 1) {
+      QList<BoundaryChunk> chunks = boundaryChunks(0, points.size());
+      runChunks(chunks, BoundaryFunctor(this, BoundaryFunctor::Ground, &points, &lonLats));
+    }
+    else {
+      for (unsigned int i = 0; i < points.size(); i++) {
+        geos::geom::Coordinate *temp = &(points.at(i));
+        SetImage(temp->x, temp->y);
+        lonLats[i] = geos::geom::Coordinate(p_gMap->UniversalLongitude(),
+                                            p_gMap->UniversalLatitude());
+      }
+    }
+
+    for (unsigned int i = 0; i < lonLats.size(); i++) {
+      lon = lonLats[i].x;
+      lat = lonLats[i].y;
       if (abs(lon - prevLon) >= 180 && i != 0) {
         crossingPoints->push_back(geos::geom::Coordinate(prevLon, prevLat));
       }
@@ -1052,21 +1079,40 @@ namespace Isis {
    *              was not or if pixel of level 2 images is NULL.
    */
   bool ImagePolygon::SetImage(const double sample, const double line) {
+    return SetImage(p_gMap, p_brick, sample, line);
+  }
+
+
+  /**
+   * Sets the sample/line values of the cube on the given ground map. This is
+   * the work behind SetImage(sample, line), parameterized so that worker
+   * threads can evaluate points with their own ground map and brick.
+   *
+   * @param gMap The ground map to set the image coordinate on
+   * @param brick A 1x1x1 brick used to read the DN of projected images
+   * @param sample Sample coordinate of the cube
+   * @param line Line coordinate of the cube
+   *
+   * @return bool Returns true if the image was set successfully and false if it
+   *              was not or if pixel of level 2 images is NULL.
+   */
+  bool ImagePolygon::SetImage(UniversalGroundMap *gMap, Brick *brick,
+                              const double sample, const double line) {
     bool found = false;
     if (!p_isProjected) {
-      found = p_gMap->SetImage(sample, line);
+      found = gMap->SetImage(sample, line);
       if (!found) {
         return false;
       }
       else {
         // Check for valid emission and incidence
         try {
-          if (p_gMap->Camera() &&
-             p_gMap->Camera()->EmissionAngle() > p_emission) {
+          if (gMap->Camera() &&
+             gMap->Camera()->EmissionAngle() > p_emission) {
             return false;
           }
-          if (p_gMap->Camera() &&
-             p_gMap->Camera()->IncidenceAngle() > p_incidence) {
+          if (gMap->Camera() &&
+             gMap->Camera()->IncidenceAngle() > p_incidence) {
             return false;
           }
         }
@@ -1085,9 +1131,9 @@ namespace Isis {
         //  This is done because some camera models due to distortion, get
         //  a lat/lon for samp/line=1:1, but entering that lat/lon does
         //  not return samp/line =1:1. Ie.  moc WA global images
-        //double lat = p_gMap->UniversalLatitude();
-        //double lon = p_gMap->UniversalLongitude();
-        //return p_gMap->SetUniversalGround(lat,lon);
+        //double lat = gMap->UniversalLatitude();
+        //double lon = gMap->UniversalLongitude();
+        //return gMap->SetUniversalGround(lat,lon);
 
         return found;
       }
@@ -1095,13 +1141,13 @@ namespace Isis {
     else {
       // If projected, make sure the pixel DN is valid before worrying about
       //  geometry.
-      p_brick->SetBasePosition((int)sample, (int)line, 1);
-      p_cube->read(*p_brick);
-      if (Isis::IsNullPixel((*p_brick)[0])) {
+      brick->SetBasePosition((int)sample, (int)line, 1);
+      p_cube->read(*brick);
+      if (Isis::IsNullPixel((*brick)[0])) {
         return false;
       }
       else {
-        return p_gMap->SetImage(sample, line);
+        return gMap->SetImage(sample, line);
       }
     }
   }
@@ -1540,43 +1586,43 @@ namespace Isis {
    * algorithm depends on a left-hand-turn algorithm and assumes that the vector
    * of Coordinates provided is not empty.
    *
+   * When running threaded, every point except the first is refined
+   * concurrently from the unrefined walk. The first point depends on the
+   * refined second point, so it is done last on this thread just as in the
+   * serial loop.
+   *
    * @param points The vector of Coordinate to set to subpixel accuracy
    */
   void ImagePolygon::FindSubpixel(std::vector<geos::geom::Coordinate> & points) {
     if (p_subpixelAccuracy > 0) {
 
-      // Fix the polygon with subpixel accuracy
-      geos::geom::Coordinate old = points.at(0);
-      bool didStartingPoint = false;
-      for (unsigned int pt = 1; !didStartingPoint; pt ++) {
-        if (pt >= points.size() - 1) {
-          pt = 0;
-          didStartingPoint = true;
-        }
-
-        // Binary Coordinate Search
-        double maxStep = std::max(p_sampinc, p_lineinc);
-        double stepY = (old.x - points.at(pt + 1).x) / maxStep;
-        double stepX = (points.at(pt + 1).y - old.y) / maxStep;
+      if (p_threadGMaps.size() > 1) {
+        std::vector<geos::geom::Coordinate> walked(points);
 
-        geos::geom::Coordinate valid = points.at(pt);
-        geos::geom::Coordinate invalid(valid.x + stepX, valid.y + stepY);
+        QList<BoundaryChunk> chunks = boundaryChunks(1, points.size() - 1);
+        runChunks(chunks, BoundaryFunctor(this, BoundaryFunctor::Subpixel, &walked, &points));
 
-        for (int itt = 0; itt < p_subpixelAccuracy; itt ++) {
-          geos::geom::Coordinate half((valid.x + invalid.x) / 2.0, (valid.y + invalid.y) / 2.0);
-          if (SetImage(half.x, half.y)  &&  InsideImage(half.x, half.y)) {
-            valid = half;
-          }
-          else {
-            invalid = half;
+        points[0] = FindSubpixelPoint(p_gMap, p_brick, walked.at(points.size() - 2),
+                                      walked.at(0), points.at(1));
+      }
+      else {
+        // Fix the polygon with subpixel accuracy
+        geos::geom::Coordinate old = points.at(0);
+        bool didStartingPoint = false;
+        for (unsigned int pt = 1; !didStartingPoint; pt ++) {
+          if (pt >= points.size() - 1) {
+            pt = 0;
+            didStartingPoint = true;
           }
-        }
 
-        old = points.at(pt);
+          geos::geom::Coordinate valid = FindSubpixelPoint(p_gMap, p_brick, old,
+                                                           points.at(pt), points.at(pt + 1));
 
-        // Set new coordinate
-        points[pt] = valid;
+          old = points.at(pt);
 
+          // Set new coordinate
+          points[pt] = valid;
+        }
       }
 
       // Fix starting point
@@ -1586,5 +1632,188 @@ namespace Isis {
   }
 
 
+  /**
+   * Finds the subpixel location of a single walked point with a binary search
+   * outward from the point, perpendicular to the boundary.
+   *
+   * @param gMap The ground map to evaluate points with
+   * @param brick The brick used to check for valid DNs
+   * @param previous The point before this one along the boundary
+   * @param point The walked point to refine
+   * @param next The point after this one along the boundary
+   *
+   * @return geos::geom::Coordinate The last valid coordinate found
+   */
+  geos::geom::Coordinate ImagePolygon::FindSubpixelPoint(UniversalGroundMap *gMap, Brick *brick,
+      const geos::geom::Coordinate &previous,
+      const geos::geom::Coordinate &point,
+      const geos::geom::Coordinate &next) {
+    // Binary Coordinate Search
+    double maxStep = std::max(p_sampinc, p_lineinc);
+    double stepY = (previous.x - next.x) / maxStep;
+    double stepX = (next.y - previous.y) / maxStep;
+
+    geos::geom::Coordinate valid = point;
+    geos::geom::Coordinate invalid(valid.x + stepX, valid.y + stepY);
+
+    for (int itt = 0; itt < p_subpixelAccuracy; itt ++) {
+      geos::geom::Coordinate half((valid.x + invalid.x) / 2.0, (valid.y + invalid.y) / 2.0);
+      if (SetImage(gMap, brick, half.x, half.y)  &&  InsideImage(half.x, half.y)) {
+        valid = half;
+      }
+      else {
+        invalid = half;
+      }
+    }
+
+    return valid;
+  }
+
+
+  /**
+   * Creates one ground map and brick per thread in the global thread pool. The
+   * first entry is always p_gMap/p_brick; the rest are created here, on this
+   * thread, from the cube so that no camera is ever constructed concurrently.
+   *
+   * @param band The band to set on the new ground maps
+   */
+  void ImagePolygon::createThreadGroundMaps(int band) {
+    deleteThreadGroundMaps();
+
+    p_threadGMaps.append(p_gMap);
+    p_threadBricks.append(p_brick);
+
+    // Mirror the limb handling done on p_gMap in initCube
+    bool ellipsoidLimb = p_ellipsoid && IsLimb();
+
+    int threads = QThreadPool::globalInstance()->maxThreadCount();
+    for (int i = 1; i < threads; i++) {
+      UniversalGroundMap *gMap = new UniversalGroundMap(*p_cube);
+      gMap->SetBand(band);
+
+      if (ellipsoidLimb && gMap->Camera()) {
+        gMap->Camera()->IgnoreElevationModel(true);
+      }
+
+      p_threadGMaps.append(gMap);
+      p_threadBricks.append(new Brick(1, 1, 1, p_cube->pixelType()));
+    }
+  }
+
+
+  /**
+   * Deletes the ground maps and bricks created by createThreadGroundMaps().
+   * p_gMap and p_brick are left alone.
+   */
+  void ImagePolygon::deleteThreadGroundMaps() {
+    for (int i = 1; i < p_threadGMaps.size(); i++) {
+      delete p_threadGMaps[i];
+    }
+    for (int i = 1; i < p_threadBricks.size(); i++) {
+      delete p_threadBricks[i];
+    }
+
+    p_threadGMaps.clear();
+    p_threadBricks.clear();
+  }
+
+
+  /**
+   * Splits a range of point indices into one contiguous chunk per thread
+   * ground map.
+   *
+   * @param begin The first point index
+   * @param end One past the last point index
+   *
+   * @return QList<BoundaryChunk> The chunks, in point order
+   */
+  QList<ImagePolygon::BoundaryChunk> ImagePolygon::boundaryChunks(int begin, int end) {
+    QList<BoundaryChunk> chunks;
+
+    int numChunks = p_threadGMaps.size();
+    int count = end - begin;
+    for (int i = 0; i < numChunks; i++) {
+      BoundaryChunk chunk;
+      chunk.gMap = p_threadGMaps[i];
+      chunk.brick = p_threadBricks[i];
+      chunk.begin = begin + (int)((long long)count * i / numChunks);
+      chunk.end = begin + (int)((long long)count * (i + 1) / numChunks);
+      chunk.failed = false;
+
+      if (chunk.end > chunk.begin) {
+        chunks.append(chunk);
+      }
+    }
+
+    return chunks;
+  }
+
+
+  /**
+   * Evaluates all of the chunks on the global thread pool and rethrows the
+   * first error, in point order, on this thread.
+   *
+   * @param chunks The chunks to evaluate
+   * @param functor The work to do for each chunk
+   */
+  void ImagePolygon::runChunks(QList<BoundaryChunk> &chunks, const BoundaryFunctor &functor) {
+    QtConcurrent::blockingMap(chunks, functor);
+
+    foreach (const BoundaryChunk &chunk, chunks) {
+      if (chunk.failed) {
+        throw chunk.error;
+      }
+    }
+  }
+
+
+  /**
+   * Constructs a BoundaryFunctor. Nothing is owned by the functor.
+   *
+   * @param polygon The polygon being created
+   * @param mode The work to do for each point
+   * @param input The walked sample/line points
+   * @param output Where to store the result for each point. Must be the same
+   *               size as input.
+   */
+  ImagePolygon::BoundaryFunctor::BoundaryFunctor(ImagePolygon *polygon, Mode mode,
+      const std::vector<geos::geom::Coordinate> *input,
+      std::vector<geos::geom::Coordinate> *output) {
+    m_polygon = polygon;
+    m_mode = mode;
+    m_input = input;
+    m_output = output;
+  }
+
+
+  /**
+   * Evaluates every point in the chunk with the chunk's ground map. Errors are
+   * stored in the chunk since only QExceptions can cross QtConcurrent.
+   *
+   * @param chunk The points to evaluate
+   */
+  void ImagePolygon::BoundaryFunctor::operator()(BoundaryChunk &chunk) const {
+    try {
+      for (int pt = chunk.begin; pt < chunk.end; pt++) {
+        if (m_mode == Subpixel) {
+          (*m_output)[pt] = m_polygon->FindSubpixelPoint(chunk.gMap, chunk.brick,
+                                                         m_input->at(pt - 1),
+                                                         m_input->at(pt),
+                                                         m_input->at(pt + 1));
+        }
+        else {
+          m_polygon->SetImage(chunk.gMap, chunk.brick, m_input->at(pt).x, m_input->at(pt).y);
+          (*m_output)[pt] = geos::geom::Coordinate(chunk.gMap->UniversalLongitude(),
+                                                   chunk.gMap->UniversalLatitude());
+        }
+      }
+    }
+    catch (IException &e) {
+      chunk.failed = true;
+      chunk.error = e;
+    }
+  }
+
+
 } // end namespace isis
 
@@ -26,6 +26,8 @@
 #include <sstream>
 #include <vector>
 
+#include <QList>
+
 #include "IException.h"
 #include "Cube.h"
 #include "Brick.h"
@@ -162,6 +164,10 @@ namespace Isis {
    *                          periodically due to accessing a vector outside of it's bounds
    *                          (negative indices). This was in the 'triangle' (loop) detection code.
    *                          Fixes #994.
+   *  @history 2026-10-19 Added Threaded() which refines the walked boundary to
+   *                          subpixel accuracy and converts it to lat/lon on
+   *                          the global thread pool. Each worker uses its own
+   *                          UniversalGroundMap created from the cube.
    */
 
   class ImagePolygon : public Isis::Blob {
@@ -217,6 +223,22 @@ namespace Isis {
         p_subpixelAccuracy = div;
       }
 
+      /**
+       * Evaluate the boundary points concurrently. The walk itself is still
+       * serial, but the subpixel search and the lat/lon conversion of the
+       * walked points are split across the global thread pool. Every worker
+       * owns a UniversalGroundMap (and so a Camera or Projection) created from
+       * the cube, so the resulting polygon is the same as the serial one.
+       *
+       * This should only be used on cubes with SPICE attached as tables, as
+       * the per-thread cameras must not load kernels.
+       *
+       * @param threaded True to evaluate the boundary on multiple threads
+       */
+      void Threaded(bool threaded) {
+        p_threaded = threaded;
+      }
+
       //!  Return a geos Multipolygon
       geos::geom::MultiPolygon *Polys() {
         return p_polygons;
@@ -241,9 +263,53 @@ namespace Isis {
       void WriteData(std::fstream &os);
 
     private:
+      /**
+       * A contiguous run of boundary points evaluated by one worker thread.
+       * Each chunk owns a ground map and brick, so no two threads ever share
+       * camera state.
+       */
+      struct BoundaryChunk {
+        UniversalGroundMap *gMap; //!< The ground map used for this chunk
+        Brick *brick;             //!< Used to check for valid DNs
+        int begin;                //!< Index of the first point in the chunk
+        int end;                  //!< Index one past the last point in the chunk
+        bool failed;              //!< True if evaluating the chunk threw
+        IException error;         //!< The error thrown when failed is true
+      };
+
+      /**
+       * Functor passed to QtConcurrent to evaluate the points of one
+       * BoundaryChunk. Depending on the mode, it either refines each walked
+       * point to subpixel accuracy or converts it to lon/lat.
+       */
+      class BoundaryFunctor {
+        public:
+          //! The work done for each point in a chunk
+          enum Mode {
+            Subpixel, //!< Refine the point with FindSubpixelPoint()
+            Ground    //!< Convert the point to a universal lon/lat
+          };
+
+          BoundaryFunctor(ImagePolygon *polygon, Mode mode,
+                          const std::vector<geos::geom::Coordinate> *input,
+                          std::vector<geos::geom::Coordinate> *output);
+
+          void operator()(BoundaryChunk &chunk) const;
+
+        private:
+          ImagePolygon *m_polygon; //!< The polygon being created
+          Mode m_mode;             //!< The work to do for each point
+          //! The walked sample/line points
+          const std::vector<geos::geom::Coordinate> *m_input;
+          //! Where the result for each point is stored
+          std::vector<geos::geom::Coordinate> *m_output;
+      };
+
       // Please do not add new polygon manipulation methods to this class.
       // Polygon manipulation should be done in the PolygonTools class.
       bool SetImage(const double sample, const double line);
+      bool SetImage(UniversalGroundMap *gMap, Brick *brick,
+                    const double sample, const double line);
 
       geos::geom::Coordinate FindFirstPoint();
       void WalkPoly();
@@ -266,6 +332,15 @@ namespace Isis {
                                            geos::geom::Coordinate newPoint);
 
       void FindSubpixel(std::vector<geos::geom::Coordinate> & points);
+      geos::geom::Coordinate FindSubpixelPoint(UniversalGroundMap *gMap, Brick *brick,
+                                               const geos::geom::Coordinate &previous,
+                                               const geos::geom::Coordinate &point,
+                                               const geos::geom::Coordinate &next);
+
+      void createThreadGroundMaps(int band);
+      void deleteThreadGroundMaps();
+      QList<BoundaryChunk> boundaryChunks(int begin, int end);
+      void runChunks(QList<BoundaryChunk> &chunks, const BoundaryFunctor &functor);
 
       void calcImageBorderCoordinates();
 
@@ -301,6 +376,12 @@ namespace Isis {
 
       int p_subpixelAccuracy; //!< The subpixel accuracy to use
 
+      bool p_threaded; //!< Evaluate the boundary points on multiple threads
+      //! Ground maps owned by the worker threads, index 0 is p_gMap
+      QList<UniversalGroundMap *> p_threadGMaps;
+      //! Bricks owned by the worker threads, index 0 is p_brick
+      QList<Brick *> p_threadBricks;
+
   };
 };
 
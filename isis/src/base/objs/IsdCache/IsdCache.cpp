@@ -0,0 +1,180 @@
+/**
+ * @file
+ *
+ *   Unless noted otherwise, the portions of Isis written by the USGS are public
+ *   domain. See individual third-party library and package descriptions for
+ *   intellectual property information,user agreements, and related information.
+ *
+ *   Although Isis has been used by the USGS, no warranty, expressed or implied,
+ *   is made by the USGS as to the accuracy and functioning of such software
+ *   and related material nor shall the fact of distribution constitute any such
+ *   warranty, and no responsibility is assumed by the USGS in connection
+ *   therewith.
+ *
+ *   For additional information, launch
+ *   $ISISROOT/doc//documents/Disclaimers/Disclaimers.html in a browser or see
+ *   the Privacy &amp; Disclaimers page on the Isis website,
+ *   http://isis.astrogeology.usgs.gov, and the USGS privacy and disclaimers on
+ *   http://www.usgs.gov/privacy.html.
+ */
+#include "IsdCache.h"
+
+#include <sstream>
+#include <vector>
+
+#include <QCoreApplication>
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+
+#include "FileName.h"
+#include "Preference.h"
+#include "Pvl.h"
+#include "PvlGroup.h"
+#include "PvlKeyword.h"
+#include "PvlObject.h"
+
+namespace Isis {
+
+  /**
+   * Returns the directory ISDs are cached in, from the IsdCache keyword of
+   * the Performance preferences.
+   *
+   * @return @b QString The expanded cache directory, or an empty string if
+   *                    ISDs are not cached
+   */
+  QString IsdCache::directory() {
+    PvlGroup &performance = Preference::Preferences().findGroup("Performance");
+    if (!performance.hasKeyword("IsdCache")) {
+      return "";
+    }
+
+    QString cachePreference = performance["IsdCache"][0];
+    if (cachePreference.isEmpty() || cachePreference.toLower() == "off") {
+      return "";
+    }
+
+    return FileName(cachePreference).expanded();
+  }
+
+
+  /**
+   * Returns the name of the file the ISD for a label is cached in. The name
+   * includes a hash of the label, so changing the label, for example by
+   * spiceiniting with other kernels, leads to a different cache file. The
+   * size and modification time of every kernel file in the Kernels group are
+   * hashed too, so a kernel that is updated in place also leads to a
+   * different cache file.
+   *
+   * @param directory The cache directory
+   * @param label The label of the cube the ISD is for
+   *
+   * @return @b QString The cache file name
+   */
+  QString IsdCache::cacheFileName(const QString &directory, Pvl &label) {
+    std::ostringstream labelText;
+    labelText << label;
+
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(FileName(label.fileName()).expanded().toUtf8());
+    hash.addData(labelText.str().c_str(), labelText.str().size());
+
+    PvlObject &cube = label.hasObject("IsisCube") ? label.findObject("IsisCube") : label;
+    if (cube.hasGroup("Kernels")) {
+      PvlGroup &kernels = cube.findGroup("Kernels");
+      for (int keyword = 0; keyword < kernels.keywords(); keyword++) {
+        for (int value = 0; value < kernels[keyword].size(); value++) {
+          QFileInfo kernel(FileName(kernels[keyword][value]).expanded());
+          if (kernel.isFile()) {
+            QString stamp = kernel.absoluteFilePath() + "|" + QString::number(kernel.size()) +
+                            "|" + QString::number(kernel.lastModified().toMSecsSinceEpoch());
+            hash.addData(stamp.toUtf8());
+          }
+        }
+      }
+    }
+
+    QString baseName = QFileInfo(label.fileName()).completeBaseName();
+    if (baseName.isEmpty()) {
+      baseName = "isd";
+    }
+
+    return directory + "/" + baseName + "_" + hash.result().toHex().left(16) + ".isd";
+  }
+
+
+  /**
+   * Reads a cached ISD. The file is memory mapped and decoded in place, so
+   * reading it does not copy the file into memory first.
+   *
+   * @param fileName The cache file to read
+   * @param isd The decoded ISD
+   *
+   * @return @b bool False if the file does not exist or can not be decoded
+   */
+  bool IsdCache::read(const QString &fileName, nlohmann::json &isd) {
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly) || file.size() == 0) {
+      return false;
+    }
+
+    uchar *data = file.map(0, file.size());
+    if (!data) {
+      return false;
+    }
+
+    bool decoded = true;
+    try {
+      isd = nlohmann::json::from_cbor(data, data + file.size());
+    }
+    catch (nlohmann::json::exception &) {
+      decoded = false;
+    }
+
+    file.unmap(data);
+    return decoded;
+  }
+
+
+  /**
+   * Writes an ISD to the cache. The ISD is written to a temporary file that
+   * is renamed into place, so other programs never read a partial file.
+   * Failing to write the cache is not an error, it only means the ISD will be
+   * generated again.
+   *
+   * @param fileName The cache file to write
+   * @param isd The ISD to cache
+   *
+   * @return @b bool True if the ISD was cached
+   */
+  bool IsdCache::write(const QString &fileName, const nlohmann::json &isd) {
+    QFileInfo info(fileName);
+    if (!QDir().mkpath(info.absolutePath())) {
+      return false;
+    }
+
+    std::vector<uint8_t> bytes = nlohmann::json::to_cbor(isd);
+
+    QString tempFileName = fileName + "." + QString::number(QCoreApplication::applicationPid());
+    QFile tempFile(tempFileName);
+    if (!tempFile.open(QIODevice::WriteOnly)) {
+      return false;
+    }
+
+    qint64 written = tempFile.write((const char *) bytes.data(), bytes.size());
+    tempFile.close();
+    if (written != (qint64) bytes.size()) {
+      QFile::remove(tempFileName);
+      return false;
+    }
+
+    QFile::remove(fileName);
+    if (!QFile::rename(tempFileName, fileName)) {
+      QFile::remove(tempFileName);
+      return false;
+    }
+    return true;
+  }
+}
@@ -0,0 +1,56 @@
+#ifndef IsdCache_h
+#define IsdCache_h
+/**
+ * @file
+ *
+ *   Unless noted otherwise, the portions of Isis written by the USGS are public
+ *   domain. See individual third-party library and package descriptions for
+ *   intellectual property information,user agreements, and related information.
+ *
+ *   Although Isis has been used by the USGS, no warranty, expressed or implied,
+ *   is made by the USGS as to the accuracy and functioning of such software
+ *   and related material nor shall the fact of distribution constitute any such
+ *   warranty, and no responsibility is assumed by the USGS in connection
+ *   therewith.
+ *
+ *   For additional information, launch
+ *   $ISISROOT/doc//documents/Disclaimers/Disclaimers.html in a browser or see
+ *   the Privacy &amp; Disclaimers page on the Isis website,
+ *   http://isis.astrogeology.usgs.gov, and the USGS privacy and disclaimers on
+ *   http://www.usgs.gov/privacy.html.
+ */
+
+#include <QString>
+
+#include <nlohmann/json.hpp>
+
+namespace Isis {
+  class Pvl;
+
+  /**
+   * A cache of the ISDs ALE generates for cubes, kept on disk in a compact
+   * binary form.
+   *
+   * Generating an ISD with ale::load and parsing the JSON it returns can take
+   * much longer than the rest of camera construction for long observations.
+   * Spice stores each ISD it generates in the directory named by the IsdCache
+   * keyword of the Performance preferences, and reads it back the next time a
+   * camera is created from the same label. Cache files are CBOR encoded and
+   * named after a hash of the label and of the size and modification time of
+   * its kernels, so a label with different kernels or times, or kernels that
+   * changed on disk, gets its own ISD.
+   */
+  class IsdCache {
+    public:
+      static QString directory();
+      static QString cacheFileName(const QString &directory, Pvl &label);
+
+      static bool read(const QString &fileName, nlohmann::json &isd);
+      static bool write(const QString &fileName, const nlohmann::json &isd);
+
+    private:
+      IsdCache();
+  };
+}
+
+#endif
@@ -4,22 +4,10 @@
 namespace Isis {
   double Lambert::PhotoModelAlgorithm(double phase, double incidence,
                                       double emission) {
-    static double pht_lambert;
+    double pht_lambert;
     double incrad;
     double munot;
 
-    static double old_phase = -9999;
-    static double old_incidence = -9999;
-    static double old_emission= -9999;
-
-    if (old_phase == phase && old_incidence == incidence && old_emission == emission) {
-      return pht_lambert;
-    }
-
-    old_phase = phase;
-    old_incidence = incidence;
-    old_emission = emission;
-
     incrad = incidence * Isis::PI / 180.0;
     munot = cos(incrad);
 
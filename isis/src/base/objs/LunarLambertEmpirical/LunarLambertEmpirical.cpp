@@ -212,7 +212,7 @@ namespace Isis {
 
   double LunarLambertEmpirical::PhotoModelAlgorithm(double phase, double incidence,
                                        double emission) {
-    static double pht_lunarlambert_empirical;
+    double pht_lunarlambert_empirical;
     double incrad;
     double emarad;
     double munot;
@@ -220,28 +220,13 @@ namespace Isis {
     double lInterpolated = 0;
     double bInterpolated = 0;
 
-    static double old_phase = -9999;
-    static double old_incidence = -9999;
-    static double old_emission= -9999;
-
-    // Don't need to do anything if the photometric angles are the same as before
-    if (old_phase == phase && old_incidence == incidence && old_emission == emission) {
-      return pht_lunarlambert_empirical;
-    }
-
-    old_incidence = incidence;
-    old_emission = emission;
-
     incrad = incidence * Isis::PI / 180.0;
     emarad = emission * Isis::PI / 180.0;
     munot = cos(incrad);
     mu = cos(emarad);
 
-    if (phase != old_phase) {
-      lInterpolated = p_photoLSpline.Evaluate(phase, NumericalApproximation::Extrapolate);
-      bInterpolated = p_photoBSpline.Evaluate(phase, NumericalApproximation::Extrapolate);
-      old_phase = phase;
-    }
+    lInterpolated = p_photoLSpline.Evaluate(phase, NumericalApproximation::Extrapolate);
+    bInterpolated = p_photoBSpline.Evaluate(phase, NumericalApproximation::Extrapolate);
 
     if(munot <= 0.0 || mu <= 0.0) {
       pht_lunarlambert_empirical = 0.0;
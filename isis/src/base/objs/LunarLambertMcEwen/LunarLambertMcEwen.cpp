@@ -16,24 +16,12 @@ namespace Isis {
 
   double LunarLambertMcEwen::PhotoModelAlgorithm(double phase, double incidence,
       double emission) {
-    static double pht_moonpr;
+    double pht_moonpr;
     double incrad;
     double emarad;
     double munot;
     double mu;
 
-    static double old_phase = -9999;
-    static double old_incidence = -9999;
-    static double old_emission= -9999;
-
-    if (old_phase == phase && old_incidence == incidence && old_emission == emission) {
-      return pht_moonpr;
-    }
-
-    old_phase = phase;
-    old_incidence = incidence;
-    old_emission = emission;
-
     incrad = incidence * Isis::PI / 180.0;
     emarad = emission * Isis::PI / 180.0;
     munot = cos(incrad);
@@ -131,7 +131,7 @@ namespace Isis {
 
   double MinnaertEmpirical::PhotoModelAlgorithm(double phase, double incidence,
                                        double emission) {
-    static double pht_minnaert_empirical;
+    double pht_minnaert_empirical;
     double incrad;
     double emarad;
     double munot;
@@ -139,28 +139,13 @@ namespace Isis {
     double kInterpolated = 0;
     double bInterpolated = 0;
 
-    static double old_phase = -9999;
-    static double old_incidence = -9999;
-    static double old_emission= -9999;
-
-    // Don't need to do anything if the photometric angles are the same as before
-    if (old_phase == phase && old_incidence == incidence && old_emission == emission) {
-      return pht_minnaert_empirical;
-    }
-
-    old_incidence = incidence;
-    old_emission = emission;
-
     incrad = incidence * Isis::PI / 180.0;
     emarad = emission * Isis::PI / 180.0;
     munot = cos(incrad);
     mu = cos(emarad);
 
-    if (phase != old_phase) {
-      kInterpolated = p_photoKSpline.Evaluate(phase, NumericalApproximation::Extrapolate);
-      bInterpolated = p_photoBSpline.Evaluate(phase, NumericalApproximation::Extrapolate);
-      old_phase = phase;
-    }
+    kInterpolated = p_photoKSpline.Evaluate(phase, NumericalApproximation::Extrapolate);
+    bInterpolated = p_photoBSpline.Evaluate(phase, NumericalApproximation::Extrapolate);
 
     if(munot <= 0.0 || mu <= 0.0 || incidence == 90.0 ||
         emission == 90.0) {
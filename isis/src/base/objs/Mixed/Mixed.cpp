@@ -5,6 +5,11 @@
 
 namespace Isis {
   Mixed::Mixed(Pvl &pvl, PhotoModel &pmodel) : NormModel(pvl, pmodel) {
+    p_normOldPhase = -9999;
+    p_normOldIncidence = -9999;
+    p_normOldEmission = -9999;
+    p_normOldDemincidence = -9999;
+    p_normOldDememission = -9999;
     PvlGroup &algorithm = pvl.findObject("NormalizationModel").findGroup("Algorithm", Pvl::Traverse);
 
     // Set default value
@@ -86,41 +91,34 @@ namespace Isis {
   void Mixed::NormModelAlgorithm(double phase, double incidence, double emission,
                                  double demincidence, double dememission, double dn,
                                  double &albedo, double &mult, double &base) {
-    static double psurf;
-    static double pprime;
-    static double aden;
-
-    static double old_phase = -9999;
-    static double old_incidence = -9999;
-    static double old_emission = -9999;
-    static double old_demincidence = -9999;
-    static double old_dememission = -9999;
-
-    if (old_phase != phase || old_incidence != incidence || old_emission != emission ||
-        old_demincidence != demincidence || old_dememission != dememission) {
+    if (p_normOldPhase != phase || p_normOldIncidence != incidence ||
+        p_normOldEmission != emission || p_normOldDemincidence != demincidence ||
+        p_normOldDememission != dememission) {
 
       // code for scaling each pixel
-      psurf = GetPhotoModel()->CalcSurfAlbedo(phase, demincidence, dememission);
-      pprime = GetPhotoModel()->PhtTopder(phase, demincidence, dememission);
-      double arg = pow(psurf, 2.0) + pow(p_psurfmatch * pprime / std::max(1.0e-30, p_pprimematch), 2.0);
-      aden = sqrt(std::max(1.0e-30, arg));
-
-      old_phase = phase;
-      old_incidence = incidence;
-      old_emission = emission;
-      old_demincidence = demincidence;
-      old_dememission = dememission;
+      p_normPsurf = GetPhotoModel()->CalcSurfAlbedo(phase, demincidence, dememission);
+      p_normPprime = GetPhotoModel()->PhtTopder(phase, demincidence, dememission);
+      double arg = pow(p_normPsurf, 2.0) +
+                   pow(p_psurfmatch * p_normPprime / std::max(1.0e-30, p_pprimematch), 2.0);
+      p_normAden = sqrt(std::max(1.0e-30, arg));
+
+      p_normOldPhase = phase;
+      p_normOldIncidence = incidence;
+      p_normOldEmission = emission;
+      p_normOldDemincidence = demincidence;
+      p_normOldDememission = dememission;
     }
 
     // thresh is a parameter limiting how much we amplify the dns
     // shouldn't actually get a large amplification in this mode because
-    // of the growing pprime term in the denominator.
+    // of the growing p_normPprime term in the denominator.
 
-    if(aden > p_anum * p_normThresh) {
+    if(p_normAden > p_anum * p_normThresh) {
       albedo = NULL8;
     }
     else {
-      albedo = dn * p_anum / aden + p_rhobar * (p_psurfref - p_anum / aden * psurf);
+      albedo = dn * p_anum / p_normAden +
+               p_rhobar * (p_psurfref - p_anum / p_normAden * p_normPsurf);
     }
   }
 
@@ -96,6 +96,14 @@ namespace Isis {
       double p_normIncmat;
       double p_normEmamat;
       double p_normAlbedo;
+      double p_normPsurf; //!< The surface brightness at the last geometry
+      double p_normPprime; //!< The topographic derivative at the last geometry
+      double p_normAden; //!< The denominator of the last albedo
+      double p_normOldPhase; //!< The phase angle of the last geometry
+      double p_normOldIncidence; //!< The incidence angle of the last geometry
+      double p_normOldEmission; //!< The emission angle of the last geometry
+      double p_normOldDemincidence; //!< The DEM incidence angle of the last geometry
+      double p_normOldDememission; //!< The DEM emission angle of the last geometry
   };
 };
 
@@ -0,0 +1,791 @@
+/**
+ * @file
+ *
+ *   Unless noted otherwise, the portions of Isis written by the USGS are public
+ *   domain. See individual third-party library and package descriptions for
+ *   intellectual property information,user agreements, and related information.
+ *
+ *   Although Isis has been used by the USGS, no warranty, expressed or implied,
+ *   is made by the USGS as to the accuracy and functioning of such software
+ *   and related material nor shall the fact of distribution constitute any such
+ *   warranty, and no responsibility is assumed by the USGS in connection
+ *   therewith.
+ *
+ *   For additional information, launch
+ *   $ISISROOT/doc//documents/Disclaimers/Disclaimers.html in a browser or see
+ *   the Privacy &amp; Disclaimers page on the Isis website,
+ *   http://isis.astrogeology.usgs.gov, and the USGS privacy and disclaimers on
+ *   http://www.usgs.gov/privacy.html.
+ */
+#include "NaifMath.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include <QString>
+
+#include <SpiceUsr.h>
+
+#include "Constants.h"
+#include "IException.h"
+#include "IString.h"
+#include "NaifStatus.h"
+
+namespace Isis {
+  bool NaifMath::m_auditing = false;
+
+  //! Relative difference allowed between CSPICE and the matrix and rotation math
+  static const double RotationTolerance = 1.0e-12;
+
+  //! Relative difference allowed between CSPICE and the ellipsoid math
+  static const double SurfaceTolerance = 1.0e-9;
+
+
+  /**
+   * Turns checking every result against CSPICE on or off. This should only be
+   * changed while no other threads are using NaifMath.
+   *
+   * @param audit True to check results against CSPICE
+   */
+  void NaifMath::setAuditing(bool audit) {
+    m_auditing = audit;
+  }
+
+
+  /**
+   * Returns whether results are checked against CSPICE.
+   *
+   * @return @b bool True if results are checked against CSPICE
+   */
+  bool NaifMath::isAuditing() {
+    return m_auditing;
+  }
+
+
+  /**
+   * Multiplies two 3x3 matrices, the same as mxm_c. The output may be one of
+   * the inputs.
+   *
+   * @param m1 The left matrix
+   * @param m2 The right matrix
+   * @param mout The product m1 * m2
+   */
+  void NaifMath::mxm(const double m1[3][3], const double m2[3][3], double mout[3][3]) {
+    double product[3][3];
+    for (int i = 0; i < 3; i++) {
+      for (int j = 0; j < 3; j++) {
+        product[i][j] = m1[i][0] * m2[0][j] + m1[i][1] * m2[1][j] + m1[i][2] * m2[2][j];
+      }
+    }
+
+    if (m_auditing) {
+      double expected[3][3];
+      mxm_c(m1, m2, expected);
+      audit("mxm", expected[0], product[0], 9, RotationTolerance);
+    }
+
+    memcpy(mout, product, sizeof(product));
+  }
+
+
+  /**
+   * Multiplies a 3x3 matrix by the transpose of another, the same as mxmt_c.
+   * The output may be one of the inputs.
+   *
+   * @param m1 The left matrix
+   * @param m2 The matrix whose transpose is on the right
+   * @param mout The product m1 * transpose(m2)
+   */
+  void NaifMath::mxmt(const double m1[3][3], const double m2[3][3], double mout[3][3]) {
+    double product[3][3];
+    for (int i = 0; i < 3; i++) {
+      for (int j = 0; j < 3; j++) {
+        product[i][j] = m1[i][0] * m2[j][0] + m1[i][1] * m2[j][1] + m1[i][2] * m2[j][2];
+      }
+    }
+
+    if (m_auditing) {
+      double expected[3][3];
+      mxmt_c(m1, m2, expected);
+      audit("mxmt", expected[0], product[0], 9, RotationTolerance);
+    }
+
+    memcpy(mout, product, sizeof(product));
+  }
+
+
+  /**
+   * Multiplies the transpose of a 3x3 matrix by another, the same as mtxm_c.
+   * The output may be one of the inputs.
+   *
+   * @param m1 The matrix whose transpose is on the left
+   * @param m2 The right matrix
+   * @param mout The product transpose(m1) * m2
+   */
+  void NaifMath::mtxm(const double m1[3][3], const double m2[3][3], double mout[3][3]) {
+    double product[3][3];
+    for (int i = 0; i < 3; i++) {
+      for (int j = 0; j < 3; j++) {
+        product[i][j] = m1[0][i] * m2[0][j] + m1[1][i] * m2[1][j] + m1[2][i] * m2[2][j];
+      }
+    }
+
+    if (m_auditing) {
+      double expected[3][3];
+      mtxm_c(m1, m2, expected);
+      audit("mtxm", expected[0], product[0], 9, RotationTolerance);
+    }
+
+    memcpy(mout, product, sizeof(product));
+  }
+
+
+  /**
+   * Multiplies a 3x3 matrix by a vector, the same as mxv_c. The output may be
+   * the input vector.
+   *
+   * @param m The matrix
+   * @param v The vector
+   * @param vout The product m * v
+   */
+  void NaifMath::mxv(const double m[3][3], const double v[3], double vout[3]) {
+    double product[3];
+    for (int i = 0; i < 3; i++) {
+      product[i] = m[i][0] * v[0] + m[i][1] * v[1] + m[i][2] * v[2];
+    }
+
+    if (m_auditing) {
+      double expected[3];
+      mxv_c(m, v, expected);
+      audit("mxv", expected, product, 3, RotationTolerance);
+    }
+
+    memcpy(vout, product, sizeof(product));
+  }
+
+
+  /**
+   * Multiplies the transpose of a 3x3 matrix by a vector, the same as mtxv_c.
+   * The output may be the input vector.
+   *
+   * @param m The matrix
+   * @param v The vector
+   * @param vout The product transpose(m) * v
+   */
+  void NaifMath::mtxv(const double m[3][3], const double v[3], double vout[3]) {
+    double product[3];
+    for (int i = 0; i < 3; i++) {
+      product[i] = m[0][i] * v[0] + m[1][i] * v[1] + m[2][i] * v[2];
+    }
+
+    if (m_auditing) {
+      double expected[3];
+      mtxv_c(m, v, expected);
+      audit("mtxv", expected, product, 3, RotationTolerance);
+    }
+
+    memcpy(vout, product, sizeof(product));
+  }
+
+
+  /**
+   * Transposes a 3x3 matrix, the same as xpose_c. The output may be the input.
+   *
+   * @param m The matrix
+   * @param mout The transpose of m
+   */
+  void NaifMath::xpose(const double m[3][3], double mout[3][3]) {
+    double transpose[3][3];
+    for (int i = 0; i < 3; i++) {
+      for (int j = 0; j < 3; j++) {
+        transpose[i][j] = m[j][i];
+      }
+    }
+    memcpy(mout, transpose, sizeof(transpose));
+  }
+
+
+  /**
+   * Returns the magnitude of a vector, the same as vnorm_c. The vector is
+   * scaled by its largest component first so the squares cannot overflow.
+   *
+   * @param v The vector
+   *
+   * @return @b double The magnitude of v
+   */
+  double NaifMath::vnorm(const double v[3]) {
+    double largest = std::max(fabs(v[0]), std::max(fabs(v[1]), fabs(v[2])));
+    if (largest == 0.0) {
+      return 0.0;
+    }
+
+    double x = v[0] / largest;
+    double y = v[1] / largest;
+    double z = v[2] / largest;
+    return largest * sqrt(x * x + y * y + z * z);
+  }
+
+
+  /**
+   * Subtracts one vector from another, the same as vsub_c. The output may be
+   * one of the inputs.
+   *
+   * @param v1 The vector to subtract from
+   * @param v2 The vector to subtract
+   * @param vout The difference v1 - v2
+   */
+  void NaifMath::vsub(const double v1[3], const double v2[3], double vout[3]) {
+    vout[0] = v1[0] - v2[0];
+    vout[1] = v1[1] - v2[1];
+    vout[2] = v1[2] - v2[2];
+  }
+
+
+  /**
+   * Scales a vector to unit length and returns its original magnitude, the
+   * same as unorm_c. The zero vector is left as the zero vector. The output
+   * may be the input.
+   *
+   * @param v The vector
+   * @param vout The unit vector in the direction of v
+   * @param vmag The magnitude of v
+   */
+  void NaifMath::unorm(const double v[3], double vout[3], double &vmag) {
+    // vout[0..2] and vmag, so the result can be audited as one array
+    double result[4] = {0.0, 0.0, 0.0, vnorm(v)};
+    if (result[3] > 0.0) {
+      result[0] = v[0] / result[3];
+      result[1] = v[1] / result[3];
+      result[2] = v[2] / result[3];
+    }
+
+    if (m_auditing) {
+      double expected[4];
+      unorm_c(v, expected, &expected[3]);
+      audit("unorm", expected, result, 4, RotationTolerance);
+    }
+
+    memcpy(vout, result, 3 * sizeof(double));
+    vmag = result[3];
+  }
+
+
+  /**
+   * Finds the unit vector along the cross product of two vectors, the same as
+   * ucrss_c. The inputs are scaled first so the products cannot overflow, and
+   * parallel vectors give the zero vector. The output may be one of the
+   * inputs.
+   *
+   * @param v1 The left vector
+   * @param v2 The right vector
+   * @param vout The unit vector along v1 x v2
+   */
+  void NaifMath::ucrss(const double v1[3], const double v2[3], double vout[3]) {
+    double largest1 = std::max(fabs(v1[0]), std::max(fabs(v1[1]), fabs(v1[2])));
+    double largest2 = std::max(fabs(v2[0]), std::max(fabs(v2[1]), fabs(v2[2])));
+    double scaled1[3] = {0.0, 0.0, 0.0};
+    double scaled2[3] = {0.0, 0.0, 0.0};
+    for (int i = 0; i < 3; i++) {
+      if (largest1 != 0.0) {
+        scaled1[i] = v1[i] / largest1;
+      }
+      if (largest2 != 0.0) {
+        scaled2[i] = v2[i] / largest2;
+      }
+    }
+
+    double cross[3] = {scaled1[1] * scaled2[2] - scaled1[2] * scaled2[1],
+                       scaled1[2] * scaled2[0] - scaled1[0] * scaled2[2],
+                       scaled1[0] * scaled2[1] - scaled1[1] * scaled2[0]};
+    double length = vnorm(cross);
+    if (length > 0.0) {
+      cross[0] /= length;
+      cross[1] /= length;
+      cross[2] /= length;
+    }
+    else {
+      cross[0] = 0.0;
+      cross[1] = 0.0;
+      cross[2] = 0.0;
+    }
+
+    if (m_auditing) {
+      double expected[3];
+      ucrss_c(v1, v2, expected);
+      audit("ucrss", expected, cross, 3, RotationTolerance);
+    }
+
+    memcpy(vout, cross, sizeof(cross));
+  }
+
+
+  /**
+   * Returns the angle between two vectors, the same as vsep_c. The angle is
+   * found from the chord between the unit vectors, which keeps its precision
+   * for nearly parallel vectors. If either vector is zero the angle is 0.
+   *
+   * @param v1 The first vector
+   * @param v2 The second vector
+   *
+   * @return @b double The angle between v1 and v2 in radians, from 0 to pi
+   */
+  double NaifMath::vsep(const double v1[3], const double v2[3]) {
+    double u1[3];
+    double u2[3];
+    double length1;
+    double length2;
+    unorm(v1, u1, length1);
+    unorm(v2, u2, length2);
+
+    double separation;
+    double dot = u1[0] * u2[0] + u1[1] * u2[1] + u1[2] * u2[2];
+    if (length1 == 0.0 || length2 == 0.0) {
+      separation = 0.0;
+    }
+    else if (dot > 0.0) {
+      double chord[3] = {u1[0] - u2[0], u1[1] - u2[1], u1[2] - u2[2]};
+      separation = 2.0 * asin(0.5 * vnorm(chord));
+    }
+    else if (dot < 0.0) {
+      double chord[3] = {u1[0] + u2[0], u1[1] + u2[1], u1[2] + u2[2]};
+      separation = PI - 2.0 * asin(0.5 * vnorm(chord));
+    }
+    else {
+      separation = HALFPI;
+    }
+
+    if (m_auditing) {
+      double expected = vsep_c(v1, v2);
+      audit("vsep", &expected, &separation, 1, RotationTolerance);
+    }
+
+    return separation;
+  }
+
+
+  /**
+   * Converts rectangular coordinates to latitudinal coordinates, the same as
+   * reclat_c. Points on the z axis get a longitude of 0.
+   *
+   * @param rectan The rectangular coordinates
+   * @param radius The distance from the origin
+   * @param longitude The longitude in radians, from -pi to pi
+   * @param latitude The latitude in radians, from -pi/2 to pi/2
+   */
+  void NaifMath::reclat(const double rectan[3], double &radius, double &longitude,
+                        double &latitude) {
+    // radius, longitude and latitude, so the result can be audited as one array
+    double result[3] = {0.0, 0.0, 0.0};
+    double largest = std::max(fabs(rectan[0]), std::max(fabs(rectan[1]), fabs(rectan[2])));
+    if (largest > 0.0) {
+      double x = rectan[0] / largest;
+      double y = rectan[1] / largest;
+      double z = rectan[2] / largest;
+      result[0] = largest * sqrt(x * x + y * y + z * z);
+      result[2] = atan2(z, sqrt(x * x + y * y));
+      if (rectan[0] != 0.0 || rectan[1] != 0.0) {
+        result[1] = atan2(rectan[1], rectan[0]);
+      }
+    }
+
+    if (m_auditing) {
+      double expected[3];
+      reclat_c(rectan, &expected[0], &expected[1], &expected[2]);
+      audit("reclat", expected, result, 3, RotationTolerance);
+    }
+
+    radius = result[0];
+    longitude = result[1];
+    latitude = result[2];
+  }
+
+
+  /**
+   * Converts latitudinal coordinates to rectangular coordinates, the same as
+   * latrec_c.
+   *
+   * @param radius The distance from the origin
+   * @param longitude The longitude in radians
+   * @param latitude The latitude in radians
+   * @param rectan The rectangular coordinates
+   */
+  void NaifMath::latrec(double radius, double longitude, double latitude, double rectan[3]) {
+    double result[3] = {radius * cos(longitude) * cos(latitude),
+                        radius * sin(longitude) * cos(latitude),
+                        radius * sin(latitude)};
+
+    if (m_auditing) {
+      double expected[3];
+      latrec_c(radius, longitude, latitude, expected);
+      audit("latrec", expected, result, 3, RotationTolerance);
+    }
+
+    memcpy(rectan, result, sizeof(result));
+  }
+
+
+  /**
+   * Converts a SPICE style quaternion to a rotation matrix, the same as q2m_c.
+   * Quaternions that are not unit length are scaled to unit length.
+   *
+   * @param q The quaternion, with the scalar part first
+   * @param r The rotation matrix
+   */
+  void NaifMath::q2m(const double q[4], double r[3][3]) {
+    double q01 = q[0] * q[1];
+    double q02 = q[0] * q[2];
+    double q03 = q[0] * q[3];
+    double q12 = q[1] * q[2];
+    double q13 = q[1] * q[3];
+    double q23 = q[2] * q[3];
+    double q1s = q[1] * q[1];
+    double q2s = q[2] * q[2];
+    double q3s = q[3] * q[3];
+
+    // Normalize the products the same way CSPICE does instead of the quaternion
+    double l2 = q[0] * q[0] + q1s + q2s + q3s;
+    if (l2 != 1.0 && l2 != 0.0) {
+      double sharpen = 1.0 / l2;
+      q01 *= sharpen;
+      q02 *= sharpen;
+      q03 *= sharpen;
+      q12 *= sharpen;
+      q13 *= sharpen;
+      q23 *= sharpen;
+      q1s *= sharpen;
+      q2s *= sharpen;
+      q3s *= sharpen;
+    }
+
+    double rotation[3][3];
+    rotation[0][0] = 1.0 - 2.0 * (q2s + q3s);
+    rotation[0][1] = 2.0 * (q12 - q03);
+    rotation[0][2] = 2.0 * (q13 + q02);
+    rotation[1][0] = 2.0 * (q12 + q03);
+    rotation[1][1] = 1.0 - 2.0 * (q1s + q3s);
+    rotation[1][2] = 2.0 * (q23 - q01);
+    rotation[2][0] = 2.0 * (q13 - q02);
+    rotation[2][1] = 2.0 * (q23 + q01);
+    rotation[2][2] = 1.0 - 2.0 * (q1s + q2s);
+
+    if (m_auditing) {
+      double expected[3][3];
+      q2m_c(q, expected);
+      audit("q2m", expected[0], rotation[0], 9, RotationTolerance);
+    }
+
+    memcpy(r, rotation, sizeof(rotation));
+  }
+
+
+  /**
+   * Converts a rotation matrix to a SPICE style quaternion, the same as m2q_c.
+   * The scalar part of the quaternion is never negative. Unlike m2q_c, the
+   * matrix is not checked to be a rotation.
+   *
+   * @param r The rotation matrix
+   * @param q The quaternion, with the scalar part first
+   */
+  void NaifMath::m2q(const double r[3][3], double q[4]) {
+    double trace = r[0][0] + r[1][1] + r[2][2];
+    double mtrace = 1.0 - trace;
+
+    double cc4 = 1.0 + trace;
+    double s114 = mtrace + 2.0 * r[0][0];
+    double s224 = mtrace + 2.0 * r[1][1];
+    double s334 = mtrace + 2.0 * r[2][2];
+
+    // Take the square root of the largest of the four squared components,
+    //   which is at least 1/4, and find the others from the off diagonal terms
+    double c, s1, s2, s3;
+    if (cc4 >= 1.0) {
+      c = sqrt(cc4 * 0.25);
+      double factor = 1.0 / (c * 4.0);
+      s1 = (r[2][1] - r[1][2]) * factor;
+      s2 = (r[0][2] - r[2][0]) * factor;
+      s3 = (r[1][0] - r[0][1]) * factor;
+    }
+    else if (s114 >= 1.0) {
+      s1 = sqrt(s114 * 0.25);
+      double factor = 1.0 / (s1 * 4.0);
+      c = (r[2][1] - r[1][2]) * factor;
+      s2 = (r[0][1] + r[1][0]) * factor;
+      s3 = (r[0][2] + r[2][0]) * factor;
+    }
+    else if (s224 >= 1.0) {
+      s2 = sqrt(s224 * 0.25);
+      double factor = 1.0 / (s2 * 4.0);
+      c = (r[0][2] - r[2][0]) * factor;
+      s1 = (r[0][1] + r[1][0]) * factor;
+      s3 = (r[1][2] + r[2][1]) * factor;
+    }
+    else {
+      s3 = sqrt(s334 * 0.25);
+      double factor = 1.0 / (s3 * 4.0);
+      c = (r[1][0] - r[0][1]) * factor;
+      s1 = (r[0][2] + r[2][0]) * factor;
+      s2 = (r[1][2] + r[2][1]) * factor;
+    }
+
+    if (c < 0.0) {
+      c = -c;
+      s1 = -s1;
+      s2 = -s2;
+      s3 = -s3;
+    }
+
+    double quaternion[4] = {c, s1, s2, s3};
+
+    if (m_auditing) {
+      double expected[4];
+      m2q_c(r, expected);
+      NaifStatus::CheckErrors();
+      audit("m2q", expected, quaternion, 4, RotationTolerance);
+    }
+
+    memcpy(q, quaternion, sizeof(quaternion));
+  }
+
+
+  /**
+   * Creates the matrix that rotates vectors by an angle about an axis, the
+   * same as axisar_c. A zero axis gives the identity matrix.
+   *
+   * @param axis The rotation axis, which does not need to be unit length
+   * @param angle The rotation angle in radians
+   * @param r The rotation matrix
+   */
+  void NaifMath::axisar(const double axis[3], double angle, double r[3][3]) {
+    double q[4] = {cos(angle / 2.0), 0.0, 0.0, 0.0};
+    double length = vnorm(axis);
+    if (length > 0.0) {
+      double scale = sin(angle / 2.0) / length;
+      q[1] = axis[0] * scale;
+      q[2] = axis[1] * scale;
+      q[3] = axis[2] * scale;
+    }
+
+    double rotation[3][3];
+    q2m(q, rotation);
+
+    if (m_auditing) {
+      double expected[3][3];
+      axisar_c(axis, angle, expected);
+      NaifStatus::CheckErrors();
+      audit("axisar", expected[0], rotation[0], 9, RotationTolerance);
+    }
+
+    memcpy(r, rotation, sizeof(rotation));
+  }
+
+
+  /**
+   * Finds the axis and angle of a rotation matrix, the same as raxisa_c. The
+   * angle is between 0 and pi, and the identity gives the z axis with an
+   * angle of 0.
+   *
+   * @param r The rotation matrix
+   * @param axis The unit rotation axis
+   * @param angle The rotation angle in radians
+   */
+  void NaifMath::raxisa(const double r[3][3], double axis[3], double &angle) {
+    double q[4];
+    m2q(r, q);
+
+    // axis[0..2] and angle, so the result can be audited as one array
+    double result[4];
+    double length = vnorm(&q[1]);
+    if (length == 0.0) {
+      result[0] = 0.0;
+      result[1] = 0.0;
+      result[2] = 1.0;
+      result[3] = 0.0;
+    }
+    else if (q[0] == 0.0) {
+      result[0] = q[1];
+      result[1] = q[2];
+      result[2] = q[3];
+      result[3] = PI;
+    }
+    else {
+      result[0] = q[1] / length;
+      result[1] = q[2] / length;
+      result[2] = q[3] / length;
+      result[3] = 2.0 * atan2(length, q[0]);
+    }
+
+    if (m_auditing) {
+      double expected[4];
+      raxisa_c(r, expected, &expected[3]);
+      NaifStatus::CheckErrors();
+      audit("raxisa", expected, result, 4, RotationTolerance);
+    }
+
+    memcpy(axis, result, 3 * sizeof(double));
+    angle = result[3];
+  }
+
+
+  /**
+   * Finds where a ray from an observer first meets the surface of an
+   * ellipsoid, the same as surfpt_c. If the observer is inside the ellipsoid,
+   * this is where the ray leaves it.
+   *
+   * @param positn The observer position in the body fixed frame
+   * @param u The direction of the ray, which does not need to be unit length
+   * @param a The radius of the ellipsoid along the x axis
+   * @param b The radius of the ellipsoid along the y axis
+   * @param c The radius of the ellipsoid along the z axis
+   * @param point The intersection, if there is one
+   *
+   * @return @b bool True if the ray meets the ellipsoid
+   */
+  bool NaifMath::surfpt(const double positn[3], const double u[3],
+                        double a, double b, double c, double point[3]) {
+    if (a <= 0.0 || b <= 0.0 || c <= 0.0) {
+      QString msg = "The ellipsoid radii [" + toString(a) + ", " + toString(b) + ", " +
+                    toString(c) + "] must be positive";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    // Scale the problem to the intersection of a line and the unit sphere
+    double x[3] = {positn[0] / a, positn[1] / b, positn[2] / c};
+    double y[3] = {u[0] / a, u[1] / b, u[2] / c};
+    double yLength = vnorm(y);
+    if (yLength == 0.0) {
+      QString msg = "The ray direction must not be the zero vector";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+    y[0] /= yLength;
+    y[1] /= yLength;
+    y[2] /= yLength;
+
+    // The point on the line closest to the center of the sphere
+    double xDotY = x[0] * y[0] + x[1] * y[1] + x[2] * y[2];
+    double perpendicular[3] = {x[0] - xDotY * y[0], x[1] - xDotY * y[1], x[2] - xDotY * y[2]};
+    double perpendicularSquared = perpendicular[0] * perpendicular[0] +
+                                  perpendicular[1] * perpendicular[1] +
+                                  perpendicular[2] * perpendicular[2];
+    double xSquared = x[0] * x[0] + x[1] * x[1] + x[2] * x[2];
+
+    bool found = true;
+    double scaled[3];
+    if (perpendicularSquared > 1.0) {
+      found = false;
+    }
+    else if (xSquared > 1.0) {
+      // Outside the ellipsoid the ray has to point toward it
+      if (xDotY > 0.0) {
+        found = false;
+      }
+      else {
+        double halfChord = sqrt(1.0 - perpendicularSquared);
+        for (int i = 0; i < 3; i++) {
+          scaled[i] = perpendicular[i] - halfChord * y[i];
+        }
+      }
+    }
+    else if (xSquared == 1.0) {
+      memcpy(scaled, x, sizeof(scaled));
+    }
+    else {
+      double halfChord = sqrt(1.0 - perpendicularSquared);
+      for (int i = 0; i < 3; i++) {
+        scaled[i] = perpendicular[i] + halfChord * y[i];
+      }
+    }
+
+    // found, x, y and z, so the result can be audited as one array
+    double result[4] = {found ? 1.0 : 0.0, 0.0, 0.0, 0.0};
+    if (found) {
+      result[1] = scaled[0] * a;
+      result[2] = scaled[1] * b;
+      result[3] = scaled[2] * c;
+    }
+
+    if (m_auditing) {
+      double expected[4] = {0.0, 0.0, 0.0, 0.0};
+      SpiceBoolean expectedFound = SPICEFALSE;
+      surfpt_c(positn, u, a, b, c, &expected[1], &expectedFound);
+      NaifStatus::CheckErrors();
+      expected[0] = expectedFound ? 1.0 : 0.0;
+      if (!expectedFound) {
+        expected[1] = expected[2] = expected[3] = 0.0;
+      }
+      audit("surfpt", expected, result, 4, SurfaceTolerance);
+    }
+
+    if (found) {
+      memcpy(point, &result[1], 3 * sizeof(double));
+    }
+    return found;
+  }
+
+
+  /**
+   * Finds the outward unit normal of an ellipsoid at a point on its surface,
+   * the same as surfnm_c.
+   *
+   * @param a The radius of the ellipsoid along the x axis
+   * @param b The radius of the ellipsoid along the y axis
+   * @param c The radius of the ellipsoid along the z axis
+   * @param point A point on the surface of the ellipsoid
+   * @param normal The unit normal at point
+   */
+  void NaifMath::surfnm(double a, double b, double c, const double point[3],
+                        double normal[3]) {
+    if (a <= 0.0 || b <= 0.0 || c <= 0.0) {
+      QString msg = "The ellipsoid radii [" + toString(a) + ", " + toString(b) + ", " +
+                    toString(c) + "] must be positive";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    // Scale by the smallest radius so the squares stay near 1
+    double smallest = std::min(a, std::min(b, c));
+    double a1 = smallest / a;
+    double b1 = smallest / b;
+    double c1 = smallest / c;
+
+    double result[3] = {point[0] * a1 * a1, point[1] * b1 * b1, point[2] * c1 * c1};
+    double length = vnorm(result);
+    if (length > 0.0) {
+      result[0] /= length;
+      result[1] /= length;
+      result[2] /= length;
+    }
+
+    if (m_auditing) {
+      double expected[3];
+      surfnm_c(a, b, c, point, expected);
+      NaifStatus::CheckErrors();
+      audit("surfnm", expected, result, 3, RotationTolerance);
+    }
+
+    memcpy(normal, result, sizeof(result));
+  }
+
+
+  /**
+   * Throws an exception if a result differs from the CSPICE result by more
+   * than the tolerance, relative to the size of the CSPICE value.
+   *
+   * @param routine The name of the routine being audited
+   * @param expected The CSPICE result
+   * @param actual The NaifMath result
+   * @param size The number of values in the results
+   * @param tolerance The relative difference allowed
+   */
+  void NaifMath::audit(const QString &routine, const double *expected,
+                       const double *actual, int size, double tolerance) {
+    for (int i = 0; i < size; i++) {
+      double difference = fabs(expected[i] - actual[i]);
+      if (difference > tolerance * std::max(1.0, fabs(expected[i]))) {
+        QString msg = "NaifMath::" + routine + " value [" + toString(i) + "] is [" +
+                      toString(actual[i]) + "], but " + routine + "_c returned [" +
+                      toString(expected[i]) + "]";
+        throw IException(IException::Programmer, msg, _FILEINFO_);
+      }
+    }
+  }
+}
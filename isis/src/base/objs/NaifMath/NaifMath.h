@@ -0,0 +1,89 @@
+#ifndef NaifMath_h
+#define NaifMath_h
+/**
+ * @file
+ *
+ *   Unless noted otherwise, the portions of Isis written by the USGS are public
+ *   domain. See individual third-party library and package descriptions for
+ *   intellectual property information,user agreements, and related information.
+ *
+ *   Although Isis has been used by the USGS, no warranty, expressed or implied,
+ *   is made by the USGS as to the accuracy and functioning of such software
+ *   and related material nor shall the fact of distribution constitute any such
+ *   warranty, and no responsibility is assumed by the USGS in connection
+ *   therewith.
+ *
+ *   For additional information, launch
+ *   $ISISROOT/doc//documents/Disclaimers/Disclaimers.html in a browser or see
+ *   the Privacy &amp; Disclaimers page on the Isis website,
+ *   http://isis.astrogeology.usgs.gov, and the USGS privacy and disclaimers on
+ *   http://www.usgs.gov/privacy.html.
+ */
+
+class QString;
+
+namespace Isis {
+  /**
+   * @brief Reentrant versions of the NAIF math routines used by cameras
+   *
+   * Every CSPICE call shares the toolkit's global error state, which is why
+   * SPICE calls are wrapped in NaifStatus::CheckErrors and cannot be made from
+   * more than one thread. These methods follow the CSPICE routines of the same
+   * name, so call sites only drop the _c suffix, and they have no state, so
+   * they can be called from any number of threads.
+   *
+   * Once a camera's rotations and positions are cached, setting a time and
+   * mapping between image and ground only go through these methods. Other
+   * camera values still call CSPICE directly, including the right ascension
+   * and declination, the azimuths from Camera::ComputeAzimuth, and anything
+   * read from kernels that are not cached, so a camera is still not safe to
+   * share between threads.
+   *
+   * When auditing is turned on, every call is repeated with CSPICE and an
+   * exception is thrown if the results differ by more than round off. Auditing
+   * goes through the NAIF error system, so it must only be used from one
+   * thread.
+   */
+  class NaifMath {
+    public:
+      static void setAuditing(bool audit);
+      static bool isAuditing();
+
+      static void mxm(const double m1[3][3], const double m2[3][3], double mout[3][3]);
+      static void mxmt(const double m1[3][3], const double m2[3][3], double mout[3][3]);
+      static void mtxm(const double m1[3][3], const double m2[3][3], double mout[3][3]);
+      static void mxv(const double m[3][3], const double v[3], double vout[3]);
+      static void mtxv(const double m[3][3], const double v[3], double vout[3]);
+      static void xpose(const double m[3][3], double mout[3][3]);
+
+      static double vnorm(const double v[3]);
+      static void vsub(const double v1[3], const double v2[3], double vout[3]);
+      static void unorm(const double v[3], double vout[3], double &vmag);
+      static void ucrss(const double v1[3], const double v2[3], double vout[3]);
+      static double vsep(const double v1[3], const double v2[3]);
+
+      static void reclat(const double rectan[3], double &radius, double &longitude,
+                         double &latitude);
+      static void latrec(double radius, double longitude, double latitude, double rectan[3]);
+
+      static void q2m(const double q[4], double r[3][3]);
+      static void m2q(const double r[3][3], double q[4]);
+      static void axisar(const double axis[3], double angle, double r[3][3]);
+      static void raxisa(const double r[3][3], double axis[3], double &angle);
+
+      static bool surfpt(const double positn[3], const double u[3],
+                         double a, double b, double c, double point[3]);
+      static void surfnm(double a, double b, double c, const double point[3],
+                         double normal[3]);
+
+    private:
+      NaifMath();
+
+      static void audit(const QString &routine, const double *expected,
+                        const double *actual, int size, double tolerance);
+
+      static bool m_auditing; //!< Whether results are checked against CSPICE
+  };
+}
+
+#endif
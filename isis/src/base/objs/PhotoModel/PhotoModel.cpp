@@ -1,6 +1,7 @@
 #include <cmath>
 #include "FileName.h"
 #include "PhotoModel.h"
+#include "PhotometricTable.h"
 #include "Plugin.h"
 #include "Pvl.h"
 #include "IException.h"
@@ -35,6 +36,10 @@ namespace Isis {
     }
 
     p_standardConditions = false;
+    p_photoOldPhase = -9999;
+    p_photoOldIncidence = -9999;
+    p_photoOldEmission = -9999;
+    p_photoOldAlbedo = 0.0;
   }
 
   /**
@@ -43,6 +48,7 @@ namespace Isis {
    */
   void PhotoModel::SetStandardConditions(bool standard) {
     p_standardConditions = standard;
+    p_photoOldPhase = -9999;
   }
 
   /**
@@ -122,8 +128,12 @@ namespace Isis {
     cema = max(-1.0, min(-xy * ye + z * ze, 1.0));
     ema4 = PhtAcos(cema) * (180.0 / Isis::PI);
 
-    d1 = (CalcSurfAlbedo(phase, inc1, ema1) - CalcSurfAlbedo(phase, inc2, ema2)) / eps;
-    d2 = (CalcSurfAlbedo(phase, inc3, ema3) - CalcSurfAlbedo(phase, inc4, ema4)) / eps;
+    // The steps are far smaller than the spacing of a table, so the photometric
+    // function is evaluated directly rather than through CalcSurfAlbedo
+    d1 = (PhotoModelAlgorithm(phase, inc1, ema1) -
+          PhotoModelAlgorithm(phase, inc2, ema2)) / eps;
+    d2 = (PhotoModelAlgorithm(phase, inc3, ema3) -
+          PhotoModelAlgorithm(phase, inc4, ema4)) / eps;
 
     //  Combine these two derivatives and return the gradient
     result = sqrt(max(1.0e-30, d1 * d1 + d2 * d2));
@@ -177,11 +187,63 @@ namespace Isis {
     //  throw iException::Message(iException::Programmer,msg,_FILEINFO_);
     //}
 
+    if (pha == p_photoOldPhase && inc == p_photoOldIncidence && ema == p_photoOldEmission) {
+      return p_photoOldAlbedo;
+    }
+
     // Apply photometric function
-    double albedo = PhotoModelAlgorithm(pha, inc, ema);
+    double albedo;
+    if (p_photoTable.isNull() || p_standardConditions ||
+        !p_photoTable->interpolate(pha, inc, ema, &albedo)) {
+      albedo = PhotoModelAlgorithm(pha, inc, ema);
+    }
+
+    p_photoOldPhase = pha;
+    p_photoOldIncidence = inc;
+    p_photoOldEmission = ema;
+    p_photoOldAlbedo = albedo;
     return albedo;
   }
 
+  /**
+   * Tabulate the surface brightness so CalcSurfAlbedo interpolates it
+   * instead of evaluating the photometric function. The table is made from
+   * the current parameters and is not used under standard conditions. If
+   * no table small enough to keep meets the tolerance, the photometric function
+   * is still evaluated for every pixel and Table() returns a null pointer.
+   *
+   * @param tolerance The largest difference allowed between the photometric
+   *                  function and the table
+   */
+  void PhotoModel::GenerateTable(double tolerance) {
+    p_photoTable.clear();
+    QSharedPointer<const PhotometricTable> table(
+        new PhotometricTable(TableFunction, this, 1, tolerance));
+    if (!table->isEmpty()) {
+      p_photoTable = table;
+    }
+    p_photoOldPhase = -9999;
+  }
+
+  /**
+   * Use a table generated by another copy of this photometric model with the
+   * same parameters.
+   *
+   * @param table The table, or a null pointer to stop using a table
+   */
+  void PhotoModel::SetTable(QSharedPointer<const PhotometricTable> table) {
+    p_photoTable = table;
+    p_photoOldPhase = -9999;
+  }
+
+  /**
+   * Evaluates the photometric function for PhotometricTable.
+   */
+  void PhotoModel::TableFunction(double phase, double incidence, double emission,
+                                 double *values, void *model) {
+    values[0] = ((PhotoModel *) model)->PhotoModelAlgorithm(phase, incidence, emission);
+  }
+
   /**
    * Set the Lunar-Lambert function weight.  This is used to govern the
    * limb-darkening in the Lunar-Lambert photometric function.  Values of
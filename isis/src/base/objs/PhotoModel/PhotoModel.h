@@ -26,11 +26,14 @@
 #include <string>
 #include <vector>
 
+#include <QSharedPointer>
 #include <QString>
 #include "NumericalApproximation.h"
 #include "Pvl.h"
 
 namespace Isis {
+  class PhotometricTable;
+
   /**
    * @brief
    *
@@ -79,6 +82,14 @@ namespace Isis {
       // Calculate the surface brightness
       double CalcSurfAlbedo(double pha, double inc, double ema);
 
+      // Tabulate the surface brightness
+      void GenerateTable(double tolerance);
+      void SetTable(QSharedPointer<const PhotometricTable> table);
+      //! Return the table of surface brightness, or a null pointer if there is none
+      QSharedPointer<const PhotometricTable> Table() const {
+        return p_photoTable;
+      }
+
       virtual void SetPhotoL(const double l) {
         p_photoL = l;
       }
@@ -248,6 +259,16 @@ namespace Isis {
       QString p_photoAlgorithmName;
       //! Indicates whether standard conditions are used
       bool p_standardConditions;
+
+      static void TableFunction(double phase, double incidence, double emission,
+                                double *values, void *model);
+
+      //! The surface brightness on a grid of angles, used outside of standard conditions
+      QSharedPointer<const PhotometricTable> p_photoTable;
+      double p_photoOldPhase;     //!< The phase angle of the last surface brightness
+      double p_photoOldIncidence; //!< The incidence angle of the last surface brightness
+      double p_photoOldEmission;  //!< The emission angle of the last surface brightness
+      double p_photoOldAlbedo;    //!< The last surface brightness calculated
   };
 };
 
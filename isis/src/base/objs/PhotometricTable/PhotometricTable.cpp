@@ -0,0 +1,326 @@
+/**
+ * @file
+ *
+ *   Unless noted otherwise, the portions of Isis written by the USGS are public
+ *   domain. See individual third-party library and package descriptions for
+ *   intellectual property information,user agreements, and related information.
+ *
+ *   Although Isis has been used by the USGS, no warranty, expressed or implied,
+ *   is made by the USGS as to the accuracy and functioning of such software
+ *   and related material nor shall the fact of distribution constitute any such
+ *   warranty, and no responsibility is assumed by the USGS in connection
+ *   therewith.
+ *
+ *   For additional information, launch
+ *   $ISISROOT/doc//documents/Disclaimers/Disclaimers.html in a browser or see
+ *   the Privacy &amp; Disclaimers page on the Isis website,
+ *   http://isis.astrogeology.usgs.gov, and the USGS privacy and disclaimers on
+ *   http://www.usgs.gov/privacy.html.
+ */
+#include "PhotometricTable.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <QString>
+
+#include "IException.h"
+#include "IString.h"
+
+using namespace std;
+
+namespace Isis {
+  //! The grid spacings that are tried, coarsest first. Each divides 90 degrees.
+  static const double s_steps[] = {5.0, 2.5, 1.0, 0.5};
+  //! The number of cells along each axis that are compared while probing
+  static const int s_probeCells = 24;
+  //! The most values a table may hold, which keeps it under 128 MB
+  static const size_t s_maximumValues = 16 * 1024 * 1024;
+
+
+  /**
+   * Returns the number of grid points along one axis of the grid.
+   *
+   * @param range The range of the angle in degrees
+   * @param step The grid spacing in degrees
+   *
+   * @return @b int The number of grid points
+   */
+  static int gridCount(double range, double step) {
+    return int(range / step + 0.5) + 1;
+  }
+
+
+  /**
+   * Returns the indices of the cells to compare along one axis of the grid,
+   * always including the first and last cells where most models change
+   * fastest.
+   *
+   * @param cells The number of cells along the axis
+   *
+   * @return @b vector<int> The cell indices
+   */
+  static vector<int> probeIndices(int cells) {
+    int stride = max(1, cells / s_probeCells);
+    vector<int> indices;
+    for (int i = 0; i < cells - 1; i += stride) {
+      indices.push_back(i);
+    }
+    indices.push_back(cells - 1);
+    return indices;
+  }
+
+
+  /**
+   * Tabulates a function of the photometric angles. The function is
+   * evaluated for every grid point, so this takes as long as evaluating it
+   * for up to 12 million pixels when the finest spacing is needed.
+   *
+   * Spacings whose table would hold more than 16 million values are not
+   * tried. If no other spacing meets the tolerance, the table is left empty
+   * and the caller evaluates the function itself.
+   *
+   * @param function The function to tabulate
+   * @param parameter Passed to the function unchanged
+   * @param valueCount The number of values the function computes
+   * @param tolerance The largest difference allowed between the function and
+   *                  the interpolated table
+   */
+  PhotometricTable::PhotometricTable(Function *function, void *parameter,
+                                     int valueCount, double tolerance) {
+    if (tolerance <= 0.0) {
+      QString msg = "The photometric table tolerance [" + toString(tolerance) +
+                    "] must be greater than zero";
+      throw IException(IException::User, msg, _FILEINFO_);
+    }
+
+    m_valueCount = valueCount;
+    m_step = s_steps[0];
+    m_phaseCount = 0;
+    m_incidenceCount = 0;
+    m_emissionCount = 0;
+    m_maximumError = numeric_limits<double>::infinity();
+
+    // Only a sample of the cells is probed, so half of the tolerance is left
+    // for the cells that are not
+    bool withinTolerance = false;
+    int stepCount = sizeof(s_steps) / sizeof(s_steps[0]);
+    for (int i = 0; i < stepCount && !withinTolerance; i++) {
+      size_t size = (size_t) gridCount(180.0, s_steps[i]) * gridCount(90.0, s_steps[i]) *
+                    gridCount(90.0, s_steps[i]) * m_valueCount;
+      if (size > s_maximumValues) {
+        break;
+      }
+
+      m_step = s_steps[i];
+      m_maximumError = probe(function, parameter, m_step);
+      withinTolerance = m_maximumError <= 0.5 * tolerance;
+    }
+
+    if (!withinTolerance) {
+      return;
+    }
+
+    m_phaseCount = gridCount(180.0, m_step);
+    m_incidenceCount = gridCount(90.0, m_step);
+    m_emissionCount = m_incidenceCount;
+    m_values.resize((size_t) m_phaseCount * m_incidenceCount * m_emissionCount *
+                    m_valueCount);
+
+    double *values = &m_values[0];
+    for (int p = 0; p < m_phaseCount; p++) {
+      for (int i = 0; i < m_incidenceCount; i++) {
+        for (int e = 0; e < m_emissionCount; e++) {
+          evaluate(function, parameter, p * m_step, i * m_step, e * m_step,
+                   values, m_valueCount);
+          values += m_valueCount;
+        }
+      }
+    }
+  }
+
+
+  //! Destroys the table
+  PhotometricTable::~PhotometricTable() {
+  }
+
+
+  /**
+   * Interpolates the values of the function at a set of angles.
+   *
+   * @param phase The phase angle in degrees
+   * @param incidence The incidence angle in degrees
+   * @param emission The emission angle in degrees
+   * @param[out] values The interpolated values. They are undefined when false
+   *                    is returned.
+   *
+   * @return @b bool False if the table is empty, or the angles are outside of
+   *                 the table or next to a grid point without a finite value
+   */
+  bool PhotometricTable::interpolate(double phase, double incidence,
+                                     double emission, double *values) const {
+    // Written so that NaN angles fail too
+    if (m_values.empty() || !(phase >= 0.0 && phase <= 180.0 &&
+          incidence >= 0.0 && incidence <= 90.0 &&
+          emission >= 0.0 && emission <= 90.0)) {
+      return false;
+    }
+
+    double p = phase / m_step;
+    double i = incidence / m_step;
+    double e = emission / m_step;
+    int pIndex = min(int(p), m_phaseCount - 2);
+    int iIndex = min(int(i), m_incidenceCount - 2);
+    int eIndex = min(int(e), m_emissionCount - 2);
+    double pFraction = p - pIndex;
+    double iFraction = i - iIndex;
+    double eFraction = e - eIndex;
+
+    int eStride = m_valueCount;
+    int iStride = m_emissionCount * eStride;
+    int pStride = m_incidenceCount * iStride;
+    const double *corner = &m_values[(size_t) pIndex * pStride + iIndex * iStride +
+                                     eIndex * eStride];
+
+    for (int v = 0; v < m_valueCount; v++) {
+      const double *c = corner + v;
+      double c00 = c[0] + eFraction * (c[eStride] - c[0]);
+      double c01 = c[iStride] + eFraction * (c[iStride + eStride] - c[iStride]);
+      double c10 = c[pStride] + eFraction * (c[pStride + eStride] - c[pStride]);
+      double c11 = c[pStride + iStride] +
+                   eFraction * (c[pStride + iStride + eStride] - c[pStride + iStride]);
+      double c0 = c00 + iFraction * (c01 - c00);
+      double c1 = c10 + iFraction * (c11 - c10);
+      values[v] = c0 + pFraction * (c1 - c0);
+
+      if (!std::isfinite(values[v])) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+
+  /**
+   * @return @b bool True if no grid spacing that fits in memory met the
+   *                 tolerance, so the function has to be evaluated directly
+   */
+  bool PhotometricTable::isEmpty() const {
+    return m_values.empty();
+  }
+
+
+  /**
+   * @return @b int The number of values tabulated for each set of angles
+   */
+  int PhotometricTable::valueCount() const {
+    return m_valueCount;
+  }
+
+
+  /**
+   * @return @b double The grid spacing in degrees
+   */
+  double PhotometricTable::step() const {
+    return m_step;
+  }
+
+
+  /**
+   * @return @b double The largest difference between the function and the
+   *                   table found at the probed cell centers of the finest
+   *                   spacing that was tried
+   */
+  double PhotometricTable::maximumError() const {
+    return m_maximumError;
+  }
+
+
+  /**
+   * Estimates the interpolation error of a grid spacing. The interpolation at
+   * the center of a cell is the mean of its corners, which is compared with
+   * the function itself. Only cells whose center is a possible viewing
+   * geometry, with the phase angle between the difference and the sum of the
+   * incidence and emission angles, are compared.
+   *
+   * @param function The function to tabulate
+   * @param parameter Passed to the function unchanged
+   * @param step The grid spacing to try
+   *
+   * @return @b double The largest difference found
+   */
+  double PhotometricTable::probe(Function *function, void *parameter,
+                                 double step) const {
+    vector<int> phases = probeIndices(int(180.0 / step + 0.5));
+    vector<int> angles = probeIndices(int(90.0 / step + 0.5));
+    vector<double> corners(8 * m_valueCount);
+    vector<double> center(m_valueCount);
+    double maximumError = 0.0;
+
+    for (unsigned int p = 0; p < phases.size(); p++) {
+      for (unsigned int i = 0; i < angles.size(); i++) {
+        for (unsigned int e = 0; e < angles.size(); e++) {
+          double phase = (phases[p] + 0.5) * step;
+          double incidence = (angles[i] + 0.5) * step;
+          double emission = (angles[e] + 0.5) * step;
+          if (phase > incidence + emission || phase < fabs(incidence - emission)) {
+            continue;
+          }
+
+          for (int c = 0; c < 8; c++) {
+            evaluate(function, parameter,
+                     (phases[p] + (c >> 2)) * step,
+                     (angles[i] + ((c >> 1) & 1)) * step,
+                     (angles[e] + (c & 1)) * step,
+                     &corners[c * m_valueCount], m_valueCount);
+          }
+          evaluate(function, parameter, phase, incidence, emission, &center[0],
+                   m_valueCount);
+
+          for (int v = 0; v < m_valueCount; v++) {
+            double mean = 0.0;
+            for (int c = 0; c < 8; c++) {
+              mean += corners[c * m_valueCount + v];
+            }
+            mean /= 8.0;
+
+            // These cells are evaluated directly rather than interpolated
+            if (std::isfinite(mean) && std::isfinite(center[v])) {
+              maximumError = max(maximumError, fabs(mean - center[v]));
+            }
+          }
+        }
+      }
+    }
+
+    return maximumError;
+  }
+
+
+  /**
+   * Evaluates the function, storing NaN for angles it fails to evaluate so
+   * they are left to the model when the table is used.
+   *
+   * @param function The function to evaluate
+   * @param parameter Passed to the function unchanged
+   * @param phase The phase angle in degrees
+   * @param incidence The incidence angle in degrees
+   * @param emission The emission angle in degrees
+   * @param[out] values The values of the function
+   * @param valueCount The number of values the function computes
+   */
+  void PhotometricTable::evaluate(Function *function, void *parameter,
+                                  double phase, double incidence, double emission,
+                                  double *values, int valueCount) {
+    try {
+      function(phase, incidence, emission, values, parameter);
+    }
+    catch (IException &e) {
+      for (int v = 0; v < valueCount; v++) {
+        values[v] = numeric_limits<double>::quiet_NaN();
+      }
+    }
+  }
+}
@@ -0,0 +1,95 @@
+#ifndef PhotometricTable_h
+#define PhotometricTable_h
+/**
+ * @file
+ *
+ *   Unless noted otherwise, the portions of Isis written by the USGS are public
+ *   domain. See individual third-party library and package descriptions for
+ *   intellectual property information,user agreements, and related information.
+ *
+ *   Although Isis has been used by the USGS, no warranty, expressed or implied,
+ *   is made by the USGS as to the accuracy and functioning of such software
+ *   and related material nor shall the fact of distribution constitute any such
+ *   warranty, and no responsibility is assumed by the USGS in connection
+ *   therewith.
+ *
+ *   For additional information, launch
+ *   $ISISROOT/doc//documents/Disclaimers/Disclaimers.html in a browser or see
+ *   the Privacy &amp; Disclaimers page on the Isis website,
+ *   http://isis.astrogeology.usgs.gov, and the USGS privacy and disclaimers on
+ *   http://www.usgs.gov/privacy.html.
+ */
+
+#include <vector>
+
+namespace Isis {
+  /**
+   * @brief Tabulates a function of the photometric angles
+   *
+   * Photometric and atmospheric models are evaluated for every pixel of an
+   * image, and models such as Hapke and the Hapke atmospheres take far longer
+   * to evaluate than anything else photomet does per pixel. This class
+   * evaluates a model once on a regular grid of phase, incidence and emission
+   * angles and then answers each pixel with a trilinear interpolation of the
+   * grid.
+   *
+   * The grid spacing is chosen from the accuracy the caller asks for. Starting
+   * with the coarsest spacing, the interpolation is compared with the model at
+   * the centers of a sample of the grid cells, and the spacing is reduced
+   * until the largest difference is within half of the tolerance.
+   * maximumError() reports the difference that was measured for the spacing
+   * that was used. The table size is capped, so a model with many values may
+   * not reach the finest spacing. When no spacing meets the tolerance the
+   * table is empty and every pixel is left to the model.
+   *
+   * Angles outside of the table, and cells where the model did not produce a
+   * finite value, are not interpolated. interpolate() returns false for them
+   * and the caller evaluates the model itself.
+   *
+   * A table is not changed after it is built, so one table can be shared by
+   * several threads and several copies of a model.
+   *
+   * @ingroup RadiometricAndPhotometricCorrection
+   */
+  class PhotometricTable {
+    public:
+      /**
+       * A function that computes valueCount values for a set of photometric
+       * angles in degrees. The parameter is passed through unchanged.
+       */
+      typedef void Function(double phase, double incidence, double emission,
+                            double *values, void *parameter);
+
+      PhotometricTable(Function *function, void *parameter, int valueCount,
+                       double tolerance);
+      ~PhotometricTable();
+
+      bool interpolate(double phase, double incidence, double emission,
+                       double *values) const;
+
+      bool isEmpty() const;
+      int valueCount() const;
+      double step() const;
+      double maximumError() const;
+
+    private:
+      // Not implemented
+      PhotometricTable(const PhotometricTable &other);
+      PhotometricTable &operator=(const PhotometricTable &other);
+
+      double probe(Function *function, void *parameter, double step) const;
+      static void evaluate(Function *function, void *parameter, double phase,
+                           double incidence, double emission, double *values,
+                           int valueCount);
+
+      int m_valueCount;          //!< The number of values at each grid point
+      double m_step;             //!< The grid spacing in degrees
+      int m_phaseCount;          //!< The number of phase angles in the grid
+      int m_incidenceCount;      //!< The number of incidence angles in the grid
+      int m_emissionCount;       //!< The number of emission angles in the grid
+      double m_maximumError;     //!< The largest difference found by the probe
+      std::vector<double> m_values; //!< The values with emission varying fastest
+  };
+}
+
+#endif
@@ -10,6 +10,7 @@
 #include "NormModel.h"
 #include "Plugin.h"
 #include "FileName.h"
+#include "SpecialPixel.h"
 
 namespace Isis {
   /**
@@ -98,6 +99,66 @@ namespace Isis {
     return;
   }
 
+  /**
+   * Calculate the surface brightness of a line of pixels. Pixels with a
+   * special DN are copied to the output unchanged, so callers can set the DN
+   * of pixels that should not be corrected to Null.
+   *
+   * @param count The number of pixels
+   * @param pha Phase angles
+   * @param inc Incidence angles for ellipsoid
+   * @param ema Emission angles for ellipsoid
+   * @param deminc Incidence angles for dem
+   * @param demema Emission angles for dem
+   * @param dn Input albedo values
+   * @param albedo Output albedo values
+   */
+  void Photometry::Compute(int count, const double *pha, const double *inc,
+                           const double *ema, const double *deminc,
+                           const double *demema, const double *dn, double *albedo) {
+    double mult, base;
+    for (int i = 0; i < count; i++) {
+      if (IsSpecial(dn[i])) {
+        albedo[i] = dn[i];
+      }
+      else {
+        p_phtNmodel->CalcNrmAlbedo(pha[i], inc[i], ema[i], deminc[i], demema[i],
+                                   dn[i], albedo[i], mult, base);
+      }
+    }
+  }
+
+  /**
+   * Tabulate the photometric model, and the atmospheric model if there is
+   * one, so Compute interpolates them instead of evaluating them for every
+   * pixel.
+   *
+   * @param tolerance The largest difference allowed between a model and its
+   *                  table
+   */
+  void Photometry::GenerateTables(double tolerance) {
+    // The atmospheric model can use the photometric model, so it is
+    // tabulated first from the photometric model itself
+    if (p_phtAmodel != NULL) {
+      p_phtAmodel->GenerateTable(tolerance);
+    }
+    p_phtPmodel->GenerateTable(tolerance);
+  }
+
+  /**
+   * Use the tables of another Photometry object made from the same
+   * parameters, so several threads can each have their own models without
+   * tabulating them again.
+   *
+   * @param other The Photometry object whose tables are used
+   */
+  void Photometry::SetTables(const Photometry &other) {
+    p_phtPmodel->SetTable(other.p_phtPmodel->Table());
+    if (p_phtAmodel != NULL && other.p_phtAmodel != NULL) {
+      p_phtAmodel->SetTable(other.p_phtAmodel->Table());
+    }
+  }
+
   /**
    * GSL's the Brent-Dekker method (referred to here as Brent's method) combines an
    * interpolation strategy with the bisection algorithm. This produces a fast algorithm
@@ -60,6 +60,13 @@ namespace Isis {
       void Compute(double pha, double inc, double ema, double deminc,
                    double demema, double dn, double &albedo,
                    double &mult, double &base);
+      void Compute(int count, const double *pha, const double *inc,
+                   const double *ema, const double *deminc, const double *demema,
+                   const double *dn, double *albedo);
+
+      //! Tabulate the photometric and atmospheric models
+      void GenerateTables(double tolerance);
+      void SetTables(const Photometry &other);
 
       //! Set the wavelength
       virtual void SetPhotomWl(double wl);
@@ -32,6 +32,7 @@
 #include "Pvl.h"
 #include "PvlGroup.h"
 #include "PvlKeyword.h"
+#include "SpecialPixel.h"
 
 using namespace std;
 namespace Isis {
@@ -197,13 +198,117 @@ namespace Isis {
    * @return bool
    */
   bool PolarStereographic::SetGround(const double lat, const double lon) {
-    // Fix up longitude
     m_longitude = lon;
+    m_latitude = lat;
+
+    double x, y;
+    bool good = groundToXY(lat, lon, x, y);
+    SetComputedXY(x, y);
+
+    m_good = good;
+    return m_good;
+  }
+
+  
+  /**
+   * This method is used to set the projection x/y. The Set forces an attempted
+   * calculation of the corresponding latitude/longitude position. This may or
+   * may not be successful and a status is returned as such.
+   *
+   * @param x X coordinate of the projection in units that are the same as the
+   *          radii in the label
+   *
+   * @param y Y coordinate of the projection in units that are the same as the
+   *          radii in the label
+   *
+   * @return bool
+   */
+  bool PolarStereographic::SetCoordinate(const double x, const double y) {
+    // Save the coordinate
+    SetXY(x, y);
+
+    xyToGround(GetX(), GetY(), m_latitude, m_longitude);
+
+    m_good = true;
+    return m_good;
+  }
+
+
+  /**
+   * This method projects many latitude/longitude positions at once with the
+   * same equations as SetGround, without storing each position in the
+   * projection. Rotated projections are projected one position at a time.
+   *
+   * @param count The number of positions to project
+   * @param lats The latitudes to project
+   * @param lons The longitudes to project
+   * @param xs Returns the projection x coordinates
+   * @param ys Returns the projection y coordinates
+   * @param good Returns whether each position was projected
+   */
+  void PolarStereographic::SetGrounds(const int count, const double *lats, const double *lons,
+                                      double *xs, double *ys, bool *good) {
+    if (Rotation() != 0.0) {
+      TProjection::SetGrounds(count, lats, lons, xs, ys, good);
+      return;
+    }
+
+    for (int i = 0; i < count; i++) {
+      good[i] = groundToXY(lats[i], lons[i], xs[i], ys[i]);
+      if (!good[i]) {
+        xs[i] = Null;
+        ys[i] = Null;
+      }
+    }
+  }
+
+
+  /**
+   * This method computes the latitude/longitude of many x/y coordinates at
+   * once with the same equations as SetCoordinate. Rotated projections are
+   * inverted one coordinate at a time.
+   *
+   * @param count The number of coordinates to invert
+   * @param xs The projection x coordinates
+   * @param ys The projection y coordinates
+   * @param lats Returns the latitudes
+   * @param lons Returns the longitudes
+   * @param good Returns whether each coordinate was inverted
+   *
+   * @throws IException::Programmer "X,Y causes latitude to be outside [-90,90]"
+   */
+  void PolarStereographic::SetCoordinates(const int count, const double *xs, const double *ys,
+                                          double *lats, double *lons, bool *good) {
+    if (Rotation() != 0.0) {
+      TProjection::SetCoordinates(count, xs, ys, lats, lons, good);
+      return;
+    }
+
+    for (int i = 0; i < count; i++) {
+      xyToGround(xs[i], ys[i], lats[i], lons[i]);
+      good[i] = true;
+    }
+  }
+
+
+  /**
+   * Computes the unrotated projection x/y of a latitude/longitude in the
+   * coordinate system of the projection.
+   *
+   * @param lat Latitude value to project
+   * @param lon Longitude value to project
+   * @param x Returns the unrotated x coordinate
+   * @param y Returns the unrotated y coordinate
+   *
+   * @return bool False for the pole opposite the center of the projection
+   */
+  bool PolarStereographic::groundToXY(const double lat, const double lon,
+                                      double &x, double &y) const {
+    // Fix up longitude
     double lonRadians = lon * PI / 180.0;
     if (m_longitudeDirection == PositiveWest) lonRadians *= -1.0;
 
     // Now do latitude ... it must be planetographic
-    m_latitude = lat;
     double latRadians = lat;
     if (IsPlanetocentric()) latRadians = ToPlanetographic(latRadians);
     latRadians = latRadians * PI / 180.0;
@@ -222,39 +327,29 @@ namespace Isis {
       dist = m_equatorialRadius * 2.0 * t / m_e4;
     }
 
-    double x = m_signFactor * dist * sin(lamda);
-    double y = -(m_signFactor * dist * cos(lamda));
-    SetComputedXY(x, y);
-
-    m_good = true;
+    x = m_signFactor * dist * sin(lamda);
+    y = -(m_signFactor * dist * cos(lamda));
 
     //So we don't project the wrong pole.
-    if (qFuzzyCompare(lat * m_signFactor, -90.0))
-      m_good = false;
-
-    return m_good;
+    return !qFuzzyCompare(lat * m_signFactor, -90.0);
   }
 
-  
+
   /**
-   * This method is used to set the projection x/y. The Set forces an attempted
-   * calculation of the corresponding latitude/longitude position. This may or
-   * may not be successful and a status is returned as such.
-   *
-   * @param x X coordinate of the projection in units that are the same as the
-   *          radii in the label
+   * Computes the latitude/longitude, in the coordinate system of the
+   * projection, of an unrotated projection x/y.
    *
-   * @param y Y coordinate of the projection in units that are the same as the
-   *          radii in the label
+   * @param x The unrotated x coordinate
+   * @param y The unrotated y coordinate
+   * @param lat Returns the latitude
+   * @param lon Returns the longitude
    *
-   * @return bool
+   * @throws IException::Programmer "X,Y causes latitude to be outside [-90,90]"
    */
-  bool PolarStereographic::SetCoordinate(const double x, const double y) {
-    // Save the coordinate
-    SetXY(x, y);
-
-    double east = m_signFactor * GetX();
-    double north = m_signFactor * GetY();
+  void PolarStereographic::xyToGround(const double x, const double y,
+                                      double &lat, double &lon) const {
+    double east = m_signFactor * x;
+    double north = m_signFactor * y;
     double dist = sqrt(east * east + north * north);
 
     double t;
@@ -268,9 +363,9 @@ namespace Isis {
 
     // Compute the latitude
     double phi = phi2Compute(t);
-    m_latitude = m_signFactor * phi;
+    lat = m_signFactor * phi;
 
-    if (fabs(m_latitude) > HALFPI) {
+    if (fabs(lat) > HALFPI) {
       QString msg = "X,Y causes latitude to be outside [-90,90] "
                    "in PolarStereographic Class";
       throw IException(IException::Programmer, msg, _FILEINFO_);
@@ -278,24 +373,21 @@ namespace Isis {
 
     // Compute the longitude
     if (dist == 0.0) {
-      m_longitude = m_signFactor * m_centerLongitude;
+      lon = m_signFactor * m_centerLongitude;
     }
     else {
-      m_longitude = m_signFactor * atan2(east, -north) + m_centerLongitude;
+      lon = m_signFactor * atan2(east, -north) + m_centerLongitude;
     }
 
     // Cleanup the longitude
-    m_longitude *= 180.0 / PI;
-    if (m_longitudeDirection == PositiveWest) m_longitude *= -1.0;
-    m_longitude = To360Domain(m_longitude);
-    if (m_longitudeDomain == 180) m_longitude = To180Domain(m_longitude);
+    lon *= 180.0 / PI;
+    if (m_longitudeDirection == PositiveWest) lon *= -1.0;
+    lon = To360Domain(lon);
+    if (m_longitudeDomain == 180) lon = To180Domain(lon);
 
     // Cleanup the latitude
-    m_latitude *= 180.0 / PI;
-    if (IsPlanetocentric()) m_latitude = ToPlanetocentric(m_latitude);
-
-    m_good = true;
-    return m_good;
+    lat *= 180.0 / PI;
+    if (IsPlanetocentric()) lat = ToPlanetocentric(lat);
   }
 
   
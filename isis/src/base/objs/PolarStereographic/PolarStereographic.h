@@ -89,6 +89,10 @@ namespace Isis {
 
       bool SetGround(const double lat, const double lon);
       bool SetCoordinate(const double x, const double y);
+      void SetGrounds(const int count, const double *lats, const double *lons,
+                      double *xs, double *ys, bool *good);
+      void SetCoordinates(const int count, const double *xs, const double *ys,
+                          double *lats, double *lons, bool *good);
       bool XYRange(double &minX, double &maxX, double &minY, double &maxY);
 
       PvlGroup Mapping();
@@ -96,6 +100,9 @@ namespace Isis {
       PvlGroup MappingLongitudes();
 
     private:
+      bool groundToXY(const double lat, const double lon, double &x, double &y) const;
+      void xyToGround(const double x, const double y, double &lat, double &lon) const;
+
       double m_centerLongitude; //!< The center longitude for the map projection
       double m_centerLatitude;  //!< The center latitude for the map projection
 
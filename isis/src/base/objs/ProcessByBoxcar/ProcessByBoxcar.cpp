@@ -20,12 +20,22 @@
  *   http://www.usgs.gov/privacy.html.
  */
 
+#include <algorithm>
+
+#include <QFuture>
+#include <QList>
+#include <QMutex>
+#include <QThreadPool>
+#include <QtConcurrentMap>
+
 #include "BoxcarCachingAlgorithm.h"
 #include "BoxcarManager.h"
 #include "Buffer.h"
+#include "IString.h"
 #include "LineManager.h"
 #include "Process.h"
 #include "ProcessByBoxcar.h"
+#include "SpecialPixel.h"
 
 using namespace std;
 namespace Isis {
@@ -119,6 +129,376 @@ namespace Isis {
 
   }
 
+  /**
+   * Sets the statistic computed by StartRankProcess
+   *
+   * @param statistic The statistic of the valid pixels in the boxcar
+   * @param percentile The percentile, 0 to 100, used by the Percentile
+   *                   statistic. The pixel at index floor((n-1) * percentile /
+   *                   100) of the n sorted valid pixels is used, so 50 gives
+   *                   the same lower median as the Median statistic.
+   *
+   * @throws Isis::IException::Programmer
+   */
+  void ProcessByBoxcar::SetRankStatistic(RankStatistic statistic, double percentile) {
+    if (percentile < 0.0 || percentile > 100.0) {
+      string m = "The percentile [" + IString(percentile) + "] must be between 0 and 100";
+      throw IException(IException::Programmer, m, _FILEINFO_);
+    }
+
+    p_rankStatistic = statistic;
+    p_rankPercentile = percentile;
+  }
+
+
+  /**
+   * Sets the range of values counted by StartRankProcess. Special pixels and
+   * values outside of the range are never counted.
+   *
+   * @param minimum The smallest valid value
+   * @param maximum The largest valid value
+   */
+  void ProcessByBoxcar::SetRankValidRange(double minimum, double maximum) {
+    p_rankMinimum = minimum;
+    p_rankMaximum = maximum;
+  }
+
+
+  /**
+   * Sets the number of valid pixels StartRankProcess needs in the boxcar to
+   * filter a pixel
+   *
+   * @param minimum The number of valid pixels needed
+   * @param propagate If true, pixels with too few valid pixels in their boxcar
+   *                  keep their value, otherwise they are set to Null. A
+   *                  boxcar with no valid pixels that still meets the minimum
+   *                  keeps its center pixel either way.
+   */
+  void ProcessByBoxcar::SetRankMinimumCount(int minimum, bool propagate) {
+    p_rankMinimumCount = minimum;
+    p_rankPropagate = propagate;
+  }
+
+
+  /**
+   * Rank filters the input cube into the output cube. Each output pixel is the
+   * statistic set by SetRankStatistic of the valid pixels in the boxcar
+   * centered on it. The Mode of a boxcar whose values all differ is its center
+   * pixel, and the smallest of several equally common values is the Mode.
+   * The result is the same as sorting the valid pixels of every
+   * boxcar, but the valid pixels are kept in an order-statistics tree that is
+   * updated by one boxcar column as the boxcar moves along a line, so each pixel
+   * costs O(boxLines log n) rather than O(boxSamples boxLines log n).
+   *
+   * The cube is split into chunks of lines that are filtered concurrently on
+   * the global thread pool, so the number of threads is set by the GlobalThreads
+   * preference. The output is the same for any number of threads.
+   *
+   * @param filter Function that is given the center pixel of a boxcar and
+   *               returns true if the pixel should be filtered. Pixels that are
+   *               not filtered are copied to the output. If NULL, every pixel
+   *               is filtered.
+   * @param chunkLines Number of lines in a chunk. If less than 1, chunks are the
+   *                   larger of 16 lines and the boxcar lines.
+   *
+   * @throws Isis::IException::Programmer
+   * @throws Isis::IException::User "Unable to rank filter lines"
+   */
+  void ProcessByBoxcar::StartRankProcess(bool filter(double center), int chunkLines) {
+    // Error checks ... there must be one input and output
+    if(InputCubes.size() != 1) {
+      string m = "You must specify exactly one input cube";
+      throw IException(IException::Programmer, m, _FILEINFO_);
+    }
+    else if(OutputCubes.size() != 1) {
+      string m = "You must specify exactly one output cube";
+      throw IException(IException::Programmer, m, _FILEINFO_);
+    }
+
+    if(InputCubes[0]->lineCount() != OutputCubes[0]->lineCount() ||
+       InputCubes[0]->sampleCount() != OutputCubes[0]->sampleCount() ||
+       InputCubes[0]->bandCount() != OutputCubes[0]->bandCount()) {
+      string m = "The dimensions of the input and output cubes must match";
+      throw IException(IException::Programmer, m, _FILEINFO_);
+    }
+
+    //  Make sure the boxcar size has been set
+    if(!p_boxsizeSet) {
+      string m = "Use the SetBoxcarSize method to set the boxcar size";
+      throw IException(IException::Programmer, m, _FILEINFO_);
+    }
+
+    if(chunkLines < 1) {
+      chunkLines = max(16, p_boxLines);
+    }
+
+    QList<RankChunk> chunks;
+    for(int band = 1; band <= InputCubes[0]->bandCount(); band++) {
+      for(int line = 1; line <= InputCubes[0]->lineCount(); line += chunkLines) {
+        RankChunk chunk;
+        chunk.band = band;
+        chunk.startLine = line;
+        chunk.endLine = min(line + chunkLines - 1, InputCubes[0]->lineCount());
+        chunk.failed = false;
+        chunks.append(chunk);
+      }
+    }
+
+    p_progress->SetMaximumSteps(chunks.size());
+    p_progress->CheckStatus();
+
+    QFuture<void> future = QtConcurrent::map(chunks, RankFunctor(this, filter));
+
+    // Translate the progress of the future into Isis progress
+    int reported = 0;
+    QMutex sleeper;
+    sleeper.lock();
+    while(!future.isFinished()) {
+      sleeper.tryLock(100);
+      for( ; reported < future.progressValue(); reported++) {
+        p_progress->CheckStatus();
+      }
+    }
+    for( ; reported < future.progressValue(); reported++) {
+      p_progress->CheckStatus();
+    }
+    sleeper.unlock();
+
+    for(int i = 0; i < chunks.size(); i++) {
+      if(chunks[i].failed) {
+        string m = "Unable to rank filter lines [" + IString(chunks[i].startLine) + "] to [" +
+                   IString(chunks[i].endLine) + "] of band [" + IString(chunks[i].band) + "]";
+        throw IException(chunks[i].error, IException::User, m, _FILEINFO_);
+      }
+    }
+  }
+
+
+  /**
+   * Rank filters one chunk of lines. The input lines covered by the boxcars of
+   * the chunk are read once, and their valid pixels are replaced by their rank
+   * among the distinct valid values so the tree is indexed by rank.
+   *
+   * @param chunk The lines to filter
+   * @param filter Selects the center pixels to filter, NULL to filter all
+   */
+  void ProcessByBoxcar::RankFilter(const RankChunk &chunk, bool filter(double center)) const {
+    Cube *icube = InputCubes[0];
+    Cube *ocube = OutputCubes[0];
+    int ns = icube->sampleCount();
+    int nl = icube->lineCount();
+
+    // The boxcar extends the same way as in BoxcarManager
+    int left = (p_boxSamples - 1) / 2;
+    int right = p_boxSamples - 1 - left;
+    int top = (p_boxLines - 1) / 2;
+    int bottom = p_boxLines - 1 - top;
+
+    int firstLine = max(1, chunk.startLine - top);
+    int lastLine = min(nl, chunk.endLine + bottom);
+
+    vector<double> data((lastLine - firstLine + 1) * ns);
+    LineManager in(*icube);
+    for(int line = firstLine; line <= lastLine; line++) {
+      in.SetLine(line, chunk.band);
+      icube->read(in);
+      copy(in.DoubleBuffer(), in.DoubleBuffer() + ns, data.begin() + (line - firstLine) * ns);
+    }
+
+    vector<double> values;
+    for(unsigned int i = 0; i < data.size(); i++) {
+      if(!IsSpecial(data[i]) && data[i] >= p_rankMinimum && data[i] <= p_rankMaximum) {
+        values.push_back(data[i]);
+      }
+    }
+    sort(values.begin(), values.end());
+    values.erase(unique(values.begin(), values.end()), values.end());
+
+    vector<int> ranks(data.size(), -1);
+    for(unsigned int i = 0; i < data.size(); i++) {
+      if(!IsSpecial(data[i]) && data[i] >= p_rankMinimum && data[i] <= p_rankMaximum) {
+        ranks[i] = lower_bound(values.begin(), values.end(), data[i]) - values.begin();
+      }
+    }
+
+    RankTree tree(values.size());
+    LineManager out(*ocube);
+    for(int line = chunk.startLine; line <= chunk.endLine; line++) {
+      int boxFirst = max(firstLine, line - top) - firstLine;
+      int boxLast = min(lastLine, line + bottom) - firstLine;
+      const double *center = &data[(line - firstLine) * ns];
+
+      // Adds or removes one column of the boxcar, ignoring columns off the cube
+      tree.clear();
+      auto addColumn = [&](int sample, int count) {
+        if(sample < 0 || sample >= ns) {
+          return;
+        }
+        for(int row = boxFirst; row <= boxLast; row++) {
+          int rank = ranks[row * ns + sample];
+          if(rank >= 0) {
+            tree.add(rank, count);
+          }
+        }
+      };
+
+      for(int sample = 0; sample < right; sample++) {
+        addColumn(sample, 1);
+      }
+
+      out.SetLine(line, chunk.band);
+      for(int sample = 0; sample < ns; sample++) {
+        addColumn(sample - left - 1, -1);
+        addColumn(sample + right, 1);
+
+        if(filter && !filter(center[sample])) {
+          out[sample] = center[sample];
+          continue;
+        }
+
+        int count = tree.total();
+        if(count < p_rankMinimumCount) {
+          out[sample] = p_rankPropagate ? center[sample] : Isis::Null;
+        }
+        else if(count == 0) {
+          // An empty boxcar allowed by the minimum count keeps the pixel
+          out[sample] = center[sample];
+        }
+        else if(p_rankStatistic == Mode) {
+          // With no repeated values there is no mode, so the pixel is kept.
+          // Ties go to the smallest value.
+          out[sample] = (tree.maxCount() > 1) ? values[tree.mode()] : center[sample];
+        }
+        else if(p_rankStatistic == Percentile) {
+          out[sample] = values[tree.kth((int)((count - 1) * p_rankPercentile / 100.0))];
+        }
+        else {
+          out[sample] = values[tree.kth((count - 1) / 2)];
+        }
+      }
+      ocube->write(out);
+    }
+  }
+
+
+  /**
+   * Constructs a functor that rank filters chunks of lines
+   *
+   * @param process The boxcar process
+   * @param filter Selects the center pixels to filter, NULL to filter all
+   */
+  ProcessByBoxcar::RankFunctor::RankFunctor(const ProcessByBoxcar *process,
+                                            bool filter(double center)) {
+    m_process = process;
+    m_filter = filter;
+  }
+
+
+  /**
+   * Rank filters a chunk of lines. Errors are stored in the chunk so they can
+   * be rethrown by StartRankProcess.
+   *
+   * @param chunk The lines to filter
+   */
+  void ProcessByBoxcar::RankFunctor::operator()(RankChunk &chunk) const {
+    try {
+      m_process->RankFilter(chunk, m_filter);
+    }
+    catch(IException &e) {
+      chunk.failed = true;
+      chunk.error = e;
+    }
+  }
+
+
+  /**
+   * Constructs an empty tree
+   *
+   * @param ranks The number of distinct values counted by the tree
+   */
+  ProcessByBoxcar::RankTree::RankTree(int ranks) {
+    m_leaves = 1;
+    while(m_leaves < ranks) {
+      m_leaves *= 2;
+    }
+    m_sums.resize(2 * m_leaves, 0);
+    m_maxes.resize(2 * m_leaves, 0);
+  }
+
+
+  //! Removes all counts from the tree
+  void ProcessByBoxcar::RankTree::clear() {
+    fill(m_sums.begin(), m_sums.end(), 0);
+    fill(m_maxes.begin(), m_maxes.end(), 0);
+  }
+
+
+  /**
+   * Changes the count of a value
+   *
+   * @param rank The rank of the value
+   * @param count The number of pixels to add, negative to remove pixels
+   */
+  void ProcessByBoxcar::RankTree::add(int rank, int count) {
+    int node = m_leaves + rank;
+    m_sums[node] += count;
+    m_maxes[node] += count;
+    for(node /= 2; node >= 1; node /= 2) {
+      m_sums[node] = m_sums[2 * node] + m_sums[2 * node + 1];
+      m_maxes[node] = max(m_maxes[2 * node], m_maxes[2 * node + 1]);
+    }
+  }
+
+
+  //! Returns the number of pixels counted
+  int ProcessByBoxcar::RankTree::total() const {
+    return m_sums[1];
+  }
+
+
+  //! Returns the count of the most frequent value
+  int ProcessByBoxcar::RankTree::maxCount() const {
+    return m_maxes[1];
+  }
+
+
+  /**
+   * Returns the rank of the k-th smallest pixel counted
+   *
+   * @param k The zero based index of the pixel in sorted order, less than total()
+   *
+   * @return @b int The rank of the pixel's value
+   */
+  int ProcessByBoxcar::RankTree::kth(int k) const {
+    int node = 1;
+    while(node < m_leaves) {
+      if(k < m_sums[2 * node]) {
+        node = 2 * node;
+      }
+      else {
+        k -= m_sums[2 * node];
+        node = 2 * node + 1;
+      }
+    }
+    return node - m_leaves;
+  }
+
+
+  /**
+   * Returns the rank of the most frequent value. If several values are the
+   * most frequent, the smallest is returned.
+   *
+   * @return @b int The rank of the value
+   */
+  int ProcessByBoxcar::RankTree::mode() const {
+    int node = 1;
+    while(node < m_leaves) {
+      node = (m_maxes[2 * node] == m_maxes[node]) ? 2 * node : 2 * node + 1;
+    }
+    return node - m_leaves;
+  }
+
+
   /**
    * End the boxcar processing sequence and cleans up by closing cubes, freeing
    * memory, etc.
@@ -22,8 +22,12 @@
  *   http://www.usgs.gov/privacy.html.
  */
 
-#include "Process.h"
+#include <cfloat>
+#include <vector>
+
 #include "Buffer.h"
+#include "IException.h"
+#include "Process.h"
 
 namespace Isis {
   /**
@@ -32,6 +36,12 @@ namespace Isis {
    * This is the processing class used to move a boxcar through cube data. This
    * class allows only one input cube and one output cube.
    *
+   * Rank filters such as median, percentile and mode should use
+   * StartRankProcess instead of sorting the boxcar in a StartProcess function.
+   * It keeps the valid pixels of the boxcar in an order-statistics tree that is
+   * updated one column at a time as the boxcar moves along a line, and filters
+   * chunks of lines concurrently on the global thread pool.
+   *
    * @ingroup HighLevelCubeIO
    *
    * @author 2003-01-03 Tracie Sucharski
@@ -54,17 +64,90 @@ namespace Isis {
 
   class ProcessByBoxcar : public Isis::Process {
 
+    public:
+      /**
+       * The statistic StartRankProcess computes from the valid pixels in the
+       * boxcar
+       */
+      enum RankStatistic {
+        Median,      //!< The lower median of the valid pixels
+        Percentile,  //!< The valid pixel at a percentile of the sorted pixels
+        Mode         //!< The most frequent valid pixel, the smallest on ties
+      };
+
     private:
       bool p_boxsizeSet; //!< Indicates whether the boxcar size has been set
       int p_boxSamples;  //!< Number of samples in boxcar
       int p_boxLines;    //!< Number of lines in boxcar
 
+      RankStatistic p_rankStatistic; //!< The statistic of rank processing
+      double p_rankPercentile;       //!< The percentile of rank processing
+      double p_rankMinimum;          //!< Smallest value that is a valid pixel
+      double p_rankMaximum;          //!< Largest value that is a valid pixel
+      int p_rankMinimumCount;        //!< Valid pixels needed to filter a pixel
+      bool p_rankPropagate;          //!< Keep the center if there are too few
+
+      /**
+       * A range of lines in one band filtered by one thread in rank processing
+       */
+      struct RankChunk {
+        int band;                    //!< The band of the chunk
+        int startLine;               //!< The first line of the chunk
+        int endLine;                 //!< The last line of the chunk
+        bool failed;                 //!< True if filtering the chunk failed
+        IException error;            //!< The error if filtering failed
+      };
+
+      /**
+       * Counts of the valid pixels in the boxcar indexed by the rank of their
+       * value. The counts are kept in a segment tree so the k-th smallest pixel
+       * and the most frequent pixel are found in logarithmic time.
+       */
+      class RankTree {
+        public:
+          RankTree(int ranks);
+
+          void clear();
+          void add(int rank, int count);
+
+          int total() const;
+          int maxCount() const;
+          int kth(int k) const;
+          int mode() const;
+
+        private:
+          int m_leaves;                //!< Number of leaves, a power of two
+          std::vector<int> m_sums;     //!< Pixels counted under each node
+          std::vector<int> m_maxes;    //!< Largest leaf count under each node
+      };
+
+      /**
+       * Functor for QtConcurrent that rank filters a chunk of lines
+       */
+      class RankFunctor {
+        public:
+          RankFunctor(const ProcessByBoxcar *process, bool filter(double center));
+
+          void operator()(RankChunk &chunk) const;
+
+        private:
+          const ProcessByBoxcar *m_process;   //!< The boxcar process
+          bool (*m_filter)(double center);    //!< Selects the pixels to filter
+      };
+
+      void RankFilter(const RankChunk &chunk, bool filter(double center)) const;
 
     public:
 
       //! Constructs a ProcessByBoxcar object
       ProcessByBoxcar() {
         p_boxsizeSet = false;
+        p_rankStatistic = Median;
+        p_rankPercentile = 50.0;
+        p_rankMinimum = -DBL_MAX;
+        p_rankMaximum = DBL_MAX;
+        p_rankMinimumCount = 0;
+        p_rankPropagate = false;
       };
 
       //! Destroys the ProcessByBoxcar object.
@@ -78,6 +161,11 @@ namespace Isis {
         StartProcess(funct);
       }
 
+      void SetRankStatistic(RankStatistic statistic, double percentile = 50.0);
+      void SetRankValidRange(double minimum, double maximum);
+      void SetRankMinimumCount(int minimum, bool propagate);
+      void StartRankProcess(bool filter(double center) = NULL, int chunkLines = 0);
+
       void EndProcess();
       void Finalize();
   };
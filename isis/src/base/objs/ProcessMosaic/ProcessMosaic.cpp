@@ -21,6 +21,11 @@
  */
 #include "Preference.h"
 
+#include <QFuture>
+#include <QMutex>
+#include <QThreadPool>
+#include <QtConcurrentMap>
+
 #include "Application.h"
 #include "IException.h"
 #include "IString.h"
@@ -68,6 +73,8 @@ namespace Isis {
 
     m_enforceMatchDEM = false;
 
+    m_tiled = false;
+
     // Initialize the data members
     m_iss = -1;
     m_isl = -1;
@@ -374,15 +381,7 @@ namespace Isis {
 
     m_onb = OutputCubes[0]->bandCount();
 
-    if (m_trackingEnabled) {
-
-      // For mosaic creation, the input is copied onto mosaic by default
-      if (m_imageOverlay == UseBandPlacementCriteria && !m_createOutputMosaic) {
-        BandComparison(iss, isl, ins, inl,
-                       bandPriorityInputBandNumber, bandPriorityOutputBandNumber, iIndex);
-      }
-    }
-    else if (m_imageOverlay == AverageImageWithMosaic) {
+    if (!m_trackingEnabled && m_imageOverlay == AverageImageWithMosaic) {
       m_onb /= 2;
       if (m_onb < 1) {
         QString msg = "The mosaic cube needs a count band.";
@@ -390,136 +389,46 @@ namespace Isis {
       }
     }
 
-    // Process Band Priority with no tracking
-    if (m_imageOverlay == UseBandPlacementCriteria && !m_trackingEnabled ) {
-      BandPriorityWithNoTracking(iss, isl, isb, ins, inl, inb, bandPriorityInputBandNumber,
-                                 bandPriorityOutputBandNumber);
+    // Record everything needed to composite this input. Placements are
+    // composited now, or queued and composited tile by tile in parallel.
+    Placement placement;
+    placement.fileName = InputCubes[0]->fileName();
+    for (int band = 1; band <= InputCubes[0]->bandCount(); band++) {
+      placement.bands.push_back(toString(InputCubes[0]->physicalBand(band)));
     }
-    else {
-      // Create portal buffers for the input and output files
-      Portal iPortal(ins, 1, InputCubes[0]->pixelType());
-      Portal oPortal(ins, 1, OutputCubes[0]->pixelType());
-      Portal countPortal(ins, 1, OutputCubes[0]->pixelType());
-      Portal trackingPortal(ins, 1, PixelType::UnsignedInteger);
-
-      for (int ib = isb, ob = m_osb; ib < (isb + inb) && ob <= m_onb; ib++, ob++) {
-        for (int il = isl, ol = m_osl; il < isl + inl; il++, ol++) {
-          // Set the position of the portals in the input and output cubes
-          iPortal.SetPosition(iss, il, ib);
-          InputCubes[0]->read(iPortal);
-
-          oPortal.SetPosition(m_oss, ol, ob);
-          OutputCubes[0]->read(oPortal);
+    placement.iss = iss;
+    placement.isl = isl;
+    placement.isb = isb;
+    placement.ins = ins;
+    placement.inl = inl;
+    placement.inb = inb;
+    placement.oss = m_oss;
+    placement.osl = m_osl;
+    placement.osb = m_osb;
+    placement.onb = m_onb;
+    placement.create = m_createOutputMosaic;
+    placement.tracking = m_trackingEnabled;
+    placement.index = iIndex;
+    placement.overlay = m_imageOverlay;
+    placement.inputCompareBand = bandPriorityInputBandNumber;
+    placement.outputCompareBand = bandPriorityOutputBandNumber;
+    placement.useMaxValue = m_bandPriorityUseMaxValue;
+    placement.placeHighSatPixels = m_placeHighSatPixels;
+    placement.placeLowSatPixels = m_placeLowSatPixels;
+    placement.placeNullPixels = m_placeNullPixels;
 
-          if (m_trackingEnabled) {
-            trackingPortal.SetPosition(m_oss, ol, 1);
-            m_trackingCube->read(trackingPortal);
-          }
-          else if (m_imageOverlay == AverageImageWithMosaic) {
-            countPortal.SetPosition(m_oss, ol, (ob+m_onb));
-            OutputCubes[0]->read(countPortal);
-          }
+    if (m_trackingCube) {
+      m_trackingFile = m_trackingCube->fileName();
+    }
 
-          bool bChanged = false;
-          // Move the input data to the output
-          for (int pixel = 0; pixel < oPortal.size(); pixel++) {
-            // Creating Mosaic, copy the input onto mosaic
-            // regardless of the priority
-            if (m_createOutputMosaic) {
-              oPortal[pixel] = iPortal[pixel];
-              if (m_trackingEnabled) {
-                trackingPortal[pixel] = iIndex;
-                bChanged = true;
-              }
-              else if (m_imageOverlay == AverageImageWithMosaic) {
-                if (IsValidPixel(iPortal[pixel])) {
-                  countPortal[pixel]=1;
-                  bChanged = true;
-                }
-              }
-            }
-            // Band Priority
-            else if (m_trackingEnabled && m_imageOverlay == UseBandPlacementCriteria) {
-              int iPixelOrigin = qRound(trackingPortal[pixel]);
-
-              Portal iComparePortal( ins, 1, InputCubes[0]->pixelType() );
-              Portal oComparePortal( ins, 1, OutputCubes[0]->pixelType() );
-              iComparePortal.SetPosition(iss, il, bandPriorityInputBandNumber);
-              InputCubes[0]->read(iComparePortal);
-              oComparePortal.SetPosition(m_oss, ol, bandPriorityOutputBandNumber);
-              OutputCubes[0]->read(oComparePortal);
-
-              if (iPixelOrigin == iIndex) {
-                if ( ( IsValidPixel(iComparePortal[pixel]) &&
-                       IsValidPixel(oComparePortal[pixel]) ) &&
-                     ( (!m_bandPriorityUseMaxValue &&
-                        iComparePortal[pixel] < oComparePortal[pixel]) ||
-                       (m_bandPriorityUseMaxValue &&
-                        iComparePortal[pixel] > oComparePortal[pixel]) ) ) {
-
-                  if ( IsValidPixel(iPortal[pixel]) ||
-                       ( m_placeHighSatPixels && IsHighPixel(iPortal[pixel]) ) ||
-                       ( m_placeLowSatPixels  && IsLowPixel (iPortal[pixel]) ) ||
-                       ( m_placeNullPixels    && IsNullPixel(iPortal[pixel]) ) ){
-                    oPortal[pixel] = iPortal[pixel];
-                    bChanged = true;
-                  }
-                }
-                else { //bad comparison
-                  if ( ( IsValidPixel(iPortal[pixel]) && !IsValidPixel(oPortal[pixel]) ) ||
-                       ( m_placeHighSatPixels && IsHighPixel(iPortal[pixel]) ) ||
-                       ( m_placeLowSatPixels  && IsLowPixel (iPortal[pixel]) ) ||
-                       ( m_placeNullPixels    && IsNullPixel(iPortal[pixel]) ) ) {
-                    oPortal[pixel] = iPortal[pixel];
-                    bChanged = true;
-                  }
-                }
-              }
-            }
-            // OnTop/Input Priority
-            else if (m_imageOverlay == PlaceImagesOnTop) {
-              if (IsNullPixel(oPortal[pixel])  ||
-                 IsValidPixel(iPortal[pixel]) ||
-                 (m_placeHighSatPixels && IsHighPixel(iPortal[pixel])) ||
-                 (m_placeLowSatPixels  && IsLowPixel(iPortal[pixel]))  ||
-                 (m_placeNullPixels    && IsNullPixel(iPortal[pixel]))) {
-                oPortal[pixel] = iPortal[pixel];
-                if (m_trackingEnabled) {
-                  trackingPortal[pixel] = iIndex;
-                  bChanged = true;
-                }
-              }
-            }
-            // AverageImageWithMosaic priority
-            else if (m_imageOverlay == AverageImageWithMosaic) {
-              bChanged |= ProcessAveragePriority(pixel, iPortal, oPortal, countPortal);
-            }
-            // Beneath/Mosaic Priority
-            else if (m_imageOverlay == PlaceImagesBeneath) {
-              if (IsNullPixel(oPortal[pixel])) {
-                oPortal[pixel] = iPortal[pixel];
-                // Set the origin if number of input bands equal to 1
-                // and if the track flag was set
-                if (m_trackingEnabled) {
-                  trackingPortal[pixel] = iIndex;
-                  bChanged = true;
-                }
-              }
-            }
-          } // End sample loop
-          if (bChanged) {
-            if (m_trackingEnabled) {
-              m_trackingCube->write(trackingPortal);
-            }
-            if (m_imageOverlay == AverageImageWithMosaic) {
-              OutputCubes[0]->write(countPortal);
-            }
-          }
-          OutputCubes[0]->write(oPortal);
-          p_progress->CheckStatus();
-        } // End line loop
-      }   // End band loop
+    if (m_tiled) {
+      m_placements.append(placement);
+    }
+    else {
+      PlaceInput(placement, InputCubes[0], m_trackingCube,
+                 m_osl, m_osl + inl - 1, p_progress);
     }
+
     if (m_trackingCube) {
       m_trackingCube->close();
       delete m_trackingCube;
@@ -532,6 +441,7 @@ namespace Isis {
    * Cleans up by closing input, output and tracking cubes
    */
   void ProcessMosaic::EndProcess() {
+    ProcessTiles();
     if (m_trackingCube) {
       m_trackingCube->close();
       delete m_trackingCube;
@@ -541,6 +451,21 @@ namespace Isis {
   }
 
 
+  /**
+   * Composites any queued placements and cleans up by closing input, output and
+   * tracking cubes
+   */
+  void ProcessMosaic::Finalize() {
+    ProcessTiles();
+    if (m_trackingCube) {
+      m_trackingCube->close();
+      delete m_trackingCube;
+      m_trackingCube = NULL;
+    }
+    Process::Finalize();
+  }
+
+
   /**
    * Accessor for the placed images and their locations.
    *
@@ -831,6 +756,18 @@ namespace Isis {
   }
 
 
+  /**
+   * When true, StartProcess updates the mosaic labels and tracking table but
+   *   queues the pixel placement. The queued inputs are composited tile by tile
+   *   in parallel by ProcessTiles(), which is called from EndProcess() and
+   *   Finalize(). The resulting mosaic is identical to placing each input as
+   *   StartProcess is called.
+   */
+  void ProcessMosaic::SetTiledFlag(bool tiled) {
+    m_tiled = tiled;
+  }
+
+
   /**
    * @see SetHighSaturationFlag()
    */
@@ -871,6 +808,14 @@ namespace Isis {
   }
 
 
+  /**
+   * @see SetTiledFlag()
+   */
+  bool ProcessMosaic::GetTiledFlag() const {
+    return m_tiled;
+  }
+
+
   /**
    * This is the line where the image was placed into the output mosaic.
    */
@@ -1038,14 +983,16 @@ namespace Isis {
    * @author Sharmila Prasad (1/13/2011)
    *
    * @param piPixel     - Pixel index
+   * @param placement   - Placement of the input providing the special pixel flags
    * @param piPortal    - Input Portal
    * @param poPortal    - Output Portal
    * @param countPortal - Count Portal
    *
    * @return bool
    */
-  bool ProcessMosaic::ProcessAveragePriority(int piPixel, Portal& piPortal, Portal& poPortal,
-                                             Portal& countPortal)
+  bool ProcessMosaic::ProcessAveragePriority(int piPixel, const Placement &placement,
+                                             Portal& piPortal, Portal& poPortal,
+                                             Portal& countPortal) const
   {
     bool bChanged=false;
     if (IsValidPixel(piPortal[piPixel]) && IsValidPixel(poPortal[piPixel])) {
@@ -1063,9 +1010,9 @@ namespace Isis {
     }
     // Input-Special, Flags-True
     else if (IsSpecial(piPortal[piPixel])) {
-      if ((m_placeHighSatPixels && IsHighPixel(piPortal[piPixel])) ||
-         (m_placeLowSatPixels  && IsLowPixel (piPortal[piPixel]))  ||
-         (m_placeNullPixels    && IsNullPixel(piPortal[piPixel]))) {
+      if ((placement.placeHighSatPixels && IsHighPixel(piPortal[piPixel])) ||
+         (placement.placeLowSatPixels  && IsLowPixel (piPortal[piPixel]))  ||
+         (placement.placeNullPixels    && IsNullPixel(piPortal[piPixel]))) {
         poPortal[piPixel]    = piPortal[piPixel];
         countPortal[piPixel] = 0;
         bChanged = true;
@@ -1328,60 +1275,226 @@ namespace Isis {
   }
 
 
+  /**
+   * Composites one input onto the mosaic over a range of mosaic lines. This is
+   * the pixel placement for every priority. Every mosaic pixel only depends on
+   * the same pixel of the input, the mosaic, the count bands and the tracking
+   * cube, so disjoint line ranges of the mosaic can be composited concurrently
+   * as long as the inputs covering each range are placed in order.
+   *
+   * @param placement The input placement recorded by StartProcess
+   * @param input     The opened input cube
+   * @param tracking  The opened tracking cube, NULL if tracking is not enabled
+   * @param startLine The first mosaic line to composite
+   * @param endLine   The last mosaic line to composite
+   * @param progress  Progress to update for each line and band, or NULL
+   */
+  void ProcessMosaic::PlaceInput(const Placement &placement, Cube *input, Cube *tracking,
+                                 int startLine, int endLine, Progress *progress) const {
+    Cube *output = OutputCubes[0];
+
+    // Process Band Priority with no tracking
+    if (placement.overlay == UseBandPlacementCriteria && !placement.tracking) {
+      BandPriorityWithNoTracking(placement, input, startLine, endLine);
+      return;
+    }
+
+    // For mosaic creation, the input is copied onto mosaic by default
+    bool bandComparison = placement.tracking && !placement.create &&
+                          placement.overlay == UseBandPlacementCriteria;
+    if (bandComparison) {
+      BandComparison(placement, input, tracking, startLine, endLine);
+    }
+
+    // Create portal buffers for the input and output files
+    int ins = placement.ins;
+    Portal iPortal(ins, 1, input->pixelType());
+    Portal oPortal(ins, 1, output->pixelType());
+    Portal countPortal(ins, 1, output->pixelType());
+    Portal trackingPortal(ins, 1, PixelType::UnsignedInteger);
+    Portal iComparePortal(ins, 1, input->pixelType());
+    Portal oComparePortal(ins, 1, output->pixelType());
+
+    for (int ib = placement.isb, ob = placement.osb;
+         ib < (placement.isb + placement.inb) && ob <= placement.onb; ib++, ob++) {
+      for (int ol = startLine; ol <= endLine; ol++) {
+        int il = placement.isl + (ol - placement.osl);
+
+        // Set the position of the portals in the input and output cubes
+        iPortal.SetPosition(placement.iss, il, ib);
+        input->read(iPortal);
+
+        oPortal.SetPosition(placement.oss, ol, ob);
+        output->read(oPortal);
+
+        if (placement.tracking) {
+          trackingPortal.SetPosition(placement.oss, ol, 1);
+          tracking->read(trackingPortal);
+        }
+        else if (placement.overlay == AverageImageWithMosaic) {
+          countPortal.SetPosition(placement.oss, ol, (ob + placement.onb));
+          output->read(countPortal);
+        }
+
+        // The comparison bands do not change while the line is processed
+        if (bandComparison) {
+          iComparePortal.SetPosition(placement.iss, il, placement.inputCompareBand);
+          input->read(iComparePortal);
+          oComparePortal.SetPosition(placement.oss, ol, placement.outputCompareBand);
+          output->read(oComparePortal);
+        }
+
+        bool bChanged = false;
+        // Move the input data to the output
+        for (int pixel = 0; pixel < oPortal.size(); pixel++) {
+          // Creating Mosaic, copy the input onto mosaic
+          // regardless of the priority
+          if (placement.create) {
+            oPortal[pixel] = iPortal[pixel];
+            if (placement.tracking) {
+              trackingPortal[pixel] = placement.index;
+              bChanged = true;
+            }
+            else if (placement.overlay == AverageImageWithMosaic) {
+              if (IsValidPixel(iPortal[pixel])) {
+                countPortal[pixel]=1;
+                bChanged = true;
+              }
+            }
+          }
+          // Band Priority
+          else if (bandComparison) {
+            int iPixelOrigin = qRound(trackingPortal[pixel]);
+
+            if (iPixelOrigin == placement.index) {
+              if ( ( IsValidPixel(iComparePortal[pixel]) &&
+                     IsValidPixel(oComparePortal[pixel]) ) &&
+                   ( (!placement.useMaxValue &&
+                      iComparePortal[pixel] < oComparePortal[pixel]) ||
+                     (placement.useMaxValue &&
+                      iComparePortal[pixel] > oComparePortal[pixel]) ) ) {
+
+                if ( IsValidPixel(iPortal[pixel]) ||
+                     ( placement.placeHighSatPixels && IsHighPixel(iPortal[pixel]) ) ||
+                     ( placement.placeLowSatPixels  && IsLowPixel (iPortal[pixel]) ) ||
+                     ( placement.placeNullPixels    && IsNullPixel(iPortal[pixel]) ) ){
+                  oPortal[pixel] = iPortal[pixel];
+                  bChanged = true;
+                }
+              }
+              else { //bad comparison
+                if ( ( IsValidPixel(iPortal[pixel]) && !IsValidPixel(oPortal[pixel]) ) ||
+                     ( placement.placeHighSatPixels && IsHighPixel(iPortal[pixel]) ) ||
+                     ( placement.placeLowSatPixels  && IsLowPixel (iPortal[pixel]) ) ||
+                     ( placement.placeNullPixels    && IsNullPixel(iPortal[pixel]) ) ) {
+                  oPortal[pixel] = iPortal[pixel];
+                  bChanged = true;
+                }
+              }
+            }
+          }
+          // OnTop/Input Priority
+          else if (placement.overlay == PlaceImagesOnTop) {
+            if (IsNullPixel(oPortal[pixel])  ||
+               IsValidPixel(iPortal[pixel]) ||
+               (placement.placeHighSatPixels && IsHighPixel(iPortal[pixel])) ||
+               (placement.placeLowSatPixels  && IsLowPixel(iPortal[pixel]))  ||
+               (placement.placeNullPixels    && IsNullPixel(iPortal[pixel]))) {
+              oPortal[pixel] = iPortal[pixel];
+              if (placement.tracking) {
+                trackingPortal[pixel] = placement.index;
+                bChanged = true;
+              }
+            }
+          }
+          // AverageImageWithMosaic priority
+          else if (placement.overlay == AverageImageWithMosaic) {
+            bChanged |= ProcessAveragePriority(pixel, placement, iPortal, oPortal, countPortal);
+          }
+          // Beneath/Mosaic Priority
+          else if (placement.overlay == PlaceImagesBeneath) {
+            if (IsNullPixel(oPortal[pixel])) {
+              oPortal[pixel] = iPortal[pixel];
+              // Set the origin if number of input bands equal to 1
+              // and if the track flag was set
+              if (placement.tracking) {
+                trackingPortal[pixel] = placement.index;
+                bChanged = true;
+              }
+            }
+          }
+        } // End sample loop
+        if (bChanged) {
+          if (placement.tracking) {
+            tracking->write(trackingPortal);
+          }
+          if (placement.overlay == AverageImageWithMosaic) {
+            output->write(countPortal);
+          }
+        }
+        output->write(oPortal);
+        if (progress) {
+          progress->CheckStatus();
+        }
+      } // End line loop
+    }   // End band loop
+  }
+
+
   /**
    * This method compares the specified band of the input and
    * output using the criteria (lesser or greater) to assign the
-   * pixel origin(input fileindex) to the origin band. In the StartProcess(),
+   * pixel origin(input fileindex) to the origin band. In PlaceInput(),
    * input pixel is assigned to the output if the origin pixel equals the current
    * input file index
    *
-   * @param iss - Comparison start sample
-   * @param isl - Comparison start line
-   * @param ins - The number of samples to compare
-   * @param inl - The number of lines to compare
-   * @param bandPriorityInputBandNumber - The band in the input cube to use for comparison
-   * @param bandPriorityOutputBandNumber - The band in the output cube to use for comparison
-   * @param index - Tracking index for the input cube
+   * @param placement - The input placement with the comparison bands and tracking index
+   * @param input     - The opened input cube
+   * @param tracking  - The opened tracking cube
+   * @param startLine - The first mosaic line to compare
+   * @param endLine   - The last mosaic line to compare
    *
    * @author Sharmila Prasad (9/04/2009)
    */
-  void ProcessMosaic::BandComparison(int iss, int isl, int ins, int inl,
-      int bandPriorityInputBandNumber, int bandPriorityOutputBandNumber, int index) {
+  void ProcessMosaic::BandComparison(const Placement &placement, Cube *input, Cube *tracking,
+                                     int startLine, int endLine) const {
     //
     // Create portal buffers for the input and output files
-    Portal cIportal(ins, 1, InputCubes[0]->pixelType());
-    Portal cOportal(ins, 1, OutputCubes[0]->pixelType());
-    Portal trackingPortal(ins, 1, PixelType::UnsignedInteger);
+    Portal cIportal(placement.ins, 1, input->pixelType());
+    Portal cOportal(placement.ins, 1, OutputCubes[0]->pixelType());
+    Portal trackingPortal(placement.ins, 1, PixelType::UnsignedInteger);
+
+    for (int iOL = startLine; iOL <= endLine; iOL++) {
+      int iIL = placement.isl + (iOL - placement.osl);
 
-    for (int iIL = isl, iOL = m_osl; iIL < isl + inl; iIL++, iOL++) {
       // Set the position of the portals in the input and output cubes
-      cIportal.SetPosition(iss, iIL, bandPriorityInputBandNumber);
-      InputCubes[0]->read(cIportal);
+      cIportal.SetPosition(placement.iss, iIL, placement.inputCompareBand);
+      input->read(cIportal);
 
-      cOportal.SetPosition(m_oss, iOL, bandPriorityOutputBandNumber);
+      cOportal.SetPosition(placement.oss, iOL, placement.outputCompareBand);
       OutputCubes[0]->read(cOportal);
 
-      trackingPortal.SetPosition(m_oss, iOL, 1);
-      m_trackingCube->read(trackingPortal);
+      trackingPortal.SetPosition(placement.oss, iOL, 1);
+      tracking->read(trackingPortal);
 
       // Move the input data to the output
       for (int iPixel = 0; iPixel < cOportal.size(); iPixel++) {
-        if ((m_placeHighSatPixels && IsHighPixel(cIportal[iPixel])) ||
-            (m_placeLowSatPixels  && IsLowPixel(cIportal[iPixel])) ||
-            (m_placeNullPixels    && IsNullPixel(cIportal[iPixel]))) {
-          trackingPortal[iPixel] = index;
+        if ((placement.placeHighSatPixels && IsHighPixel(cIportal[iPixel])) ||
+            (placement.placeLowSatPixels  && IsLowPixel(cIportal[iPixel])) ||
+            (placement.placeNullPixels    && IsNullPixel(cIportal[iPixel]))) {
+          trackingPortal[iPixel] = placement.index;
         }
         else {
           if (IsValidPixel(cIportal[iPixel])) {
             if (IsSpecial(cOportal[iPixel]) ||
-                (m_bandPriorityUseMaxValue == false  && cIportal[iPixel] < cOportal[iPixel]) ||
-                (m_bandPriorityUseMaxValue == true && cIportal[iPixel] > cOportal[iPixel])) {
-              trackingPortal[iPixel] = index;
+                (placement.useMaxValue == false && cIportal[iPixel] < cOportal[iPixel]) ||
+                (placement.useMaxValue == true && cIportal[iPixel] > cOportal[iPixel])) {
+              trackingPortal[iPixel] = placement.index;
             }
           }
         }
       }
-      m_trackingCube->write(trackingPortal);
+      tracking->write(trackingPortal);
     }
   }
 
@@ -1389,46 +1502,51 @@ namespace Isis {
   /**
    * Mosaicking for Band Priority with no Tracking
    *
+   * @param placement - The input placement with the comparison bands
+   * @param input     - The opened input cube
+   * @param startLine - The first mosaic line to composite
+   * @param endLine   - The last mosaic line to composite
+   *
    * @author Sharmila Prasad (1/4/2012)
    */
-void ProcessMosaic::BandPriorityWithNoTracking(int iss, int isl, int isb, int ins, int inl,
-                                                 int inb, int bandPriorityInputBandNumber,
-                                                 int bandPriorityOutputBandNumber) {
+  void ProcessMosaic::BandPriorityWithNoTracking(const Placement &placement, Cube *input,
+                                                 int startLine, int endLine) const {
+    int ins = placement.ins;
+
     /*
      * specified band for comparison
      * Create portal buffers for the input and output files pointing to the
      */
-    Portal iComparePortal( ins, 1, InputCubes[0]->pixelType() );
+    Portal iComparePortal( ins, 1, input->pixelType() );
     Portal oComparePortal( ins, 1, OutputCubes[0]->pixelType() );
     Portal resultsPortal ( ins, 1, OutputCubes[0]->pixelType() );
 
     // Create portal buffers for the input and output files
-    Portal iPortal( ins, 1, InputCubes[0]->pixelType() );
+    Portal iPortal( ins, 1, input->pixelType() );
     Portal oPortal( ins, 1, OutputCubes[0]->pixelType() );
 
-    for (int inLine = isl, outLine = m_osl; inLine < isl + inl; inLine++, outLine++) {
+    for (int outLine = startLine; outLine <= endLine; outLine++) {
+      int inLine = placement.isl + (outLine - placement.osl);
+
 //       Set the position of the portals in the input and output cubes
-      iComparePortal.SetPosition(iss, inLine, bandPriorityInputBandNumber);
-      InputCubes[0]->read(iComparePortal);
+      iComparePortal.SetPosition(placement.iss, inLine, placement.inputCompareBand);
+      input->read(iComparePortal);
 
-      oComparePortal.SetPosition(m_oss, outLine, bandPriorityOutputBandNumber);
+      oComparePortal.SetPosition(placement.oss, outLine, placement.outputCompareBand);
       OutputCubes[0]->read(oComparePortal);
 
-      Portal iPortal( ins, 1, InputCubes[0]->pixelType() );
-      Portal oPortal( ins, 1, OutputCubes[0]->pixelType() );
-
       bool inCopy = false;
 //       Move the input data to the output
       for (int iPixel = 0; iPixel < ins; iPixel++) {
         resultsPortal[iPixel] = false;
-        if (m_createOutputMosaic) {
+        if (placement.create) {
           resultsPortal[iPixel] = true;
           inCopy = true;
         }
         else if ( IsValidPixel(iComparePortal[iPixel]) && IsValidPixel(oComparePortal[iPixel]) ) {
-          if ( (m_bandPriorityUseMaxValue == false  &&
+          if ( (placement.useMaxValue == false  &&
                 iComparePortal[iPixel] < oComparePortal[iPixel]) ||
-                (m_bandPriorityUseMaxValue == true &&
+                (placement.useMaxValue == true &&
                 iComparePortal[iPixel] > oComparePortal[iPixel]) ) {
             resultsPortal[iPixel] = true;
             inCopy = true;
@@ -1440,23 +1558,24 @@ void ProcessMosaic::BandPriorityWithNoTracking(int iss, int isl, int isb, int in
         }
       }
       if (inCopy) {
-        for (int ib = isb, ob = m_osb; ib < (isb + inb) && ob <= m_onb; ib++, ob++) {
+        for (int ib = placement.isb, ob = placement.osb;
+             ib < (placement.isb + placement.inb) && ob <= placement.onb; ib++, ob++) {
 //           Set the position of the portals in the input and output cubes
-          iPortal.SetPosition(iss, inLine, ib);
-          InputCubes[0]->read(iPortal);
+          iPortal.SetPosition(placement.iss, inLine, ib);
+          input->read(iPortal);
 
-          oPortal.SetPosition(m_oss, outLine, ob);
+          oPortal.SetPosition(placement.oss, outLine, ob);
           OutputCubes[0]->read(oPortal);
 
           for (int iPixel = 0; iPixel < ins; iPixel++) {
             if (resultsPortal[iPixel]) {
-              if (m_createOutputMosaic) {
+              if (placement.create) {
                 oPortal[iPixel] = iPortal[iPixel];
               }
               else if ( IsValidPixel(iPortal[iPixel]) ||
-                        (m_placeHighSatPixels && IsHighPixel(iPortal[iPixel]) ) ||
-                        (m_placeLowSatPixels  && IsLowPixel (iPortal[iPixel]) ) ||
-                        (m_placeNullPixels    && IsNullPixel(iPortal[iPixel]) ) ) {
+                        (placement.placeHighSatPixels && IsHighPixel(iPortal[iPixel]) ) ||
+                        (placement.placeLowSatPixels  && IsLowPixel (iPortal[iPixel]) ) ||
+                        (placement.placeNullPixels    && IsNullPixel(iPortal[iPixel]) ) ) {
                 oPortal[iPixel] = iPortal[iPixel];
               }
             }
@@ -1471,6 +1590,143 @@ void ProcessMosaic::BandPriorityWithNoTracking(int iss, int isl, int isb, int in
   }
 
 
+  /**
+   * Composites all placements queued by StartProcess while tiled processing is
+   * enabled. The mosaic is split into tiles of whole lines and the tiles are
+   * composited concurrently on the global thread pool. Within a tile, the inputs
+   * overlapping it are placed in the order StartProcess was called, so the
+   * mosaic, count bands and tracking cube are identical to placing the inputs
+   * one at a time. Each tile opens the inputs it overlaps, so only the inputs of
+   * the tiles being processed are open at any time.
+   *
+   * This is called by EndProcess and Finalize, so applications only need to
+   * call it directly to composite before then.
+   *
+   * @param tileLines Number of mosaic lines in a tile. If less than 1, the lines
+   *                  are split into four tiles per thread.
+   *
+   * @throws IException::User "Unable to composite mosaic lines"
+   */
+  void ProcessMosaic::ProcessTiles(int tileLines) {
+    if (m_placements.isEmpty()) {
+      return;
+    }
+
+    if (OutputCubes.size() != 1) {
+      QString m = "You must specify exactly one output cube";
+      throw IException(IException::Programmer, m, _FILEINFO_);
+    }
+
+    // Take the queue so a failure does not composite the placements again
+    QList<Placement> placements = m_placements;
+    m_placements.clear();
+
+    Cube *tracking = NULL;
+    for (int i = 0; i < placements.size() && !tracking; i++) {
+      if (placements[i].tracking) {
+        tracking = new Cube;
+        tracking->open(m_trackingFile, "rw");
+      }
+    }
+
+    int nlMosaic = OutputCubes[0]->lineCount();
+    if (tileLines < 1) {
+      int tiles = 4 * QThreadPool::globalInstance()->maxThreadCount();
+      tileLines = max(1, (nlMosaic + tiles - 1) / tiles);
+    }
+
+    QList<MosaicTile> tiles;
+    for (int line = 1; line <= nlMosaic; line += tileLines) {
+      MosaicTile tile;
+      tile.startLine = line;
+      tile.endLine = min(line + tileLines - 1, nlMosaic);
+      tile.failed = false;
+      tiles.append(tile);
+    }
+
+    p_progress->SetText("Compositing tiles");
+    p_progress->SetMaximumSteps(tiles.size());
+    p_progress->CheckStatus();
+
+    QFuture<void> future = QtConcurrent::map(tiles, TileFunctor(this, &placements, tracking));
+
+    // Translate the progress of the future into Isis progress
+    int reported = 0;
+    QMutex sleeper;
+    sleeper.lock();
+    while (!future.isFinished()) {
+      sleeper.tryLock(100);
+      for ( ; reported < future.progressValue(); reported++) {
+        p_progress->CheckStatus();
+      }
+    }
+    for ( ; reported < future.progressValue(); reported++) {
+      p_progress->CheckStatus();
+    }
+    sleeper.unlock();
+
+    if (tracking) {
+      tracking->close();
+      delete tracking;
+    }
+
+    for (int i = 0; i < tiles.size(); i++) {
+      if (tiles[i].failed) {
+        QString msg = "Unable to composite mosaic lines [" + toString(tiles[i].startLine) +
+                      "] to [" + toString(tiles[i].endLine) + "]";
+        throw IException(tiles[i].error, IException::User, msg, _FILEINFO_);
+      }
+    }
+  }
+
+
+  /**
+   * Constructs a functor that composites the placements overlapping a tile
+   *
+   * @param process    The mosaic process
+   * @param placements The placements in the order they were recorded
+   * @param tracking   The opened tracking cube, NULL if tracking is not enabled
+   */
+  ProcessMosaic::TileFunctor::TileFunctor(const ProcessMosaic *process,
+                                          const QList<Placement> *placements,
+                                          Cube *tracking) {
+    m_process = process;
+    m_placements = placements;
+    m_tracking = tracking;
+  }
+
+
+  /**
+   * Composites the placements overlapping a tile in order. Errors are stored in
+   * the tile and rethrown by ProcessTiles.
+   *
+   * @param tile The lines of the mosaic to composite
+   */
+  void ProcessMosaic::TileFunctor::operator()(MosaicTile &tile) const {
+    try {
+      for (int i = 0; i < m_placements->size(); i++) {
+        const Placement &placement = m_placements->at(i);
+        int startLine = max(tile.startLine, placement.osl);
+        int endLine = min(tile.endLine, placement.osl + placement.inl - 1);
+        if (startLine > endLine) {
+          continue;
+        }
+
+        Cube input;
+        if (placement.bands.size() != 0) {
+          input.setVirtualBands(placement.bands);
+        }
+        input.open(placement.fileName);
+        m_process->PlaceInput(placement, &input, m_tracking, startLine, endLine, NULL);
+      }
+    }
+    catch (IException &e) {
+      tile.failed = true;
+      tile.error = e;
+    }
+  }
+
+
   /**
    * This method  returns the defaults(unassigned origin value)
    * depending on the pixel type.
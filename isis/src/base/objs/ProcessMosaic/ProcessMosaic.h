@@ -22,10 +22,18 @@
  *   http://www.usgs.gov/privacy.html.
  */
 
+#include <vector>
+
+#include <QList>
+#include <QString>
+
+#include "IException.h"
 #include "Process.h"
 
 namespace Isis {
+  class Cube;
   class Portal;
+  class Progress;
 
   /**
    * @brief Mosaic two cubes together
@@ -58,6 +66,15 @@ namespace Isis {
    * Representation and Null DN values from the input to the mosaic. These options are
    * valid for only input(top) and band priorities.
    *
+   * Large mosaics can be composited in parallel by enabling tiled processing
+   * with SetTiledFlag(). StartProcess then updates the labels and tracking table
+   * for each input but defers the pixel placement. ProcessTiles(), which is
+   * called by EndProcess() and Finalize(), splits the mosaic into tiles of lines
+   * and composites each tile on its own thread, placing the inputs that overlap
+   * the tile in the order they were given. Every priority only relates pixels at
+   * the same mosaic location, so the mosaic, count bands and tracking cube are
+   * identical to the serial result.
+   *
    * Following are the values for the origin band depending on the pixel type
    * --------------------------------------------------------------
    * Pixel Type  Default     Start Value  Max Value  Total Images
@@ -241,6 +258,10 @@ namespace Isis {
 
       // Finish with tracking cube
       virtual void EndProcess();
+      virtual void Finalize();
+
+      // Composite the placements queued in tiled mode
+      void ProcessTiles(int tileLines = 0);
 
       // Accessor for the placed images.
       PvlObject imagePositions();
@@ -282,12 +303,14 @@ namespace Isis {
       void SetMatchDEM(bool matchDEM);
       void SetNullFlag(bool placeNullPixels);
       void SetTrackFlag(bool trackingEnabled);
+      void SetTiledFlag(bool tiled);
 
       bool GetHighSaturationFlag() const;
       ImageOverlay GetImageOverlay() const;
       bool GetLowSaturationFlag() const;
       bool GetNullFlag() const;
       bool GetTrackFlag() const;
+      bool GetTiledFlag() const;
 
       int GetInputStartLineInMosaic() const;
       int GetInputStartSampleInMosaic() const;
@@ -298,17 +321,75 @@ namespace Isis {
 
     private:
 
+      /**
+       * The placement of one input on the mosaic as determined by StartProcess.
+       * This holds everything needed to composite the input, so placements can
+       * be composited later and over any range of mosaic lines.
+       */
+      struct Placement {
+        QString fileName;           //!< The input cube file name
+        std::vector<QString> bands; //!< The physical bands of the input cube used
+        int iss;                    //!< The starting sample within the input cube
+        int isl;                    //!< The starting line within the input cube
+        int isb;                    //!< The starting band within the input cube
+        int ins;                    //!< The number of samples from the input cube
+        int inl;                    //!< The number of lines from the input cube
+        int inb;                    //!< The number of bands from the input cube
+        int oss;                    //!< The starting sample within the mosaic
+        int osl;                    //!< The starting line within the mosaic
+        int osb;                    //!< The starting band within the mosaic
+        int onb;                    //!< The number of data bands in the mosaic
+        bool create;                //!< The input creates the mosaic
+        bool tracking;              //!< Tracking is enabled
+        int index;                  //!< The tracking index of the input
+        ImageOverlay overlay;       //!< The mosaic priority
+        int inputCompareBand;       //!< The input band for band priority
+        int outputCompareBand;      //!< The mosaic band for band priority
+        bool useMaxValue;           //!< Band priority takes the greater value
+        bool placeHighSatPixels;    //!< Place high saturation input pixels
+        bool placeLowSatPixels;     //!< Place low saturation input pixels
+        bool placeNullPixels;       //!< Place null input pixels
+      };
+
+      /**
+       * A range of mosaic lines composited by one thread in tiled processing
+       */
+      struct MosaicTile {
+        int startLine;              //!< The first mosaic line of the tile
+        int endLine;                //!< The last mosaic line of the tile
+        bool failed;                //!< True if compositing the tile failed
+        IException error;           //!< The error if compositing failed
+      };
+
+      /**
+       * Functor for QtConcurrent that composites the placements overlapping a
+       * tile in order
+       */
+      class TileFunctor {
+        public:
+          TileFunctor(const ProcessMosaic *process, const QList<Placement> *placements,
+                      Cube *tracking);
+
+          void operator()(MosaicTile &tile) const;
+
+        private:
+          const ProcessMosaic *m_process;          //!< The mosaic process
+          const QList<Placement> *m_placements;    //!< The placements in order
+          Cube *m_tracking;                        //!< The tracking cube or NULL
+      };
+
+      // Composite one input onto a range of mosaic lines
+      void PlaceInput(const Placement &placement, Cube *input, Cube *tracking,
+                      int startLine, int endLine, Progress *progress) const;
+
       //Compare the input and mosaic for the specified band based on the criteria and update the
       //  mosaic origin band.
-      void BandComparison(int iss, int isl, int ins, int inl,
-                          int bandPriorityInputBandNumber, int bandPriorityOutputBandNumber,
-                          int index);
+      void BandComparison(const Placement &placement, Cube *input, Cube *tracking,
+                          int startLine, int endLine) const;
 
       // Mosaicking for Band Priority with no Tracking
-      void BandPriorityWithNoTracking(int iss, int isl, int isb,
-                                      int ins, int inl, int inb,
-                                      int bandPriorityInputBandNumber,
-                                      int bandPriorityOutputBandNumber);
+      void BandPriorityWithNoTracking(const Placement &placement, Cube *input,
+                                      int startLine, int endLine) const;
 
       // Get the default origin value based on pixel type for the origin band
       int GetOriginDefaultByPixelType();
@@ -328,8 +409,9 @@ namespace Isis {
       // Mosaic exists, match the band with the input image
       void MatchBandBinGroup(int origIsb, int &inb);
 
-      bool ProcessAveragePriority(int piPixel, Portal& pInPortal, Portal& pOutPortal,
-                                  Portal& pOrigPortal);
+      bool ProcessAveragePriority(int piPixel, const Placement &placement,
+                                  Portal& pInPortal, Portal& pOutPortal,
+                                  Portal& pOrigPortal) const;
 
       void ResetCountBands();
 
@@ -367,6 +449,10 @@ namespace Isis {
 
       PvlObject m_imagePositions; //!< List of images placed on the mosaic.
 
+      bool m_tiled;                   //!< Queue placements for tiled processing
+      QList<Placement> m_placements;  //!< Placements queued for tiled processing
+      QString m_trackingFile;         //!< The tracking cube of the queued placements
+
       /*
        * Set the Special Pixels Flags to True/False.
        * True- allow the special pixel to be passed onto the mosaic.
@@ -20,6 +20,7 @@
  *   http://www.usgs.gov/privacy.html.
  */
 
+#include <cmath>
 #include <iostream>
 #include <iomanip>
 
@@ -31,6 +32,7 @@
 #include "Brick.h"
 #include "Interpolator.h"
 #include "LeastSquares.h"
+#include "LineManager.h"
 #include "Portal.h"
 #include "ProcessRubberSheet.h"
 #include "TileManager.h"
@@ -157,6 +159,12 @@ namespace Isis {
       throw IException(IException::Programmer, m, _FILEINFO_);
     }
 
+    // Separable transforms do not need a quad tree
+    if (trans.IsSeparable()) {
+      SeparableGeom(trans, interp);
+      return;
+    }
+
     // allocate the sampMap/lineMap vectors
     p_lineMap.resize(p_startQuadSize);
     p_sampMap.resize(p_startQuadSize);
@@ -252,16 +260,26 @@ namespace Isis {
   void ProcessRubberSheet::SlowGeom(TileManager &otile, Portal &iportal,
                                     Transform &trans, Interpolator &interp) {
 
-    double outputSamp, outputLine;
     double inputSamp, inputLine;
     int outputBand = otile.Band();
 
-    for (int i = 0; i < otile.size(); i++) {
-      outputSamp = otile.Sample(i);
-      outputLine = otile.Line(i);
-      // Use the defined transform to find out what input pixel the output
-      // pixel came from
-      if (trans.Xform(inputSamp, inputLine, outputSamp, outputLine)) {
+    // Use the defined transform to find out what input pixel each output
+    // pixel of the tile came from
+    int count = otile.size();
+    QVector<double> outputSamps(count), outputLines(count);
+    QVector<double> inputSamps(count), inputLines(count);
+    QVector<bool> good(count);
+    for (int i = 0; i < count; i++) {
+      outputSamps[i] = otile.Sample(i);
+      outputLines[i] = otile.Line(i);
+    }
+    trans.Xforms(count, inputSamps.data(), inputLines.data(), outputSamps.constData(),
+                 outputLines.constData(), good.data());
+
+    for (int i = 0; i < count; i++) {
+      inputSamp = inputSamps[i];
+      inputLine = inputLines[i];
+      if (good[i]) {
         if ((inputSamp < 0.5) || (inputLine < 0.5) ||
             (inputLine > InputCubes[0]->lineCount() + 0.5) ||
             (inputSamp > InputCubes[0]->sampleCount() + 0.5)) {
@@ -282,6 +300,98 @@ namespace Isis {
   }
 
 
+  /**
+   * Resamples the input cube through a separable transform. The input sample
+   * of every output sample is computed once, and the input line once per
+   * output line. The input lines under the interpolator are read for the full
+   * width of the input cube once per output line and reused while the
+   * interpolator stays on them, so each output pixel is interpolated without
+   * transforming it or reading the input cube.
+   *
+   * @param trans The separable transform
+   * @param interp The interpolator
+   */
+  void ProcessRubberSheet::SeparableGeom(Transform &trans, Interpolator &interp) {
+    Cube *icube = InputCubes[0];
+    Cube *ocube = OutputCubes[0];
+    int inputSamples = icube->sampleCount();
+    int inputLines = icube->lineCount();
+    int windowSamples = interp.Samples();
+    int windowLines = interp.Lines();
+
+    // Map the output samples to the input. The input rows are padded by the
+    // interpolator width on each side so windows at the edges read Nulls the
+    // same way portals outside of the cube do.
+    int pad = windowSamples;
+    vector<bool> sampleGood(ocube->sampleCount());
+    vector<double> inputSample(ocube->sampleCount());
+    vector<int> windowStart(ocube->sampleCount());
+    for (int samp = 0; samp < ocube->sampleCount(); samp++) {
+      double isamp = 0.0;
+      sampleGood[samp] = trans.XformSample(isamp, samp + 1) &&
+                         isamp >= 0.5 && isamp <= inputSamples + 0.5;
+      inputSample[samp] = isamp;
+      windowStart[samp] = (int)floor(isamp - interp.HotSample()) - (1 - pad);
+    }
+
+    Brick rows(inputSamples + 2 * pad, windowLines, 1, icube->pixelType());
+    vector<double> window(windowSamples * windowLines);
+    LineManager oline(*ocube);
+
+    p_progress->SetMaximumSteps(ocube->lineCount() * ocube->bandCount());
+    p_progress->CheckStatus();
+
+    for (int band = 1; band <= ocube->bandCount(); band++) {
+      if (p_bandChangeFunct != NULL) {
+        p_bandChangeFunct(band);
+      }
+
+      int rowsStart = 0;
+      bool rowsRead = false;
+      for (int line = 1; line <= ocube->lineCount(); line++) {
+        oline.SetLine(line, band);
+
+        double iline = 0.0;
+        bool lineGood = trans.XformLine(iline, line) &&
+                        iline >= 0.5 && iline <= inputLines + 0.5;
+        if (!lineGood) {
+          for (int i = 0; i < oline.size(); i++) {
+            oline[i] = NULL8;
+          }
+        }
+        else {
+          int start = (int)floor(iline - interp.HotLine());
+          if (!rowsRead || start != rowsStart) {
+            rows.SetBasePosition(1 - pad, start, band);
+            icube->read(rows);
+            rowsStart = start;
+            rowsRead = true;
+          }
+
+          for (int samp = 0; samp < oline.size(); samp++) {
+            if (!sampleGood[samp]) {
+              oline[samp] = NULL8;
+              continue;
+            }
+
+            for (int l = 0; l < windowLines; l++) {
+              const double *row = rows.DoubleBuffer() + l * rows.SampleDimension() +
+                                  windowStart[samp];
+              for (int s = 0; s < windowSamples; s++) {
+                window[l * windowSamples + s] = row[s];
+              }
+            }
+            oline[samp] = interp.Interpolate(inputSample[samp], iline, &window[0]);
+          }
+        }
+
+        ocube->write(oline);
+        p_progress->CheckStatus();
+      }
+    }
+  }
+
+
   void ProcessRubberSheet::QuadTree(TileManager &otile, Portal &iportal,
                                     Transform &trans, Interpolator &interp,
                                     bool useLastTileMap) {
@@ -687,13 +797,30 @@ namespace Isis {
     Quad *quad = quadTree[0];
     double iline, isamp;
 
-    // Loop and do the slow computation of input position from output position
+    // Do the slow computation of input position from output position for
+    // the whole quad at once
+    int count = (quad->eline - quad->sline + 1) * (quad->esamp - quad->ssamp + 1);
+    QVector<double> osamps(count), olines(count), isamps(count), ilines(count);
+    QVector<bool> good(count);
+    int index = 0;
+    for (int oline = quad->sline; oline <= quad->eline; oline++) {
+      for (int osamp = quad->ssamp; osamp <= quad->esamp; osamp++, index++) {
+        osamps[index] = osamp;
+        olines[index] = oline;
+      }
+    }
+    trans.Xforms(count, isamps.data(), ilines.data(), osamps.constData(), olines.constData(),
+                 good.data());
+
+    index = 0;
     for (int oline = quad->sline; oline <= quad->eline; oline++) {
       int lineIndex = oline - quad->slineTile;
-      for (int osamp = quad->ssamp; osamp <= quad->esamp; osamp++) {
+      for (int osamp = quad->ssamp; osamp <= quad->esamp; osamp++, index++) {
         int sampIndex = osamp - quad->ssampTile;
         lineMap[lineIndex][sampIndex] = NULL8;
-        if (trans.Xform(isamp, iline, (double) osamp, (double) oline)) {
+        isamp = isamps[index];
+        iline = ilines[index];
+        if (good[index]) {
           if ((isamp >= 0.5) ||
               (iline >= 0.5) ||
               (iline <= InputCubes[0]->lineCount() + 0.5) ||
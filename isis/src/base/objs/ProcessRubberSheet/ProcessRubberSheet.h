@@ -45,6 +45,10 @@ namespace Isis {
    * an Interpolator object. This class allows only one input cube and one
    * output cube.
    *
+   * StartProcess resamples separable transforms (see Transform::IsSeparable)
+   * directly, one output line at a time, and only builds a quad tree of
+   * output tiles for other transforms.
+   *
    * @ingroup HighLevelCubeIO
    *
    * @author 2002-10-22 Stuart Sides
@@ -196,6 +200,8 @@ namespace Isis {
       bool TestLine(Transform &trans, int ssamp, int esamp, int sline,
                     int eline, int increment);
 
+      void SeparableGeom(Transform &trans, Interpolator &interp);
+
       void (*p_bandChangeFunct)(const int band);
 
       void transformPatch (double startingSample, double endingSample,
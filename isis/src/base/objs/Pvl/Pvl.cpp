@@ -26,11 +26,14 @@
 #include <locale>
 #include <fstream>
 
+#include <QFile>
+
 #include "FileName.h"
 #include "IException.h"
 #include "Message.h"
 #include "PvlTokenizer.h"
 #include "PvlFormat.h"
+#include "PvlParser.h"
 
 using namespace std;
 namespace Isis {
@@ -74,6 +77,23 @@ namespace Isis {
    * @throws Isis::iException::Io
    */
   void Pvl::read(const QString &file) {
+    read(file, QStringList());
+  }
+
+
+  /**
+   * Loads the keywords and groups at the top of a PVL file, but only the
+   * top level objects with the given names. This is much faster than reading
+   * every object when only part of a large label is needed, such as the
+   * IsisCube object of a cube with a large NaifKeywords object.
+   *
+   * @param file A file containing PVL information
+   * @param objectNames The names of the top level objects to read, or an
+   *                    empty list to read every object
+   *
+   * @throws Isis::iException::Io
+   */
+  void Pvl::read(const QString &file, const QStringList &objectNames) {
     // Expand the filename
     Isis::FileName temp(file);
     m_filename = temp.expanded();
@@ -86,7 +106,24 @@ namespace Isis {
       throw IException(IException::Io, message, _FILEINFO_);
     }
 
+    // Parse the file in place when possible, which is much faster than
+    // reading it through the stream
+    QFile pvlFile(m_filename);
+    if (pvlFile.open(QIODevice::ReadOnly) && !pvlFile.isSequential() &&
+        pvlFile.size() > 0) {
+      uchar *data = pvlFile.map(0, pvlFile.size());
+      if (data) {
+        PvlParser parser(reinterpret_cast<const char *>(data), pvlFile.size());
+        parser.setObjectNames(objectNames);
+        if (parser.read(*this)) {
+          istm.close();
+          return;
+        }
+      }
+    }
+
     // Read it
+    int firstObject = objects();
     try {
       istm >> *this;
     }
@@ -101,6 +138,20 @@ namespace Isis {
       throw IException(IException::Unknown, message, _FILEINFO_);
     }
     istm.close();
+
+    // The stream reads every object, so remove the ones that were not asked for
+    if (!objectNames.isEmpty()) {
+      for (int i = objects() - 1; i >= firstObject; i--) {
+        bool wanted = false;
+        for (int j = 0; !wanted && j < objectNames.size(); j++) {
+          wanted = object(i).isNamed(objectNames[j]);
+        }
+
+        if (!wanted) {
+          deleteObject(i);
+        }
+      }
+    }
   }
 
 
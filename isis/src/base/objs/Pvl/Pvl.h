@@ -24,6 +24,9 @@
  */
 
 #include <fstream>
+
+#include <QStringList>
+
 #include "PvlObject.h"
 
 namespace Isis {
@@ -146,6 +149,7 @@ namespace Isis {
       };
 
       void read(const QString &file);
+      void read(const QString &file, const QStringList &objectNames);
 
       void write(const QString &file);
       void append(const QString &file);
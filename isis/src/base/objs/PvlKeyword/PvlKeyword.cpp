@@ -135,7 +135,12 @@ namespace Isis {
    */
   void PvlKeyword::setName(QString name) {
     QString final = name.trimmed();
-    if (final.contains(QRegExp("\\s"))) {
+    bool hasWhitespace = false;
+    for (int i = 0; i < final.size() && !hasWhitespace; i++) {
+      hasWhitespace = final[i].isSpace();
+    }
+
+    if (hasWhitespace) {
       QString msg = "[" + name + "] is invalid. Keyword name cannot ";
       msg += "contain whitespace.";
       throw IException(IException::User, msg, _FILEINFO_);
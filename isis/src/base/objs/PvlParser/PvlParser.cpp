@@ -0,0 +1,647 @@
+/**
+ * @file
+ *
+ *   Unless noted otherwise, the portions of Isis written by the USGS are public
+ *   domain. See individual third-party library and package descriptions for
+ *   intellectual property information,user agreements, and related information.
+ *
+ *   Although Isis has been used by the USGS, no warranty, expressed or implied,
+ *   is made by the USGS as to the accuracy and functioning of such software
+ *   and related material nor shall the fact of distribution constitute any such
+ *   warranty, and no responsibility is assumed by the USGS in connection
+ *   therewith.
+ *
+ *   For additional information, launch
+ *   $ISISROOT/doc//documents/Disclaimers/Disclaimers.html in a browser or see
+ *   the Privacy &amp; Disclaimers page on the Isis website,
+ *   http://isis.astrogeology.usgs.gov, and the USGS privacy and disclaimers on
+ *   http://www.usgs.gov/privacy.html.
+ */
+#include "PvlParser.h"
+
+#include <cstring>
+
+#include <QByteArray>
+
+#include "IException.h"
+#include "Pvl.h"
+#include "PvlGroup.h"
+#include "PvlKeyword.h"
+#include "PvlObject.h"
+
+using namespace std;
+
+namespace Isis {
+
+  /**
+   * Returns true for the characters QString::trimmed() removes.
+   */
+  static inline bool isSpace(char c) {
+    return c == ' ' || (c >= '\t' && c <= '\r');
+  }
+
+
+  /**
+   * Skips the whitespace at the start of [begin, end).
+   */
+  static inline void trimStart(const char *&begin, const char *end) {
+    while (begin != end && isSpace(*begin)) {
+      begin++;
+    }
+  }
+
+
+  /**
+   * Creates a parser for a buffer. The buffer is not copied and must remain
+   * valid while the parser is used.
+   *
+   * @param data The first byte of the PVL
+   * @param size The number of bytes in the buffer
+   */
+  PvlParser::PvlParser(const char *data, qint64 size) {
+    m_position = data;
+    m_end = data + size;
+    m_good = true;
+  }
+
+
+  //! Destroys the parser
+  PvlParser::~PvlParser() {
+  }
+
+
+  /**
+   * Limits the top level objects that are read. Objects with other names are
+   * skipped, while keywords and groups at the top level are always read.
+   *
+   * @param names The names of the objects to read, or an empty list to read
+   *              every object
+   */
+  void PvlParser::setObjectNames(const QStringList &names) {
+    m_objectNames = names;
+  }
+
+
+  /**
+   * Reads the PVL in the buffer and appends it to a Pvl, like the stream
+   * operator does.
+   *
+   * @param pvl The Pvl to append to
+   *
+   * @return @b bool True if the PVL was read. False if it has to be read with
+   *                 the stream operator instead, in which case the Pvl has
+   *                 not been changed.
+   */
+  bool PvlParser::read(Pvl &pvl) {
+    PvlObject root("Root");
+
+    try {
+      PvlKeyword keyword;
+      if (!readKeyword(keyword)) {
+        return false;
+      }
+
+      while (!isNamed(keyword, "END")) {
+        if (isNamed(keyword, "ENDGROUP") || isNamed(keyword, "ENDOBJECT")) {
+          return false;
+        }
+
+        if (isNamed(keyword, "GROUP")) {
+          PvlGroup group;
+          if (!readGroup(keyword, &group)) {
+            return false;
+          }
+          root.addGroup(group);
+        }
+        else if (isNamed(keyword, "OBJECT")) {
+          bool wanted = m_objectNames.isEmpty();
+          for (int i = 0; !wanted && i < m_objectNames.size() && keyword.size() == 1; i++) {
+            wanted = PvlKeyword::stringEqual(m_objectNames[i], keyword[0]);
+          }
+
+          PvlObject object;
+          if (!readObject(keyword, wanted ? &object : NULL)) {
+            return false;
+          }
+
+          if (wanted) {
+            root.addObject(object);
+          }
+        }
+        else {
+          root.addKeyword(keyword);
+        }
+
+        // Binary data after the labels ends the PVL
+        if (!m_good || *m_position < 32 || *m_position > 126) {
+          break;
+        }
+
+        keyword = PvlKeyword();
+        if (!readKeyword(keyword)) {
+          return false;
+        }
+      }
+    }
+    catch (IException &) {
+      return false;
+    }
+
+    for (int i = 0; i < root.keywords(); i++) {
+      pvl.addKeyword(root[i]);
+    }
+    for (int i = 0; i < root.groups(); i++) {
+      pvl.addGroup(root.group(i));
+    }
+    for (int i = 0; i < root.objects(); i++) {
+      pvl.addObject(root.object(i));
+    }
+
+    return true;
+  }
+
+
+  /**
+   * Reads the contents of an object, through its EndObject keyword.
+   *
+   * @param objectKeyword The Object keyword that starts the object
+   * @param object The object to read into, or NULL to skip the object
+   *
+   * @return @b bool False if the stream operator has to read the PVL
+   */
+  bool PvlParser::readObject(const PvlKeyword &objectKeyword, PvlObject *object) {
+    if (objectKeyword.size() != 1) {
+      return false;
+    }
+
+    if (object) {
+      object->setName(objectKeyword[0]);
+      for (int i = 0; i < objectKeyword.comments(); i++) {
+        object->addComment(objectKeyword.comment(i));
+      }
+    }
+
+    PvlKeyword keyword;
+    if (!readKeyword(keyword, !object)) {
+      return false;
+    }
+
+    while (!isNamed(keyword, "ENDOBJECT")) {
+      if (isNamed(keyword, "ENDGROUP")) {
+        return false;
+      }
+
+      if (isNamed(keyword, "GROUP")) {
+        PvlGroup group;
+        if (!readGroup(keyword, object ? &group : NULL)) {
+          return false;
+        }
+        if (object) {
+          object->addGroup(group);
+        }
+      }
+      else if (isNamed(keyword, "OBJECT")) {
+        PvlObject child;
+        if (!readObject(keyword, object ? &child : NULL)) {
+          return false;
+        }
+        if (object) {
+          object->addObject(child);
+        }
+      }
+      else if (object) {
+        object->addKeyword(keyword);
+      }
+
+      keyword = PvlKeyword();
+      if (!readKeyword(keyword, !object)) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+
+  /**
+   * Reads the contents of a group, through its EndGroup keyword.
+   *
+   * @param groupKeyword The Group keyword that starts the group
+   * @param group The group to read into, or NULL to skip the group
+   *
+   * @return @b bool False if the stream operator has to read the PVL
+   */
+  bool PvlParser::readGroup(const PvlKeyword &groupKeyword, PvlGroup *group) {
+    if (groupKeyword.size() != 1) {
+      return false;
+    }
+
+    if (group) {
+      group->setName(groupKeyword[0]);
+      for (int i = 0; i < groupKeyword.comments(); i++) {
+        group->addComment(groupKeyword.comment(i));
+      }
+    }
+
+    PvlKeyword keyword;
+    if (!readKeyword(keyword, !group)) {
+      return false;
+    }
+
+    while (m_good && !isNamed(keyword, "ENDGROUP")) {
+      if (isNamed(keyword, "GROUP") || isNamed(keyword, "OBJECT") ||
+          isNamed(keyword, "ENDOBJECT")) {
+        return false;
+      }
+
+      if (group) {
+        group->addKeyword(keyword);
+      }
+
+      keyword = PvlKeyword();
+      if (!readKeyword(keyword, !group)) {
+        return false;
+      }
+    }
+
+    return isNamed(keyword, "ENDGROUP");
+  }
+
+
+  /**
+   * Reads the next keyword along with the comments before it. Keywords can
+   * span several lines, either because a line ends with '-', or because a
+   * quote or array has not been closed, or because the units are on the next
+   * line.
+   *
+   * @param keyword The keyword to read into
+   * @param skip If true, the keyword is being skipped. Only its name and
+   *             number of values are set.
+   *
+   * @return @b bool False if the stream operator has to read the PVL
+   */
+  bool PvlParser::readKeyword(PvlKeyword &keyword, bool skip) {
+    if (!m_good) {
+      return false;
+    }
+
+    vector<QString> comments;
+    // The text of a keyword that spans several lines
+    QByteArray text;
+
+    while (true) {
+      const char *begin;
+      const char *end;
+      if (!readLine(begin, end)) {
+        return false;
+      }
+
+      // Running out of data before a keyword is the implicit End keyword
+      if (begin == end) {
+        if (!text.isEmpty()) {
+          return false;
+        }
+        begin = "End";
+        end = begin + 3;
+      }
+
+      if (begin[0] == '#' || (end - begin > 1 && begin[0] == '/' && begin[1] == '/')) {
+        if (!text.isEmpty()) {
+          return false;
+        }
+        if (!skip) {
+          comments.push_back(QString::fromLatin1(begin, end - begin));
+        }
+        continue;
+      }
+
+      const char *keywordBegin = begin;
+      const char *keywordEnd = end;
+      if (!text.isEmpty() || end[-1] == '-') {
+        if (text.endsWith('-')) {
+          text.chop(1);
+        }
+        else if (!text.isEmpty()) {
+          text.append(' ');
+        }
+        text.append(begin, end - begin);
+
+        if (end[-1] == '-') {
+          continue;
+        }
+
+        keywordBegin = text.constData();
+        keywordEnd = keywordBegin + text.size();
+      }
+
+      QString name;
+      vector< pair<QString, QString> > values;
+      vector<QString> trailingComments;
+
+      ScanStatus status = scanKeyword(keywordBegin, keywordEnd, name, values, skip);
+      if (status == Unknown) {
+        QString keywordString = QString::fromLatin1(keywordBegin, keywordEnd - keywordBegin);
+        status = PvlKeyword::readCleanKeyword(keywordString, trailingComments, name, values) ?
+                 Complete : Incomplete;
+      }
+
+      // Keep reading if the keyword is not finished or its units are on the
+      // next line
+      if (status == Incomplete || (m_good && *m_position == '<' && !values.empty())) {
+        if (!m_good) {
+          return false;
+        }
+        if (text.isEmpty()) {
+          text = QByteArray(keywordBegin, keywordEnd - keywordBegin);
+        }
+        continue;
+      }
+
+      keyword.setName(name);
+      keyword.addComments(comments);
+      keyword.addComments(trailingComments);
+      for (unsigned int i = 0; i < values.size(); i++) {
+        keyword.addValue(values[i].first, values[i].second);
+      }
+
+      return true;
+    }
+  }
+
+
+  /**
+   * Finds the next line that is not blank and trims it, like
+   * PvlKeyword::readLine. An empty line is returned once the data ends.
+   *
+   * @param begin The first character of the line (OUTPUT)
+   * @param end One past the last character of the line (OUTPUT)
+   *
+   * @return @b bool False if the stream operator has to read the PVL
+   */
+  bool PvlParser::readLine(const char *&begin, const char *&end) {
+    while (m_good) {
+      const char *lineStart = m_position;
+      const char *pos = m_position;
+      while (pos != m_end && *pos != '\n' && *pos > 0) {
+        // Comments that can span lines change where lines end
+        if (*pos == '*' && pos != lineStart && pos[-1] == '/') {
+          return false;
+        }
+        pos++;
+      }
+
+      // The data ends with this line, which is used as is
+      if (pos == m_end || *pos <= 0) {
+        m_position = m_end;
+        m_good = false;
+
+        if (pos != lineStart && (isSpace(*lineStart) || isSpace(pos[-1]))) {
+          return false;
+        }
+
+        begin = lineStart;
+        end = pos;
+        return true;
+      }
+
+      begin = lineStart;
+      end = pos;
+      trimStart(begin, end);
+      while (end != begin && isSpace(end[-1])) {
+        end--;
+      }
+
+      m_position = pos + 1;
+      while (m_position != m_end &&
+             (*m_position == ' ' || *m_position == '\r' || *m_position == '\n')) {
+        m_position++;
+      }
+      m_good = m_position != m_end;
+
+      if (begin != end) {
+        return true;
+      }
+    }
+
+    begin = end = m_position;
+    return true;
+  }
+
+
+  /**
+   * Reads the name, values and units of a keyword from its text, the same way
+   * PvlKeyword::readCleanKeyword does.
+   *
+   * @param begin The first character of the keyword, which is not whitespace
+   * @param end One past the last character, which is not whitespace
+   * @param name The keyword name (OUTPUT)
+   * @param values The values and units (OUTPUT)
+   * @param skip If true, the values and units are left empty
+   *
+   * @return @b ScanStatus Unknown if the text is not a simple keyword, for
+   *                       example because it has a comment at the end or is
+   *                       not valid PVL
+   */
+  PvlParser::ScanStatus PvlParser::scanKeyword(const char *begin, const char *end,
+                                               QString &name,
+                                               vector< pair<QString, QString> > &values,
+                                               bool skip) {
+    bool quoteProblem = false;
+    const char *pos = begin;
+
+    scanValue(pos, end, &name, quoteProblem);
+    if (pos == end) {
+      return Complete;
+    }
+
+    if (*pos != '=') {
+      return Unknown;
+    }
+    pos++;
+    trimStart(pos, end);
+
+    if (pos == end) {
+      return Incomplete;
+    }
+
+    if (*pos == '(' || *pos == '{') {
+      char closingParen = (*pos == '(') ? ')' : '}';
+      char wrongClosingParen = (*pos == '(') ? '}' : ')';
+      pos++;
+      trimStart(pos, end);
+
+      bool closedProperly = (pos != end && *pos == closingParen);
+
+      while (pos != end && *pos != closingParen) {
+        pair<QString, QString> value;
+        if (!scanValue(pos, end, skip ? NULL : &value.first, quoteProblem, true)) {
+          return Unknown;
+        }
+
+        if (pos != end && *pos == wrongClosingParen) {
+          return Unknown;
+        }
+
+        if (pos != end && *pos == '<') {
+          scanValue(pos, end, skip ? NULL : &value.second, quoteProblem);
+        }
+
+        bool foundComma = false;
+        if (pos != end && *pos == ',') {
+          foundComma = true;
+          pos++;
+          trimStart(pos, end);
+        }
+
+        if (!foundComma && pos == end) {
+          return Incomplete;
+        }
+
+        bool foundCloseParen = (pos != end && *pos == closingParen);
+        if (foundCloseParen) {
+          closedProperly = true;
+        }
+
+        if (foundComma && foundCloseParen) {
+          return Unknown;
+        }
+
+        if (!foundComma && !foundCloseParen) {
+          return quoteProblem ? Incomplete : Unknown;
+        }
+
+        values.push_back(value);
+      }
+
+      if (!closedProperly) {
+        return Incomplete;
+      }
+
+      if (pos != end) {
+        pos++;
+        trimStart(pos, end);
+      }
+
+      // Units after the array apply to every value without its own
+      if (pos != end && *pos == '<') {
+        QString units;
+        scanValue(pos, end, skip ? NULL : &units, quoteProblem);
+        for (unsigned int i = 0; i < values.size(); i++) {
+          if (values[i].second.isEmpty()) {
+            values[i].second = units;
+          }
+        }
+      }
+    }
+    else {
+      pair<QString, QString> value;
+      scanValue(pos, end, skip ? NULL : &value.first, quoteProblem);
+
+      if (pos != end && *pos == '<') {
+        scanValue(pos, end, skip ? NULL : &value.second, quoteProblem);
+      }
+
+      values.push_back(value);
+    }
+
+    if (quoteProblem) {
+      return Incomplete;
+    }
+
+    return (pos == end) ? Complete : Unknown;
+  }
+
+
+  /**
+   * Reads a name, value or units from the start of [begin, end), the same way
+   * PvlKeyword::readValue does, and moves begin past it and the whitespace
+   * that follows.
+   *
+   * @param begin The start of the text, which is moved past the value
+   * @param end One past the last character, which is not whitespace
+   * @param value The value without its quotes, or NULL if it is not needed
+   *              (OUTPUT)
+   * @param quoteProblem Set to true if a quote is not closed, in which case
+   *                     begin is not moved
+   * @param inArray True if the value is an element of an array
+   *
+   * @return @b bool False if the value is a nested array
+   */
+  bool PvlParser::scanValue(const char *&begin, const char *end, QString *value,
+                            bool &quoteProblem, bool inArray) {
+    trimStart(begin, end);
+    if (value) {
+      *value = QString();
+    }
+
+    if (begin == end) {
+      return true;
+    }
+
+    if (inArray && (*begin == '(' || *begin == '{')) {
+      return false;
+    }
+
+    if (*begin == '\'' || *begin == '"' || *begin == '<') {
+      char quoteEnd = (*begin == '<') ? '>' : *begin;
+      const char *close = static_cast<const char *>(memchr(begin + 1, quoteEnd, end - begin - 1));
+
+      if (!close) {
+        quoteProblem = true;
+        return true;
+      }
+
+      if (value) {
+        *value = QString::fromLatin1(begin + 1, close - begin - 1);
+      }
+      begin = close + 1;
+    }
+    else {
+      const char *pos = begin;
+      while (pos != end && *pos != ')' && *pos != '}' && *pos != ',' && *pos != ' ' &&
+             *pos != '\t' && *pos != '<' && *pos != '=') {
+        pos++;
+      }
+
+      if (value) {
+        *value = QString::fromLatin1(begin, pos - begin);
+      }
+      begin = pos;
+    }
+
+    trimStart(begin, end);
+    return true;
+  }
+
+
+  /**
+   * Compares a keyword name to an upper case name the way PvlKeyword's
+   * comparison operators do, ignoring case and underscores.
+   *
+   * @param keyword The keyword to check
+   * @param name The upper case name without underscores
+   *
+   * @return @b bool True if the keyword has the name
+   */
+  bool PvlParser::isNamed(const PvlKeyword &keyword, const char *name) {
+    QString keywordName = keyword.name();
+    int pos = 0;
+
+    for (; *name; name++) {
+      while (pos < keywordName.size() && keywordName[pos] == '_') {
+        pos++;
+      }
+
+      if (pos == keywordName.size() || keywordName[pos].toUpper() != QLatin1Char(*name)) {
+        return false;
+      }
+      pos++;
+    }
+
+    while (pos < keywordName.size() && keywordName[pos] == '_') {
+      pos++;
+    }
+
+    return pos == keywordName.size();
+  }
+}
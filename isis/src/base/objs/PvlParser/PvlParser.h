@@ -0,0 +1,97 @@
+#ifndef PvlParser_h
+#define PvlParser_h
+/**
+ * @file
+ *
+ *   Unless noted otherwise, the portions of Isis written by the USGS are public
+ *   domain. See individual third-party library and package descriptions for
+ *   intellectual property information,user agreements, and related information.
+ *
+ *   Although Isis has been used by the USGS, no warranty, expressed or implied,
+ *   is made by the USGS as to the accuracy and functioning of such software
+ *   and related material nor shall the fact of distribution constitute any such
+ *   warranty, and no responsibility is assumed by the USGS in connection
+ *   therewith.
+ *
+ *   For additional information, launch
+ *   $ISISROOT/doc//documents/Disclaimers/Disclaimers.html in a browser or see
+ *   the Privacy &amp; Disclaimers page on the Isis website,
+ *   http://isis.astrogeology.usgs.gov, and the USGS privacy and disclaimers on
+ *   http://www.usgs.gov/privacy.html.
+ */
+
+#include <utility>
+#include <vector>
+
+#include <QString>
+#include <QStringList>
+#include <QtGlobal>
+
+namespace Isis {
+  class Pvl;
+  class PvlGroup;
+  class PvlKeyword;
+  class PvlObject;
+
+  /**
+   * @brief Reads PVL from a buffer in memory
+   *
+   * The stream operators that read PVL get one character at a time from the
+   * stream and build every keyword by repeatedly cutting up a QString, which
+   * dominates the time it takes to open cubes with large labels and to read
+   * control networks stored as PVL. This class reads the same PVL from a byte
+   * range, usually a memory mapped file, by scanning it in place and only
+   * creating strings for the names, values, units and comments it stores.
+   *
+   * The parser follows the stream operators exactly, so the Pvl it builds is
+   * the same one they would build. Anything unusual, such as C style
+   * comments, syntax errors or binary data in the middle of a line, makes
+   * read() return false without changing the Pvl, and the caller reads the
+   * PVL with the stream operators instead. That keeps the error messages and
+   * line numbers users see unchanged.
+   *
+   * The parser can also skip top level objects that are not needed, such as
+   * the NaifKeywords and Table objects of a cube label when only its
+   * dimensions are wanted. Skipped objects are checked for the same syntax
+   * but no keywords are created for them.
+   *
+   * @ingroup Parsing
+   */
+  class PvlParser {
+    public:
+      PvlParser(const char *data, qint64 size);
+      ~PvlParser();
+
+      void setObjectNames(const QStringList &names);
+
+      bool read(Pvl &pvl);
+
+    private:
+      //! The result of scanning the text of a keyword
+      enum ScanStatus {
+        Complete,   //!< The keyword has been read
+        Incomplete, //!< The keyword continues on the next line
+        Unknown     //!< The keyword has to be read by PvlKeyword
+      };
+
+      bool readObject(const PvlKeyword &objectKeyword, PvlObject *object);
+      bool readGroup(const PvlKeyword &groupKeyword, PvlGroup *group);
+      bool readKeyword(PvlKeyword &keyword, bool skip = false);
+      bool readLine(const char *&begin, const char *&end);
+
+      static ScanStatus scanKeyword(const char *begin, const char *end,
+                                    QString &name,
+                                    std::vector< std::pair<QString, QString> > &values,
+                                    bool skip);
+      static bool scanValue(const char *&begin, const char *end, QString *value,
+                            bool &quoteProblem, bool inArray = false);
+      static bool isNamed(const PvlKeyword &keyword, const char *name);
+
+      const char *m_position; //!< The next byte to read
+      const char *m_end;      //!< One past the last byte of the buffer
+      bool m_good;            //!< False once the data ends, like istream::good()
+      QStringList m_objectNames; //!< The top level objects to read, or empty for all
+  };
+}
+
+#endif
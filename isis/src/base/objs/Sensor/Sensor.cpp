@@ -37,6 +37,7 @@
 #include "iTime.h"
 #include "Latitude.h"
 #include "Longitude.h"
+#include "NaifMath.h"
 #include "NaifStatus.h"
 #include "Projection.h"
 #include "ShapeModel.h"
@@ -59,6 +60,8 @@ namespace Isis {
    * @param cube Cube whose label contains Instrument and Kernels groups.
    */
   Sensor::Sensor(Cube &cube) : Spice(cube) {
+    m_collectedPositions = NULL;
+    m_collectedLookDirections = NULL;
   }
 
 
@@ -184,12 +187,45 @@ namespace Isis {
     const vector<double> &sB = bodyRotation()->ReferenceVector(
         instrumentPosition()->Coordinate());
 
+    // Only collect the look direction to be traced later with the others
+    if (m_collectedPositions) {
+      m_collectedPositions->push_back(sB);
+      m_collectedLookDirections->push_back(lookB);
+      target()->shape()->setHasIntersection(false);
+      return false;
+    }
+
     // double tolerance = resolution() / 100.0; return
     // target()->shape()->intersectSurface(sB, lookB, tolerance);
     return target()->shape()->intersectSurface(sB, lookB);
   }
 
 
+  /**
+   * Starts or stops collecting the body-fixed observer positions and look
+   * directions of SetLookDirection. While collecting, SetLookDirection adds
+   * them to the vectors and returns false without intersecting the target, so
+   * a batch of look directions can be passed to
+   * ShapeModel::prepareIntersections.
+   *
+   * @param observerPositions The vector to add the observer positions to, or
+   *                          NULL to stop collecting
+   * @param lookDirections The vector to add the look directions to, or NULL to
+   *                       stop collecting
+   */
+  void Sensor::collectLookDirections(std::vector< std::vector<double> > *observerPositions,
+                                     std::vector< std::vector<double> > *lookDirections) {
+    if (observerPositions && lookDirections) {
+      m_collectedPositions = observerPositions;
+      m_collectedLookDirections = lookDirections;
+    }
+    else {
+      m_collectedPositions = NULL;
+      m_collectedLookDirections = NULL;
+    }
+  }
+
+
   /**
    * Returns if the last call to either SetLookDirection or
    * SetUniversalGround had a valid intersection with the target. If so then
@@ -657,8 +693,8 @@ namespace Isis {
     pB[1] = shape->surfaceIntersection()->GetY().kilometers();
     pB[2] = shape->surfaceIntersection()->GetZ().kilometers();
 
-    vsub_c(pB, (SpiceDouble *) &sB[0], psB);
-    unorm_c(psB, upsB, &dist);
+    NaifMath::vsub(pB, &sB[0], psB);
+    NaifMath::unorm(psB, upsB, dist);
     return dist;
   }
 
@@ -725,7 +761,7 @@ namespace Isis {
 
     // Now with the 3 spherical value compute the x/y/z coordinate
     double ssB[3];
-    latrec_c(rad.kilometers(), rlon, rlat, ssB);
+    NaifMath::latrec(rad.kilometers(), rlon, rlat, ssB);
 
     // Calc the change
     double xChange = spB[0] - ssB[0];
@@ -248,6 +248,10 @@ namespace Isis {
       virtual QString spacecraftNameLong() const = 0;
       virtual QString spacecraftNameShort() const = 0;
 
+    protected:
+      void collectLookDirections(std::vector< std::vector<double> > *observerPositions,
+                                 std::vector< std::vector<double> > *lookDirections);
+
     private:
       // This version of DemRadius is for SetLookDirection ONLY. Do not call.
       // DAC TODO Why is next declaration here? Don't move until I know
@@ -261,6 +265,15 @@ namespace Isis {
       SpiceDouble m_dec;    //!< Decliation (sky latitude)
       void computeRaDec();  //!< Computes the ra/dec from the look direction
       bool SetGroundLocal(bool backCheck);   //!< Computes look vector
+
+      std::vector< std::vector<double> > *m_collectedPositions; /**!< Collects the observer
+                                                                      positions of
+                                                                      SetLookDirection instead of
+                                                                      intersecting, if set. */
+      std::vector< std::vector<double> > *m_collectedLookDirections; /**!< Collects the look
+                                                                           directions of
+                                                                           SetLookDirection, if
+                                                                           set. */
   };
 };
 
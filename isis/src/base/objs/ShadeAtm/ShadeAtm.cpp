@@ -6,6 +6,11 @@
 
 namespace Isis {
   ShadeAtm::ShadeAtm(Pvl &pvl, PhotoModel &pmodel, AtmosModel &amodel) : NormModel(pvl, pmodel, amodel) {
+    p_normOldPhase = -9999;
+    p_normOldIncidence = -9999;
+    p_normOldEmission = -9999;
+    p_normOldDemincidence = -9999;
+    p_normOldDememission = -9999;
     PvlGroup &algorithm = pvl.findObject("NormalizationModel").findGroup("Algorithm", Pvl::Traverse);
 
     SetNormPharef(0.0);
@@ -51,21 +56,12 @@ namespace Isis {
                                     double &albedo, double &mult, double &base) {
     double rho;
     double psurfref;
-    static double psurf;
-    static double ahInterp;
-    static double munot;
     double pstd;
     double trans;
     double trans0;
     double transs;
     double sbar;
 
-    static double old_phase = -9999;
-    static double old_incidence = -9999;
-    static double old_emission = -9999;
-    static double old_demincidence = -9999;
-    static double old_dememission = -9999;
-
     // Calculate normalization at standard conditions
     GetPhotoModel()->SetStandardConditions(true);
     psurfref = GetPhotoModel()->CalcSurfAlbedo(p_normPharef, p_normIncref, p_normEmaref);
@@ -81,27 +77,30 @@ namespace Isis {
 
     rho = p_normAlbedo / psurfref;
 
-    if (old_phase != phase || old_incidence != incidence || old_emission != emission ||
-        old_demincidence != demincidence || old_dememission != dememission) {
+    if (p_normOldPhase != phase || p_normOldIncidence != incidence ||
+        p_normOldEmission != emission || p_normOldDemincidence != demincidence ||
+        p_normOldDememission != dememission) {
 
-      psurf = GetPhotoModel()->CalcSurfAlbedo(phase, demincidence, dememission);
+      p_normPsurf = GetPhotoModel()->CalcSurfAlbedo(phase, demincidence, dememission);
 
-      ahInterp = (GetAtmosModel()->AtmosAhSpline()).Evaluate(incidence, NumericalApproximation::Extrapolate);
+      p_normAhInterp = (GetAtmosModel()->AtmosAhSpline()).Evaluate(incidence,
+                           NumericalApproximation::Extrapolate);
 
-      munot = cos(incidence * (PI / 180.0));
+      p_normMunot = cos(incidence * (PI / 180.0));
 
-      old_phase = phase;
-      old_incidence = incidence;
-      old_emission = emission;
-      old_demincidence = demincidence;
-      old_dememission = dememission;
+      p_normOldPhase = phase;
+      p_normOldIncidence = incidence;
+      p_normOldEmission = emission;
+      p_normOldDemincidence = demincidence;
+      p_normOldDememission = dememission;
     }
 
     GetAtmosModel()->CalcAtmEffect(phase, incidence, emission, &pstd, &trans, &trans0, &sbar,
                                    &transs);
 
-    albedo = pstd + rho * (ahInterp * munot * trans /
-                           (1.0 - rho * GetAtmosModel()->AtmosAb() * sbar) + (psurf - ahInterp * munot) * trans0);
+    albedo = pstd + rho * (p_normAhInterp * p_normMunot * trans /
+                           (1.0 - rho * GetAtmosModel()->AtmosAb() * sbar) +
+                           (p_normPsurf - p_normAhInterp * p_normMunot) * trans0);
   }
 
   /**
@@ -71,6 +71,14 @@ namespace Isis {
       double p_normEmaref;
       double p_normAlbedo;
 
+      double p_normPsurf; //!< The surface brightness at the last geometry
+      double p_normAhInterp; //!< The hemispheric albedo at the last incidence angle
+      double p_normMunot; //!< The cosine of the last incidence angle
+      double p_normOldPhase; //!< The phase angle of the last geometry
+      double p_normOldIncidence; //!< The incidence angle of the last geometry
+      double p_normOldEmission; //!< The emission angle of the last geometry
+      double p_normOldDemincidence; //!< The DEM incidence angle of the last geometry
+      double p_normOldDememission; //!< The DEM emission angle of the last geometry
   };
 };
 
@@ -18,7 +18,7 @@
 #include "SurfacePoint.h"
 #include "IException.h"
 #include "IString.h"
-#include "NaifStatus.h"
+#include "NaifMath.h"
 #include "Spice.h"
 #include "Target.h"
 
@@ -128,6 +128,35 @@ namespace Isis {
     return (true);
   }
 
+  /**
+   * Indicates if the shape model can trace a batch of look directions at once
+   * with prepareIntersections. The default implementation cannot, so callers
+   * should not spend time collecting look directions for it.
+   *
+   * @return @b bool If prepareIntersections traces look directions
+   */
+  bool ShapeModel::canPrepareIntersections() const {
+    return false;
+  }
+
+
+  /**
+   * Traces a batch of look directions, such as the look directions of a brick
+   * of pixels, ahead of the intersectSurface calls for them. Shape models that
+   * can intersect many rays at once, such as EmbreeShapeModel, override this
+   * and answer the following intersectSurface calls with the same observer
+   * positions and look directions from the batch. The default implementation
+   * does nothing.
+   *
+   * @param observerPositions The body-fixed position of the observer for each
+   *                          look direction, in kilometers
+   * @param lookDirections The body-fixed look directions
+   */
+  void ShapeModel::prepareIntersections(const std::vector< std::vector<double> > &observerPositions,
+                                        const std::vector< std::vector<double> > &lookDirections) {
+  }
+
+
   /**
    *  Calculates the ellipsoidal surface normal.
    */
@@ -280,12 +309,8 @@ namespace Isis {
 
     // check if observer look vector intersects the target
     SpiceDouble intersectionPoint[3];
-    SpiceBoolean intersected = false;
-
-    NaifStatus::CheckErrors();
-    surfpt_c((SpiceDouble *) &observerBodyFixedPosition[0], lookB, a, b, c,
-             intersectionPoint, &intersected);
-    NaifStatus::CheckErrors();
+    bool intersected = NaifMath::surfpt(&observerBodyFixedPosition[0], lookB, a, b, c,
+                                        intersectionPoint);
 
     if (intersected) {
       m_surfacePoint->FromNaifArray(intersectionPoint);
@@ -101,6 +101,12 @@ namespace Isis {
       virtual bool intersectSurface(const SurfacePoint &surfpt, 
                                     const std::vector<double> &observerPos,
                                     const bool &backCheck = true);
+
+      // Trace a batch of look directions, such as a brick of pixels, ahead of
+      // intersecting them one at a time
+      virtual bool canPrepareIntersections() const;
+      virtual void prepareIntersections(const std::vector< std::vector<double> > &observerPositions,
+                                        const std::vector< std::vector<double> > &lookDirections);
                                  
 
 
@@ -28,6 +28,7 @@
 #include "BulletShapeModel.h"
 #include "BulletTargetShape.h"
 #include "Cube.h"
+#include "CubeManager.h"
 #include "DemShape.h"
 #include "EllipsoidShape.h"
 #include "EmbreeShapeModel.h"
@@ -272,10 +273,12 @@ namespace Isis {
 
         //-------------- Is the shape model an ISIS DEM? ------------------------------//
         // TODO Deal with stacks -- this could be a list of DEMs
-        Isis::Cube* shapeModelCube = new Isis::Cube;
+        // The DEM shapes read the cube through the CubeManager, so opening it there lets
+        //   every camera that uses this DEM share one open cube
+        Isis::Cube *shapeModelCube = NULL;
         try {
           // first, try to open the shape model file as an Isis3 cube
-          shapeModelCube->open(FileName(shapeModelFilenames).expanded(), "r" );
+          shapeModelCube = CubeManager::Open(shapeModelFilenames);
         }
         catch (IException &e) {
           // The file is neither a valid DSK nor an ISIS cube. Append a message and throw the error.
@@ -336,8 +339,6 @@ namespace Isis {
           // in case no error was thrown, but constructor returned NULL
           fileError.append(IException(IException::Unknown, msg, _FILEINFO_));
         }
-        
-        delete shapeModelCube;
 
       }
 
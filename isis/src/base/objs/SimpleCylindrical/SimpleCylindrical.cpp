@@ -31,6 +31,7 @@
 #include "Pvl.h"
 #include "PvlGroup.h"
 #include "PvlKeyword.h"
+#include "SpecialPixel.h"
 
 using namespace std;
 namespace Isis {
@@ -193,6 +194,65 @@ namespace Isis {
     return m_good;
   }
 
+  /**
+   * This method projects many latitude/longitude positions at once with the
+   * same equations as SetGround. The loop has no branches so the compiler can
+   * vectorize it. Rotated projections are projected one position at a time.
+   *
+   * @param count The number of positions to project
+   * @param lats The latitudes to project
+   * @param lons The longitudes to project
+   * @param xs Returns the projection x coordinates
+   * @param ys Returns the projection y coordinates
+   * @param good Returns whether each position was projected
+   */
+  void SimpleCylindrical::SetGrounds(const int count, const double *lats, const double *lons,
+                                     double *xs, double *ys, bool *good) {
+    if (Rotation() != 0.0) {
+      TProjection::SetGrounds(count, lats, lons, xs, ys, good);
+      return;
+    }
+
+    double lonSign = (m_longitudeDirection == PositiveWest) ? -1.0 : 1.0;
+    for (int i = 0; i < count; i++) {
+      double latRadians = lats[i] * PI / 180.0;
+      double lonRadians = lons[i] * PI / 180.0 * lonSign;
+      double deltaLon = (lonRadians - m_centerLongitude);
+      xs[i] = m_equatorialRadius * deltaLon;
+      ys[i] = m_equatorialRadius * latRadians;
+      good[i] = true;
+    }
+  }
+
+  /**
+   * This method computes the latitude/longitude of many x/y coordinates at
+   * once with the same equations as SetCoordinate. Rotated projections are
+   * inverted one coordinate at a time.
+   *
+   * @param count The number of coordinates to invert
+   * @param xs The projection x coordinates
+   * @param ys The projection y coordinates
+   * @param lats Returns the latitudes
+   * @param lons Returns the longitudes
+   * @param good Returns whether each coordinate was inverted
+   */
+  void SimpleCylindrical::SetCoordinates(const int count, const double *xs, const double *ys,
+                                           double *lats, double *lons, bool *good) {
+    if (Rotation() != 0.0) {
+      TProjection::SetCoordinates(count, xs, ys, lats, lons, good);
+      return;
+    }
+
+    double lonSign = (m_longitudeDirection == PositiveWest) ? -1.0 : 1.0;
+    for (int i = 0; i < count; i++) {
+      double latitude = ys[i] / m_equatorialRadius;
+      double longitude = m_centerLongitude + xs[i] / m_equatorialRadius;
+      good[i] = !((fabs(latitude) - HALFPI) > DBL_EPSILON);
+      lats[i] = good[i] ? latitude * (180.0 / PI) : Null;
+      lons[i] = good[i] ? longitude * (180.0 / PI) * lonSign : Null;
+    }
+  }
+
   /**
    * This method is used to determine the x/y range which completely covers the
    * area of interest specified by the lat/lon range. The latitude/longitude
@@ -97,6 +97,10 @@ namespace Isis {
 
       bool SetGround(const double lat, const double lon);
       bool SetCoordinate(const double x, const double y);
+      void SetGrounds(const int count, const double *lats, const double *lons,
+                      double *xs, double *ys, bool *good);
+      void SetCoordinates(const int count, const double *xs, const double *ys,
+                          double *lats, double *lons, bool *good);
       bool XYRange(double &minX, double &maxX, double &minY, double &maxY);
 
       PvlGroup Mapping();
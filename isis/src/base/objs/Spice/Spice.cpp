@@ -22,9 +22,11 @@
 #include "Spice.h"
 
 #include <cfloat>
+#include <cstring>
 #include <iomanip>
 
 #include <QDebug>
+#include <QStringList>
 #include <QVector>
 
 #include <getSpkAbCorrState.hpp>
@@ -41,10 +43,12 @@ using json = nlohmann::json;
 #include "EndianSwapper.h"
 #include "FileName.h"
 #include "IException.h"
+#include "IsdCache.h"
 #include "IString.h"
 #include "iTime.h"
 #include "Longitude.h"
 #include "LightTimeCorrectionState.h"
+#include "NaifMath.h"
 #include "NaifStatus.h"
 #include "ShapeModel.h"
 #include "SpacecraftPosition.h"
@@ -54,6 +58,10 @@ using json = nlohmann::json;
 using namespace std;
 
 namespace Isis {
+  int Spice::m_maximumResidentKernels = 0;
+  QStringList *Spice::m_residentKernels = NULL;
+  QHash<QString, int> *Spice::m_residentKernelUsers = NULL;
+
   /**
    * Constructs a Spice object and loads SPICE kernels using information from the
    * label object. The constructor expects an Instrument and Kernels group to be
@@ -80,7 +88,13 @@ namespace Isis {
     Pvl &lab = *cube.label();
     PvlGroup kernels = lab.findGroup("Kernels", Pvl::Traverse);
     bool hasTables = (kernels["TargetPosition"][0] == "Table");
-    init(lab, !hasTables);
+    try {
+      init(lab, !hasTables);
+    }
+    catch (...) {
+      releaseResidentKernels();
+      throw;
+    }
   }
 
   /**
@@ -90,7 +104,13 @@ namespace Isis {
    * @param noTables Indicates the use of tables.
    */
   Spice::Spice(Cube &cube, bool noTables) {
-    init(*cube.label(), noTables);
+    try {
+      init(*cube.label(), noTables);
+    }
+    catch (...) {
+      releaseResidentKernels();
+      throw;
+    }
   }
 
 
@@ -100,15 +120,25 @@ namespace Isis {
    * @param lab Isis Cube Pvl Lavel
    * @param isd ALE Json ISD
    */
-  Spice::Spice(Pvl &lab, json isd) {
-    init(lab, true, isd);
+  Spice::Spice(Pvl &lab, const json &isd) {
+    try {
+      init(lab, true, isd);
+    }
+    catch (...) {
+      releaseResidentKernels();
+      throw;
+    }
   }
 
   /**
    * Initialization of Spice object.
    *
+   * If no ISD is given and the NAIF kernels are used, the ISD is generated
+   * with ALE, or read from the IsdCache if it was generated before.
+   *
    * @param lab  Pvl labels
    * @param noTables Indicates the use of tables.
+   * @param isd ALE Json ISD, or null to generate one
    *
    * @throw Isis::IException::Io - "Can not find NAIF code for NAIF target"
    * @throw Isis::IException::Camera - "No camera pointing available"
@@ -117,7 +147,7 @@ namespace Isis {
    * @internal
    *   @history 2011-02-08 Jeannie Walldren - Initialize pointers to null.
    */
-  void Spice::init(Pvl &lab, bool noTables, json isd) {
+  void Spice::init(Pvl &lab, bool noTables, const json &isd) {
     NaifStatus::CheckErrors();
     // Initialize members
     m_solarLongitude = new Longitude;
@@ -155,6 +185,17 @@ namespace Isis {
     // Get the kernel group and load main kernels
     PvlGroup kernels = lab.findGroup("Kernels", Pvl::Traverse);
 
+    // Kernels left loaded for other images must not answer for this one
+    if (m_maximumResidentKernels > 0) {
+      QStringList listedKernels;
+      for (int i = 0; i < kernels.keywords(); i++) {
+        for (int j = 0; j < kernels[i].size(); j++) {
+          listedKernels.append(FileName(kernels[i][j]).expanded());
+        }
+      }
+      unloadUnusedResidentKernels(0, listedKernels);
+    }
+
     // Get the time padding first
     if (kernels.hasKeyword("StartPadding")) {
       *m_startTimePadding = toDouble(kernels["StartPadding"][0]);
@@ -174,6 +215,11 @@ namespace Isis {
     m_usingNaif = !lab.hasObject("NaifKeywords") || noTables;
     m_usingAle = false;
 
+    // The ISD the caches are loaded from, either the one passed in or the one
+    // generated by ALE
+    const json *aleIsd = &isd;
+    json loadedIsd;
+
     //  Modified  to load planetary ephemeris SPKs before s/c SPKs since some
     //  missions (e.g., MESSENGER) may augment the s/c SPK with new planet
     //  ephemerides. (2008-02-27 (KJB))
@@ -186,18 +232,31 @@ namespace Isis {
           throw IException(IException::Programmer, msg, _FILEINFO_);
         }
 
-        if (isd == NULL){
-          // try using ALE
-          std::ostringstream kernel_pvl;
-          kernel_pvl << kernels;
+        if (isd.is_null()) {
+          QString cacheFile;
+          QString cacheDirectory = IsdCache::directory();
+          if (!cacheDirectory.isEmpty()) {
+            cacheFile = IsdCache::cacheFileName(cacheDirectory, lab);
+          }
+
+          if (cacheFile.isEmpty() || !IsdCache::read(cacheFile, loadedIsd)) {
+            // try using ALE
+            std::ostringstream kernel_pvl;
+            kernel_pvl << kernels;
 
-          json props;
-          props["kernels"] = kernel_pvl.str();
+            json props;
+            props["kernels"] = kernel_pvl.str();
 
-          isd = ale::load(lab.fileName().toStdString(), props.dump(), "ale");
+            loadedIsd = ale::load(lab.fileName().toStdString(), props.dump(), "ale");
+
+            if (!cacheFile.isEmpty()) {
+              IsdCache::write(cacheFile, loadedIsd);
+            }
+          }
+          aleIsd = &loadedIsd;
         }
 
-        json aleNaifKeywords = isd["naif_keywords"];
+        json aleNaifKeywords = aleIsd->at("naif_keywords");
         m_naifKeywords = new PvlObject("NaifKeywords", aleNaifKeywords);
 
         // Still need to load clock kernels for now
@@ -379,11 +438,11 @@ namespace Isis {
     // Check to see if we have nadir pointing that needs to be computed &
     // See if we have table blobs to load
     if (m_usingAle) {
-      m_sunPosition->LoadCache(isd["sun_position"]);
+      m_sunPosition->LoadCache(aleIsd->at("sun_position"));
       if (m_sunPosition->cacheSize() > 3) {
         m_sunPosition->Memcache2HermiteCache(0.01);
       }
-      m_bodyRotation->LoadCache(isd["body_rotation"]);
+      m_bodyRotation->LoadCache(aleIsd->at("body_rotation"));
       m_bodyRotation->MinimizeCache(SpiceRotation::DownsizeStatus::Yes);
       if (m_bodyRotation->cacheSize() > 5) {
         m_bodyRotation->LoadTimeCache();
@@ -428,7 +487,7 @@ namespace Isis {
       m_instrumentRotation = new SpiceRotation(*m_ikCode, *m_spkBodyCode);
     }
     else if (m_usingAle) {
-     m_instrumentRotation->LoadCache(isd["instrument_pointing"]);
+     m_instrumentRotation->LoadCache(aleIsd->at("instrument_pointing"));
      m_instrumentRotation->MinimizeCache(SpiceRotation::DownsizeStatus::Yes);
      if (m_instrumentRotation->cacheSize() > 5) {
        m_instrumentRotation->LoadTimeCache();
@@ -447,7 +506,7 @@ namespace Isis {
     }
 
     if (m_usingAle) {
-      m_instrumentPosition->LoadCache(isd["instrument_position"]);
+      m_instrumentPosition->LoadCache(aleIsd->at("instrument_position"));
       if (m_instrumentPosition->cacheSize() > 3) {
         m_instrumentPosition->Memcache2HermiteCache(0.01);
       }
@@ -484,13 +543,157 @@ namespace Isis {
         throw IException(IException::Io, msg, _FILEINFO_);
       }
       QString fileName = file.expanded();
-      furnsh_c(fileName.toLatin1().data());
+
+      if (m_maximumResidentKernels > 0) {
+        if (!m_residentKernels) {
+          m_residentKernels = new QStringList;
+          m_residentKernelUsers = new QHash<QString, int>;
+        }
+
+        // A resident kernel is only loaded again when a kernel this object
+        //   loaded before it has a higher priority, so the kernels keep the
+        //   priority they were listed with
+        int index = m_residentKernels->indexOf(fileName);
+        bool reload = (index < 0);
+        for (int j = index + 1; index >= 0 && !reload && j < m_residentKernels->size(); j++) {
+          reload = m_usedResidentKernels.contains(m_residentKernels->at(j));
+        }
+
+        if (reload) {
+          if (index >= 0) {
+            unload_c(fileName.toLatin1().data());
+            m_residentKernels->removeAt(index);
+          }
+          furnsh_c(fileName.toLatin1().data());
+          m_residentKernels->append(fileName);
+        }
+
+        if (!m_usedResidentKernels.contains(fileName)) {
+          m_usedResidentKernels.append(fileName);
+          (*m_residentKernelUsers)[fileName]++;
+        }
+      }
+      else {
+        furnsh_c(fileName.toLatin1().data());
+      }
       m_kernels->push_back(key[i]);
     }
 
     NaifStatus::CheckErrors();
   }
 
+  /**
+   * Unloads the kernels this object loaded, unless they are resident.
+   */
+  void Spice::unloadKernels() {
+    if (!m_usedResidentKernels.isEmpty()) {
+      releaseResidentKernels();
+      return;
+    }
+
+    // Unload the kernels (TODO: Can this be done faster)
+    for (int i = 0; m_kernels && i < m_kernels->size(); i++) {
+      FileName file(m_kernels->at(i));
+      QString fileName = file.expanded();
+      unload_c(fileName.toLatin1().data());
+    }
+  }
+
+
+  /**
+   * Stops this object from using the resident kernels it loaded. The kernels
+   * stay loaded until there are more resident kernels than the maximum, or
+   * another Spice object is created from labels that do not list them.
+   */
+  void Spice::releaseResidentKernels() {
+    if (m_usedResidentKernels.isEmpty()) {
+      return;
+    }
+
+    foreach (QString fileName, m_usedResidentKernels) {
+      if (m_residentKernelUsers->contains(fileName)) {
+        (*m_residentKernelUsers)[fileName]--;
+      }
+    }
+    m_usedResidentKernels.clear();
+
+    unloadUnusedResidentKernels(m_maximumResidentKernels);
+  }
+
+
+  /**
+   * Unloads resident kernels that no Spice object is using, the ones loaded
+   * first going first, until there are no more than the given number of
+   * resident kernels. Kernels in use are never unloaded, so there can be more
+   * resident kernels than the maximum while one image needs them.
+   *
+   * @param maximum The number of resident kernels to unload down to
+   * @param keep Expanded names of kernels that are not unloaded
+   */
+  void Spice::unloadUnusedResidentKernels(int maximum, const QStringList &keep) {
+    if (!m_residentKernels) {
+      return;
+    }
+
+    for (int i = 0; i < m_residentKernels->size() && m_residentKernels->size() > maximum; ) {
+      QString fileName = m_residentKernels->at(i);
+      if (m_residentKernelUsers->value(fileName) > 0 || keep.contains(fileName)) {
+        i++;
+        continue;
+      }
+
+      unload_c(fileName.toLatin1().data());
+      m_residentKernels->removeAt(i);
+      m_residentKernelUsers->remove(fileName);
+    }
+  }
+
+
+  /**
+   * Sets how many kernels stay loaded after the Spice objects that loaded them
+   * are destroyed. Long running programs that create cameras for many images
+   * use this to avoid loading the same kernels again for every image.
+   *
+   * A Spice object only uses the resident kernels its labels list. The others
+   * that no Spice object is using are unloaded when it is created, and the
+   * ones it lists are loaded again when needed to give them the priority they
+   * are listed with. When there are more resident kernels than the maximum,
+   * the ones loaded first that are not in use are unloaded.
+   *
+   * NAIF is not thread safe, so this must not be changed while Spice objects
+   * exist.
+   *
+   * @param maximum The most kernels to keep loaded, or 0 to unload kernels with
+   *                the Spice objects that loaded them
+   */
+  void Spice::setMaximumResidentKernels(int maximum) {
+    m_maximumResidentKernels = qMax(maximum, 0);
+    unloadUnusedResidentKernels(m_maximumResidentKernels);
+  }
+
+
+  /**
+   * @return @b int The most kernels that stay loaded after the Spice objects
+   *                that loaded them are destroyed
+   */
+  int Spice::maximumResidentKernels() {
+    return m_maximumResidentKernels;
+  }
+
+
+  /**
+   * Unloads all of the resident kernels.
+   */
+  void Spice::unloadResidentKernels() {
+    if (m_residentKernels) {
+      while (!m_residentKernels->isEmpty()) {
+        unload_c(m_residentKernels->takeFirst().toLatin1().data());
+      }
+      m_residentKernelUsers->clear();
+    }
+  }
+
+
   /**
    * Destroys the Spice object
    */
@@ -587,12 +790,7 @@ namespace Isis {
       m_target = NULL;
     }
 
-    // Unload the kernels (TODO: Can this be done faster)
-    for (int i = 0; m_kernels && i < m_kernels->size(); i++) {
-      FileName file(m_kernels->at(i));
-      QString fileName = file.expanded();
-      unload_c(fileName.toLatin1().data());
-    }
+    unloadKernels();
 
     if (m_kernels != NULL) {
       delete m_kernels;
@@ -707,13 +905,7 @@ namespace Isis {
     *m_cacheSize = cacheSize;
     m_et = NULL;
 
-    // Unload the kernels (TODO: Can this be done faster)
-    for (int i = 0; i < m_kernels->size(); i++) {
-      FileName file(m_kernels->at(i));
-      QString fileName = file.expanded();
-      unload_c(fileName.toLatin1().data());
-    }
-
+    unloadKernels();
     m_kernels->clear();
 
     NaifStatus::CheckErrors();
@@ -1262,8 +1454,6 @@ namespace Isis {
    *             first."
    */
   void Spice::subSpacecraftPoint(double &lat, double &lon) {
-    NaifStatus::CheckErrors();
-
     if (m_et == NULL) {
       QString msg = "Unable to retrieve subspacecraft position."
                     " Spice::SetTime must be called first.";
@@ -1276,7 +1466,7 @@ namespace Isis {
     sB[0] = vsB[0];
     sB[1] = vsB[1];
     sB[2] = vsB[2];
-    unorm_c(sB, usB, &dist);
+    NaifMath::unorm(sB, usB, dist);
 
     std::vector<Distance> radii = target()->radii();
     SpiceDouble a = radii[0].kilometers();
@@ -1286,18 +1476,14 @@ namespace Isis {
     SpiceDouble originB[3];
     originB[0] = originB[1] = originB[2] = 0.0;
 
-    SpiceBoolean found;
     SpiceDouble subB[3];
-
-    surfpt_c(originB, usB, a, b, c, subB, &found);
+    NaifMath::surfpt(originB, usB, a, b, c, subB);
 
     SpiceDouble mylon, mylat;
-    reclat_c(subB, &a, &mylon, &mylat);
+    NaifMath::reclat(subB, a, mylon, mylat);
     lat = mylat * 180.0 / PI;
     lon = mylon * 180.0 / PI;
     if (lon < 0.0) lon += 360.0;
-
-    NaifStatus::CheckErrors();
   }
 
   /**
@@ -1312,8 +1498,6 @@ namespace Isis {
    *             first."
    */
   void Spice::subSolarPoint(double &lat, double &lon) {
-    NaifStatus::CheckErrors();
-
     if (m_et == NULL) {
       QString msg = "Unable to retrieve subsolar point."
                     " Spice::SetTime must be called first.";
@@ -1321,7 +1505,7 @@ namespace Isis {
     }
 
     SpiceDouble uuB[3], dist;
-    unorm_c(m_uB, uuB, &dist);
+    NaifMath::unorm(m_uB, uuB, dist);
     std::vector<Distance> radii = target()->radii();
 
     SpiceDouble a = radii[0].kilometers();
@@ -1331,17 +1515,15 @@ namespace Isis {
     SpiceDouble originB[3];
     originB[0] = originB[1] = originB[2] = 0.0;
 
-    SpiceBoolean found;
     SpiceDouble subB[3];
-    surfpt_c(originB, uuB, a, b, c, subB, &found);
+    NaifMath::surfpt(originB, uuB, a, b, c, subB);
 
     SpiceDouble mylon, mylat;
-    reclat_c(subB, &a, &mylon, &mylat);
+    NaifMath::reclat(subB, a, mylon, mylat);
 
     lat = mylat * 180.0 / PI;
     lon = mylon * 180.0 / PI;
     if (lon < 0.0) lon += 360.0;
-    NaifStatus::CheckErrors();
   }
 
 
@@ -1370,9 +1552,9 @@ namespace Isis {
     std::vector<double> bodyRotation = m_bodyRotation->Matrix();
 
     double sunPosFromTarget[3];
-    mxv_c(&bodyRotation[0], &sunPosition[0], sunPosFromTarget);
+    NaifMath::mxv((const double (*)[3]) &bodyRotation[0], &sunPosition[0], sunPosFromTarget);
 
-    return vnorm_c(sunPosFromTarget);
+    return NaifMath::vnorm(sunPosFromTarget);
   }
 
 
@@ -1383,8 +1565,6 @@ namespace Isis {
    * @param et Ephemeris time
    */
   void Spice::computeSolarLongitude(iTime et) {
-    NaifStatus::CheckErrors();
-
     if (m_target->isSky()) {
       *m_solarLongitude = Longitude();
       return;
@@ -1400,7 +1580,7 @@ namespace Isis {
       std::vector<double> sunVel = m_sunPosition->Velocity();
       double sunAv[3];
 
-      ucrss_c(&sunPos[0], &sunVel[0], sunAv);
+      NaifMath::ucrss(&sunPos[0], &sunVel[0], sunAv);
 
       double npole[3];
       for (int i = 0; i < 3; i++) {
@@ -1408,9 +1588,9 @@ namespace Isis {
       }
 
       double x[3], y[3], z[3];
-      vequ_c(sunAv, z);
-      ucrss_c(npole, z, x);
-      ucrss_c(z, x, y);
+      memcpy(z, sunAv, sizeof(z));
+      NaifMath::ucrss(npole, z, x);
+      NaifMath::ucrss(z, x, y);
 
       double trans[3][3];
       for (int i = 0; i < 3; i++) {
@@ -1420,14 +1600,13 @@ namespace Isis {
       }
 
       double pos[3];
-      mxv_c(trans, &sunPos[0], pos);
+      NaifMath::mxv(trans, &sunPos[0], pos);
 
       double radius, ls, lat;
-      reclat_c(pos, &radius, &ls, &lat);
+      NaifMath::reclat(pos, radius, ls, lat);
 
       *m_solarLongitude = Longitude(ls, Angle::Radians).force360Domain();
 
-      NaifStatus::CheckErrors();
       m_bodyRotation->SetEphemerisTime(og_time);
       m_sunPosition->SetEphemerisTime(og_time);
       return;
@@ -1435,6 +1614,8 @@ namespace Isis {
 
     if (m_bodyRotation->IsCached()) return;
 
+    NaifStatus::CheckErrors();
+
     double tipm[3][3], npole[3];
     char frameName[32];
     SpiceInt frameCode;
@@ -24,6 +24,9 @@
 #include <string>
 #include <vector>
 
+#include <QHash>
+#include <QStringList>
+
 #include <SpiceUsr.h>
 #include <SpiceZfc.h>
 #include <SpiceZmc.h>
@@ -296,7 +299,7 @@ namespace Isis {
       // constructors
       Spice(Cube &cube);
       Spice(Cube &cube, bool noTables);
-      Spice(Pvl &lab, nlohmann::json);
+      Spice(Pvl &lab, const nlohmann::json &isd);
 
       // destructor
       virtual ~Spice();
@@ -352,6 +355,10 @@ namespace Isis {
       PvlObject getStoredNaifKeywords() const;
       virtual double resolution();
 
+      static void setMaximumResidentKernels(int maximum);
+      static int maximumResidentKernels();
+      static void unloadResidentKernels();
+
     protected:
       /**
        * NAIF value primitive type
@@ -396,9 +403,13 @@ namespace Isis {
       Spice(const Spice &other);
       Spice &operator=(const Spice &other);
   
-      void init(Pvl &pvl, bool noTables, nlohmann::json isd = NULL);
+      void init(Pvl &pvl, bool noTables, const nlohmann::json &isd = nlohmann::json());
 
       void load(PvlKeyword &key, bool notab);
+      void unloadKernels();
+      void releaseResidentKernels();
+      static void unloadUnusedResidentKernels(int maximum,
+                                              const QStringList &keep = QStringList());
       void computeSolarLongitude(iTime et);
 
       Longitude *m_solarLongitude; //!< Body rotation solar longitude value
@@ -442,6 +453,17 @@ namespace Isis {
 
       bool m_usingAle; /**< Indicate whether we are reading values from an ISD returned 
                             from ALE */
+
+      static int m_maximumResidentKernels; /**< The most kernels to keep loaded after the
+                                                Spice objects that loaded them are gone, 0
+                                                to unload kernels with their Spice object*/
+      QStringList m_usedResidentKernels; //!< The resident kernels this object uses
+
+      static QStringList *m_residentKernels; /**< The expanded names of the kernels that
+                                                  stay loaded, in the order they were
+                                                  loaded*/
+      static QHash<QString, int> *m_residentKernelUsers; /**< How many Spice objects use
+                                                              each resident kernel*/
   };
 }
 
@@ -242,8 +242,6 @@ namespace Isis {
    *                      to make software more readable.
    */
   const std::vector<double> &SpicePosition::SetEphemerisTime(double et) {
-    NaifStatus::CheckErrors();
-
     // Save the time
     if(et == p_et) return p_coordinate;
     p_et = et;
@@ -262,11 +260,11 @@ namespace Isis {
       SetEphemerisTimePolyFunctionOverHermiteConstant();
     }
     else {  // Read from the kernel
+      NaifStatus::CheckErrors();
       SetEphemerisTimeSpice();
+      NaifStatus::CheckErrors();
     }
 
-    NaifStatus::CheckErrors();
-
     // Return the coordinate
     return p_coordinate;
   }
@@ -348,28 +346,31 @@ namespace Isis {
    * @param isdPos The ALE ISD as a JSON object.
    *
    */
-  void SpicePosition::LoadCache(json &isdPos) {
+  void SpicePosition::LoadCache(const json &isdPos) {
     if (p_source != Spice) {
         throw IException(IException::Programmer, "SpicePosition::LoadCache(json) only supports Spice source", _FILEINFO_);
     }
 
     // Load the full cache time information from the label if available
-    p_fullCacheStartTime = isdPos["spk_table_start_time"].get<double>();
-    p_fullCacheEndTime = isdPos["spk_table_end_time"].get<double>();
-    p_fullCacheSize = isdPos["spk_table_original_size"].get<double>();
-    p_cacheTime = isdPos["ephemeris_times"].get<std::vector<double>>();
-
-    for (auto it = isdPos["positions"].begin(); it != isdPos["positions"].end(); it++) {
+    p_fullCacheStartTime = isdPos.at("spk_table_start_time").get<double>();
+    p_fullCacheEndTime = isdPos.at("spk_table_end_time").get<double>();
+    p_fullCacheSize = isdPos.at("spk_table_original_size").get<double>();
+    p_cacheTime = isdPos.at("ephemeris_times").get<std::vector<double>>();
+
+    const json &positions = isdPos.at("positions");
+    p_cache.reserve(positions.size());
+    for (auto it = positions.begin(); it != positions.end(); it++) {
       std::vector<double> pos = {it->at(0).get<double>(), it->at(1).get<double>(), it->at(2).get<double>()};
       p_cache.push_back(pos);
     }
 
     p_cacheVelocity.clear();
 
-    bool hasVelocityKey = isdPos.find("velocities") != isdPos.end();
+    auto velocities = isdPos.find("velocities");
 
-    if (hasVelocityKey) {
-      for (auto it = isdPos["velocities"].begin(); it != isdPos["velocities"].end(); it++) {
+    if (velocities != isdPos.end()) {
+      p_cacheVelocity.reserve(velocities->size());
+      for (auto it = velocities->begin(); it != velocities->end(); it++) {
         std::vector<double> vel = {it->at(0).get<double>(), it->at(1).get<double>(), it->at(2).get<double>()};
         p_cacheVelocity.push_back(vel);
       }
@@ -445,59 +446,63 @@ namespace Isis {
                        _FILEINFO_);
     }
 
-    // Loop through and move the table to the cache
+    // Read the table a column at a time and move it to the cache
     if (p_source != PolyFunction) {
-      for (int r = 0; r < table.Records(); r++) {
-        TableRecord &rec = table[r];
-        if (rec.Fields() == 7) {
-          p_hasVelocity = true;
-        }
-        else if (rec.Fields() == 4) {
-          p_hasVelocity = false;
-        }
-        else  {
-          QString msg = "Expecting four or seven fields in the SpicePosition table";
-          throw IException(IException::Programmer, msg, _FILEINFO_);
-        }
+      if (table.RecordFields() == 7) {
+        p_hasVelocity = true;
+      }
+      else if (table.RecordFields() == 4) {
+        p_hasVelocity = false;
+      }
+      else  {
+        QString msg = "Expecting four or seven fields in the SpicePosition table";
+        throw IException(IException::Programmer, msg, _FILEINFO_);
+      }
 
-        std::vector<double> j2000Coord;
-        j2000Coord.push_back((double)rec[0]);
-        j2000Coord.push_back((double)rec[1]);
-        j2000Coord.push_back((double)rec[2]);
-        int inext = 3;
+      std::vector<double> x = table.column(0);
+      std::vector<double> y = table.column(1);
+      std::vector<double> z = table.column(2);
+      std::vector<double> vx, vy, vz;
+      int inext = 3;
+      if (p_hasVelocity) {
+        vx = table.column(3);
+        vy = table.column(4);
+        vz = table.column(5);
+        inext = 6;
+      }
+      std::vector<double> times = table.column(inext);
 
+      for (int r = 0; r < table.Records(); r++) {
+        std::vector<double> j2000Coord(3);
+        j2000Coord[0] = x[r];
+        j2000Coord[1] = y[r];
+        j2000Coord[2] = z[r];
         p_cache.push_back(j2000Coord);
-        if (p_hasVelocity) {
-          std::vector<double> j2000Velocity;
-          j2000Velocity.push_back((double)rec[3]);
-          j2000Velocity.push_back((double)rec[4]);
-          j2000Velocity.push_back((double)rec[5]);
-          inext = 6;
 
+        if (p_hasVelocity) {
+          std::vector<double> j2000Velocity(3);
+          j2000Velocity[0] = vx[r];
+          j2000Velocity[1] = vy[r];
+          j2000Velocity[2] = vz[r];
           p_cacheVelocity.push_back(j2000Velocity);
         }
-        p_cacheTime.push_back((double)rec[inext]);
+        p_cacheTime.push_back(times[r]);
       }
     }
     else {
       // Coefficient table for postion coordinates x, y, and z
-      std::vector<double> coeffX, coeffY, coeffZ;
-
-      for (int r = 0; r < table.Records() - 1; r++) {
-        TableRecord &rec = table[r];
+      std::vector<double> coeffX = table.column(0);
+      std::vector<double> coeffY = table.column(1);
+      std::vector<double> coeffZ = table.column(2);
+
+      // Take care of function time parameters, which are in the last record
+      double baseTime = coeffX.back();
+      double timeScale = coeffY.back();
+      double degree = coeffZ.back();
+      coeffX.pop_back();
+      coeffY.pop_back();
+      coeffZ.pop_back();
 
-        if(rec.Fields() != 3) {
-          // throw an error
-        }
-        coeffX.push_back((double)rec[0]);
-        coeffY.push_back((double)rec[1]);
-        coeffZ.push_back((double)rec[2]);
-      }
-      // Take care of function time parameters
-      TableRecord &rec = table[table.Records()-1];
-      double baseTime = (double)rec[0];
-      double timeScale = (double)rec[1];
-      double degree = (double)rec[2];
       SetPolynomialDegree((int) degree);
       SetOverrideBaseTime(baseTime, timeScale);
       SetPolynomial(coeffX, coeffY, coeffZ);
@@ -235,7 +235,7 @@ namespace Isis {
       void LoadCache(double startTime, double endTime, int size);
       void LoadCache(double time);
       void LoadCache(Table &table);
-      void LoadCache(nlohmann::json &isd);
+      void LoadCache(const nlohmann::json &isd);
 
       Table LineCache(const QString &tableName);
       Table LoadHermiteCache(const QString &tableName);
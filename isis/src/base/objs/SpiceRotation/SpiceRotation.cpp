@@ -21,6 +21,7 @@
 #include "IString.h"
 #include "LeastSquares.h"
 #include "LineEquation.h"
+#include "NaifMath.h"
 #include "NaifStatus.h"
 #include "PolynomialUnivariate.h"
 #include "Quaternion.h"
@@ -415,7 +416,7 @@ namespace Isis {
    * @param isdRot The ALE ISD as a JSON object.
    *
    */
-  void SpiceRotation::LoadCache(json &isdRot){
+  void SpiceRotation::LoadCache(const json &isdRot){
     if (p_source != Spice) {
         throw IException(IException::Programmer, "SpiceRotation::LoadCache(json) only supports Spice source", _FILEINFO_);
     }
@@ -429,21 +430,25 @@ namespace Isis {
     m_frameType = CK;
 
     // Load the full cache time information from the label if available
-    p_fullCacheStartTime = isdRot["ck_table_start_time"].get<double>();
-    p_fullCacheEndTime = isdRot["ck_table_end_time"].get<double>();
-    p_fullCacheSize = isdRot["ck_table_original_size"].get<double>();
-    p_cacheTime = isdRot["ephemeris_times"].get<std::vector<double>>();
-    p_timeFrames = isdRot["time_dependent_frames"].get<std::vector<int>>();
-
-    for (auto it = isdRot["quaternions"].begin(); it != isdRot["quaternions"].end(); it++) {
+    p_fullCacheStartTime = isdRot.at("ck_table_start_time").get<double>();
+    p_fullCacheEndTime = isdRot.at("ck_table_end_time").get<double>();
+    p_fullCacheSize = isdRot.at("ck_table_original_size").get<double>();
+    p_cacheTime = isdRot.at("ephemeris_times").get<std::vector<double>>();
+    p_timeFrames = isdRot.at("time_dependent_frames").get<std::vector<int>>();
+
+    const json &quaternions = isdRot.at("quaternions");
+    p_cache.reserve(quaternions.size());
+    for (auto it = quaternions.begin(); it != quaternions.end(); it++) {
         std::vector<double> quat = {it->at(0).get<double>(), it->at(1).get<double>(), it->at(2).get<double>(), it->at(3).get<double>()};
         Quaternion q(quat);
         std::vector<double> CJ = q.ToMatrix();
         p_cache.push_back(CJ);
     }
 
-    if (isdRot["angular_velocities"].size() != 0) {
-      for (auto it = isdRot["angular_velocities"].begin(); it != isdRot["angular_velocities"].end(); it++) {
+    auto angularVelocities = isdRot.find("angular_velocities");
+    if (angularVelocities != isdRot.end() && angularVelocities->size() != 0) {
+      p_cacheAv.reserve(angularVelocities->size());
+      for (auto it = angularVelocities->begin(); it != angularVelocities->end(); it++) {
           std::vector<double> av = {it->at(0).get<double>(), it->at(1).get<double>(), it->at(2).get<double>()};
           p_cacheAv.push_back(av);
       }
@@ -453,8 +458,8 @@ namespace Isis {
     bool hasConstantFrames = isdRot.find("constant_frames") != isdRot.end();
 
     if (hasConstantFrames) {
-      p_constantFrames = isdRot["constant_frames"].get<std::vector<int>>();
-      p_TC = isdRot["constant_rotation"].get<std::vector<double>>();
+      p_constantFrames = isdRot.at("constant_frames").get<std::vector<int>>();
+      p_TC = isdRot.at("constant_rotation").get<std::vector<double>>();
 
     }
     else {
@@ -553,86 +558,66 @@ namespace Isis {
       loadPCFromTable(table.Label());
     }
 
-    int recFields = table[0].Fields();
+    int recFields = table.RecordFields();
 
-    // Loop through and move the table to the cache.  Retrieve the first record to
-    // establish the type of cache and then use the appropriate loop.
+    // Read the table a column at a time and move it to the cache.  The number of
+    // fields establishes the type of cache.
 
     // list table of quaternion and time
-    if (recFields == 5) {
-      for (int r = 0; r < table.Records(); r++) {
-        TableRecord &rec = table[r];
-
-        if (rec.Fields() != recFields) {
-          // throw and error
-        }
+    if (recFields == 5 || recFields == 8) {
+      std::vector<double> q0 = table.column(0);
+      std::vector<double> q1 = table.column(1);
+      std::vector<double> q2 = table.column(2);
+      std::vector<double> q3 = table.column(3);
+      std::vector<double> times = table.column(recFields - 1);
 
-        std::vector<double> j2000Quat;
-        j2000Quat.push_back((double)rec[0]);
-        j2000Quat.push_back((double)rec[1]);
-        j2000Quat.push_back((double)rec[2]);
-        j2000Quat.push_back((double)rec[3]);
-
-        Quaternion q(j2000Quat);
-        std::vector<double> CJ = q.ToMatrix();
-        p_cache.push_back(CJ);
-        p_cacheTime.push_back((double)rec[4]);
+      // list table of quaternion, angular velocity vector, and time
+      std::vector<double> av1, av2, av3;
+      if (recFields == 8) {
+        av1 = table.column(4);
+        av2 = table.column(5);
+        av3 = table.column(6);
       }
-      p_source = Memcache;
-    }
 
-    // list table of quaternion, angular velocity vector, and time
-    else if (recFields == 8) {
       for (int r = 0; r < table.Records(); r++) {
-        TableRecord &rec = table[r];
-
-        if (rec.Fields() != recFields) {
-          // throw and error
-        }
-
-        std::vector<double> j2000Quat;
-        j2000Quat.push_back((double)rec[0]);
-        j2000Quat.push_back((double)rec[1]);
-        j2000Quat.push_back((double)rec[2]);
-        j2000Quat.push_back((double)rec[3]);
-
+        std::vector<double> j2000Quat(4);
+        j2000Quat[0] = q0[r];
+        j2000Quat[1] = q1[r];
+        j2000Quat[2] = q2[r];
+        j2000Quat[3] = q3[r];
 
         Quaternion q(j2000Quat);
         std::vector<double> CJ = q.ToMatrix();
         p_cache.push_back(CJ);
 
-        std::vector<double> av;
-        av.push_back((double)rec[4]);
-        av.push_back((double)rec[5]);
-        av.push_back((double)rec[6]);
-        p_cacheAv.push_back(av);
+        if (recFields == 8) {
+          std::vector<double> av(3);
+          av[0] = av1[r];
+          av[1] = av2[r];
+          av[2] = av3[r];
+          p_cacheAv.push_back(av);
+          p_hasAngularVelocity = true;
+        }
 
-        p_cacheTime.push_back((double)rec[7]);
-        p_hasAngularVelocity = true;
+        p_cacheTime.push_back(times[r]);
       }
       p_source = Memcache;
     }
 
     // coefficient table for angle1, angle2, and angle3
     else if (recFields == 3) {
-      std::vector<double> coeffAng1, coeffAng2, coeffAng3;
-
-      for (int r = 0; r < table.Records() - 1; r++) {
-        TableRecord &rec = table[r];
-
-        if (rec.Fields() != recFields) {
-          // throw an error
-        }
-        coeffAng1.push_back((double)rec[0]);
-        coeffAng2.push_back((double)rec[1]);
-        coeffAng3.push_back((double)rec[2]);
-      }
+      std::vector<double> coeffAng1 = table.column(0);
+      std::vector<double> coeffAng2 = table.column(1);
+      std::vector<double> coeffAng3 = table.column(2);
+
+      // Take care of time parameters, which are in the last record
+      double baseTime = coeffAng1.back();
+      double timeScale = coeffAng2.back();
+      double degree = coeffAng3.back();
+      coeffAng1.pop_back();
+      coeffAng2.pop_back();
+      coeffAng3.pop_back();
 
-      // Take care of time parameters
-      TableRecord &rec = table[table.Records()-1];
-      double baseTime = (double)rec[0];
-      double timeScale = (double)rec[1];
-      double degree = (double)rec[2];
       SetPolynomialDegree((int) degree);
       SetOverrideBaseTime(baseTime, timeScale);
       SetPolynomial(coeffAng1, coeffAng2, coeffAng3);
@@ -1286,17 +1271,17 @@ namespace Isis {
    * @return vector<double>  A direction vector in J2000 frame.
    */
   std::vector<double> SpiceRotation::J2000Vector(const std::vector<double> &rVec) {
-    NaifStatus::CheckErrors();
-
     std::vector<double> jVec;
     if (rVec.size() == 3) {
       double TJ[3][3];
-      mxm_c((SpiceDouble *) &p_TC[0], (SpiceDouble *) &p_CJ[0], TJ);
+      NaifMath::mxm((const double (*)[3]) &p_TC[0], (const double (*)[3]) &p_CJ[0], TJ);
       jVec.resize(3);
-      mtxv_c(TJ, (SpiceDouble *) &rVec[0], (SpiceDouble *) &jVec[0]);
+      NaifMath::mtxv(TJ, &rVec[0], &jVec[0]);
     }
 
     else if (rVec.size() == 6) {
+      NaifStatus::CheckErrors();
+
       // See Naif routine frmchg for the format of the state matrix.  The constant rotation, TC,
       // has a derivative with respect to time of I.
       if (!p_hasAngularVelocity) {
@@ -1313,8 +1298,8 @@ namespace Isis {
       jVec.resize(6);
 
       mxvg_c(stateJT, (SpiceDouble *) &rVec[0], 6, 6, (SpiceDouble *) &jVec[0]);
+      NaifStatus::CheckErrors();
     }
-    NaifStatus::CheckErrors();
     return (jVec);
   }
 
@@ -1578,17 +1563,16 @@ namespace Isis {
    * @return @b vector<double> A direction vector in reference frame.
    */
   std::vector<double> SpiceRotation::ReferenceVector(const std::vector<double> &jVec) {
-    NaifStatus::CheckErrors();
-
     std::vector<double> rVec(3);
 
     if (jVec.size() == 3) {
       double TJ[3][3];
-      mxm_c((SpiceDouble *) &p_TC[0], (SpiceDouble *) &p_CJ[0], TJ);
+      NaifMath::mxm((const double (*)[3]) &p_TC[0], (const double (*)[3]) &p_CJ[0], TJ);
       rVec.resize(3);
-      mxv_c(TJ, (SpiceDouble *) &jVec[0], (SpiceDouble *) &rVec[0]);
+      NaifMath::mxv(TJ, &jVec[0], &rVec[0]);
     }
     else if (jVec.size() == 6) {
+      NaifStatus::CheckErrors();
       // See Naif routine frmchg for the format of the state matrix.  The constant rotation, TC,
       // has a derivative with respect to time of I.
       if (!p_hasAngularVelocity) {
@@ -1598,9 +1582,9 @@ namespace Isis {
       stateTJ = StateTJ();
       rVec.resize(6);
       mxvg_c((SpiceDouble *) &stateTJ[0], (SpiceDouble *) &jVec[0], 6, 6, (SpiceDouble *) &rVec[0]);
+      NaifStatus::CheckErrors();
     }
 
-    NaifStatus::CheckErrors();
     return (rVec);
   }
 
@@ -3121,13 +3105,13 @@ namespace Isis {
    * Updates rotation state based on the rotation cache
    *
    * When setting the ephemeris time, this method is used to update the rotation state by reading
-   * from the rotation cache
+   * from the rotation cache. The interpolation uses NaifMath instead of CSPICE, so cached
+   * rotations can be evaluated from any number of threads.
    *
    * @see SpiceRotation::SetEphemerisTime
    */
   void SpiceRotation::setEphemerisTimeMemcache() {
     // If the cache has only one rotation, set it
-    NaifStatus::CheckErrors();
     if (p_cache.size() == 1) {
       p_CJ = p_cache[0];
       if (p_hasAngularVelocity) {
@@ -3156,27 +3140,25 @@ namespace Isis {
                     (p_cacheTime[cacheIndex+1] - p_cacheTime[cacheIndex]);
       /*        Quaternion Q2 (p_cache[cacheIndex+1]);
                Quaternion Q1 (p_cache[cacheIndex]);*/
-      std::vector<double> CJ2(p_cache[cacheIndex+1]);
-      std::vector<double> CJ1(p_cache[cacheIndex]);
-      SpiceDouble J2J1[3][3];
-      mtxm_c((SpiceDouble( *)[3]) &CJ2[0], (SpiceDouble( *)[3]) &CJ1[0], J2J1);
-      SpiceDouble axis[3];
-      SpiceDouble angle;
-      raxisa_c(J2J1, axis, &angle);
-      SpiceDouble delta[3][3];
-      axisar_c(axis, angle * (SpiceDouble)mult, delta);
-      mxmt_c((SpiceDouble *) &CJ1[0], delta, (SpiceDouble( *) [3]) &p_CJ[0]);
+      const double (*CJ2)[3] = (const double (*)[3]) &p_cache[cacheIndex+1][0];
+      const double (*CJ1)[3] = (const double (*)[3]) &p_cache[cacheIndex][0];
+      double J2J1[3][3];
+      NaifMath::mtxm(CJ2, CJ1, J2J1);
+      double axis[3];
+      double angle;
+      NaifMath::raxisa(J2J1, axis, angle);
+      double delta[3][3];
+      NaifMath::axisar(axis, angle * mult, delta);
+      NaifMath::mxmt(CJ1, delta, (double (*)[3]) &p_CJ[0]);
 
       if (p_hasAngularVelocity) {
-        double v1[3], v2[3]; // Vectors surrounding desired time
-        vequ_c((SpiceDouble *) &p_cacheAv[cacheIndex][0], v1);
-        vequ_c((SpiceDouble *) &p_cacheAv[cacheIndex+1][0], v2);
-        vscl_c((1. - mult), v1, v1);
-        vscl_c(mult, v2, v2);
-        vadd_c(v1, v2, (SpiceDouble *) &p_av[0]);
+        const std::vector<double> &v1 = p_cacheAv[cacheIndex];
+        const std::vector<double> &v2 = p_cacheAv[cacheIndex+1];
+        for (int i = 0; i < 3; i++) {
+          p_av[i] = (1. - mult) * v1[i] + mult * v2[i];
+        }
       }
     }
-    NaifStatus::CheckErrors();
   }
 
 
@@ -351,7 +351,7 @@ namespace Isis {
 
       void LoadCache(Table &table);
 
-      void LoadCache(nlohmann::json &isd);
+      void LoadCache(const nlohmann::json &isd);
 
       Table LineCache(const QString &tableName);
 
@@ -815,6 +815,57 @@ namespace Isis {
   }
 
 
+  /**
+   * This method projects many latitude/longitude positions at once. It is
+   * equivalent to calling SetGround and then XCoord and YCoord for each
+   * position, and the results are identical to the scalar results.
+   * Coordinates that could not be projected are set to Null and flagged in
+   * good. Projections with closed form equations override this with loops
+   * the compiler can vectorize. The current ground position and x/y
+   * coordinate of the projection are undefined after this method returns.
+   *
+   * @param count The number of positions to project
+   * @param lats The latitudes to project
+   * @param lons The longitudes to project
+   * @param xs Returns the projection x coordinates
+   * @param ys Returns the projection y coordinates
+   * @param good Returns whether each position was projected
+   */
+  void TProjection::SetGrounds(const int count, const double *lats, const double *lons,
+                               double *xs, double *ys, bool *good) {
+    for (int i = 0; i < count; i++) {
+      good[i] = SetGround(lats[i], lons[i]);
+      xs[i] = good[i] ? XCoord() : Null;
+      ys[i] = good[i] ? YCoord() : Null;
+    }
+  }
+
+
+  /**
+   * This method computes the latitude/longitude of many x/y coordinates at
+   * once. It is equivalent to calling SetCoordinate and then Latitude and
+   * Longitude for each coordinate, and the results are identical to the scalar
+   * results. Positions that could not be computed are set to Null and flagged
+   * in good. The current ground position and x/y coordinate of the projection
+   * are undefined after this method returns.
+   *
+   * @param count The number of coordinates to invert
+   * @param xs The projection x coordinates
+   * @param ys The projection y coordinates
+   * @param lats Returns the latitudes
+   * @param lons Returns the longitudes
+   * @param good Returns whether each coordinate was inverted
+   */
+  void TProjection::SetCoordinates(const int count, const double *xs, const double *ys,
+                                   double *lats, double *lons, bool *good) {
+    for (int i = 0; i < count; i++) {
+      good[i] = SetCoordinate(xs[i], ys[i]);
+      lats[i] = good[i] ? Latitude() : Null;
+      lons[i] = good[i] ? Longitude() : Null;
+    }
+  }
+
+
   /**
    * This returns a latitude with correct latitude type as specified in the
    * label object. The method can only be used if SetGround, SetCoordinate,
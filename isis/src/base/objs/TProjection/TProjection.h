@@ -263,6 +263,12 @@ namespace Isis {
       virtual bool SetGround(const double lat, const double lon);
       virtual bool SetCoordinate(const double x, const double y);
 
+      // Set many ground positions or x/y coordinates at once
+      virtual void SetGrounds(const int count, const double *lats, const double *lons,
+                              double *xs, double *ys, bool *good);
+      virtual void SetCoordinates(const int count, const double *xs, const double *ys,
+                                  double *lats, double *lons, bool *good);
+
       // Methods that depend on successful completion
       // of SetGround/SetCoordinate Get lat,lon, x,y
       virtual double Latitude() const;
@@ -22,6 +22,7 @@
 
 #include "Table.h"
 
+#include <cstring>
 #include <fstream>
 #include <string>
 
@@ -130,16 +131,7 @@ namespace Isis {
     p_records = other.p_records;
     p_assoc = other.p_assoc;
     p_swap = other.p_swap;
-
-    for (unsigned int i = 0; i < other.p_recbufs.size(); i++) {
-      char *data = new char[RecordSize()];
-
-      for (int j = 0; j < RecordSize(); j++) {
-        data[j] = other.p_recbufs[i][j];
-      }
-
-      p_recbufs.push_back(data);
-    }
+    p_data = other.p_data;
   }
 
   /**
@@ -158,16 +150,7 @@ namespace Isis {
     p_records = other.p_records;
     p_assoc = other.p_assoc;
     p_swap = other.p_swap;
-
-    for (unsigned int i = 0; i < other.p_recbufs.size(); i++) {
-      char *data = new char[RecordSize()];
-
-      for (int j = 0; j < RecordSize(); j++) {
-        data[j] = other.p_recbufs[i][j];
-      }
-
-      p_recbufs.push_back(data);
-    }
+    p_data = other.p_data;
 
     return *this;
   }
@@ -222,7 +205,10 @@ namespace Isis {
    * @return @b int Number of records
    */
   int Table::Records() const {
-    return p_recbufs.size();
+    if (RecordSize() == 0) {
+      return 0;
+    }
+    return p_data.size() / RecordSize();
   }
 
   /**
@@ -251,10 +237,91 @@ namespace Isis {
    * @return Returns the TableRecord at specific index
    */
   Isis::TableRecord &Table::operator[](const int index) {
-    p_record.Unpack(p_recbufs[index]);
+    p_record.Unpack(&p_data[(size_t) index * RecordSize()]);
     return p_record;
   }
 
+
+  /**
+   * Reads every value of a numeric field straight from the packed records,
+   * without unpacking each record into a TableRecord. Fields with more than
+   * one value per record return their values record by record.
+   *
+   * @param field Index of the field to read
+   *
+   * @return @b std::vector<double> The values of the field in all records
+   *
+   * @throws IException::Programmer "Field index is out of range"
+   * @throws IException::Programmer "Text fields can not be read as numbers"
+   */
+  std::vector<double> Table::column(const int field) {
+    if (field < 0 || field >= RecordFields()) {
+      QString msg = "Field index [" + Isis::toString(field) + "] is out of range for Table ["
+                    + p_blobName + "] with [" + Isis::toString(RecordFields()) + "] fields";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    int offset = 0;
+    for (int f = 0; f < field; f++) {
+      offset += p_record[f].bytes();
+    }
+
+    const TableField &tableField = p_record[field];
+    if (tableField.isText()) {
+      QString msg = "Text field [" + tableField.name() + "] in Table [" + p_blobName
+                    + "] can not be read as numbers";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    int records = Records();
+    int size = tableField.size();
+    std::vector<double> values((size_t) records * size);
+    const char *buf = p_data.empty() ? NULL : &p_data[offset];
+    for (int rec = 0; rec < records; rec++, buf += RecordSize()) {
+      for (int i = 0; i < size; i++) {
+        double &value = values[(size_t) rec * size + i];
+        if (tableField.isDouble()) {
+          memcpy(&value, buf + i * sizeof(double), sizeof(double));
+        }
+        else if (tableField.isInteger()) {
+          int intValue;
+          memcpy(&intValue, buf + i * sizeof(int), sizeof(int));
+          value = intValue;
+        }
+        else {
+          float realValue;
+          memcpy(&realValue, buf + i * sizeof(float), sizeof(float));
+          value = realValue;
+        }
+      }
+    }
+
+    return values;
+  }
+
+
+  /**
+   * Reads every value of the named numeric field.
+   *
+   * @param fieldName Name of the field to read
+   *
+   * @return @b std::vector<double> The values of the field in all records
+   *
+   * @throws IException::Programmer "Field does not exist in the Table"
+   *
+   * @see column(const int)
+   */
+  std::vector<double> Table::column(const QString &fieldName) {
+    for (int f = 0; f < RecordFields(); f++) {
+      if (p_record[f].name().toUpper() == fieldName.toUpper()) {
+        return column(f);
+      }
+    }
+
+    QString msg = "Field [" + fieldName + "] does not exist in Table [" + p_blobName + "]";
+    throw IException(IException::Programmer, msg, _FILEINFO_);
+  }
+
   /**
    * Adds a TableRecord to the Table
    *
@@ -274,9 +341,8 @@ namespace Isis {
                      + Isis::toString(RecordSize()) + " bytes]. Record sizes must match.";
        throw IException(IException::Unknown, msg, _FILEINFO_);
      }
-    char *newbuf = new char[RecordSize()];
-    rec.Pack(newbuf);
-    p_recbufs.push_back(newbuf);
+    p_data.resize(p_data.size() + RecordSize());
+    rec.Pack(&p_data[p_data.size() - RecordSize()]);
   }
 
   /**
@@ -286,7 +352,7 @@ namespace Isis {
    * @param index Index of TableRecord to be updated
    */
   void Table::Update(const Isis::TableRecord &rec, const int index) {
-    rec.Pack(p_recbufs[index]);
+    rec.Pack(&p_data[(size_t) index * RecordSize()]);
   }
 
   /**
@@ -295,18 +361,15 @@ namespace Isis {
    * @param index Index of TableRecord to be deleted
    */
   void Table::Delete(const int index) {
-    vector<char *>::iterator it = p_recbufs.begin();
-    for (int i = 0; i < index; i++, it++);
-    delete [] p_recbufs[index];
-    p_recbufs.erase(it);
+    vector<char>::iterator it = p_data.begin() + (size_t) index * RecordSize();
+    p_data.erase(it, it + RecordSize());
   }
 
   /**
    * Clear the table of all records
    */
   void Table::Clear() {
-    for (int i = 0; i < (int)p_recbufs.size(); i++) delete [] p_recbufs[i];
-    p_recbufs.clear();
+    p_data.clear();
   }
 
   //! Virtual function to validate PVL table information
@@ -349,26 +412,31 @@ namespace Isis {
    * @throws Isis::IException::Io - Error reading or preparing to read a record
    */
   void Table::ReadData(std::istream &stream) {
-    for (int rec = 0; rec < p_records; rec++) {
-      streampos sbyte = (streampos)(p_startByte - 1) +
-                        (streampos)(rec * RecordSize());
-      stream.seekg(sbyte, std::ios::beg);
-      if (!stream.good()) {
-        QString msg = "Error preparing to read record [" + Isis::toString(rec + 1) + 
-                     "] from Table [" + p_blobName + "]";
-        throw IException(IException::Io, msg, _FILEINFO_);
-      }
+    if (p_records <= 0 || RecordSize() == 0) {
+      return;
+    }
 
-      char *buf = new char[RecordSize()];
-      stream.read(buf, RecordSize());
-      if (!stream.good()) {
-        QString msg = "Error reading record [" + Isis::toString(rec + 1) + 
-                      "] from Table [" + p_blobName + "]";
-        throw IException(IException::Io, msg, _FILEINFO_);
-      }
+    streampos sbyte = (streampos)(p_startByte - 1);
+    stream.seekg(sbyte, std::ios::beg);
+    if (!stream.good()) {
+      QString msg = "Error preparing to read records from Table [" + p_blobName + "]";
+      throw IException(IException::Io, msg, _FILEINFO_);
+    }
 
-      if (p_swap) p_record.Swap(buf);
-      p_recbufs.push_back(buf);
+    // Read all of the records at once and swap them in place
+    p_data.resize((size_t) p_records * RecordSize());
+    stream.read(&p_data[0], p_data.size());
+    if (!stream.good()) {
+      p_data.clear();
+      QString msg = "Error reading [" + Isis::toString(p_records) +
+                    "] records from Table [" + p_blobName + "]";
+      throw IException(IException::Io, msg, _FILEINFO_);
+    }
+
+    if (p_swap) {
+      for (int rec = 0; rec < p_records; rec++) {
+        p_record.Swap(&p_data[(size_t) rec * RecordSize()]);
+      }
     }
   }
 
@@ -404,8 +472,8 @@ namespace Isis {
    * @param os Outputstream to write the data to
    */
   void Table::WriteData(std::fstream &os) {
-    for (int rec = 0; rec < Records(); rec++) {
-      os.write(p_recbufs[rec], RecordSize());
+    if (!p_data.empty()) {
+      os.write(&p_data[0], p_data.size());
     }
   }
 
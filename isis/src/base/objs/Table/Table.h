@@ -114,6 +114,10 @@ namespace Isis {
       // Read a record
       TableRecord &operator[](const int index);
 
+      // Read every value of a numeric field
+      std::vector<double> column(const int field);
+      std::vector<double> column(const QString &fieldName);
+
       // Add a record
       void operator+=(TableRecord &rec);
 
@@ -134,11 +138,12 @@ namespace Isis {
       void WriteInit();
       void WriteData(std::fstream &os);
 
-      TableRecord p_record;          //!< The current table record
-      std::vector<char *> p_recbufs; //!< Buffers containing record values
+      TableRecord p_record;     //!< The current table record
+      std::vector<char> p_data; /**< The packed values of every record, one
+                                     record after another.*/
 
       int p_records; /**< Holds record count read from labels, may differ from
-                         the size of p_recbufs.*/
+                         the number of records in p_data.*/
 
       Association p_assoc; //!< Association Type of the table
       bool p_swap;         //!< Only used for reading
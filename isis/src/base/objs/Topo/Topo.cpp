@@ -7,6 +7,11 @@ using std::max;
 
 namespace Isis {
   Topo::Topo(Pvl &pvl, PhotoModel &pmodel) : NormModel(pvl, pmodel) {
+    p_normOldPhase = -9999;
+    p_normOldIncidence = -9999;
+    p_normOldEmission = -9999;
+    p_normOldDemincidence = -9999;
+    p_normOldDememission = -9999;
     PvlGroup &algorithm = pvl.findObject("NormalizationModel").findGroup("Algorithm", Pvl::Traverse);
 
     SetNormPharef(0.0);
@@ -41,59 +46,48 @@ namespace Isis {
   void Topo::NormModelAlgorithm(double phase, double incidence, double emission,
                                 double demincidence, double dememission, double dn,
                                 double &albedo, double &mult, double &base) {
-    static double rhobar;
-    static double pprimeref;
-    static double psurfref;
-    static double psurf;
-    static double psurf0;
-    static double pprime;
-
-    static double old_phase = -9999;
-    static double old_incidence = -9999;
-    static double old_emission = -9999;
-    static double old_demincidence = -9999;
-    static double old_dememission = -9999;
-
-    if (old_phase != phase || old_incidence != incidence || old_emission != emission ||
-        old_demincidence != demincidence || old_dememission != dememission) {
+    if (p_normOldPhase != phase || p_normOldIncidence != incidence ||
+        p_normOldEmission != emission || p_normOldDemincidence != demincidence ||
+        p_normOldDememission != dememission) {
 
       GetPhotoModel()->SetStandardConditions(true);
-      psurf0 = GetPhotoModel()->CalcSurfAlbedo(0.0, 0.0, 0.0);
+      p_normPsurf0 = GetPhotoModel()->CalcSurfAlbedo(0.0, 0.0, 0.0);
 
-      if(psurf0 == 0.0) {
+      if(p_normPsurf0 == 0.0) {
         std::string msg = "Divide by zero error";
         throw IException(IException::Unknown, msg, _FILEINFO_);
       }
       else {
-        rhobar = p_normAlbedo / psurf0;
+        p_normRhobar = p_normAlbedo / p_normPsurf0;
       }
 
-      psurfref = GetPhotoModel()->CalcSurfAlbedo(p_normPharef, p_normIncref, p_normEmaref);
-      pprimeref = GetPhotoModel()->PhtTopder(p_normPharef, p_normIncref, p_normEmaref);
+      p_normPsurfref = GetPhotoModel()->CalcSurfAlbedo(p_normPharef, p_normIncref, p_normEmaref);
+      p_normPprimeref = GetPhotoModel()->PhtTopder(p_normPharef, p_normIncref, p_normEmaref);
       GetPhotoModel()->SetStandardConditions(false);
 
       // code for scaling each pixel
-      psurf = GetPhotoModel()->CalcSurfAlbedo(phase, demincidence, dememission);
-      pprime = GetPhotoModel()->PhtTopder(phase, demincidence, dememission);
-
-      old_phase = phase;
-      old_incidence = incidence;
-      old_emission = emission;
-      old_demincidence = demincidence;
-      old_dememission = dememission;
+      p_normPsurf = GetPhotoModel()->CalcSurfAlbedo(phase, demincidence, dememission);
+      p_normPprime = GetPhotoModel()->PhtTopder(phase, demincidence, dememission);
+
+      p_normOldPhase = phase;
+      p_normOldIncidence = incidence;
+      p_normOldEmission = emission;
+      p_normOldDemincidence = demincidence;
+      p_normOldDememission = dememission;
     }
 
-    if(psurf * pprimeref > pprime * p_normThresh) {
+    if(p_normPsurf * p_normPprimeref > p_normPprime * p_normThresh) {
       albedo = NULL8;
     }
     else {
-      if(pprime == 0.0) {
+      if(p_normPprime == 0.0) {
         std::string msg = "Divide by zero error";
         throw IException(IException::Unknown, msg, _FILEINFO_);
       }
       else {
-        albedo = dn * rhobar * (psurf * pprimeref) / pprime +
-                 rhobar * psurfref - rhobar * (psurf * pprimeref) / pprime;
+        albedo = dn * p_normRhobar * (p_normPsurf * p_normPprimeref) / p_normPprime +
+                 p_normRhobar * p_normPsurfref -
+                 p_normRhobar * (p_normPsurf * p_normPprimeref) / p_normPprime;
       }
     }
   }
@@ -70,6 +70,17 @@ namespace Isis {
       double p_normThresh;
       double p_normAlbedo;
 
+      double p_normRhobar; //!< The albedo scaling at standard conditions
+      double p_normPprimeref; //!< The topographic derivative at the reference geometry
+      double p_normPsurfref; //!< The surface brightness at the reference geometry
+      double p_normPsurf; //!< The surface brightness at the last geometry
+      double p_normPsurf0; //!< The surface brightness at zero phase, incidence and emission
+      double p_normPprime; //!< The topographic derivative at the last geometry
+      double p_normOldPhase; //!< The phase angle of the last geometry
+      double p_normOldIncidence; //!< The incidence angle of the last geometry
+      double p_normOldEmission; //!< The emission angle of the last geometry
+      double p_normOldDemincidence; //!< The DEM incidence angle of the last geometry
+      double p_normOldDememission; //!< The DEM emission angle of the last geometry
   };
 };
 
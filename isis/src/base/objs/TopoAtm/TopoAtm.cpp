@@ -10,6 +10,11 @@ namespace Isis {
    *          since this is in Isis namespace.
    */
   TopoAtm::TopoAtm(Pvl &pvl, PhotoModel &pmodel, AtmosModel &amodel) : NormModel(pvl, pmodel, amodel) {
+    p_normOldPhase = -9999;
+    p_normOldIncidence = -9999;
+    p_normOldEmission = -9999;
+    p_normOldDemincidence = -9999;
+    p_normOldDememission = -9999;
     double psurf0;
     double psurfref;
     double pprimeref;
@@ -95,10 +100,6 @@ namespace Isis {
                                    double demincidence, double dememission, double dn,
                                    double &albedo, double &mult, double &base) {
     double eps = 0.1;
-    static double psurf;
-    static double pprime;
-    static double ahInterp;
-    static double munot;
     double pstd;
     double trans;
     double trans0;
@@ -114,40 +115,36 @@ namespace Isis {
     double pflat;
     double rhoflat;
 
-    static double old_phase = -9999;
-    static double old_incidence = -9999;
-    static double old_emission = -9999;
-    static double old_demincidence = -9999;
-    static double old_dememission = -9999;
+    if (p_normOldPhase != phase || p_normOldIncidence != incidence ||
+        p_normOldEmission != emission || p_normOldDemincidence != demincidence ||
+        p_normOldDememission != dememission) {
 
-    if (old_phase != phase || old_incidence != incidence || old_emission != emission ||
-        old_demincidence != demincidence || old_dememission != dememission) {
+      p_normPsurf = GetPhotoModel()->CalcSurfAlbedo(phase, demincidence, dememission);
+      p_normPprime = GetPhotoModel()->PhtTopder(phase, demincidence, dememission);
+      p_normAhInterp = (GetAtmosModel()->AtmosAhSpline()).Evaluate(incidence,
+                           NumericalApproximation::Extrapolate);
 
-      psurf = GetPhotoModel()->CalcSurfAlbedo(phase, demincidence, dememission);
-      pprime = GetPhotoModel()->PhtTopder(phase, demincidence, dememission);
-      ahInterp = (GetAtmosModel()->AtmosAhSpline()).Evaluate(incidence, NumericalApproximation::Extrapolate);
+      p_normMunot = cos(incidence * (PI / 180.0));
 
-      munot = cos(incidence * (PI / 180.0));
-
-      old_phase = phase;
-      old_incidence = incidence;
-      old_emission = emission;
-      old_demincidence = demincidence;
-      old_dememission = dememission;
+      p_normOldPhase = phase;
+      p_normOldIncidence = incidence;
+      p_normOldEmission = emission;
+      p_normOldDemincidence = demincidence;
+      p_normOldDememission = dememission;
     }
 
     GetAtmosModel()->CalcAtmEffect(phase, incidence, emission, &pstd, &trans, &trans0, &sbar,
                                    &transs);
-    pflat = pstd + p_normRhobar * (trans * ahInterp * munot /
-                                   (1.0 - p_normRhobar * GetAtmosModel()->AtmosAb() * sbar) + trans0 * (psurf -
-                                       ahInterp * munot));
-    ptilt = pflat + p_normRhobar * pprime * trans0 * eps;
+    pflat = pstd + p_normRhobar * (trans * p_normAhInterp * p_normMunot /
+                                   (1.0 - p_normRhobar * GetAtmosModel()->AtmosAb() * sbar) +
+                                   trans0 * (p_normPsurf - p_normAhInterp * p_normMunot));
+    ptilt = pflat + p_normRhobar * p_normPprime * trans0 * eps;
     dpo = ptilt - pstd;
-    dpm = (psurf - ahInterp * munot) * trans0;
-    q = ahInterp * munot * trans + GetAtmosModel()->AtmosAb() * sbar * dpo + dpm;
+    dpm = (p_normPsurf - p_normAhInterp * p_normMunot) * trans0;
+    q = p_normAhInterp * p_normMunot * trans + GetAtmosModel()->AtmosAb() * sbar * dpo + dpm;
     rhotlt = 2.0 * dpo / (q + sqrt(pow(q, 2.0) - 4.0 * GetAtmosModel()->AtmosAb() * sbar * dpo * dpm));
     dpo = pflat - pstd;
-    q = ahInterp * munot * trans + GetAtmosModel()->AtmosAb() * sbar * dpo + dpm;
+    q = p_normAhInterp * p_normMunot * trans + GetAtmosModel()->AtmosAb() * sbar * dpo + dpm;
     rhoflat = 2.0 * dpo / (q + sqrt(pow(q, 2.0) - 4.0 * GetAtmosModel()->AtmosAb() * sbar * dpo * dpm));
     pprimeeff = (rhotlt - rhoflat) / (rhoflat * eps);
     slope = (dn - 1.0) / pprimeeff;
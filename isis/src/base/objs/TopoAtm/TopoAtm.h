@@ -112,6 +112,15 @@ namespace Isis {
       double p_normAout;
       double p_normBout;
       double p_normRhobar;
+      double p_normPsurf; //!< The surface brightness at the last geometry
+      double p_normPprime; //!< The topographic derivative at the last geometry
+      double p_normAhInterp; //!< The hemispheric albedo at the last incidence angle
+      double p_normMunot; //!< The cosine of the last incidence angle
+      double p_normOldPhase; //!< The phase angle of the last geometry
+      double p_normOldIncidence; //!< The incidence angle of the last geometry
+      double p_normOldEmission; //!< The emission angle of the last geometry
+      double p_normOldDemincidence; //!< The DEM incidence angle of the last geometry
+      double p_normOldDememission; //!< The DEM emission angle of the last geometry
   };
 };
 
@@ -143,6 +143,71 @@ namespace Isis {
         return true;
       }
 
+      /**
+       * Transforms many output pixels, such as the pixels of an output tile,
+       * to the corresponding input lines and samples. Each result is the same
+       * as calling Xform with the output pixel, in order. Transforms that can
+       * share work between pixels override this.
+       *
+       * @param count The number of output pixels
+       * @param inSamples The calculated input sample of each output pixel
+       * @param inLines The calculated input line of each output pixel
+       * @param outSamples The output sample of each output pixel
+       * @param outLines The output line of each output pixel
+       * @param good If each output pixel transformed to an input pixel
+       */
+      virtual void Xforms(const int count, double *inSamples, double *inLines,
+                          const double *outSamples, const double *outLines,
+                          bool *good) {
+        for (int i = 0; i < count; i++) {
+          good[i] = Xform(inSamples[i], inLines[i], outSamples[i], outLines[i]);
+        }
+      }
+
+      /**
+       * Returns whether the transform is separable, that is, whether the input
+       * sample depends only on the output sample and the input line depends
+       * only on the output line. Separable transforms must also implement
+       * XformSample and XformLine, and an output pixel must transform exactly
+       * when both its sample and its line do. ProcessRubberSheet resamples
+       * separable transforms directly instead of building a quad tree.
+       *
+       * @return bool True if the transform is separable
+       */
+      virtual bool IsSeparable() const {
+        return false;
+      }
+
+      /**
+       * Transforms an output sample to the corresponding input sample for a
+       * separable transform.
+       *
+       * @param inSample The calculated input sample
+       *
+       * @param outSample The output sample for which an input sample is being
+       *                  sought
+       *
+       * @return bool True if the output sample transforms to an input sample
+       */
+      virtual bool XformSample(double &inSample, const double outSample) {
+        return false;
+      }
+
+      /**
+       * Transforms an output line to the corresponding input line for a
+       * separable transform.
+       *
+       * @param inLine The calculated input line
+       *
+       * @param outLine The output line for which an input line is being
+       *                sought
+       *
+       * @return bool True if the output line transforms to an input line
+       */
+      virtual bool XformLine(double &inLine, const double outLine) {
+        return false;
+      }
+
   };
 };
 
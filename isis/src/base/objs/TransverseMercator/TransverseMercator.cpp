@@ -31,6 +31,7 @@
 #include "Pvl.h"
 #include "PvlGroup.h"
 #include "PvlKeyword.h"
+#include "SpecialPixel.h"
 
 using namespace std;
 namespace Isis {
@@ -184,18 +185,129 @@ namespace Isis {
     // Get longitude & fix direction
     m_longitude = lon;
     if (m_longitudeDirection == PositiveWest) m_longitude *= -1.0;
+    m_latitude = lat;
+
+    double x, y;
+    if (!groundToXY(lat, m_longitude, x, y)) {
+      m_good = false;
+      return m_good;
+    }
+
+    SetComputedXY(x, y);
+    m_good = true;
+    return m_good;
+  }
+
+  /**
+   * This method is used to set the projection x/y. The Set forces an attempted
+   * calculation of the corresponding latitude/longitude position. This may or
+   * may not be successful and a status is returned as such.
+   *
+   * @param x X coordinate of the projection in units that are the same as the
+   *          radii in the label
+   *
+   * @param y Y coordinate of the projection in units that are the same as the
+   *          radii in the label
+   *
+   * @return bool
+   */
+  bool TransverseMercator::SetCoordinate(const double x, const double y) {
+    // Save the coordinate
+    SetXY(x, y);
+
+    double lat, lon;
+    if (!xyToGround(GetX(), GetY(), lat, lon)) {
+      m_good = false;
+      return m_good;
+    }
+
+    m_latitude = lat;
+    m_longitude = lon;
+    m_good = true;
+    return m_good;
+  }
+
+  /**
+   * This method projects many latitude/longitude positions at once with the
+   * same equations as SetGround, without storing each position in the
+   * projection. Rotated projections are projected one position at a time.
+   *
+   * @param count The number of positions to project
+   * @param lats The latitudes to project
+   * @param lons The longitudes to project
+   * @param xs Returns the projection x coordinates
+   * @param ys Returns the projection y coordinates
+   * @param good Returns whether each position was projected
+   */
+  void TransverseMercator::SetGrounds(const int count, const double *lats, const double *lons,
+                                      double *xs, double *ys, bool *good) {
+    if (Rotation() != 0.0) {
+      TProjection::SetGrounds(count, lats, lons, xs, ys, good);
+      return;
+    }
+
+    double lonSign = (m_longitudeDirection == PositiveWest) ? -1.0 : 1.0;
+    for (int i = 0; i < count; i++) {
+      good[i] = groundToXY(lats[i], lons[i] * lonSign, xs[i], ys[i]);
+      if (!good[i]) {
+        xs[i] = Null;
+        ys[i] = Null;
+      }
+    }
+  }
+
+  /**
+   * This method computes the latitude/longitude of many x/y coordinates at
+   * once with the same equations as SetCoordinate. Rotated projections are
+   * inverted one coordinate at a time.
+   *
+   * @param count The number of coordinates to invert
+   * @param xs The projection x coordinates
+   * @param ys The projection y coordinates
+   * @param lats Returns the latitudes
+   * @param lons Returns the longitudes
+   * @param good Returns whether each coordinate was inverted
+   */
+  void TransverseMercator::SetCoordinates(const int count, const double *xs, const double *ys,
+                                          double *lats, double *lons, bool *good) {
+    if (Rotation() != 0.0) {
+      TProjection::SetCoordinates(count, xs, ys, lats, lons, good);
+      return;
+    }
+
+    for (int i = 0; i < count; i++) {
+      good[i] = xyToGround(xs[i], ys[i], lats[i], lons[i]);
+      if (!good[i]) {
+        lats[i] = Null;
+        lons[i] = Null;
+      }
+    }
+  }
 
+  /**
+   * Computes the unrotated projection x/y of a latitude/longitude. The
+   * latitude is of the latitude type of the projection and the longitude is
+   * positive east.
+   *
+   * @param lat Latitude value to project
+   * @param lon Positive east longitude value to project
+   * @param x Returns the unrotated x coordinate
+   * @param y Returns the unrotated y coordinate
+   *
+   * @return bool False if the position projects to infinity
+   */
+  bool TransverseMercator::groundToXY(const double lat, const double lon,
+                                      double &x, double &y) const {
     double cLonDeg = m_centerLongitude * 180.0 / PI;
-    double deltaLon = m_longitude - cLonDeg;
+    double deltaLon = lon - cLonDeg;
     while(deltaLon < -360.0) deltaLon += 360.0;
     while(deltaLon > 360.0) deltaLon -= 360.0;
     double deltaLonRads = deltaLon * PI / 180.0;
 
     // Now convert latitude to radians & clean up ... it must be planetographic
-    m_latitude = lat;
-    double latRadians = m_latitude * PI / 180.0;
+    double latRadians = lat * PI / 180.0;
     if (IsPlanetocentric()) {
-      latRadians = ToPlanetographic(m_latitude) * PI / 180.0;
+      latRadians = ToPlanetographic(lat) * PI / 180.0;
     }
 
     // distance along the meridian fromthe Equator to the latitude phi
@@ -209,15 +321,13 @@ namespace Isis {
     const double epsilon = 1.0e-10;
 
     // Sphere Conversion
-    double x, y;
     if (m_sph) {
       double cosphi = cos(latRadians);
       double b = cosphi * sin(deltaLonRads);
 
       // Point projects to infinity
       if (fabs(fabs(b) - 1.0) <= epsilon) {
-        m_good = false;
-        return m_good;
+        return false;
       }
       x = 0.5 * m_equatorialRadius * m_scalefactor * log((1.0 + b) / (1.0 - b));
 
@@ -229,7 +339,7 @@ namespace Isis {
       else {
         con = acos(con);
       }
-      if (m_latitude < 0.0) con = -con;
+      if (lat < 0.0) con = -con;
       y = m_equatorialRadius * m_scalefactor * (con - m_centerLatitude);
     }
 
@@ -261,28 +371,22 @@ namespace Isis {
       }
     }
 
-    SetComputedXY(x, y);
-    m_good = true;
-    return m_good;
+    return true;
   }
 
   /**
-   * This method is used to set the projection x/y. The Set forces an attempted
-   * calculation of the corresponding latitude/longitude position. This may or
-   * may not be successful and a status is returned as such.
+   * Computes the latitude/longitude, in the coordinate system of the
+   * projection, of an unrotated projection x/y.
    *
-   * @param x X coordinate of the projection in units that are the same as the
-   *          radii in the label
-   *
-   * @param y Y coordinate of the projection in units that are the same as the
-   *          radii in the label
+   * @param x The unrotated x coordinate
+   * @param y The unrotated y coordinate
+   * @param lat Returns the latitude
+   * @param lon Returns the longitude
    *
-   * @return bool
+   * @return bool False if the latitude could not be computed
    */
-  bool TransverseMercator::SetCoordinate(const double x, const double y) {
-    // Save the coordinate
-    SetXY(x, y);
-
+  bool TransverseMercator::xyToGround(const double x, const double y,
+                                      double &lat, double &lon) const {
     // Declare & Initialize variables
     double f, g, h, temp, con, phi, dphi, sinphi, cosphi, tanphi;
     double c, cs, t, ts, n, rp, d, ds;
@@ -290,24 +394,24 @@ namespace Isis {
 
     // Sphere Conversion
     if (m_sph) {
-      f = exp(GetX() / (m_equatorialRadius * m_scalefactor));
+      f = exp(x / (m_equatorialRadius * m_scalefactor));
       g = 0.5 * (f - 1.0 / f);
-      temp = m_centerLatitude + GetY() / (m_equatorialRadius * m_scalefactor);
+      temp = m_centerLatitude + y / (m_equatorialRadius * m_scalefactor);
       h = cos(temp);
       con = sqrt((1.0 - h * h) / (1.0 + g * g));
       if (con > 1.0) con = 1.0;
       if (con < -1.0) con = -1.0;
-      m_latitude = asin(con);
-      if (temp < 0.0) m_latitude = -m_latitude;
-      m_longitude = m_centerLongitude;
+      lat = asin(con);
+      if (temp < 0.0) lat = -lat;
+      lon = m_centerLongitude;
       if (g != 0.0 || h != 0.0) {
-        m_longitude = atan2(g, h) + m_centerLongitude;
+        lon = atan2(g, h) + m_centerLongitude;
       }
     }
 
     // Ellipsoid Conversion
     else if (!m_sph) {
-      con = (m_ml0 + GetY() / m_scalefactor) / m_equatorialRadius;
+      con = (m_ml0 + y / m_scalefactor) / m_equatorialRadius;
       phi = con;
       for (int i = 1; i < 7; i++) {
         dphi = ((con + m_e1 * sin(2.0 * phi) - m_e2 * sin(4.0 * phi)
@@ -318,13 +422,12 @@ namespace Isis {
 
       // Didn't converge
       if (fabs(dphi) > epsilon) {
-        m_good = false;
-        return m_good;
+        return false;
       }
       if (fabs(phi) >= HALFPI) {
-        if (GetY() >= 0.0) m_latitude = fabs(HALFPI);
-        if (GetY() < 0.0) m_latitude = - fabs(HALFPI);
-        m_longitude = m_centerLongitude;
+        if (y >= 0.0) lat = fabs(HALFPI);
+        if (y < 0.0) lat = - fabs(HALFPI);
+        lon = m_centerLongitude;
       }
       else {
         sinphi = sin(phi);
@@ -337,20 +440,19 @@ namespace Isis {
         con = 1.0 - m_eccsq * sinphi * sinphi;
         n = m_equatorialRadius / sqrt(con);
         rp = n * (1.0 - m_eccsq) / con;
-        d = GetX() / (n * m_scalefactor);
+        d = x / (n * m_scalefactor);
         ds = d * d;
-        m_latitude = phi - (n * tanphi * ds / rp) * (0.5 - ds /
+        lat = phi - (n * tanphi * ds / rp) * (0.5 - ds /
                      24.0 * (5.0 + 3.0 * t + 10.0 * c - 4.0 * cs - 9.0 *
                              m_esp - ds / 30.0 * (61.0 + 90.0 * t + 298.0 * c +
                                  45.0 * ts - 252.0 * m_esp - 3.0 * cs)));
 
 
         // Latitude cannot be greater than + or - halfpi radians (or 90 degrees)
-        if (fabs(m_latitude) > HALFPI) {
-          m_good = false;
-          return m_good;
+        if (fabs(lat) > HALFPI) {
+          return false;
         }
-        m_longitude = m_centerLongitude 
+        lon = m_centerLongitude 
                       + (d * (1.0 - ds / 6.0 *
                               (1.0 + 2.0 * t + c - ds / 20.0 * (5.0 - 2.0 * c +
                                    28.0 * t - 3.0 * cs + 8.0 * m_esp + 24.0 * ts))) / cosphi);
@@ -358,20 +460,19 @@ namespace Isis {
     }
 
     // Convert to Degrees
-    m_latitude *= 180.0 / PI;
-    m_longitude *= 180.0 / PI;
+    lat *= 180.0 / PI;
+    lon *= 180.0 / PI;
 
     // Cleanup the longitude
-    if (m_longitudeDirection == PositiveWest) m_longitude *= -1.0;
+    if (lonDirection == PositiveWest) lon *= -1.0;
     // These need to be done for circular type projections
-    m_longitude = To360Domain(m_longitude);
-    if (m_longitudeDomain == 180) m_longitude = To180Domain(m_longitude);
+    lon = To360Domain(lon);
+    if (lonDomain == 180) lon = To180Domain(lon);
 
     // Cleanup the latitude
-    if (IsPlanetocentric()) m_latitude = ToPlanetocentric(m_latitude);
+    if (IsPlanetocentric()) lat = ToPlanetocentric(lat);
 
-    m_good = true;
-    return m_good;
+    return true;
   }
 
   /**
@@ -3,7 +3,14 @@
 #include <map>
 #include <sstream>
 
+#include <QFuture>
+#include <QList>
+#include <QMap>
+#include <QMutex>
+#include <QMutexLocker>
 #include <QString>
+#include <QThreadPool>
+#include <QtConcurrentMap>
 
 #include "geos/util/GEOSException.h"
 
@@ -14,6 +21,7 @@
 #include "ControlNet.h"
 #include "ControlPoint.h"
 #include "Cube.h"
+#include "CubeManager.h"
 #include "ID.h"
 #include "IException.h"
 #include "ImageOverlap.h"
@@ -38,6 +46,317 @@ using namespace std;
 
 namespace Isis {
 
+  /**
+   * The image coordinate and status of one measure of a seeded point
+   */
+  struct SeedMeasure {
+    QString serialNumber; //!< Serial number of the measured image
+    double sample;        //!< Apriori sample of the measure
+    double line;          //!< Apriori line of the measure
+    bool ignore;          //!< The measure failed a seed definition criterion
+  };
+
+  /**
+   * The seeded points of one overlap. Points are kept as measures so the
+   * control points can be created, and numbered, in overlap order afterwards.
+   */
+  struct OverlapSeeds {
+    const ImageOverlap *overlap;          //!< The overlap seeded
+    bool seedFailed;                      //!< The seeder failed on the overlap
+    QString seedError;                    //!< Why the seeder failed
+    QList< QList<SeedMeasure> > points;   //!< Measures of each seeded point
+  };
+
+  /**
+   * The seed definition criteria every measure is checked against
+   */
+  struct SeedCriteria {
+    SeedDomain seedDomain;
+    double pixelsFromEdge;
+    double minEmission;
+    double maxEmission;
+    double minIncidence;
+    double maxIncidence;
+    bool hasDNRestriction;
+    double minDN;
+    double maxDN;
+    double minResolution;
+    double maxResolution;
+  };
+
+  /**
+   * The most ground maps, and the most cubes for the DN restriction, that a
+   * chunk keeps open. Consecutive overlaps usually share images, so the most
+   * recently used ones are kept for the next overlaps.
+   */
+  static const int MaxOpenImages = 16;
+
+  /**
+   * A contiguous range of overlaps seeded together. Each chunk has its own
+   * seeder, seeding projection, ground maps and cubes so chunks can be seeded
+   * concurrently. The ground maps and cubes of the images are opened when an
+   * overlap needs them, and only the most recently used ones are kept.
+   */
+  struct SeedChunk {
+    QList<OverlapSeeds> overlaps;  //!< The overlaps to seed, in order
+    PolygonSeeder *seeder;         //!< Seeder for this chunk
+    TProjection *proj;             //!< Projection for XY seeding
+    UniversalGroundMap *ugmap;     //!< Ground map for SampleLine seeding
+    const QMap<QString, QString> *files; //!< File name of each serial number
+    QMutex *cameraMutex;           //!< Serializes creating cameras, which is not thread safe
+    QMap<QString, UniversalGroundMap *> groundMaps; //!< Open ground map of each image
+    QList<QString> groundMapOrder; //!< Serial numbers of the open ground maps, oldest use first
+    QMap<QString, IException> groundMapErrors;      //!< Why a ground map was not created
+    CubeManager *cubes;            //!< Open cubes for the DN restriction, NULL if unused
+    bool failed;                   //!< Seeding the chunk failed
+    IException error;              //!< Why seeding the chunk failed
+  };
+
+
+  /**
+   * Gets the ground map of an image of a chunk, creating it if it is not open.
+   * When more than MaxOpenImages ground maps are open, the least recently used
+   * one is deleted. An image that is missing from the FROMLIST or that has no
+   * camera fails the seeding.
+   *
+   * @param chunk The chunk to get the ground map for
+   * @param serialNumber The serial number of the image
+   * @return The ground map of the image
+   */
+  static UniversalGroundMap *groundMap(SeedChunk &chunk, const QString &serialNumber) {
+    if (chunk.groundMaps.contains(serialNumber)) {
+      chunk.groundMapOrder.removeOne(serialNumber);
+      chunk.groundMapOrder.append(serialNumber);
+      return chunk.groundMaps[serialNumber];
+    }
+
+    if (chunk.groundMapErrors.contains(serialNumber)) {
+      throw chunk.groundMapErrors[serialNumber];
+    }
+
+    if (!chunk.files->contains(serialNumber)) {
+      QString msg = "Unable to create a Universal Ground for Serial Number [";
+      msg += serialNumber + "] The associated image is more than ";
+      msg += "likely missing from your FROMLIST.";
+      chunk.groundMapErrors.insert(serialNumber,
+                                   IException(IException::User, msg, _FILEINFO_));
+      throw chunk.groundMapErrors[serialNumber];
+    }
+
+    UniversalGroundMap *gmap = NULL;
+    try {
+      QMutexLocker locker(chunk.cameraMutex);
+      Cube cube((*chunk.files)[serialNumber], "r");
+      gmap = new UniversalGroundMap(cube);
+    }
+    catch (IException &e) {
+      chunk.groundMapErrors.insert(serialNumber, e);
+      throw;
+    }
+
+    chunk.groundMaps.insert(serialNumber, gmap);
+    chunk.groundMapOrder.append(serialNumber);
+    while (chunk.groundMapOrder.size() > MaxOpenImages) {
+      delete chunk.groundMaps.take(chunk.groundMapOrder.takeFirst());
+    }
+
+    return gmap;
+  }
+
+
+  /**
+   * Deletes the ground maps and closes the cubes a chunk has open.
+   *
+   * @param chunk The chunk to close the images of
+   */
+  static void closeImages(SeedChunk &chunk) {
+    qDeleteAll(chunk.groundMaps);
+    chunk.groundMaps.clear();
+    chunk.groundMapOrder.clear();
+
+    delete chunk.cubes;
+    chunk.cubes = NULL;
+  }
+
+
+  /**
+   * Functor for QtConcurrent that seeds the overlaps of a chunk and projects
+   * the seeds into every image of each overlap
+   */
+  class SeedFunctor {
+    public:
+      SeedFunctor(const SeedCriteria &criteria, Progress *progress = NULL) :
+          m_criteria(criteria), m_progress(progress) { }
+
+      void operator()(SeedChunk &chunk) const;
+
+    private:
+      void seed(SeedChunk &chunk, OverlapSeeds &seeds) const;
+
+      const SeedCriteria &m_criteria;        //!< Criteria for the measures
+      Progress *m_progress;                  //!< Progress per overlap, NULL if threaded
+  };
+
+
+  /**
+   * Seeds every overlap of a chunk in order, then closes the images the chunk
+   * still has open.
+   *
+   * @param chunk The chunk to seed
+   */
+  void SeedFunctor::operator()(SeedChunk &chunk) const {
+    try {
+      for (int i = 0; i < chunk.overlaps.size(); i++) {
+        if (m_progress) {
+          m_progress->CheckStatus();
+        }
+        seed(chunk, chunk.overlaps[i]);
+      }
+    }
+    catch (IException &e) {
+      chunk.failed = true;
+      chunk.error = e;
+    }
+
+    closeImages(chunk);
+  }
+
+
+  /**
+   * Seeds one overlap and computes the measures of each seed. The seeds are
+   * projected into one image at a time, so each camera and cube is used for
+   * all the seeds of the overlap at once.
+   *
+   * @param chunk The chunk providing the seeder, seeding projection and
+   *              ground maps
+   * @param seeds The overlap to seed and its resulting points
+   */
+  void SeedFunctor::seed(SeedChunk &chunk, OverlapSeeds &seeds) const {
+    const ImageOverlap &overlap = *seeds.overlap;
+
+    // Seed this overlap with points
+    const geos::geom::MultiPolygon *polygonOverlaps = overlap.Polygon();
+    std::vector<geos::geom::Point *> points;
+
+    try {
+      geos::geom::MultiPolygon *mp = NULL;
+      if (m_criteria.seedDomain == XY) {
+        mp = PolygonTools::LatLonToXY(*polygonOverlaps, chunk.proj);
+      }
+      else if (m_criteria.seedDomain == SampleLine) {
+        mp = PolygonTools::LatLonToSampleLine(*polygonOverlaps, chunk.ugmap);
+      }
+      points = chunk.seeder->Seed(mp);
+      delete mp;
+    }
+    catch (IException &e) {
+      seeds.seedFailed = true;
+      seeds.seedError = e.toPvl().group(0).findKeyword("Message")[0];
+      return;
+    }
+
+    vector<geos::geom::Coordinate> seed;
+    for (unsigned int pt = 0; pt < points.size(); pt ++) {
+      if (m_criteria.seedDomain == XY) {
+        // Convert the X/Y points back to Lat/Lon points
+        if (chunk.proj->SetCoordinate(points[pt]->getX(), points[pt]->getY())) {
+          seed.push_back(geos::geom::Coordinate(chunk.proj->UniversalLongitude(),
+                                                chunk.proj->UniversalLatitude()));
+        }
+        else {
+          IString msg = "Unable to convert from X/Y to a (lon,lat)";
+          throw IException(IException::Unknown, msg, _FILEINFO_);
+        }
+      }
+      else if (m_criteria.seedDomain == SampleLine) {
+        // Convert the Sample/Line points back to Lat/Lon points
+        if (chunk.ugmap->SetImage(points[pt]->getX(), points[pt]->getY())) {
+          seed.push_back(geos::geom::Coordinate(chunk.ugmap->UniversalLongitude(),
+                                                chunk.ugmap->UniversalLatitude()));
+        }
+        else {
+          IString msg = "Unable to convert from Sample/Line to a (lon,lat)";
+          throw IException(IException::Unknown, msg, _FILEINFO_);
+        }
+      }
+    }
+
+    for (unsigned int pt = 0; pt < points.size(); pt ++) {
+      delete points[pt];
+    }
+
+    for (unsigned int pt = 0; pt < seed.size(); pt ++) {
+      seeds.points.append(QList<SeedMeasure>());
+    }
+    if (seed.size() == 0) {
+      return;
+    }
+
+    // Create a measurment of each point for each image in the overlap area
+    for (int sn = 0; sn < overlap.Size(); ++sn) {
+      UniversalGroundMap *gmap = groundMap(chunk, overlap[sn]);
+
+      // Check the DNs with the cube, Note: this is costly to do
+      Cube *cube = NULL;
+      if (chunk.cubes) {
+        cube = chunk.cubes->OpenCube((*chunk.files)[overlap[sn]]);
+      }
+
+      for (unsigned int pt = 0; pt < seed.size(); pt ++) {
+        bool ignore = false;
+
+        // Get the line/sample of the lat/lon for this cube
+        if (!gmap->SetUniversalGround(seed[pt].y, seed[pt].x)) {
+          // This error is more than likely due to floating point roundoff
+          continue;
+        }
+
+        // Check the line/sample with the gmap for image edge
+        if (m_criteria.pixelsFromEdge > gmap->Sample() ||
+            m_criteria.pixelsFromEdge > gmap->Line() ||
+            gmap->Sample() > gmap->Camera()->Samples() - m_criteria.pixelsFromEdge ||
+            gmap->Line() > gmap->Camera()->Lines() - m_criteria.pixelsFromEdge) {
+          ignore = true;
+        }
+
+        // Check the Emission/Incidence Angle with the camera from the gmap
+        if (gmap->Camera()->EmissionAngle() < m_criteria.minEmission ||
+            gmap->Camera()->EmissionAngle() > m_criteria.maxEmission) {
+          ignore = true;
+        }
+        if (gmap->Camera()->IncidenceAngle() < m_criteria.minIncidence ||
+            gmap->Camera()->IncidenceAngle() > m_criteria.maxIncidence) {
+          ignore = true;
+        }
+
+        if (cube) {
+          Brick brick(1, 1, 1, cube->pixelType());
+          brick.SetBasePosition((int)gmap->Camera()->Sample(), (int)gmap->Camera()->Line(),
+                                (int)gmap->Camera()->Band());
+          cube->read(brick);
+          if (Isis::IsSpecial(brick[0]) || brick[0] > m_criteria.maxDN ||
+              brick[0] < m_criteria.minDN) {
+            ignore = true;
+          }
+        }
+
+        // Check the Resolution with the camera from the gmap
+        if (gmap->Resolution() < m_criteria.minResolution ||
+            (m_criteria.maxResolution > 0.0 && gmap->Resolution() > m_criteria.maxResolution)) {
+          ignore = true;
+        }
+
+        SeedMeasure measure;
+        measure.serialNumber = overlap[sn];
+        measure.sample = gmap->Sample();
+        measure.line = gmap->Line();
+        measure.ignore = ignore;
+        seeds.points[pt].append(measure);
+      }
+    }
+  }
+
+
   void autoseed(UserInterface &ui, Pvl *log) {
     SerialNumberList serialNumbers(ui.GetFileName("FROMLIST"));
 
@@ -191,18 +510,29 @@ namespace Isis {
     ImageOverlapSet overlaps;
     overlaps.ReadImageOverlaps(ui.GetFileName("OVERLAPLIST"));
 
-    // Create a Universal Ground Map (UGM) for each image in the list
     int stats_noOverlap = 0;
     int stats_tolerance = 0;
 
-    map<QString, UniversalGroundMap *> gMaps;
+    // The file of each image in the FROMLIST. Ground maps are created from
+    // these before the overlaps are seeded.
+    QMap<QString, QString> files;
     for (int sn = 0; sn < serialNumbers.size(); ++sn) {
-      // Create the UGM for the cube associated with this SN
-      Cube cube(serialNumbers.fileName(sn), "r");
-      gMaps.insert(std::pair<QString, UniversalGroundMap *>
-                   (serialNumbers.serialNumber(sn), new UniversalGroundMap(cube)));
+      files.insert(serialNumbers.serialNumber(sn), serialNumbers.fileName(sn));
     }
 
+    SeedCriteria criteria;
+    criteria.seedDomain = seedDomain;
+    criteria.pixelsFromEdge = pixelsFromEdge;
+    criteria.minEmission = minEmission;
+    criteria.maxEmission = maxEmission;
+    criteria.minIncidence = minIncidence;
+    criteria.maxIncidence = maxIncidence;
+    criteria.hasDNRestriction = hasDNRestriction;
+    criteria.minDN = minDN;
+    criteria.maxDN = maxDN;
+    criteria.minResolution = minResolution;
+    criteria.maxResolution = maxResolution;
+
     stringstream errors(stringstream::in | stringstream::out);
     int errorNum = 0;
 
@@ -246,11 +576,12 @@ namespace Isis {
     int cpIgnoredCount = 0;
     int cmIgnoredCount = 0;
 
+    // Find the overlaps that need to be seeded
+    QList<OverlapSeeds> toSeed;
     for (int ov = 0; ov < overlaps.Size(); ++ov) {
-      progress.CheckStatus();
-
       if (overlaps[ov]->Size() == 1) {
         stats_noOverlap++;
+        progress.CheckStatus();
         continue;
       }
 
@@ -270,185 +601,179 @@ namespace Isis {
           }
         }
 
-        if (overlapSeeded) continue;
+        if (overlapSeeded) {
+          progress.CheckStatus();
+          continue;
+        }
       }
 
-      // Seed this overlap with points
-      const geos::geom::MultiPolygon *polygonOverlaps = overlaps[ov]->Polygon();
-      std::vector<geos::geom::Point *> points;
+      OverlapSeeds seeds;
+      seeds.overlap = overlaps[ov];
+      seeds.seedFailed = false;
+      toSeed.append(seeds);
+    }
 
-      try {
-        geos::geom::MultiPolygon *mp = NULL;
+    // Split the overlaps into chunks. When threaded, each chunk gets its own
+    // seeder, projection and ground maps and the chunks are seeded concurrently.
+    // There is one chunk per thread, and each chunk opens the images of its
+    // overlaps as it gets to them.
+    bool threaded = ui.GetBoolean("THREADED");
+    int numChunks = 1;
+    if (threaded) {
+      numChunks = QThreadPool::globalInstance()->maxThreadCount();
+      numChunks = max(1, min(numChunks, toSeed.size()));
+    }
+
+    QMutex cameraMutex;
+    QList<SeedChunk> chunks;
+    for (int c = 0; c < numChunks; c++) {
+      SeedChunk chunk;
+      int begin = (int) ((qint64) toSeed.size() * c / numChunks);
+      int end = (int) ((qint64) toSeed.size() * (c + 1) / numChunks);
+      chunk.overlaps = toSeed.mid(begin, end - begin);
+      chunk.seeder = seeder;
+      chunk.proj = proj;
+      chunk.ugmap = ugmap;
+      chunk.files = &files;
+      chunk.cameraMutex = &cameraMutex;
+      chunk.cubes = NULL;
+      chunk.failed = false;
+
+      if (hasDNRestriction) {
+        chunk.cubes = new CubeManager;
+        chunk.cubes->SetNumOpenCubes(MaxOpenImages);
+      }
+
+      if (threaded) {
+        chunk.seeder = PolygonSeederFactory::Create(seedDef);
+        chunk.proj = NULL;
+        chunk.ugmap = NULL;
         if (seedDomain == XY) {
-          mp = PolygonTools::LatLonToXY(*polygonOverlaps, proj);
+          chunk.proj = (TProjection *) ProjectionFactory::Create(maplab);
         }
         else if (seedDomain == SampleLine) {
-          mp = PolygonTools::LatLonToSampleLine(*polygonOverlaps, ugmap);
+          Cube cube;
+          cube.open(serialNumbers.fileName(0));
+          chunk.ugmap = new UniversalGroundMap(cube);
         }
-        points = seeder->Seed(mp);
       }
-      catch (IException &e) {
 
-        if (ui.WasEntered("ERRORS")) {
+      chunks.append(chunk);
+    }
 
-          if (errorNum > 0) {
-            errors << endl;
-          }
-          errorNum ++;
+    if (threaded) {
+      QFuture<void> future = QtConcurrent::map(chunks, SeedFunctor(criteria));
 
-          errors << e.toPvl().group(0).findKeyword("Message")[0];
-          for (int serNum = 0; serNum < overlaps[ov]->Size(); serNum++) {
-            if (serNum == 0) {
-              errors << ": ";
-            }
-            else {
-              errors << ", ";
-            }
-            errors << (*overlaps[ov])[serNum];
-          }
+      // Report progress by chunk as the threads finish them
+      progress.SetMaximumSteps(chunks.size());
+      progress.CheckStatus();
+      int reported = 0;
+      QMutex sleeper;
+      sleeper.lock();
+      while (!future.isFinished()) {
+        sleeper.tryLock(100);
+        for ( ; reported < future.progressValue(); reported++) {
+          progress.CheckStatus();
         }
-
-        continue;
       }
-
-      // No points were seeded in this polygon, so collect some stats and move on
-      if (points.size() == 0) {
-        stats_tolerance++;
-        continue;
+      for ( ; reported < future.progressValue(); reported++) {
+        progress.CheckStatus();
       }
+      sleeper.unlock();
 
-      vector<geos::geom::Point *> seed;
-      if (seedDomain == XY) {
-        // Convert the X/Y points back to Lat/Lon points
-        for (unsigned int pt = 0; pt < points.size(); pt ++) {
-          if (proj->SetCoordinate(points[pt]->getX(), points[pt]->getY())) {
-            seed.push_back(Isis::globalFactory->createPoint(
-                             geos::geom::Coordinate(proj->UniversalLongitude(),
-                                                    proj->UniversalLatitude())));
-          }
-          else {
-            IString msg = "Unable to convert from X/Y to a (lon,lat)";
-            throw IException(IException::Unknown, msg, _FILEINFO_);
-          }
-        }
-      }
-      else if (seedDomain == SampleLine) {
-        // Convert the Sample/Line points back to Lat/Lon points
-        for (unsigned int pt = 0; pt < points.size(); pt ++) {
-          if (ugmap->SetImage(points[pt]->getX(), points[pt]->getY())) {
-            seed.push_back(Isis::globalFactory->createPoint(
-                             geos::geom::Coordinate(ugmap->UniversalLongitude(),
-                                                    ugmap->UniversalLatitude())));
-          }
-          else {
-            IString msg = "Unable to convert from Sample/Line to a (lon,lat)";
-            throw IException(IException::Unknown, msg, _FILEINFO_);
-          }
-        }
+      for (int c = 0; c < chunks.size(); c++) {
+        delete chunks[c].seeder;
+        delete chunks[c].proj;
+        delete chunks[c].ugmap;
       }
+    }
+    else {
+      SeedFunctor seed(criteria, &progress);
+      seed(chunks[0]);
+    }
 
-      //   Create a control point for each seeded point in this overlap
-      for (unsigned int point = 0; point < seed.size(); ++point) {
-
-        ControlPoint *controlpt = new ControlPoint();
-        controlpt->SetId(pointId.Next());
-        controlpt->SetType(ControlPoint::Free);
+    // Create the control points in overlap order so the point ids do not
+    // depend on the number of threads
+    for (int c = 0; c < chunks.size(); c++) {
+      if (chunks[c].failed) {
+        throw chunks[c].error;
+      }
 
-        // Create a measurment at this point for each image in the overlap area
-        for (int sn = 0; sn < overlaps[ov]->Size(); ++sn) {
-          bool ignore = false;
+      for (int i = 0; i < chunks[c].overlaps.size(); i++) {
+        const OverlapSeeds &seeds = chunks[c].overlaps[i];
 
-          // Get the line/sample of the lat/lon for this cube
-          UniversalGroundMap *gmap = gMaps[(*overlaps[ov])[sn]];
+        if (seeds.seedFailed) {
+          if (ui.WasEntered("ERRORS")) {
 
-          if (!gmap) {
-            QString msg = "Unable to create a Universal Ground for Serial Number [";
-            msg += (*overlaps[ov])[sn] + "] The associated image is more than ";
-            msg += "likely missing from your FROMLIST.";
-            throw IException(IException::User, msg, _FILEINFO_);
+            if (errorNum > 0) {
+              errors << endl;
+            }
+            errorNum ++;
+
+            errors << seeds.seedError;
+            for (int serNum = 0; serNum < seeds.overlap->Size(); serNum++) {
+              if (serNum == 0) {
+                errors << ": ";
+              }
+              else {
+                errors << ", ";
+              }
+              errors << (*seeds.overlap)[serNum];
+            }
           }
 
-          if (!gmap->SetUniversalGround(seed[point]->getY(), seed[point]->getX())) {
-            // This error is more than likely due to floating point roundoff
-            continue;
-          }
+          continue;
+        }
 
-          // Check the line/sample with the gmap for image edge
-          if (pixelsFromEdge > gmap->Sample() || pixelsFromEdge > gmap->Line()
-              || gmap->Sample() > gmap->Camera()->Samples() - pixelsFromEdge
-              || gmap->Line() > gmap->Camera()->Lines() - pixelsFromEdge) {
-            ignore = true;
-          }
+        // No points were seeded in this polygon, so collect some stats and move on
+        if (seeds.points.size() == 0) {
+          stats_tolerance++;
+          continue;
+        }
 
-          // Check the Emission/Incidence Angle with the camera from the gmap
-          if (gmap->Camera()->EmissionAngle() < minEmission ||
-              gmap->Camera()->EmissionAngle() > maxEmission) {
-            ignore = true;
-          }
-          if (gmap->Camera()->IncidenceAngle() < minIncidence ||
-              gmap->Camera()->IncidenceAngle() > maxIncidence) {
-            ignore = true;
-          }
+        //   Create a control point for each seeded point in this overlap
+        for (int point = 0; point < seeds.points.size(); ++point) {
 
-          // Check the DNs with the cube, Note: this is costly to do
-          if (hasDNRestriction) {
-            Cube cube;
-            QString c = serialNumbers.fileName((*overlaps[ov])[sn]);
-            cube.open(c);
-            Brick brick(1, 1, 1, cube.pixelType());
-            brick.SetBasePosition((int)gmap->Camera()->Sample(), (int)gmap->Camera()->Line(), (int)gmap->Camera()->Band());
-            cube.read(brick);
-            if (Isis::IsSpecial(brick[0]) || brick[0] > maxDN || brick[0] < minDN) {
-              ignore = true;
-            }
-          }
+          ControlPoint *controlpt = new ControlPoint();
+          controlpt->SetId(pointId.Next());
+          controlpt->SetType(ControlPoint::Free);
 
-          // Check the Resolution with the camera from the gmap
-          if (gmap->Resolution() < minResolution ||
-              (maxResolution > 0.0 && gmap->Resolution() > maxResolution)) {
-            ignore = true;
-          }
+          const QList<SeedMeasure> &measures = seeds.points[point];
+          for (int m = 0; m < measures.size(); m++) {
+            // Put the line/samp into a measurment
+            ControlMeasure *measurement = new ControlMeasure();
+            measurement->SetAprioriSample(measures[m].sample);
+            measurement->SetAprioriLine(measures[m].line);
+            measurement->SetCoordinate(measures[m].sample, measures[m].line,
+                                      ControlMeasure::Candidate);
 
-          // Put the line/samp into a measurment
-          ControlMeasure *measurement = new ControlMeasure();
-          measurement->SetAprioriSample(gmap->Sample());
-          measurement->SetAprioriLine(gmap->Line());
-          measurement->SetCoordinate(gmap->Sample(), gmap->Line(),
-                                    ControlMeasure::Candidate);
+            measurement->SetType(ControlMeasure::Candidate);
+            measurement->SetCubeSerialNumber(measures[m].serialNumber);
+            measurement->SetIgnored(measures[m].ignore);
 
-          measurement->SetType(ControlMeasure::Candidate);
-          measurement->SetCubeSerialNumber((*(overlaps[ov]))[sn]);
-          measurement->SetIgnored(ignore);
+            if (measures[m].ignore) {
+              cmIgnoredCount ++;
+            }
 
-          if (ignore) {
-            cmIgnoredCount ++;
+            controlpt->Add(measurement); //controlpt takes ownership
+            measurement = NULL;
           }
 
-          controlpt->Add(measurement); //controlpt takes ownership
-          measurement = NULL;
-        }
-
-        if (controlpt->GetNumValidMeasures() < 2) {
-          controlpt->SetIgnored(true);
-          cpIgnoredCount ++;
-        }
-
-        if (controlpt->GetNumMeasures() > 0) {
-          cnet.AddPoint(controlpt); //cnet takes ownership
-        }
-        delete seed[point];
-
-      } // End of create control points loop
+          if (controlpt->GetNumValidMeasures() < 2) {
+            controlpt->SetIgnored(true);
+            cpIgnoredCount ++;
+          }
 
+          if (controlpt->GetNumMeasures() > 0) {
+            cnet.AddPoint(controlpt); //cnet takes ownership
+          }
+          else {
+            delete controlpt;
+          }
+        } // End of create control points loop
+      }
     } // End of seeding loop
 
-    // All done with the UGMs so delete them
-    for (unsigned int sn = 0; sn < gMaps.size(); ++sn) {
-      UniversalGroundMap *gmap = gMaps[serialNumbers.serialNumber(sn)];
-      delete gmap;
-    }
-    gMaps.clear();
-
     for (unsigned int i = 0 ; i < points.size(); i ++) {
       delete points[i];
       points[i] = NULL;
@@ -25,6 +25,7 @@
 #include <cmath>
 
 #include <QtAlgorithms>
+#include <QHash>
 #include <QMap>
 #include <QPair>
 #include <QSharedPointer>
@@ -255,6 +256,37 @@ namespace Isis {
   }
 
 
+/**
+ * Returns control measures and their associated indicies for several cubes at once. The points
+ * are read once for all of the cubes, rather than once for each cube, and each PointSet is in
+ * the same order as getCubeMeasureIndices(const QString &) returns it.
+ * 
+ * @param serialNos Serial numbers of the cubes to get the measure indicies for.
+ * 
+ * @return @b QVector<CnetManager::PointSet> The calculated indices and measures of each cube, 
+ *                                           in the order of the serial numbers.
+ */
+  QVector<CnetManager::PointSet> CnetManager::getCubeMeasureIndices(const QStringList &serialNos) 
+                                                                     const {
+    QHash<QString, int> cubes;
+    for (int i = 0; i < serialNos.size(); i++) {
+      cubes.insert(serialNos[i], i);
+    }
+
+    QVector<PointSet> cubeNdx(serialNos.size());
+    BOOST_FOREACH ( const KPoint &p, m_kpts ) {
+      QList<ControlMeasure *> measures = p.point()->getMeasures();
+      BOOST_FOREACH ( ControlMeasure *m, measures ) {
+        QHash<QString, int>::const_iterator cube = cubes.constFind(m->GetCubeSerialNumber());
+        if ( cube != cubes.constEnd() ) {
+          cubeNdx[cube.value()].append( qMakePair(p.index(), m) );
+        }
+      }
+    }
+    return ( cubeNdx );
+  }
+
+
 /**
  * Will return the KPoint at an input index. 
  * 
@@ -150,6 +150,7 @@ namespace Isis {
       QMap<QString, int> getCubeMeasureCount() const;
       const QList<ControlPoint *> getControlPoints() const;
       PointSet getCubeMeasureIndices(const QString &serialNo) const;
+      QVector<PointSet> getCubeMeasureIndices(const QStringList &serialNos) const;
 
       const KPoint &operator()(const int index) const;
       const ControlPoint *point(const int &index) const;
@@ -24,13 +24,16 @@
 #include <cfloat>
 #include <cmath>
 
+#include <QHash>
 #include <QMap>
 #include <QPair>
+#include <QPointF>
 #include <QRectF>
 #include <QSizeF>
 #include <QSharedPointer>
 #include <QString>
 #include <QStringList>
+#include <QtConcurrentMap>
 
 #include <boost/foreach.hpp>
 
@@ -54,7 +57,7 @@ namespace Isis {
  * Constructs an empty CnetSuppression object. 
  * 
  */
-  CnetSuppression::CnetSuppression() : CnetManager(), m_cnet(), m_points(), m_results(), 
+  CnetSuppression::CnetSuppression() : CnetManager(), m_cnet(), m_points(), 
                                        m_early_term(EARLY_TERMINATION), 
                                        m_area() { }
 
@@ -67,7 +70,7 @@ namespace Isis {
  * @throws IException::User "Control Net filename [FILENAME] is invalid." 
  */
   CnetSuppression::CnetSuppression(const QString &cnetfile, const double &weight) : 
-                                   CnetManager( ), m_cnet(), m_points(), m_results(), 
+                                   CnetManager( ), m_cnet(), m_points(), 
                                    m_early_term(EARLY_TERMINATION), 
                                    m_area() {
 
@@ -92,7 +95,6 @@ namespace Isis {
   CnetSuppression::CnetSuppression(const CnetManager &cman) : 
                                    CnetManager(cman), 
                                    m_cnet(), m_points(), 
-                                   m_results(), 
                                    m_early_term(EARLY_TERMINATION), 
                                    m_area() { }
 
@@ -123,6 +125,13 @@ namespace Isis {
  * Performs a suppression on all cubes associated with the CnetSuppression object and returns the 
  * results as a Results object. An input bitmask will be used to mask all pointsets associated with 
  * all cubes before running the suppression.  
+ *  
+ * The cubes are suppressed from the highest to the lowest measure count, and the points kept from 
+ * each cube are fixed in the cubes after it. A cube only depends on the earlier cubes that share 
+ * points with it, so the cubes are grouped into jobs where no two cubes share a point and each 
+ * job only follows the jobs its cubes depend on. The cubes of a job are suppressed in parallel 
+ * and the results are merged in the original order, so the result is the same as suppressing the 
+ * cubes one at a time. 
  * 
  * @param minpts minimum points to keep in the result set
  * @param maxpts maximum points to keep in the result set. 
@@ -155,29 +164,81 @@ namespace Isis {
     }
 #endif
 
-    // Suppress points in highest to lowest count
-    m_results.clear();
-    BitMask myBm = bm;
-    Results final;
+    QStringList serials;
+    for ( int p = 0 ; p < pntcount.size() ; p++) {
+      serials.append(pntcount[p].first);
+    }
+    QVector<PointSet> cubesets = getCubeMeasureIndices(serials);
+
+    // Each cube goes in the job after the last job holding any of its points. The scale is
+    // found in suppression order since the first cube sets the reference area.
+    QVector<int> pointJob(size(), -1);
+    QVector<QList<ImageJob> > jobs;
     for ( int p = 0 ; p < pntcount.size() ; p++) {
-      QString serialno = pntcount[p].first;
+      ImageJob job;
+      job.order = p;
+      job.points = cubesets[p];
+      job.domain = domain(job.points);
+      job.scale = getScale(job.domain.size());
+      job.radius = 1.0;
+      cubesets[p] = PointSet();
+
+      int jobIndex = 0;
+      BOOST_FOREACH ( const IndexPoint &pt, job.points ) {
+        jobIndex = qMax(jobIndex, pointJob[index(pt)] + 1);
+      }
+      BOOST_FOREACH ( const IndexPoint &pt, job.points ) {
+        pointJob[index(pt)] = jobIndex;
+      }
+
+      if ( jobIndex >= jobs.size() ) { jobs.resize(jobIndex + 1); }
+      jobs[jobIndex].append(job);
+    }
 
 #if defined(DEBUG)
-//      int pts = pntcount[p].second;
-      std::cout << "\n--> Serial: " << serialno.toStdString() << "\n";
+    std::cout << "  Images: " << pntcount.size() << " in " << jobs.size() << " jobs\n";
 #endif
 
-      Results r = suppress(serialno, minpts, maxpts, min_radius, 
-                           tolerance, myBm);
-      m_results.append(r);
+    // Suppress points in highest to lowest count. The first image uses the input mask and the 
+    // rest use the points kept from the images before them.
+    BitMask selected(size(), false);
+    SuppressFunctor functor(this, &bm, &selected, minpts, maxpts, min_radius, tolerance);
+    QVector<ImageJob> done(pntcount.size());
+    for ( int j = 0 ; j < jobs.size() ; j++) {
+      QtConcurrent::blockingMap(jobs[j], functor);
+
+      BOOST_FOREACH ( const ImageJob &job, jobs[j] ) {
+        BOOST_FOREACH ( const IndexPoint &pt, job.selected ) {
+          selected[index(pt)] = true;
+        }
+        done[job.order] = job;
+      }
+      jobs[j].clear();
+    }
+
+    // Merge the results in suppression order
+    Results final;
+    for ( int p = 0 ; p < done.size() ; p++) {
 
 #if defined(DEBUG)
-      std::cout << "  Total Saved: " << r.size() << " at cell radius " 
-                << r.m_radius << "\n";
+      std::cout << "\n--> Serial: " << serials[p].toStdString() << "\n";
+      std::cout << "  Total Saved: " << done[p].selected.size() << " at cell radius " 
+                << done[p].radius << "\n";
 #endif
 
-      final = merge(r,final);
-      myBm = final.m_selected;
+      if ( !final.isValid() ) {
+        final = Results(size(), done[p].domain, done[p].radius);
+        final.add(done[p].selected);
+      }
+      else {
+        // Merged results have no single domain or radius
+        final.m_domain = QRectF();
+        final.m_radius = 0;
+        BOOST_FOREACH ( const IndexPoint &pt, done[p].selected ) {
+          if ( !final.m_selected[index(pt)] ) { final.add(pt); }
+        }
+      }
+      done[p] = ImageJob();
     }
    
     return (final);
@@ -233,16 +294,58 @@ namespace Isis {
 
     // Bounding box of control points
     QRectF d = domain(points);
+    double scale = getScale( d.size() );
+
+    // Determine if any previously selected points are contained in this set
+    PointSet fixed( contains(bm, points) );
+
+    double radius;
+    PointSet kept = suppressImage(points, fixed, d, scale, minpts, maxpts, min_radius, 
+                                  tolerance, radius);
+
+    // Caller should check to determine if success
+    Results result(size(), d, radius);
+    result.add(kept);
+    return (result);
+  }
+
+
+/**
+ * Suppresses the points of one image. This runs a binary search over the cell radius, each 
+ * pass keeping the points in order whose cell is not covered by a point already kept. 
+ *  
+ * The coordinates of the points are read from their measures once, and each pass keeps the 
+ * covered cells in a CoverageIndex instead of a grid the size of the image. This only reads 
+ * the suppression, so several images can be suppressed at the same time. 
+ * 
+ * @param points The point set to run suppression on.
+ * @param fixed The points in the set that have already been selected. 
+ * @param d The bounding box of the points. 
+ * @param scale The fraction of maxpts to keep for this image. 
+ * @param minpts The minimum possible points to keep after a suppression run. 
+ * @param maxpts The maximum possible points to keep after a suppression run. 
+ * @param min_radius The minimum radius to use for the suppression calculation. 
+ * @param tolerance A tolerance factor which scales the size of the search space for suppression. 
+ * @param radius The cell radius of the final pass (Result). 
+ * 
+ * @return @b CnetSuppression::PointSet The fixed points followed by the points kept. 
+ */
+  CnetSuppression::PointSet CnetSuppression::suppressImage(const CnetSuppression::PointSet &points,
+                                                           const CnetSuppression::PointSet &fixed,
+                                                           const QRectF &d, const double &scale, 
+                                                           const int &minpts, const int &maxpts, 
+                                                           const double &min_radius,
+                                                           const double &tolerance, 
+                                                           double &radius) const {
 
     double max_radius = qMax(d.width(), d.height());
     int num = qMax(qFloor(max_radius - min_radius), 11); //TODO not sure where the 11 came from...?
     QVector<double> radii = linspace(min_radius, max_radius, num, 
                                      1.0/qSqrt(2.0) );
 
-    QPointF botR = d.bottomRight();
-
 #if defined(DEBUG)
     QPointF topL = d.topLeft();
+    QPointF botR = d.bottomRight();
     std::cout << "  Domain((x), (y)): (" << topL.x() << "," << botR.x() 
               << "), (" << topL.y() << "," << botR.y() << ")\n";
     std::cout << "  Min.Max, count Radius: " << min_radius << ", "
@@ -250,21 +353,17 @@ namespace Isis {
 #endif
 
     // Get scaled points to save
-    int v_maxpts = int ( (double) maxpts * getScale( d.size() ) );
+    int v_maxpts = int ( (double) maxpts * scale );
     v_maxpts = qMax(v_maxpts, minpts);
     int pnttol = qFloor( (v_maxpts * tolerance) + 0.5 );
 
-
-    // Determine if any previously selected points are contained in this set
-    PointSet fixed( contains(bm, points) );
-
 #if defined(DEBUG)
     std::cout << "  FixedPoints: " << fixed.size() << " - ToSave: " 
               << v_maxpts << " (scaled) - Pnttol: " << pnttol << "\n";
 #endif
 
-    Results result(size(), d, 1.0);
-    result.add(fixed);
+    radius = 1.0;
+    PointSet result(fixed);
 
     // Check for a termination condition on input
     if (  result.size() > (v_maxpts - pnttol)  ) {
@@ -273,55 +372,45 @@ namespace Isis {
       std::cout << " ++> Initial condition met - return input set\n";
 #endif
 
-      m_results.append(result);
       return (result);
     }
+
+    // The coordinates are the same for every pass
+    QVector<QPointF> coords(points.size());
+    for ( int i = 0 ; i < points.size() ; i++) {
+      coords[i] = QPointF(measure(points[i])->GetSample(), measure(points[i])->GetLine());
+    }
+    QVector<QPointF> fixedCoords(fixed.size());
+    for ( int i = 0 ; i < fixed.size() ; i++) {
+      fixedCoords[i] = QPointF(measure(fixed[i])->GetSample(), measure(fixed[i])->GetLine());
+    }
     
     // Binary loop around cell radius list
     int bmin = 0;
     int bmax = radii.size() - 1;
     while ( (bmax-bmin) > 1 ) {
       int bmid = (bmin + bmax) / 2;
-
-#if defined(DEBUG)
-//      std::cout << "  \nBSearchIndx: (" << bmin << "," << bmid << "," << bmax << ")\n";
-#endif
-
       double cell_size = radii[bmid];
-      int n_x_cells = qCeil(botR.x() / cell_size);
-      int n_y_cells = qCeil(botR.y() / cell_size);
-      BOOST_ASSERT ( n_x_cells > 0 );
-      BOOST_ASSERT ( n_y_cells > 0 );
 
-#if defined(DEBUG)
-      std::cout << "  CellRadius(x,y): " << cell_size << " - "
-                << "Grid(" << n_x_cells << "," << n_y_cells << ")\n";
-#endif
-
-      // Create initial coverage grid with fixed points
-      GridMask grid(n_x_cells, n_y_cells, false);
-      result = Results(size(), d, cell_size);
-      result.add(fixed);
-      cover(grid, fixed, cell_size);
-
-#if defined(DEBUG)
-      int nIcov = cover(grid, fixed, cell_size);
-      std::cout << "  InitialCoverage: " << nIcov << "\n";
-#endif
+      // Create initial coverage with fixed points. NOTE the cover is a square, NOT euclidean 
+      // distance!!!
+      CoverageIndex coverage( int(cell_size+0.5) );
+      radius = cell_size;
+      result = fixed;
+      BOOST_FOREACH ( const QPointF &c, fixedCoords ) {
+        coverage.add( int(c.x() / cell_size), int(c.y() / cell_size) );
+      }
 
       // Evaluate all points
-      int x_center, y_center;
       for ( int i = 0 ; i < points.size() ; i++) {
-
-        cellIndex(points[i], cell_size, x_center,  y_center);
-        BOOST_ASSERT ( x_center < n_x_cells );
-        BOOST_ASSERT ( y_center < n_y_cells );
+        int x_center = int(coords[i].x() / cell_size);
+        int y_center = int(coords[i].y() / cell_size);
 
         // Got one, update result state
-        if ( false == grid[x_center][y_center] ) {
+        if ( !coverage.covered(x_center, y_center) ) {
 
           // First check to see if we have exceeded the requested results set
-          result.add(points[i]);
+          result.append(points[i]);
           if ( m_early_term ) {
             if ( result.size() > (v_maxpts + pnttol) ) {
               bmin = bmid;
@@ -330,19 +419,13 @@ namespace Isis {
           }
 
           // Compute cell coverage
-          cover(grid, x_center, y_center, cell_size);
-
-#if defined(DEBUG)
-          int ncov = cover(grid, x_center, y_center, cell_size);
-          std::cout << "  TotalCovered: " << ncov << "(" << nCovered(grid) 
-                    << ") of " << (n_x_cells*n_y_cells) << "\n"; 
-#endif
-
+          coverage.add(x_center, y_center);
         }
       }
 
-      // Results of search...
-//      std::cout << "  PointsFound: " << result.size() << "\n";
+#if defined(DEBUG)
+      std::cout << "  CellRadius: " << cell_size << " - PointsFound: " << result.size() << "\n";
+#endif
 
       // Now determine if we have enough points to call it good
       if (  (result.size() >= (v_maxpts - pnttol) ) &&  
@@ -361,7 +444,6 @@ namespace Isis {
       }
     }
 
-    // Caller should check to determine if success
     return (result);
   }
 
@@ -492,103 +574,6 @@ namespace Isis {
   }
 
 
-/**
- * Calculates the (x,y) coordinates for an IndexPoint inside of a cell 
- * of input size.  
- * 
- * @param p The index point to calculate the x_center and y_center of.
- * @param cell_size Size of the cell.
- * @param x_center The x-coordinate of the center of the cell (Result).
- * @param y_center The y-coordinate of the center of the cell (Result).
- */
-  void CnetSuppression::cellIndex(const CnetSuppression::IndexPoint &p, 
-                                  const double &cell_size, 
-                                  int &x_center, int &y_center) const {
-    x_center = int((measure(p)->GetSample()) / cell_size);
-    y_center = int((measure(p)->GetLine())   / cell_size);
-    return;
-  }
-
-
-/**
- * Determine the number of (x,y) positions in the input grid which are set to true. 
- *  
- * @param grid The grid to calculate the number of covered points from. 
- * 
- * @return @b int The number of convered points; the number of (x,y) positions for which the bitmask 
- *                is set to true. 
- */
-  int CnetSuppression::nCovered(const CnetSuppression::GridMask &grid) const {
-    int ncov(0);
-    for ( int x = 0 ; x < grid.dim1() ; x++) {
-      for ( int y = 0 ; y < grid.dim2() ; y++) {
-        if ( grid[x][y] == true) ncov++;
-      }
-    }
-    return (ncov);
-  }
-
-
-/**
- * Update a grid to contain true values where it is covered by cells as defined by the input 
- * PointSet.  
- *  
- * @param grid The grid to update by setting to true grid entries which are contained within cells 
- *             definted by the input PointSet. 
- * @param points The input PointSet to use to update the grid. 
- * @param cell_size The size of a cell.
- * 
- * @return @b int The number of grid entries updated. 
- */
-  int CnetSuppression::cover(CnetSuppression::GridMask &grid, 
-                             const CnetSuppression::PointSet &points, 
-                             const double &cell_size) const {
-
-    int x_center, y_center, ncov(0);
-    BOOST_FOREACH ( const IndexPoint &p, points ) {
-      cellIndex(p, cell_size, x_center, y_center);
-      ncov = cover(grid, x_center, y_center, cell_size);
-    }
-    return (ncov); //ncov should be += for _all_ covered? 
-  }
-
-
-/**
- * Update a grid to contain true values where it overlaps a rectangle defined by the 
- * input paramters and return the number of values contained in this rectange.  
- *  
- * @param grid The grid to update by setting to true grid entries contained within the 
- *             rectangle defined by the paramters passed to this function.
- * @param x_center The x-coordinate of the center of the grid. 
- * @param y_center The y-coordinate of the center of the grid. 
- * @param cell_size The size of a cell. 
- * 
- * @return @b int The number of covered cells. 
- */
-  int CnetSuppression::cover(CnetSuppression::GridMask &grid, 
-                             const int &x_center, const int &y_center, 
-                             const double &cell_size) const {
-
-    int n_x_cells = grid.dim1();
-    int n_y_cells = grid.dim2();
-
-    // Compute the cover. NOTE this is a rectangle, NOT euclidean distance!!!
-    int g_x_min = qMax(x_center - int(cell_size+0.5), 0);
-    int g_x_max = qMin(x_center + int(cell_size+0.5), n_x_cells-1);
-    int g_y_min = qMax(y_center - int(cell_size+0.5), 0);
-    int g_y_max = qMin(y_center + int(cell_size+0.5), n_y_cells-1);
-
-#if defined(DEBUG)
-    std::cout << "  CellCover: (" << g_x_min << "," << g_x_max << ")("
-              << g_y_min << "," << g_y_max << ")\n";
-#endif
-
-    grid.subarray(g_x_min, g_x_max, g_y_min, g_y_max) = true;
-    int ncov = (g_x_max-g_x_min+1) * (g_y_max-g_y_min+1);
-    return ( ncov );
-  }
-
-
 /**
  * Merge two PointSets together and return the result. 
  * 
@@ -709,5 +694,45 @@ namespace Isis {
   }
 
 
+/**
+ * Constructs a SuppressFunctor. Nothing is owned by the functor. 
+ * 
+ * @param suppression The suppression being run.
+ * @param initial Mask of the points kept before the first image. 
+ * @param selected Mask of the points kept from the images of the earlier jobs. 
+ * @param minpts The minimum possible points to keep from each image. 
+ * @param maxpts The maximum possible points to keep from each image. 
+ * @param min_radius The minimum radius to use for the suppression calculation. 
+ * @param tolerance A multiplicative tolerance on the number of maxpoints to return. 
+ */
+  CnetSuppression::SuppressFunctor::SuppressFunctor(const CnetSuppression *suppression, 
+                                                    const CnetSuppression::BitMask *initial,
+                                                    const CnetSuppression::BitMask *selected,
+                                                    const int &minpts, const int &maxpts, 
+                                                    const double &min_radius,
+                                                    const double &tolerance) : 
+                                                    m_suppression(suppression), 
+                                                    m_initial(initial), m_selected(selected),
+                                                    m_minpts(minpts), m_maxpts(maxpts), 
+                                                    m_min_radius(min_radius), 
+                                                    m_tolerance(tolerance) { }
+
+
+/**
+ * Suppresses the points of an image. The points kept from the earlier images are fixed, 
+ * except for the first image, which uses the mask given to the suppression. 
+ * 
+ * @param job The image to suppress. 
+ */
+  void CnetSuppression::SuppressFunctor::operator()(CnetSuppression::ImageJob &job) const {
+    const BitMask &bm = ( job.order == 0 ) ? *m_initial : *m_selected;
+    PointSet fixed( m_suppression->contains(bm, job.points) );
+    job.selected = m_suppression->suppressImage(job.points, fixed, job.domain, job.scale,
+                                                m_minpts, m_maxpts, m_min_radius, 
+                                                m_tolerance, job.radius);
+    job.points = PointSet();
+  }
+
+
 } // namespace Isis
 
@@ -25,7 +25,10 @@
 #include <cfloat>
 #include <cmath>
 
+#include <QHash>
+#include <QList>
 #include <QMap>
+#include <QPoint>
 #include <QRectF>
 #include <QSharedPointer>
 #include <QSizeF>
@@ -133,6 +136,74 @@ namespace Isis {
           double     m_radius; //! 
       };
 
+      /**
+       * @brief Cells covered by the points kept in one pass 
+       *  
+       * A kept point covers the square of cells within the cell radius of its own 
+       * cell. Rather than marking every cell of the image, the kept cells are stored 
+       * in buckets as wide as the radius, so whether a cell is covered is found from 
+       * the few kept cells in the nine buckets around it. The memory used depends on 
+       * the points kept, not on the size of the image. 
+       */
+      class CoverageIndex {
+        public:
+          CoverageIndex(const int &reach) : m_reach(reach), m_width(qMax(reach, 1)),
+                                            m_buckets() { }
+          ~CoverageIndex() { }
+
+
+        /**
+         * True if a cell is covered by any cell that has been added.
+         * 
+         * @param x The x index of the cell.
+         * @param y The y index of the cell.
+         * 
+         * @return @b bool True if the cell is covered.
+         */
+          inline bool covered(const int &x, const int &y) const {
+            int b_x = bucket(x);
+            int b_y = bucket(y);
+            for ( int i = b_x - 1 ; i <= b_x + 1 ; i++ ) {
+              for ( int j = b_y - 1 ; j <= b_y + 1 ; j++ ) {
+                QHash<quint64, QVector<QPoint> >::const_iterator cells = 
+                    m_buckets.constFind(key(i, j));
+                if ( cells == m_buckets.constEnd() ) continue;
+                BOOST_FOREACH ( const QPoint &c, cells.value() ) {
+                  if ( (qAbs(c.x() - x) <= m_reach) && (qAbs(c.y() - y) <= m_reach) ) {
+                    return (true);
+                  }
+                }
+              }
+            }
+            return (false);
+          }
+
+
+        /**
+         * Add a kept cell, covering the cells around it. 
+         * 
+         * @param x The x index of the cell.
+         * @param y The y index of the cell.
+         */
+          inline void add(const int &x, const int &y) {
+            m_buckets[key(bucket(x), bucket(y))].append(QPoint(x, y));
+            return;
+          }
+
+        private:
+          inline int bucket(const int &cell) const {
+            return ( (cell >= 0) ? (cell / m_width) : -((-cell - 1) / m_width) - 1 );
+          }
+
+          static inline quint64 key(const int &b_x, const int &b_y) {
+            return ( (quint64(quint32(b_x)) << 32) | quint32(b_y) );
+          }
+
+          int m_reach; //! The cells covered on each side of a kept cell
+          int m_width; //! The number of cells in each bucket
+          QHash<quint64, QVector<QPoint> > m_buckets; //! Kept cells by bucket
+      };
+
       CnetSuppression();
       CnetSuppression(const QString &cnetfile, const double &weight = 0.0);
       CnetSuppression(const CnetManager &cman);
@@ -164,10 +235,50 @@ namespace Isis {
       const ControlNet *net() const;
 
     private:
+      /**
+       * The points of one image and the points kept from it by a suppression. 
+       *  
+       * Images that share no points with each other are suppressed at the same time, 
+       * so each image keeps what it needs from the earlier images in its job. 
+       */
+      struct ImageJob {
+        int      order;    //! Position of the image in the suppression order
+        PointSet points;   //! The points measured in the image
+        QRectF   domain;   //! Bounding box of the measures in the image
+        double   scale;    //! Fraction of the reference area covered by the image
+        PointSet selected; //! The points kept from the image
+        double   radius;   //! The cell radius of the final pass
+      };
+
+
+      /**
+       * @brief Suppresses the points of one image for QtConcurrent 
+       *  
+       * The images of a job are independent, so the functor only reads the suppression 
+       * and the masks of the points that have already been selected. 
+       */
+      class SuppressFunctor {
+        public:
+          SuppressFunctor(const CnetSuppression *suppression, const BitMask *initial, 
+                          const BitMask *selected, const int &minpts, const int &maxpts, 
+                          const double &min_radius, const double &tolerance);
+
+          void operator()(ImageJob &job) const;
+
+        private:
+          const CnetSuppression *m_suppression; //! The suppression being run
+          const BitMask *m_initial;  //! Mask of the points kept before the first image
+          const BitMask *m_selected; //! Mask of the points kept from the earlier images
+          int            m_minpts;   //! The minimum points to keep from each image
+          int            m_maxpts;   //! The maximum points to keep from each image
+          double         m_min_radius; //! The minimum cell radius
+          double         m_tolerance;  //! The tolerance on the number of points kept
+      };
+
+
       QScopedPointer<ControlNet> m_cnet; //!
       QList<ControlPoint *>      m_points; //!
       BitMask                    m_saved; //!
-      QVector<Results>           m_results; //!
       bool                       m_early_term; //! Will terminate early if true
       mutable QSizeF             m_area; //!
 
@@ -176,14 +287,11 @@ namespace Isis {
       BitMask  maskPoints(int nbits, const PointSet &p) const;
       PointSet contains(const BitMask &bm, const PointSet &pset) const;
 
-
-      void cellIndex(const IndexPoint &p, const double &cell_size,
-                     int &x_center, int &y_center) const;
-      int nCovered(const GridMask &grid) const;
-      int cover(GridMask &grid, const PointSet &points, 
-                const double &cell_size) const;
-      int cover(GridMask &grid, const int &x_center, const int &y_center, 
-                const double &cell_size) const;
+      PointSet suppressImage(const PointSet &points, const PointSet &fixed, 
+                             const QRectF &d, const double &scale, 
+                             const int &minpts, const int &maxpts, 
+                             const double &min_radius, const double &tolerance, 
+                             double &radius) const;
 
       PointSet merge(const PointSet &s1, const PointSet &s2) const;
       Results  merge(const Results &r1, const Results &r2) const;
@@ -96,6 +96,14 @@ CropTransform::CropTransform(const QString &name,
 #endif
 }
 
+/** Return the generic transform signature along with the crop region */
+QString CropTransform::signature() const {
+  return ( GenericTransform::signature() + "[" +
+           QString::number(m_crop.x) + "," + QString::number(m_crop.y) + "," +
+           QString::number(m_crop.width) + "," +
+           QString::number(m_crop.height) + "]" );
+}
+
 /**
  * @brief Crop the input image as specfied in the contructor
  * 
@@ -55,6 +55,7 @@ class CropTransform : public GenericTransform {
     CropTransform(const QString &name, const RectArea &region);
     virtual ~CropTransform();
 
+    virtual QString signature() const;
     virtual cv::Mat render(const cv::Mat &image) const;
 
   protected:
@@ -0,0 +1,213 @@
+/**
+ * @file
+ * $Revision$
+ * $Date$
+ * $Id$
+ *
+ *   Unless noted otherwise, the portions of Isis written by the USGS are
+ *   public domain. See individual third-party library and package descriptions
+ *   for intellectual property information, user agreements, and related
+ *   information.
+ *
+ *   Although Isis has been used by the USGS, no warranty, expressed or
+ *   implied, is made by the USGS as to the accuracy and functioning of such
+ *   software and related material nor shall the fact of distribution
+ *   constitute any such warranty, and no responsibility is assumed by the
+ *   USGS in connection therewith.
+ *
+ *   For additional information, launch
+ *   $ISISROOT/doc//documents/Disclaimers/Disclaimers.html
+ *   in a browser or see the Privacy &amp; Disclaimers page on the Isis website,
+ *   http://isis.astrogeology.usgs.gov, and the USGS privacy and disclaimers on
+ *   http://www.usgs.gov/privacy.html.
+ */
+
+#include <QByteArray>
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDir>
+#include <QFile>
+#include <QSaveFile>
+
+#include "FeatureCache.h"
+#include "FileName.h"
+#include "IException.h"
+
+namespace Isis {
+
+// Identifies a feature cache file and the version of its layout
+static const quint32 FeatureCacheMagic   = 0x46454154;  // "FEAT"
+static const qint32  FeatureCacheVersion = 1;
+
+
+/** Construct a disabled cache */
+FeatureCache::FeatureCache() : m_directory(), m_algorithm() { }
+
+
+/**
+ * @brief Construct a cache in a directory for a feature algorithm
+ *
+ * The directory is created if it does not exist. An empty directory name
+ * disables the cache.
+ *
+ * @param directory Directory to store cache entries in
+ * @param algorithm Specification of everything, other than the image, that
+ *                  determines the keypoints and descriptors
+ */
+FeatureCache::FeatureCache(const QString &directory, const QString &algorithm) :
+                           m_directory(), m_algorithm(algorithm) {
+  if ( directory.isEmpty() ) {  return;  }
+
+  m_directory = FileName(directory).expanded();
+  if ( !QDir().mkpath(m_directory) ) {
+    QString mess = "Unable to create feature cache directory [" +
+                   directory + "]";
+    throw IException(IException::User, mess, _FILEINFO_);
+  }
+}
+
+
+/** Returns true if the cache has a directory to use */
+bool FeatureCache::isEnabled() const {
+  return ( !m_directory.isEmpty() );
+}
+
+
+/** Returns the expanded cache directory */
+QString FeatureCache::directory() const {
+  return ( m_directory );
+}
+
+
+/**
+ * @brief Return the full key of an image
+ *
+ * @param image Image to compute the key for
+ *
+ * @return QString Serial number, transform chain and algorithm of the image
+ */
+QString FeatureCache::key(const MatchImage &image) const {
+  return ( "SerialNumber=" + image.id() + "\n" +
+           "Transforms=" + image.transforms().signature() + "\n" +
+           "Algorithm=" + m_algorithm );
+}
+
+
+/**
+ * @brief Load the keypoints and descriptors of an image from the cache
+ *
+ * @param image Image to load features into. It is not changed on a miss.
+ *
+ * @return bool True if the features were found in the cache
+ */
+bool FeatureCache::load(MatchImage &image) const {
+  if ( !isEnabled() ) {  return ( false );  }
+
+  QString v_key = key(image);
+  QFile file( cacheFile(v_key) );
+  if ( !file.open(QIODevice::ReadOnly) ) {  return ( false );  }
+
+  QDataStream stream(&file);
+  stream.setByteOrder(QDataStream::LittleEndian);
+  stream.setFloatingPointPrecision(QDataStream::SinglePrecision);
+
+  quint32 magic;
+  qint32 version;
+  QString fileKey;
+  stream >> magic >> version >> fileKey;
+  if ( (magic != FeatureCacheMagic) || (version != FeatureCacheVersion) ||
+       (fileKey != v_key) ) {
+    return ( false );
+  }
+
+  // Each keypoint takes 28 bytes, so a damaged count can be caught before
+  // allocating the keypoints
+  qint32 npoints;
+  stream >> npoints;
+  if ( (stream.status() != QDataStream::Ok) || (npoints < 0) ||
+       ((qint64) npoints * 28 > file.size() - file.pos()) ) {
+    return ( false );
+  }
+
+  Keypoints keypoints(npoints);
+  for (int i = 0 ; i < npoints ; i++) {
+    float x, y, size, angle, response;
+    qint32 octave, classId;
+    stream >> x >> y >> size >> angle >> response >> octave >> classId;
+    keypoints[i] = cv::KeyPoint(x, y, size, angle, response, octave, classId);
+  }
+
+  qint32 rows, cols, type;
+  QByteArray data;
+  stream >> rows >> cols >> type >> data;
+  if ( stream.status() != QDataStream::Ok ) {  return ( false );  }
+
+  // The descriptor shape must describe exactly the bytes that were read
+  Descriptors descriptors;
+  if ( (rows > 0) && (cols > 0) ) {
+    if ( (type != CV_MAT_TYPE(type)) ||
+         ((qint64) rows * cols * CV_ELEM_SIZE(type) != data.size()) ) {
+      return ( false );
+    }
+    descriptors.create(rows, cols, type);
+    memcpy(descriptors.data, data.constData(), data.size());
+  }
+
+  image.keypoints() = keypoints;
+  image.setDescriptors(descriptors);
+  return ( true );
+}
+
+
+/**
+ * @brief Store the keypoints and descriptors of an image in the cache
+ *
+ * @param image Image with computed features
+ *
+ * @return bool True if the entry was written
+ */
+bool FeatureCache::store(const MatchImage &image) const {
+  if ( !isEnabled() ) {  return ( false );  }
+
+  QString v_key = key(image);
+  QSaveFile file( cacheFile(v_key) );
+  if ( !file.open(QIODevice::WriteOnly) ) {  return ( false );  }
+
+  QDataStream stream(&file);
+  stream.setByteOrder(QDataStream::LittleEndian);
+  stream.setFloatingPointPrecision(QDataStream::SinglePrecision);
+
+  stream << FeatureCacheMagic << FeatureCacheVersion << v_key;
+
+  const Keypoints &keypoints = image.keypoints();
+  stream << (qint32) keypoints.size();
+  for (unsigned int i = 0 ; i < keypoints.size() ; i++) {
+    const cv::KeyPoint &kp = keypoints[i];
+    stream << kp.pt.x << kp.pt.y << kp.size << kp.angle << kp.response
+           << (qint32) kp.octave << (qint32) kp.class_id;
+  }
+
+  // Descriptors may be a view into a larger matrix, so make them contiguous
+  Descriptors descriptors = image.descriptors();
+  if ( !descriptors.isContinuous() ) {  descriptors = descriptors.clone();  }
+  QByteArray data( (const char *) descriptors.data,
+                   (int) (descriptors.total() * descriptors.elemSize()) );
+  stream << (qint32) descriptors.rows << (qint32) descriptors.cols
+         << (qint32) descriptors.type() << data;
+
+  if ( stream.status() != QDataStream::Ok ) {
+    file.cancelWriting();
+    return ( false );
+  }
+  return ( file.commit() );
+}
+
+
+/** Returns the path of the cache file for a key */
+QString FeatureCache::cacheFile(const QString &key) const {
+  QByteArray hash = QCryptographicHash::hash(key.toUtf8(),
+                                             QCryptographicHash::Sha1);
+  return ( m_directory + "/" + QString::fromLatin1(hash.toHex()) + ".features" );
+}
+
+}  // namespace Isis
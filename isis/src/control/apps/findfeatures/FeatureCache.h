@@ -0,0 +1,73 @@
+#ifndef FeatureCache_h
+#define FeatureCache_h
+/**
+ * @file
+ * $Revision$ 
+ * $Date$ 
+ *
+ *   Unless noted otherwise, the portions of Isis written by the USGS are public
+ *   domain. See individual third-party library and package descriptions for
+ *   intellectual property information,user agreements, and related information.
+ *
+ *   Although Isis has been used by the USGS, no warranty, expressed or implied,
+ *   is made by the USGS as to the accuracy and functioning of such software
+ *   and related material nor shall the fact of distribution constitute any such
+ *   warranty, and no responsibility is assumed by the USGS in connection
+ *   therewith.
+ *
+ *   For additional information, launch
+ *   $ISISROOT/doc//documents/Disclaimers/Disclaimers.html in a browser or see
+ *   the Privacy &amp; Disclaimers page on the Isis website,
+ *   http://isis.astrogeology.usgs.gov, and the USGS privacy and disclaimers on
+ *   http://www.usgs.gov/privacy.html.
+ */
+
+#include <QString>
+
+#include "FeatureMatcherTypes.h"
+#include "MatchImage.h"
+
+namespace Isis {
+
+/**
+ * @brief On-disk cache of image keypoints and descriptors
+ *
+ * Detecting keypoints and extracting descriptors is the most expensive part
+ * of matching, and in a network build the same image is matched against many
+ * partners with the same algorithms. This cache stores the keypoints and
+ * descriptors of an image in a directory so they are computed once per
+ * configuration and reused by later runs.
+ *
+ * Entries are keyed by the serial number of the image, the signature of its
+ * transform chain and the algorithm specification provided by the caller.
+ * Each entry is a small binary file named after a hash of the key. The full
+ * key is stored in the file and checked when it is read, so hash collisions
+ * and stale or damaged files are treated as cache misses. Entries are written
+ * atomically so concurrent processes can share a cache directory.
+ *
+ * Note that the serial number identifies an image, not its pixels. Clear the
+ * cache if the DNs of a cube are changed without changing its serial number.
+ */
+class FeatureCache {
+  public:
+    FeatureCache();
+    FeatureCache(const QString &directory, const QString &algorithm);
+    virtual ~FeatureCache() { }
+
+    bool isEnabled() const;
+    QString directory() const;
+
+    QString key(const MatchImage &image) const;
+
+    bool load(MatchImage &image) const;
+    bool store(const MatchImage &image) const;
+
+  private:
+    QString     m_directory;  //!< Expanded cache directory, empty if disabled
+    QString     m_algorithm;  //!< Specification of the feature algorithms
+
+    QString cacheFile(const QString &key) const;
+};
+
+}  // namespace Isis
+#endif
@@ -21,6 +21,7 @@
  */
 
 #include <QString>
+#include <QStringList>
 #include <QSharedPointer>
 #include <opencv2/opencv.hpp>
 #include "GenericTransform.h"
@@ -85,6 +86,23 @@ cv::Size GenericTransform::getSize(const cv::Mat &image) const {
   return (m_size);
 }
 
+/** Return the name, matrix and output size of the transform */
+QString GenericTransform::signature() const {
+  cv::Mat matrix;
+  m_matrix.convertTo(matrix, CV_64FC1);
+
+  QStringList values;
+  for (int r = 0 ; r < matrix.rows ; r++) {
+    for (int c = 0 ; c < matrix.cols ; c++) {
+      values.append(QString::number(matrix.at<double>(r, c), 'g', 17));
+    }
+  }
+
+  return ( ImageTransform::signature() + "(" + values.join(",") + ";" +
+           QString::number(m_size.width) + "x" +
+           QString::number(m_size.height) + ")" );
+}
+
 /** Transform the image matrix using the matrix and size constraints */
 cv::Mat GenericTransform::render(const cv::Mat &image) const {
   cv::Mat result;
@@ -62,6 +62,7 @@ class GenericTransform : public ImageTransform {
      
     cv::Size getSize(const cv::Mat &image = cv::Mat()) const;
 
+    virtual QString signature() const;
     virtual cv::Mat render(const cv::Mat &image) const;
 
     virtual cv::Point2f forward(const cv::Point2f &point) const;
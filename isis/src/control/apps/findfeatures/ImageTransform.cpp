@@ -48,6 +48,20 @@ QString ImageTransform::name() const {
   return ( m_name );  
 }
 
+/**
+ * @brief Return a string that uniquely identifies the rendering of this
+ *        transform
+ *
+ * Two transforms with the same signature render an image identically. It is
+ * used to key cached image features, so transforms that have parameters must
+ * include them in their signature.
+ *
+ * @return QString The name of the transform
+ */
+QString ImageTransform::signature() const {
+  return ( m_name );
+}
+
 
 /**
  * Perform the transformation on an image matrix.
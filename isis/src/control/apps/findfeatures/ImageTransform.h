@@ -54,6 +54,7 @@ class ImageTransform {
     virtual ~ImageTransform();
 
     QString name() const;
+    virtual QString signature() const;
 
     virtual cv::Mat render(const cv::Mat &image) const;
     virtual cv::Point2f forward(const cv::Point2f &point) const;
@@ -123,6 +123,10 @@ class MatchImage {
       return ( m_data->m_source );
     }
 
+    inline const Transformer &transforms() const {
+      return ( m_data->m_transforms );
+    }
+
     inline const cv::Mat image() const {
       // Run through transforms to render image
       return ( m_data->m_transforms.render( m_data->m_source.image()) );
@@ -32,6 +32,7 @@
 #include <QList>
 #include <QStringList>
 #include <QTime>
+#include <QtConcurrentMap>
 
 #include <boost/foreach.hpp>
 
@@ -126,9 +127,26 @@ MatchImage MatchMaker::getGeometrySource() const {
 }
 
 MatcherSolution *MatchMaker::match(const SharedRobustMatcher &matcher) {
+  return ( match(matcher, *this) );
+}
+
+
+/**
+ * @brief Run one matcher on the query and train images
+ *
+ * The query and train images are cloned so concurrent matchers each work on
+ * their own keypoints and descriptors while sharing the loaded image data.
+ *
+ * @param matcher Matcher to run
+ * @param logger  Logger the matcher and its solution write to
+ *
+ * @return MatcherSolution* Solution of the matcher, owned by the caller
+ */
+MatcherSolution *MatchMaker::match(const SharedRobustMatcher &matcher,
+                                   const QLogger &logger) {
 
   // Pass along logging status
-  matcher->setDebugLogger( stream(), isDebug() );
+  matcher->setDebugLogger( logger.stream(), logger.isDebug() );
   MatchImage query_copy = m_query.clone();
   QList<MatchImage> trainers_copy;
   for (int i = 0; i < m_trainers.size();i++) {
@@ -141,27 +159,86 @@ MatcherSolution *MatchMaker::match(const SharedRobustMatcher &matcher) {
     // Run a pair only matcher
     m = new MatcherSolution(matcher,
                             matcher->match(query_copy, trainers_copy[0]),
-                            *this /* MatchMaker and/or QLogger */ );
+                            logger );
   }
   else {
     // Run the multi-matcher
     m = new MatcherSolution(matcher,
                             matcher->match(query_copy, trainers_copy),
-                            *this /* MatchMaker and/or QLogger */ );
+                            logger );
   }
   return ( m );
 }
 
+
+/**
+ * @brief Run all matchers concurrently
+ *
+ * Images are loaded (all ISIS I/O and camera work) before this is called, so
+ * the matchers only do OpenCV work here. Each matcher writes its debug output
+ * to a buffer which is copied to the logger in matcher order once all are
+ * done. Solutions are returned in the same order as the matchers.
+ *
+ * @param matchers Matchers to run
+ *
+ * @return MatcherSolutionList One solution per matcher
+ */
 MatcherSolutionList MatchMaker::match(const RobustMatcherList &matchers) {
-  // Thread here!!!!
-  MatcherSolutionList solutions;
+  QList<MatcherTask> tasks;
   for (int i = 0 ; i < matchers.size() ; i++) {
-    solutions.push_back(SharedMatcherSolution( match(matchers[i]) ));
+    tasks.append(MatcherTask(matchers[i]));
+  }
+
+  QtConcurrent::blockingMap(tasks, MatcherFunctor(this));
+
+  // Point everything back at the shared logger before the buffers go away
+  for (int i = 0 ; i < tasks.size() ; i++) {
+    tasks[i].matcher->setDebugLogger( stream(), isDebug() );
+    if ( !tasks[i].solution.isNull() ) {
+      tasks[i].solution->setDebugLogger( stream(), isDebug() );
+    }
+  }
+
+  MatcherSolutionList solutions;
+  for (int i = 0 ; i < tasks.size() ; i++) {
+    logger() << tasks[i].log;
+    logger().flush();
+
+    if ( tasks[i].failed ) {
+      throw tasks[i].error;
+    }
+    solutions.push_back( tasks[i].solution );
   }
   return ( solutions );
 }
 
 
+/**
+ * @brief Construct a functor to run matchers for a MatchMaker
+ *
+ * @param maker MatchMaker holding the query and train images
+ */
+MatchMaker::MatcherFunctor::MatcherFunctor(MatchMaker *maker) : m_maker(maker) { }
+
+
+/**
+ * @brief Run the matcher of a task, logging to the task buffer
+ *
+ * @param task Matcher to run and where to put the results
+ */
+void MatchMaker::MatcherFunctor::operator()(MatcherTask &task) const {
+  try {
+    QLogger taskLogger( QDebugLogger::create(&task.log), m_maker->isDebug() );
+    task.solution = SharedMatcherSolution( m_maker->match(task.matcher, taskLogger) );
+    taskLogger.logger().flush();
+  }
+  catch (IException &e) {
+    task.failed = true;
+    task.error = e;
+  }
+}
+
+
  PvlGroup MatchMaker::network(ControlNet &cnet, const MatcherSolution &solution,
                               ID &pointMaker) const {
 
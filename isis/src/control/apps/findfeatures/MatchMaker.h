@@ -31,6 +31,7 @@
 #include "ControlNet.h"
 #include "FeatureMatcherTypes.h"
 #include "ID.h"
+#include "IException.h"
 #include "MatchImage.h"
 #include "PvlFlatMap.h"
 #include "QDebugLogger.h"
@@ -109,12 +110,37 @@ class MatchMaker : public QLogger {
   private:
     typedef  QScopedPointer<ControlPoint> ScopedControlPoint;
 
+    /** A matcher run concurrently by match() and its results */
+    struct MatcherTask {
+      MatcherTask(const SharedRobustMatcher &robust) : matcher(robust),
+                  solution(), log(), failed(false), error() { }
+
+      SharedRobustMatcher   matcher;   // Matcher to run
+      SharedMatcherSolution solution;  // Solution of the matcher
+      QString               log;       // Buffered debug output
+      bool                  failed;    // Matcher threw an error
+      IException            error;     // Error thrown when failed
+    };
+
+    /** Functor for QtConcurrent that runs the matcher of a task */
+    class MatcherFunctor {
+      public:
+        MatcherFunctor(MatchMaker *maker);
+        void operator()(MatcherTask &task) const;
+
+      private:
+        MatchMaker *m_maker;  // Holds the query and train images
+    };
+
     QString             m_name;
     PvlFlatMap          m_parameters;
     MatchImage          m_query;
     MatchImageQList     m_trainers;
     GeometrySourceFlag  m_geomFlag;
 
+    MatcherSolution *match(const SharedRobustMatcher &matcher,
+                           const QLogger &logger);
+
     double getParameter(const QString &name, const PvlFlatMap &parameters, 
                         const double &defaultParm) const;
 
@@ -34,6 +34,7 @@
 #include <QList>
 #include <QStringList>
 #include <QTime>
+#include <QtConcurrentMap>
 
 #include <opencv2/opencv.hpp>
 
@@ -139,11 +140,19 @@ MatchPair RobustMatcher::match(MatchImage &query, MatchImage &train) const {
    MatchImage v_train = train.clone();
    MatchPair v_pair(v_query, v_train);
 
+   // Use cached features where available. Images are only rendered when
+   // their features must be computed or when they are saved.
+   FeatureCache cache = featureCache();
+   bool q_cached = cache.load(v_query);
+   bool t_cached = cache.load(v_train);
+   bool saveRendered = toBool(m_parameters.get("SaveRenderedImages"));
+
    // Render images for matching
-   cv::Mat i_query = v_query.image();
-   cv::Mat i_train = v_train.image();
+   cv::Mat i_query, i_train;
+   if ( !q_cached || saveRendered ) {  i_query = v_query.image();  }
+   if ( !t_cached || saveRendered ) {  i_train = v_train.image();  }
 
-   if ( toBool(m_parameters.get("SaveRenderedImages")) ) {
+   if ( true == saveRendered ) {
      QString savepath = m_parameters.get("SavePath");
 
      FileName qfile(v_query.source().name());
@@ -168,6 +177,10 @@ MatchPair RobustMatcher::match(MatchImage &query, MatchImage &train) const {
                                           << v_train.source().lines() << ")\n";
      logger() << "       Rendered:     (" << i_train.cols << ", "
                                           << i_train.rows << ")\n";
+     if ( cache.isEnabled() ) {
+       logger() << "  Cached Features:  Query=" << toString(q_cached)
+                << ", Train=" << toString(t_cached) << "\n";
+     }
      logger() << "--> Feature detection...\n";
      logger().flush();
   }
@@ -177,8 +190,8 @@ MatchPair RobustMatcher::match(MatchImage &query, MatchImage &train) const {
    stime.start();
 
    // 1a. Detection of the features
-   detector().algorithm()->detect(i_query, v_query.keypoints());
-   detector().algorithm()->detect(i_train, v_train.keypoints());
+   if ( !q_cached ) detector().algorithm()->detect(i_query, v_query.keypoints());
+   if ( !t_cached ) detector().algorithm()->detect(i_train, v_train.keypoints());
 
    int v_query_points = v_query.size();
    int v_train_points = v_train.size();
@@ -189,8 +202,8 @@ MatchPair RobustMatcher::match(MatchImage &query, MatchImage &train) const {
    if ( v_maxpoints > 0 ) {
      logger() << "  Keypoints restricted by user to " << v_maxpoints << " points...\n";
      logger().flush();
-     cv::KeyPointsFilter::retainBest(v_query.keypoints(), v_maxpoints);
-     cv::KeyPointsFilter::retainBest(v_train.keypoints(), v_maxpoints);
+     if ( !q_cached ) cv::KeyPointsFilter::retainBest(v_query.keypoints(), v_maxpoints);
+     if ( !t_cached ) cv::KeyPointsFilter::retainBest(v_train.keypoints(), v_maxpoints);
    }
 
    double v_time = elapsed(stime);  // Event timing
@@ -210,8 +223,12 @@ MatchPair RobustMatcher::match(MatchImage &query, MatchImage &train) const {
 
    // 1b. Extraction of the descriptors
    cv::Mat queryDescriptors, trainerDescriptors;
-   extractor().algorithm()->compute(i_query, v_query.keypoints(), v_query.descriptors());
-   extractor().algorithm()->compute(i_train, v_train.keypoints(), v_train.descriptors());
+   if ( !q_cached ) {
+     extractor().algorithm()->compute(i_query, v_query.keypoints(), v_query.descriptors());
+   }
+   if ( !t_cached ) {
+     extractor().algorithm()->compute(i_train, v_train.keypoints(), v_train.descriptors());
+   }
    double d_time = elapsed(stime) - v_time;
    v_pair.addTime( v_time + d_time );
 
@@ -221,10 +238,14 @@ MatchPair RobustMatcher::match(MatchImage &query, MatchImage &train) const {
      if ( isDebug() ) {
        logger() << "  Computing RootSift Descriptors...\n";
      }
-     RootSift( v_query.descriptors() );
-     RootSift( v_train.descriptors() );
+     if ( !q_cached ) RootSift( v_query.descriptors() );
+     if ( !t_cached ) RootSift( v_train.descriptors() );
    }
 
+   // Save newly computed features for later runs
+   if ( !q_cached ) cache.store(v_query);
+   if ( !t_cached ) cache.store(v_train);
+
    if ( isDebug() ) {
      logger() <<     "  Processing Time(s):         " << d_time << "\n";
      logger() <<     "  Processing Descriptors/Sec: "
@@ -314,12 +335,24 @@ MatchPairQList RobustMatcher::match(MatchImage &query,
    MatchImageQList &v_trainers = trainers;
 
 
+   // Use cached features where available. Only the images whose features
+   // must be computed are rendered, unless they are saved.
+   FeatureCache cache = featureCache();
+   bool q_cached = cache.load(v_query);
+   QList<bool> t_cached;
+   QList<int>  t_compute;  // Trainers that need detection and extraction
+   for (int i = 0 ; i < v_trainers.size() ; i++) {
+     t_cached.append( cache.load(v_trainers[i]) );
+     if ( !t_cached[i] ) t_compute.append(i);
+   }
+
   // Create rendered trainer images for matching
   // Render images for efficiency
-   cv::Mat i_query = v_query.image();
-   std::vector<cv::Mat> i_trainers;
    bool saveRendered = toBool(m_parameters.get("SaveRenderedImages"));
    QString savepath = m_parameters.get("SavePath");
+   cv::Mat i_query;
+   if ( !q_cached || saveRendered ) {  i_query = v_query.image();  }
+   std::vector<cv::Mat> i_trainers;
 
    if ( true == saveRendered ) {
      // Save the query image first
@@ -331,7 +364,9 @@ MatchPairQList RobustMatcher::match(MatchImage &query,
 
    // Now process the rest of the trainer images
    for (int i = 0 ; i < v_trainers.size() ; i++) {
-     i_trainers.push_back(v_trainers[i].image());
+     cv::Mat i_train;
+     if ( !t_cached[i] || saveRendered ) {  i_train = v_trainers[i].image();  }
+     i_trainers.push_back(i_train);
 
      if ( true == saveRendered ) {
        FileName tfile(v_trainers[i].source().name());
@@ -356,6 +391,11 @@ MatchPairQList RobustMatcher::match(MatchImage &query,
        logger() << "       Rendered:     (" << i_trainers[i].cols << ", "
                                               << i_trainers[i].rows << ")\n";
      }
+     if ( cache.isEnabled() ) {
+       logger() << "  Cached Features:  Query=" << toString(q_cached)
+                << ", Trainers=" << v_trainers.size() - t_compute.size()
+                << " of " << v_trainers.size() << "\n";
+     }
      logger() << "--> Feature detection...\n";
      logger().flush();
    }
@@ -364,10 +404,26 @@ MatchPairQList RobustMatcher::match(MatchImage &query,
    QTime stime;
    stime.start();
 
-   // 1a. Run detection of features
-   std::vector<std::vector<cv::KeyPoint> > trainerKeypoints;
-   detector().algorithm()->detect(i_query, v_query.keypoints());
-   detector().algorithm()->detect(i_trainers, trainerKeypoints);
+   // 1a. Run detection of features on the uncached images in one batch
+   std::vector<cv::Mat> i_compute;
+   for (int c = 0 ; c < t_compute.size() ; c++) {
+     i_compute.push_back(i_trainers[t_compute[c]]);
+   }
+
+   std::vector<std::vector<cv::KeyPoint> > trainerKeypoints(v_trainers.size());
+   std::vector<std::vector<cv::KeyPoint> > computeKeypoints;
+   if ( !q_cached ) detector().algorithm()->detect(i_query, v_query.keypoints());
+   if ( !i_compute.empty() ) {
+     detector().algorithm()->detect(i_compute, computeKeypoints);
+   }
+
+   for (int i = 0 ; i < v_trainers.size() ; i++) {
+     if ( t_cached[i] ) trainerKeypoints[i] = v_trainers[i].keypoints();
+   }
+
+   for (int c = 0 ; c < t_compute.size() ; c++) {
+     trainerKeypoints[t_compute[c]] = computeKeypoints[c];
+   }
 
    int v_query_points = v_query.size();
    int allPoints = v_query_points;
@@ -377,14 +433,15 @@ MatchPairQList RobustMatcher::match(MatchImage &query,
      allPoints += trainerKeypoints[i].size();
    }
 
-   // Limit keypoints if requested by user
+   // Limit keypoints if requested by user. Cached keypoints are already
+   // limited.
    int v_maxpoints = toInt(m_parameters.get("MaxPoints"));
    if ( v_maxpoints > 0 ) {
      logger() << "  Keypoints restricted by user to " << v_maxpoints << " points...\n";
      logger().flush();
-     cv::KeyPointsFilter::retainBest(v_query.keypoints(), v_maxpoints);
-     for (unsigned int i = 0 ; i < trainerKeypoints.size() ; i++) {
-       cv::KeyPointsFilter::retainBest(trainerKeypoints[i], v_maxpoints);
+     if ( !q_cached ) cv::KeyPointsFilter::retainBest(v_query.keypoints(), v_maxpoints);
+     for (int c = 0 ; c < t_compute.size() ; c++) {
+       cv::KeyPointsFilter::retainBest(trainerKeypoints[t_compute[c]], v_maxpoints);
      }
    }
 
@@ -417,9 +474,27 @@ MatchPairQList RobustMatcher::match(MatchImage &query,
    }
 
    // 1b. Extraction of the descriptors
-   std::vector<cv::Mat> trainerDescriptors;
-   extractor().algorithm()->compute(i_query, v_query.keypoints(), v_query.descriptors());
-   extractor().algorithm()->compute(i_trainers, trainerKeypoints, trainerDescriptors);
+   std::vector<cv::Mat> trainerDescriptors(v_trainers.size());
+   if ( !q_cached ) {
+     extractor().algorithm()->compute(i_query, v_query.keypoints(), v_query.descriptors());
+   }
+   if ( !i_compute.empty() ) {
+     std::vector<std::vector<cv::KeyPoint> > computeKeypoints;
+     for (int c = 0 ; c < t_compute.size() ; c++) {
+       computeKeypoints.push_back(trainerKeypoints[t_compute[c]]);
+     }
+
+     std::vector<cv::Mat> computeDescriptors;
+     extractor().algorithm()->compute(i_compute, computeKeypoints, computeDescriptors);
+     for (int c = 0 ; c < t_compute.size() ; c++) {
+       trainerKeypoints[t_compute[c]] = computeKeypoints[c];
+       trainerDescriptors[t_compute[c]] = computeDescriptors[c];
+     }
+   }
+
+   for (int i = 0 ; i < v_trainers.size() ; i++) {
+     if ( t_cached[i] ) trainerDescriptors[i] = v_trainers[i].descriptors();
+   }
 
     // Record time to detect features and extract descriptors for all images
    double e_time = elapsed(stime) - d_time;
@@ -434,13 +509,18 @@ MatchPairQList RobustMatcher::match(MatchImage &query,
      if ( isDebug() ) {
        logger() << "  Computing RootSift Descriptors...\n";
      }
-     RootSift( v_query.descriptors() );
-     for (unsigned int i = 0; i < trainerDescriptors.size() ; i++) {
-       RootSift( trainerDescriptors[i] );
+     if ( !q_cached ) RootSift( v_query.descriptors() );
+     for (int c = 0 ; c < t_compute.size() ; c++) {
+       RootSift( trainerDescriptors[t_compute[c]] );
      }
    }
 
-   MatchPairQList pairs;
+   // Save newly computed features for later runs
+   if ( !q_cached ) cache.store(v_query);
+
+   // Set up the pairs here, then remove outliers from each pair concurrently.
+   // Debug output of each pair is buffered and written in trainer order.
+   QList<OutlierTask> tasks;
    for ( int i = 0 ; i < v_trainers.size() ; i++) {
 
      double kpRatio = (trainerKeypoints[i].size() / allPoints);
@@ -451,63 +531,25 @@ MatchPairQList RobustMatcher::match(MatchImage &query,
      v_train.keypoints() = trainerKeypoints[i];
      v_train.setDescriptors(trainerDescriptors[i]);
      v_train.addTime(t_time);
-     MatchPair v_pair(v_query, v_train);
+     if ( !t_cached[i] ) cache.store(v_train);
+
+     OutlierTask task(i, v_query, v_train, t_time);
      if ( isDebug() ) {
        logger() << "  Processing Time(s):         " << d_time * kpRatio << "\n";
        logger() << "  Processing Descriptors/Sec: "
-                << (double) v_pair.keyPointTotal() / (d_time * kpRatio) << "\n";
-       logger() << "\n*Removing outliers from image pairs:"
-                << "\n *  Query: " << v_query.name()
-                << "\n *  Train: " << v_train.name()
-                << "\n";
+                << (double) task.pair.keyPointTotal() / (d_time * kpRatio) << "\n";
        logger().flush();
      }
+     tasks.append(task);
+   }
 
-     try {
-       // OUTLIER DETECTION!!!
-       // 2, 3, 4,  5, 6: Apply ratio (2) and symmetric (3) tests, then apply
-       // RANSAC homography (4) outlier followed by epipoloar (5) and final
-       // homography (6)
-       double mtime(0);
-       cv::Mat homography, fundamental;
-       removeOutliers(v_query.descriptors(), v_train.descriptors(),
-                      v_query.keypoints(), v_train.keypoints(),
-                      v_pair.homography_matches(), v_pair.epipolar_matches(),
-                      v_pair.matches(), homography, fundamental,
-                      t_time, onErrorThrow);
-
-       v_pair.setFundamental(fundamental);
-       v_pair.setHomography(homography);
-       v_pair.addTime(mtime);
-       pairs.push_back( v_pair );
-     }
-     catch ( cv::Exception &c ) {
-       QString mess = "Outlier removal process failed on Query/Train image pair "
-                      " Query=" + v_query.name() +
-                      ", Train[" + QString::number(i) + "]: " + v_train.name() +
-                      ".  cv::Error - " + c.what();
-       // throw IException(IException::Programmer, mess, _FILEINFO_);
-       v_pair.addError(mess);
-       pairs.push_back( v_pair ) ;
-       if ( isDebug() ) {
-         logger() << "  Outlier Error = "
-                   << v_pair.getError(v_pair.errorCount()-1) << "\n";
-         logger().flush();
-       }
-     }
-     catch ( IException &ie) {
-       QString mess = "Outlier removal process failed on Query/Train image pair "
-                      " Query=" + v_query.name() +
-                      ", Train[" + QString::number(i) + "]: " + v_train.name();
-       // throw IException(ie, IException::Programmer, mess, _FILEINFO_);
-       v_pair.addError(mess);
-       pairs.push_back( v_pair );
-       if ( isDebug() ) {
-         logger() << "  Outlier Error = "
-                   << v_pair.getError(v_pair.errorCount()-1) << "\n";
-         logger().flush();
-       }
-     }
+   QtConcurrent::blockingMap(tasks, OutlierFunctor(*this, onErrorThrow));
+
+   MatchPairQList pairs;
+   for ( int i = 0 ; i < tasks.size() ; i++) {
+     logger() << tasks[i].log;
+     logger().flush();
+     pairs.push_back( tasks[i].pair );
    }
 
    // All done...
@@ -522,6 +564,102 @@ MatchPairQList RobustMatcher::match(MatchImage &query,
 }
 
 
+/**
+ * @brief Remove outliers from a single query/train pair
+ *
+ * Runs removeOutliers() on the pair and stores the homography and fundamental
+ * matrices in it. Failures are recorded as errors in the pair rather than
+ * thrown, so one bad trainer does not stop the others.
+ *
+ * @param query   Query image with keypoints and descriptors
+ * @param train   Train image with keypoints and descriptors
+ * @param index   Index of the train image, used in error messages
+ * @param pair    Pair to store matches and errors in
+ * @param mtime   Time accumulated in removing outliers
+ * @param onErrorThrow Passed on to removeOutliers()
+ */
+void RobustMatcher::removePairOutliers(MatchImage &query, MatchImage &train,
+                                       const int &index, MatchPair &pair,
+                                       double &mtime,
+                                       const bool onErrorThrow) const {
+  if ( isDebug() ) {
+    logger() << "\n*Removing outliers from image pairs:"
+             << "\n *  Query: " << query.name()
+             << "\n *  Train: " << train.name()
+             << "\n";
+    logger().flush();
+  }
+
+  try {
+    // OUTLIER DETECTION!!!
+    // 2, 3, 4,  5, 6: Apply ratio (2) and symmetric (3) tests, then apply
+    // RANSAC homography (4) outlier followed by epipoloar (5) and final
+    // homography (6)
+    cv::Mat homography, fundamental;
+    removeOutliers(query.descriptors(), train.descriptors(),
+                   query.keypoints(), train.keypoints(),
+                   pair.homography_matches(), pair.epipolar_matches(),
+                   pair.matches(), homography, fundamental,
+                   mtime, onErrorThrow);
+
+    pair.setFundamental(fundamental);
+    pair.setHomography(homography);
+  }
+  catch ( cv::Exception &c ) {
+    QString mess = "Outlier removal process failed on Query/Train image pair "
+                   " Query=" + query.name() +
+                   ", Train[" + QString::number(index) + "]: " + train.name() +
+                   ".  cv::Error - " + c.what();
+    pair.addError(mess);
+    if ( isDebug() ) {
+      logger() << "  Outlier Error = "
+                << pair.getError(pair.errorCount()-1) << "\n";
+      logger().flush();
+    }
+  }
+  catch ( IException &ie) {
+    QString mess = "Outlier removal process failed on Query/Train image pair "
+                   " Query=" + query.name() +
+                   ", Train[" + QString::number(index) + "]: " + train.name();
+    pair.addError(mess);
+    if ( isDebug() ) {
+      logger() << "  Outlier Error = "
+                << pair.getError(pair.errorCount()-1) << "\n";
+      logger().flush();
+    }
+  }
+}
+
+
+/**
+ * @brief Construct a functor for concurrent outlier removal
+ *
+ * @param matcher      Matcher whose algorithms and parameters are used
+ * @param onErrorThrow Passed on to removeOutliers()
+ */
+RobustMatcher::OutlierFunctor::OutlierFunctor(const RobustMatcher &matcher,
+                                              const bool onErrorThrow) :
+                                              m_matcher(matcher),
+                                              m_onErrorThrow(onErrorThrow) { }
+
+
+/**
+ * @brief Remove outliers from the pair in a task
+ *
+ * A copy of the matcher is made that logs to the task, as the QTextStream of
+ * the shared logger cannot be written from several threads.
+ *
+ * @param task The pair to process
+ */
+void RobustMatcher::OutlierFunctor::operator()(OutlierTask &task) const {
+  RobustMatcher matcher(m_matcher);
+  matcher.setDebugLogger(QDebugLogger::create(&task.log), m_matcher.isDebug());
+  matcher.removePairOutliers(task.query, task.train, task.index, task.pair,
+                             task.mtime, m_onErrorThrow);
+  matcher.logger().flush();
+}
+
+
 /**
  * @brief Apply ratio and symmetric outlier tests
  *
@@ -1151,6 +1289,30 @@ void RobustMatcher::init(const PvlFlatMap &parameters) {
   return;
 }
 
+/**
+ * @brief Return the keypoint/descriptor cache configured for this matcher
+ *
+ * The cache is disabled unless the FeatureCache parameter names a directory.
+ * Entries are keyed by the detector and extractor configuration and the
+ * parameters that change the stored features, so matchers with different
+ * feature algorithms can share a cache directory.
+ *
+ * @return FeatureCache Cache for the features of this matcher
+ */
+FeatureCache RobustMatcher::featureCache() const {
+  QString directory = m_parameters.get("FeatureCache", "");
+  if ( directory.isEmpty() ) {  return ( FeatureCache() );  }
+
+  std::ostringstream spec;
+  spec << detector().info("Detector") << "\n"
+       << extractor().info("Extractor") << "\n";
+  QString algorithm = QString::fromStdString(spec.str()) +
+                      "MaxPoints=" + m_parameters.get("MaxPoints") + "\n" +
+                      "RootSift=" + toString(toBool(m_parameters.get("RootSift")));
+  return ( FeatureCache(directory, algorithm) );
+}
+
+
 // Compute RootSift descriptors for better matching potential
 void RobustMatcher::RootSift(cv::Mat &descriptors, const float eps) const {
   // Compute sums for L1 Norm
@@ -28,6 +28,7 @@
 
 #include <opencv2/opencv.hpp>
 
+#include "FeatureCache.h"
 #include "FeatureMatcherTypes.h"
 #include "MatcherAlgorithms.h"
 #include "MatchImage.h"
@@ -114,10 +115,41 @@ class QDebug;
       PvlObject info(const QString &p_name = "RobustMatcher") const;
   
     private:
+      /** State for removing the outliers from one query/train pair */
+      struct OutlierTask {
+        OutlierTask(const int &trainIndex, const MatchImage &queryImage,
+                    const MatchImage &trainImage, const double &time) :
+                    index(trainIndex), query(queryImage), train(trainImage),
+                    pair(queryImage, trainImage), mtime(time), log() { }
+
+        int        index;   // Index of the train image
+        MatchImage query;   // Query image
+        MatchImage train;   // Train image
+        MatchPair  pair;    // Resulting match pair
+        double     mtime;   // Outlier removal time
+        QString    log;     // Buffered debug output
+      };
+
+      /** Functor for QtConcurrent that removes the outliers of a task */
+      class OutlierFunctor {
+        public:
+          OutlierFunctor(const RobustMatcher &matcher, const bool onErrorThrow);
+          void operator()(OutlierTask &task) const;
+
+        private:
+          const RobustMatcher &m_matcher;       // Matcher to copy for each task
+          bool                 m_onErrorThrow;  // Passed to removeOutliers
+      };
+
       QString      m_name;        // Name of matcher
       PvlFlatMap   m_parameters;  // Parameters for matcher
 
+      void removePairOutliers(MatchImage &query, MatchImage &train,
+                              const int &index, MatchPair &pair,
+                              double &mtime, const bool onErrorThrow) const;
+
       void init(const PvlFlatMap &parameters = PvlFlatMap());
+      FeatureCache featureCache() const;
       void RootSift(cv::Mat &descriptors, const float eps = 1.0E-7) const;
       double elapsed(const QTime &runtime) const;  // returns seconds
   
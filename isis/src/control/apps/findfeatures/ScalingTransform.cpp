@@ -40,6 +40,13 @@ ScalingTransform::ScalingTransform(const double &scale, const QString &name) :
                                    ImageTransform(name), m_scale(scale) { }
                                                   
 
+/** Return the name and scale of the transform */
+QString ScalingTransform::signature() const {
+  return ( ImageTransform::signature() + "(" +
+           QString::number(m_scale, 'g', 17) + ")" );
+}
+
+
 /**
  * @brief Implementation of scaling transform
  *  
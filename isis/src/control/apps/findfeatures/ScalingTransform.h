@@ -49,6 +49,7 @@ namespace Isis {
                        const QString &name = "ScaleTransform"); 
       virtual ~ScalingTransform() { }
   
+      virtual QString signature() const;
       virtual cv::Mat render(const cv::Mat &image) const;
       virtual cv::Point2f forward(const cv::Point2f &point) const;
       virtual cv::Point2f inverse(const cv::Point2f &point) const;
@@ -104,6 +104,12 @@ class ScharrTransform : public ImageTransform {
       return ( grad) ;
     }
 
+    /** Return the name and noise reduction state of the transform */
+    virtual QString signature() const {
+      return ( ImageTransform::signature() +
+               ( m_reduceNoise ? "(ReduceNoise)" : "" ) );
+    }
+
   private:
     bool m_reduceNoise;
 
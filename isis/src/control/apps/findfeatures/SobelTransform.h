@@ -103,6 +103,12 @@ class SobelTransform : public ImageTransform {
       return ( grad) ;
     }
 
+    /** Return the name and noise reduction state of the transform */
+    virtual QString signature() const {
+      return ( ImageTransform::signature() +
+               ( m_reduceNoise ? "(ReduceNoise)" : "" ) );
+    }
+
   private:
     bool m_reduceNoise;
 
@@ -120,6 +120,19 @@ cv::Point2f Transformer::inverse(const cv::Point2f &point) const {
   return (tpoint);
 }
 
+/**
+ * @brief Return the signatures of all transforms in the order they are applied
+ *
+ * @return QString Signatures of the transforms separated by "|"
+ */
+QString Transformer::signature() const {
+  QStringList signatures;
+  BOOST_FOREACH ( SharedImageTransform t, m_transforms ) {
+    signatures.append(t->signature());
+  }
+  return ( signatures.join("|") );
+}
+
 /* Return the start of the image transform list */
 Transformer::ImageTransformConstIterator Transformer::begin() const {
   return ( m_transforms.begin() );
@@ -60,6 +60,7 @@ namespace Isis {
       int size() const;
   
       void add(ImageTransform *transform);
+      QString signature() const;
       cv::Mat render(const cv::Mat &image) const;
   
       cv::Point2f forward(const cv::Point2f &point) const;
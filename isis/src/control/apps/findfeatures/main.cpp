@@ -10,6 +10,7 @@
 #include <QSharedPointer>
 #include <QFile>
 #include <QTextStream>
+#include <QThreadPool>
 
 // OpenCV stuff
 #include "opencv2/core.hpp"
@@ -150,6 +151,11 @@ void IsisMain() {
     parameters.add(p, ui.GetAsString(p));
   }
 
+  // Keypoints and descriptors are cached if a directory is provided
+  if ( ui.WasEntered("FEATURECACHE") ) {
+    parameters.add("FeatureCache", ui.GetAsString("FEATURECACHE"));
+  }
+
   // Got all parameters.  Add them now and they don't need to be considered
   // from here on.  Parameters specified in input algorithm specs take
   // precedence (in MatchMaker)
@@ -203,6 +209,8 @@ void IsisMain() {
   if ( ui.WasEntered("MAXTHREADS") ) {
     uthreads = ui.GetInteger("MAXTHREADS");
     if (uthreads < nthreads) cv::setNumThreads(uthreads);
+    // Matchers and train images are also run concurrently on the Qt pool
+    if (uthreads > 0) QThreadPool::globalInstance()->setMaxThreadCount(uthreads);
     logger->dbugout() << "User restricted threads:   " << uthreads << "\n";
   }
   int total_threads = cv::getNumThreads();
@@ -226,6 +226,17 @@ BundleSettingsQsp bundleSettings(UserInterface &ui) {
                                   ui.GetDouble("SIGMA0"),
                                   ui.GetInteger("MAXITS"));
 
+  // solve method
+  QString solver = ui.GetString("SOLVER");
+  if (solver == "CONJUGATE_GRADIENT" || solver == "HYBRID") {
+    settings->setSolveMethod(
+        solver == "HYBRID" ? BundleSettings::Hybrid : BundleSettings::ConjugateGradient,
+        BundleSettings::stringToPreconditioner(ui.GetString("PRECONDITIONER")),
+        ui.GetDouble("CG_TOLERANCE"),
+        ui.GetInteger("CG_MAXITS"),
+        ui.GetInteger("HYBRID_ITERATIONS"));
+  }
+
   // max likelihood estimation
   if (ui.GetString("MODEL1").compare("NONE") != 0) {
     // if model1 is not "NONE", add to the models list with its quantile
@@ -1530,16 +1530,71 @@ namespace Isis {
 
 
   /**
-   * Compute the solution to the normal equations using the CHOLMOD library.
+   * Compute the solution to the normal equations, using the CHOLMOD library or
+   * the conjugate gradient method depending on the solve method in the
+   * BundleSettings and the current iteration.
    *
    * @return @b bool If the solution was successfully computed.
    *
-   * @throws IException::Programmer "CHOLMOD: Failed to load Triplet matrix"
-   *
    * @see BundleAdjust::solveCholesky
    */
   bool BundleAdjust::solveSystem() {
 
+    BundleSettings::SolveMethod method = m_bundleSettings->solveMethod();
+    if (method == BundleSettings::ConjugateGradient ||
+        (method == BundleSettings::Hybrid &&
+         m_iteration <= m_bundleSettings->hybridIterations())) {
+      return solveConjugateGradient();
+    }
+
+    if (!factorNormals()) {
+      return false;
+    }
+
+    // cholmod solution and right-hand side vectors
+    cholmod_dense *x, *b;
+
+    // initialize right-hand side vector
+    b = cholmod_zeros(m_cholmodNormal->nrow, 1, m_cholmodNormal->xtype, &m_cholmodCommon);
+
+    // copy right-hand side vector into b
+    double *px = (double*)b->x;
+    for (int i = 0; i < m_rank; i++) {
+      px[i] = m_RHS[i];
+    }
+
+    // cholmod solve
+    x = cholmod_solve(CHOLMOD_A, m_L, b, &m_cholmodCommon);
+
+    // copy solution vector x out into m_imageSolution
+    double *sx = (double*)x->x;
+    for (int i = 0; i < m_rank; i++) {
+      m_imageSolution[i] = sx[i];
+    }
+
+    // free cholmod structures
+    cholmod_free_sparse(&m_cholmodNormal, &m_cholmodCommon);
+    cholmod_free_dense(&b, &m_cholmodCommon);
+    cholmod_free_dense(&x, &m_cholmodCommon);
+
+    return true;
+  }
+
+
+  /**
+   * Factor the normal equations using the CHOLMOD library. The factor is
+   * stored in m_L. The sparse normals stay in m_cholmodNormal until the caller
+   * is done with them.
+   *
+   * @return @b bool If the normal equations were successfully factored.
+   *
+   * @throws IException::Programmer "CHOLMOD: Failed to load Triplet matrix"
+   *
+   * @see BundleAdjust::solveSystem
+   * @see BundleAdjust::errorPropagation
+   */
+  bool BundleAdjust::factorNormals() {
+
     // load cholmod triplet
     if ( !loadCholmodTriplet() ) {
       QString msg = "CHOLMOD: Failed to load Triplet matrix";
@@ -1568,31 +1623,288 @@ namespace Isis {
       return false;
     }
 
-    // cholmod solution and right-hand side vectors
-    cholmod_dense *x, *b;
+    return true;
+  }
 
-    // initialize right-hand side vector
-    b = cholmod_zeros(m_cholmodNormal->nrow, 1, m_cholmodNormal->xtype, &m_cholmodCommon);
 
-    // copy right-hand side vector into b
-    double *px = (double*)b->x;
-    for (int i = 0; i < m_rank; i++) {
-      px[i] = m_RHS[i];
+  /**
+   * Compute the solution to the normal equations using the preconditioned
+   * conjugate gradient method. The reduced normal equations in m_sparseNormals
+   * are only multiplied by vectors, so no factor is formed and no memory is
+   * needed beyond a few vectors the size of the solution.
+   *
+   * The iterations stop when the residual relative to the right hand side is
+   * within the tolerance from the BundleSettings. If the maximum number of
+   * iterations is reached first, the current estimate is used as the
+   * correction for this iteration of the bundle.
+   *
+   * @return @b bool If the solution was successfully computed. False means
+   *                 the normal equations matrix is not positive definite.
+   *
+   * @see BundleAdjust::solveSystem
+   */
+  bool BundleAdjust::solveConjugateGradient() {
+    double tolerance = m_bundleSettings->conjugateGradientTolerance();
+    int maximumIterations = m_bundleSettings->conjugateGradientMaximumIterations();
+    if (maximumIterations <= 0) {
+      maximumIterations = m_rank;
     }
 
-    // cholmod solve
-    x = cholmod_solve(CHOLMOD_A, m_L, b, &m_cholmodCommon);
+    QVector<LinearAlgebra::Matrix> preconditioner = formPreconditioner();
 
-    // copy solution vector x out into m_imageSolution
-    double *sx = (double*)x->x;
-    for (int i = 0; i < m_rank; i++) {
-      m_imageSolution[i] = sx[i];
+    // the solution starts at zero, so the residual starts as the right hand side
+    LinearAlgebra::Vector residual = m_RHS;
+    LinearAlgebra::Vector preconditioned(m_rank);
+    LinearAlgebra::Vector product(m_rank);
+    m_imageSolution.clear();
+
+    applyPreconditioner(preconditioner, residual, preconditioned);
+    LinearAlgebra::Vector direction = preconditioned;
+    double residualProduct = inner_prod(residual, preconditioned);
+
+    double rhsNorm = norm_2(m_RHS);
+    double relativeResidual = 0.0;
+    bool converged = (rhsNorm == 0.0);
+    int iteration = 0;
+
+    while (!converged && iteration < maximumIterations) {
+      multiplyNormals(direction, product);
+
+      double curvature = inner_prod(direction, product);
+      if (curvature <= 0.0) {
+        QString msg = "Matrix NOT positive-definite: failure at conjugate gradient iteration "
+                      + toString(iteration + 1);
+        error(msg);
+        emit(finished());
+        return false;
+      }
+
+      double step = residualProduct / curvature;
+      noalias(m_imageSolution) += step * direction;
+      noalias(residual) -= step * product;
+      iteration++;
+
+      relativeResidual = norm_2(residual) / rhsNorm;
+      if (relativeResidual <= tolerance) {
+        converged = true;
+        break;
+      }
+
+      applyPreconditioner(preconditioner, residual, preconditioned);
+      double nextResidualProduct = inner_prod(residual, preconditioned);
+      direction = preconditioned + (nextResidualProduct / residualProduct) * direction;
+      residualProduct = nextResidualProduct;
     }
 
-    // free cholmod structures
-    cholmod_free_sparse(&m_cholmodNormal, &m_cholmodCommon);
-    cholmod_free_dense(&b, &m_cholmodCommon);
-    cholmod_free_dense(&x, &m_cholmodCommon);
+    m_bundleResults.addConjugateGradientSolve(iteration, relativeResidual, converged);
+
+    emit statusUpdate(QString("Conjugate Gradient Iterations: %1 \n").arg(iteration));
+    emit statusUpdate(QString("Conjugate Gradient Relative Residual: %1 \n")
+                              .arg(relativeResidual, 0, 'e', 6));
+    if (!converged) {
+      emit statusUpdate("Conjugate Gradient reached the maximum iterations\n");
+    }
+
+    return true;
+  }
+
+
+  /**
+   * Multiply the reduced normal equations matrix by a vector. Only the upper
+   * triangular blocks are stored in m_sparseNormals, so each off-diagonal
+   * block is applied once as stored and once transposed.
+   *
+   * @param values The vector to multiply, with m_rank elements.
+   * @param product The output product, with m_rank elements.
+   *
+   * @see BundleAdjust::solveConjugateGradient
+   */
+  void BundleAdjust::multiplyNormals(const LinearAlgebra::Vector &values,
+                                     LinearAlgebra::Vector &product) {
+    product.clear();
+
+    int numBlockColumns = m_sparseNormals.size();
+    for (int columnIndex = 0; columnIndex < numBlockColumns; columnIndex++) {
+      SparseBlockColumnMatrix *normalsColumn = m_sparseNormals.at(columnIndex);
+      int columnStart = normalsColumn->startColumn();
+
+      QMapIterator< int, LinearAlgebra::Matrix * > it(*normalsColumn);
+      while ( it.hasNext() ) {
+        it.next();
+
+        int rowIndex = it.key();
+        int rowStart = m_sparseNormals.at(rowIndex)->startColumn();
+        const LinearAlgebra::Matrix &block = *it.value();
+        int numRows = block.size1();
+        int numColumns = block.size2();
+
+        if (rowIndex == columnIndex) {
+          // diagonal block, only the upper triangle is used like CHOLMOD
+          for (int i = 0; i < numRows; i++) {
+            double sum = 0.0;
+            for (int j = 0; j < numColumns; j++) {
+              sum += (j >= i ? block(i, j) : block(j, i)) * values(columnStart + j);
+            }
+            product(rowStart + i) += sum;
+          }
+          continue;
+        }
+
+        for (int i = 0; i < numRows; i++) {
+          double sum = 0.0;
+          for (int j = 0; j < numColumns; j++) {
+            sum += block(i, j) * values(columnStart + j);
+          }
+          product(rowStart + i) += sum;
+        }
+
+        for (int j = 0; j < numColumns; j++) {
+          double sum = 0.0;
+          for (int i = 0; i < numRows; i++) {
+            sum += block(i, j) * values(rowStart + i);
+          }
+          product(columnStart + j) += sum;
+        }
+      }
+    }
+  }
+
+
+  /**
+   * Form the preconditioner for the conjugate gradient method from the
+   * diagonal blocks of the reduced normal equations. Each returned matrix is
+   * the inverse applied to the corresponding block of the residual. For the
+   * Jacobi preconditioner the matrices are diagonal. A block that cannot be
+   * inverted is preconditioned by its diagonal instead.
+   *
+   * @return @b QVector<LinearAlgebra::Matrix> One matrix for each block column,
+   *            or none if no preconditioner is used.
+   *
+   * @see BundleAdjust::solveConjugateGradient
+   */
+  QVector<LinearAlgebra::Matrix> BundleAdjust::formPreconditioner() {
+    QVector<LinearAlgebra::Matrix> preconditioner;
+    BundleSettings::Preconditioner type = m_bundleSettings->preconditioner();
+    if (type == BundleSettings::NoPreconditioner) {
+      return preconditioner;
+    }
+
+    int numBlockColumns = m_sparseNormals.size();
+    preconditioner.resize(numBlockColumns);
+    for (int i = 0; i < numBlockColumns; i++) {
+      LinearAlgebra::Matrix *diagonalBlock = m_sparseNormals.getBlock(i, i);
+      if ( !diagonalBlock ) {
+        continue;
+      }
+
+      if (type == BundleSettings::BlockJacobi
+          && invertPositiveDefinite(*diagonalBlock, preconditioner[i])) {
+        continue;
+      }
+
+      int blockSize = diagonalBlock->size1();
+      preconditioner[i] = LinearAlgebra::zeroMatrix(blockSize, blockSize);
+      for (int j = 0; j < blockSize; j++) {
+        double diagonal = (*diagonalBlock)(j, j);
+        preconditioner[i](j, j) = (diagonal > 0.0) ? 1.0 / diagonal : 1.0;
+      }
+    }
+
+    return preconditioner;
+  }
+
+
+  /**
+   * Apply the conjugate gradient preconditioner to a residual vector.
+   *
+   * @param preconditioner The matrices from formPreconditioner.
+   * @param residual The residual vector.
+   * @param preconditioned The output preconditioned residual.
+   *
+   * @see BundleAdjust::solveConjugateGradient
+   */
+  void BundleAdjust::applyPreconditioner(const QVector<LinearAlgebra::Matrix> &preconditioner,
+                                         const LinearAlgebra::Vector &residual,
+                                         LinearAlgebra::Vector &preconditioned) {
+    if (preconditioner.isEmpty()) {
+      preconditioned = residual;
+      return;
+    }
+
+    // parameters of a block column without a diagonal block are left unchanged
+    preconditioned = residual;
+
+    for (int blockIndex = 0; blockIndex < preconditioner.size(); blockIndex++) {
+      const LinearAlgebra::Matrix &block = preconditioner[blockIndex];
+      int start = m_sparseNormals.at(blockIndex)->startColumn();
+      int blockSize = block.size1();
+
+      for (int i = 0; i < blockSize; i++) {
+        double sum = 0.0;
+        for (int j = 0; j < blockSize; j++) {
+          sum += block(i, j) * residual(start + j);
+        }
+        preconditioned(start + i) = sum;
+      }
+    }
+  }
+
+
+  /**
+   * Invert a symmetric positive definite matrix by Cholesky decomposition.
+   * Only the upper triangle of the matrix is used.
+   *
+   * @param matrix The symmetric matrix to invert.
+   * @param inverse The output inverse.
+   *
+   * @return @b bool False if the matrix is not positive definite.
+   *
+   * @see BundleAdjust::formPreconditioner
+   */
+  bool BundleAdjust::invertPositiveDefinite(const LinearAlgebra::Matrix &matrix,
+                                            LinearAlgebra::Matrix &inverse) {
+    int size = matrix.size1();
+
+    // lower triangular factor, matrix = L x L(transpose)
+    LinearAlgebra::Matrix L = LinearAlgebra::zeroMatrix(size, size);
+    for (int j = 0; j < size; j++) {
+      double diagonal = matrix(j, j);
+      for (int k = 0; k < j; k++) {
+        diagonal -= L(j, k) * L(j, k);
+      }
+      if (diagonal <= 0.0) {
+        return false;
+      }
+      L(j, j) = sqrt(diagonal);
+
+      for (int i = j + 1; i < size; i++) {
+        double value = matrix(j, i);
+        for (int k = 0; k < j; k++) {
+          value -= L(i, k) * L(j, k);
+        }
+        L(i, j) = value / L(j, j);
+      }
+    }
+
+    // solve L x L(transpose) x inverse = identity one column at a time
+    inverse = LinearAlgebra::zeroMatrix(size, size);
+    for (int column = 0; column < size; column++) {
+      LinearAlgebra::Vector y(size);
+      for (int i = 0; i < size; i++) {
+        double value = (i == column) ? 1.0 : 0.0;
+        for (int k = 0; k < i; k++) {
+          value -= L(i, k) * y(k);
+        }
+        y(i) = value / L(i, i);
+      }
+      for (int i = size - 1; i >= 0; i--) {
+        double value = y(i);
+        for (int k = i + 1; k < size; k++) {
+          value -= L(k, i) * inverse(k, column);
+        }
+        inverse(i, column) = value / L(i, i);
+      }
+    }
 
     return true;
   }
@@ -1611,7 +1923,11 @@ namespace Isis {
    */
   bool BundleAdjust::loadCholmodTriplet() {
 
-    if ( m_iteration == 1 ) {
+    // the triplet is allocated and its row and column indices set the first time the normals
+    // are factored, which is not the first iteration when the conjugate gradient method is used
+    bool newTriplet = !m_cholmodTriplet;
+
+    if ( newTriplet ) {
       int numElements = m_sparseNormals.numberOfElements();
       m_cholmodTriplet = cholmod_allocate_triplet(m_rank, m_rank, numElements,
                                                   -1, CHOLMOD_REAL, &m_cholmodCommon);
@@ -1678,7 +1994,7 @@ namespace Isis {
               int entryColumnIndex = jj + numLeadingColumns;
               int entryRowIndex = ii + numLeadingRows;
 
-              if ( m_iteration == 1 ) {
+              if ( newTriplet ) {
                 tripletColumns[numEntries] = entryColumnIndex;
                 tripletRows[numEntries] = entryRowIndex;
                 m_cholmodTriplet->nnz++;
@@ -1697,7 +2013,7 @@ namespace Isis {
               int entryColumnIndex = jj + numLeadingColumns;
               int entryRowIndex = ii + numLeadingRows;
 
-              if ( m_iteration ==1 ) {
+              if ( newTriplet ) {
                 tripletColumns[numEntries] = entryRowIndex;
                 tripletRows[numEntries] = entryColumnIndex;
                 m_cholmodTriplet->nnz++;
@@ -2582,6 +2898,13 @@ namespace Isis {
    */
   bool BundleAdjust::errorPropagation() {
     emit(statusBarUpdate("Error Propagation"));
+
+    // the conjugate gradient method does not factor the normal equations, so the normals of
+    // the final iteration are factored here
+    if (!m_L && !factorNormals()) {
+      return false;
+    }
+
     // free unneeded memory
     cholmod_free_triplet(&m_cholmodTriplet, &m_cholmodCommon);
     cholmod_free_sparse(&m_cholmodNormal, &m_cholmodCommon);
@@ -65,7 +65,9 @@ namespace Isis {
    *
    * BundleAdjust is used to perform a bundle adjustment on overlapping ISIS 3 cubes.
    * Using the collineariy condition, BundleAdjust can construct a system of normal equations
-   * and then using the CHOLMOD library, solve that system.
+   * and then using the CHOLMOD library, solve that system. For networks whose Cholesky factor
+   * would not fit in memory, the system can instead be solved with the preconditioned conjugate
+   * gradient method (see BundleSettings::SolveMethod).
    *
    * @author 2006-05-30 Jeff Anderson, Debbie A. Cook, and Tracie Sucharski
    *
@@ -396,6 +398,8 @@ namespace Isis {
       bool initializeNormalEquationsMatrix();
       bool validateNetwork();
       bool solveSystem();
+      bool factorNormals();
+      bool solveConjugateGradient();
       void iterationSummary();
       BundleSolutionInfo* bundleSolveInformation();
       bool computeBundleStatistics();
@@ -447,6 +451,14 @@ namespace Isis {
                               double, boost::numeric::ublas::upper >  &N22,
                           SparseBlockColumnMatrix                     &N12,
                           SparseBlockRowMatrix                        &Q);
+      void multiplyNormals(const LinearAlgebra::Vector &values,
+                           LinearAlgebra::Vector &product);
+      QVector<LinearAlgebra::Matrix> formPreconditioner();
+      void applyPreconditioner(const QVector<LinearAlgebra::Matrix> &preconditioner,
+                               const LinearAlgebra::Vector &residual,
+                               LinearAlgebra::Vector &preconditioned);
+      bool invertPositiveDefinite(const LinearAlgebra::Matrix &matrix,
+                                  LinearAlgebra::Matrix &inverse);
       void productAlphaAV(double alpha,
                           boost::numeric::ublas::bounded_vector< double, 3 >  &v2,
                           SparseBlockRowMatrix                                &Q,
@@ -99,6 +99,12 @@ namespace Isis {
         m_elapsedTime(src.m_elapsedTime),
         m_elapsedTimeErrorProp(src.m_elapsedTimeErrorProp),
         m_converged(src.m_converged),
+        m_numberConjugateGradientSolves(src.m_numberConjugateGradientSolves),
+        m_numberConjugateGradientIterations(src.m_numberConjugateGradientIterations),
+        m_maximumConjugateGradientIterations(src.m_maximumConjugateGradientIterations),
+        m_numberUnconvergedConjugateGradientSolves(
+            src.m_numberUnconvergedConjugateGradientSolves),
+        m_conjugateGradientRelativeResidual(src.m_conjugateGradientRelativeResidual),
         m_bundleControlPoints(src.m_bundleControlPoints),
         m_outNet(src.m_outNet),
         m_iterations(src.m_iterations),
@@ -184,6 +190,11 @@ namespace Isis {
       m_elapsedTime = src.m_elapsedTime;
       m_elapsedTimeErrorProp = src.m_elapsedTimeErrorProp;
       m_converged = src.m_converged;
+      m_numberConjugateGradientSolves = src.m_numberConjugateGradientSolves;
+      m_numberConjugateGradientIterations = src.m_numberConjugateGradientIterations;
+      m_maximumConjugateGradientIterations = src.m_maximumConjugateGradientIterations;
+      m_numberUnconvergedConjugateGradientSolves = src.m_numberUnconvergedConjugateGradientSolves;
+      m_conjugateGradientRelativeResidual = src.m_conjugateGradientRelativeResidual;
       m_bundleControlPoints = src.m_bundleControlPoints;
       m_outNet = src.m_outNet;
       m_iterations = src.m_iterations;
@@ -309,6 +320,13 @@ namespace Isis {
     m_elapsedTimeErrorProp = 0.0;
     m_converged = false; // or initialze method
 
+    // solve conjugate gradient
+    m_numberConjugateGradientSolves = 0;
+    m_numberConjugateGradientIterations = 0;
+    m_maximumConjugateGradientIterations = 0;
+    m_numberUnconvergedConjugateGradientSolves = 0;
+    m_conjugateGradientRelativeResidual = 0.0;
+
     m_cumPro = NULL;
     m_maximumLikelihoodIndex = 0;
     m_maximumLikelihoodMedianR2Residuals = 0.0;
@@ -846,6 +864,27 @@ namespace Isis {
   }
 
 
+  /**
+   * Adds the statistics of one solve of the normal equations by the
+   * conjugate gradient method.
+   *
+   * @param iterations The number of conjugate gradient iterations.
+   * @param relativeResidual The final residual relative to the right hand side.
+   * @param converged If the relative residual reached the tolerance.
+   */
+  void BundleResults::addConjugateGradientSolve(int iterations, double relativeResidual,
+                                                bool converged) {
+    m_numberConjugateGradientSolves++;
+    m_numberConjugateGradientIterations += iterations;
+    m_maximumConjugateGradientIterations = qMax(m_maximumConjugateGradientIterations,
+                                                iterations);
+    if (!converged) {
+      m_numberUnconvergedConjugateGradientSolves++;
+    }
+    m_conjugateGradientRelativeResidual = relativeResidual;
+  }
+
+
   /**
    * Sets the vector of BundleObservations.
    *
@@ -1296,6 +1335,59 @@ namespace Isis {
   }
 
 
+  /**
+   * Returns the number of bundle iterations that solved the normal equations
+   * by the conjugate gradient method.
+   *
+   * @return @b int The number of conjugate gradient solves.
+   */
+  int BundleResults::numberConjugateGradientSolves() const {
+    return m_numberConjugateGradientSolves;
+  }
+
+
+  /**
+   * Returns the total number of conjugate gradient iterations of every solve.
+   *
+   * @return @b int The number of conjugate gradient iterations.
+   */
+  int BundleResults::numberConjugateGradientIterations() const {
+    return m_numberConjugateGradientIterations;
+  }
+
+
+  /**
+   * Returns the largest number of conjugate gradient iterations of one solve.
+   *
+   * @return @b int The maximum number of conjugate gradient iterations.
+   */
+  int BundleResults::maximumConjugateGradientIterations() const {
+    return m_maximumConjugateGradientIterations;
+  }
+
+
+  /**
+   * Returns the number of conjugate gradient solves that stopped at the
+   * maximum number of iterations before reaching the tolerance.
+   *
+   * @return @b int The number of unconverged conjugate gradient solves.
+   */
+  int BundleResults::numberUnconvergedConjugateGradientSolves() const {
+    return m_numberUnconvergedConjugateGradientSolves;
+  }
+
+
+  /**
+   * Returns the residual, relative to the right hand side, of the last
+   * conjugate gradient solve.
+   *
+   * @return @b double The relative residual.
+   */
+  double BundleResults::conjugateGradientRelativeResidual() const {
+    return m_conjugateGradientRelativeResidual;
+  }
+
+
   /**
    * Returns a reference to the observations used by the BundleAdjust.
    *
@@ -1613,6 +1705,19 @@ namespace Isis {
     stream.writeAttribute("errorProp", toString(elapsedTimeErrorProp()));
     stream.writeEndElement(); // end elapsed time
 
+    // Only bundles that used the conjugate gradient method have its statistics
+    if (numberConjugateGradientSolves() > 0) {
+      stream.writeStartElement("conjugateGradient");
+      stream.writeAttribute("solves", toString(numberConjugateGradientSolves()));
+      stream.writeAttribute("iterations", toString(numberConjugateGradientIterations()));
+      stream.writeAttribute("maximumIterations",
+                            toString(maximumConjugateGradientIterations()));
+      stream.writeAttribute("unconvergedSolves",
+                            toString(numberUnconvergedConjugateGradientSolves()));
+      stream.writeAttribute("relativeResidual", toString(conjugateGradientRelativeResidual()));
+      stream.writeEndElement(); // end conjugate gradient
+    }
+
     stream.writeStartElement("minMaxSigmas");
 
     // Write the labels corresponding to the coordinate type set for reports
@@ -1905,6 +2010,35 @@ namespace Isis {
         }
 
       }
+      else if (qName == "conjugateGradient") {
+        QString solves = atts.value("solves");
+        if (!solves.isEmpty()) {
+          m_xmlHandlerBundleResults->m_numberConjugateGradientSolves = toInt(solves);
+        }
+
+        QString iterations = atts.value("iterations");
+        if (!iterations.isEmpty()) {
+          m_xmlHandlerBundleResults->m_numberConjugateGradientIterations = toInt(iterations);
+        }
+
+        QString maximumIterations = atts.value("maximumIterations");
+        if (!maximumIterations.isEmpty()) {
+          m_xmlHandlerBundleResults->m_maximumConjugateGradientIterations
+              = toInt(maximumIterations);
+        }
+
+        QString unconvergedSolves = atts.value("unconvergedSolves");
+        if (!unconvergedSolves.isEmpty()) {
+          m_xmlHandlerBundleResults->m_numberUnconvergedConjugateGradientSolves
+              = toInt(unconvergedSolves);
+        }
+
+        QString relativeResidual = atts.value("relativeResidual");
+        if (!relativeResidual.isEmpty()) {
+          m_xmlHandlerBundleResults->m_conjugateGradientRelativeResidual
+              = toDouble(relativeResidual);
+        }
+      }
 // ???      else if (qName == "minMaxSigmaDistances") {
 // ???        QString units = atts.value("units");
 // ???        if (!QString::compare(units, "meters", Qt::CaseInsensitive)) {
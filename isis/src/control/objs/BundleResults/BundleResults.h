@@ -177,6 +177,7 @@ namespace Isis {
       void setBundleControlPoints(QVector<BundleControlPointQsp> controlPoints);
       void setOutputControlNet(ControlNetQsp outNet);
       void setIterations(int iterations);
+      void addConjugateGradientSolve(int iterations, double relativeResidual, bool converged);
       void setObservations(BundleObservationVector observations);
 
       // Accessors...
@@ -229,6 +230,11 @@ namespace Isis {
       QVector<BundleControlPointQsp> &bundleControlPoints();
       ControlNetQsp outputControlNet() const;
       int iterations() const;
+      int numberConjugateGradientSolves() const;
+      int numberConjugateGradientIterations() const;
+      int maximumConjugateGradientIterations() const;
+      int numberUnconvergedConjugateGradientSolves() const;
+      double conjugateGradientRelativeResidual() const;
       const BundleObservationVector &observations() const;
 
       int numberMaximumLikelihoodModels() const;
@@ -324,6 +330,12 @@ namespace Isis {
       double m_elapsedTime;                    //!< elapsed time for bundle
       double m_elapsedTimeErrorProp;           //!< elapsed time for error propagation
       bool m_converged;
+      int m_numberConjugateGradientSolves;     //!< number of solves by conjugate gradient
+      int m_numberConjugateGradientIterations; //!< total conjugate gradient iterations
+      int m_maximumConjugateGradientIterations; //!< most conjugate gradient iterations in a solve
+      int m_numberUnconvergedConjugateGradientSolves; /**< number of conjugate gradient solves
+                                                           that reached the maximum iterations*/
+      double m_conjugateGradientRelativeResidual; //!< relative residual of the last solve
       
       // Variables for output methods in BundleSolutionInfo
       
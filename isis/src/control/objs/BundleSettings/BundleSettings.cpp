@@ -62,6 +62,13 @@ namespace Isis {
     m_convergenceCriteriaThreshold = 1.0e-10;
     m_convergenceCriteriaMaximumIterations = 50;
 
+    // Solve Method
+    m_solveMethod = BundleSettings::Cholesky;
+    m_preconditioner = BundleSettings::BlockJacobi;
+    m_conjugateGradientTolerance = 1.0e-10;
+    m_conjugateGradientMaximumIterations = 0;
+    m_hybridIterations = 3;
+
     // Maximum Likelihood Estimation Options no default in the constructor - must be set.
     m_maximumLikelihood.clear();
 
@@ -130,6 +137,11 @@ namespace Isis {
         m_convergenceCriteria(other.m_convergenceCriteria),
         m_convergenceCriteriaThreshold(other.m_convergenceCriteriaThreshold),
         m_convergenceCriteriaMaximumIterations(other.m_convergenceCriteriaMaximumIterations),
+        m_solveMethod(other.m_solveMethod),
+        m_preconditioner(other.m_preconditioner),
+        m_conjugateGradientTolerance(other.m_conjugateGradientTolerance),
+        m_conjugateGradientMaximumIterations(other.m_conjugateGradientMaximumIterations),
+        m_hybridIterations(other.m_hybridIterations),
         m_maximumLikelihood(other.m_maximumLikelihood),
         m_solveTargetBody(other.m_solveTargetBody),
         m_bundleTargetBody(other.m_bundleTargetBody),
@@ -176,6 +188,11 @@ namespace Isis {
       m_convergenceCriteria = other.m_convergenceCriteria;
       m_convergenceCriteriaThreshold = other.m_convergenceCriteriaThreshold;
       m_convergenceCriteriaMaximumIterations = other.m_convergenceCriteriaMaximumIterations;
+      m_solveMethod = other.m_solveMethod;
+      m_preconditioner = other.m_preconditioner;
+      m_conjugateGradientTolerance = other.m_conjugateGradientTolerance;
+      m_conjugateGradientMaximumIterations = other.m_conjugateGradientMaximumIterations;
+      m_hybridIterations = other.m_hybridIterations;
       m_solveTargetBody = other.m_solveTargetBody;
       m_bundleTargetBody = other.m_bundleTargetBody;
       m_cpCoordTypeReports = other.m_cpCoordTypeReports;
@@ -682,6 +699,196 @@ namespace Isis {
 
 
 
+  // =============================================================================================//
+  // ======================== Solve Method =======================================================//
+  // =============================================================================================//
+
+  /**
+   * Converts the given string value to a BundleSettings::SolveMethod enumeration.
+   * Currently accepted inputs are listed below. This method is case insensitive.
+   * <ul>
+   *   <li>Cholesky</li>
+   *   <li>ConjugateGradient</li>
+   *   <li>Hybrid</li>
+   * </ul>
+   *
+   * @param method Solve method name to be converted.
+   *
+   * @return @b SolveMethod The enumeration corresponding to the given name.
+   *
+   * @throw Isis::Exception::Programmer "Unknown bundle solve method."
+   */
+  BundleSettings::SolveMethod BundleSettings::stringToSolveMethod(QString method) {
+    if (method.compare("CHOLESKY", Qt::CaseInsensitive) == 0) {
+      return BundleSettings::Cholesky;
+    }
+    else if (method.compare("CONJUGATEGRADIENT", Qt::CaseInsensitive) == 0) {
+      return BundleSettings::ConjugateGradient;
+    }
+    else if (method.compare("HYBRID", Qt::CaseInsensitive) == 0) {
+      return BundleSettings::Hybrid;
+    }
+    else throw IException(IException::Programmer,
+                          "Unknown bundle solve method [" + method + "].",
+                          _FILEINFO_);
+  }
+
+
+  /**
+   * Converts the given BundleSettings::SolveMethod enumeration to a string.
+   *
+   * @param method The SolveMethod enumeration to be converted.
+   *
+   * @return @b QString The name associated with the given solve method.
+   *
+   * @throw Isis::Exception::Programmer "Unknown solve method enum."
+   */
+  QString BundleSettings::solveMethodToString(BundleSettings::SolveMethod method) {
+    if (method == Cholesky)                return "Cholesky";
+    else if (method == ConjugateGradient)  return "ConjugateGradient";
+    else if (method == Hybrid)             return "Hybrid";
+    else  throw IException(IException::Programmer,
+                           "Unknown solve method enum [" + toString(method) + "].",
+                           _FILEINFO_);
+  }
+
+
+  /**
+   * Converts the given string value to a BundleSettings::Preconditioner enumeration.
+   * Currently accepted inputs are listed below. This method is case insensitive.
+   * <ul>
+   *   <li>None</li>
+   *   <li>Jacobi</li>
+   *   <li>BlockJacobi</li>
+   * </ul>
+   *
+   * @param preconditioner Preconditioner name to be converted.
+   *
+   * @return @b Preconditioner The enumeration corresponding to the given name.
+   *
+   * @throw Isis::Exception::Programmer "Unknown bundle preconditioner."
+   */
+  BundleSettings::Preconditioner
+      BundleSettings::stringToPreconditioner(QString preconditioner) {
+    if (preconditioner.compare("NONE", Qt::CaseInsensitive) == 0) {
+      return BundleSettings::NoPreconditioner;
+    }
+    else if (preconditioner.compare("JACOBI", Qt::CaseInsensitive) == 0) {
+      return BundleSettings::Jacobi;
+    }
+    else if (preconditioner.compare("BLOCKJACOBI", Qt::CaseInsensitive) == 0) {
+      return BundleSettings::BlockJacobi;
+    }
+    else throw IException(IException::Programmer,
+                          "Unknown bundle preconditioner [" + preconditioner + "].",
+                          _FILEINFO_);
+  }
+
+
+  /**
+   * Converts the given BundleSettings::Preconditioner enumeration to a string.
+   *
+   * @param preconditioner The Preconditioner enumeration to be converted.
+   *
+   * @return @b QString The name associated with the given preconditioner.
+   *
+   * @throw Isis::Exception::Programmer "Unknown preconditioner enum."
+   */
+  QString BundleSettings::preconditionerToString(
+              BundleSettings::Preconditioner preconditioner) {
+    if (preconditioner == NoPreconditioner) return "None";
+    else if (preconditioner == Jacobi)      return "Jacobi";
+    else if (preconditioner == BlockJacobi) return "BlockJacobi";
+    else  throw IException(IException::Programmer,
+                           "Unknown preconditioner enum [" + toString(preconditioner) + "].",
+                           _FILEINFO_);
+  }
+
+
+  /**
+   * Set how the normal equations are solved in each iteration of the bundle
+   * adjustment. CHOLMOD factors the normal equations exactly, but the factor
+   * can need far more memory than the normal equations themselves for large
+   * networks. The conjugate gradient method only multiplies the normal
+   * equations by vectors, and stops once the residual relative to the right
+   * hand side is below the tolerance.
+   *
+   * @param method How the normal equations are solved.
+   * @param preconditioner The preconditioner used by the conjugate gradient method.
+   * @param tolerance The relative residual at which the conjugate gradient method stops.
+   * @param maximumIterations The maximum number of conjugate gradient iterations for each
+   *                          solve, or 0 to allow as many as there are image parameters.
+   * @param hybridIterations The number of bundle iterations the Hybrid method solves with
+   *                         the conjugate gradient method before changing to CHOLMOD.
+   */
+  void BundleSettings::setSolveMethod(BundleSettings::SolveMethod method,
+                                      BundleSettings::Preconditioner preconditioner,
+                                      double tolerance,
+                                      int maximumIterations,
+                                      int hybridIterations) {
+    m_solveMethod = method;
+    m_preconditioner = preconditioner;
+    m_conjugateGradientTolerance = tolerance;
+    m_conjugateGradientMaximumIterations = maximumIterations;
+    m_hybridIterations = hybridIterations;
+  }
+
+
+  /**
+   * Retrieves how the normal equations are solved.
+   *
+   * @return @b SolveMethod The enumeration of the solve method.
+   */
+  BundleSettings::SolveMethod BundleSettings::solveMethod() const {
+    return m_solveMethod;
+  }
+
+
+  /**
+   * Retrieves the preconditioner used by the conjugate gradient method.
+   *
+   * @return @b Preconditioner The enumeration of the preconditioner.
+   */
+  BundleSettings::Preconditioner BundleSettings::preconditioner() const {
+    return m_preconditioner;
+  }
+
+
+  /**
+   * Retrieves the residual, relative to the right hand side, at which the
+   * conjugate gradient method stops.
+   *
+   * @return @b double The conjugate gradient tolerance.
+   */
+  double BundleSettings::conjugateGradientTolerance() const {
+    return m_conjugateGradientTolerance;
+  }
+
+
+  /**
+   * Retrieves the maximum number of conjugate gradient iterations for each
+   * solve.
+   *
+   * @return @b int The maximum number of iterations, or 0 for the number of
+   *                image parameters.
+   */
+  int BundleSettings::conjugateGradientMaximumIterations() const {
+    return m_conjugateGradientMaximumIterations;
+  }
+
+
+  /**
+   * Retrieves the number of bundle iterations the Hybrid solve method solves
+   * with the conjugate gradient method.
+   *
+   * @return @b int The number of conjugate gradient iterations of the bundle.
+   */
+  int BundleSettings::hybridIterations() const {
+    return m_hybridIterations;
+  }
+
+
+
   // =============================================================================================//
   // ======================== Parameter Uncertainties (Weighting) ================================//
   // =============================================================================================//
@@ -1099,6 +1306,18 @@ namespace Isis {
                           toString(convergenceCriteriaMaximumIterations()));
     stream.writeEndElement();
 
+    // Settings without the element read back as Cholesky, which is the default
+    if (solveMethod() != Cholesky) {
+      stream.writeStartElement("solveMethodOptions");
+      stream.writeAttribute("solveMethod", solveMethodToString(solveMethod()));
+      stream.writeAttribute("preconditioner", preconditionerToString(preconditioner()));
+      stream.writeAttribute("tolerance", toString(conjugateGradientTolerance()));
+      stream.writeAttribute("maximumIterations",
+                            toString(conjugateGradientMaximumIterations()));
+      stream.writeAttribute("hybridIterations", toString(hybridIterations()));
+      stream.writeEndElement();
+    }
+
     stream.writeStartElement("maximumLikelihoodEstimation");
     for (int i = 0; i < m_maximumLikelihood.size(); i++) {
       stream.writeStartElement("model");
@@ -1288,6 +1507,35 @@ namespace Isis {
               = toInt(convergenceCriteriaMaximumIterationsStr);
         }
       }
+      else if (localName == "solveMethodOptions") {
+
+        QString solveMethodStr = attributes.value("solveMethod");
+        if (!solveMethodStr.isEmpty()) {
+          m_xmlHandlerBundleSettings->m_solveMethod = stringToSolveMethod(solveMethodStr);
+        }
+
+        QString preconditionerStr = attributes.value("preconditioner");
+        if (!preconditionerStr.isEmpty()) {
+          m_xmlHandlerBundleSettings->m_preconditioner
+              = stringToPreconditioner(preconditionerStr);
+        }
+
+        QString toleranceStr = attributes.value("tolerance");
+        if (!toleranceStr.isEmpty()) {
+          m_xmlHandlerBundleSettings->m_conjugateGradientTolerance = toDouble(toleranceStr);
+        }
+
+        QString maximumIterationsStr = attributes.value("maximumIterations");
+        if (!maximumIterationsStr.isEmpty()) {
+          m_xmlHandlerBundleSettings->m_conjugateGradientMaximumIterations
+              = toInt(maximumIterationsStr);
+        }
+
+        QString hybridIterationsStr = attributes.value("hybridIterations");
+        if (!hybridIterationsStr.isEmpty()) {
+          m_xmlHandlerBundleSettings->m_hybridIterations = toInt(hybridIterationsStr);
+        }
+      }
       else if (localName == "model") {
         QString type = attributes.value("type");
         QString quantile = attributes.value("quantile");
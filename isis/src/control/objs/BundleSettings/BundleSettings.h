@@ -224,6 +224,47 @@ namespace Isis {
       double convergenceCriteriaThreshold() const;
       int convergenceCriteriaMaximumIterations() const;
 
+      //=====================================================================//
+      //============================ Solve Method ===========================//
+      //=====================================================================//
+
+      /**
+       * This enum defines how the reduced normal equations are solved in each
+       * iteration of the bundle adjustment.
+       */
+      enum SolveMethod {
+        Cholesky,          /**< The normal equations are factored with CHOLMOD.*/
+        ConjugateGradient, /**< The normal equations are solved with the preconditioned
+                                conjugate gradient method, which never forms a factor.*/
+        Hybrid             /**< The conjugate gradient method is used for the first
+                                iterations and CHOLMOD for the rest.*/
+      };
+
+      /**
+       * This enum defines the preconditioners for the conjugate gradient method.
+       */
+      enum Preconditioner {
+        NoPreconditioner, /**< The residuals are used unchanged.*/
+        Jacobi,           /**< The diagonal of the normal equations matrix is inverted.*/
+        BlockJacobi       /**< The diagonal blocks of the normal equations matrix, one for
+                               each observation and one for the target body, are inverted.*/
+      };
+
+      static SolveMethod stringToSolveMethod(QString method);
+      static QString solveMethodToString(SolveMethod method);
+      static Preconditioner stringToPreconditioner(QString preconditioner);
+      static QString preconditionerToString(Preconditioner preconditioner);
+      void setSolveMethod(SolveMethod method,
+                          Preconditioner preconditioner = BlockJacobi,
+                          double tolerance = 1.0e-10,
+                          int maximumIterations = 0,
+                          int hybridIterations = 3);
+      SolveMethod solveMethod() const;
+      Preconditioner preconditioner() const;
+      double conjugateGradientTolerance() const;
+      int conjugateGradientMaximumIterations() const;
+      int hybridIterations() const;
+
       //=====================================================================//
       //================ Parameter Uncertainties (Weighting) ================//
       //=====================================================================//
@@ -386,6 +427,19 @@ namespace Isis {
                                                        quitting the bundle adjustment if it has
                                                        not yet converged to the given threshold.*/
 
+      // Solve Method
+      SolveMethod m_solveMethod;                  //!< How the normal equations are solved.
+      Preconditioner m_preconditioner;            //!< The conjugate gradient preconditioner.
+      double m_conjugateGradientTolerance;        /**< The residual, relative to the right hand
+                                                       side, at which the conjugate gradient
+                                                       iterations stop.*/
+      int m_conjugateGradientMaximumIterations;   /**< Maximum number of conjugate gradient
+                                                       iterations for each solve, or 0 for the
+                                                       number of image parameters.*/
+      int m_hybridIterations;                     /**< Number of bundle iterations solved with
+                                                       the conjugate gradient method by the
+                                                       Hybrid solve method.*/
+
       // Maximum Likelihood Estimation Options
       /**
        * Model and C-Quantile for each of the three maximum likelihood
@@ -701,6 +701,31 @@ namespace Isis {
                   m_settings->convergenceCriteriaMaximumIterations());
     fpOut << buf;
 
+    // Runs solved by CHOLMOD alone keep the output they always had
+    if (m_settings->solveMethod() != BundleSettings::Cholesky) {
+      sprintf(buf, "\n\nINPUT: SOLVE METHOD\n===================\n");
+      fpOut << buf;
+      sprintf(buf, "\n                   SOLVE METHOD: %s",
+                    BundleSettings::solveMethodToString(m_settings->solveMethod())
+                        .toLatin1().data());
+      fpOut << buf;
+      sprintf(buf, "\n                 PRECONDITIONER: %s",
+                    BundleSettings::preconditionerToString(m_settings->preconditioner())
+                        .toLatin1().data());
+      fpOut << buf;
+      sprintf(buf, "\n                   CG TOLERANCE: %e",
+                    m_settings->conjugateGradientTolerance());
+      fpOut << buf;
+      sprintf(buf, "\n          CG MAXIMUM ITERATIONS: %d",
+                    m_settings->conjugateGradientMaximumIterations());
+      fpOut << buf;
+      if (m_settings->solveMethod() == BundleSettings::Hybrid) {
+        sprintf(buf, "\n              HYBRID ITERATIONS: %d",
+                      m_settings->hybridIterations());
+        fpOut << buf;
+      }
+    }
+
     //TODO Should it be checked that positionSigmas.size() == positionSolveDegree and
     //     pointingSigmas.size() == pointingSolveDegree somewhere? JAM
 
@@ -976,6 +1001,24 @@ namespace Isis {
       fpOut << buf;
     }
 
+    if (m_statisticsResults->numberConjugateGradientSolves() > 0) {
+      sprintf(buf, "\n                      CG Solves: %6d",
+                    m_statisticsResults->numberConjugateGradientSolves());
+      fpOut << buf;
+      sprintf(buf, "\n                  CG Iterations: %6d (%d maximum)",
+                    m_statisticsResults->numberConjugateGradientIterations(),
+                    m_statisticsResults->maximumConjugateGradientIterations());
+      fpOut << buf;
+      if (m_statisticsResults->numberUnconvergedConjugateGradientSolves() > 0) {
+        sprintf(buf, "\n          Unconverged CG Solves: %6d",
+                      m_statisticsResults->numberUnconvergedConjugateGradientSolves());
+        fpOut << buf;
+      }
+      sprintf(buf, "\n           CG Relative Residual: %6.3g",
+                    m_statisticsResults->conjugateGradientRelativeResidual());
+      fpOut << buf;
+    }
+
     sprintf(buf, "\n                         Sigma0: %30.20lf\n", m_statisticsResults->sigma0());
     fpOut << buf;
     sprintf(buf, " Error Propagation Elapsed Time: %6.4lf (seconds)\n",
@@ -1,6 +1,8 @@
 #include "ControlNetStatistics.h"
 
 #include <QDebug>
+#include <QScopedPointer>
+#include <QtConcurrentMap>
 
 #include <geos_c.h>
 #include <geos/algorithm/ConvexHull.h>
@@ -32,6 +34,28 @@ namespace Isis {
   //! String values for Boolean
   QString sBoolean[]    = { "False", "True" };
 
+  //! The number of control points gathered by each thread at a time
+  static const int s_pointChunkSize = 4096;
+
+  //! The default number of images whose convex hulls are found in parallel
+  static const int s_imageBatchSize = 256;
+
+  //! The point stats that hold the smallest absolute value of any point
+  static const ControlNetStatistics::ePointDoubleStats s_minimumStats[] = {
+    ControlNetStatistics::minResidual, ControlNetStatistics::minLineResidual,
+    ControlNetStatistics::minSampleResidual, ControlNetStatistics::minPixelShift,
+    ControlNetStatistics::minLineShift, ControlNetStatistics::minSampleShift,
+    ControlNetStatistics::minGFit
+  };
+
+  //! The point stats that hold the largest absolute value of any point
+  static const ControlNetStatistics::ePointDoubleStats s_maximumStats[] = {
+    ControlNetStatistics::maxResidual, ControlNetStatistics::maxLineResidual,
+    ControlNetStatistics::maxSampleResidual, ControlNetStatistics::maxPixelShift,
+    ControlNetStatistics::maxLineShift, ControlNetStatistics::maxSampleShift,
+    ControlNetStatistics::maxGFit
+  };
+
   /**
    * ControlNetStatistics Constructor has ctor to it's base Control Network
    *
@@ -45,14 +69,14 @@ namespace Isis {
                                              Progress *pProgress) {
     numCNetImages = 0;
     mCNet = pCNet;
+    mImageBatchSize = s_imageBatchSize;
 
     mSerialNumList = SerialNumberList(psSerialNumFile);
     InitSerialNumMap();
 
     mProgress = pProgress;
 
-    GetPointIntStats();
-    GetPointDoubleStats();
+    GetPointStats();
     GenerateImageStats();
   }
 
@@ -67,9 +91,9 @@ namespace Isis {
   ControlNetStatistics::ControlNetStatistics(ControlNet *pCNet, Progress *pProgress) {
     mCNet = pCNet;
     mProgress = pProgress;
+    mImageBatchSize = s_imageBatchSize;
 
-    GetPointIntStats();
-    GetPointDoubleStats();
+    GetPointStats();
   }
 
   /**
@@ -207,99 +231,143 @@ namespace Isis {
    *  imgSamples, imgLines, imgTotalPoints, imgIgnoredPoints, imgFixedPoints, imgLockedPoints,
    *  imgLocked, imgConstrainedPoints, imgFreePoints, imgConvexHullArea, imgConvexHullRatio
    *
+   * The cubes are opened and the measures of each image are found in order. The images are
+   * then counted and their convex hulls found in parallel, a batch at a time, and the results
+   * are added to the convex hull statistics in the same order.
+   *
    * @author Sharmila Prasad (11/1/2011)
    */
   void ControlNetStatistics::GenerateImageStats() {
-    geos::geom::GeometryFactory::Ptr geosFactory = geos::geom::GeometryFactory::create();
-
     CubeManager cubeMgr;
     cubeMgr.SetNumOpenCubes(50);
 
     QList<QString> cnetSerials = mCNet->GetCubeSerials();
 
+    // The stats of an earlier call are replaced
+    numCNetImages = 0;
+    mConvexHullStats.Reset();
+    mConvexHullRatioStats.Reset();
+
     if (mProgress != NULL) {
       mProgress->SetText("Generating Image Stats.....");
       mProgress->SetMaximumSteps(cnetSerials.size());
       mProgress->CheckStatus();
     }
 
-    foreach (QString sn, cnetSerials) {
-      geos::geom::CoordinateSequence * ptCoordinates =
-          new geos::geom::CoordinateArraySequence();
+    QList<ImageTask> tasks;
+    for (int i = 0; i < cnetSerials.size(); i++) {
+      ImageTask task;
+      task.serialNumber = cnetSerials[i];
 
       // setup vector for number of image properties and init to 0
-      QVector<double> imgStats(numImageStats, 0);
+      task.stats = QVector<double>(numImageStats, 0);
 
       // Open the cube to get the dimensions
-      Cube *cube = cubeMgr.OpenCube(mSerialNumList.fileName(sn));
+      Cube *cube = cubeMgr.OpenCube(mSerialNumList.fileName(task.serialNumber));
 
-      mSerialNumMap[sn] = true;
+      mSerialNumMap[task.serialNumber] = true;
       numCNetImages++;
 
-      imgStats[imgSamples] = cube->sampleCount();
-      imgStats[imgLines]   = cube->lineCount();
-      double cubeArea      = imgStats[imgSamples] * imgStats[imgLines];
-
-      QList< ControlMeasure * > measures = mCNet->GetMeasuresInCube(sn);
-
-      // Populate pts with a list of control points
-      if (!measures.isEmpty()) {
-        foreach (ControlMeasure * measure, measures) {
-          ControlPoint *parentPoint = measure->Parent();
-          imgStats[imgTotalPoints]++;
-          if (parentPoint->IsIgnored()) {
-            imgStats[imgIgnoredPoints]++;
-          }
-          if (parentPoint->GetType() == ControlPoint::Fixed) {
-            imgStats[imgFixedPoints]++;
-          }
-          if (parentPoint->GetType() == ControlPoint::Constrained) {
-            imgStats[imgConstrainedPoints]++;
-          }
-          if (parentPoint->GetType() == ControlPoint::Free) {
-            imgStats[imgFreePoints]++;
-          }
-          if (parentPoint->IsEditLocked()) {
-            imgStats[imgLockedPoints]++;
-          }
-          if (measure->IsEditLocked()) {
-            imgStats[imgLocked]++;
-          }
-          ptCoordinates->add(geos::geom::Coordinate(measure->GetSample(),
-                                                    measure->GetLine()));
-        }
+      task.stats[imgSamples] = cube->sampleCount();
+      task.stats[imgLines]   = cube->lineCount();
+      task.measures = mCNet->GetMeasuresInCube(task.serialNumber);
+      tasks.append(task);
 
-        ptCoordinates->add(geos::geom::Coordinate(measures[0]->GetSample(),
-                                                  measures[0]->GetLine()));
-      }
+      if (tasks.size() >= mImageBatchSize || i == cnetSerials.size() - 1) {
+        QtConcurrent::blockingMap(tasks, &ControlNetStatistics::GatherImageStats);
 
-      if (ptCoordinates->size() >= 4) {
-        // Calculate the convex hull
+        foreach (const ImageTask &done, tasks) {
+          // Add info to statistics to get min, max and avg convex hull
+          mConvexHullStats.AddData(done.stats[imgConvexHullArea]);
+          mConvexHullRatioStats.AddData(done.stats[imgConvexHullRatio]);
 
-        // Even though geos doesn't create valid linear rings/polygons from this set of coordinates,
-        //   because it self-intersects many many times, it still correctly does a convex hull
-        //   calculation on the points in the polygon.
-        geos::geom::Geometry * convexHull = geosFactory->createPolygon(
-          geosFactory->createLinearRing(ptCoordinates), 0)->convexHull();
+          mImageMap[done.serialNumber] = done.stats;
 
-        // Calculate the area of the convex hull
-        imgStats[imgConvexHullArea] = convexHull->getArea();
-        imgStats[imgConvexHullRatio] = imgStats[imgConvexHullArea] / cubeArea;
+          // Update Progress
+          if (mProgress != NULL)
+            mProgress->CheckStatus();
+        }
+
+        tasks.clear();
       }
+    }
+  }
 
-      // Add info to statistics to get min, max and avg convex hull
-      mConvexHullStats.AddData(imgStats[imgConvexHullArea]);
-      mConvexHullRatioStats.AddData(imgStats[imgConvexHullRatio]);
 
-      mImageMap[sn] = imgStats;
+  /**
+   * Sets how many images GenerateImageStats opens before gathering their stats in parallel.
+   * Larger batches keep more threads busy and hold the measures of more images at once.
+   *
+   * @param size The number of images in a batch, at least one
+   */
+  void ControlNetStatistics::SetImageBatchSize(int size) {
+    mImageBatchSize = qMax(size, 1);
+  }
 
-      delete ptCoordinates;
-      ptCoordinates = NULL;
 
-      // Update Progress
-      if (mProgress != NULL)
-        mProgress->CheckStatus();
+  /**
+   * Counts the points of one image and finds the area of the convex hull of its measures. The
+   * image dimensions must already be in the stats.
+   *
+   * @param task The image to gather the stats of
+   */
+  void ControlNetStatistics::GatherImageStats(ImageTask &task) {
+    QVector<double> &imgStats = task.stats;
+    double cubeArea = imgStats[imgSamples] * imgStats[imgLines];
+
+    QScopedPointer<geos::geom::CoordinateSequence> ptCoordinates(
+        new geos::geom::CoordinateArraySequence());
+
+    // Populate pts with a list of control points
+    if (!task.measures.isEmpty()) {
+      foreach (ControlMeasure * measure, task.measures) {
+        ControlPoint *parentPoint = measure->Parent();
+        imgStats[imgTotalPoints]++;
+        if (parentPoint->IsIgnored()) {
+          imgStats[imgIgnoredPoints]++;
+        }
+        if (parentPoint->GetType() == ControlPoint::Fixed) {
+          imgStats[imgFixedPoints]++;
+        }
+        if (parentPoint->GetType() == ControlPoint::Constrained) {
+          imgStats[imgConstrainedPoints]++;
+        }
+        if (parentPoint->GetType() == ControlPoint::Free) {
+          imgStats[imgFreePoints]++;
+        }
+        if (parentPoint->IsEditLocked()) {
+          imgStats[imgLockedPoints]++;
+        }
+        if (measure->IsEditLocked()) {
+          imgStats[imgLocked]++;
+        }
+        ptCoordinates->add(geos::geom::Coordinate(measure->GetSample(),
+                                                  measure->GetLine()));
+      }
+
+      ptCoordinates->add(geos::geom::Coordinate(task.measures[0]->GetSample(),
+                                                task.measures[0]->GetLine()));
+    }
+
+    if (ptCoordinates->size() >= 4) {
+      // Calculate the convex hull. Each image uses its own factory because geometries update
+      // the reference count of the factory that made them.
+      geos::geom::GeometryFactory::Ptr geosFactory = geos::geom::GeometryFactory::create();
+
+      // Even though geos doesn't create valid linear rings/polygons from this set of coordinates,
+      //   because it self-intersects many many times, it still correctly does a convex hull
+      //   calculation on the points in the polygon.
+      QScopedPointer<geos::geom::Polygon> polygon(geosFactory->createPolygon(
+          geosFactory->createLinearRing(ptCoordinates.take()), 0));
+      QScopedPointer<geos::geom::Geometry> convexHull(polygon->convexHull());
+
+      // Calculate the area of the convex hull
+      imgStats[imgConvexHullArea] = convexHull->getArea();
+      imgStats[imgConvexHullRatio] = imgStats[imgConvexHullArea] / cubeArea;
     }
+
+    // The measures are not needed once the image has been counted
+    task.measures.clear();
   }
 
 
@@ -431,61 +499,84 @@ namespace Isis {
 
 
   /**
-   * Get network statistics for total, valid, ignored, locked points and measures
+   * Get network statistics for total, valid, ignored, locked points and measures, and for
+   * Residuals (line, sample, magnitude) and Shifts (line, sample, pixel)
+   *
+   * The points are read once, in chunks of a fixed size that are gathered in parallel. The
+   * chunks are then merged in order, so the counts, minimums and maximums are the same as
+   * reading the points one at a time and the averages are summed the same way every run.
    *
    * @author sprasad (7/19/2011)
    */
-  void ControlNetStatistics::GetPointIntStats() {
+  void ControlNetStatistics::GetPointStats() {
     // Init all the entries
     // totalPoints, validPoints, ignoredPoints, fixedPoints, constrainedPoints, editLockedPoints,
     // totalMeasures, validMeasures, ignoredMeasures, editLockedMeasures
     for (int i=0; i<numPointIntStats; i++) {
       mPointIntStats[i] = 0;
     }
+    InitPointDoubleStats();
 
     int iNumPoints = mCNet->GetNumPoints();
 
     // totalPoints
     mPointIntStats[totalPoints] = iNumPoints;
 
-    for (int i = 0; i < iNumPoints; i++) {
-      if (!mCNet->GetPoint(i)->IsIgnored()) {
-        // validPoints
-        mPointIntStats[validPoints]++;
-      }
-      else {
-        // ignoredPoints
-        mPointIntStats[ignoredPoints]++;
-      }
-
-      // fixedPoints
-      if (mCNet->GetPoint(i)->GetType() == ControlPoint::Fixed)
-        mPointIntStats[fixedPoints]++;
+    QList<PointChunk> chunks;
+    for (int begin = 0; begin < iNumPoints; begin += s_pointChunkSize) {
+      PointChunk chunk;
+      chunk.cnet = mCNet;
+      chunk.begin = begin;
+      chunk.end = qMin(begin + s_pointChunkSize, iNumPoints);
+      chunk.intStats = QVector<int>(numPointIntStats, 0);
+      chunk.doubleStats = QVector<double>(numPointDblStats, Null);
+      chunks.append(chunk);
+    }
 
-      // constrainedPoints
-      if (mCNet->GetPoint(i)->GetType() == ControlPoint::Constrained)
-        mPointIntStats[constrainedPoints]++;
+    QtConcurrent::blockingMap(chunks, &ControlNetStatistics::GatherPointStats);
 
-      // free points
-      if (mCNet->GetPoint(i)->GetType() == ControlPoint::Free)
-        mPointIntStats[freePoints]++;
+    double residualSum = 0.0;
+    double pixelShiftSum = 0.0;
+    BigInt residualCount = 0;
+    BigInt pixelShiftCount = 0;
+    int numMinMaxStats = sizeof(s_minimumStats) / sizeof(s_minimumStats[0]);
 
-      // editLockedPoints
-      if (mCNet->GetPoint(i)->IsEditLocked()) {
-        mPointIntStats[editLockedPoints]++;
+    foreach (const PointChunk &chunk, chunks) {
+      for (int stat = validPoints; stat < numPointIntStats; stat++) {
+        mPointIntStats[stat] += chunk.intStats[stat];
       }
 
-      // totalMeasures
-      mPointIntStats[totalMeasures] += mCNet->GetPoint(i)->GetNumMeasures();
+      for (int i = 0; i < numMinMaxStats; i++) {
+        double chunkMin = chunk.doubleStats[s_minimumStats[i]];
+        double chunkMax = chunk.doubleStats[s_maximumStats[i]];
+        if (chunkMin != Null) {
+          mPointDoubleStats[s_minimumStats[i]] = (mPointDoubleStats[s_minimumStats[i]] != Null) ?
+              qMin(mPointDoubleStats[s_minimumStats[i]], chunkMin) : chunkMin;
+          mPointDoubleStats[s_maximumStats[i]] = (mPointDoubleStats[s_maximumStats[i]] != Null) ?
+              qMax(mPointDoubleStats[s_maximumStats[i]], chunkMax) : chunkMax;
+        }
+      }
 
-      // validMeasures
-      mPointIntStats[validMeasures] += mCNet->GetPoint(i)->GetNumValidMeasures();
+      // The pixel z-scores are compared the same way they are for each point
+      if (mPointDoubleStats[minPixelZScore] > chunk.doubleStats[minPixelZScore])
+        mPointDoubleStats[minPixelZScore] = chunk.doubleStats[minPixelZScore];
+      if (mPointDoubleStats[maxPixelZScore] > chunk.doubleStats[maxPixelZScore])
+        mPointDoubleStats[maxPixelZScore] = chunk.doubleStats[maxPixelZScore];
 
-      // editLockedMeasures
-      mPointIntStats[editLockedMeasures] +=  mCNet->GetPoint(i)->GetNumLockedMeasures();
+      residualSum += chunk.residualMagStats.Sum();
+      residualCount += chunk.residualMagStats.ValidPixels();
+      pixelShiftSum += chunk.pixelShiftStats.Sum();
+      pixelShiftCount += chunk.pixelShiftStats.ValidPixels();
     }
+
     // ignoredMeasures
     mPointIntStats[ignoredMeasures] = mPointIntStats[totalMeasures] -  mPointIntStats[validMeasures];
+
+    // Average Residuals
+    mPointDoubleStats[avgResidual] = residualCount ? residualSum / residualCount : Null;
+
+    // Average Shift
+    mPointDoubleStats[avgPixelShift] = pixelShiftCount ? pixelShiftSum / pixelShiftCount : Null;
   }
 
 
@@ -502,108 +593,130 @@ namespace Isis {
 
 
   /**
-   * Get the Network Statistics for Residuals (line, sample, magnitude) and
-   * Shifts (line, sample, pixel)
+   * Gathers the stats of a chunk of control points, reading the measures of each point once.
+   * The minimums and maximums of each point are its Statistics, as ControlPoint::GetStatistic
+   * would find them, so they are combined across points exactly as before.
    *
-   * @author Sharmila Prasad (7/19/2011)
+   * @param chunk The points to gather the stats of
    */
-  void ControlNetStatistics::GetPointDoubleStats() {
-    InitPointDoubleStats();
-
-    int iNumPoints = mCNet->GetNumPoints();
+  void ControlNetStatistics::GatherPointStats(PointChunk &chunk) {
+    const ControlNet *cnet = chunk.cnet;
     double dValue = 0;
 
-    Statistics residualMagStats;
-    Statistics pixelShiftStats;
-
-    for (int i = 0; i < iNumPoints; i++) {
-      ControlPoint * cp = mCNet->GetPoint(i);
+    for (int i = chunk.begin; i < chunk.end; i++) {
+      const ControlPoint *cp = cnet->GetPoint(i);
+      QList<ControlMeasure *> measures = cp->getMeasures();
 
       if (!cp->IsIgnored()) {
-        for (int cmIndex = 0; cmIndex < cp->GetNumMeasures(); cmIndex++) {
-          ControlMeasure *cm = cp->GetMeasure(cmIndex);
+        chunk.intStats[validPoints]++;
+      }
+      else {
+        chunk.intStats[ignoredPoints]++;
+      }
 
-          if (!cm->IsIgnored()) {
-            residualMagStats.AddData(cm->GetResidualMagnitude());
+      if (cp->GetType() == ControlPoint::Fixed)
+        chunk.intStats[fixedPoints]++;
 
-            if (!IsSpecial(cm->GetPixelShift()))
-              pixelShiftStats.AddData(fabs(cm->GetPixelShift()));
-          }
-        }
+      if (cp->GetType() == ControlPoint::Constrained)
+        chunk.intStats[constrainedPoints]++;
+
+      if (cp->GetType() == ControlPoint::Free)
+        chunk.intStats[freePoints]++;
+
+      if (cp->IsEditLocked()) {
+        chunk.intStats[editLockedPoints]++;
       }
 
-      Statistics resMagStats = cp->GetStatistic(
-          &ControlMeasure::GetResidualMagnitude);
-      UpdateMinMaxStats(resMagStats, minResidual, maxResidual);
+      chunk.intStats[totalMeasures] += measures.size();
 
-      Statistics resLineStats = cp->GetStatistic(
-          &ControlMeasure::GetLineResidual);
-      UpdateMinMaxStats(resLineStats, minLineResidual, maxLineResidual);
+      Statistics resMagStats, resLineStats, resSampStats;
+      Statistics pixShiftStats, lineShiftStats, sampShiftStats;
+      Statistics gFitStats, minPixelZScoreStats, maxPixelZScoreStats;
 
-      Statistics resSampStats = cp->GetStatistic(
-          &ControlMeasure::GetSampleResidual);
-      UpdateMinMaxStats(resSampStats, minSampleResidual, maxSampleResidual);
+      foreach (const ControlMeasure *cm, measures) {
+        if (cm->IsEditLocked()) {
+          chunk.intStats[editLockedMeasures]++;
+        }
 
-      Statistics pixShiftStats = cp->GetStatistic(
-          &ControlMeasure::GetPixelShift);
-      UpdateMinMaxStats(pixShiftStats, minPixelShift, maxPixelShift);
+        if (cm->IsIgnored()) {
+          continue;
+        }
+
+        chunk.intStats[validMeasures]++;
 
-      Statistics lineShiftStats = cp->GetStatistic(
-          &ControlMeasure::GetLineShift);
-      UpdateMinMaxStats(lineShiftStats, minLineShift, maxLineShift);
+        double residualMagnitude = cm->GetResidualMagnitude();
+        double pixelShift = cm->GetPixelShift();
 
-      Statistics sampShiftStats = cp->GetStatistic(
-          &ControlMeasure::GetSampleShift);
-      UpdateMinMaxStats(sampShiftStats, minSampleShift, maxSampleShift);
+        if (!cp->IsIgnored()) {
+          chunk.residualMagStats.AddData(residualMagnitude);
+
+          if (!IsSpecial(pixelShift))
+            chunk.pixelShiftStats.AddData(fabs(pixelShift));
+        }
 
-      Statistics gFitStats = cp->GetStatistic(
-          ControlMeasureLogData::GoodnessOfFit);
-      UpdateMinMaxStats(gFitStats, minGFit, maxGFit);
+        resMagStats.AddData(residualMagnitude);
+        resLineStats.AddData(cm->GetLineResidual());
+        resSampStats.AddData(cm->GetSampleResidual());
+        pixShiftStats.AddData(pixelShift);
+        lineShiftStats.AddData(cm->GetLineShift());
+        sampShiftStats.AddData(cm->GetSampleShift());
+        gFitStats.AddData(
+            cm->GetLogData(ControlMeasureLogData::GoodnessOfFit).GetNumericalValue());
+        minPixelZScoreStats.AddData(
+            cm->GetLogData(ControlMeasureLogData::MinimumPixelZScore).GetNumericalValue());
+        maxPixelZScoreStats.AddData(
+            cm->GetLogData(ControlMeasureLogData::MaximumPixelZScore).GetNumericalValue());
+      }
 
-      Statistics minPixelZScoreStats = cp->GetStatistic(
-          ControlMeasureLogData::MinimumPixelZScore);
+      UpdateMinMaxStats(chunk.doubleStats, resMagStats, minResidual, maxResidual);
+      UpdateMinMaxStats(chunk.doubleStats, resLineStats, minLineResidual, maxLineResidual);
+      UpdateMinMaxStats(chunk.doubleStats, resSampStats, minSampleResidual, maxSampleResidual);
+      UpdateMinMaxStats(chunk.doubleStats, pixShiftStats, minPixelShift, maxPixelShift);
+      UpdateMinMaxStats(chunk.doubleStats, lineShiftStats, minLineShift, maxLineShift);
+      UpdateMinMaxStats(chunk.doubleStats, sampShiftStats, minSampleShift, maxSampleShift);
+      UpdateMinMaxStats(chunk.doubleStats, gFitStats, minGFit, maxGFit);
 
       if (minPixelZScoreStats.ValidPixels()) {
         dValue = fabs(minPixelZScoreStats.Minimum());
-        if (mPointDoubleStats[minPixelZScore] > dValue)
-          mPointDoubleStats[minPixelZScore] = dValue;
+        if (chunk.doubleStats[minPixelZScore] > dValue)
+          chunk.doubleStats[minPixelZScore] = dValue;
       }
 
-      Statistics maxPixelZScoreStats = cp->GetStatistic(
-          ControlMeasureLogData::MaximumPixelZScore);
-
       if (maxPixelZScoreStats.ValidPixels()) {
         dValue = fabs(maxPixelZScoreStats.Maximum());
-        if (mPointDoubleStats[maxPixelZScore] > dValue)
-          mPointDoubleStats[maxPixelZScore] = dValue;
+        if (chunk.doubleStats[maxPixelZScore] > dValue)
+          chunk.doubleStats[maxPixelZScore] = dValue;
       }
     }
-
-    // Average Residuals
-    mPointDoubleStats[avgResidual] = residualMagStats.Average();
-
-    // Average Shift
-    mPointDoubleStats[avgPixelShift] = pixelShiftStats.Average();
   }
 
 
-  void ControlNetStatistics::UpdateMinMaxStats(const Statistics & stats,
-      ePointDoubleStats min, ePointDoubleStats max) {
+  /**
+   * Updates the smallest and largest absolute values of a point stat with the stats of
+   * another point.
+   *
+   * @param pointStats The point stats, indexed by ePointDoubleStats
+   * @param stats The values of the point
+   * @param min The stat holding the smallest absolute value
+   * @param max The stat holding the largest absolute value
+   */
+  void ControlNetStatistics::UpdateMinMaxStats(QVector<double> &pointStats,
+      const Statistics & stats, ePointDoubleStats min, ePointDoubleStats max) {
     if (stats.ValidPixels()) {
-      if (mPointDoubleStats[min] != Null) {
-        mPointDoubleStats[min] = qMin(
-            mPointDoubleStats[min], fabs(stats.Minimum()));
+      if (pointStats[min] != Null) {
+        pointStats[min] = qMin(
+            pointStats[min], fabs(stats.Minimum()));
       }
       else {
-        mPointDoubleStats[min] = fabs(stats.Minimum());
+        pointStats[min] = fabs(stats.Minimum());
       }
 
-      if (mPointDoubleStats[max] != Null) {
-        mPointDoubleStats[max] = qMax(
-            mPointDoubleStats[max], fabs(stats.Maximum()));
+      if (pointStats[max] != Null) {
+        pointStats[max] = qMax(
+            pointStats[max], fabs(stats.Maximum()));
       }
       else {
-        mPointDoubleStats[max] = fabs(stats.Maximum());
+        pointStats[max] = fabs(stats.Maximum());
       }
     }
   }
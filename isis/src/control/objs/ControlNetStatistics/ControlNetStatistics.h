@@ -1,8 +1,10 @@
 #ifndef _CONTROLNETSTATISTICS_H_
 #define _CONTROLNETSTATISTICS_H_
 
+#include <QList>
 #include <QMap>
-#include <QVector> 
+#include <QString>
+#include <QVector>
 
 #include "Progress.h"
 #include "PvlGroup.h"
@@ -34,6 +36,7 @@
  */
 
 namespace Isis {
+  class ControlMeasure;
   class ControlNet;
   class Progress;
   class PvlGroup;
@@ -110,6 +113,9 @@ namespace Isis {
       //! Generate stats like Total, Ignored, Fixed Points in an Image
       void GenerateImageStats();
 
+      //! Set the number of images whose stats are gathered at once
+      void SetImageBatchSize(int size);
+
       //! Print the Image Stats into specified output file
       void PrintImageStats(const QString &psImageFile);
 
@@ -253,15 +259,42 @@ namespace Isis {
       QMap<QString, QVector<double> > mImageMap; //!< Contains stats by Image/Serial Num
       QMap<QString, bool> mSerialNumMap;        //!< Whether serial# is part of ControlNet
 
-      //! Get point count stats
-      void GetPointIntStats();
-
-      //! Get Point stats for Residuals and Shifts
-      void GetPointDoubleStats();
-
-      void UpdateMinMaxStats(const Statistics & stats,
-                             ePointDoubleStats min,
-                             ePointDoubleStats max);
+      /**
+       * The counts, minimums, maximums and sums gathered from a contiguous
+       * range of the control points. The chunks have a fixed size so the
+       * sums are added in the same order however many threads are used.
+       */
+      struct PointChunk {
+        const ControlNet *cnet;       //!< The network the points belong to
+        int begin;                    //!< Index of the first point in the chunk
+        int end;                      //!< Index one past the last point in the chunk
+        QVector<int> intStats;        //!< Counts indexed by ePointIntStats
+        QVector<double> doubleStats;  //!< Minimums and maximums indexed by ePointDoubleStats
+        Statistics residualMagStats;  //!< Residual magnitudes of the valid measures
+        Statistics pixelShiftStats;   //!< Pixel shifts of the valid measures
+      };
+
+      /**
+       * The measures of one image and the stats found from them. The cubes
+       * are opened one at a time, and then the measures of several images
+       * are counted and their convex hulls found in parallel.
+       */
+      struct ImageTask {
+        QString serialNumber;              //!< The serial number of the image
+        QList<ControlMeasure *> measures;  //!< The measures in the image
+        QVector<double> stats;             //!< Stats indexed by ImageStats
+      };
+
+      //! Get point count stats and the stats for Residuals and Shifts
+      void GetPointStats();
+
+      static void GatherPointStats(PointChunk &chunk);
+      static void GatherImageStats(ImageTask &task);
+
+      static void UpdateMinMaxStats(QVector<double> &pointStats,
+                                    const Statistics & stats,
+                                    ePointDoubleStats min,
+                                    ePointDoubleStats max);
 
       //! Init Pointstats std::vector
       void InitPointDoubleStats();
@@ -270,6 +303,7 @@ namespace Isis {
       void InitSerialNumMap();
 
       int numCNetImages;
+      int mImageBatchSize; //!< The number of images whose stats are gathered at once
 
       Statistics mConvexHullStats, mConvexHullRatioStats; //!< min, max, average convex hull stats
   };
@@ -8,6 +8,7 @@
 #include <sstream>
 #include <iostream>
 
+#include "CalibrationPipeline.h"
 #include "FileName.h"
 #include "ProcessByLine.h"
 #include "UserInterface.h"
@@ -45,63 +46,65 @@ MatrixList *calVars = 0;
 
 
 /**
- * @brief Apply calibration to each HiRISE image line
+ * @brief Converts a HiCal coefficient matrix to a pipeline coefficient vector
  *
- * This function applies the calbration equation to each input image line.  It
- * gets matrices and constants from the \b calVars container that is established
- * in the main with some user input via the configuration (CONF) parameter.
+ * @param name Name of the matrix in the \b calVars container
  *
- * @param in  Input raw image line buffer
- * @param out Output calibrated image line buffer
+ * @return std::vector<double> The coefficients of the matrix
  */
-void calibrate(Buffer &in, Buffer &out) {
-  const HiVector &ZBF    = calVars->get("ZeroBufferFit");
-  const HiVector &ZRev   = calVars->get("ZeroReverse");
-  const HiVector &ZD     = calVars->get("ZeroDark");
-  const HiVector &GLD    = calVars->get("GainLineDrift");
-  const HiVector &GCN    = calVars->get("GainChannelNormalize");
-  const double GNL       = calVars->get("GainNonLinearity")[0];
-  const HiVector &GFF    = calVars->get("GainFlatField");
-  const HiVector &GT     = calVars->get("GainTemperature");
-  const double GUC       = calVars->get("GainUnitConversion")[0];
-
-  //  Set current line (index)
-  int line(in.Line()-1);
-  if (calVars->exists("LastGoodLine")) {
-    int lastline = ((int) (calVars->get("LastGoodLine"))[0]) - 1;
-    if ( line > lastline ) { line = lastline; }
-  }
+static vector<double> coefficients(const QString &name) {
+  const HiVector &matrix = calVars->get(name);
+  return vector<double>(&matrix[0], &matrix[0] + matrix.dim());
+}
 
-  //  Apply correction to point of non-linearity accumulating average
-  vector<double> data;
-  for (int i = 0 ; i < in.size() ; i++) {
-    if (IsSpecial(in[i])) {
-      out[i] = in[i];
-    }
-    else {
-      double hdn;
-      hdn = (in[i] - ZBF[line] - ZRev[i] - ZD[i]); // Drift, Reverse, Dark
-      hdn = hdn / GLD[line];  // GainLineDrift
-      data.push_back(hdn);   // Accumulate average for non-linearity
-      out[i] = hdn;
-    }
-  }
 
-  // Second loop require to apply non-linearity gain correction from average
-  if ( data.size() > 0 ) {  // No valid pixels means just that - done
-    // See HiCalUtil.h for the function that returns this stat.
-    double NLGain = 1.0 - (GNL * GainLineStat(data));
-    for (int i = 0 ; i < out.size() ; i++) {
-      if (!IsSpecial(out[i])) {
-        double hdn = out[i];
-        hdn = hdn * GCN[i] * NLGain * GFF[i] * GT[i];  // Gain, Non-linearity
-                                                       // gain,  FlatField,
-                                                       // TempGain
-        out[i] = hdn / GUC;                   // I/F or DN or DN/US
-      }
-    }
-  }
-  return;
+/**
+ * @brief Builds the HiRISE calibration equation
+ *
+ * The pipeline applies the calibration equation to each input image line
+ * using the matrices and constants from the \b calVars container that is
+ * established in the main with some user input via the configuration (CONF)
+ * parameter:
+ *
+ *   hdn = (idn - ZeroBufferFit - ZeroReverse - ZeroDark) / GainLineDrift
+ *   odn = hdn * GainChannelNormalize * (1 - GainNonLinearity * GainLineStat(hdn))
+ *             * GainFlatField * GainTemperature / GainUnitConversion
+ *
+ * @return CalibrationPipeline The calibration equation
+ */
+static CalibrationPipeline calibrationPipeline() {
+  CalibrationPipeline pipeline;
+
+  //  Drift, Reverse, Dark
+  pipeline.addStage(CalibrationPipeline::Subtract, "ZeroBufferFit",
+                    CalibrationPipeline::LineCoefficients, coefficients("ZeroBufferFit"));
+  pipeline.addStage(CalibrationPipeline::Subtract, "ZeroReverse",
+                    CalibrationPipeline::SampleCoefficients, coefficients("ZeroReverse"));
+  pipeline.addStage(CalibrationPipeline::Subtract, "ZeroDark",
+                    CalibrationPipeline::SampleCoefficients, coefficients("ZeroDark"));
+  pipeline.addStage(CalibrationPipeline::Divide, "GainLineDrift",
+                    CalibrationPipeline::LineCoefficients, coefficients("GainLineDrift"));
+
+  //  Non-linearity gain from the line average.  See HiCalUtil.h for the
+  //  function that returns this stat.
+  const double GNL = calVars->get("GainNonLinearity")[0];
+  pipeline.addLineStatistic("GainNonLinearity", [GNL](vector<double> &data) {
+    return 1.0 - (GNL * GainLineStat(data));
+  });
+
+  //  Gain, Non-linearity gain, FlatField, TempGain, I/F or DN or DN/US
+  pipeline.addStage(CalibrationPipeline::Multiply, "GainChannelNormalize",
+                    CalibrationPipeline::SampleCoefficients, coefficients("GainChannelNormalize"));
+  pipeline.addStage(CalibrationPipeline::Multiply, "GainNonLinearity",
+                    CalibrationPipeline::LineStatistic);
+  pipeline.addStage(CalibrationPipeline::Multiply, "GainFlatField",
+                    CalibrationPipeline::SampleCoefficients, coefficients("GainFlatField"));
+  pipeline.addStage(CalibrationPipeline::Multiply, "GainTemperature",
+                    CalibrationPipeline::SampleCoefficients, coefficients("GainTemperature"));
+  pipeline.addStage(CalibrationPipeline::Divide, "GainUnitConversion",
+                    CalibrationPipeline::Constant,
+                    vector<double>(1, calVars->get("GainUnitConversion")[0]));
+  return pipeline;
 }
 
 
@@ -382,7 +385,9 @@ void IsisMain(){
 /////////////////////////////////////////////////////////////////////////
 //  Call the processing function
     procStep = "calibration phase";
-    p.StartProcess(calibrate);
+    CalibrationPipeline pipeline = calibrationPipeline();
+    pipeline.validate(nsamps, nlines);
+    p.ProcessCube(pipeline);
 
     // Get the default profile for logging purposes
     hiprof = hiconf.getMatrixProfile();
@@ -54,10 +54,14 @@ namespace Isis {
 
     p_requestedFillArea = 0.0;
     p_bricksOrdered = true;
+    p_overviewLevels = p_dataThread->GetCube(p_cubeId)->overviewLevels();
 
     connect(this, SIGNAL(ReadCube(int, int, int, int, int, int, void *)),
             p_dataThread, SLOT(ReadCube(int, int, int, int, int, int, void *)));
 
+    connect(this, SIGNAL(ReadCubeOverview(int, int, int, int, int, int, int, void *)),
+            p_dataThread, SLOT(ReadCubeOverview(int, int, int, int, int, int, int, void *)));
+
     connect(p_dataThread, SIGNAL(ReadReady(void *, int, const Isis::Brick *)),
             this, SLOT(DataReady(void *, int, const Isis::Brick *)));
 
@@ -73,6 +77,9 @@ namespace Isis {
     disconnect(this, SIGNAL(ReadCube(int, int, int, int, int, int, void *)),
                p_dataThread, SLOT(ReadCube(int, int, int, int, int, int, void *)));
 
+    disconnect(this, SIGNAL(ReadCubeOverview(int, int, int, int, int, int, int, void *)),
+               p_dataThread, SLOT(ReadCubeOverview(int, int, int, int, int, int, int, void *)));
+
     disconnect(p_dataThread, SIGNAL(ReadReady(void *, int, const Isis::Brick *)),
                this, SLOT(DataReady(void *, int, const Isis::Brick *)));
 
@@ -551,13 +558,44 @@ namespace Isis {
     int roundedSamp = (int)(ssamp + 0.5);
     int roundedLine = (int)(line + 0.5);
 
-    emit ReadCube(p_cubeId, roundedSamp, roundedLine, roundedSamp + brickWidth,
-                  roundedLine, p_band, this);
+    int level = overviewLevel();
+    if (level > 1) {
+      emit ReadCubeOverview(p_cubeId, level, roundedSamp, roundedLine,
+                            roundedSamp + brickWidth, roundedLine, p_band, this);
+    }
+    else {
+      emit ReadCube(p_cubeId, roundedSamp, roundedLine, roundedSamp + brickWidth,
+                    roundedLine, p_band, this);
+    }
 
     fill->incRequestPosition();
   }
 
 
+  /**
+   * When the viewport is zoomed out, only one of every few cube pixels is
+   * shown. If the cube has overviews, reading the coarsest one that still has
+   * at least one pixel per screen pixel is much less I/O. The picture is not
+   * the same, though: overview pixels are averages of the cube pixels under
+   * them, so the view is smoother than the nearest neighbor sampling of the
+   * cube itself, and the stretch sees the averaged values.
+   *
+   * @return int The overview level to read from, or 1 to read the cube itself
+   */
+  int ViewportBuffer::overviewLevel() const {
+    int level = 1;
+    double pixelsPerScreenPixel = 1.0 / p_viewport->scale();
+
+    for (int i = 0; i < p_overviewLevels.size(); i++) {
+      if (p_overviewLevels[i] <= pixelsPerScreenPixel) {
+        level = p_overviewLevels[i];
+      }
+    }
+
+    return level;
+  }
+
+
   /**
    * This processes the next available action, or starts
    * processing it, if possible. This method keeps the buffer
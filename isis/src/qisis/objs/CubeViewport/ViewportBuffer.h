@@ -142,6 +142,21 @@ namespace Isis {
       void ReadCube(int cubeId, int startSample, int startLine,
                     int endSample, int endLine, int band, void *caller);
 
+      /**
+       * Ask the cube data thread for data from a reduced-resolution overview
+       *
+       * @param cubeId
+       * @param level
+       * @param startSample
+       * @param startLine
+       * @param endSample
+       * @param endLine
+       * @param band
+       * @param caller
+       */
+      void ReadCubeOverview(int cubeId, int level, int startSample, int startLine,
+                            int endSample, int endLine, int band, void *caller);
+
       //! Tell cube data thread we're done with a brick
       void DoneWithData(int, const Isis::Brick *);
 
@@ -157,6 +172,7 @@ namespace Isis {
       ViewportBufferFill *createViewportBufferFill(QRect, bool);
 
       void requestCubeLine(ViewportBufferFill *fill);
+      int overviewLevel() const;
 
       void resizeBuffer(unsigned int width, unsigned int height);
       void shiftBuffer(int deltaX, int deltaY);
@@ -170,6 +186,7 @@ namespace Isis {
       CubeDataThread *p_dataThread;  //!< manages cube io
 
       int p_band; //!< The band to read from
+      QList<int> p_overviewLevels; //!< Overview levels stored in the cube
 
       bool p_enabled; //!< True if reading from cube (active)
       std::vector< std::vector<double> > p_buffer; //!< The buffer to hold cube dn values
@@ -1,6 +1,7 @@
 #include <iostream>
 #include <QTemporaryFile>
 #include <QTemporaryDir>
+#include <QThreadPool>
 #include <QVector>
 
 #include <geos/geom/GeometryFactory.h>
@@ -14,6 +15,9 @@
 
 #include "Camera.h"
 #include "CameraFactory.h"
+#include "ControlMeasure.h"
+#include "ControlNet.h"
+#include "ControlPoint.h"
 #include "Cube.h"
 #include "CubeAttribute.h"
 #include "FileName.h"
@@ -197,3 +201,67 @@ TEST_F(ThreeImageNetwork, FunctionalTestAutoseedDeffiles) {
   ASSERT_EQ(onet.GetNumValidPoints(), 60);
   ASSERT_EQ(onet.GetNumValidMeasures(), 147);
 }
+
+TEST_F(ThreeImageNetwork, FunctionalTestAutoseedThreaded) {
+  Pvl *log = NULL;
+  QString defFile = tempDir.path()+"/gridPixels.pvl";
+  QString serialNet = tempDir.path()+"/serial.net";
+  QString threadedNet = tempDir.path()+"/threaded.net";
+
+  PvlObject autoseedObject("AutoSeed");
+  PvlGroup autoseedGroup("PolygonSeederAlgorithm");
+  autoseedGroup.addKeyword(PvlKeyword("Name", "Grid"));
+  autoseedGroup.addKeyword(PvlKeyword("MinimumThickness", "0.0"));
+  autoseedGroup.addKeyword(PvlKeyword("MinimumArea", "1000"));
+  autoseedGroup.addKeyword(PvlKeyword("XSpacing", "20000"));
+  autoseedGroup.addKeyword(PvlKeyword("YSpacing", "10000"));
+  autoseedGroup.addKeyword(PvlKeyword("MinEmission", "18.0"));
+  autoseedGroup.addKeyword(PvlKeyword("MaxEmission", "75.0"));
+  autoseedObject.addGroup(autoseedGroup);
+
+  Pvl autoseedDef;
+  autoseedDef.addObject(autoseedObject);
+  autoseedDef.write(defFile);
+
+  QVector<QString> autoseedArgs = {"fromlist="+cubeListFile,
+                                    "onet="+serialNet,
+                                    "deffile="+defFile,
+                                    "overlaplist="+threeImageOverlapFile->original(),
+                                    "networkid=1",
+                                    "pointid=???",
+                                    "description=autoseed test network"};
+  UserInterface serialUi(APP_XML, autoseedArgs);
+  autoseed(serialUi, log);
+
+  autoseedArgs.replace(1, "onet="+threadedNet);
+  autoseedArgs.append("threaded=yes");
+  UserInterface threadedUi(APP_XML, autoseedArgs);
+
+  // Make sure the overlaps are split between threads even on a single core machine
+  int maxThreads = QThreadPool::globalInstance()->maxThreadCount();
+  QThreadPool::globalInstance()->setMaxThreadCount(qMax(maxThreads, 3));
+  autoseed(threadedUi, log);
+  QThreadPool::globalInstance()->setMaxThreadCount(maxThreads);
+
+  ControlNet serial(serialNet);
+  ControlNet threaded(threadedNet);
+  ASSERT_EQ(serial.GetNumPoints(), threaded.GetNumPoints());
+  ASSERT_EQ(serial.GetNumValidMeasures(), threaded.GetNumValidMeasures());
+
+  for (int i = 0; i < serial.GetNumPoints(); i++) {
+    ControlPoint *serialPoint = serial.GetPoint(i);
+    ControlPoint *threadedPoint = threaded.GetPoint(i);
+    EXPECT_EQ(serialPoint->GetId(), threadedPoint->GetId());
+    EXPECT_EQ(serialPoint->IsIgnored(), threadedPoint->IsIgnored());
+    ASSERT_EQ(serialPoint->GetNumMeasures(), threadedPoint->GetNumMeasures());
+
+    for (int m = 0; m < serialPoint->GetNumMeasures(); m++) {
+      const ControlMeasure *serialMeasure = serialPoint->GetMeasure(m);
+      const ControlMeasure *threadedMeasure = threadedPoint->GetMeasure(m);
+      EXPECT_EQ(serialMeasure->GetCubeSerialNumber(), threadedMeasure->GetCubeSerialNumber());
+      EXPECT_DOUBLE_EQ(serialMeasure->GetSample(), threadedMeasure->GetSample());
+      EXPECT_DOUBLE_EQ(serialMeasure->GetLine(), threadedMeasure->GetLine());
+      EXPECT_EQ(serialMeasure->IsIgnored(), threadedMeasure->IsIgnored());
+    }
+  }
+}
@@ -0,0 +1,88 @@
+#include <cmath>
+
+#include <QString>
+
+#include "BundleAdjust.h"
+#include "BundleResults.h"
+#include "BundleSettings.h"
+#include "BundleSolutionInfo.h"
+#include "ControlNet.h"
+#include "ControlPoint.h"
+#include "Distance.h"
+#include "Fixtures.h"
+#include "SurfacePoint.h"
+
+#include "gmock/gmock.h"
+
+using namespace Isis;
+
+/**
+ * Adjusts the three image network with the given solve method and returns
+ * its results. The adjusted network is returned through the last argument.
+ */
+static BundleResults adjustNetwork(QString cubeListFile, BundleSettings::SolveMethod method,
+                                   ControlNetQsp &adjustedNetwork) {
+  BundleSettingsQsp settings = BundleSettingsQsp(new BundleSettings);
+  settings->setSolveOptions(false, false, true, false,
+                            SurfacePoint::Latitudinal, SurfacePoint::Latitudinal,
+                            1000.0, 1000.0, 1000.0);
+  settings->setConvergenceCriteria(BundleSettings::Sigma0, 1.0e-10, 50);
+  settings->setSolveMethod(method, BundleSettings::BlockJacobi, 1.0e-14, 0, 1);
+
+  BundleAdjust bundleAdjustment(settings, "data/threeImageNetwork/controlnetwork.net",
+                                cubeListFile, false);
+  BundleSolutionInfo *solution = bundleAdjustment.solveCholeskyBR();
+  BundleResults results = solution->bundleResults();
+  delete solution;
+
+  adjustedNetwork = bundleAdjustment.controlNet();
+  return results;
+}
+
+
+/**
+ * Adjusts the network by conjugate gradient and by the hybrid method and
+ * compares both to CHOLMOD.
+ */
+TEST_F(ThreeImageNetwork, BundleAdjustSolveMethodsMatchCholesky) {
+  ControlNetQsp expectedNetwork;
+  BundleResults expected = adjustNetwork(cubeListFile, BundleSettings::Cholesky,
+                                         expectedNetwork);
+  ASSERT_TRUE(expected.converged());
+  EXPECT_EQ(expected.numberConjugateGradientSolves(), 0);
+
+  BundleSettings::SolveMethod methods[] = {BundleSettings::ConjugateGradient,
+                                           BundleSettings::Hybrid};
+  for (int m = 0; m < 2; m++) {
+    QString name = BundleSettings::solveMethodToString(methods[m]);
+    ControlNetQsp actualNetwork;
+    BundleResults actual = adjustNetwork(cubeListFile, methods[m], actualNetwork);
+    ASSERT_TRUE(actual.converged()) << name;
+    EXPECT_GT(actual.numberConjugateGradientSolves(), 0) << name;
+    EXPECT_EQ(actual.numberUnconvergedConjugateGradientSolves(), 0) << name;
+    EXPECT_NEAR(actual.sigma0(), expected.sigma0(), 1.0e-6 * expected.sigma0()) << name;
+
+    ASSERT_EQ(actualNetwork->GetNumPoints(), expectedNetwork->GetNumPoints());
+    for (int i = 0; i < expectedNetwork->GetNumPoints(); i++) {
+      SurfacePoint expectedPoint = expectedNetwork->GetPoint(i)->GetAdjustedSurfacePoint();
+      SurfacePoint actualPoint = actualNetwork->GetPoint(i)->GetAdjustedSurfacePoint();
+      if (!expectedPoint.Valid()) {
+        EXPECT_FALSE(actualPoint.Valid()) << name << " point " << i;
+        continue;
+      }
+
+      // Adjusted coordinates agree to a millimeter
+      EXPECT_NEAR(actualPoint.GetX().meters(), expectedPoint.GetX().meters(), 1.0e-3)
+          << name << " point " << i;
+      EXPECT_NEAR(actualPoint.GetY().meters(), expectedPoint.GetY().meters(), 1.0e-3)
+          << name << " point " << i;
+      EXPECT_NEAR(actualPoint.GetZ().meters(), expectedPoint.GetZ().meters(), 1.0e-3)
+          << name << " point " << i;
+
+      // Error propagation factors the final normals, so the sigmas agree as well
+      double expectedSigma = expectedPoint.GetLatSigmaDistance().meters();
+      EXPECT_NEAR(actualPoint.GetLatSigmaDistance().meters(), expectedSigma,
+                  1.0e-4 * expectedSigma) << name << " point " << i;
+    }
+  }
+}
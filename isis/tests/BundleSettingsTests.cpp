@@ -130,6 +130,14 @@ class ConvergenceCriteriaTest : public ::testing::TestWithParam<BundleSettings::
   // Intentionally empty
 };
 
+class SolveMethodTest : public ::testing::TestWithParam<BundleSettings::SolveMethod> {
+  // Intentionally empty
+};
+
+class PreconditionerTest : public ::testing::TestWithParam<BundleSettings::Preconditioner> {
+  // Intentionally empty
+};
+
 TEST(BundleSettings, DefaultConstructor) {
   BundleSettings testSettings;
 
@@ -152,6 +160,12 @@ TEST(BundleSettings, DefaultConstructor) {
   EXPECT_EQ(1.0e-10, testSettings.convergenceCriteriaThreshold());
   EXPECT_EQ(50, testSettings.convergenceCriteriaMaximumIterations());
 
+  EXPECT_EQ(BundleSettings::Cholesky, testSettings.solveMethod());
+  EXPECT_EQ(BundleSettings::BlockJacobi, testSettings.preconditioner());
+  EXPECT_EQ(1.0e-10, testSettings.conjugateGradientTolerance());
+  EXPECT_EQ(0, testSettings.conjugateGradientMaximumIterations());
+  EXPECT_EQ(3, testSettings.hybridIterations());
+
   EXPECT_TRUE(testSettings.maximumLikelihoodEstimatorModels().isEmpty());
 
   EXPECT_FALSE(testSettings.solveTargetBody());
@@ -637,6 +651,107 @@ INSTANTIATE_TEST_CASE_P(
       ::testing::Values(BundleSettings::Sigma0, BundleSettings::ParameterCorrections)
 );
 
+TEST_P(SolveMethodTest, solveMethodStrings) {
+  QString methodString = BundleSettings::solveMethodToString(GetParam());
+  BundleSettings::SolveMethod method = BundleSettings::stringToSolveMethod(methodString);
+  EXPECT_EQ(GetParam(), method);
+}
+
+TEST_P(SolveMethodTest, solveMethod) {
+  BundleSettings testSettings;
+  testSettings.setSolveMethod(
+        GetParam(),
+        BundleSettings::Jacobi,
+        1.0e-6,
+        200,
+        2
+  );
+  EXPECT_EQ(GetParam(), testSettings.solveMethod());
+  EXPECT_EQ(BundleSettings::Jacobi, testSettings.preconditioner());
+  EXPECT_EQ(1.0e-6, testSettings.conjugateGradientTolerance());
+  EXPECT_EQ(200, testSettings.conjugateGradientMaximumIterations());
+  EXPECT_EQ(2, testSettings.hybridIterations());
+
+  BundleSettings copySettings(testSettings);
+  EXPECT_EQ(GetParam(), copySettings.solveMethod());
+  EXPECT_EQ(BundleSettings::Jacobi, copySettings.preconditioner());
+  EXPECT_EQ(1.0e-6, copySettings.conjugateGradientTolerance());
+  EXPECT_EQ(200, copySettings.conjugateGradientMaximumIterations());
+  EXPECT_EQ(2, copySettings.hybridIterations());
+}
+
+TEST_P(SolveMethodTest, saveSolveMethod) {
+  BundleSettings testSettings;
+  testSettings.setSolveMethod(
+        GetParam(),
+        BundleSettings::NoPreconditioner,
+        1.0e-6,
+        200,
+        2
+  );
+
+  QDomDocument settingsDoc = saveToQDomDocument(testSettings);
+  QDomElement root = settingsDoc.documentElement();
+
+  QDomElement globalSettings = root.firstChildElement("globalSettings");
+  ASSERT_FALSE(globalSettings.isNull());
+
+  // The default method is not written, so older settings files stay the same
+  QDomElement solveMethodOptions = globalSettings.firstChildElement("solveMethodOptions");
+  if (GetParam() == BundleSettings::Cholesky) {
+    EXPECT_TRUE(solveMethodOptions.isNull());
+    return;
+  }
+  ASSERT_FALSE(solveMethodOptions.isNull());
+  QDomNamedNodeMap solveMethodOptionsAtts = solveMethodOptions.attributes();
+  EXPECT_EQ(
+        BundleSettings::solveMethodToString(testSettings.solveMethod()),
+        solveMethodOptionsAtts.namedItem("solveMethod").nodeValue()
+  );
+  EXPECT_EQ(
+        "None",
+        solveMethodOptionsAtts.namedItem("preconditioner").nodeValue()
+  );
+  EXPECT_EQ(
+        toString(testSettings.conjugateGradientTolerance()),
+        solveMethodOptionsAtts.namedItem("tolerance").nodeValue()
+  );
+  EXPECT_EQ(
+        "200",
+        solveMethodOptionsAtts.namedItem("maximumIterations").nodeValue()
+  );
+  EXPECT_EQ(
+        "2",
+        solveMethodOptionsAtts.namedItem("hybridIterations").nodeValue()
+  );
+}
+
+INSTANTIATE_TEST_CASE_P(
+      BundleSettings,
+      SolveMethodTest,
+      ::testing::Values(BundleSettings::Cholesky, BundleSettings::ConjugateGradient,
+                        BundleSettings::Hybrid)
+);
+
+TEST_P(PreconditionerTest, preconditionerStrings) {
+  QString preconditionerString = BundleSettings::preconditionerToString(GetParam());
+  BundleSettings::Preconditioner preconditioner =
+        BundleSettings::stringToPreconditioner(preconditionerString);
+  EXPECT_EQ(GetParam(), preconditioner);
+}
+
+INSTANTIATE_TEST_CASE_P(
+      BundleSettings,
+      PreconditionerTest,
+      ::testing::Values(BundleSettings::NoPreconditioner, BundleSettings::Jacobi,
+                        BundleSettings::BlockJacobi)
+);
+
+TEST(BundleSettings, unknownSolveMethod) {
+  EXPECT_THROW(BundleSettings::stringToSolveMethod("LU"), IException);
+  EXPECT_THROW(BundleSettings::stringToPreconditioner("Multigrid"), IException);
+}
+
 TEST(BundleSettings, maximumLikelihoodHuber) {
   BundleSettings testSettings;
   testSettings.addMaximumLikelihoodEstimatorModel(
@@ -0,0 +1,106 @@
+#include <algorithm>
+#include <vector>
+
+#include "CalibrationPipeline.h"
+#include "Fixtures.h"
+#include "IException.h"
+#include "LineManager.h"
+#include "SpecialPixel.h"
+
+#include "gmock/gmock.h"
+
+using namespace Isis;
+
+static double medianPixel(std::vector<double> &pixels) {
+  std::sort(pixels.begin(), pixels.end());
+  return pixels[pixels.size() / 2];
+}
+
+
+TEST_F(SmallCube, CalibrationPipelineStages) {
+  std::vector<double> dark(10);
+  std::vector<double> gain(10);
+  for (int i = 0; i < 10; i++) {
+    dark[i] = i * 0.5;
+    gain[i] = 1.0 + i * 0.1;
+  }
+
+  CalibrationPipeline pipeline;
+  pipeline.addStage(CalibrationPipeline::Subtract, "Dark",
+                    CalibrationPipeline::SampleCoefficients, dark);
+  pipeline.addStage(CalibrationPipeline::Divide, "Gain",
+                    CalibrationPipeline::LineCoefficients, gain);
+  pipeline.addLineStatistic("Median", medianPixel);
+  pipeline.addStage(CalibrationPipeline::Subtract, "Median",
+                    CalibrationPipeline::LineStatistic);
+  pipeline.addStage(CalibrationPipeline::Multiply, "Scale",
+                    CalibrationPipeline::Constant, std::vector<double>(1, 3.0));
+  EXPECT_EQ(pipeline.size(), 5);
+  EXPECT_NO_THROW(pipeline.validate(10, 10));
+
+  LineManager in(*testCube);
+  LineManager out(*testCube);
+  in.SetLine(4, 1);
+  out.SetLine(4, 1);
+  testCube->read(in);
+  in[2] = Isis::Lrs;
+
+  pipeline(in, out);
+
+  std::vector<double> hdn;
+  for (int i = 0; i < in.size(); i++) {
+    if (!IsSpecial(in[i])) {
+      hdn.push_back((in[i] - dark[i]) / gain[3]);
+    }
+  }
+  std::vector<double> sorted(hdn);
+  double median = medianPixel(sorted);
+
+  int valid = 0;
+  for (int i = 0; i < in.size(); i++) {
+    if (i == 2) {
+      EXPECT_EQ(out[i], Isis::Lrs);
+    }
+    else {
+      EXPECT_DOUBLE_EQ(out[i], (hdn[valid++] - median) * 3.0);
+    }
+  }
+}
+
+
+TEST_F(SmallCube, CalibrationPipelineNoValidPixels) {
+  CalibrationPipeline pipeline;
+  pipeline.addLineStatistic("Median", medianPixel);
+  pipeline.addStage(CalibrationPipeline::Multiply, "Median",
+                    CalibrationPipeline::LineStatistic);
+
+  LineManager in(*testCube);
+  LineManager out(*testCube);
+  in.SetLine(1, 1);
+  out.SetLine(1, 1);
+  for (int i = 0; i < in.size(); i++) {
+    in[i] = Isis::Null;
+  }
+
+  pipeline(in, out);
+  for (int i = 0; i < out.size(); i++) {
+    EXPECT_EQ(out[i], Isis::Null);
+  }
+}
+
+
+TEST(CalibrationPipeline, Errors) {
+  CalibrationPipeline pipeline;
+  EXPECT_THROW(pipeline.addStage(CalibrationPipeline::Multiply, "Missing",
+                                 CalibrationPipeline::LineStatistic), IException);
+  EXPECT_THROW(pipeline.addStage(CalibrationPipeline::Multiply, "Empty",
+                                 CalibrationPipeline::Constant), IException);
+
+  pipeline.addLineStatistic("Median", medianPixel);
+  EXPECT_THROW(pipeline.addLineStatistic("Median", medianPixel), IException);
+
+  pipeline.addStage(CalibrationPipeline::Subtract, "Dark",
+                    CalibrationPipeline::SampleCoefficients, std::vector<double>(5, 1.0));
+  EXPECT_NO_THROW(pipeline.validate(5, 100));
+  EXPECT_THROW(pipeline.validate(6, 100), IException);
+}
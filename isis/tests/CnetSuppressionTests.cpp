@@ -0,0 +1,202 @@
+#include <algorithm>
+
+#include <QMap>
+#include <QPair>
+#include <QString>
+#include <QVector>
+#include <QtCore/qmath.h>
+
+#include "CnetManager.h"
+#include "CnetSuppression.h"
+#include "ControlMeasure.h"
+#include "ControlMeasureLogData.h"
+#include "ControlNet.h"
+#include "ControlPoint.h"
+
+#include "gmock/gmock.h"
+
+using namespace Isis;
+
+/**
+ * Adds a point measured at the same coordinate in two images.
+ */
+static void addPoint(ControlNet &network, int id, QString first, QString second,
+                     double sample, double line) {
+  ControlPoint *point = new ControlPoint(QString("Point%1").arg(id));
+  QString serials[] = {first, second};
+  for (int i = 0; i < 2; i++) {
+    ControlMeasure *measure = new ControlMeasure;
+    measure->SetCubeSerialNumber(serials[i]);
+    measure->SetCoordinate(sample, line);
+    // Distinct strengths so the points have a single order
+    measure->SetLogData(ControlMeasureLogData(ControlMeasureLogData::GoodnessOfFit,
+                                              0.1 + ((id * 37) % 80) / 100.0));
+    point->Add(measure);
+  }
+  network.AddPoint(point);
+}
+
+
+/**
+ * Creates a network of four overlapping images. B and A share 40 points, B and C share 10 and
+ * C and D share 25, so B is suppressed first, A and C can be suppressed together after it and
+ * D follows C. B covers exactly 100 by 100 pixels.
+ */
+static void createNetwork(ControlNet &network, double cellSize) {
+  int id = 0;
+  addPoint(network, id++, "A", "B", 0.0, 0.0);
+  addPoint(network, id++, "A", "B", 100.0, 100.0);
+  // On a cell corner of the first pass over B
+  addPoint(network, id++, "A", "B", 2.0 * cellSize, cellSize);
+  while (id < 40) {
+    addPoint(network, id, "A", "B", 1.25 + (id * 37) % 98, 1.5 + (id * 53) % 97);
+    id++;
+  }
+  while (id < 50) {
+    addPoint(network, id, "B", "C", 1.25 + (id * 41) % 98, 1.5 + (id * 29) % 97);
+    id++;
+  }
+  while (id < 75) {
+    addPoint(network, id, "C", "D", 1.25 + (id * 43) % 98, 1.5 + (id * 31) % 97);
+    id++;
+  }
+}
+
+
+static bool moreMeasures(const QPair<QString, int> &a, const QPair<QString, int> &b) {
+  return a.second > b.second;
+}
+
+
+TEST(CnetSuppression, ParallelSuppressMatchesSerialLoop) {
+  const int minpts = 5;
+  const int maxpts = 20;
+  const double minRadius = 1.5;
+  const double tolerance = 0.1;
+
+  // The cell size of the first pass over B, computed like the suppression does
+  const int numRadii = 98;
+  double increment = (100.0 - minRadius) / (double) (numRadii - 1);
+  double cellSize = (minRadius + (increment * (double) ((numRadii - 1) / 2))) *
+                    (1.0 / qSqrt(2.0));
+
+  ControlNet network;
+  createNetwork(network, cellSize);
+  CnetManager manager(network);
+  ASSERT_EQ(manager.size(), 75);
+
+  CnetSuppression::BitMask initial(manager.size(), false);
+  for (int i = 0; i < manager.size(); i += 9) {
+    initial[i] = true;
+  }
+
+  // Suppress the images one at a time from the most to the fewest measures. Each image keeps the
+  // points kept before it and the first image keeps the points of the input mask.
+  CnetSuppression serial(manager);
+  QMap<QString, int> counts = serial.getCubeMeasureCount();
+  QVector<QPair<QString, int> > order;
+  QMapIterator<QString, int> count(counts);
+  while (count.hasNext()) {
+    count.next();
+    order.append(qMakePair(count.key(), count.value()));
+  }
+  std::stable_sort(order.begin(), order.end(), moreMeasures);
+  ASSERT_EQ(order.size(), 4);
+  EXPECT_EQ(order[0].first.toStdString(), "B");
+
+  CnetSuppression::BitMask mask = initial;
+  CnetSuppression::Results expected;
+  for (int i = 0; i < order.size(); i++) {
+    CnetSuppression::Results result = serial.suppress(order[i].first, minpts, maxpts, minRadius,
+                                                      tolerance, mask);
+    if (!expected.isValid()) {
+      expected = result;
+    }
+    else {
+      for (int p = 0; p < result.m_points.size(); p++) {
+        if (!expected.m_selected[result.m_points[p].first]) {
+          expected.add(result.m_points[p]);
+        }
+      }
+    }
+    mask = expected.m_selected.copy();
+  }
+
+  CnetSuppression parallel(manager);
+  CnetSuppression::Results actual = parallel.suppress(minpts, maxpts, minRadius, tolerance,
+                                                      initial);
+
+  ASSERT_TRUE(actual.isValid());
+  EXPECT_GT(actual.size(), 0);
+  EXPECT_LT(actual.size(), manager.size());
+  ASSERT_EQ(actual.size(), expected.size());
+  for (int p = 0; p < expected.size(); p++) {
+    EXPECT_EQ(actual.m_points[p].first, expected.m_points[p].first) << "Point " << p;
+    EXPECT_EQ(actual.m_points[p].second, expected.m_points[p].second) << "Point " << p;
+  }
+  for (int i = 0; i < manager.size(); i++) {
+    EXPECT_EQ(actual.m_selected[i], expected.m_selected[i]) << "Index " << i;
+  }
+}
+
+
+/**
+ * Compares a coverage index with the square of cells around each kept cell, over cells on both
+ * sides of zero.
+ */
+static void checkCoverage(int reach, const QVector<QPair<int, int> > &kept) {
+  CnetSuppression::CoverageIndex coverage(reach);
+  for (int k = 0; k < kept.size(); k++) {
+    coverage.add(kept[k].first, kept[k].second);
+  }
+
+  for (int x = -12; x <= 12; x++) {
+    for (int y = -12; y <= 12; y++) {
+      bool expected = false;
+      for (int k = 0; k < kept.size(); k++) {
+        if (qAbs(kept[k].first - x) <= reach && qAbs(kept[k].second - y) <= reach) {
+          expected = true;
+        }
+      }
+      EXPECT_EQ(coverage.covered(x, y), expected) << "Reach " << reach << " cell (" << x
+                                                  << ", " << y << ")";
+    }
+  }
+}
+
+
+TEST(CnetSuppression, CoverageIndexReachZero) {
+  QVector<QPair<int, int> > kept;
+  kept.append(qMakePair(3, 4));
+  kept.append(qMakePair(-1, 0));
+  kept.append(qMakePair(-5, -7));
+  checkCoverage(0, kept);
+
+  // Only the kept cells themselves are covered
+  CnetSuppression::CoverageIndex coverage(0);
+  coverage.add(-1, 0);
+  EXPECT_TRUE(coverage.covered(-1, 0));
+  EXPECT_FALSE(coverage.covered(0, 0));
+  EXPECT_FALSE(coverage.covered(-2, 0));
+  EXPECT_FALSE(coverage.covered(-1, -1));
+}
+
+
+TEST(CnetSuppression, CoverageIndexNegativeCells) {
+  QVector<QPair<int, int> > kept;
+  kept.append(qMakePair(-1, -1));
+  kept.append(qMakePair(0, 6));
+  kept.append(qMakePair(-9, 2));
+  kept.append(qMakePair(5, -10));
+  for (int reach = 1; reach <= 4; reach++) {
+    checkCoverage(reach, kept);
+  }
+
+  // Cells across zero from a kept cell
+  CnetSuppression::CoverageIndex coverage(2);
+  coverage.add(-1, -1);
+  EXPECT_TRUE(coverage.covered(1, 1));
+  EXPECT_TRUE(coverage.covered(-3, -3));
+  EXPECT_FALSE(coverage.covered(2, -1));
+  EXPECT_FALSE(coverage.covered(-1, -4));
+}
@@ -0,0 +1,296 @@
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include <QMap>
+#include <QScopedPointer>
+#include <QString>
+#include <QStringList>
+#include <QThreadPool>
+#include <QVector>
+
+#include <geos/geom/CoordinateArraySequence.h>
+#include <geos/geom/Geometry.h>
+#include <geos/geom/GeometryFactory.h>
+#include <geos/geom/Polygon.h>
+
+#include "ControlMeasure.h"
+#include "ControlNet.h"
+#include "ControlNetStatistics.h"
+#include "ControlPoint.h"
+#include "Cube.h"
+#include "Fixtures.h"
+#include "IString.h"
+#include "PvlGroup.h"
+#include "SerialNumberList.h"
+#include "SpecialPixel.h"
+#include "Statistics.h"
+
+#include "gmock/gmock.h"
+
+using namespace Isis;
+
+/**
+ * Creates a network with enough points to be gathered in several chunks, with ignored points,
+ * ignored measures and measures without residuals.
+ */
+static void createNetwork(ControlNet &network, int numPoints) {
+  for (int i = 0; i < numPoints; i++) {
+    ControlPoint *point = new ControlPoint(QString("Point%1").arg(i));
+
+    ControlMeasure *first = new ControlMeasure;
+    first->SetCubeSerialNumber("First");
+    first->SetCoordinate(100.0 + i % 50, 200.0 + i % 31);
+    first->SetAprioriSample(100.0 + i % 50 - 0.25 * (i % 4));
+    first->SetAprioriLine(200.0 + i % 31 + 0.125 * (i % 9));
+    first->SetResidual(0.01 * (i % 13) - 0.05, -0.02 * (i % 11));
+    point->Add(first);
+
+    ControlMeasure *second = new ControlMeasure;
+    second->SetCubeSerialNumber("Second");
+    second->SetCoordinate(50.0 + i % 23, 75.0 + i % 19);
+    if (i % 5 != 0) {
+      second->SetResidual(0.03 * (i % 5), 0.01 * (i % 17) - 0.08);
+    }
+    if (i % 7 == 0) {
+      second->SetIgnored(true);
+    }
+    point->Add(second);
+
+    if (i % 10 == 0) {
+      point->SetIgnored(true);
+    }
+
+    network.AddPoint(point);
+  }
+}
+
+
+/**
+ * Updates a smallest and largest absolute value with the values of one point.
+ */
+static void updateMinMax(const Statistics &stats, double &minimum, double &maximum) {
+  if (stats.ValidPixels()) {
+    minimum = (minimum == Null) ? fabs(stats.Minimum()) : qMin(minimum, fabs(stats.Minimum()));
+    maximum = (maximum == Null) ? fabs(stats.Maximum()) : qMax(maximum, fabs(stats.Maximum()));
+  }
+}
+
+
+TEST(ControlNetStatistics, PointStatsMatchSerialPass) {
+  ControlNet network;
+  createNetwork(network, 10000);
+  ControlNetStatistics stats(&network);
+
+  int validPoints = 0;
+  int totalMeasures = 0;
+  int validMeasures = 0;
+  Statistics residualMagnitudes;
+  Statistics pixelShifts;
+  double minResidual = Null, maxResidual = Null;
+  double minLineResidual = Null, maxLineResidual = Null;
+  double minSampleResidual = Null, maxSampleResidual = Null;
+  double minPixelShift = Null, maxPixelShift = Null;
+  double minLineShift = Null, maxLineShift = Null;
+
+  for (int i = 0; i < network.GetNumPoints(); i++) {
+    ControlPoint *point = network.GetPoint(i);
+    totalMeasures += point->GetNumMeasures();
+    validMeasures += point->GetNumValidMeasures();
+
+    if (!point->IsIgnored()) {
+      validPoints++;
+      for (int m = 0; m < point->GetNumMeasures(); m++) {
+        ControlMeasure *measure = point->GetMeasure(m);
+        if (!measure->IsIgnored()) {
+          residualMagnitudes.AddData(measure->GetResidualMagnitude());
+          if (!IsSpecial(measure->GetPixelShift())) {
+            pixelShifts.AddData(fabs(measure->GetPixelShift()));
+          }
+        }
+      }
+    }
+
+    updateMinMax(point->GetStatistic(&ControlMeasure::GetResidualMagnitude),
+                 minResidual, maxResidual);
+    updateMinMax(point->GetStatistic(&ControlMeasure::GetLineResidual),
+                 minLineResidual, maxLineResidual);
+    updateMinMax(point->GetStatistic(&ControlMeasure::GetSampleResidual),
+                 minSampleResidual, maxSampleResidual);
+    updateMinMax(point->GetStatistic(&ControlMeasure::GetPixelShift),
+                 minPixelShift, maxPixelShift);
+    updateMinMax(point->GetStatistic(&ControlMeasure::GetLineShift),
+                 minLineShift, maxLineShift);
+  }
+
+  EXPECT_EQ(stats.NumValidPoints(), validPoints);
+  EXPECT_EQ(stats.NumIgnoredPoints(), network.GetNumPoints() - validPoints);
+  EXPECT_EQ(stats.NumFreePoints(), network.GetNumPoints());
+  EXPECT_EQ(stats.NumFixedPoints(), 0);
+  EXPECT_EQ(stats.NumMeasures(), totalMeasures);
+  EXPECT_EQ(stats.NumValidMeasures(), validMeasures);
+  EXPECT_EQ(stats.NumIgnoredMeasures(), totalMeasures - validMeasures);
+  EXPECT_EQ(stats.NumEditLockedMeasures(), 0);
+
+  EXPECT_DOUBLE_EQ(stats.GetMinimumResidual(), minResidual);
+  EXPECT_DOUBLE_EQ(stats.GetMaximumResidual(), maxResidual);
+  EXPECT_DOUBLE_EQ(stats.GetMinLineResidual(), minLineResidual);
+  EXPECT_DOUBLE_EQ(stats.GetMaxLineResidual(), maxLineResidual);
+  EXPECT_DOUBLE_EQ(stats.GetMinSampleResidual(), minSampleResidual);
+  EXPECT_DOUBLE_EQ(stats.GetMaxSampleResidual(), maxSampleResidual);
+  EXPECT_DOUBLE_EQ(stats.GetMinPixelShift(), minPixelShift);
+  EXPECT_DOUBLE_EQ(stats.GetMaxPixelShift(), maxPixelShift);
+  EXPECT_DOUBLE_EQ(stats.GetMinLineShift(), minLineShift);
+  EXPECT_DOUBLE_EQ(stats.GetMaxLineShift(), maxLineShift);
+
+  // The sums are added in a different order, so only the printed digits have to agree
+  EXPECT_NEAR(stats.GetAverageResidual(), residualMagnitudes.Average(),
+              1.0e-13 * residualMagnitudes.Average());
+  EXPECT_NEAR(stats.GetAvgPixelShift(), pixelShifts.Average(),
+              1.0e-13 * pixelShifts.Average());
+
+  // The statistics are the same every time they are gathered
+  ControlNetStatistics again(&network);
+  EXPECT_EQ(again.GetAverageResidual(), stats.GetAverageResidual());
+  EXPECT_EQ(again.GetAvgPixelShift(), stats.GetAvgPixelShift());
+}
+
+
+TEST(ControlNetStatistics, EmptyNetwork) {
+  ControlNet network;
+  ControlNetStatistics stats(&network);
+
+  EXPECT_EQ(stats.NumValidPoints(), 0);
+  EXPECT_EQ(stats.NumMeasures(), 0);
+  EXPECT_EQ(stats.GetAverageResidual(), Null);
+  EXPECT_EQ(stats.GetMinimumResidual(), Null);
+  EXPECT_EQ(stats.GetAvgPixelShift(), Null);
+}
+
+
+/**
+ * Finds the stats of one image like GenerateImageStats did before the images were gathered in
+ * parallel, with one shared geometry factory.
+ */
+static QVector<double> serialImageStats(ControlNet &network, const QString &serialNumber,
+                                        const QString &cubeFile,
+                                        const geos::geom::GeometryFactory *factory) {
+  QVector<double> stats(ControlNetStatistics::numImageStats, 0);
+  Cube cube(cubeFile, "r");
+  stats[ControlNetStatistics::imgSamples] = cube.sampleCount();
+  stats[ControlNetStatistics::imgLines] = cube.lineCount();
+
+  QList<ControlMeasure *> measures = network.GetMeasuresInCube(serialNumber);
+  geos::geom::CoordinateSequence *coordinates = new geos::geom::CoordinateArraySequence();
+  foreach (ControlMeasure *measure, measures) {
+    ControlPoint *point = measure->Parent();
+    stats[ControlNetStatistics::imgTotalPoints]++;
+    if (point->IsIgnored()) {
+      stats[ControlNetStatistics::imgIgnoredPoints]++;
+    }
+    if (point->GetType() == ControlPoint::Fixed) {
+      stats[ControlNetStatistics::imgFixedPoints]++;
+    }
+    if (point->GetType() == ControlPoint::Constrained) {
+      stats[ControlNetStatistics::imgConstrainedPoints]++;
+    }
+    if (point->GetType() == ControlPoint::Free) {
+      stats[ControlNetStatistics::imgFreePoints]++;
+    }
+    if (point->IsEditLocked()) {
+      stats[ControlNetStatistics::imgLockedPoints]++;
+    }
+    if (measure->IsEditLocked()) {
+      stats[ControlNetStatistics::imgLocked]++;
+    }
+    coordinates->add(geos::geom::Coordinate(measure->GetSample(), measure->GetLine()));
+  }
+  if (!measures.isEmpty()) {
+    coordinates->add(geos::geom::Coordinate(measures[0]->GetSample(), measures[0]->GetLine()));
+  }
+
+  if (coordinates->size() >= 4) {
+    QScopedPointer<geos::geom::Polygon> polygon(factory->createPolygon(
+        factory->createLinearRing(coordinates), 0));
+    QScopedPointer<geos::geom::Geometry> convexHull(polygon->convexHull());
+    stats[ControlNetStatistics::imgConvexHullArea] = convexHull->getArea();
+    stats[ControlNetStatistics::imgConvexHullRatio] =
+        stats[ControlNetStatistics::imgConvexHullArea] /
+        (stats[ControlNetStatistics::imgSamples] * stats[ControlNetStatistics::imgLines]);
+  }
+  else {
+    delete coordinates;
+  }
+  return stats;
+}
+
+
+TEST_F(ThreeImageNetwork, ControlNetStatisticsImageStatsMatchSerial) {
+  cube1->close();
+  cube2->close();
+  cube3->close();
+
+  // Make sure the images are split between threads even on a single core machine
+  int maxThreads = QThreadPool::globalInstance()->maxThreadCount();
+  QThreadPool::globalInstance()->setMaxThreadCount(qMax(maxThreads, 4));
+  ControlNetStatistics stats(network, cubeListFile);
+
+  SerialNumberList serials(cubeListFile);
+  QList<QString> cnetSerials = network->GetCubeSerials();
+  ASSERT_EQ(cnetSerials.size(), 3);
+  geos::geom::GeometryFactory::Ptr factory = geos::geom::GeometryFactory::create();
+  QMap<QString, QVector<double> > expected;
+  foreach (QString serialNumber, cnetSerials) {
+    expected[serialNumber] = serialImageStats(*network, serialNumber,
+                                              serials.fileName(serialNumber), factory.get());
+    EXPECT_GT(expected[serialNumber][ControlNetStatistics::imgConvexHullArea], 0.0);
+  }
+
+  // One batch holding every image, then batches of one and of two images
+  int batchSizes[] = {0, 1, 2};
+  for (int b = 0; b < 3; b++) {
+    if (batchSizes[b] > 0) {
+      stats.SetImageBatchSize(batchSizes[b]);
+      stats.GenerateImageStats();
+    }
+
+    foreach (QString serialNumber, cnetSerials) {
+      QVector<double> actual = stats.GetImageStatsBySerialNum(serialNumber);
+      ASSERT_EQ(actual.size(), ControlNetStatistics::numImageStats);
+      for (int i = 0; i < ControlNetStatistics::numImageStats; i++) {
+        EXPECT_EQ(actual[i], expected[serialNumber][i])
+            << "Batch size " << batchSizes[b] << " image " << serialNumber.toStdString()
+            << " stat " << i;
+      }
+    }
+
+    PvlGroup summary;
+    stats.GenerateControlNetStats(summary);
+    EXPECT_EQ(toInt(summary["ImagesInControlNet"][0]), 3) << "Batch size " << batchSizes[b];
+  }
+  QThreadPool::globalInstance()->setMaxThreadCount(maxThreads);
+
+  // The CSV has a row for each image in serial number order
+  QString csvFile = tempDir.path() + "/images.csv";
+  stats.PrintImageStats(csvFile);
+  std::ifstream csv(csvFile.toStdString().c_str());
+  std::string line;
+  ASSERT_TRUE(std::getline(csv, line));
+  QStringList sortedSerials = expected.keys();
+  foreach (QString serialNumber, sortedSerials) {
+    const QVector<double> &image = expected[serialNumber];
+    std::ostringstream row;
+    row << serials.fileName(serialNumber).toStdString() << ", " << serialNumber.toStdString()
+        << ", " << image[ControlNetStatistics::imgTotalPoints]
+        << ", " << image[ControlNetStatistics::imgIgnoredPoints]
+        << ", " << image[ControlNetStatistics::imgLockedPoints]
+        << ", " << image[ControlNetStatistics::imgFixedPoints]
+        << ", " << image[ControlNetStatistics::imgConstrainedPoints]
+        << ", " << image[ControlNetStatistics::imgFreePoints]
+        << ", " << image[ControlNetStatistics::imgConvexHullRatio];
+    ASSERT_TRUE(std::getline(csv, line));
+    EXPECT_EQ(line, row.str());
+  }
+  EXPECT_FALSE(std::getline(csv, line));
+}
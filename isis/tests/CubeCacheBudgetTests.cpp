@@ -0,0 +1,105 @@
+#include <QString>
+
+#include "Constants.h"
+#include "Cube.h"
+#include "CubeCacheBudget.h"
+#include "FileName.h"
+#include "Fixtures.h"
+#include "LineManager.h"
+#include "PvlGroup.h"
+
+#include "gmock/gmock.h"
+
+using namespace Isis;
+
+/**
+ * Reads every line of a cube and returns its cache statistics.
+ */
+static PvlGroup readAllLines(QString cubeFile) {
+  Cube cube(FileName(cubeFile), "r");
+  LineManager line(cube);
+  for (line.begin(); !line.end(); line++) {
+    cube.read(line);
+  }
+  return cube.cacheStatistics();
+}
+
+
+TEST_F(SmallCube, CubeCacheStatistics) {
+  QString cubeFile = testCube->fileName();
+  testCube->close();
+
+  Cube cube(FileName(cubeFile), "r");
+  LineManager line(cube);
+  for (line.begin(); !line.end(); line++) {
+    cube.read(line);
+  }
+
+  PvlGroup stats = cube.cacheStatistics();
+  EXPECT_EQ(stats.name(), "CacheStatistics");
+  EXPECT_GT(toInt(stats["Misses"][0]), 0);
+  EXPECT_GT(toInt(stats["Hits"][0]), 0);
+  EXPECT_GT(toBigInt(stats["BytesRead"][0]), 0);
+  EXPECT_GT(toBigInt(stats["CachedBytes"][0]), 0);
+  EXPECT_EQ(stats["AccessPattern"][0], "Sequential");
+
+  // Jumping back to the start is not sequential
+  line.SetLine(1, 1);
+  cube.read(line);
+  stats = cube.cacheStatistics();
+  EXPECT_EQ(stats["AccessPattern"][0], "Random");
+}
+
+
+TEST_F(SmallCube, CubeCacheBudgetLimitsCache) {
+  QString cubeFile = testCube->fileName();
+  testCube->close();
+
+  PvlGroup unlimited = readAllLines(cubeFile);
+
+  CubeCacheBudget &budget = CubeCacheBudget::budget();
+  BigInt maximumBytes = budget.maximumBytes();
+  budget.setMaximumBytes(1);
+  PvlGroup limited = readAllLines(cubeFile);
+  budget.setMaximumBytes(maximumBytes);
+
+  // The chunks of the last read are always kept
+  EXPECT_GT(toBigInt(limited["CachedBytes"][0]), 0);
+  EXPECT_LT(toBigInt(limited["CachedBytes"][0]), toBigInt(unlimited["CachedBytes"][0]));
+  EXPECT_GE(toInt(limited["Misses"][0]), toInt(unlimited["Misses"][0]));
+  EXPECT_EQ(budget.allocatedBytes(), 0);
+}
+
+
+TEST(CubeCacheBudget, AllowanceStaysWithinBudget) {
+  CubeCacheBudget &budget = CubeCacheBudget::budget();
+  ASSERT_EQ(budget.allocatedBytes(), 0);
+  BigInt maximumBytes = budget.maximumBytes();
+  budget.setMaximumBytes(1000);
+
+  // Two handlers, the first of them holding most of the budget
+  budget.addHandler();
+  budget.addHandler();
+  budget.allocated(900);
+  EXPECT_EQ(budget.allowance(900), 1000);
+  EXPECT_EQ(budget.allowance(0), 100);
+
+  // Once the budget is full, nothing is left for a handler under its share
+  budget.allocated(100);
+  EXPECT_EQ(budget.allowance(100), 100);
+  budget.allocated(100);
+  EXPECT_EQ(budget.allowance(200), 100);
+  budget.freed(100);
+
+  // The handler over its share gives back what the other gave up
+  EXPECT_EQ(budget.allowance(900), 800);
+  budget.freed(100);
+  EXPECT_EQ(budget.allowance(100), 200);
+  EXPECT_EQ(budget.allowance(800), 900);
+
+  budget.freed(900);
+  budget.removeHandler();
+  budget.removeHandler();
+  budget.setMaximumBytes(maximumBytes);
+  EXPECT_EQ(budget.allocatedBytes(), 0);
+}
@@ -0,0 +1,113 @@
+#include <QFileInfo>
+#include <QString>
+
+#include "Brick.h"
+#include "Cube.h"
+#include "CubeAttribute.h"
+#include "FileName.h"
+#include "Fixtures.h"
+#include "LineManager.h"
+#include "SpecialPixel.h"
+
+#include "gmock/gmock.h"
+
+using namespace Isis;
+
+/**
+ * Creates a cube large enough to have several tiles per band with a
+ * compressible first band and a second band of only NULLs.
+ */
+static void createCube(QString fileName, Cube::Format format) {
+  Cube cube;
+  cube.setFormat(format);
+  cube.setDimensions(1200, 1200, 2);
+  cube.create(fileName);
+
+  LineManager line(cube);
+  for (line.begin(); !line.end(); line++) {
+    for (int i = 0; i < line.size(); i++) {
+      line[i] = (line.Band() == 1) ? (double) ((i + line.Line()) % 256) : Isis::Null;
+    }
+    cube.write(line);
+  }
+  cube.close();
+}
+
+
+TEST_F(TempTestingFiles, CubeCompressedTileRoundTrip) {
+  QString tileFile = tempDir.path() + "/tile.cub";
+  QString compressedFile = tempDir.path() + "/compressed.cub";
+  createCube(tileFile, Cube::Tile);
+  createCube(compressedFile, Cube::CompressedTile);
+
+  EXPECT_LT(QFileInfo(compressedFile).size(), QFileInfo(tileFile).size() / 10);
+
+  Cube tileCube(FileName(tileFile), "r");
+  Cube compressedCube(FileName(compressedFile), "r");
+  EXPECT_EQ(compressedCube.format(), Cube::CompressedTile);
+  PvlObject &core = compressedCube.label()->findObject("IsisCube").findObject("Core");
+  EXPECT_EQ(core["Format"][0], "CompressedTile");
+
+  // A brick of a whole band needs every tile in the band at once
+  for (int band = 1; band <= 2; band++) {
+    Brick expected(tileCube, 1200, 1200, 1);
+    Brick actual(compressedCube, 1200, 1200, 1);
+    expected.SetBasePosition(1, 1, band);
+    actual.SetBasePosition(1, 1, band);
+    tileCube.read(expected);
+    compressedCube.read(actual);
+    for (int i = 0; i < expected.size(); i++) {
+      ASSERT_EQ(expected[i], actual[i]) << "Pixel " << i << " band " << band;
+    }
+  }
+}
+
+
+TEST_F(TempTestingFiles, CubeCompressedTileRewrite) {
+  QString compressedFile = tempDir.path() + "/compressed.cub";
+  createCube(compressedFile, Cube::CompressedTile);
+
+  // Rewriting tiles with less compressible data moves them in the file
+  Cube cube(FileName(compressedFile), "rw");
+  LineManager line(cube);
+  for (line.SetLine(1, 1); line.Line() <= 10; line++) {
+    for (int i = 0; i < line.size(); i++) {
+      line[i] = (double) ((i * 7919 + line.Line() * 104729) % 65521);
+    }
+    cube.write(line);
+  }
+  line.SetLine(1, 2);
+  for (int i = 0; i < line.size(); i++) {
+    line[i] = 5.0;
+  }
+  cube.write(line);
+  cube.close();
+
+  cube.open(compressedFile, "r");
+  for (line.SetLine(1, 1); line.Line() <= 11; line++) {
+    cube.read(line);
+    for (int i = 0; i < line.size(); i++) {
+      double expected = (line.Line() <= 10) ?
+                        (double) ((i * 7919 + line.Line() * 104729) % 65521) :
+                        (double) ((i + line.Line()) % 256);
+      ASSERT_EQ(line[i], expected) << "Sample " << i + 1 << " line " << line.Line();
+    }
+  }
+
+  line.SetLine(1, 2);
+  cube.read(line);
+  EXPECT_EQ(line[0], 5.0);
+  line.SetLine(2, 2);
+  cube.read(line);
+  EXPECT_EQ(line[0], Isis::Null);
+}
+
+
+TEST(CubeCompressedTile, OutputAttribute) {
+  CubeAttributeOutput att("+CompressedTile");
+  EXPECT_EQ(att.fileFormat(), Cube::CompressedTile);
+  EXPECT_EQ(att.fileFormatString(), "CompressedTile");
+
+  att.setFileFormat(Cube::Tile);
+  EXPECT_EQ(att.fileFormat(), Cube::Tile);
+}
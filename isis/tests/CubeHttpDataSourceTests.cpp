@@ -0,0 +1,322 @@
+#include <QAtomicInt>
+#include <QCoreApplication>
+#include <QFile>
+#include <QList>
+#include <QPair>
+#include <QRegExp>
+#include <QSemaphore>
+#include <QString>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QThread>
+#include <QtConcurrent>
+
+#include "Cube.h"
+#include "CubeHttpDataSource.h"
+#include "FileName.h"
+#include "Fixtures.h"
+#include "IException.h"
+#include "LineManager.h"
+#include "Table.h"
+
+#include "gmock/gmock.h"
+
+using namespace Isis;
+
+/**
+ * A minimal HTTP server for the files in a directory that supports HEAD and
+ * range GET requests, one connection at a time. It can also act like a server
+ * that ignores ranges and always sends the whole file.
+ */
+class RangeServer : public QThread {
+  public:
+    RangeServer(const QString &root, bool honorRanges = true) {
+      m_root = root;
+      m_honorRanges = honorRanges;
+      m_port = 0;
+      m_stopping = 0;
+      start();
+      m_listening.acquire();
+    }
+
+    ~RangeServer() {
+      m_stopping = 1;
+      wait();
+    }
+
+    QString url(const QString &name) const {
+      return "http://127.0.0.1:" + QString::number(m_port) + "/" + name;
+    }
+
+    int requestCount() const {
+      return m_requests.load();
+    }
+
+  protected:
+    void run() {
+      QTcpServer server;
+      server.listen(QHostAddress::LocalHost);
+      m_port = server.serverPort();
+      m_listening.release();
+
+      while (!m_stopping.load()) {
+        if (!server.waitForNewConnection(100)) {
+          continue;
+        }
+
+        QTcpSocket *socket = server.nextPendingConnection();
+        QByteArray request;
+        while (!request.contains("\r\n\r\n") && socket->waitForReadyRead(5000)) {
+          request += socket->readAll();
+        }
+        respond(socket, QString::fromLatin1(request));
+        socket->disconnectFromHost();
+        if (socket->state() != QAbstractSocket::UnconnectedState) {
+          socket->waitForDisconnected(1000);
+        }
+        delete socket;
+      }
+    }
+
+  private:
+    void respond(QTcpSocket *socket, const QString &request) {
+      QStringList requestLine = request.section("\r\n", 0, 0).split(" ");
+      QFile file(m_root + requestLine.value(1));
+      if (requestLine.size() < 2 || !file.open(QIODevice::ReadOnly)) {
+        socket->write("HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\nConnection: close\r\n\r\n");
+        socket->waitForBytesWritten(5000);
+        return;
+      }
+
+      if (requestLine[0] == "HEAD") {
+        socket->write("HTTP/1.1 200 OK\r\nContent-Length: " + QByteArray::number(file.size()) +
+                      "\r\nAccept-Ranges: bytes\r\nConnection: close\r\n\r\n");
+        socket->waitForBytesWritten(5000);
+        return;
+      }
+
+      m_requests.ref();
+      QRegExp range("Range: bytes=(\\d+)-(\\d+)", Qt::CaseInsensitive);
+      qint64 start = 0;
+      qint64 end = file.size() - 1;
+      if (range.indexIn(request) != -1) {
+        start = range.cap(1).toLongLong();
+        end = qMin(range.cap(2).toLongLong(), file.size() - 1);
+      }
+      if (!m_honorRanges) {
+        QByteArray data = file.readAll();
+        socket->write("HTTP/1.1 200 OK\r\nContent-Length: " + QByteArray::number(data.size()) +
+                      "\r\nConnection: close\r\n\r\n");
+        socket->write(data);
+        while (socket->bytesToWrite() > 0 && socket->waitForBytesWritten(5000)) {
+        }
+        return;
+      }
+
+      file.seek(start);
+      QByteArray data = file.read(end - start + 1);
+
+      socket->write("HTTP/1.1 206 Partial Content\r\nContent-Length: " +
+                    QByteArray::number(data.size()) + "\r\nContent-Range: bytes " +
+                    QByteArray::number(start) + "-" + QByteArray::number(end) + "/" +
+                    QByteArray::number(file.size()) + "\r\nConnection: close\r\n\r\n");
+      socket->write(data);
+      while (socket->bytesToWrite() > 0 && socket->waitForBytesWritten(5000)) {
+      }
+    }
+
+    QString m_root;
+    bool m_honorRanges;
+    quint16 m_port;
+    QAtomicInt m_stopping;
+    QAtomicInt m_requests;
+    QSemaphore m_listening;
+};
+
+
+/**
+ * Network requests need an event loop, which needs an application.
+ */
+static void ensureApplication() {
+  if (!QCoreApplication::instance()) {
+    static int argc = 1;
+    static char name[] = "runISISTests";
+    static char *argv[] = {name, NULL};
+    new QCoreApplication(argc, argv);
+  }
+}
+
+
+/**
+ * Creates a cube with several tiles per band and a table.
+ */
+static void createCube(QString fileName, Cube::Format format) {
+  Cube cube;
+  cube.setFormat(format);
+  cube.setDimensions(1200, 1000, 2);
+  cube.create(fileName);
+
+  LineManager line(cube);
+  for (line.begin(); !line.end(); line++) {
+    for (int i = 0; i < line.size(); i++) {
+      line[i] = (double) (i + line.Line() * 3 + line.Band() * 7);
+    }
+    cube.write(line);
+  }
+
+  TableField field("Value", TableField::Integer);
+  TableRecord record;
+  record += field;
+  Table table("TestTable", record);
+  record[0] = 42;
+  table += record;
+  cube.write(table);
+  cube.close();
+}
+
+
+static void compareCubes(Cube &expectedCube, Cube &actualCube) {
+  ASSERT_EQ(expectedCube.sampleCount(), actualCube.sampleCount());
+  ASSERT_EQ(expectedCube.lineCount(), actualCube.lineCount());
+  ASSERT_EQ(expectedCube.bandCount(), actualCube.bandCount());
+
+  LineManager expected(expectedCube);
+  LineManager actual(actualCube);
+  for (expected.begin(), actual.begin(); !expected.end(); expected++, actual++) {
+    expectedCube.read(expected);
+    actualCube.read(actual);
+    for (int i = 0; i < expected.size(); i++) {
+      ASSERT_EQ(expected[i], actual[i]) << "Sample " << i + 1 << " line "
+          << expected.Line() << " band " << expected.Band();
+    }
+  }
+}
+
+
+TEST_F(TempTestingFiles, CubeHttpDataSourceRanges) {
+  ensureApplication();
+  QString fileName = tempDir.path() + "/bytes.dat";
+  QFile file(fileName);
+  ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+  QByteArray bytes;
+  for (int i = 0; i < 10000; i++) {
+    bytes.append((char) (i % 251));
+  }
+  file.write(bytes);
+  file.close();
+
+  RangeServer server(tempDir.path());
+  CubeHttpDataSource source(QUrl(server.url("bytes.dat")));
+  EXPECT_EQ(source.size(), 10000);
+
+  // The first three ranges touch or overlap and are read with one request, the
+  // last reaches past the end of the file
+  QList< QPair<BigInt, BigInt> > ranges;
+  ranges.append(qMakePair((BigInt) 100, (BigInt) 50));
+  ranges.append(qMakePair((BigInt) 0, (BigInt) 100));
+  ranges.append(qMakePair((BigInt) 120, (BigInt) 40));
+  ranges.append(qMakePair((BigInt) 5000, (BigInt) 10));
+  ranges.append(qMakePair((BigInt) 9995, (BigInt) 10));
+
+  QList<QByteArray> data = source.read(ranges);
+  EXPECT_EQ(server.requestCount(), 3);
+  ASSERT_EQ(data.size(), ranges.size());
+  for (int i = 0; i < 4; i++) {
+    EXPECT_EQ(data[i], bytes.mid(ranges[i].first, ranges[i].second)) << "Range " << i;
+  }
+
+  // Reads past the end are short
+  EXPECT_EQ(data[4], bytes.mid(9995));
+  EXPECT_EQ(source.write(0, QByteArray("x")), -1);
+  EXPECT_THROW(CubeHttpDataSource(QUrl(server.url("missing.dat"))), IException);
+}
+
+
+TEST_F(TempTestingFiles, CubeHttpDataSourceRemoteCube) {
+  ensureApplication();
+  QString fileName = tempDir.path() + "/remote.cub";
+  createCube(fileName, Cube::Tile);
+
+  RangeServer server(tempDir.path());
+  Cube localCube(FileName(fileName), "r");
+  Cube remoteCube;
+  remoteCube.open(server.url("remote.cub"));
+  EXPECT_TRUE(remoteCube.isReadOnly());
+  EXPECT_EQ(remoteCube.format(), Cube::Tile);
+
+  // A line covers a row of three adjacent tiles, which are read together
+  int requests = server.requestCount();
+  LineManager line(remoteCube);
+  line.SetLine(1, 1);
+  remoteCube.read(line);
+  EXPECT_EQ(server.requestCount(), requests + 1);
+
+  compareCubes(localCube, remoteCube);
+
+  Table table("TestTable");
+  remoteCube.read(table);
+  ASSERT_EQ(table.Records(), 1);
+  EXPECT_EQ((int) table[0][0], 42);
+
+  EXPECT_THROW(Cube().open(server.url("remote.cub"), "rw"), IException);
+}
+
+
+TEST_F(TempTestingFiles, CubeHttpDataSourceRemoteBsqCube) {
+  ensureApplication();
+  QString fileName = tempDir.path() + "/remote.cub";
+  createCube(fileName, Cube::Bsq);
+
+  RangeServer server(tempDir.path());
+  Cube localCube(FileName(fileName), "r");
+  Cube remoteCube;
+  remoteCube.open(server.url("remote.cub"));
+  EXPECT_EQ(remoteCube.format(), Cube::Bsq);
+  compareCubes(localCube, remoteCube);
+}
+
+
+TEST_F(TempTestingFiles, CubeHttpDataSourceIgnoredRange) {
+  ensureApplication();
+  QString fileName = tempDir.path() + "/bytes.dat";
+  QFile file(fileName);
+  ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+  file.write(QByteArray(1000, 'x'));
+  file.close();
+
+  // A whole file answer to a range request is an error, not a slow success
+  RangeServer server(tempDir.path(), false);
+  CubeHttpDataSource source(QUrl(server.url("bytes.dat")));
+  EXPECT_THROW(source.read(100, 50), IException);
+}
+
+
+TEST_F(TempTestingFiles, CubeHttpDataSourceThreads) {
+  ensureApplication();
+  QString fileName = tempDir.path() + "/bytes.dat";
+  QFile file(fileName);
+  ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+  QByteArray bytes;
+  for (int i = 0; i < 10000; i++) {
+    bytes.append((char) (i % 251));
+  }
+  file.write(bytes);
+  file.close();
+
+  RangeServer server(tempDir.path());
+  CubeHttpDataSource source(QUrl(server.url("bytes.dat")));
+
+  // Each thread reads with its own network access manager, and the source
+  // keeps working in this thread after the others have read from it
+  QList< QFuture<QByteArray> > results;
+  for (int i = 0; i < 4; i++) {
+    results.append(QtConcurrent::run([&source, i]() {
+      return source.read(i * 1000, 500);
+    }));
+  }
+
+  for (int i = 0; i < 4; i++) {
+    EXPECT_EQ(results[i].result(), bytes.mid(i * 1000, 500)) << "Thread " << i;
+  }
+  EXPECT_EQ(source.read(9000, 100), bytes.mid(9000, 100));
+}
@@ -1,12 +1,21 @@
 #include <QTemporaryFile>
 #include <QString>
+#include <QtConcurrent>
+#include <functional>
 #include <iostream>
+#include <sstream>
 
 #include <nlohmann/json.hpp>
 using json = nlohmann::json;
 
+#include "Brick.h"
 #include "Cube.h"
+#include "CubeOverview.h"
 #include "Camera.h"
+#include "IException.h"
+#include "LineManager.h"
+#include "Pvl.h"
+#include "SpecialPixel.h"
 
 #include "Fixtures.h"
 #include "TestUtilities.h"
@@ -232,3 +241,103 @@ TEST(CubeTest, TestCubeAttachSpiceFromIsd) {
 
   EXPECT_PRED_FORMAT2(AssertQStringsEqual, cam->instrumentNameLong(), "Visual Imaging Subsystem Camera B");
 }
+
+
+TEST_F(DefaultCube, CubeLazyLabels) {
+  QString fileName = testCube->fileName();
+  testCube->close();
+  Pvl fullLabel(fileName);
+  ASSERT_TRUE(fullLabel.hasObject("NaifKeywords"));
+
+  Cube cube;
+  cube.setLazyLabels(true);
+  cube.open(fileName);
+  PvlGroup &dimensions = fullLabel.findGroup("Dimensions", Pvl::Traverse);
+  EXPECT_EQ(cube.sampleCount(), int(dimensions["Samples"]));
+  EXPECT_EQ(cube.lineCount(), int(dimensions["Lines"]));
+  ASSERT_TRUE(cube.hasGroup("Instrument"));
+  EXPECT_EQ(cube.group("Instrument")["InstrumentId"][0],
+            fullLabel.findObject("IsisCube").findGroup("Instrument")["InstrumentId"][0]);
+
+  // The skipped objects are read once the whole label is used
+  EXPECT_TRUE(cube.hasTable("InstrumentPointing"));
+  std::ostringstream lazyText;
+  std::ostringstream fullText;
+  lazyText << *cube.label();
+  fullText << fullLabel;
+  EXPECT_EQ(lazyText.str(), fullText.str());
+  EXPECT_THROW(cube.setLazyLabels(false), IException);
+}
+
+
+TEST_F(DefaultCube, CubeLazyLabelsThreaded) {
+  QString fileName = testCube->fileName();
+  testCube->close();
+  int fullObjects = Pvl(fileName).objects();
+
+  Cube cube;
+  cube.setLazyLabels(true);
+  cube.open(fileName);
+
+  // Every thread sees the whole label, which is read only once
+  QList<int> objectCounts = QtConcurrent::blockingMapped(QList<int>() << 0 << 1 << 2 << 3 << 4 << 5,
+      std::function<int(const int &)>([&cube](const int &) { return cube.label()->objects(); }));
+  for (int i = 0; i < objectCounts.size(); i++) {
+    EXPECT_EQ(objectCounts[i], fullObjects);
+  }
+  EXPECT_EQ(cube.label()->objects(), fullObjects);
+}
+
+
+TEST_F(SmallCube, CubeReadTiledOverview) {
+  // A level 2 overview of the 10x10x10 cube is 5x5x10, stored here in tiles
+  // of two lines
+  QList<CubeOverview *> tiles;
+  for (int firstLine = 1; firstLine <= 5; firstLine += 2) {
+    int tileLines = qMin(2, 5 - firstLine + 1);
+    CubeOverview *tile = new CubeOverview(2, 5, 5, 10, firstLine, tileLines);
+    for (int band = 1; band <= 10; band++) {
+      for (int line = firstLine; line < firstLine + tileLines; line++) {
+        for (int sample = 1; sample <= 5; sample++) {
+          tile->setPixel(sample, line, band, sample + 10 * line + 100 * band);
+        }
+      }
+    }
+    tiles.append(tile);
+  }
+
+  testCube->write(*tiles[0]);
+  testCube->write(*tiles[1]);
+  EXPECT_TRUE(testCube->overviewLevels().isEmpty());
+  testCube->write(*tiles[2]);
+  qDeleteAll(tiles);
+  ASSERT_EQ(testCube->overviewLevels(), QList<int>() << 2);
+
+  // Crosses the edge between the first two tiles and the edge of the overview
+  Brick brick(3, 3, 2, testCube->pixelType());
+  brick.SetBasePosition(4, 2, 3);
+  testCube->read(brick, 2);
+  for (int i = 0; i < brick.size(); i++) {
+    int sample = brick.Sample(i);
+    int line = brick.Line(i);
+    if (sample > 5) {
+      EXPECT_EQ(brick[i], Isis::Null);
+    }
+    else {
+      EXPECT_EQ(brick[i], sample + 10 * line + 100 * brick.Band(i)) << "Index " << i;
+    }
+  }
+
+  // Writing DNs leaves the overview stale
+  LineManager line(*testCube);
+  line.SetLine(1, 1);
+  testCube->read(line);
+  testCube->write(line);
+  EXPECT_TRUE(testCube->overviewLevels().isEmpty());
+  EXPECT_THROW(testCube->read(brick, 2), IException);
+
+  QString fileName = testCube->fileName();
+  testCube->close();
+  testCube->open(fileName, "r");
+  EXPECT_TRUE(testCube->overviewLevels().isEmpty());
+}
@@ -0,0 +1,111 @@
+#include <vector>
+
+#include "EmbreeShapeModel.h"
+#include "EmbreeTargetManager.h"
+#include "IException.h"
+#include "SurfacePoint.h"
+
+#include <gtest/gtest.h>
+
+using namespace Isis;
+
+TEST(EmbreeShapeModel, PreparedIntersectionsMatchIntersectSurface) {
+  QString dskfile("$base/testData/hay_a_amica_5_itokawashape_v1_0_64q.bds");
+  EmbreeTargetManager *manager = EmbreeTargetManager::getInstance();
+  EmbreeShapeModel prepared(NULL, dskfile, manager);
+  EmbreeShapeModel direct(NULL, dskfile, manager);
+  ASSERT_TRUE(prepared.canPrepareIntersections());
+
+  // Observers one kilometer above the target looking down, so some of them miss it
+  std::vector< std::vector<double> > observers;
+  std::vector< std::vector<double> > looks;
+  std::vector<double> look(3);
+  look[0] = 0.1;
+  look[1] = 0.0;
+  look[2] = -1.0;
+  for (int i = -10; i <= 10; i++) {
+    for (int j = -10; j <= 10; j++) {
+      std::vector<double> observer(3);
+      observer[0] = i * 0.05;
+      observer[1] = j * 0.05;
+      observer[2] = 1.0;
+      observers.push_back(observer);
+      looks.push_back(look);
+    }
+  }
+  prepared.prepareIntersections(observers, looks);
+
+  int hits = 0;
+  for (size_t i = 0; i < observers.size(); i++) {
+    bool expected = direct.intersectSurface(observers[i], looks[i]);
+    ASSERT_EQ(prepared.intersectSurface(observers[i], looks[i]), expected) << "Ray " << i;
+    if (expected) {
+      hits++;
+      SurfacePoint *expectedPoint = direct.surfaceIntersection();
+      SurfacePoint *actualPoint = prepared.surfaceIntersection();
+      EXPECT_EQ(actualPoint->GetX().kilometers(), expectedPoint->GetX().kilometers());
+      EXPECT_EQ(actualPoint->GetY().kilometers(), expectedPoint->GetY().kilometers());
+      EXPECT_EQ(actualPoint->GetZ().kilometers(), expectedPoint->GetZ().kilometers());
+      EXPECT_EQ(prepared.normal(), direct.normal());
+    }
+  }
+  EXPECT_GT(hits, 0);
+  EXPECT_LT(hits, (int) observers.size());
+
+  // Look directions that were not prepared are still traced
+  std::vector<double> observer(3, 0.0);
+  observer[0] = 1000.0;
+  std::vector<double> lookBack(3, 0.0);
+  lookBack[0] = -1.0;
+  EXPECT_EQ(prepared.intersectSurface(observer, lookBack),
+            direct.intersectSurface(observer, lookBack));
+  EXPECT_TRUE(prepared.hasIntersection());
+}
+
+
+TEST(EmbreeShapeModel, PreparedIntersectionsOutOfOrder) {
+  QString dskfile("$base/testData/hay_a_amica_5_itokawashape_v1_0_64q.bds");
+  EmbreeTargetManager *manager = EmbreeTargetManager::getInstance();
+  EmbreeShapeModel prepared(NULL, dskfile, manager);
+  EmbreeShapeModel direct(NULL, dskfile, manager);
+
+  std::vector< std::vector<double> > observers;
+  std::vector< std::vector<double> > looks(21, std::vector<double>(3, 0.0));
+  for (int i = -10; i <= 10; i++) {
+    std::vector<double> observer(3, 0.0);
+    observer[0] = i * 0.02;
+    observer[2] = 1.0;
+    observers.push_back(observer);
+    looks[i + 10][2] = -1.0;
+  }
+  prepared.prepareIntersections(observers, looks);
+
+  // Intersect the prepared rays backwards, with a ray that was not prepared
+  // between each of them, like the neighbors traced for a local normal
+  std::vector<double> neighbor(3, 0.0);
+  neighbor[0] = 0.3;
+  neighbor[2] = 1.0;
+  for (int i = (int) observers.size() - 1; i >= 0; i--) {
+    bool expected = direct.intersectSurface(observers[i], looks[i]);
+    ASSERT_EQ(prepared.intersectSurface(observers[i], looks[i]), expected) << "Ray " << i;
+    if (expected) {
+      EXPECT_EQ(prepared.surfaceIntersection()->GetX().kilometers(),
+                direct.surfaceIntersection()->GetX().kilometers()) << "Ray " << i;
+      EXPECT_EQ(prepared.surfaceIntersection()->GetZ().kilometers(),
+                direct.surfaceIntersection()->GetZ().kilometers()) << "Ray " << i;
+    }
+
+    expected = direct.intersectSurface(neighbor, looks[i]);
+    EXPECT_EQ(prepared.intersectSurface(neighbor, looks[i]), expected) << "Ray " << i;
+  }
+}
+
+
+TEST(EmbreeShapeModel, PrepareIntersectionsSizeMismatch) {
+  QString dskfile("$base/testData/hay_a_amica_5_itokawashape_v1_0_64q.bds");
+  EmbreeShapeModel shape(NULL, dskfile, EmbreeTargetManager::getInstance());
+
+  std::vector< std::vector<double> > observers(2, std::vector<double>(3, 1.0));
+  std::vector< std::vector<double> > looks(1, std::vector<double>(3, -1.0));
+  EXPECT_THROW(shape.prepareIntersections(observers, looks), IException);
+}
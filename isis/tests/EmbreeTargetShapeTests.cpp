@@ -0,0 +1,64 @@
+#include <vector>
+
+#include <QDir>
+#include <QTemporaryDir>
+
+#include "EmbreeTargetShape.h"
+#include "Pvl.h"
+
+#include <gtest/gtest.h>
+
+using namespace Isis;
+
+/**
+ * Rays on a grid of observers one kilometer above the target looking down, so
+ * some of them miss the target.
+ */
+static std::vector< std::vector<double> > gridObservers() {
+  std::vector< std::vector<double> > observers;
+  for (int i = -10; i <= 10; i++) {
+    for (int j = -10; j <= 10; j++) {
+      std::vector<double> observer(3);
+      observer[0] = i * 0.05;
+      observer[1] = j * 0.05;
+      observer[2] = 1.0;
+      observers.push_back(observer);
+    }
+  }
+  return observers;
+}
+
+
+TEST(EmbreeTargetShapeTests, IntersectRaysMatchesIntersectRay) {
+  EmbreeTargetShape itokawaShape("$base/testData/hay_a_amica_5_itokawashape_v1_0_64q.bds");
+  std::vector< std::vector<double> > observers = gridObservers();
+  std::vector<double> look(3);
+  look[0] = 0.0;
+  look[1] = 0.0;
+  look[2] = -1.0;
+
+  std::vector<RTCMultiHitRay> rays;
+  for (size_t i = 0; i < observers.size(); i++) {
+    rays.push_back(RTCMultiHitRay(observers[i], look));
+  }
+  itokawaShape.intersectRays(rays);
+
+  int hits = 0;
+  for (size_t i = 0; i < observers.size(); i++) {
+    RTCMultiHitRay ray(observers[i], look);
+    itokawaShape.intersectRay(ray);
+    ASSERT_EQ(ray.lastHit, rays[i].lastHit) << "Ray " << i;
+    if (ray.lastHit >= 0) {
+      hits++;
+      RayHitInformation expected = itokawaShape.getHitInformation(ray, 0);
+      RayHitInformation actual = itokawaShape.getHitInformation(rays[i], 0);
+      EXPECT_EQ(expected.primID, actual.primID);
+      EXPECT_DOUBLE_EQ(expected.intersection[0], actual.intersection[0]);
+      EXPECT_DOUBLE_EQ(expected.intersection[1], actual.intersection[1]);
+      EXPECT_DOUBLE_EQ(expected.intersection[2], actual.intersection[2]);
+    }
+  }
+  EXPECT_GT(hits, 0);
+  EXPECT_LT(hits, (int) observers.size());
+}
+
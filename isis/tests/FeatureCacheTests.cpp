@@ -0,0 +1,186 @@
+#include <QByteArray>
+#include <QDataStream>
+#include <QDir>
+#include <QFile>
+#include <QString>
+#include <QStringList>
+
+#include <opencv2/opencv.hpp>
+
+#include "FeatureCache.h"
+#include "FeatureMatcherTypes.h"
+#include "Fixtures.h"
+#include "ImageSource.h"
+#include "MatchImage.h"
+#include "SobelTransform.h"
+
+#include "gmock/gmock.h"
+
+using namespace Isis;
+
+/**
+ * Creates an image with keypoints and descriptors that differ in every field.
+ */
+static MatchImage createImage(const QString &serial) {
+  MatchImage image(ImageSource(serial, cv::Mat::zeros(64, 64, CV_8UC1), serial));
+  Keypoints keypoints;
+  for (int i = 0; i < 25; i++) {
+    keypoints.push_back(cv::KeyPoint(1.5f + i, 60.25f - 2.0f * i, 7.0f + 0.125f * i,
+                                     (float) (i * 14 % 360), 0.001f * (i + 1), i % 4, i - 3));
+  }
+  image.keypoints() = keypoints;
+
+  Descriptors descriptors(25, 32, CV_8UC1);
+  cv::RNG rng(25);
+  rng.fill(descriptors, cv::RNG::UNIFORM, 0, 256);
+  image.setDescriptors(descriptors);
+  return image;
+}
+
+
+/**
+ * Returns the only cache file in a directory.
+ */
+static QString cacheFile(const QString &directory) {
+  QStringList files = QDir(directory).entryList(QStringList("*.features"), QDir::Files);
+  EXPECT_EQ(files.size(), 1);
+  return files.isEmpty() ? QString() : directory + "/" + files.first();
+}
+
+
+TEST_F(TempTestingFiles, FeatureCacheRoundTrip) {
+  FeatureCache cache(tempDir.path() + "/cache", "orb/orb");
+  ASSERT_TRUE(cache.isEnabled());
+  MatchImage stored = createImage("Image1");
+  ASSERT_TRUE(cache.store(stored));
+
+  MatchImage loaded = createImage("Image1");
+  loaded.keypoints().clear();
+  loaded.setDescriptors(Descriptors());
+  ASSERT_TRUE(cache.load(loaded));
+
+  ASSERT_EQ(loaded.keypoints().size(), stored.keypoints().size());
+  for (unsigned int i = 0; i < stored.keypoints().size(); i++) {
+    const cv::KeyPoint &expected = stored.keypoints()[i];
+    const cv::KeyPoint &actual = loaded.keypoints()[i];
+    EXPECT_EQ(actual.pt.x, expected.pt.x) << i;
+    EXPECT_EQ(actual.pt.y, expected.pt.y) << i;
+    EXPECT_EQ(actual.size, expected.size) << i;
+    EXPECT_EQ(actual.angle, expected.angle) << i;
+    EXPECT_EQ(actual.response, expected.response) << i;
+    EXPECT_EQ(actual.octave, expected.octave) << i;
+    EXPECT_EQ(actual.class_id, expected.class_id) << i;
+  }
+
+  ASSERT_EQ(loaded.descriptors().rows, stored.descriptors().rows);
+  ASSERT_EQ(loaded.descriptors().cols, stored.descriptors().cols);
+  ASSERT_EQ(loaded.descriptors().type(), stored.descriptors().type());
+  EXPECT_EQ(cv::countNonZero(loaded.descriptors() != stored.descriptors()), 0);
+
+  // A view into a larger matrix is stored as its own values
+  Descriptors wide(25, 64, CV_32FC1);
+  cv::RNG rng(64);
+  rng.fill(wide, cv::RNG::UNIFORM, -1.0, 1.0);
+  stored.setDescriptors(wide.colRange(16, 48));
+  ASSERT_TRUE(cache.store(stored));
+  ASSERT_TRUE(cache.load(loaded));
+  ASSERT_EQ(loaded.descriptors().type(), CV_32FC1);
+  EXPECT_EQ(cv::countNonZero(loaded.descriptors() != wide.colRange(16, 48)), 0);
+}
+
+
+TEST_F(TempTestingFiles, FeatureCacheKeyMismatch) {
+  QString directory = tempDir.path() + "/cache";
+  FeatureCache cache(directory, "orb@nfeatures:500/orb");
+  ASSERT_TRUE(cache.store(createImage("Image1")));
+
+  MatchImage loaded = createImage("Image1");
+  loaded.keypoints().clear();
+
+  // Other algorithm parameters
+  FeatureCache otherParameters(directory, "orb@nfeatures:1000/orb");
+  EXPECT_FALSE(otherParameters.load(loaded));
+
+  // Another image
+  MatchImage otherImage = createImage("Image2");
+  otherImage.keypoints().clear();
+  EXPECT_FALSE(cache.load(otherImage));
+
+  // The same image through a transform
+  MatchImage transformed = createImage("Image1");
+  transformed.keypoints().clear();
+  transformed.addTransform(new SobelTransform("SobelTransform"));
+  EXPECT_NE(cache.key(transformed), cache.key(loaded));
+  EXPECT_FALSE(cache.load(transformed));
+  EXPECT_TRUE(transformed.keypoints().empty());
+
+  EXPECT_TRUE(cache.load(loaded));
+  EXPECT_EQ(loaded.keypoints().size(), 25u);
+
+  // A file that holds another key is a miss, as after a hash collision
+  MatchImage image2 = createImage("Image2");
+  FeatureCache otherCache(tempDir.path() + "/other", "orb@nfeatures:500/orb");
+  ASSERT_TRUE(otherCache.store(image2));
+  QString collision = cacheFile(tempDir.path() + "/other");
+  QFile::remove(collision);
+  ASSERT_TRUE(QFile::copy(cacheFile(directory), collision));
+  image2.keypoints().clear();
+  EXPECT_FALSE(otherCache.load(image2));
+  EXPECT_TRUE(image2.keypoints().empty());
+}
+
+
+TEST_F(TempTestingFiles, FeatureCacheDamagedFiles) {
+  QString directory = tempDir.path() + "/cache";
+  FeatureCache cache(directory, "orb/orb");
+  MatchImage stored = createImage("Image1");
+  ASSERT_TRUE(cache.store(stored));
+  QString file = cacheFile(directory);
+
+  QFile original(file);
+  ASSERT_TRUE(original.open(QIODevice::ReadOnly));
+  QByteArray contents = original.readAll();
+  original.close();
+
+  // The keypoint count follows the magic number, version and key
+  int countOffset = 4 + 4 + 4 + 2 * cache.key(stored).size();
+
+  QList<QByteArray> damaged;
+  damaged.append(QByteArray());
+  damaged.append(contents.left(contents.size() / 2));
+  damaged.append(contents.left(contents.size() - 1));
+  damaged.append(QByteArray(contents.size(), 'x'));
+
+  // A huge keypoint count
+  QByteArray count = contents;
+  count[countOffset] = '\xff';
+  count[countOffset + 1] = '\xff';
+  count[countOffset + 2] = '\xff';
+  count[countOffset + 3] = '\x7f';
+  damaged.append(count);
+
+  // A descriptor type that does not match the descriptor bytes
+  QByteArray type = contents;
+  int typeOffset = contents.size() - 4 - 25 * 32 - 4;
+  type[typeOffset] = (char) CV_32FC1;
+  damaged.append(type);
+
+  for (int d = 0; d < damaged.size(); d++) {
+    QFile out(file);
+    ASSERT_TRUE(out.open(QIODevice::WriteOnly | QIODevice::Truncate));
+    out.write(damaged[d]);
+    out.close();
+
+    MatchImage loaded = createImage("Image1");
+    loaded.keypoints().clear();
+    loaded.setDescriptors(Descriptors());
+    EXPECT_FALSE(cache.load(loaded)) << "Damaged file " << d;
+    EXPECT_TRUE(loaded.keypoints().empty()) << "Damaged file " << d;
+    EXPECT_TRUE(loaded.descriptors().empty()) << "Damaged file " << d;
+  }
+
+  // Storing again replaces the damaged file
+  ASSERT_TRUE(cache.store(stored));
+  MatchImage loaded = createImage("Image1");
+  EXPECT_TRUE(cache.load(loaded));
+}
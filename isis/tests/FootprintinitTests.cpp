@@ -1,11 +1,15 @@
 #include <iostream>
 #include <QTemporaryFile>
 #include <QTemporaryDir>
+#include <QThreadPool>
 
 #include "footprintinit.h"
 
 #include "Cube.h"
+#include "FileList.h"
+#include "ImagePolygon.h"
 #include "Pvl.h"
+#include "Spice.h"
 #include "TestUtilities.h"
 #include "FileName.h"
 
@@ -24,3 +28,59 @@ TEST_F(DefaultCube, FunctionalTestFootprintinitDefault) {
   footprintinit(testCube, footprintUi);
   ASSERT_TRUE(testCube->label()->hasObject("Polygon"));
 }
+
+TEST_F(DefaultCube, FunctionalTestFootprintinitThreaded) {
+  // Make sure the boundary is split between threads even on a single core machine
+  int maxThreads = QThreadPool::globalInstance()->maxThreadCount();
+  QThreadPool::globalInstance()->setMaxThreadCount(qMax(maxThreads, 4));
+
+  ImagePolygon serialPoly;
+  serialPoly.Create(*testCube, 10, 10);
+
+  ImagePolygon threadedPoly;
+  threadedPoly.Threaded(true);
+  threadedPoly.Create(*testCube, 10, 10);
+
+  QThreadPool::globalInstance()->setMaxThreadCount(maxThreads);
+
+  EXPECT_TRUE(serialPoly.Polys()->equalsExact(threadedPoly.Polys()));
+
+  QVector<QString> footprintArgs = {"threaded=true"};
+  UserInterface footprintUi(APP_XML, footprintArgs);
+
+  footprintinit(testCube, footprintUi);
+  ASSERT_TRUE(testCube->label()->hasObject("Polygon"));
+}
+
+TEST_F(DefaultCube, FunctionalTestFootprintinitFromList) {
+  QString cubeFileName = testCube->fileName();
+  testCube->close();
+
+  // The second cube is footprinted with the setup left from the first one
+  QString copyFileName = tempDir.path() + "/copy.cub";
+  ASSERT_TRUE(QFile::copy(cubeFileName, copyFileName));
+
+  FileList cubes;
+  cubes.append(cubeFileName);
+  cubes.append(copyFileName);
+  QString cubeListPath = tempDir.path() + "/cubes.lis";
+  cubes.write(cubeListPath);
+
+  QVector<QString> footprintArgs = {"fromlist=" + cubeListPath};
+  UserInterface footprintUi(APP_XML, footprintArgs);
+
+  footprintinit(footprintUi);
+
+  EXPECT_EQ(Spice::maximumResidentKernels(), 0);
+
+  Cube cube(cubeFileName);
+  ASSERT_TRUE(cube.label()->hasObject("Polygon"));
+  Cube copy(copyFileName);
+  ASSERT_TRUE(copy.label()->hasObject("Polygon"));
+
+  ImagePolygon poly;
+  cube.read(poly);
+  ImagePolygon copyPoly;
+  copy.read(copyPoly);
+  EXPECT_TRUE(poly.Polys()->equalsExact(copyPoly.Polys()));
+}
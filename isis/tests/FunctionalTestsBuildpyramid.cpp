@@ -0,0 +1,161 @@
+#include <QList>
+
+#include "buildpyramid.h"
+
+#include "Brick.h"
+#include "Fixtures.h"
+#include "IException.h"
+#include "LineManager.h"
+#include "PvlGroup.h"
+#include "SpecialPixel.h"
+#include "TestUtilities.h"
+
+#include "gmock/gmock.h"
+
+using namespace Isis;
+
+static QString APP_XML = FileName("$ISISROOT/bin/xml/buildpyramid.xml").expanded();
+
+/**
+ * Compares an overview of the cube with the averages of the valid cube pixels
+ * under each overview pixel.
+ */
+static void compareOverview(Cube &cube, int level) {
+  int samples = (cube.sampleCount() + level - 1) / level;
+  int lines = (cube.lineCount() + level - 1) / level;
+
+  for (int band = 1; band <= cube.bandCount(); band++) {
+    Brick full(cube.sampleCount(), cube.lineCount(), 1, cube.pixelType());
+    full.SetBasePosition(1, 1, band);
+    cube.read(full);
+
+    Brick overview(samples, lines, 1, cube.pixelType());
+    overview.SetBasePosition(1, 1, band);
+    cube.read(overview, level);
+
+    for (int line = 0; line < lines; line++) {
+      for (int sample = 0; sample < samples; sample++) {
+        double sum = 0.0;
+        int count = 0;
+        for (int l = line * level; l < (line + 1) * level && l < cube.lineCount(); l++) {
+          for (int s = sample * level; s < (sample + 1) * level && s < cube.sampleCount(); s++) {
+            double pixel = full[l * cube.sampleCount() + s];
+            if (!IsSpecial(pixel)) {
+              sum += pixel;
+              count++;
+            }
+          }
+        }
+
+        double actual = overview[line * samples + sample];
+        if (count == 0) {
+          EXPECT_EQ(actual, Isis::Null);
+        }
+        else {
+          EXPECT_FLOAT_EQ(actual, sum / count) << "Level " << level << " sample "
+              << sample + 1 << " line " << line + 1 << " band " << band;
+        }
+      }
+    }
+  }
+}
+
+
+TEST_F(SmallCube, FunctionalTestBuildpyramidLevels) {
+  LineManager line(*testCube);
+  line.SetLine(1, 1);
+  testCube->read(line);
+  line[0] = Isis::Null;
+  testCube->write(line);
+
+  QVector<QString> args = {"minsize=2"};
+  UserInterface options(APP_XML, args);
+  Pvl appLog;
+  buildpyramid(testCube, options, &appLog);
+
+  PvlGroup results = appLog.findGroup("Results");
+  EXPECT_EQ(results.findKeyword("Levels").size(), 3);
+
+  QList<int> expectedLevels;
+  expectedLevels << 2 << 4 << 8;
+  EXPECT_EQ(testCube->overviewLevels(), expectedLevels);
+
+  compareOverview(*testCube, 2);
+  compareOverview(*testCube, 4);
+  compareOverview(*testCube, 8);
+
+  // Level 1 is the cube itself
+  Brick expected(10, 10, 1, testCube->pixelType());
+  Brick actual(10, 10, 1, testCube->pixelType());
+  expected.SetBasePosition(1, 1, 3);
+  actual.SetBasePosition(1, 1, 3);
+  testCube->read(expected);
+  testCube->read(actual, 1);
+  for (int i = 0; i < expected.size(); i++) {
+    EXPECT_EQ(expected[i], actual[i]);
+  }
+
+  Brick missing(2, 2, 1, testCube->pixelType());
+  missing.SetBasePosition(1, 1, 1);
+  EXPECT_THROW(testCube->read(missing, 3), IException);
+}
+
+
+TEST_F(SmallCube, FunctionalTestBuildpyramidRebuild) {
+  QString cubeFile = testCube->fileName();
+  testCube->close();
+
+  QVector<QString> args = {"from=" + cubeFile, "minsize=2"};
+  UserInterface options(APP_XML, args);
+  Pvl appLog;
+  buildpyramid(options, &appLog);
+
+  // A larger minimum size drops the smaller levels
+  QVector<QString> rebuildArgs = {"from=" + cubeFile, "minsize=4"};
+  UserInterface rebuildOptions(APP_XML, rebuildArgs);
+  buildpyramid(rebuildOptions, &appLog);
+
+  Cube cube(FileName(cubeFile), "r");
+  QList<int> expectedLevels;
+  expectedLevels << 2 << 4;
+  EXPECT_EQ(cube.overviewLevels(), expectedLevels);
+  compareOverview(cube, 2);
+  compareOverview(cube, 4);
+}
+
+
+TEST_F(SmallCube, FunctionalTestBuildpyramidStale) {
+  QVector<QString> args = {"minsize=2"};
+  UserInterface options(APP_XML, args);
+  Pvl appLog;
+  buildpyramid(testCube, options, &appLog);
+  ASSERT_EQ(testCube->overviewLevels().size(), 3);
+
+  LineManager line(*testCube);
+  line.SetLine(3, 2);
+  testCube->read(line);
+  for (int i = 0; i < line.size(); i++) {
+    line[i] = -line[i];
+  }
+  testCube->write(line);
+  EXPECT_TRUE(testCube->overviewLevels().isEmpty());
+
+  QString cubeFile = testCube->fileName();
+  testCube->close();
+  testCube->open(cubeFile, "rw");
+  EXPECT_TRUE(testCube->overviewLevels().isEmpty());
+
+  // Building again makes them current, over the same tiles
+  int overviewObjects = 0;
+  buildpyramid(testCube, options, &appLog);
+  for (int i = 0; i < testCube->label()->objects(); i++) {
+    if (testCube->label()->object(i).isNamed("Overview")) {
+      overviewObjects++;
+    }
+  }
+  EXPECT_EQ(overviewObjects, 3);
+  EXPECT_EQ(testCube->overviewLevels().size(), 3);
+  compareOverview(*testCube, 2);
+  compareOverview(*testCube, 4);
+  compareOverview(*testCube, 8);
+}
@@ -0,0 +1,161 @@
+#include <cmath>
+
+#include <QString>
+#include <QVector>
+
+#include "Constants.h"
+#include "Cube.h"
+#include "CubeAttribute.h"
+#include "FileName.h"
+#include "Fixtures.h"
+#include "Interpolator.h"
+#include "LineManager.h"
+#include "ProcessRubberSheet.h"
+#include "Pvl.h"
+#include "PvlGroup.h"
+#include "PvlKeyword.h"
+#include "SpecialPixel.h"
+#include "TProjection.h"
+#include "map2map.h"
+
+#include "gmock/gmock.h"
+
+using namespace Isis;
+
+static QString APP_XML = FileName("$ISISROOT/bin/xml/map2map.xml").expanded();
+
+/**
+ * The map2map transform with the separable resampling turned off, so every
+ * output pixel goes through the quad tree.
+ */
+class QuadTreeMap2map : public map2mapReverse {
+  public:
+    QuadTreeMap2map(const int inputSamples, const int inputLines, TProjection *inmap,
+                    const int outputSamples, const int outputLines, TProjection *outmap) :
+        map2mapReverse(inputSamples, inputLines, inmap, outputSamples, outputLines, outmap,
+                       false) {
+    }
+
+    bool IsSeparable() const {
+      return false;
+    }
+};
+
+
+/**
+ * Returns an Equirectangular mapping group for Mars covering 10S to 10N and
+ * 0 to 20 degrees longitude.
+ */
+static PvlGroup equirectangularMapping(double scale) {
+  double radius = 3396190.0;
+  double resolution = radius * PI / 180.0 / scale;
+
+  PvlGroup mapping("Mapping");
+  mapping += PvlKeyword("ProjectionName", "Equirectangular");
+  mapping += PvlKeyword("CenterLongitude", "0.0", "degrees");
+  mapping += PvlKeyword("CenterLatitude", "0.0", "degrees");
+  mapping += PvlKeyword("TargetName", "Mars");
+  mapping += PvlKeyword("EquatorialRadius", toString(radius), "meters");
+  mapping += PvlKeyword("PolarRadius", "3376200.0", "meters");
+  mapping += PvlKeyword("LatitudeType", "Planetocentric");
+  mapping += PvlKeyword("LongitudeDirection", "PositiveEast");
+  mapping += PvlKeyword("LongitudeDomain", "360", "degrees");
+  mapping += PvlKeyword("MinimumLatitude", "-10.0", "degrees");
+  mapping += PvlKeyword("MaximumLatitude", "10.0", "degrees");
+  mapping += PvlKeyword("MinimumLongitude", "0.0", "degrees");
+  mapping += PvlKeyword("MaximumLongitude", "20.0", "degrees");
+  mapping += PvlKeyword("UpperLeftCornerX", "0.0", "meters");
+  mapping += PvlKeyword("UpperLeftCornerY", toString(10.0 * scale * resolution), "meters");
+  mapping += PvlKeyword("PixelResolution", toString(resolution), "meters/pixel");
+  mapping += PvlKeyword("Scale", toString(scale), "pixels/degree");
+  return mapping;
+}
+
+
+/**
+ * Runs map2map on an Equirectangular cube and compares the output to the
+ * same warp done through the quad tree.
+ */
+static void compareToQuadTree(QString outputDir, PvlGroup userMapping, QString interp) {
+  QString inputFile = outputDir + "/input.cub";
+  Cube input;
+  input.setDimensions(80, 80, 1);
+  input.setPixelType(Real);
+  input.create(inputFile);
+  input.putGroup(equirectangularMapping(4.0));
+  LineManager line(input);
+  for (line.begin(); !line.end(); line++) {
+    for (int i = 0; i < line.size(); i++) {
+      line[i] = 100.0 * sin(0.13 * (i + 1)) + 50.0 * cos(0.07 * line.Line());
+    }
+    input.write(line);
+  }
+  input.close();
+
+  QString mapFile = outputDir + "/map.map";
+  Pvl userMap;
+  userMap.addGroup(userMapping);
+  userMap.write(mapFile);
+
+  QVector<QString> args = {"from=" + inputFile, "map=" + mapFile,
+                           "to=" + outputDir + "/map2map.cub", "pixres=map",
+                           "defaultrange=from", "interp=" + interp};
+  UserInterface ui(APP_XML, args);
+  Pvl log;
+  map2map(ui, &log);
+
+  Cube actual(outputDir + "/map2map.cub");
+  Cube inCube(inputFile);
+  TProjection *inproj = (TProjection *) inCube.projection();
+  TProjection *outproj = (TProjection *) actual.projection();
+
+  map2mapReverse separable(inCube.sampleCount(), inCube.lineCount(), inproj,
+                           actual.sampleCount(), actual.lineCount(), outproj, false);
+  ASSERT_TRUE(separable.IsSeparable());
+
+  // A two pixel tile size makes ProcessRubberSheet transform every pixel
+  ProcessRubberSheet slow(2, 2);
+  slow.SetInputCube(&inCube);
+  CubeAttributeOutput att;
+  Cube *expected = slow.SetOutputCube(outputDir + "/quadtree.cub", att, actual.sampleCount(),
+                                      actual.lineCount(), actual.bandCount());
+  QuadTreeMap2map quadTree(inCube.sampleCount(), inCube.lineCount(), inproj,
+                           actual.sampleCount(), actual.lineCount(), outproj);
+  Interpolator interpolator((interp == "BILINEAR") ? Interpolator::BiLinearType :
+                                                     Interpolator::NearestNeighborType);
+  slow.StartProcess(quadTree, interpolator);
+
+  LineManager expectedLine(*expected);
+  LineManager actualLine(actual);
+  int valid = 0;
+  for (expectedLine.begin(), actualLine.begin(); !expectedLine.end();
+       expectedLine++, actualLine++) {
+    expected->read(expectedLine);
+    actual.read(actualLine);
+    for (int i = 0; i < expectedLine.size(); i++) {
+      ASSERT_EQ(expectedLine[i], actualLine[i]) << "Sample " << i + 1 << " line "
+          << expectedLine.Line();
+      if (!IsSpecial(actualLine[i])) {
+        valid++;
+      }
+    }
+  }
+  EXPECT_GT(valid, 0);
+
+  slow.Finalize();
+}
+
+
+TEST_F(TempTestingFiles, FunctionalTestMap2mapSeparableResolution) {
+  compareToQuadTree(tempDir.path(), equirectangularMapping(6.0), "BILINEAR");
+}
+
+
+TEST_F(TempTestingFiles, FunctionalTestMap2mapSeparableLongitudeDirection) {
+  PvlGroup userMapping = equirectangularMapping(3.0);
+  userMapping["LongitudeDirection"] = "PositiveWest";
+  userMapping["LongitudeDomain"] = "180";
+  userMapping.deleteKeyword("MinimumLongitude");
+  userMapping.deleteKeyword("MaximumLongitude");
+  compareToQuadTree(tempDir.path(), userMapping, "NEARESTNEIGHBOR");
+}
@@ -267,6 +267,40 @@ TEST_F(DefaultCube, FunctionalTestMapptImageCoordList) {
 
 }
 
+TEST_F(DefaultCube, FunctionalTestMapptProjectionCoordList) {
+  std::ofstream of;
+  of.open(tempDir.path().toStdString()+"/coords.txt");
+  of << "50000, 550000\n150000, 450000\n 250000, 350000";
+  of.close();
+
+  QVector<QString> args = {"coordlist="+tempDir.path()+"/coords.txt",
+                           "UseCoordList=True",
+                           "append=false",
+                           "type=projection"};
+  UserInterface options(APP_XML, args);
+  Pvl appLog;
+  mappt(projTestCube, options, &appLog);
+  ASSERT_EQ(appLog.groups(), 3);
+
+  // The whole list is inverted at once, so compare it to one point at a time
+  QString coords[3][2] = {{"50000", "550000"}, {"150000", "450000"}, {"250000", "350000"}};
+  for (int i = 0; i < 3; i++) {
+    QVector<QString> pointArgs = {"append=false", "type=projection",
+                                  "x=" + coords[i][0], "y=" + coords[i][1]};
+    UserInterface pointOptions(APP_XML, pointArgs);
+    Pvl pointLog;
+    mappt(projTestCube, pointOptions, &pointLog);
+
+    PvlGroup expected = pointLog.findGroup("Results");
+    PvlGroup actual = appLog.group(i);
+    ASSERT_EQ(actual.keywords(), expected.keywords());
+    for (int k = 0; k < expected.keywords(); k++) {
+      EXPECT_PRED_FORMAT2(AssertQStringsEqual, actual[k].name(), expected[k].name());
+      EXPECT_PRED_FORMAT2(AssertQStringsEqual, actual[k][0], expected[k][0]);
+    }
+  }
+}
+
 TEST_F(DefaultCube, FunctionalTestMapptCoordListFlatFile) {
   std::ofstream of;
   of.open(tempDir.path().toStdString()+"/coords.txt");
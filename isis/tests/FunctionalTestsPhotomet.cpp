@@ -0,0 +1,197 @@
+#include <cmath>
+
+#include <QString>
+#include <QVector>
+
+#include "Cube.h"
+#include "FileName.h"
+#include "Fixtures.h"
+#include "LineManager.h"
+#include "Photometry.h"
+#include "Pvl.h"
+#include "PvlGroup.h"
+#include "PvlKeyword.h"
+#include "PvlObject.h"
+#include "SpecialPixel.h"
+#include "photomet.h"
+
+#include "gmock/gmock.h"
+
+using namespace Isis;
+
+static QString APP_XML = FileName("$ISISROOT/bin/xml/photomet.xml").expanded();
+
+static const int s_size = 40;
+
+
+/**
+ * Creates a cube with one band whose pixels are given by a function of the
+ * sample and line.
+ */
+static void createCube(QString fileName, double (*value)(int sample, int line)) {
+  Cube cube;
+  cube.setDimensions(s_size, s_size, 1);
+  cube.setPixelType(Real);
+  cube.create(fileName);
+
+  PvlGroup bandBin("BandBin");
+  bandBin += PvlKeyword("Center", "0.75", "micrometers");
+  cube.putGroup(bandBin);
+
+  LineManager line(cube);
+  for (line.begin(); !line.end(); line++) {
+    for (int i = 0; i < line.size(); i++) {
+      line[i] = value(i + 1, line.Line());
+    }
+    cube.write(line);
+  }
+  cube.close();
+}
+
+
+static double dnValue(int sample, int line) {
+  if (sample == 3 && line == 4) {
+    return Null;
+  }
+  if (sample == 5 && line == 6) {
+    return Lrs;
+  }
+  return 0.05 + 0.001 * ((sample * 7 + line * 3) % 50);
+}
+
+
+static double incidenceValue(int sample, int line) {
+  // The last lines are past the terminator
+  return 2.5 * (line - 1);
+}
+
+
+static double emissionValue(int sample, int line) {
+  // The last samples are beyond the largest emission allowed
+  return 2.0 * (sample - 1);
+}
+
+
+static double phaseValue(int sample, int line) {
+  if (sample == 8 && line == 9) {
+    return Null;
+  }
+  double incidence = incidenceValue(sample, line);
+  double emission = emissionValue(sample, line);
+  return fabs(incidence - emission) +
+         (incidence + emission - fabs(incidence - emission)) * ((sample * line) % 11) / 11.0;
+}
+
+
+/**
+ * Runs photomet with backplanes and compares the output to correcting each
+ * pixel in turn with the models photomet logged.
+ */
+static void compareToSerial(QString outputDir, bool tabulate) {
+  QString inputFile = outputDir + "/input.cub";
+  QString phaseFile = outputDir + "/phase.cub";
+  QString incidenceFile = outputDir + "/incidence.cub";
+  QString emissionFile = outputDir + "/emission.cub";
+  QString outputFile = outputDir + "/photomet.cub";
+  createCube(inputFile, dnValue);
+  createCube(phaseFile, phaseValue);
+  createCube(incidenceFile, incidenceValue);
+  createCube(emissionFile, emissionValue);
+
+  QVector<QString> args = {"from=" + inputFile, "to=" + outputFile,
+                           "anglesource=backplane", "phase_angle_file=" + phaseFile,
+                           "incidence_angle_file=" + incidenceFile,
+                           "emission_angle_file=" + emissionFile,
+                           "maxemission=70.0", "maxincidence=85.0",
+                           "phtname=hapkehen", "theta=30.0", "wh=0.52", "hg1=0.213",
+                           "hg2=1.0", "hh=0.06", "b0=0.8", "zerob0standard=false",
+                           "normname=albedo", "incref=30.0", "albedo=0.0690507",
+                           "thresh=30.0"};
+  if (tabulate) {
+    args.append("tabletolerance=1.0e-4");
+  }
+  UserInterface ui(APP_XML, args);
+  Pvl log;
+  photomet(ui, &log);
+
+  // The same models, created from what was logged
+  PvlGroup normalization = log.findGroup("NormalizationModelParametersUsed");
+  normalization.setName("Algorithm");
+  normalization += PvlKeyword("Wl", "0.75");
+  PvlGroup photometric = log.findGroup("PhotometricModelParametersUsed");
+  photometric.setName("Algorithm");
+
+  Pvl parameters;
+  PvlObject normalizationModel("NormalizationModel");
+  normalizationModel.addGroup(normalization);
+  parameters.addObject(normalizationModel);
+  PvlObject photometricModel("PhotometricModel");
+  photometricModel.addGroup(photometric);
+  parameters.addObject(photometricModel);
+
+  Photometry serial(parameters);
+  serial.SetPhotomWl(0.75);
+  if (tabulate) {
+    serial.GenerateTables(1.0e-4);
+    ASSERT_TRUE(log.hasGroup("PhotometricTables"));
+    EXPECT_TRUE(log.findGroup("PhotometricTables").hasKeyword("PhotometricModelStep"));
+  }
+  else {
+    EXPECT_FALSE(log.hasGroup("PhotometricTables"));
+  }
+
+  Cube output(outputFile);
+  LineManager outputLine(output);
+  int valid = 0;
+  int nulls = 0;
+  for (outputLine.begin(); !outputLine.end(); outputLine++) {
+    output.read(outputLine);
+    int line = outputLine.Line();
+    for (int i = 0; i < outputLine.size(); i++) {
+      int sample = i + 1;
+      double dn = dnValue(sample, line);
+      double phase = phaseValue(sample, line);
+      double incidence = incidenceValue(sample, line);
+      double emission = emissionValue(sample, line);
+
+      // Special pixels are copied and pixels with invalid angles are nulled
+      double expected;
+      if (IsSpecial(dn)) {
+        expected = dn;
+      }
+      else if (IsSpecial(phase) || incidence >= 90.0 || emission >= 90.0 ||
+               incidence > 85.0 || emission > 70.0) {
+        expected = Null;
+      }
+      else {
+        double mult, base;
+        serial.Compute(phase, incidence, emission, incidence, emission, dn, expected,
+                       mult, base);
+      }
+
+      if (IsSpecial(expected)) {
+        ASSERT_EQ(outputLine[i], expected) << "Sample " << sample << " line " << line;
+        if (expected == Null) {
+          nulls++;
+        }
+      }
+      else {
+        // The output cube holds single precision pixels
+        ASSERT_FLOAT_EQ(outputLine[i], expected) << "Sample " << sample << " line " << line;
+        valid++;
+      }
+    }
+  }
+  EXPECT_GT(valid, 0);
+  EXPECT_GT(nulls, 0);
+}
+
+
+TEST_F(TempTestingFiles, FunctionalTestPhotometBackplane) {
+  compareToSerial(tempDir.path(), false);
+}
+
+
+TEST_F(TempTestingFiles, FunctionalTestPhotometBackplaneTables) {
+  compareToSerial(tempDir.path(), true);
+}
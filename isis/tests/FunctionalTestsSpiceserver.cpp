@@ -1,9 +1,15 @@
+#include <thread>
+
 #include <QTextStream>
 #include <QStringList>
 #include <QTemporaryFile>
 #include <QByteArray>
+#include <QCoreApplication>
 #include <QFile>
+#include <QLocalSocket>
+#include <QThread>
 #include <QVector>
+#include <QDir>
 #include <QDomDocument>
 
 #include "spiceserver.h"
@@ -19,6 +25,49 @@ using namespace Isis;
 
 static QString APP_XML = FileName("$ISISROOT/bin/xml/spiceserver.xml").expanded();
 
+/**
+ * The local server needs an event loop, which needs an application.
+ */
+static void ensureApplication() {
+  if (!QCoreApplication::instance()) {
+    static int argc = 1;
+    static char name[] = "runISISTests";
+    static char *argv[] = {name, NULL};
+    new QCoreApplication(argc, argv);
+  }
+}
+
+
+/**
+ * Sends a request to a local spiceserver the same way spiceinit does and
+ * returns the response.
+ */
+static QByteArray sendLocalRequest(QString socketName, QByteArray request) {
+  QLocalSocket socket;
+
+  // The server may still be starting
+  for (int attempt = 0; attempt < 50; attempt++) {
+    socket.connectToServer(socketName);
+    if ( socket.waitForConnected(1000) ) {
+      break;
+    }
+    QThread::msleep(100);
+  }
+  if (socket.state() != QLocalSocket::ConnectedState) {
+    return QByteArray();
+  }
+
+  socket.write(request.trimmed() + "\n");
+  socket.waitForBytesWritten(30000);
+
+  QByteArray response;
+  while ( socket.waitForReadyRead(60000) ) {
+    response += socket.readAll();
+  }
+  response += socket.readAll();
+  return response;
+}
+
 class TestPayload : public DefaultCube {
     protected:
       
@@ -178,3 +227,111 @@ TEST_F(TempTestingFiles, FunctionalTestSpiceserverIsisVersion) {
     }
   }, IException);
 } 
+
+
+TEST_F(TestPayload, FunctionalTestSpiceserverLocalSocket) {
+  ensureApplication();
+  QString socketName = tempDir.path() + "/spiceserver.socket";
+
+  QVector<QString> args = {"SOCKET=" + socketName, "IDLETIMEOUT=2",
+                           "TEMPFILE=" + tempDir.path() + "/temp.cub"};
+  UserInterface options(APP_XML, args);
+  std::thread server([&options]() {
+    spiceserver(options);
+  });
+
+  QFile hexFile(hexPayloadPath);
+  ASSERT_TRUE( hexFile.open(QIODevice::ReadOnly) );
+  QByteArray request = hexFile.readAll();
+  hexFile.close();
+
+  // The second request uses the kernels the first one left loaded
+  QByteArray first = sendLocalRequest(socketName, request);
+  QByteArray second = sendLocalRequest(socketName, request);
+  server.join();
+
+  ASSERT_FALSE(first.isEmpty());
+  EXPECT_EQ(first, second);
+
+  QString xml( QByteArray::fromHex(first).constData() );
+  QDomDocument document;
+  ASSERT_TRUE( document.setContent(xml) );
+
+  Pvl kernelsLabel;
+  QDomElement rootElement = document.firstChild().toElement();
+  for ( QDomNode node = rootElement.firstChild(); !node.isNull(); node = node.nextSibling() ) {
+    QDomElement element = node.toElement();
+    if (element.tagName() == "kernels_label") {
+      QString encoded = element.firstChild().toText().data();
+      std::stringstream labStream;
+      labStream << QString( QByteArray::fromHex( encoded.toLatin1() ).constData() );
+      labStream >> kernelsLabel;
+    }
+  }
+
+  PvlGroup naifKeywords = kernelsLabel.group(0);
+  EXPECT_EQ((int)naifKeywords.findKeyword("NaifFrameCode"), -27002);
+  EXPECT_PRED_FORMAT2(AssertQStringsEqual, naifKeywords.findKeyword("InstrumentPointing")[0], "Table");
+
+  // The temporary files for each request are cleaned up
+  QStringList leftovers = QDir( tempDir.path() ).entryList(QStringList() << "temp*");
+  EXPECT_TRUE(leftovers.isEmpty()) << leftovers.join(", ").toStdString();
+}
+
+
+TEST_F(TestPayload, FunctionalTestSpiceserverLocalSocketDifferentKernels) {
+  ensureApplication();
+  QString socketName = tempDir.path() + "/spiceserver.socket";
+
+  QFile asciiFile(asciiPayloadPath);
+  ASSERT_TRUE( asciiFile.open(QIODevice::ReadOnly) );
+  QByteArray asciiPayload = asciiFile.readAll();
+  asciiFile.close();
+
+  // The second request uses nadir pointing instead of the reconstructed CK
+  QByteArray reconRequest = asciiPayload.toHex();
+  QByteArray nadirPayload = asciiPayload;
+  nadirPayload.replace("<ckrecon value='yes' />", "<ckrecon value='no' />");
+  nadirPayload.replace("<cknadir value='no' />", "<cknadir value='yes' />");
+  QByteArray nadirRequest = nadirPayload.toHex();
+
+  // Answer each request on its own, without resident kernels
+  QByteArray expected[2];
+  QByteArray requests[2] = {reconRequest, nadirRequest};
+  for (int i = 0; i < 2; i++) {
+    QString requestFile = tempDir.path() + QString("/request%1.txt").arg(i);
+    QString responseFile = tempDir.path() + QString("/response%1.txt").arg(i);
+    QFile file(requestFile);
+    ASSERT_TRUE( file.open(QIODevice::WriteOnly) );
+    file.write(requests[i]);
+    file.close();
+
+    QVector<QString> args = {"From=" + requestFile, "To=" + responseFile,
+                             "TEMPFILE=" + tempDir.path() + "/temp.cub"};
+    UserInterface options(APP_XML, args);
+    spiceserver(options);
+
+    QFile response(responseFile);
+    ASSERT_TRUE( response.open(QIODevice::ReadOnly) );
+    expected[i] = response.readAll().trimmed();
+  }
+  ASSERT_NE(expected[0], expected[1]);
+
+  QVector<QString> args = {"SOCKET=" + socketName, "IDLETIMEOUT=2", "MAXKERNELS=1",
+                           "TEMPFILE=" + tempDir.path() + "/temp.cub"};
+  UserInterface options(APP_XML, args);
+  std::thread server([&options]() {
+    spiceserver(options);
+  });
+
+  // Kernels left loaded by one request must not change the answer to the other, even when
+  //   a request needs more kernels than MAXKERNELS
+  QByteArray first = sendLocalRequest(socketName, reconRequest);
+  QByteArray second = sendLocalRequest(socketName, nadirRequest);
+  QByteArray third = sendLocalRequest(socketName, reconRequest);
+  server.join();
+
+  EXPECT_EQ(first.trimmed(), expected[0]);
+  EXPECT_EQ(second.trimmed(), expected[1]);
+  EXPECT_EQ(third.trimmed(), expected[0]);
+}
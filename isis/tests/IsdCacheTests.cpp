@@ -0,0 +1,108 @@
+#include <QFile>
+#include <QString>
+
+#include <nlohmann/json.hpp>
+
+#include "Fixtures.h"
+#include "IsdCache.h"
+#include "Preference.h"
+#include "Pvl.h"
+#include "PvlGroup.h"
+#include "PvlKeyword.h"
+
+#include "gmock/gmock.h"
+
+using json = nlohmann::json;
+using namespace Isis;
+
+TEST_F(TempTestingFiles, IsdCacheRoundTrip) {
+  json isd;
+  isd["name_model"] = "USGS_ASTRO_LINE_SCANNER_SENSOR_MODEL";
+  isd["instrument_position"]["ephemeris_times"] = {1.5, 2.5, 3.5};
+  isd["instrument_position"]["positions"] = {{1.0, 2.0, 3.0}, {4.0, 5.0, 6.0}, {7.0, 8.0, 9.0}};
+  isd["naif_keywords"]["BODY499_RADII"] = {3396.19, 3396.19, 3376.2};
+
+  QString fileName = tempDir.path() + "/cache/test.isd";
+  ASSERT_TRUE(IsdCache::write(fileName, isd));
+
+  json cached;
+  ASSERT_TRUE(IsdCache::read(fileName, cached));
+  EXPECT_EQ(cached, isd);
+
+  // The binary form is smaller than the text form
+  EXPECT_LT(QFile(fileName).size(), (qint64) isd.dump().size());
+}
+
+
+TEST_F(TempTestingFiles, IsdCacheUnreadable) {
+  json isd;
+  EXPECT_FALSE(IsdCache::read(tempDir.path() + "/missing.isd", isd));
+
+  QString fileName = tempDir.path() + "/corrupt.isd";
+  QFile file(fileName);
+  ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+  file.write("\xbf\x61", 2);
+  file.close();
+  EXPECT_FALSE(IsdCache::read(fileName, isd));
+}
+
+
+TEST(IsdCache, CacheFileName) {
+  Pvl label;
+  PvlGroup kernels("Kernels");
+  kernels += PvlKeyword("InstrumentPointing", "ck1.bc");
+  label.addGroup(kernels);
+
+  QString first = IsdCache::cacheFileName("/cache", label);
+  EXPECT_TRUE(first.startsWith("/cache/"));
+  EXPECT_TRUE(first.endsWith(".isd"));
+  EXPECT_EQ(IsdCache::cacheFileName("/cache", label), first);
+
+  label.findGroup("Kernels")["InstrumentPointing"] = "ck2.bc";
+  EXPECT_NE(IsdCache::cacheFileName("/cache", label), first);
+}
+
+
+TEST_F(TempTestingFiles, IsdCacheFileNameKernelChanged) {
+  QString kernelFile = tempDir.path() + "/kernel.bc";
+  QFile kernel(kernelFile);
+  ASSERT_TRUE(kernel.open(QIODevice::WriteOnly));
+  kernel.write("first");
+  kernel.close();
+
+  Pvl label;
+  PvlGroup kernels("Kernels");
+  kernels += PvlKeyword("InstrumentPointing", kernelFile);
+  label.addGroup(kernels);
+
+  QString first = IsdCache::cacheFileName("/cache", label);
+
+  // Rewriting the kernel in place changes its size
+  ASSERT_TRUE(kernel.open(QIODevice::WriteOnly | QIODevice::Truncate));
+  kernel.write("second version");
+  kernel.close();
+  EXPECT_NE(IsdCache::cacheFileName("/cache", label), first);
+}
+
+
+TEST(IsdCache, DisabledByDefault) {
+  PvlGroup &performance = Preference::Preferences().findGroup("Performance");
+  bool hadPreference = performance.hasKeyword("IsdCache");
+  PvlKeyword original = hadPreference ? performance["IsdCache"] : PvlKeyword("IsdCache");
+
+  performance.addKeyword(PvlKeyword("IsdCache", "Off"), Pvl::Replace);
+  EXPECT_TRUE(IsdCache::directory().isEmpty());
+
+  performance.deleteKeyword("IsdCache");
+  EXPECT_TRUE(IsdCache::directory().isEmpty());
+
+  performance.addKeyword(PvlKeyword("IsdCache", "/tmp/isdcache"), Pvl::Replace);
+  EXPECT_EQ(IsdCache::directory(), "/tmp/isdcache");
+
+  if (hadPreference) {
+    performance.addKeyword(original, Pvl::Replace);
+  }
+  else {
+    performance.deleteKeyword("IsdCache");
+  }
+}
@@ -0,0 +1,201 @@
+#include <algorithm>
+#include <cmath>
+
+#include <SpiceUsr.h>
+
+#include "Constants.h"
+#include "IException.h"
+#include "NaifMath.h"
+
+#include "gmock/gmock.h"
+
+using namespace Isis;
+
+/**
+ * Turns auditing on for a test so every result is checked against CSPICE.
+ */
+class NaifMathAudit : public ::testing::Test {
+  protected:
+    void SetUp() override {
+      NaifMath::setAuditing(true);
+    }
+
+    void TearDown() override {
+      NaifMath::setAuditing(false);
+    }
+};
+
+
+TEST_F(NaifMathAudit, Rotations) {
+  double axes[][3] = {{0.0, 0.0, 1.0}, {1.0, 2.0, 3.0}, {-0.5, 0.25, -4.0}, {0.0, 0.0, 0.0}};
+  double angles[] = {0.0, 1.0e-9, 0.3, -1.2, PI / 2.0, PI - 1.0e-6, PI, 2.5 * PI};
+
+  for (int i = 0; i < 4; i++) {
+    for (int j = 0; j < 8; j++) {
+      double r[3][3];
+      ASSERT_NO_THROW(NaifMath::axisar(axes[i], angles[j], r)) << i << " " << j;
+
+      double q[4];
+      ASSERT_NO_THROW(NaifMath::m2q(r, q)) << i << " " << j;
+      double fromQuaternion[3][3];
+      ASSERT_NO_THROW(NaifMath::q2m(q, fromQuaternion)) << i << " " << j;
+
+      double axis[3];
+      double angle;
+      ASSERT_NO_THROW(NaifMath::raxisa(r, axis, angle)) << i << " " << j;
+
+      double rotated[3][3];
+      double back[3][3];
+      ASSERT_NO_THROW(NaifMath::mxm(r, fromQuaternion, rotated));
+      ASSERT_NO_THROW(NaifMath::mtxm(r, rotated, back));
+      ASSERT_NO_THROW(NaifMath::mxmt(back, fromQuaternion, back));
+      for (int row = 0; row < 3; row++) {
+        for (int col = 0; col < 3; col++) {
+          EXPECT_NEAR(back[row][col], row == col ? 1.0 : 0.0, 1.0e-14);
+        }
+      }
+
+      double v[3] = {3.0, -2.0, 1.5};
+      double rv[3];
+      ASSERT_NO_THROW(NaifMath::mxv(r, v, rv));
+      ASSERT_NO_THROW(NaifMath::mtxv(r, rv, rv));
+      EXPECT_NEAR(rv[0], v[0], 1.0e-14);
+      EXPECT_NEAR(rv[1], v[1], 1.0e-14);
+      EXPECT_NEAR(rv[2], v[2], 1.0e-14);
+    }
+  }
+}
+
+
+TEST_F(NaifMathAudit, Interpolation) {
+  // The same interpolation SpiceRotation does between cached rotations
+  double axis1[3] = {0.2, -0.7, 0.4};
+  double axis2[3] = {0.3, -0.6, 0.5};
+  double CJ1[3][3], CJ2[3][3];
+  NaifMath::axisar(axis1, 0.8, CJ1);
+  NaifMath::axisar(axis2, 0.9, CJ2);
+
+  double J2J1[3][3];
+  NaifMath::mtxm(CJ2, CJ1, J2J1);
+  double axis[3];
+  double angle;
+  NaifMath::raxisa(J2J1, axis, angle);
+
+  double delta[3][3];
+  double CJ[3][3];
+  NaifMath::axisar(axis, angle * 0.25, delta);
+  ASSERT_NO_THROW(NaifMath::mxmt(CJ1, delta, CJ));
+
+  // Without auditing the results are the same as CSPICE
+  NaifMath::setAuditing(false);
+  double expected[3][3];
+  double spiceAxis[3];
+  double spiceAngle;
+  mtxm_c(CJ2, CJ1, J2J1);
+  raxisa_c(J2J1, spiceAxis, &spiceAngle);
+  axisar_c(spiceAxis, spiceAngle * 0.25, delta);
+  mxmt_c(CJ1, delta, expected);
+  for (int row = 0; row < 3; row++) {
+    for (int col = 0; col < 3; col++) {
+      EXPECT_NEAR(CJ[row][col], expected[row][col], 1.0e-14);
+    }
+  }
+}
+
+
+TEST_F(NaifMathAudit, Ellipsoid) {
+  double a = 3396.19;
+  double b = 3390.0;
+  double c = 3376.2;
+  double point[3];
+
+  // Looking at the body from outside
+  double observer[3] = {10000.0, 500.0, -300.0};
+  double look[3] = {-1.0, -0.01, 0.02};
+  ASSERT_TRUE(NaifMath::surfpt(observer, look, a, b, c, point));
+  EXPECT_NEAR(point[0] * point[0] / (a * a) + point[1] * point[1] / (b * b) +
+              point[2] * point[2] / (c * c), 1.0, 1.0e-12);
+
+  double normal[3];
+  ASSERT_NO_THROW(NaifMath::surfnm(a, b, c, point, normal));
+  EXPECT_NEAR(NaifMath::vnorm(normal), 1.0, 1.0e-15);
+
+  // Looking past and away from the body
+  double past[3] = {0.0, 1.0, 0.0};
+  EXPECT_FALSE(NaifMath::surfpt(observer, past, a, b, c, point));
+  double away[3] = {1.0, 0.0, 0.0};
+  EXPECT_FALSE(NaifMath::surfpt(observer, away, a, b, c, point));
+
+  // From inside the ray leaves the body
+  double inside[3] = {100.0, 0.0, 0.0};
+  ASSERT_TRUE(NaifMath::surfpt(inside, away, a, b, c, point));
+  EXPECT_NEAR(point[0], a, 1.0e-9);
+
+  double zero[3] = {0.0, 0.0, 0.0};
+  EXPECT_THROW(NaifMath::surfpt(observer, zero, a, b, c, point), IException);
+  EXPECT_THROW(NaifMath::surfpt(observer, look, a, 0.0, c, point), IException);
+  EXPECT_THROW(NaifMath::surfnm(-a, b, c, point, normal), IException);
+}
+
+
+TEST_F(NaifMathAudit, Vectors) {
+  double vectors[][3] = {{3.0, -2.0, 1.5}, {1.0e-300, 2.0e-300, 0.0}, {1.0e300, -1.0e300, 1.0e299},
+                         {0.0, 0.0, -4.0}, {0.0, 0.0, 0.0}, {3.0, -2.0, 1.5000001}};
+
+  for (int i = 0; i < 6; i++) {
+    double unit[3];
+    double length;
+    ASSERT_NO_THROW(NaifMath::unorm(vectors[i], unit, length)) << i;
+    if (length > 0.0) {
+      EXPECT_NEAR(NaifMath::vnorm(unit), 1.0, 1.0e-15) << i;
+    }
+
+    double reclatRadius, longitude, latitude;
+    ASSERT_NO_THROW(NaifMath::reclat(vectors[i], reclatRadius, longitude, latitude)) << i;
+    EXPECT_EQ(reclatRadius, length) << i;
+    double rectan[3];
+    ASSERT_NO_THROW(NaifMath::latrec(reclatRadius, longitude, latitude, rectan)) << i;
+    for (int k = 0; k < 3; k++) {
+      EXPECT_NEAR(rectan[k], vectors[i][k], 1.0e-14 * std::max(1.0, length)) << i;
+    }
+
+    for (int j = 0; j < 6; j++) {
+      double difference[3];
+      NaifMath::vsub(vectors[i], vectors[j], difference);
+      for (int k = 0; k < 3; k++) {
+        EXPECT_EQ(difference[k], vectors[i][k] - vectors[j][k]);
+      }
+
+      double cross[3];
+      ASSERT_NO_THROW(NaifMath::ucrss(vectors[i], vectors[j], cross)) << i << " " << j;
+      ASSERT_NO_THROW(NaifMath::vsep(vectors[i], vectors[j])) << i << " " << j;
+    }
+  }
+
+  // Nearly parallel vectors keep their separation
+  double x[3] = {1.0, 0.0, 0.0};
+  double nearlyX[3] = {1.0, 1.0e-10, 0.0};
+  EXPECT_NEAR(NaifMath::vsep(x, nearlyX), 1.0e-10, 1.0e-24);
+  double minusX[3] = {-1.0, 1.0e-10, 0.0};
+  EXPECT_NEAR(NaifMath::vsep(x, minusX), PI - 1.0e-10, 1.0e-15);
+  double y[3] = {0.0, 2.0, 0.0};
+  EXPECT_EQ(NaifMath::vsep(x, y), HALFPI);
+
+  // Parallel vectors have no cross product
+  double cross[3];
+  double twoX[3] = {2.0, 0.0, 0.0};
+  NaifMath::ucrss(x, twoX, cross);
+  EXPECT_EQ(cross[0], 0.0);
+  EXPECT_EQ(cross[1], 0.0);
+  EXPECT_EQ(cross[2], 0.0);
+  NaifMath::ucrss(x, y, cross);
+  EXPECT_EQ(cross[2], 1.0);
+
+  // Points on the z axis have a longitude of 0
+  double radius, longitude, latitude;
+  double south[3] = {0.0, 0.0, -4.0};
+  NaifMath::reclat(south, radius, longitude, latitude);
+  EXPECT_EQ(radius, 4.0);
+  EXPECT_EQ(longitude, 0.0);
+  EXPECT_EQ(latitude, -HALFPI);
+}
@@ -0,0 +1,322 @@
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+#include <QScopedPointer>
+
+#include "Constants.h"
+#include "IException.h"
+#include "Photometry.h"
+#include "PhotometricTable.h"
+#include "PhotoModel.h"
+#include "PhotoModelFactory.h"
+#include "Pvl.h"
+#include "PvlGroup.h"
+#include "PvlKeyword.h"
+#include "PvlObject.h"
+#include "SpecialPixel.h"
+
+#include "gmock/gmock.h"
+
+using namespace Isis;
+
+/**
+ * A smooth limb darkening function, which has no value beyond 80 degrees of
+ * incidence.
+ */
+static void limbDarkening(double phase, double incidence, double emission,
+                          double *values, void *parameter) {
+  double munot = cos(incidence * PI / 180.0);
+  double mu = cos(emission * PI / 180.0);
+  values[0] = 0.1 * munot * (1.0 + mu);
+  values[1] = incidence > 80.0 ? std::numeric_limits<double>::quiet_NaN() : phase / 180.0;
+  (*(int *) parameter)++;
+}
+
+
+/**
+ * A function that curves too quickly to meet a tight tolerance at any
+ * spacing. The parameter is the number of values to compute.
+ */
+static void oscillating(double phase, double incidence, double emission,
+                        double *values, void *parameter) {
+  for (int i = 0; i < *(int *) parameter; i++) {
+    values[i] = sin(2.0 * incidence * PI / 180.0) + i;
+  }
+}
+
+
+/**
+ * Creates the models used by photomet with a Hapke photometric model.
+ */
+static Pvl hapkeParameters(QString atmosphere) {
+  Pvl parameters;
+  PvlObject photometric("PhotometricModel");
+  PvlGroup algorithm("Algorithm");
+  algorithm += PvlKeyword("Name", "HapkeHen");
+  algorithm += PvlKeyword("Wh", "0.52");
+  algorithm += PvlKeyword("B0", "0.8");
+  algorithm += PvlKeyword("Hh", "0.06");
+  algorithm += PvlKeyword("Theta", "30.0");
+  algorithm += PvlKeyword("Hg1", "0.213");
+  algorithm += PvlKeyword("Hg2", "1.0");
+  photometric.addGroup(algorithm);
+  parameters.addObject(photometric);
+
+  PvlObject normalization("NormalizationModel");
+  algorithm = PvlGroup("Algorithm");
+  algorithm += PvlKeyword("Incref", "30.0");
+  algorithm += PvlKeyword("Albedo", "0.0690507");
+  algorithm += PvlKeyword("Thresh", "30.0");
+
+  if (atmosphere.isEmpty()) {
+    algorithm += PvlKeyword("Name", "Albedo");
+  }
+  else {
+    algorithm += PvlKeyword("Name", "AlbedoAtm");
+
+    PvlObject atmospheric("AtmosphericModel");
+    PvlGroup atmosAlgorithm("Algorithm");
+    atmosAlgorithm += PvlKeyword("Name", atmosphere);
+    atmosAlgorithm += PvlKeyword("Tau", "0.28");
+    atmosAlgorithm += PvlKeyword("Tauref", "0.001");
+    atmosAlgorithm += PvlKeyword("Wha", "0.95");
+    atmosAlgorithm += PvlKeyword("Bha", "0.85");
+    atmosAlgorithm += PvlKeyword("Hga", "0.68");
+    atmosAlgorithm += PvlKeyword("Hnorm", "0.003");
+    atmosAlgorithm += PvlKeyword("Nulneg", "NO");
+    atmospheric.addGroup(atmosAlgorithm);
+    parameters.addObject(atmospheric);
+  }
+
+  normalization.addGroup(algorithm);
+  parameters.addObject(normalization);
+  return parameters;
+}
+
+
+/**
+ * Creates a line of viewing geometries across most of the possible angles.
+ */
+static void createGeometry(int count, std::vector<double> &phases,
+                           std::vector<double> &incidences,
+                           std::vector<double> &emissions,
+                           std::vector<double> &dns) {
+  phases.resize(count);
+  incidences.resize(count);
+  emissions.resize(count);
+  dns.resize(count);
+  for (int i = 0; i < count; i++) {
+    incidences[i] = 5.0 + 70.0 * i / count;
+    emissions[i] = 70.0 - 60.0 * ((i * 7) % count) / count;
+    phases[i] = fabs(incidences[i] - emissions[i]) +
+                (incidences[i] + emissions[i] - fabs(incidences[i] - emissions[i])) *
+                ((i * 13) % count) / count;
+    dns[i] = 0.05 + 0.001 * (i % 100);
+  }
+}
+
+
+TEST(PhotometricTable, Interpolation) {
+  int evaluations = 0;
+  PhotometricTable table(limbDarkening, &evaluations, 2, 1.0e-4);
+  ASSERT_FALSE(table.isEmpty());
+  EXPECT_EQ(table.valueCount(), 2);
+  EXPECT_LE(table.maximumError(), 0.5e-4);
+  EXPECT_GT(evaluations, 0);
+
+  // Grid points are exact and the function is not evaluated again
+  evaluations = 0;
+  double values[2];
+  double expected[2];
+  double step = table.step();
+  int dummy = 0;
+  ASSERT_TRUE(table.interpolate(4 * step, 2 * step, 3 * step, values));
+  limbDarkening(4 * step, 2 * step, 3 * step, expected, &dummy);
+  EXPECT_DOUBLE_EQ(values[0], expected[0]);
+  EXPECT_DOUBLE_EQ(values[1], expected[1]);
+  EXPECT_EQ(evaluations, 0);
+
+  for (double incidence = 0.0; incidence <= 79.0; incidence += 3.7) {
+    for (double emission = 0.0; emission <= 90.0; emission += 4.3) {
+      double phase = fabs(incidence - emission) +
+                     0.4 * (incidence + emission - fabs(incidence - emission));
+      ASSERT_TRUE(table.interpolate(phase, incidence, emission, values));
+      limbDarkening(phase, incidence, emission, expected, &dummy);
+      EXPECT_NEAR(values[0], expected[0], 1.0e-4);
+      EXPECT_NEAR(values[1], expected[1], 1.0e-12);
+    }
+  }
+
+  // The ends of the table are included
+  EXPECT_TRUE(table.interpolate(180.0, 0.0, 90.0, values));
+
+  // Angles outside of the table and cells without values are left to the caller
+  EXPECT_FALSE(table.interpolate(-1.0, 10.0, 10.0, values));
+  EXPECT_FALSE(table.interpolate(10.0, 95.0, 10.0, values));
+  EXPECT_FALSE(table.interpolate(10.0, 10.0, 90.5, values));
+  EXPECT_FALSE(table.interpolate(std::numeric_limits<double>::quiet_NaN(), 10.0, 10.0, values));
+  EXPECT_FALSE(table.interpolate(30.0, 85.0, 60.0, values));
+
+  // A coarser tolerance gives a coarser grid
+  PhotometricTable coarse(limbDarkening, &evaluations, 2, 1.0e-2);
+  EXPECT_GE(coarse.step(), table.step());
+
+  EXPECT_THROW(PhotometricTable(limbDarkening, &evaluations, 2, 0.0), IException);
+}
+
+
+TEST(PhotometricTable, NoSpacingMeetsTolerance) {
+  // A single value is small enough to try the finest spacing
+  int valueCount = 1;
+  PhotometricTable fine(oscillating, &valueCount, valueCount, 1.0e-6);
+  EXPECT_TRUE(fine.isEmpty());
+  EXPECT_EQ(fine.step(), 0.5);
+  EXPECT_GT(fine.maximumError(), 0.5e-6);
+
+  double values[5];
+  EXPECT_FALSE(fine.interpolate(30.0, 20.0, 10.0, values));
+
+  // Five values on the finest spacing would be too large, so it is not tried
+  valueCount = 5;
+  PhotometricTable capped(oscillating, &valueCount, valueCount, 1.0e-6);
+  EXPECT_TRUE(capped.isEmpty());
+  EXPECT_EQ(capped.step(), 1.0);
+  EXPECT_FALSE(capped.interpolate(30.0, 20.0, 10.0, values));
+}
+
+
+TEST(PhotometricTable, PhotometryMatchesModels) {
+  const char *atmospheres[] = {"", "Anisotropic1", "HapkeAtm2"};
+
+  for (int a = 0; a < 3; a++) {
+    Pvl parameters = hapkeParameters(atmospheres[a]);
+    Photometry direct(parameters);
+    Photometry tabulated(parameters);
+    tabulated.GenerateTables(1.0e-4);
+    EXPECT_EQ(tabulated.GetAtmosModel() != NULL, a != 0);
+
+    // A model without a table small enough to meet the tolerance is evaluated directly
+    QSharedPointer<const PhotometricTable> photoTable = tabulated.GetPhotoModel()->Table();
+    EXPECT_TRUE(photoTable.isNull() || photoTable->maximumError() <= 0.5e-4);
+    if (tabulated.GetAtmosModel() != NULL) {
+      QSharedPointer<const PhotometricTable> atmosTable = tabulated.GetAtmosModel()->Table();
+      EXPECT_TRUE(atmosTable.isNull() || atmosTable->maximumError() <= 0.5e-4);
+    }
+
+    // Another copy of the models can use the same tables
+    Photometry shared(parameters);
+    shared.SetTables(tabulated);
+    EXPECT_EQ(shared.GetPhotoModel()->Table(), tabulated.GetPhotoModel()->Table());
+
+    std::vector<double> phases, incidences, emissions, dns;
+    createGeometry(2000, phases, incidences, emissions, dns);
+    dns[10] = Null;
+    dns[11] = Lrs;
+
+    // The tabulated models are within the tolerance of the models themselves
+    for (unsigned int i = 0; i < dns.size(); i++) {
+      EXPECT_NEAR(tabulated.GetPhotoModel()->CalcSurfAlbedo(phases[i], incidences[i],
+                                                            emissions[i]),
+                  direct.GetPhotoModel()->CalcSurfAlbedo(phases[i], incidences[i],
+                                                         emissions[i]),
+                  1.0e-4) << atmospheres[a] << " " << i;
+
+      if (tabulated.GetAtmosModel() != NULL) {
+        double expected[5];
+        double actual[5];
+        direct.GetAtmosModel()->CalcAtmEffect(phases[i], incidences[i], emissions[i],
+                                              &expected[0], &expected[1], &expected[2],
+                                              &expected[3], &expected[4]);
+        tabulated.GetAtmosModel()->CalcAtmEffect(phases[i], incidences[i], emissions[i],
+                                                 &actual[0], &actual[1], &actual[2],
+                                                 &actual[3], &actual[4]);
+        for (int v = 0; v < 5; v++) {
+          EXPECT_NEAR(actual[v], expected[v], 1.0e-4) << atmospheres[a] << " " << i << " " << v;
+        }
+      }
+    }
+
+    std::vector<double> expected(dns.size()), tabulatedAlbedo(dns.size()),
+                        sharedAlbedo(dns.size());
+    direct.Compute(dns.size(), &phases[0], &incidences[0], &emissions[0], &incidences[0],
+                   &emissions[0], &dns[0], &expected[0]);
+    tabulated.Compute(dns.size(), &phases[0], &incidences[0], &emissions[0], &incidences[0],
+                      &emissions[0], &dns[0], &tabulatedAlbedo[0]);
+    shared.Compute(dns.size(), &phases[0], &incidences[0], &emissions[0], &incidences[0],
+                   &emissions[0], &dns[0], &sharedAlbedo[0]);
+
+    EXPECT_EQ(tabulatedAlbedo[10], Null);
+    EXPECT_EQ(tabulatedAlbedo[11], Lrs);
+    for (unsigned int i = 0; i < dns.size(); i++) {
+      if (IsSpecial(expected[i])) {
+        EXPECT_EQ(tabulatedAlbedo[i], expected[i]) << atmospheres[a] << " " << i;
+      }
+      EXPECT_EQ(sharedAlbedo[i], tabulatedAlbedo[i]);
+    }
+
+    // Each pixel is the same as computing it alone
+    double albedo, mult, base;
+    direct.Compute(phases[5], incidences[5], emissions[5], incidences[5], emissions[5], dns[5],
+                   albedo, mult, base);
+    EXPECT_EQ(albedo, expected[5]);
+  }
+}
+
+
+TEST(PhotometricTable, TopographicDerivativeIgnoresTable) {
+  const char *models[] = {"Lambert", "HapkeHen"};
+
+  for (int m = 0; m < 2; m++) {
+    Pvl parameters = hapkeParameters("");
+    parameters.findObject("PhotometricModel").findGroup("Algorithm")["Name"].setValue(models[m]);
+    QScopedPointer<PhotoModel> direct(PhotoModelFactory::Create(parameters));
+    QScopedPointer<PhotoModel> tabulated(PhotoModelFactory::Create(parameters));
+    tabulated->GenerateTable(1.0e-3);
+    if (m == 0) {
+      ASSERT_FALSE(tabulated->Table().isNull());
+    }
+
+    // The derivative steps by hundredths of a degree, so it must not see the table
+    std::vector<double> phases, incidences, emissions, dns;
+    createGeometry(500, phases, incidences, emissions, dns);
+    for (unsigned int i = 0; i < phases.size(); i++) {
+      EXPECT_EQ(tabulated->PhtTopder(phases[i], incidences[i], emissions[i]),
+                direct->PhtTopder(phases[i], incidences[i], emissions[i]))
+          << models[m] << " " << i;
+    }
+  }
+}
+
+
+// Prints timings, so it only runs with --gtest_also_run_disabled_tests
+TEST(PhotometricTable, DISABLED_PhotometryBenchmark) {
+  const char *atmospheres[] = {"", "HapkeAtm2"};
+  std::vector<double> phases, incidences, emissions, dns;
+  createGeometry(200000, phases, incidences, emissions, dns);
+  std::vector<double> albedo(dns.size());
+  typedef std::chrono::duration<double, std::milli> Milliseconds;
+
+  for (int a = 0; a < 2; a++) {
+    Pvl parameters = hapkeParameters(atmospheres[a]);
+    Photometry direct(parameters);
+    Photometry tabulated(parameters);
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    direct.Compute(dns.size(), &phases[0], &incidences[0], &emissions[0], &incidences[0],
+                   &emissions[0], &dns[0], &albedo[0]);
+    std::chrono::steady_clock::time_point directEnd = std::chrono::steady_clock::now();
+    tabulated.GenerateTables(1.0e-4);
+    std::chrono::steady_clock::time_point tableEnd = std::chrono::steady_clock::now();
+    tabulated.Compute(dns.size(), &phases[0], &incidences[0], &emissions[0], &incidences[0],
+                      &emissions[0], &dns[0], &albedo[0]);
+    std::chrono::steady_clock::time_point tabulatedEnd = std::chrono::steady_clock::now();
+
+    std::cout << "HapkeHen " << atmospheres[a] << " " << dns.size() << " pixels" << std::endl
+              << "  Direct    " << Milliseconds(directEnd - start).count() << " ms" << std::endl
+              << "  Tables    " << Milliseconds(tableEnd - directEnd).count() << " ms" << std::endl
+              << "  Tabulated " << Milliseconds(tabulatedEnd - tableEnd).count() << " ms" << std::endl;
+  }
+}
@@ -0,0 +1,218 @@
+#include <algorithm>
+#include <vector>
+
+#include <QString>
+
+#include "CubeAttribute.h"
+#include "Fixtures.h"
+#include "LineManager.h"
+#include "ProcessByBoxcar.h"
+#include "SpecialPixel.h"
+
+#include "gmock/gmock.h"
+
+using namespace Isis;
+
+static ProcessByBoxcar::RankStatistic bruteStatistic;
+static double brutePercentile;
+
+/**
+ * Computes the rank statistic of the valid pixels in a boxcar by sorting them,
+ * the way rank filter applications did before StartRankProcess.
+ */
+static void bruteRank(Buffer &in, double &v) {
+  double centerPixel = in[(in.size() - 1) / 2];
+  if (IsLisPixel(centerPixel)) {
+    v = centerPixel;
+    return;
+  }
+
+  std::vector<double> boxdata;
+  for (int i = 0; i < in.size(); i++) {
+    if (!IsSpecial(in[i]) && in[i] >= 1.0 && in[i] <= 40.0) {
+      boxdata.push_back(in[i]);
+    }
+  }
+  if (boxdata.size() < 3) {
+    v = Isis::Null;
+    return;
+  }
+
+  std::sort(boxdata.begin(), boxdata.end());
+  if (bruteStatistic == ProcessByBoxcar::Median) {
+    v = boxdata[(boxdata.size() - 1) / 2];
+  }
+  else if (bruteStatistic == ProcessByBoxcar::Percentile) {
+    v = boxdata[(int)((boxdata.size() - 1) * brutePercentile / 100.0)];
+  }
+  else {
+    v = centerPixel;
+    int count = 1;
+    int maxCount = 1;
+    for (unsigned int i = 1; i <= boxdata.size(); i++) {
+      if (i < boxdata.size() && boxdata[i] == boxdata[i - 1]) {
+        count++;
+      }
+      else {
+        if (count > maxCount) {
+          v = boxdata[i - 1];
+          maxCount = count;
+        }
+        count = 1;
+      }
+    }
+  }
+}
+
+
+static bool notLis(double centerPixel) {
+  return !IsLisPixel(centerPixel);
+}
+
+
+static void compareRankFilter(Cube *input, QString outputDir,
+                              ProcessByBoxcar::RankStatistic statistic,
+                              double percentile, int chunkLines) {
+  bruteStatistic = statistic;
+  brutePercentile = percentile;
+  CubeAttributeOutput att;
+
+  ProcessByBoxcar brute;
+  brute.SetInputCube(input);
+  Cube *expected = brute.SetOutputCube(outputDir + "/brute.cub", att, input->sampleCount(),
+                                       input->lineCount(), input->bandCount());
+  brute.SetBoxcarSize(5, 3);
+  brute.StartProcess(bruteRank);
+
+  ProcessByBoxcar rank;
+  rank.SetInputCube(input);
+  Cube *actual = rank.SetOutputCube(outputDir + "/rank.cub", att, input->sampleCount(),
+                                    input->lineCount(), input->bandCount());
+  rank.SetBoxcarSize(5, 3);
+  rank.SetRankStatistic(statistic, percentile);
+  rank.SetRankValidRange(1.0, 40.0);
+  rank.SetRankMinimumCount(3, false);
+  rank.StartRankProcess(notLis, chunkLines);
+
+  LineManager expectedLine(*expected);
+  LineManager actualLine(*actual);
+  for (expectedLine.begin(), actualLine.begin(); !expectedLine.end();
+       expectedLine++, actualLine++) {
+    expected->read(expectedLine);
+    actual->read(actualLine);
+    for (int i = 0; i < expectedLine.size(); i++) {
+      EXPECT_EQ(expectedLine[i], actualLine[i]) << "Sample " << i + 1 << " line "
+          << expectedLine.Line() << " band " << expectedLine.Band();
+    }
+  }
+
+  brute.Finalize();
+  rank.Finalize();
+}
+
+
+class RankCube : public SmallCube {
+  protected:
+    void SetUp() override {
+      SmallCube::SetUp();
+
+      // Repeat values so the boxcars have modes, and add special pixels and
+      // values outside of the valid range
+      LineManager line(*testCube);
+      for (line.begin(); !line.end(); line++) {
+        for (int i = 0; i < line.size(); i++) {
+          int n = (i * 7 + line.Line() * 3 + line.Band()) % 53;
+          if (n == 0) {
+            line[i] = Isis::Null;
+          }
+          else if (n == 1) {
+            line[i] = Isis::Lis;
+          }
+          else if (n == 2) {
+            line[i] = Isis::Hrs;
+          }
+          else {
+            line[i] = (double) (n % 45);
+          }
+        }
+        testCube->write(line);
+      }
+    }
+};
+
+
+TEST_F(RankCube, ProcessByBoxcarRankMedian) {
+  compareRankFilter(testCube, tempDir.path(), ProcessByBoxcar::Median, 50.0, 0);
+}
+
+
+TEST_F(RankCube, ProcessByBoxcarRankPercentile) {
+  compareRankFilter(testCube, tempDir.path(), ProcessByBoxcar::Percentile, 90.0, 1);
+}
+
+
+TEST_F(RankCube, ProcessByBoxcarRankMode) {
+  compareRankFilter(testCube, tempDir.path(), ProcessByBoxcar::Mode, 50.0, 4);
+}
+
+
+/**
+ * Mode filters one line with a 5x1 boxcar and returns the output line.
+ */
+static std::vector<double> modeFilterLine(QString outputDir, const std::vector<double> &values,
+                                          int minimumCount) {
+  Cube input;
+  input.setDimensions(values.size(), 1, 1);
+  input.create(outputDir + "/line" + QString::number(minimumCount) + ".cub");
+  LineManager line(input);
+  line.begin();
+  std::copy(values.begin(), values.end(), line.DoubleBuffer());
+  input.write(line);
+
+  CubeAttributeOutput att;
+  ProcessByBoxcar p;
+  p.SetInputCube(&input);
+  Cube *output = p.SetOutputCube(outputDir + "/mode" + QString::number(minimumCount) + ".cub",
+                                 att, values.size(), 1, 1);
+  p.SetBoxcarSize(5, 1);
+  p.SetRankStatistic(ProcessByBoxcar::Mode);
+  p.SetRankValidRange(1.0, 10.0);
+  p.SetRankMinimumCount(minimumCount, false);
+  p.StartRankProcess();
+
+  LineManager outputLine(*output);
+  outputLine.begin();
+  output->read(outputLine);
+  std::vector<double> result(outputLine.DoubleBuffer(),
+                             outputLine.DoubleBuffer() + outputLine.size());
+  p.Finalize();
+  input.close();
+  return result;
+}
+
+
+TEST_F(TempTestingFiles, ProcessByBoxcarRankModeTiesAndEmptyBoxcars) {
+  std::vector<double> values = {50.0, 4.0, 4.0, 2.0, 2.0, 9.0, 60.0, 70.0, 80.0, 90.0};
+
+  // Ties go to the smallest value, boxcars without a repeated value keep the
+  // center, and so do empty boxcars when no valid pixels are needed
+  std::vector<double> expected = {4.0, 4.0, 2.0, 2.0, 2.0, 2.0, 60.0, 70.0, 80.0, 90.0};
+  std::vector<double> actual = modeFilterLine(tempDir.path(), values, 0);
+  for (unsigned int i = 0; i < values.size(); i++) {
+    EXPECT_EQ(actual[i], expected[i]) << "Sample " << i + 1;
+  }
+
+  // Empty boxcars are replaced when a valid pixel is needed
+  expected[8] = Isis::Null;
+  expected[9] = Isis::Null;
+  actual = modeFilterLine(tempDir.path(), values, 1);
+  for (unsigned int i = 0; i < values.size(); i++) {
+    EXPECT_EQ(actual[i], expected[i]) << "Sample " << i + 1;
+  }
+}
+
+
+TEST_F(SmallCube, ProcessByBoxcarRankBadPercentile) {
+  ProcessByBoxcar p;
+  EXPECT_THROW(p.SetRankStatistic(ProcessByBoxcar::Percentile, 101.0), IException);
+}
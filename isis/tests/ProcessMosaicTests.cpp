@@ -0,0 +1,181 @@
+#include <string>
+
+#include <QString>
+
+#include "CubeAttribute.h"
+#include "FileList.h"
+#include "Fixtures.h"
+#include "LineManager.h"
+#include "ProcessMosaic.h"
+#include "ProcessMapMosaic.h"
+#include "Pvl.h"
+#include "PvlGroup.h"
+#include "SpecialPixel.h"
+
+#include "gmock/gmock.h"
+
+using namespace Isis;
+
+/**
+ * Mosaics a list of projected cubes with a priority, either placing each
+ * input as it is given or compositing in tiles of tileLines lines. Band
+ * priority mosaics are tracked.
+ */
+static void mosaicInputs(FileList &inputs, QString mosaicFile,
+                         ProcessMosaic::ImageOverlay overlay, bool tiled,
+                         int tileLines = 0) {
+  ProcessMapMosaic m;
+  m.SetCreateFlag(true);
+  m.SetImageOverlay(overlay);
+  if (overlay == ProcessMosaic::UseBandPlacementCriteria) {
+    m.SetTrackFlag(true);
+    m.SetBandNumber(1);
+    m.SetBandUseMaxValue(true);
+    m.SetBandBinMatch(false);
+  }
+  m.SetTiledFlag(tiled);
+
+  CubeAttributeOutput outAtt;
+  m.SetOutputCube(inputs, outAtt, mosaicFile);
+
+  for (int i = 0; i < inputs.size(); i++) {
+    if (m.StartProcess(inputs[i].toString())) {
+      m.SetCreateFlag(false);
+    }
+  }
+
+  m.ProcessTiles(tileLines);
+  m.EndProcess();
+}
+
+
+static void compareCubes(QString expectedFile, QString actualFile) {
+  Cube expected(FileName(expectedFile), "r");
+  Cube actual(FileName(actualFile), "r");
+  ASSERT_EQ(expected.sampleCount(), actual.sampleCount());
+  ASSERT_EQ(expected.lineCount(), actual.lineCount());
+  ASSERT_EQ(expected.bandCount(), actual.bandCount());
+
+  LineManager expectedLine(expected);
+  LineManager actualLine(actual);
+  for (expectedLine.begin(), actualLine.begin(); !expectedLine.end();
+       expectedLine++, actualLine++) {
+    expected.read(expectedLine);
+    actual.read(actualLine);
+    for (int i = 0; i < expectedLine.size(); i++) {
+      if (IsSpecial(expectedLine[i])) {
+        EXPECT_EQ(expectedLine[i], actualLine[i]);
+      }
+      else {
+        EXPECT_DOUBLE_EQ(expectedLine[i], actualLine[i]);
+      }
+    }
+  }
+}
+
+
+TEST_F(DefaultCube, ProcessMosaicTiledMatchesSerial) {
+  // Give the two bands different patterns so the band priority comparison
+  // decides which input wins each pixel
+  LineManager line(*projTestCube);
+  for (line.begin(); !line.end(); line++) {
+    for (int i = 0; i < line.size(); i++) {
+      line[i] = (line.Band() == 1) ? (double) ((i + line.Line()) % 3) :
+                                     (double) (i * line.Line());
+    }
+    projTestCube->write(line);
+  }
+  QString inputFile = projTestCube->fileName();
+  projTestCube->close();
+
+  FileList inputs;
+  inputs.append(FileName(inputFile));
+  inputs.append(FileName(inputFile));
+
+  mosaicInputs(inputs, tempDir.path() + "/serial.cub", ProcessMosaic::UseBandPlacementCriteria,
+               false);
+  mosaicInputs(inputs, tempDir.path() + "/tiled.cub", ProcessMosaic::UseBandPlacementCriteria,
+               true, 1);
+
+  compareCubes(tempDir.path() + "/serial.cub", tempDir.path() + "/tiled.cub");
+  compareCubes(tempDir.path() + "/serial_tracking.cub", tempDir.path() + "/tiled_tracking.cub");
+}
+
+
+TEST_F(DefaultCube, ProcessMosaicTiledDefaultTiles) {
+  QString inputFile = projTestCube->fileName();
+  projTestCube->close();
+
+  FileList inputs;
+  inputs.append(FileName(inputFile));
+
+  mosaicInputs(inputs, tempDir.path() + "/serial.cub", ProcessMosaic::UseBandPlacementCriteria,
+               false);
+  mosaicInputs(inputs, tempDir.path() + "/tiled.cub", ProcessMosaic::UseBandPlacementCriteria,
+               true);
+
+  compareCubes(tempDir.path() + "/serial.cub", tempDir.path() + "/tiled.cub");
+}
+
+
+TEST_F(DefaultCube, ProcessMosaicTiledOffsetInputs) {
+  // The second input is the first one moved 2 samples right and 3 lines down,
+  // so the 6x6 inputs only partly overlap in an 8x9 mosaic
+  Pvl shiftedLabel = projLabel;
+  PvlGroup &mapping = shiftedLabel.findObject("IsisCube").findGroup("Mapping");
+  mapping["UpperLeftCornerX"].setValue("200000.0", "meters");
+  mapping["UpperLeftCornerY"].setValue("300000.0", "meters");
+  Cube shiftedCube;
+  shiftedCube.fromIsd(tempDir.path() + "/shifted.cub", shiftedLabel, isd, "rw");
+
+  LineManager line(*projTestCube);
+  for (line.begin(); !line.end(); line++) {
+    for (int i = 0; i < line.size(); i++) {
+      line[i] = i + 1 + 10 * line.Line() + 100 * line.Band();
+    }
+    projTestCube->write(line);
+  }
+
+  // Some NULLs in the second input let the first one show through
+  LineManager shiftedLine(shiftedCube);
+  for (shiftedLine.begin(); !shiftedLine.end(); shiftedLine++) {
+    for (int i = 0; i < shiftedLine.size(); i++) {
+      shiftedLine[i] = ((i + shiftedLine.Line()) % 4 == 0) ? Isis::Null :
+                       1000 + 7 * i + 3 * shiftedLine.Line() + 100 * shiftedLine.Band();
+    }
+    shiftedCube.write(shiftedLine);
+  }
+
+  FileList inputs;
+  inputs.append(FileName(projTestCube->fileName()));
+  inputs.append(FileName(shiftedCube.fileName()));
+  projTestCube->close();
+  shiftedCube.close();
+
+  ProcessMosaic::ImageOverlay overlays[] = {ProcessMosaic::PlaceImagesOnTop,
+                                            ProcessMosaic::PlaceImagesBeneath,
+                                            ProcessMosaic::AverageImageWithMosaic,
+                                            ProcessMosaic::UseBandPlacementCriteria};
+  for (int o = 0; o < 4; o++) {
+    QString name = ProcessMosaic::OverlayToString(overlays[o]);
+    QString serialFile = tempDir.path() + "/serial" + name + ".cub";
+    mosaicInputs(inputs, serialFile, overlays[o], false);
+
+    Cube serial(FileName(serialFile), "r");
+    EXPECT_EQ(serial.sampleCount(), 8) << name.toStdString();
+    EXPECT_EQ(serial.lineCount(), 9) << name.toStdString();
+    serial.close();
+
+    // Tile edges after lines 2, 4, 6 and 8 fall inside the inputs, which
+    // cover lines 1 to 6 and 4 to 9
+    int tileLines[] = {2, 4};
+    for (int t = 0; t < 2; t++) {
+      SCOPED_TRACE(name.toStdString() + " in tiles of " + std::to_string(tileLines[t]) +
+                   " lines");
+      QString tiledFile = tempDir.path() + "/tiled" + name + QString::number(tileLines[t]) +
+                          ".cub";
+      mosaicInputs(inputs, tiledFile, overlays[o], true, tileLines[t]);
+      compareCubes(serialFile, tiledFile);
+    }
+  }
+}
@@ -0,0 +1,111 @@
+#include <QString>
+
+#include "CubeAttribute.h"
+#include "Fixtures.h"
+#include "Interpolator.h"
+#include "LineManager.h"
+#include "ProcessRubberSheet.h"
+#include "SpecialPixel.h"
+#include "Transform.h"
+
+#include "gmock/gmock.h"
+
+using namespace Isis;
+
+/**
+ * Scales and shifts an image, which is separable in sample and line.
+ */
+class ScaleTransform : public Transform {
+  public:
+    ScaleTransform(bool separable) {
+      m_separable = separable;
+    }
+
+    int OutputSamples() const {
+      return 17;
+    }
+
+    int OutputLines() const {
+      return 13;
+    }
+
+    bool Xform(double &inSample, double &inLine,
+               const double outSample, const double outLine) {
+      return XformSample(inSample, outSample) && XformLine(inLine, outLine);
+    }
+
+    bool IsSeparable() const {
+      return m_separable;
+    }
+
+    bool XformSample(double &inSample, const double outSample) {
+      inSample = 0.6 * outSample - 0.3;
+      return true;
+    }
+
+    bool XformLine(double &inLine, const double outLine) {
+      // Leave some output lines without an input line
+      if (outLine > 12.0) {
+        return false;
+      }
+      inLine = 0.8 * outLine + 0.7;
+      return true;
+    }
+
+  private:
+    bool m_separable;
+};
+
+
+static void compareSeparableToSlowGeom(Cube *input, QString outputDir,
+                                       Interpolator::interpType type) {
+  CubeAttributeOutput att;
+  Interpolator interp(type);
+
+  // A two pixel tile size makes ProcessRubberSheet transform every pixel
+  ProcessRubberSheet slow(2, 2);
+  slow.SetInputCube(input);
+  ScaleTransform slowTransform(false);
+  Cube *expected = slow.SetOutputCube(outputDir + "/slow.cub", att,
+                                      slowTransform.OutputSamples(),
+                                      slowTransform.OutputLines(), input->bandCount());
+  slow.StartProcess(slowTransform, interp);
+
+  ProcessRubberSheet separable;
+  separable.SetInputCube(input);
+  ScaleTransform separableTransform(true);
+  Cube *actual = separable.SetOutputCube(outputDir + "/separable.cub", att,
+                                         separableTransform.OutputSamples(),
+                                         separableTransform.OutputLines(), input->bandCount());
+  separable.StartProcess(separableTransform, interp);
+
+  LineManager expectedLine(*expected);
+  LineManager actualLine(*actual);
+  for (expectedLine.begin(), actualLine.begin(); !expectedLine.end();
+       expectedLine++, actualLine++) {
+    expected->read(expectedLine);
+    actual->read(actualLine);
+    for (int i = 0; i < expectedLine.size(); i++) {
+      EXPECT_EQ(expectedLine[i], actualLine[i]) << "Sample " << i + 1 << " line "
+          << expectedLine.Line() << " band " << expectedLine.Band();
+    }
+  }
+
+  slow.Finalize();
+  separable.Finalize();
+}
+
+
+TEST_F(SmallCube, ProcessRubberSheetSeparableNearestNeighbor) {
+  compareSeparableToSlowGeom(testCube, tempDir.path(), Interpolator::NearestNeighborType);
+}
+
+
+TEST_F(SmallCube, ProcessRubberSheetSeparableBiLinear) {
+  compareSeparableToSlowGeom(testCube, tempDir.path(), Interpolator::BiLinearType);
+}
+
+
+TEST_F(SmallCube, ProcessRubberSheetSeparableCubicConvolution) {
+  compareSeparableToSlowGeom(testCube, tempDir.path(), Interpolator::CubicConvolutionType);
+}
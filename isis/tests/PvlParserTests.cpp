@@ -0,0 +1,293 @@
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#include <QByteArray>
+#include <QFile>
+#include <QString>
+#include <QStringList>
+
+#include "Fixtures.h"
+#include "IException.h"
+#include "Pvl.h"
+#include "PvlGroup.h"
+#include "PvlKeyword.h"
+#include "PvlObject.h"
+#include "PvlParser.h"
+
+#include "gmock/gmock.h"
+
+using namespace Isis;
+
+/**
+ * Reads PVL text with the parser and with the stream operator and checks that
+ * both produce the same Pvl.
+ */
+static void compareParsers(const QByteArray &text) {
+  Pvl parsed;
+  PvlParser parser(text.constData(), text.size());
+  ASSERT_TRUE(parser.read(parsed)) << text.constData();
+
+  Pvl streamed;
+  std::istringstream stream(std::string(text.constData(), text.size()));
+  stream >> streamed;
+
+  std::ostringstream parsedText;
+  std::ostringstream streamedText;
+  parsedText << parsed;
+  streamedText << streamed;
+  EXPECT_EQ(parsedText.str(), streamedText.str()) << text.constData();
+}
+
+
+/**
+ * Creates a control network in PVL form with a number of points that each
+ * have several measures.
+ */
+static QByteArray createNetwork(int points, int measures) {
+  QByteArray text;
+  text += "Object = ControlNetwork\n"
+          "  NetworkId    = Test\n"
+          "  TargetName   = Mars\n"
+          "  UserName     = tester\n"
+          "  Created      = 2020-01-01T00:00:00\n"
+          "  LastModified = 2020-01-01T00:00:00\n"
+          "  Description  = \"A generated network\"\n"
+          "  Version      = 5\n\n";
+
+  for (int p = 0; p < points; p++) {
+    text += "  Object = ControlPoint\n"
+            "    PointType                = Free\n"
+            "    PointId                  = Point" + QByteArray::number(p) + "\n"
+            "    ChooserName              = pointreg\n"
+            "    DateTime                 = 2020-01-01T00:00:00\n"
+            "    AprioriXYZSource         = AverageOfMeasures\n"
+            "    AdjustedX                = " + QByteArray::number(3396190.0 - p * 0.25, 'g', 15) + " <meters>\n"
+            "    AdjustedY                = " + QByteArray::number(p * 10.5, 'g', 15) + " <meters>\n"
+            "    AdjustedZ                = " + QByteArray::number(-p * 3.125, 'g', 15) + " <meters>\n"
+            "    AprioriCovarianceMatrix  = (100.0, 0.0, 0.0, 100.0, 0.0, 100.0)\n\n";
+
+    for (int m = 0; m < measures; m++) {
+      text += "    Group = ControlMeasure\n"
+              "      SerialNumber = MRO/CTX/" + QByteArray::number(1000000000 + m) + ":0\n"
+              "      MeasureType  = RegisteredSubPixel\n"
+              "      Sample       = " + QByteArray::number(100.5 + p, 'f', 4) + "\n"
+              "      Line         = " + QByteArray::number(200.25 + m, 'f', 4) + "\n"
+              "      SampleResidual = 0.125 <pixels>\n"
+              "      LineResidual   = -0.0625 <pixels>\n"
+              "      Reference    = " + QByteArray(m == 0 ? "True" : "False") + "\n"
+              "    End_Group\n\n";
+    }
+
+    text += "  End_Object\n\n";
+  }
+
+  text += "End_Object\nEnd\n";
+  return text;
+}
+
+
+TEST(PvlParser, SameAsStream) {
+  compareParsers("");
+  compareParsers("End\n");
+  compareParsers("Keyword = Value\n");
+
+  compareParsers(
+      "# Comments before a keyword\n"
+      "// belong to the keyword\n"
+      "Name     = \"Quoted value\"\n"
+      "Single   = 'single quoted'\n"
+      "NoValue\n"
+      "Units    = 5.0 <meters>\n"
+      "NextLine = 10.0\n"
+      "           <km>\n"
+      "Array    = (1, 2, 3)\n"
+      "Braces   = {a, \"b c\", 'd'}\n"
+      "Empty    = ()\n"
+      "ArrayUnits = (1 <m>, 2, 3) <km>\n"
+      "Trailing = 1 # Comment after the value\n"
+      "\n"
+      "Object = IsisCube\n"
+      "  # An object comment\n"
+      "  Object = Core\n"
+      "    StartByte = 65537\n"
+      "\r\n"
+      "    Group = Dimensions\n"
+      "      Samples = 1024\n"
+      "      Lines   = 2048\n"
+      "    End_Group\n"
+      "  End_Object\n"
+      "  Group = Pixels\n"
+      "    Type = Real\n"
+      "  EndGroup\n"
+      "EndObject\n"
+      "\n"
+      "Group = Multiline\n"
+      "  Quote   = \"A quote that\n"
+      "             spans lines\"\n"
+      "  Array   = (1.0, 2.0,\n"
+      "             3.0, 4.0)\n"
+      "  Joined  = ABC-\n"
+      "            DEF\n"
+      "  Spaced  = 'a   b'\n"
+      "  End     = 1\n"
+      "EndGroup\n"
+      "End\n");
+
+  // Labels followed by binary data, or that end without a newline
+  compareParsers(QByteArray("A = 1\nEnd\n\0\0\xff\x01", 14));
+  compareParsers("Group = G\n  A = 1\nEndGroup\nEnd");
+  compareParsers("A = 1\nB = 2");
+  compareParsers("A = 1\n# Only a comment\n");
+  compareParsers("A = 1\nB = 2\x80\n");
+
+  compareParsers(createNetwork(3, 2));
+}
+
+
+TEST(PvlParser, FallsBack) {
+  const char *labels[] = {
+    "/* A C style comment */\nA = 1\n",
+    "A = 1 /* trailing */\n",
+    "Group = G\n  A = 1\n",
+    "Object = O\n  A = 1\nEndGroup\n",
+    "EndGroup\n",
+    "Group = G\n  Group = H\n  EndGroup\nEndGroup\n",
+    "A = (1, 2\n",
+    "A = \"unclosed\n",
+    "A = (1, 2,)\n",
+    "A = 1 2\n",
+    "Group = (A, B)\nEndGroup\n",
+    "A = 1   "
+  };
+
+  for (unsigned int i = 0; i < sizeof(labels) / sizeof(labels[0]); i++) {
+    Pvl pvl;
+    PvlParser parser(labels[i], strlen(labels[i]));
+    EXPECT_FALSE(parser.read(pvl)) << labels[i];
+    EXPECT_EQ(pvl.keywords(), 0) << labels[i];
+    EXPECT_EQ(pvl.groups(), 0) << labels[i];
+    EXPECT_EQ(pvl.objects(), 0) << labels[i];
+  }
+}
+
+
+TEST_F(TempTestingFiles, PvlParserReadFile) {
+  QString fileName = tempDir.path() + "/label.pvl";
+  QFile file(fileName);
+  ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+  file.write("Group = Test\n  A = 1 <m>\nEndGroup\nEnd\n");
+  file.close();
+
+  Pvl pvl(fileName);
+  EXPECT_EQ(pvl.fileName(), fileName);
+  ASSERT_TRUE(pvl.hasGroup("Test"));
+  EXPECT_EQ(double(pvl.findGroup("Test")["A"]), 1.0);
+  EXPECT_EQ(pvl.findGroup("Test")["A"].unit(), "m");
+
+  // Files the parser cannot read still produce the stream operator's errors
+  ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+  file.write("Group = Test\n  A = 1\n");
+  file.close();
+  EXPECT_THROW(Pvl invalid(fileName), IException);
+}
+
+
+TEST_F(TempTestingFiles, PvlParserSelectedObjects) {
+  QByteArray text = "Object = IsisCube\n"
+                    "  Group = Dimensions\n"
+                    "    Samples = 10\n"
+                    "  End_Group\n"
+                    "End_Object\n"
+                    "Object = Table\n"
+                    "  Name = \"Pointing\"\n"
+                    "  Field = (1, 2, 3)\n"
+                    "End_Object\n"
+                    "Object = Label\n"
+                    "  Bytes = 65536\n"
+                    "End_Object\n"
+                    "End\n";
+  QStringList objectNames;
+  objectNames << "isiscube" << "Label";
+
+  // Both the parser and the stream operators keep only the named objects
+  QByteArray files[] = {text, "/* Falls back */\n" + text};
+  for (int i = 0; i < 2; i++) {
+    QString fileName = tempDir.path() + "/selected" + QString::number(i) + ".pvl";
+    QFile file(fileName);
+    ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+    file.write(files[i]);
+    file.close();
+
+    Pvl pvl;
+    pvl.read(fileName, objectNames);
+    ASSERT_EQ(pvl.objects(), 2);
+    EXPECT_EQ(pvl.object(0).name(), "IsisCube");
+    EXPECT_EQ(pvl.object(1).name(), "Label");
+    EXPECT_EQ(int(pvl.findGroup("Dimensions", Pvl::Traverse)["Samples"]), 10);
+    EXPECT_EQ(int(pvl.findObject("Label")["Bytes"]), 65536);
+  }
+
+  // Skipped objects are still checked for syntax
+  Pvl pvl;
+  PvlParser parser(text.constData(), text.size() - 4);
+  parser.setObjectNames(QStringList("Table"));
+  ASSERT_TRUE(parser.read(pvl));
+  ASSERT_EQ(pvl.objects(), 1);
+  EXPECT_EQ(pvl.object(0)["Field"].size(), 3);
+
+  QByteArray broken = "Object = Table\n  A = (1, 2\nEnd_Object\n";
+  PvlParser brokenParser(broken.constData(), broken.size());
+  brokenParser.setObjectNames(QStringList("Label"));
+  EXPECT_FALSE(brokenParser.read(pvl));
+}
+
+
+// Prints timings, so it only runs with --gtest_also_run_disabled_tests
+TEST_F(TempTestingFiles, DISABLED_PvlParserBenchmark) {
+  QByteArray label;
+  label += "Object = IsisCube\n";
+  for (int g = 0; g < 2000; g++) {
+    label += "  Group = Group" + QByteArray::number(g) + "\n"
+             "    # A comment\n"
+             "    Name    = \"A quoted value\"\n"
+             "    Value   = " + QByteArray::number(g * 0.5) + " <degrees>\n"
+             "    Array   = (1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0, 9.0, 10.0,\n"
+             "               11.0, 12.0, 13.0, 14.0, 15.0, 16.0)\n"
+             "    Time    = 2020-01-01T00:00:00.000\n"
+             "  End_Group\n";
+  }
+  label += "End_Object\nEnd\n";
+
+  QByteArray files[] = {label, createNetwork(5000, 4)};
+  const char *names[] = {"label", "control network"};
+
+  for (int i = 0; i < 2; i++) {
+    QString fileName = tempDir.path() + "/benchmark" + QString::number(i) + ".pvl";
+    QFile file(fileName);
+    ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+    file.write(files[i]);
+    file.close();
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    Pvl parsed(fileName);
+    std::chrono::steady_clock::time_point parsedEnd = std::chrono::steady_clock::now();
+    Pvl streamed;
+    std::ifstream stream(fileName.toLatin1().data());
+    stream >> streamed;
+    std::chrono::steady_clock::time_point streamedEnd = std::chrono::steady_clock::now();
+
+    std::ostringstream parsedText;
+    std::ostringstream streamedText;
+    parsedText << parsed;
+    streamedText << streamed;
+    EXPECT_EQ(parsedText.str(), streamedText.str());
+
+    typedef std::chrono::duration<double, std::milli> Milliseconds;
+    std::cout << names[i] << " " << files[i].size() << " bytes" << std::endl
+              << "  PvlParser " << Milliseconds(parsedEnd - start).count() << " ms" << std::endl
+              << "  Stream    " << Milliseconds(streamedEnd - parsedEnd).count() << " ms" << std::endl;
+  }
+}
@@ -0,0 +1,150 @@
+#include <vector>
+
+#include <QScopedPointer>
+#include <QString>
+#include <QThreadPool>
+
+#include <opencv2/opencv.hpp>
+
+#include "ControlMeasure.h"
+#include "ControlNet.h"
+#include "ControlPoint.h"
+#include "FeatureAlgorithmFactory.h"
+#include "FeatureMatcherTypes.h"
+#include "ID.h"
+#include "ImageSource.h"
+#include "MatchImage.h"
+#include "MatchMaker.h"
+#include "MatchPair.h"
+#include "MatcherSolution.h"
+#include "RobustMatcher.h"
+
+#include "gmock/gmock.h"
+
+using namespace Isis;
+
+/**
+ * Creates a query image of blurred noise from a fixed seed and train images that are the query
+ * moved and turned by different amounts.
+ */
+static void createImages(cv::Mat &query, std::vector<cv::Mat> &trainers) {
+  cv::RNG rng(20171009);
+  cv::Mat noise(300, 300, CV_8UC1);
+  rng.fill(noise, cv::RNG::UNIFORM, 0, 256);
+  cv::GaussianBlur(noise, query, cv::Size(5, 5), 1.5);
+
+  double shifts[][3] = { {4.0, 7.0, 0.0}, {-6.0, 3.0, 5.0}, {10.0, -5.0, -8.0} };
+  for (int t = 0; t < 3; t++) {
+    cv::Mat transform = cv::getRotationMatrix2D(cv::Point2f(150.0, 150.0), shifts[t][2], 1.0);
+    transform.at<double>(0, 2) += shifts[t][0];
+    transform.at<double>(1, 2) += shifts[t][1];
+    cv::Mat train;
+    cv::warpAffine(query, train, transform, query.size());
+    trainers.push_back(train);
+  }
+}
+
+
+static MatchMaker *createMatchMaker(const cv::Mat &query, const std::vector<cv::Mat> &trainers,
+                                    const std::vector<int> &use) {
+  MatchMaker *maker = new MatchMaker("RobustMatcherTest");
+  maker->setQueryImage(MatchImage(ImageSource("Query", query, "Query")));
+  for (unsigned int t = 0; t < use.size(); t++) {
+    QString name = QString("Train%1").arg(use[t]);
+    maker->addTrainImage(MatchImage(ImageSource(name, trainers[use[t]], name)));
+  }
+  return maker;
+}
+
+
+static void compareMatches(const Matches &expected, const Matches &actual, const QString &what) {
+  ASSERT_EQ(actual.size(), expected.size()) << what.toStdString();
+  for (unsigned int m = 0; m < expected.size(); m++) {
+    EXPECT_EQ(actual[m].queryIdx, expected[m].queryIdx) << what.toStdString() << " " << m;
+    EXPECT_EQ(actual[m].trainIdx, expected[m].trainIdx) << what.toStdString() << " " << m;
+    EXPECT_EQ(actual[m].distance, expected[m].distance) << what.toStdString() << " " << m;
+  }
+}
+
+
+TEST(RobustMatcher, ConcurrentMatchesSerial) {
+  cv::Mat query;
+  std::vector<cv::Mat> trainers;
+  createImages(query, trainers);
+
+  RobustMatcherList algorithms =
+      FeatureAlgorithmFactory::getInstance()->create("orb/orb|brisk/brisk");
+  ASSERT_EQ(algorithms.size(), 2);
+
+  // Make sure the matchers and trainers are split between threads even on a single core machine
+  int maxThreads = QThreadPool::globalInstance()->maxThreadCount();
+  QThreadPool::globalInstance()->setMaxThreadCount(qMax(maxThreads, 4));
+
+  std::vector<int> all;
+  for (unsigned int t = 0; t < trainers.size(); t++) {
+    all.push_back(t);
+  }
+  QScopedPointer<MatchMaker> concurrent(createMatchMaker(query, trainers, all));
+  cv::setRNGSeed(1234);
+  MatcherSolutionList solutions = concurrent->match(algorithms);
+
+  QThreadPool::globalInstance()->setMaxThreadCount(maxThreads);
+  ASSERT_EQ(solutions.size(), algorithms.size());
+
+  // Run each matcher on each train image alone, one after another
+  for (int a = 0; a < algorithms.size(); a++) {
+    ASSERT_EQ(solutions[a]->size(), (int) trainers.size());
+    EXPECT_EQ(solutions[a]->matcher(), algorithms[a]);
+
+    MatchPairQList serialPairs;
+    for (unsigned int t = 0; t < trainers.size(); t++) {
+      std::vector<int> one(1, t);
+      QScopedPointer<MatchMaker> serial(createMatchMaker(query, trainers, one));
+      cv::setRNGSeed(1234);
+      QScopedPointer<MatcherSolution> solution(serial->match(algorithms[a]));
+      ASSERT_EQ(solution->size(), 1);
+      serialPairs.append(*solution->begin());
+    }
+
+    QString name = algorithms[a]->name();
+    MatcherSolution::MatchPairConstIterator pair = solutions[a]->begin();
+    for (int t = 0; t < serialPairs.size(); t++, ++pair) {
+      QString what = name + " Train" + QString::number(t);
+      EXPECT_EQ(pair->train().id().toStdString(), serialPairs[t].train().id().toStdString())
+          << what.toStdString();
+      EXPECT_EQ(pair->errorCount(), serialPairs[t].errorCount()) << what.toStdString();
+      compareMatches(serialPairs[t].homography_matches(), pair->homography_matches(), what);
+      compareMatches(serialPairs[t].epipolar_matches(), pair->epipolar_matches(), what);
+      compareMatches(serialPairs[t].matches(), pair->matches(), what);
+    }
+
+    // The networks from both solutions are the same
+    MatcherSolution serialSolution(algorithms[a], serialPairs);
+    ControlNet expectedNet;
+    ID expectedId("Point????");
+    concurrent->network(expectedNet, serialSolution, expectedId);
+    ControlNet actualNet;
+    ID actualId("Point????");
+    concurrent->network(actualNet, *solutions[a], actualId);
+
+    EXPECT_GT(expectedNet.GetNumPoints(), 0) << name.toStdString();
+    ASSERT_EQ(actualNet.GetNumPoints(), expectedNet.GetNumPoints()) << name.toStdString();
+    for (int p = 0; p < expectedNet.GetNumPoints(); p++) {
+      ControlPoint *expectedPoint = expectedNet.GetPoint(p);
+      ControlPoint *actualPoint = actualNet.GetPoint(p);
+      EXPECT_EQ(actualPoint->GetId().toStdString(), expectedPoint->GetId().toStdString());
+      ASSERT_EQ(actualPoint->GetNumMeasures(), expectedPoint->GetNumMeasures())
+          << expectedPoint->GetId().toStdString();
+      for (int m = 0; m < expectedPoint->GetNumMeasures(); m++) {
+        const ControlMeasure *expectedMeasure = expectedPoint->GetMeasure(m);
+        const ControlMeasure *actualMeasure = actualPoint->GetMeasure(m);
+        EXPECT_EQ(actualMeasure->GetCubeSerialNumber().toStdString(),
+                  expectedMeasure->GetCubeSerialNumber().toStdString());
+        EXPECT_EQ(actualMeasure->GetSample(), expectedMeasure->GetSample());
+        EXPECT_EQ(actualMeasure->GetLine(), expectedMeasure->GetLine());
+        EXPECT_EQ(actualMeasure->GetSampleResidual(), expectedMeasure->GetSampleResidual());
+        EXPECT_EQ(actualMeasure->GetLineResidual(), expectedMeasure->GetLineResidual());
+      }
+    }
+  }
+}
@@ -0,0 +1,204 @@
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+#include <QScopedPointer>
+#include <QString>
+
+#include "ProjectionFactory.h"
+#include "Pvl.h"
+#include "PvlGroup.h"
+#include "PvlKeyword.h"
+#include "SpecialPixel.h"
+#include "TProjection.h"
+
+#include <gtest/gtest.h>
+
+using namespace Isis;
+
+/**
+ * Creates a Mars projection centered at 30 degrees longitude.
+ */
+static TProjection *createProjection(QString name, QString direction = "PositiveEast",
+                                     double rotation = 0.0) {
+  Pvl lab;
+  lab.addGroup(PvlGroup("Mapping"));
+  PvlGroup &mapGroup = lab.findGroup("Mapping");
+  mapGroup += PvlKeyword("EquatorialRadius", toString(3396190.0));
+  mapGroup += PvlKeyword("PolarRadius", toString(3376200.0));
+  mapGroup += PvlKeyword("LatitudeType", "Planetocentric");
+  mapGroup += PvlKeyword("LongitudeDirection", direction);
+  mapGroup += PvlKeyword("LongitudeDomain", toString(360));
+  mapGroup += PvlKeyword("MinimumLatitude", toString(-80.0));
+  mapGroup += PvlKeyword("MaximumLatitude", toString(80.0));
+  mapGroup += PvlKeyword("MinimumLongitude", toString(0.0));
+  mapGroup += PvlKeyword("MaximumLongitude", toString(60.0));
+  mapGroup += PvlKeyword("ProjectionName", name);
+  mapGroup += PvlKeyword("CenterLongitude", toString(30.0));
+  if (name == "PolarStereographic") {
+    mapGroup += PvlKeyword("CenterLatitude", toString(90.0));
+  }
+  else if (name == "Equirectangular") {
+    mapGroup += PvlKeyword("CenterLatitude", toString(20.0));
+  }
+  else {
+    mapGroup += PvlKeyword("CenterLatitude", toString(0.0));
+  }
+  mapGroup += PvlKeyword("ScaleFactor", toString(1.0));
+  if (rotation != 0.0) {
+    mapGroup += PvlKeyword("Rotation", toString(rotation));
+  }
+  return (TProjection *) ProjectionFactory::Create(lab, true);
+}
+
+
+/**
+ * A grid of ground points covering the projection's latitude range.
+ */
+static void groundGrid(std::vector<double> &lats, std::vector<double> &lons) {
+  for (double lat = 5.0; lat <= 80.0; lat += 2.5) {
+    for (double lon = 0.0; lon <= 60.0; lon += 1.5) {
+      lats.push_back(lat);
+      lons.push_back(lon);
+      lats.push_back(-lat);
+      lons.push_back(lon);
+    }
+  }
+}
+
+
+static void compareBatchToScalar(TProjection *proj) {
+  std::vector<double> lats;
+  std::vector<double> lons;
+  groundGrid(lats, lons);
+  int count = lats.size();
+
+  std::vector<double> xs(count);
+  std::vector<double> ys(count);
+  bool *good = new bool[count];
+  proj->SetGrounds(count, &lats[0], &lons[0], &xs[0], &ys[0], good);
+
+  for (int i = 0; i < count; i++) {
+    bool expected = proj->SetGround(lats[i], lons[i]);
+    ASSERT_EQ(expected, good[i]) << "Ground point " << i;
+    if (expected) {
+      EXPECT_EQ(proj->XCoord(), xs[i]) << "Ground point " << i;
+      EXPECT_EQ(proj->YCoord(), ys[i]) << "Ground point " << i;
+    }
+    else {
+      EXPECT_EQ(Isis::Null, xs[i]);
+      EXPECT_EQ(Isis::Null, ys[i]);
+    }
+  }
+
+  // Invert the projected coordinates along with some that are off the planet
+  std::vector<double> inXs;
+  std::vector<double> inYs;
+  for (int i = 0; i < count; i++) {
+    if (good[i]) {
+      inXs.push_back(xs[i]);
+      inYs.push_back(ys[i]);
+    }
+  }
+  inXs.push_back(0.0);
+  inYs.push_back(1.0e8);
+  inXs.push_back(1.0e8);
+  inYs.push_back(-1.0e8);
+  int inverseCount = inXs.size();
+
+  std::vector<double> outLats(inverseCount);
+  std::vector<double> outLons(inverseCount);
+  bool *inverseGood = new bool[inverseCount];
+  proj->SetCoordinates(inverseCount, &inXs[0], &inYs[0], &outLats[0], &outLons[0], inverseGood);
+
+  for (int i = 0; i < inverseCount; i++) {
+    bool expected = proj->SetCoordinate(inXs[i], inYs[i]);
+    ASSERT_EQ(expected, inverseGood[i]) << "Coordinate " << i;
+    if (expected) {
+      EXPECT_EQ(proj->Latitude(), outLats[i]) << "Coordinate " << i;
+      EXPECT_EQ(proj->Longitude(), outLons[i]) << "Coordinate " << i;
+    }
+    else {
+      EXPECT_EQ(Isis::Null, outLats[i]);
+      EXPECT_EQ(Isis::Null, outLons[i]);
+    }
+  }
+
+  delete [] good;
+  delete [] inverseGood;
+}
+
+
+class BatchProjection : public ::testing::TestWithParam<QString> {
+};
+
+
+TEST_P(BatchProjection, PositiveEast) {
+  QScopedPointer<TProjection> proj(createProjection(GetParam()));
+  compareBatchToScalar(proj.data());
+}
+
+
+TEST_P(BatchProjection, PositiveWest) {
+  QScopedPointer<TProjection> proj(createProjection(GetParam(), "PositiveWest"));
+  compareBatchToScalar(proj.data());
+}
+
+
+TEST_P(BatchProjection, Rotated) {
+  QScopedPointer<TProjection> proj(createProjection(GetParam(), "PositiveEast", 30.0));
+  compareBatchToScalar(proj.data());
+}
+
+
+/**
+ * Times projecting a grid one point at a time against projecting it with
+ * SetGrounds and SetCoordinates. Run it with --gtest_also_run_disabled_tests.
+ */
+TEST_P(BatchProjection, DISABLED_Benchmark) {
+  QScopedPointer<TProjection> proj(createProjection(GetParam()));
+  std::vector<double> lats;
+  std::vector<double> lons;
+  while (lats.size() < 1000000) {
+    groundGrid(lats, lons);
+  }
+  int count = lats.size();
+  std::vector<double> xs(count);
+  std::vector<double> ys(count);
+  bool *good = new bool[count];
+
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  for (int i = 0; i < count; i++) {
+    good[i] = proj->SetGround(lats[i], lons[i]);
+    xs[i] = proj->XCoord();
+    ys[i] = proj->YCoord();
+  }
+  std::chrono::steady_clock::time_point scalarForward = std::chrono::steady_clock::now();
+  proj->SetGrounds(count, &lats[0], &lons[0], &xs[0], &ys[0], good);
+  std::chrono::steady_clock::time_point batchForward = std::chrono::steady_clock::now();
+  for (int i = 0; i < count; i++) {
+    good[i] = proj->SetCoordinate(xs[i], ys[i]);
+    lats[i] = proj->Latitude();
+    lons[i] = proj->Longitude();
+  }
+  std::chrono::steady_clock::time_point scalarInverse = std::chrono::steady_clock::now();
+  proj->SetCoordinates(count, &xs[0], &ys[0], &lats[0], &lons[0], good);
+  std::chrono::steady_clock::time_point batchInverse = std::chrono::steady_clock::now();
+
+  typedef std::chrono::duration<double, std::milli> Milliseconds;
+  std::cout << GetParam().toStdString() << " " << count << " points" << std::endl
+            << "  SetGround      " << Milliseconds(scalarForward - start).count() << " ms" << std::endl
+            << "  SetGrounds     " << Milliseconds(batchForward - scalarForward).count() << " ms" << std::endl
+            << "  SetCoordinate  " << Milliseconds(scalarInverse - batchForward).count() << " ms" << std::endl
+            << "  SetCoordinates " << Milliseconds(batchInverse - scalarInverse).count() << " ms" << std::endl;
+
+  delete [] good;
+}
+
+
+INSTANTIATE_TEST_CASE_P(
+      TProjection,
+      BatchProjection,
+      ::testing::Values("Equirectangular", "SimpleCylindrical", "Sinusoidal", "Mercator",
+                        "PolarStereographic", "TransverseMercator", "Orthographic",
+                        "Mollweide", "Robinson", "LambertAzimuthalEqualArea"));
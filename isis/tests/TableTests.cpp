@@ -0,0 +1,142 @@
+#include <algorithm>
+#include <vector>
+
+#include <QFile>
+#include <QString>
+
+#include "Endian.h"
+#include "Fixtures.h"
+#include "IException.h"
+#include "Pvl.h"
+#include "PvlObject.h"
+#include "Table.h"
+#include "TableField.h"
+#include "TableRecord.h"
+
+#include "gmock/gmock.h"
+
+using namespace Isis;
+
+/**
+ * Creates a table with one field of each type, including a field with several
+ * values per record.
+ */
+static Table createTable() {
+  TableField integer("Integer", TableField::Integer);
+  TableField real("Real", TableField::Real, 2);
+  TableField text("Text", TableField::Text, 6);
+  TableField dbl("Double", TableField::Double);
+  TableRecord record;
+  record += integer;
+  record += real;
+  record += text;
+  record += dbl;
+
+  Table table("TestTable", record);
+  for (int i = 0; i < 5; i++) {
+    record[0] = i - 2;
+    std::vector<float> reals;
+    reals.push_back(i * 0.5f);
+    reals.push_back(-i * 0.25f);
+    record[1] = reals;
+    record[2] = QString("Rec") + QString::number(i);
+    record[3] = i * 1.0e10 + 0.125;
+    table += record;
+  }
+  return table;
+}
+
+
+static void compareColumns(Table &table) {
+  std::vector<double> integers = table.column(0);
+  std::vector<double> reals = table.column("real");
+  std::vector<double> doubles = table.column("Double");
+  ASSERT_EQ(integers.size(), (size_t) table.Records());
+  ASSERT_EQ(reals.size(), (size_t) table.Records() * 2);
+  ASSERT_EQ(doubles.size(), (size_t) table.Records());
+
+  for (int r = 0; r < table.Records(); r++) {
+    TableRecord &record = table[r];
+    EXPECT_EQ(integers[r], (int) record[0]);
+    std::vector<float> expectedReals = record[1];
+    EXPECT_EQ(reals[r * 2], expectedReals[0]);
+    EXPECT_EQ(reals[r * 2 + 1], expectedReals[1]);
+    EXPECT_EQ(doubles[r], (double) record[3]);
+  }
+}
+
+
+TEST_F(TempTestingFiles, TableRoundTrip) {
+  Table table = createTable();
+  compareColumns(table);
+  EXPECT_THROW(table.column(2), IException);
+  EXPECT_THROW(table.column(4), IException);
+  EXPECT_THROW(table.column("Missing"), IException);
+
+  QString fileName = tempDir.path() + "/table.tbl";
+  table.Write(fileName);
+
+  Table read("TestTable", fileName);
+  ASSERT_EQ(read.Records(), 5);
+  for (int r = 0; r < read.Records(); r++) {
+    EXPECT_EQ((int) read[r][0], r - 2);
+    EXPECT_EQ(QString(read[r][2]), QString("Rec") + QString::number(r));
+    EXPECT_EQ((double) read[r][3], r * 1.0e10 + 0.125);
+  }
+  compareColumns(read);
+
+  // Updating and deleting records keeps the remaining records in order
+  TableRecord record = read[4];
+  read.Update(record, 0);
+  read.Delete(1);
+  ASSERT_EQ(read.Records(), 4);
+  std::vector<double> integers = read.column("Integer");
+  EXPECT_EQ(integers[0], 2.0);
+  EXPECT_EQ(integers[1], 0.0);
+  EXPECT_EQ(integers[3], 2.0);
+
+  Table copy(read);
+  read.Clear();
+  EXPECT_EQ(read.Records(), 0);
+  EXPECT_TRUE(read.column(0).empty());
+  EXPECT_EQ(copy.Records(), 4);
+  compareColumns(copy);
+}
+
+
+TEST_F(TempTestingFiles, TableSwappedByteOrder) {
+  Table table = createTable();
+  QString fileName = tempDir.path() + "/table.tbl";
+  table.Write(fileName);
+
+  // Rewrite the file in the other byte order
+  Pvl label(fileName);
+  PvlObject &tableObject = label.findObject("Table");
+  int startByte = tableObject["StartByte"];
+  QFile file(fileName);
+  ASSERT_TRUE(file.open(QIODevice::ReadWrite));
+  QByteArray bytes = file.readAll();
+  int recordSize = table.RecordSize();
+  for (int r = 0; r < table.Records(); r++) {
+    char *record = bytes.data() + startByte - 1 + r * recordSize;
+    std::reverse(record, record + 4);
+    std::reverse(record + 4, record + 8);
+    std::reverse(record + 8, record + 12);
+    std::reverse(record + 18, record + 26);
+  }
+  int byteOrder = bytes.indexOf(IsLsb() ? "Lsb" : "Msb", bytes.indexOf("ByteOrder"));
+  ASSERT_GT(byteOrder, 0);
+  bytes.replace(byteOrder, 3, IsLsb() ? "Msb" : "Lsb");
+  file.seek(0);
+  file.write(bytes);
+  file.close();
+
+  Table swapped("TestTable", fileName);
+  ASSERT_EQ(swapped.Records(), table.Records());
+  for (int r = 0; r < table.Records(); r++) {
+    EXPECT_EQ((int) swapped[r][0], (int) table[r][0]);
+    EXPECT_EQ((double) swapped[r][3], (double) table[r][3]);
+  }
+  EXPECT_EQ(swapped.column("Double"), table.column("Double"));
+  EXPECT_EQ(swapped.column("Real"), table.column("Real"));
+}